@@ -0,0 +1,111 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::AllocationsManagerBenchmark class
+
+#include <vector>
+#include <string>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Allocations manager benchmark settings
+struct AllocationsManagerSettings
+{
+    /// Number of allocations in every trace. Every allocation is also released, 
+    /// so the trace has twice as many operations.
+    Uint32 NumAllocations = 1 << 20;
+
+    /// Number of times every trace is replayed. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Result of replaying one trace with one allocations manager
+struct AllocationsManagerResult
+{
+    std::string Trace;
+    std::string Manager;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds = 0;
+
+    /// Wall time divided by the number of Allocate() and Free() calls
+    double NsPerOperation = 0;
+
+    double OperationsPerSecond = 0;
+
+    /// Time of the tree-based manager divided by the time of this manager
+    double Speedup = 0;
+
+    /// Number of allocations that failed because no free block was large enough
+    Uint32 FailedAllocations = 0;
+};
+
+/// Replays synthetic allocation traces through VariableSizeAllocationsManager and 
+/// SegregatedFitAllocationsManager.
+
+/// Every trace is a sequence of Allocate(Size, Alignment) and Free(Offset, Size) calls generated 
+/// with a fixed seed: small descriptor ranges without alignment as in descriptor heaps, 256-byte 
+/// aligned buffers as in Vulkan memory pages, and sizes with random power-of-two alignments.
+/// Before timing, every trace is replayed once with verification: the allocations must be properly 
+/// aligned, must not overlap, and the managers must be empty at the end of the trace.
+class AllocationsManagerBenchmark
+{
+public:
+    AllocationsManagerBenchmark(const AllocationsManagerSettings& Settings);
+
+    /// Replays every trace with both managers and appends results to the array.
+    /// Returns false if verification failed.
+    bool Run(std::vector<AllocationsManagerResult>& Results);
+
+private:
+    struct TraceOp
+    {
+        // Allocation that is created or released by this operation
+        Uint32 Id;
+        // Size and alignment of the new allocation. Zero size releases the allocation.
+        Uint32 Size;
+        Uint32 Alignment;
+    };
+
+    struct Trace
+    {
+        std::string          Name;
+        Uint64               MaxSize;
+        std::vector<TraceOp> Ops;
+    };
+
+    template<typename ManagerType>
+    bool Replay(const Trace& trace, bool Verify, AllocationsManagerResult& Result);
+
+    const AllocationsManagerSettings m_Settings;
+
+    std::vector<Trace> m_Traces;
+};
+
+}
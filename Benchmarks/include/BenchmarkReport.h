@@ -0,0 +1,92 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::WriteBenchmarkReport, Diligent::WriteShaderCompilationReport,
+/// Diligent::WriteBoxCullingReport, Diligent::WriteMatrixReport, Diligent::WriteGLBindingReport,
+/// Diligent::WriteGLDynamicBufferReport, Diligent::WriteGLDeferredReport, Diligent::WriteGLVAOReport, Diligent::WriteSamplerRegistryReport,
+/// Diligent::WriteMemoryPageIndexReport, Diligent::WriteAllocationsManagerReport,
+/// Diligent::WriteFixedBlockAllocatorReport and Diligent::WriteRingBufferReport functions
+
+#include <ostream>
+#include <vector>
+#include "DrawCallBenchmark.h"
+#include "ShaderCompilationBenchmark.h"
+#include "BoxCullingBenchmark.h"
+#include "MatrixBenchmark.h"
+#include "GLBindingBenchmark.h"
+#include "GLDynamicBufferBenchmark.h"
+#include "GLDeferredBenchmark.h"
+#include "GLVAOBenchmark.h"
+#include "SamplerRegistryBenchmark.h"
+#include "MemoryPageIndexBenchmark.h"
+#include "AllocationsManagerBenchmark.h"
+#include "FixedBlockAllocatorBenchmark.h"
+#include "RingBufferBenchmark.h"
+
+namespace Diligent
+{
+
+/// Writes benchmark results to the stream in JSON format
+void WriteBenchmarkReport(std::ostream& Stream, const BenchmarkSettings& Settings, const std::vector<BenchmarkResult>& Results);
+
+/// Writes shader compilation benchmark results to the stream in JSON format
+void WriteShaderCompilationReport(std::ostream& Stream, const ShaderCompilationSettings& Settings, const std::vector<ShaderCompilationResult>& Results);
+
+/// Writes box culling benchmark results to the stream in JSON format
+void WriteBoxCullingReport(std::ostream& Stream, const BoxCullingSettings& Settings, const std::vector<BoxCullingResult>& Results);
+
+/// Writes matrix benchmark results to the stream in JSON format
+void WriteMatrixReport(std::ostream& Stream, const MatrixBenchmarkSettings& Settings, const std::vector<MatrixBenchmarkResult>& Results);
+
+/// Writes GL resource binding benchmark results to the stream in JSON format
+void WriteGLBindingReport(std::ostream& Stream, const GLBindingSettings& Settings, const std::vector<GLBindingResult>& Results);
+
+/// Writes GL dynamic buffer benchmark results to the stream in JSON format
+void WriteGLDynamicBufferReport(std::ostream& Stream, const GLDynamicBufferSettings& Settings, const std::vector<GLDynamicBufferResult>& Results);
+
+/// Writes GL deferred context benchmark results to the stream in JSON format
+void WriteGLDeferredReport(std::ostream& Stream, const GLDeferredSettings& Settings, const std::vector<GLDeferredResult>& Results);
+
+/// Writes GL VAO cache benchmark results to the stream in JSON format
+void WriteGLVAOReport(std::ostream& Stream, const GLVAOSettings& Settings, const std::vector<GLVAOResult>& Results);
+
+/// Writes sampler registry benchmark results to the stream in JSON format
+void WriteSamplerRegistryReport(std::ostream& Stream, const SamplerRegistrySettings& Settings, const std::vector<SamplerRegistryResult>& Results);
+
+/// Writes memory page index benchmark results to the stream in JSON format
+void WriteMemoryPageIndexReport(std::ostream& Stream, const MemoryPageIndexSettings& Settings, const std::vector<MemoryPageIndexResult>& Results);
+
+/// Writes allocations manager benchmark results to the stream in JSON format
+void WriteAllocationsManagerReport(std::ostream& Stream, const AllocationsManagerSettings& Settings, const std::vector<AllocationsManagerResult>& Results);
+
+/// Writes fixed block allocator benchmark results to the stream in JSON format
+void WriteFixedBlockAllocatorReport(std::ostream& Stream, const FixedBlockAllocatorSettings& Settings, const std::vector<FixedBlockAllocatorResult>& Results);
+
+/// Writes ring buffer benchmark results to the stream in JSON format
+void WriteRingBufferReport(std::ostream& Stream, const RingBufferSettings& Settings, const std::vector<RingBufferResult>& Results);
+
+}
@@ -0,0 +1,96 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BoxCullingBenchmark class
+
+#include <vector>
+#include "BasicTypes.h"
+#include "AdvancedMath.h"
+
+namespace Diligent
+{
+
+/// Box culling benchmark settings
+struct BoxCullingSettings
+{
+    /// Number of bounding boxes
+    Uint32 NumBoxes = 262144;
+
+    /// Number of views every method culls the boxes against
+    Uint32 NumViews = 8;
+
+    /// Number of times every method is measured. The fastest run is reported.
+    Uint32 NumRuns  = 3;
+};
+
+/// Timing of one culling method
+struct BoxCullingResult
+{
+    const char* Name = "";
+
+    /// Total number of boxes tested in one run: NumBoxes * NumViews
+    Uint64 NumBoxes = 0;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds        = 0;
+    double BoxesPerSecond = 0;
+
+    /// Time of the scalar method for the same frustum type divided by the time of this method
+    double Speedup        = 0;
+};
+
+/// Measures bounding box culling throughput of GetBoxVisibility() and GetBoxesVisibility().
+
+/// Boxes are randomly distributed around the camera, and every view looks in a different
+/// direction. The scalar methods test boxes stored as an array of BoundBox structures, the
+/// batch methods test the same boxes stored as structure of arrays. Visibility computed by
+/// the batch methods is compared with the scalar results.
+class BoxCullingBenchmark
+{
+public:
+    BoxCullingBenchmark(const BoxCullingSettings& Settings);
+
+    /// Measures all methods and appends results to the array.
+    /// Returns false if batch culling results differ from the scalar results.
+    bool Run(std::vector<BoxCullingResult>& Results);
+
+private:
+    template<typename TCullViewFunc>
+    double Measure(TCullViewFunc CullView);
+
+    const BoxCullingSettings    m_Settings;
+    std::vector<ViewFrustumExt> m_Views;
+
+    std::vector<BoundBox>       m_Boxes;
+    std::vector<float>          m_MinX, m_MaxX, m_MinY, m_MaxY, m_MinZ, m_MaxZ;
+    BoundBoxArrays              m_BoxArrays;
+
+    std::vector<Uint8>          m_Visibility;
+    std::vector<Uint8>          m_ReferenceVisibility;
+};
+
+}
@@ -0,0 +1,129 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DrawCallBenchmark class
+
+#include <vector>
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "SwapChain.h"
+#include "RefCntAutoPtr.h"
+
+namespace Diligent
+{
+
+/// Benchmark settings
+struct BenchmarkSettings
+{
+    /// Maximum number of contexts that record commands in parallel.
+    /// The benchmark runs for every power of two up to this number.
+    Uint32 MaxContexts   = 64;
+
+    /// Number of frames every operation is measured for
+    Uint32 NumFrames     = 16;
+
+    /// Number of calls every context makes in one frame
+    Uint32 CallsPerFrame = 4096;
+};
+
+/// Timing of one operation recorded by a given number of contexts
+struct BenchmarkResult
+{
+    const Char* Name        = nullptr;
+    Uint32      NumContexts = 0;
+    Uint64      TotalCalls  = 0;
+
+    /// Average time of one call, averaged over all contexts, in nanoseconds
+    double NsPerCall    = 0;
+
+    /// Average time of one call in the fastest and the slowest context, in nanoseconds
+    double MinNsPerCall = 0;
+    double MaxNsPerCall = 0;
+
+    /// Number of calls made by all contexts together per second
+    double CallsPerSecond = 0;
+};
+
+/// Measures CPU cost of the most frequently used device context and resource methods.
+
+/// The benchmark runs on top of the Null back-end. Every context records commands from
+/// its own thread into a deferred context. At the end of every frame, command lists are 
+/// executed by the immediate context, which is not included in the timings.
+class DrawCallBenchmark
+{
+public:
+    DrawCallBenchmark(const BenchmarkSettings& Settings);
+    ~DrawCallBenchmark();
+
+    DrawCallBenchmark            (const DrawCallBenchmark&) = delete;
+    DrawCallBenchmark            (DrawCallBenchmark&&)      = delete;
+    DrawCallBenchmark& operator= (const DrawCallBenchmark&) = delete;
+    DrawCallBenchmark& operator= (DrawCallBenchmark&&)      = delete;
+
+    /// Measures all operations with NumContexts contexts and appends results to the array
+    void Run(Uint32 NumContexts, std::vector<BenchmarkResult>& Results);
+
+private:
+    enum OPERATION : Uint32
+    {
+        OPERATION_SET_PIPELINE_STATE = 0,
+        OPERATION_COMMIT_SHADER_RESOURCES,
+        OPERATION_SET_VERTEX_BUFFERS,
+        OPERATION_DRAW,
+        OPERATION_MAP_UNMAP,
+        OPERATION_SET_SHADER_VARIABLE,
+        OPERATION_NUM_OPERATIONS
+    };
+    static const Char* GetOperationName(OPERATION Operation);
+
+    BenchmarkResult MeasureOperation(OPERATION Operation, Uint32 NumContexts);
+
+    // Binds the state the operation requires, which is not included in the timings
+    void PrepareContext(OPERATION Operation, Uint32 Ctx);
+
+    // Makes CallsPerFrame calls and returns the time spent, in seconds
+    double RecordCalls(OPERATION Operation, Uint32 Ctx);
+
+    const BenchmarkSettings m_Settings;
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pImmediateContext;
+    RefCntAutoPtr<ISwapChain>     m_pSwapChain;
+    std::vector< RefCntAutoPtr<IDeviceContext> > m_DeferredContexts;
+
+    // Two instances of every object, so that every call changes the bound state
+    RefCntAutoPtr<IPipelineState> m_pPSO[2];
+    RefCntAutoPtr<IBuffer>        m_pVertexBuffer[2];
+    RefCntAutoPtr<IBuffer>        m_pConstantBuffer[2];
+    RefCntAutoPtr<ITexture>       m_pTexture;
+
+    // Every context uses its own resource binding
+    std::vector< RefCntAutoPtr<IShaderResourceBinding> > m_SRBs;
+    std::vector< IShaderVariable* >                      m_ConstantsVariables;
+};
+
+}
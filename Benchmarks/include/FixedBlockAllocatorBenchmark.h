@@ -0,0 +1,100 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FixedBlockAllocatorBenchmark class
+
+#include <vector>
+#include <string>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Fixed block allocator benchmark settings
+struct FixedBlockAllocatorSettings
+{
+    /// Maximum number of threads, 0 means 32.
+    /// The benchmark runs for every power of two up to this number, and for the number itself.
+    Uint32 MaxThreads = 0;
+
+    /// Number of Allocate() and Free() calls every thread makes
+    Uint32 OperationsPerThread = 1 << 20;
+
+    /// Number of live blocks every thread holds. Every operation after the
+    /// first allocations releases a random block or allocates a new one.
+    Uint32 BlocksPerThread = 256;
+
+    /// Block size and number of blocks in a page, as in SRBMemoryAllocator
+    Uint32 BlockSize       = 192;
+    Uint32 NumBlocksInPage = 16;
+
+    /// Number of times every configuration is measured. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Timing of the calls made by a given number of threads in one allocator mode
+struct FixedBlockAllocatorResult
+{
+    Uint32      NumThreads = 0;
+    std::string Mode;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds = 0;
+
+    /// Wall time divided by the number of calls made by one thread
+    double NsPerOperation = 0;
+
+    /// Total number of calls all threads make per second
+    double OperationsPerSecond = 0;
+
+    /// Time of the mutex mode divided by the time of this mode with the same number of threads
+    double Speedup = 0;
+};
+
+/// Measures FixedBlockMemoryAllocator throughput with and without thread caching.
+
+/// All threads share one allocator. Every thread keeps BlocksPerThread live blocks and randomly
+/// releases and allocates blocks with a fixed seed. Every block is filled with the id of the 
+/// thread and the operation that allocated it, and the contents are verified before the block
+/// is released, so that a block handed out twice is detected. When the threads finish, the main
+/// thread releases all remaining blocks, so blocks allocated by one thread are released by another.
+class FixedBlockAllocatorBenchmark
+{
+public:
+    FixedBlockAllocatorBenchmark(const FixedBlockAllocatorSettings& Settings);
+
+    /// Runs the benchmark with 1, 2, 4, ... up to MaxThreads threads in both modes and 
+    /// appends results to the array. Returns false if verification failed.
+    bool Run(std::vector<FixedBlockAllocatorResult>& Results);
+
+private:
+    // Returns wall time of the fastest run, or a negative value if verification failed
+    double Measure(Uint32 NumThreads, bool ThreadCaching);
+
+    const FixedBlockAllocatorSettings m_Settings;
+};
+
+}
@@ -0,0 +1,98 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLBindingBenchmark class
+
+#include <vector>
+#include <memory>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// OpenGL resource binding benchmark settings
+struct GLBindingSettings
+{
+    /// Number of draw calls in every scenario
+    Uint32 NumDraws = 16384;
+
+    /// Number of times every scenario is measured. The fastest run is reported.
+    Uint32 NumRuns  = 3;
+};
+
+/// Timing and GL call counts of one scenario
+struct GLBindingResult
+{
+    const char* Name = "";
+
+    Uint32 NumDraws = 0;
+
+    /// Wall time of the fastest run, in seconds, and time of one CommitShaderResources() + Draw() pair
+    double Seconds   = 0;
+    double NsPerDraw = 0;
+
+    /// Average number of GL calls of every kind made per draw
+    double UniformBlockBindingsPerDraw = 0;
+    double SamplerUniformsPerDraw      = 0;
+    double BufferBindingsPerDraw       = 0;
+    double ActiveTexturesPerDraw       = 0;
+    double SamplerBindingsPerDraw      = 0;
+};
+
+/// Measures CPU time and the number of resource binding GL calls made by
+/// IDeviceContext::CommitShaderResources() and IDeviceContext::Draw() in the OpenGL back-end.
+
+/// The benchmark creates an off-screen GLX context, so it requires an X server. Running
+/// it under Xvfb with LIBGL_ALWAYS_SOFTWARE=1 uses Mesa's software rasterizer. GL calls are
+/// counted by replacing GLEW function pointers, so functions that GLEW does not load
+/// (such as glBindTexture()) are not counted.
+/// Uniform block bindings and sampler uniforms are assigned when programs are linked, so
+/// the benchmark fails if any of these calls is made while drawing.
+class GLBindingBenchmark
+{
+public:
+    GLBindingBenchmark(const GLBindingSettings& Settings);
+    ~GLBindingBenchmark();
+
+    GLBindingBenchmark            (const GLBindingBenchmark&) = delete;
+    GLBindingBenchmark            (GLBindingBenchmark&&)      = delete;
+    GLBindingBenchmark& operator= (const GLBindingBenchmark&) = delete;
+    GLBindingBenchmark& operator= (GLBindingBenchmark&&)      = delete;
+
+    /// Measures all scenarios and appends results to the array.
+    /// Returns false if program bindings are updated while drawing.
+    bool Run(std::vector<GLBindingResult>& Results);
+
+private:
+    const GLBindingSettings m_Settings;
+
+    // Engine objects are kept out of the header
+    struct Impl;
+    std::unique_ptr<Impl> m_pImpl;
+};
+
+}
@@ -0,0 +1,107 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDeferredBenchmark class
+
+#include <vector>
+#include <memory>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// OpenGL deferred context benchmark settings
+struct GLDeferredSettings
+{
+    /// Number of draws in the scene
+    Uint32 NumDraws = 16384;
+
+    /// Maximum number of recording threads, 0 means the number of hardware threads.
+    /// The benchmark runs for every power of two up to this number, and for the number itself.
+    Uint32 MaxThreads = 0;
+
+    /// Number of times every scenario is measured. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Timing of one scenario
+struct GLDeferredResult
+{
+    const char* Name = "";
+
+    /// Number of deferred contexts that record the scene in parallel, zero if
+    /// the scene is submitted directly to the immediate context
+    Uint32 NumThreads = 0;
+
+    Uint32 NumDraws = 0;
+
+    /// Wall time of the fastest run, in seconds: time to record all command lists,
+    /// time to submit the commands to OpenGL and wait for the GPU, and the sum of the two
+    double RecordSeconds  = 0;
+    double ExecuteSeconds = 0;
+    double TotalSeconds   = 0;
+
+    /// Ratio of the recording time of one deferred context to this scenario's recording time
+    double RecordSpeedup = 0;
+
+    /// Ratio of the total time of immediate submission to this scenario's total time
+    double Speedup = 0;
+};
+
+/// Measures parallel recording of OpenGL command lists on deferred contexts.
+
+/// Every draw of the scene maps a dynamic uniform buffer with MAP_FLAG_DISCARD, writes the color and the
+/// position of one render target pixel to it, commits shader resources and draws a quad that covers the pixel.
+/// Consecutive draws overwrite pixels in a fixed order, so the image depends on the order in which the draws are executed.
+/// The scene is first submitted to the immediate context, then the draws are split into contiguous ranges that
+/// are recorded on deferred contexts by worker threads and the command lists are executed on the immediate context
+/// in order. The benchmark fails if any image differs from the expected one.
+/// The benchmark creates an off-screen GLX context, so it requires an X server.
+class GLDeferredBenchmark
+{
+public:
+    GLDeferredBenchmark(const GLDeferredSettings& Settings);
+    ~GLDeferredBenchmark();
+
+    GLDeferredBenchmark            (const GLDeferredBenchmark&) = delete;
+    GLDeferredBenchmark            (GLDeferredBenchmark&&)      = delete;
+    GLDeferredBenchmark& operator= (const GLDeferredBenchmark&) = delete;
+    GLDeferredBenchmark& operator= (GLDeferredBenchmark&&)      = delete;
+
+    /// Measures immediate submission and recording with 1, 2, 4, ... up to MaxThreads threads,
+    /// and appends results to the array. Returns false if any scenario renders incorrect image.
+    bool Run(std::vector<GLDeferredResult>& Results);
+
+private:
+    const GLDeferredSettings m_Settings;
+
+    // Engine objects are kept out of the header
+    struct Impl;
+    std::unique_ptr<Impl> m_pImpl;
+};
+
+}
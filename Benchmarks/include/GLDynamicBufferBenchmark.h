@@ -0,0 +1,102 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDynamicBufferBenchmark class
+
+#include <vector>
+#include <memory>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// OpenGL dynamic buffer benchmark settings
+struct GLDynamicBufferSettings
+{
+    /// Number of frames in every run
+    Uint32 NumFrames = 64;
+
+    /// Number of Map() + Draw() pairs in every frame
+    Uint32 DrawsPerFrame = 1024;
+
+    /// Number of dynamic uniform buffers the draws cycle through
+    Uint32 NumBuffers = 16;
+
+    /// Number of times every scenario is measured. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Timing of one scenario
+struct GLDynamicBufferResult
+{
+    const char* Name = "";
+
+    /// Size of the dynamic heap, zero if buffers are mapped with glMapBufferRange()
+    Uint32 DynamicHeapSize = 0;
+
+    Uint32 NumDraws = 0;
+
+    /// Wall time of the fastest run including GPU execution, in seconds, time of one
+    /// Map() + Unmap() + CommitShaderResources() + Draw() sequence and the number of sequences per second
+    double Seconds        = 0;
+    double NsPerDraw      = 0;
+    double DrawsPerSecond = 0;
+
+    /// Ratio of the time of the first scenario to this scenario
+    double Speedup = 0;
+};
+
+/// Measures IBuffer::Map() with MAP_FLAG_DISCARD of dynamic uniform buffers in the OpenGL back-end.
+
+/// Every draw maps one of the buffers, writes a color to it and draws a quad that reads the color.
+/// The first scenario maps buffers with glMapBufferRange() (the dynamic heap is disabled), the second
+/// one suballocates the persistently mapped dynamic heap. Every frame is finished with
+/// IDeviceContext::FinishFrame(). The benchmark fails if the rendered image does not match
+/// the color written by the last draw.
+/// The benchmark creates an off-screen GLX context, so it requires an X server.
+class GLDynamicBufferBenchmark
+{
+public:
+    GLDynamicBufferBenchmark(const GLDynamicBufferSettings& Settings);
+    ~GLDynamicBufferBenchmark();
+
+    GLDynamicBufferBenchmark            (const GLDynamicBufferBenchmark&) = delete;
+    GLDynamicBufferBenchmark            (GLDynamicBufferBenchmark&&)      = delete;
+    GLDynamicBufferBenchmark& operator= (const GLDynamicBufferBenchmark&) = delete;
+    GLDynamicBufferBenchmark& operator= (GLDynamicBufferBenchmark&&)      = delete;
+
+    /// Measures all scenarios and appends results to the array.
+    /// Returns false if any scenario renders incorrect image.
+    bool Run(std::vector<GLDynamicBufferResult>& Results);
+
+private:
+    const GLDynamicBufferSettings m_Settings;
+
+    std::unique_ptr<class OffscreenGLContext> m_pGLContext;
+};
+
+}
@@ -0,0 +1,93 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLVAOBenchmark class
+
+#include <vector>
+#include <memory>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// OpenGL vertex array object cache benchmark settings
+struct GLVAOSettings
+{
+    /// Number of draw calls in every draw scenario and number of buffers released
+    /// in the buffer release scenarios
+    Uint32 NumDraws = 16384;
+
+    /// Number of distinct vertex buffers the cycling scenario draws with
+    Uint32 NumVertexBuffers = 1024;
+
+    /// Number of times every scenario is measured. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Timing of one scenario
+struct GLVAOResult
+{
+    const char* Name = "";
+
+    Uint32 NumOperations = 0;
+
+    /// CPU time of the fastest run, in seconds, and time of one operation
+    double Seconds        = 0;
+    double NsPerOperation = 0;
+};
+
+/// Measures the cost of vertex array object lookup in the OpenGL back-end.
+
+/// Setting vertex buffers invalidates the VAO of the context, so the next draw looks up
+/// the VAO cache. The benchmark measures IDeviceContext::SetVertexBuffers() + IDeviceContext::Draw()
+/// with the same vertex buffers and with buffers that cycle through a set of cached VAOs, draws
+/// that do not look up the cache as the baseline, and the time it takes to release buffers that
+/// are referenced by cached VAOs, either all at once or one before every draw.
+/// The benchmark creates an off-screen GLX context, so it requires an X server.
+class GLVAOBenchmark
+{
+public:
+    GLVAOBenchmark(const GLVAOSettings& Settings);
+    ~GLVAOBenchmark();
+
+    GLVAOBenchmark            (const GLVAOBenchmark&) = delete;
+    GLVAOBenchmark            (GLVAOBenchmark&&)      = delete;
+    GLVAOBenchmark& operator= (const GLVAOBenchmark&) = delete;
+    GLVAOBenchmark& operator= (GLVAOBenchmark&&)      = delete;
+
+    /// Measures all scenarios and appends results to the array
+    bool Run(std::vector<GLVAOResult>& Results);
+
+private:
+    const GLVAOSettings m_Settings;
+
+    // Engine objects are kept out of the header
+    struct Impl;
+    std::unique_ptr<Impl> m_pImpl;
+};
+
+}
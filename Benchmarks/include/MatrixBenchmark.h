@@ -0,0 +1,96 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::MatrixBenchmark class
+
+#include <vector>
+#include "BasicTypes.h"
+#include "BasicMath.h"
+
+namespace Diligent
+{
+
+/// Matrix benchmark settings
+struct MatrixBenchmarkSettings
+{
+    /// Number of matrices, points and normals every method processes
+    Uint32 NumElements = 262144;
+
+    /// Number of times every method is measured. The fastest run is reported.
+    Uint32 NumRuns     = 3;
+};
+
+/// Timing of one matrix method
+struct MatrixBenchmarkResult
+{
+    const char* Name = "";
+
+    /// Number of elements processed in one run
+    Uint64 NumElements = 0;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds           = 0;
+    double ElementsPerSecond = 0;
+
+    /// Time of the scalar method for the same operation divided by the time of this method
+    double Speedup           = 0;
+};
+
+/// Measures throughput of the scalar matrix operations from BasicMath.h and of the
+/// corresponding bulk functions (MultiplyMatrices(), InvertMatrices(), TransformPoints() and
+/// TransformNormals()).
+
+/// The scalar methods write every result to an array one element at a time, the bulk methods
+/// process the whole array at once. Results of the bulk methods are compared bit-for-bit with
+/// the scalar results.
+class MatrixBenchmark
+{
+public:
+    MatrixBenchmark(const MatrixBenchmarkSettings& Settings);
+
+    /// Measures all methods and appends results to the array.
+    /// Returns false if the results of any bulk method differ from the scalar results.
+    bool Run(std::vector<MatrixBenchmarkResult>& Results);
+
+private:
+    template<typename TFunc>
+    double Measure(TFunc Func);
+
+    const MatrixBenchmarkSettings m_Settings;
+
+    std::vector<float4x4> m_Left;
+    std::vector<float4x4> m_Right;
+    std::vector<float3>   m_Points;
+    float4x4              m_ViewProj;
+
+    std::vector<float4x4> m_Matrices;
+    std::vector<float4x4> m_ReferenceMatrices;
+    std::vector<float3>   m_Vectors;
+    std::vector<float3>   m_ReferenceVectors;
+};
+
+}
@@ -0,0 +1,139 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::MemoryPageIndexBenchmark class
+
+#include <vector>
+#include <string>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Memory page index benchmark settings
+struct MemoryPageIndexSettings
+{
+    /// Number of allocations in every trace
+    Uint32 NumAllocations = 65536;
+
+    /// Size of a shared memory page, the same as EngineVkAttribs::DeviceLocalMemoryPageSize
+    Uint32 PageSize = 16 << 20;
+
+    /// Allocations of this size or larger are placed into dedicated pages by the 
+    /// best_fit_dedicated strategy, the same as EngineVkAttribs::DedicatedAllocationThreshold
+    Uint32 DedicatedAllocationThreshold = 8 << 20;
+
+    /// Number of allocations between two calls that release empty pages, 
+    /// which emulates VulkanMemoryManager::ShrinkMemory() called once per frame
+    Uint32 AllocationsPerFrame = 256;
+
+    /// Number of times every trace is replayed. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Result of replaying one trace with one page selection strategy
+struct MemoryPageIndexResult
+{
+    std::string Trace;
+    std::string Strategy;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds = 0;
+
+    /// Wall time divided by the number of allocations. Includes the time to release memory.
+    double NsPerAllocation = 0;
+
+    double AllocationsPerSecond = 0;
+
+    /// Total number of pages created during the trace, including dedicated pages
+    Uint32 PagesCreated = 0;
+
+    /// Maximum number of pages that existed at the same time
+    Uint32 PeakPages = 0;
+
+    /// Maximum total size of all pages, in bytes
+    Uint64 PeakAllocatedSize = 0;
+
+    /// Maximum total size of live allocations, in bytes
+    Uint64 PeakUsedSize = 0;
+
+    /// Average fraction of page memory that is not used by live allocations,
+    /// sampled at the end of every frame
+    double Fragmentation = 0;
+};
+
+/// Replays synthetic resource allocation traces through the page selection strategies
+/// of VulkanMemoryManager.
+
+/// The benchmark does not need a Vulkan device: pages are emulated with VariableSizeAllocationsManager
+/// that VulkanMemoryPage uses to suballocate device memory. Every trace is replayed with the former 
+/// strategy that tries pages in creation order, with the best fit strategy implemented by 
+/// PageFreeSpaceIndex, and with best fit combined with dedicated pages for large allocations.
+/// Every allocation is verified to fit into its page, and all pages are verified to be empty 
+/// once the allocations that are alive at the end of the trace are released.
+class MemoryPageIndexBenchmark
+{
+public:
+    MemoryPageIndexBenchmark(const MemoryPageIndexSettings& Settings);
+
+    /// Replays every trace with every strategy and appends results to the array.
+    /// Returns false if any allocation failed or did not fit into its page.
+    bool Run(std::vector<MemoryPageIndexResult>& Results);
+
+private:
+    struct TraceOp
+    {
+        // Allocation that is created by this operation
+        Uint32 Id;
+        Uint64 Size;
+        Uint64 Alignment;
+        // Allocations that are released before the new one is created
+        std::vector<Uint32> Released;
+    };
+
+    struct Trace
+    {
+        std::string          Name;
+        std::vector<TraceOp> Ops;
+    };
+
+    enum class Strategy
+    {
+        FirstFit,
+        BestFit,
+        BestFitDedicated
+    };
+
+    // Replays the trace once, returns false if verification failed
+    bool Replay(const Trace& trace, Strategy strategy, MemoryPageIndexResult& Result);
+
+    const MemoryPageIndexSettings m_Settings;
+
+    std::vector<Trace> m_Traces;
+};
+
+}
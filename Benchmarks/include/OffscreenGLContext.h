@@ -0,0 +1,58 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::OffscreenGLContext class
+
+#include <memory>
+
+namespace Diligent
+{
+
+/// OpenGL 4.3 core context made current on a small off-screen GLX pbuffer
+
+/// The context requires an X server. Running under Xvfb with LIBGL_ALWAYS_SOFTWARE=1
+/// uses Mesa's software rasterizer. The context is released by the destructor, so all
+/// engine objects must be released before the context is destroyed.
+class OffscreenGLContext
+{
+public:
+    /// Creates the context and makes it current. Throws if the context cannot be created.
+    OffscreenGLContext();
+    ~OffscreenGLContext();
+
+    OffscreenGLContext            (const OffscreenGLContext&) = delete;
+    OffscreenGLContext            (OffscreenGLContext&&)      = delete;
+    OffscreenGLContext& operator= (const OffscreenGLContext&) = delete;
+    OffscreenGLContext& operator= (OffscreenGLContext&&)      = delete;
+
+private:
+    // GLX objects are kept out of the header to avoid including X11 headers
+    struct GLXObjects;
+    std::unique_ptr<GLXObjects> m_pGLX;
+};
+
+}
@@ -0,0 +1,107 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::RingBufferBenchmark class
+
+#include <vector>
+#include <string>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Ring buffer benchmark settings
+struct RingBufferSettings
+{
+    /// Maximum number of threads, 0 means 32.
+    /// The benchmark runs for every power of two up to this number, and for the number itself.
+    Uint32 MaxThreads = 0;
+
+    /// Number of master blocks every thread allocates
+    Uint32 AllocationsPerThread = 1 << 20;
+
+    /// Size of the ring buffer
+    Uint32 BufferSize = 64 << 20;
+
+    /// Master block sizes are random multiples of the alignment up to MaxAllocationSize
+    Uint32 MaxAllocationSize = 4096;
+    Uint32 Alignment         = 256;
+
+    /// Number of frames the emulated GPU lags behind the frame thread
+    Uint32 FramesInFlight = 2;
+
+    /// Number of times every configuration is measured. The fastest run is reported.
+    Uint32 NumRuns = 3;
+};
+
+/// Timing of the allocations made by a given number of threads in one ring buffer mode
+struct RingBufferResult
+{
+    Uint32      NumThreads = 0;
+    std::string Mode;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds = 0;
+
+    /// Wall time divided by the number of allocations made by one thread
+    double NsPerOperation = 0;
+
+    /// Total number of allocations all threads make per second
+    double OperationsPerSecond = 0;
+
+    /// Time of the mutex mode divided by the time of this mode with the same number of threads
+    double Speedup = 0;
+
+    /// Number of times an allocation failed because the buffer was full and had to be retried
+    Uint64 FullBufferRetries = 0;
+};
+
+/// Measures master block allocation throughput of DynamicHeap::MasterBlockRingBufferBasedManager,
+/// which allocates from the lock-free ConcurrentRingBuffer, against a RingBuffer guarded by a mutex.
+
+/// All threads share one ring buffer and allocate random-size master blocks with a fixed seed. 
+/// While they run, the main thread finishes frames and releases the frames that are FramesInFlight
+/// frames old, as the device does once per frame. A thread that finds the buffer full yields and
+/// retries. Every offset is checked for alignment and bounds, and the buffer must be empty once all 
+/// frames are released.
+class RingBufferBenchmark
+{
+public:
+    RingBufferBenchmark(const RingBufferSettings& Settings);
+
+    /// Runs the benchmark with 1, 2, 4, ... up to MaxThreads threads in both modes and 
+    /// appends results to the array. Returns false if verification failed.
+    bool Run(std::vector<RingBufferResult>& Results);
+
+private:
+    // Returns wall time of the fastest run, or a negative value if verification failed
+    template<typename ManagerType>
+    double Measure(Uint32 NumThreads, Uint64& FullBufferRetries);
+
+    const RingBufferSettings m_Settings;
+};
+
+}
@@ -0,0 +1,98 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SamplerRegistryBenchmark class
+
+#include <vector>
+#include "RenderDevice.h"
+#include "RefCntAutoPtr.h"
+
+namespace Diligent
+{
+
+/// Sampler registry benchmark settings
+struct SamplerRegistrySettings
+{
+    /// Maximum number of threads, 0 means the number of hardware threads.
+    /// The benchmark runs for every power of two up to this number, and for the number itself.
+    Uint32 MaxThreads     = 0;
+
+    /// Number of IRenderDevice::CreateSampler() calls every thread makes
+    Uint32 CallsPerThread = 65536;
+
+    /// Number of distinct sampler descriptions. Samplers for the first half of the descriptions
+    /// are kept alive during the whole run, samplers for the second half are repeatedly released
+    /// and created again.
+    Uint32 NumSamplerDescs = 512;
+
+    /// Number of times every thread count is measured. The fastest run is reported.
+    Uint32 NumRuns        = 3;
+};
+
+/// Timing of the calls made by a given number of threads
+struct SamplerRegistryResult
+{
+    Uint32 NumThreads = 0;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds        = 0;
+
+    /// Wall time divided by the number of calls made by one thread
+    double NsPerCall      = 0;
+
+    /// Total number of calls all threads make per second
+    double CallsPerSecond = 0;
+};
+
+/// Measures contention in the sampler registry that IRenderDevice::CreateSampler() uses to 
+/// deduplicate samplers with equal descriptions.
+
+/// The benchmark runs on top of the Null back-end, so that the registry lookup, object 
+/// creation and destruction are the only work that is measured. Every thread creates samplers 
+/// from the same set of descriptions, mostly finding existing samplers, and holds the last few
+/// samplers it created, so that samplers that are not referenced elsewhere keep expiring.
+/// Every call is verified to return a sampler with the requested description.
+class SamplerRegistryBenchmark
+{
+public:
+    SamplerRegistryBenchmark(const SamplerRegistrySettings& Settings);
+
+    /// Runs the benchmark with 1, 2, 4, ... up to MaxThreads threads and appends results to the array.
+    /// Returns false if any call failed or returned a sampler with a different description.
+    bool Run(std::vector<SamplerRegistryResult>& Results);
+
+private:
+    // Makes CallsPerThread calls, returns false on failure
+    bool RunThread(Uint32 ThreadId);
+
+    const SamplerRegistrySettings m_Settings;
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    std::vector<SamplerDesc>     m_SamplerDescs;
+};
+
+}
@@ -0,0 +1,90 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderCompilationBenchmark class
+
+#include <vector>
+#include <string>
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Shader compilation benchmark settings
+struct ShaderCompilationSettings
+{
+    /// Maximum number of compiler threads, 0 means the number of hardware threads.
+    /// The benchmark runs for every power of two up to this number, and for the number itself.
+    Uint32 MaxThreads = 0;
+
+    /// Number of shaders in the batch
+    Uint32 NumShaders = 256;
+
+    /// Number of times every batch is compiled. The fastest run is reported.
+    Uint32 NumRuns    = 3;
+};
+
+/// Timing of the batch compiled by a given number of threads
+struct ShaderCompilationResult
+{
+    Uint32 NumThreads = 0;
+    Uint32 NumShaders = 0;
+
+    /// Wall time of the fastest run, in seconds
+    double Seconds          = 0;
+    double ShadersPerSecond = 0;
+
+    /// Single-thread time divided by the time of this run
+    double Speedup          = 0;
+};
+
+/// Measures GLSLtoSPIRVBatch() throughput as a function of the number of compiler threads.
+
+/// The batch consists of generated fragment shaders of similar complexity. Byte code produced
+/// with every number of threads is compared with the single-thread byte code to verify that
+/// the results do not depend on the number of threads.
+class ShaderCompilationBenchmark
+{
+public:
+    ShaderCompilationBenchmark(const ShaderCompilationSettings& Settings);
+    ~ShaderCompilationBenchmark();
+
+    ShaderCompilationBenchmark            (const ShaderCompilationBenchmark&) = delete;
+    ShaderCompilationBenchmark            (ShaderCompilationBenchmark&&)      = delete;
+    ShaderCompilationBenchmark& operator= (const ShaderCompilationBenchmark&) = delete;
+    ShaderCompilationBenchmark& operator= (ShaderCompilationBenchmark&&)      = delete;
+
+    /// Compiles the batch with 1, 2, 4, ... up to MaxThreads threads and appends results to the array.
+    /// Returns false if any shader fails to compile or the byte code differs from the single-thread run.
+    bool Run(std::vector<ShaderCompilationResult>& Results);
+
+private:
+    const ShaderCompilationSettings m_Settings;
+    std::vector<std::string>        m_Sources;
+};
+
+}
@@ -0,0 +1,213 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <random>
+#include <map>
+#include <algorithm>
+#include <cmath>
+
+#include "AllocationsManagerBenchmark.h"
+#include "VariableSizeAllocationsManager.h"
+#include "SegregatedFitAllocationsManager.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Align.h"
+#include "Timer.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+AllocationsManagerBenchmark::AllocationsManagerBenchmark(const AllocationsManagerSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.NumAllocations > 0 && m_Settings.NumRuns > 0);
+
+    struct TraceDesc
+    {
+        const char* Name;
+        Uint64      MaxSize;
+        // Sizes are distributed log-uniformly in [2^MinSizeLog2, 2^MaxSizeLog2]
+        double      MinSizeLog2;
+        double      MaxSizeLog2;
+        // Alignments are random powers of two in [2^MinAlignmentLog2, 2^MaxAlignmentLog2]
+        Uint32      MinAlignmentLog2;
+        Uint32      MaxAlignmentLog2;
+        // Maximum number of allocations made during the lifetime of an allocation
+        Uint32      MaxLifetime;
+    };
+    static const TraceDesc TraceDescs[] = 
+    {
+        {"descriptor_heap", Uint64{1} << 16,  0,  6,  0,  0, 2048},
+        {"memory_page",     Uint64{1} << 26,  8, 18,  8,  8,  512},
+        {"mixed_alignment", Uint64{1} << 28,  4, 16,  0, 12, 4096}
+    };
+
+    const auto NumAllocations = m_Settings.NumAllocations;
+    for (const auto& Desc : TraceDescs)
+    {
+        // Fixed seed makes results comparable between runs
+        std::mt19937 Rng(0);
+        std::uniform_real_distribution<double> Distr01(0.0, 1.0);
+        std::uniform_int_distribution<Uint32>  AlignmentLog2Distr(Desc.MinAlignmentLog2, Desc.MaxAlignmentLog2);
+        std::uniform_int_distribution<Uint32>  LifetimeDistr(1, Desc.MaxLifetime);
+
+        Trace NewTrace;
+        NewTrace.Name    = Desc.Name;
+        NewTrace.MaxSize = Desc.MaxSize;
+        NewTrace.Ops.reserve(size_t{NumAllocations} * 2);
+        // Allocations ordered by the index of the allocation before which they are released
+        std::multimap<Uint32, Uint32> ReleaseQueue;
+        for (Uint32 i = 0; i < NumAllocations; ++i)
+        {
+            while (!ReleaseQueue.empty() && ReleaseQueue.begin()->first <= i)
+            {
+                NewTrace.Ops.push_back(TraceOp{ReleaseQueue.begin()->second, 0, 0});
+                ReleaseQueue.erase(ReleaseQueue.begin());
+            }
+
+            auto Size      = static_cast<Uint32>(std::exp2(Desc.MinSizeLog2 + (Desc.MaxSizeLog2 - Desc.MinSizeLog2) * Distr01(Rng)));
+            auto Alignment = Uint32{1} << AlignmentLog2Distr(Rng);
+            NewTrace.Ops.push_back(TraceOp{i, std::max(Size, 1u), Alignment});
+            ReleaseQueue.emplace(i + LifetimeDistr(Rng), i);
+        }
+        for (const auto& Release : ReleaseQueue)
+            NewTrace.Ops.push_back(TraceOp{Release.second, 0, 0});
+
+        m_Traces.emplace_back(std::move(NewTrace));
+    }
+}
+
+template<typename ManagerType>
+bool AllocationsManagerBenchmark::Replay(const Trace& trace, bool Verify, AllocationsManagerResult& Result)
+{
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    ManagerType Mgr(static_cast<size_t>(trace.MaxSize), DefaultRawMemoryAllocator::GetAllocator());
+    std::vector<Allocation> Allocations(m_Settings.NumAllocations);
+    // Live allocations by unaligned offset, only used for verification
+    std::map<size_t, size_t> LiveRanges;
+
+    Result.FailedAllocations = 0;
+    bool Succeeded = true;
+    for (const auto& Op : trace.Ops)
+    {
+        auto& Alloc = Allocations[Op.Id];
+        if (Op.Size == 0)
+        {
+            if (Alloc.IsValid())
+            {
+                if (Verify)
+                    LiveRanges.erase(Alloc.UnalignedOffset);
+                Mgr.Free(std::move(Alloc));
+            }
+            continue;
+        }
+
+        Alloc = Mgr.Allocate(Op.Size, Op.Alignment);
+        if (!Alloc.IsValid())
+        {
+            ++Result.FailedAllocations;
+            continue;
+        }
+
+        if (Verify)
+        {
+            const auto Start = Alloc.UnalignedOffset;
+            const auto End   = Start + Alloc.Size;
+            bool IsValid = Align(Start, size_t{Op.Alignment}) + Op.Size <= End && End <= trace.MaxSize;
+            auto Next = LiveRanges.lower_bound(Start);
+            if (Next != LiveRanges.end() && Next->first < End)
+                IsValid = false;
+            if (Next != LiveRanges.begin() && std::prev(Next)->second > Start)
+                IsValid = false;
+            if (!IsValid)
+            {
+                LOG_ERROR_MESSAGE("Allocation ", Op.Id, " of trace '", trace.Name, "' is misaligned or overlaps another allocation");
+                Succeeded = false;
+                break;
+            }
+            LiveRanges.emplace(Start, End);
+        }
+    }
+
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+    if (!Mgr.IsEmpty())
+    {
+        LOG_ERROR_MESSAGE("Not all space has been released at the end of trace '", trace.Name, "'");
+        Succeeded = false;
+    }
+
+    return Succeeded;
+}
+
+bool AllocationsManagerBenchmark::Run(std::vector<AllocationsManagerResult>& Results)
+{
+    for (const auto& trace : m_Traces)
+    {
+        double TreeTime = 0;
+        for (int mgr = 0; mgr < 2; ++mgr)
+        {
+            AllocationsManagerResult Result;
+            Result.Trace   = trace.Name;
+            Result.Manager = mgr == 0 ? "tree" : "segregated_fit";
+
+            auto ReplayTrace = [&](bool Verify)
+            {
+                return mgr == 0 ?
+                    Replay<VariableSizeAllocationsManager> (trace, Verify, Result) :
+                    Replay<SegregatedFitAllocationsManager>(trace, Verify, Result);
+            };
+
+            if (!ReplayTrace(true))
+                return false;
+
+            double BestTime = 0;
+            for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+            {
+                Timer timer;
+                ReplayTrace(false);
+                auto RunTime = timer.GetElapsedTime();
+                BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+            }
+            if (mgr == 0)
+                TreeTime = BestTime;
+
+            // Allocations that failed are not released
+            const auto NumOperations = static_cast<double>(trace.Ops.size() - Result.FailedAllocations);
+            Result.Seconds             = BestTime;
+            Result.NsPerOperation      = BestTime * 1e+9 / NumOperations;
+            Result.OperationsPerSecond = BestTime > 0 ? NumOperations / BestTime : 0;
+            Result.Speedup             = BestTime > 0 ? TreeTime / BestTime : 0;
+            Results.emplace_back(std::move(Result));
+        }
+    }
+
+    return true;
+}
+
+}
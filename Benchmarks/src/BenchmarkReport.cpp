@@ -0,0 +1,516 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <iomanip>
+#include "BenchmarkReport.h"
+
+namespace Diligent
+{
+
+void WriteBenchmarkReport(std::ostream& Stream, const BenchmarkSettings& Settings, const std::vector<BenchmarkResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+    Stream << "  \"device\": \"Null\",\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"frames\": "          << Settings.NumFrames     << ",\n";
+    Stream << "  \"calls_per_frame\": " << Settings.CallsPerFrame << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the operations only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""            << Result.Name << "\", "
+               << "\"contexts\": "          << Result.NumContexts    << ", "
+               << "\"calls\": "             << Result.TotalCalls     << ", "
+               << "\"ns_per_call\": "       << Result.NsPerCall      << ", "
+               << "\"min_ns_per_call\": "   << Result.MinNsPerCall   << ", "
+               << "\"max_ns_per_call\": "   << Result.MaxNsPerCall   << ", "
+               << "\"calls_per_second\": "  << Result.CallsPerSecond
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteShaderCompilationReport(std::ostream& Stream, const ShaderCompilationSettings& Settings, const std::vector<ShaderCompilationResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(3);
+
+    Stream << "{\n";
+    Stream << "  \"compiler\": \"glslang\",\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"shaders\": " << Settings.NumShaders << ",\n";
+    Stream << "  \"runs\": "    << Settings.NumRuns    << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"threads\": "            << Result.NumThreads       << ", "
+               << "\"seconds\": "            << Result.Seconds          << ", "
+               << "\"shaders_per_second\": " << Result.ShadersPerSecond << ", "
+               << "\"speedup\": "            << Result.Speedup
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteBoxCullingReport(std::ostream& Stream, const BoxCullingSettings& Settings, const std::vector<BoxCullingResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(3);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"boxes\": " << Settings.NumBoxes << ",\n";
+    Stream << "  \"views\": " << Settings.NumViews << ",\n";
+    Stream << "  \"runs\": "  << Settings.NumRuns  << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the methods only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""           << Result.Name << "\", "
+               << "\"boxes\": "            << Result.NumBoxes       << ", "
+               << "\"seconds\": "          << Result.Seconds        << ", "
+               << "\"boxes_per_second\": " << Result.BoxesPerSecond << ", "
+               << "\"speedup\": "          << Result.Speedup
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteMatrixReport(std::ostream& Stream, const MatrixBenchmarkSettings& Settings, const std::vector<MatrixBenchmarkResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(6);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"elements\": " << Settings.NumElements << ",\n";
+    Stream << "  \"runs\": "     << Settings.NumRuns     << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the methods only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""              << Result.Name << "\", "
+               << "\"elements\": "            << Result.NumElements       << ", "
+               << "\"seconds\": "             << Result.Seconds           << ", "
+               << "\"elements_per_second\": " << Result.ElementsPerSecond << ", "
+               << "\"speedup\": "             << Result.Speedup
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteGLBindingReport(std::ostream& Stream, const GLBindingSettings& Settings, const std::vector<GLBindingResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(6);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"draws\": " << Settings.NumDraws << ",\n";
+    Stream << "  \"runs\": "  << Settings.NumRuns  << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the scenarios only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""                         << Result.Name << "\", "
+               << "\"draws\": "                          << Result.NumDraws                    << ", "
+               << "\"seconds\": "                        << Result.Seconds                     << ", "
+               << "\"ns_per_draw\": "                    << Result.NsPerDraw                   << ", "
+               << "\"uniform_block_bindings_per_draw\": " << Result.UniformBlockBindingsPerDraw << ", "
+               << "\"sampler_uniforms_per_draw\": "      << Result.SamplerUniformsPerDraw      << ", "
+               << "\"buffer_bindings_per_draw\": "       << Result.BufferBindingsPerDraw       << ", "
+               << "\"active_textures_per_draw\": "       << Result.ActiveTexturesPerDraw       << ", "
+               << "\"sampler_bindings_per_draw\": "      << Result.SamplerBindingsPerDraw
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteGLDynamicBufferReport(std::ostream& Stream, const GLDynamicBufferSettings& Settings, const std::vector<GLDynamicBufferResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(6);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"frames\": "          << Settings.NumFrames     << ",\n";
+    Stream << "  \"draws_per_frame\": " << Settings.DrawsPerFrame << ",\n";
+    Stream << "  \"buffers\": "         << Settings.NumBuffers    << ",\n";
+    Stream << "  \"runs\": "            << Settings.NumRuns       << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the scenarios only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""              << Result.Name << "\", "
+               << "\"dynamic_heap_size\": "  << Result.DynamicHeapSize << ", "
+               << "\"draws\": "              << Result.NumDraws        << ", "
+               << "\"seconds\": "            << Result.Seconds         << ", "
+               << "\"ns_per_draw\": "        << Result.NsPerDraw       << ", "
+               << "\"draws_per_second\": "   << Result.DrawsPerSecond  << ", "
+               << "\"speedup\": "            << Result.Speedup
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteGLDeferredReport(std::ostream& Stream, const GLDeferredSettings& Settings, const std::vector<GLDeferredResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(6);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"draws\": " << Settings.NumDraws << ",\n";
+    Stream << "  \"runs\": "  << Settings.NumRuns  << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the scenarios only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""            << Result.Name << "\", "
+               << "\"threads\": "          << Result.NumThreads     << ", "
+               << "\"draws\": "            << Result.NumDraws       << ", "
+               << "\"record_seconds\": "   << Result.RecordSeconds  << ", "
+               << "\"execute_seconds\": "  << Result.ExecuteSeconds << ", "
+               << "\"total_seconds\": "    << Result.TotalSeconds   << ", "
+               << "\"record_speedup\": "   << Result.RecordSpeedup  << ", "
+               << "\"speedup\": "          << Result.Speedup
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteGLVAOReport(std::ostream& Stream, const GLVAOSettings& Settings, const std::vector<GLVAOResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(6);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"draws\": "          << Settings.NumDraws         << ",\n";
+    Stream << "  \"vertex_buffers\": " << Settings.NumVertexBuffers << ",\n";
+    Stream << "  \"runs\": "           << Settings.NumRuns          << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        // Names of the scenarios only contain characters that do not need to be escaped
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"name\": \""             << Result.Name << "\", "
+               << "\"operations\": "        << Result.NumOperations << ", "
+               << "\"seconds\": "           << Result.Seconds       << ", "
+               << "\"ns_per_operation\": "  << Result.NsPerOperation
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteSamplerRegistryReport(std::ostream& Stream, const SamplerRegistrySettings& Settings, const std::vector<SamplerRegistryResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+    Stream << "  \"device\": \"Null\",\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"calls_per_thread\": " << Settings.CallsPerThread  << ",\n";
+    Stream << "  \"sampler_descs\": "    << Settings.NumSamplerDescs << ",\n";
+    Stream << "  \"runs\": "             << Settings.NumRuns         << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"threads\": "          << Result.NumThreads     << ", "
+               << "\"seconds\": "          << std::setprecision(6) << Result.Seconds << std::setprecision(2) << ", "
+               << "\"ns_per_call\": "      << Result.NsPerCall      << ", "
+               << "\"calls_per_second\": " << Result.CallsPerSecond
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteMemoryPageIndexReport(std::ostream& Stream, const MemoryPageIndexSettings& Settings, const std::vector<MemoryPageIndexResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"allocations\": "                    << Settings.NumAllocations               << ",\n";
+    Stream << "  \"page_size\": "                      << Settings.PageSize                     << ",\n";
+    Stream << "  \"dedicated_allocation_threshold\": " << Settings.DedicatedAllocationThreshold << ",\n";
+    Stream << "  \"allocations_per_frame\": "          << Settings.AllocationsPerFrame          << ",\n";
+    Stream << "  \"runs\": "                           << Settings.NumRuns                      << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"trace\": \""              << Result.Trace    << "\", "
+               << "\"strategy\": \""           << Result.Strategy << "\", "
+               << "\"seconds\": "               << std::setprecision(6) << Result.Seconds << std::setprecision(2) << ", "
+               << "\"ns_per_allocation\": "     << Result.NsPerAllocation      << ", "
+               << "\"allocations_per_second\": " << Result.AllocationsPerSecond << ", "
+               << "\"pages_created\": "         << Result.PagesCreated         << ", "
+               << "\"peak_pages\": "            << Result.PeakPages            << ", "
+               << "\"peak_allocated_size\": "   << Result.PeakAllocatedSize    << ", "
+               << "\"peak_used_size\": "        << Result.PeakUsedSize         << ", "
+               << "\"fragmentation\": "         << std::setprecision(4) << Result.Fragmentation << std::setprecision(2)
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteAllocationsManagerReport(std::ostream& Stream, const AllocationsManagerSettings& Settings, const std::vector<AllocationsManagerResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"allocations\": " << Settings.NumAllocations << ",\n";
+    Stream << "  \"runs\": "        << Settings.NumRuns        << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"trace\": \""               << Result.Trace   << "\", "
+               << "\"manager\": \""             << Result.Manager << "\", "
+               << "\"seconds\": "                << std::setprecision(6) << Result.Seconds << std::setprecision(2) << ", "
+               << "\"ns_per_operation\": "       << Result.NsPerOperation      << ", "
+               << "\"operations_per_second\": "  << Result.OperationsPerSecond << ", "
+               << "\"speedup\": "                << std::setprecision(3) << Result.Speedup << std::setprecision(2) << ", "
+               << "\"failed_allocations\": "     << Result.FailedAllocations
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteFixedBlockAllocatorReport(std::ostream& Stream, const FixedBlockAllocatorSettings& Settings, const std::vector<FixedBlockAllocatorResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"operations_per_thread\": " << Settings.OperationsPerThread << ",\n";
+    Stream << "  \"blocks_per_thread\": "     << Settings.BlocksPerThread     << ",\n";
+    Stream << "  \"block_size\": "            << Settings.BlockSize           << ",\n";
+    Stream << "  \"blocks_in_page\": "        << Settings.NumBlocksInPage     << ",\n";
+    Stream << "  \"runs\": "                  << Settings.NumRuns             << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"threads\": "                << Result.NumThreads << ", "
+               << "\"mode\": \""                 << Result.Mode       << "\", "
+               << "\"seconds\": "                << std::setprecision(6) << Result.Seconds << std::setprecision(2) << ", "
+               << "\"ns_per_operation\": "       << Result.NsPerOperation      << ", "
+               << "\"operations_per_second\": "  << Result.OperationsPerSecond << ", "
+               << "\"speedup\": "                << std::setprecision(3) << Result.Speedup << std::setprecision(2)
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+void WriteRingBufferReport(std::ostream& Stream, const RingBufferSettings& Settings, const std::vector<RingBufferResult>& Results)
+{
+    auto Flags = Stream.flags();
+    auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(2);
+
+    Stream << "{\n";
+#ifdef DEVELOPMENT
+    Stream << "  \"development\": true,\n";
+#else
+    Stream << "  \"development\": false,\n";
+#endif
+    Stream << "  \"allocations_per_thread\": " << Settings.AllocationsPerThread << ",\n";
+    Stream << "  \"buffer_size\": "            << Settings.BufferSize           << ",\n";
+    Stream << "  \"max_allocation_size\": "    << Settings.MaxAllocationSize    << ",\n";
+    Stream << "  \"alignment\": "              << Settings.Alignment            << ",\n";
+    Stream << "  \"frames_in_flight\": "       << Settings.FramesInFlight       << ",\n";
+    Stream << "  \"runs\": "                   << Settings.NumRuns              << ",\n";
+    Stream << "  \"results\": [";
+    for (size_t i = 0; i < Results.size(); ++i)
+    {
+        const auto& Result = Results[i];
+        Stream << (i > 0 ? ",\n" : "\n");
+        Stream << "    {"
+               << "\"threads\": "                << Result.NumThreads << ", "
+               << "\"mode\": \""                 << Result.Mode       << "\", "
+               << "\"seconds\": "                << std::setprecision(6) << Result.Seconds << std::setprecision(2) << ", "
+               << "\"ns_per_operation\": "       << Result.NsPerOperation      << ", "
+               << "\"operations_per_second\": "  << Result.OperationsPerSecond << ", "
+               << "\"speedup\": "                << std::setprecision(3) << Result.Speedup << std::setprecision(2) << ", "
+               << "\"full_buffer_retries\": "    << Result.FullBufferRetries
+               << "}";
+    }
+    Stream << "\n  ]\n";
+    Stream << "}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+}
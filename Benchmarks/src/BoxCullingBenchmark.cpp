@@ -0,0 +1,175 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+#include "BoxCullingBenchmark.h"
+#include "Timer.h"
+#include "Errors.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+BoxCullingBenchmark::BoxCullingBenchmark(const BoxCullingSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.NumBoxes > 0 && m_Settings.NumViews > 0 && m_Settings.NumRuns > 0);
+
+    const auto NumBoxes = m_Settings.NumBoxes;
+    m_Boxes.resize(NumBoxes);
+    m_MinX.resize(NumBoxes);
+    m_MaxX.resize(NumBoxes);
+    m_MinY.resize(NumBoxes);
+    m_MaxY.resize(NumBoxes);
+    m_MinZ.resize(NumBoxes);
+    m_MaxZ.resize(NumBoxes);
+    m_Visibility.resize(NumBoxes);
+    m_ReferenceVisibility.resize(NumBoxes);
+
+    // Fixed seed makes results comparable between runs
+    std::mt19937 Rng(0);
+    std::uniform_real_distribution<float> PosDistr(-500.f, 500.f);
+    std::uniform_real_distribution<float> SizeDistr(0.5f, 10.f);
+    for (Uint32 box = 0; box < NumBoxes; ++box)
+    {
+        auto& Box = m_Boxes[box];
+        Box.fMinX = PosDistr(Rng);
+        Box.fMinY = PosDistr(Rng) * 0.1f;
+        Box.fMinZ = PosDistr(Rng);
+        Box.fMaxX = Box.fMinX + SizeDistr(Rng);
+        Box.fMaxY = Box.fMinY + SizeDistr(Rng);
+        Box.fMaxZ = Box.fMinZ + SizeDistr(Rng);
+
+        m_MinX[box] = Box.fMinX;
+        m_MaxX[box] = Box.fMaxX;
+        m_MinY[box] = Box.fMinY;
+        m_MaxY[box] = Box.fMaxY;
+        m_MinZ[box] = Box.fMinZ;
+        m_MaxZ[box] = Box.fMaxZ;
+    }
+
+    m_BoxArrays.MinX = m_MinX.data();
+    m_BoxArrays.MaxX = m_MaxX.data();
+    m_BoxArrays.MinY = m_MinY.data();
+    m_BoxArrays.MaxY = m_MaxY.data();
+    m_BoxArrays.MinZ = m_MinZ.data();
+    m_BoxArrays.MaxZ = m_MaxZ.data();
+
+    // Camera is at the origin and turns around the vertical axis
+    const auto Proj = Projection(PI_F / 4.f, 16.f / 9.f, 1.f, 1000.f, false);
+    m_Views.resize(m_Settings.NumViews);
+    for (Uint32 view = 0; view < m_Settings.NumViews; ++view)
+    {
+        auto ViewProj = rotationY(2.f * PI_F * static_cast<float>(view) / static_cast<float>(m_Settings.NumViews)) * Proj;
+        ExtractViewFrustumPlanesFromMatrix(ViewProj, m_Views[view], false);
+    }
+}
+
+template<typename TCullViewFunc>
+double BoxCullingBenchmark::Measure(TCullViewFunc CullView)
+{
+    double BestTime = 0;
+    for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+    {
+        Timer timer;
+        for (const auto& View : m_Views)
+            CullView(View);
+        auto RunTime = timer.GetElapsedTime();
+        BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+    }
+    return BestTime;
+}
+
+bool BoxCullingBenchmark::Run(std::vector<BoxCullingResult>& Results)
+{
+    const size_t NumBoxes = m_Boxes.size();
+    const auto   TotalBoxes = static_cast<Uint64>(NumBoxes) * m_Views.size();
+
+    auto AddResult = [&](const char* Name, double Seconds, double ScalarSeconds)
+    {
+        BoxCullingResult Result;
+        Result.Name           = Name;
+        Result.NumBoxes       = TotalBoxes;
+        Result.Seconds        = Seconds;
+        Result.BoxesPerSecond = Seconds > 0 ? static_cast<double>(TotalBoxes) / Seconds : 0;
+        Result.Speedup        = Seconds > 0 ? ScalarSeconds / Seconds : 0;
+        Results.push_back(Result);
+    };
+
+    auto VerifyResults = [&](const char* Name)
+    {
+        // Every method writes the results for the last view
+        for (size_t box = 0; box < NumBoxes; ++box)
+        {
+            if (m_Visibility[box] != m_ReferenceVisibility[box])
+            {
+                LOG_ERROR_MESSAGE("Visibility of box ", box, " computed by ", Name, " (", Uint32{m_Visibility[box]}, 
+                                  ") differs from the scalar result (", Uint32{m_ReferenceVisibility[box]}, ")");
+                return false;
+            }
+        }
+        return true;
+    };
+
+    for (int Ext = 0; Ext < 2; ++Ext)
+    {
+        const char* ScalarName = Ext ? "GetBoxVisibility(ViewFrustumExt)"   : "GetBoxVisibility(ViewFrustum)";
+        const char* BatchName  = Ext ? "GetBoxesVisibility(ViewFrustumExt)" : "GetBoxesVisibility(ViewFrustum)";
+        std::cerr << "Culling " << TotalBoxes << " boxes with " << ScalarName << '\n';
+        auto ScalarTime = Measure(
+            [&](const ViewFrustumExt& View)
+            {
+                for (size_t box = 0; box < NumBoxes; ++box)
+                {
+                    auto Visibility = Ext ? 
+                        GetBoxVisibility<true>(View, m_Boxes[box]) : 
+                        GetBoxVisibility<true>(static_cast<const ViewFrustum&>(View), m_Boxes[box]);
+                    m_ReferenceVisibility[box] = static_cast<Uint8>(Visibility);
+                }
+            }
+        );
+        AddResult(ScalarName, ScalarTime, ScalarTime);
+
+        std::cerr << "Culling " << TotalBoxes << " boxes with " << BatchName << '\n';
+        auto BatchTime = Measure(
+            [&](const ViewFrustumExt& View)
+            {
+                if (Ext)
+                    GetBoxesVisibility(View, m_BoxArrays, NumBoxes, m_Visibility.data(), true);
+                else
+                    GetBoxesVisibility(static_cast<const ViewFrustum&>(View), m_BoxArrays, NumBoxes, m_Visibility.data(), true);
+            }
+        );
+        if (!VerifyResults(BatchName))
+            return false;
+        AddResult(BatchName, BatchTime, ScalarTime);
+    }
+
+    return true;
+}
+
+}
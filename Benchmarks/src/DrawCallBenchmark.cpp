@@ -0,0 +1,356 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include "DrawCallBenchmark.h"
+#include "RenderDeviceFactoryNull.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+DrawCallBenchmark::DrawCallBenchmark(const BenchmarkSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.MaxContexts > 0 && m_Settings.NumFrames > 0 && m_Settings.CallsPerFrame > 0);
+
+    auto* pFactoryNull = GetEngineFactoryNull();
+
+    EngineNullAttribs EngineAttribs;
+    std::vector<IDeviceContext*> ppContexts(1 + m_Settings.MaxContexts);
+    pFactoryNull->CreateDeviceAndContextsNull(EngineAttribs, &m_pDevice, ppContexts.data(), m_Settings.MaxContexts);
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Failed to create Null render device");
+
+    m_pImmediateContext.Attach(ppContexts[0]);
+    m_DeferredContexts.resize(m_Settings.MaxContexts);
+    for (Uint32 ctx = 0; ctx < m_Settings.MaxContexts; ++ctx)
+        m_DeferredContexts[ctx].Attach(ppContexts[1 + ctx]);
+
+    SwapChainDesc SCDesc;
+    SCDesc.Width  = 1280;
+    SCDesc.Height = 720;
+    pFactoryNull->CreateSwapChainNull(m_pDevice, m_pImmediateContext, SCDesc, &m_pSwapChain);
+
+    // The Null back-end does not reflect shader code: shader resources are the variables listed
+    // in the shader description
+    ShaderCreationAttribs CreationAttribs;
+    CreationAttribs.Source = "void main(){}";
+    CreationAttribs.Desc.DefaultVariableType = SHADER_VARIABLE_TYPE_MUTABLE;
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        // Constant buffer is changed by every IShaderVariable::Set() call, so it must be dynamic
+        ShaderVariableDesc Vars[] = 
+        {
+            {"cbConstants", SHADER_VARIABLE_TYPE_DYNAMIC}
+        };
+        CreationAttribs.Desc.Name         = "Benchmark VS";
+        CreationAttribs.Desc.ShaderType   = SHADER_TYPE_VERTEX;
+        CreationAttribs.Desc.VariableDesc = Vars;
+        CreationAttribs.Desc.NumVariables = _countof(Vars);
+        m_pDevice->CreateShader(CreationAttribs, &pVS);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderVariableDesc Vars[] = 
+        {
+            {"g_Texture", SHADER_VARIABLE_TYPE_MUTABLE}
+        };
+        CreationAttribs.Desc.Name         = "Benchmark PS";
+        CreationAttribs.Desc.ShaderType   = SHADER_TYPE_PIXEL;
+        CreationAttribs.Desc.VariableDesc = Vars;
+        CreationAttribs.Desc.NumVariables = _countof(Vars);
+        m_pDevice->CreateShader(CreationAttribs, &pPS);
+    }
+    if (!pVS || !pPS)
+        LOG_ERROR_AND_THROW("Failed to create benchmark shaders");
+
+    LayoutElement LayoutElems[] =
+    {
+        LayoutElement(0, 0, 3, VT_FLOAT32, False),
+        LayoutElement(1, 0, 2, VT_FLOAT32, False)
+    };
+
+    for (Uint32 i = 0; i < _countof(m_pPSO); ++i)
+    {
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = i == 0 ? "Benchmark PSO 0" : "Benchmark PSO 1";
+        auto& GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = pVS;
+        GraphicsPipeline.pPS = pPS;
+        GraphicsPipeline.NumRenderTargets = 1;
+        GraphicsPipeline.RTVFormats[0]    = m_pSwapChain->GetDesc().ColorBufferFormat;
+        GraphicsPipeline.DSVFormat        = m_pSwapChain->GetDesc().DepthBufferFormat;
+        GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+        GraphicsPipeline.InputLayout.NumElements    = _countof(LayoutElems);
+        GraphicsPipeline.RasterizerDesc.CullMode    = i == 0 ? CULL_MODE_BACK : CULL_MODE_NONE;
+        m_pDevice->CreatePipelineState(PSODesc, &m_pPSO[i]);
+        if (!m_pPSO[i])
+            LOG_ERROR_AND_THROW("Failed to create benchmark pipeline state");
+    }
+
+    for (Uint32 i = 0; i < _countof(m_pVertexBuffer); ++i)
+    {
+        std::vector<float> VertexData(5 * 1024);
+        BufferDesc VBDesc;
+        VBDesc.Name          = "Benchmark vertex buffer";
+        VBDesc.uiSizeInBytes = static_cast<Uint32>(VertexData.size() * sizeof(VertexData[0]));
+        VBDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        VBDesc.Usage         = USAGE_STATIC;
+        BufferData VBData;
+        VBData.pData    = VertexData.data();
+        VBData.DataSize = VBDesc.uiSizeInBytes;
+        m_pDevice->CreateBuffer(VBDesc, VBData, &m_pVertexBuffer[i]);
+
+        BufferDesc CBDesc;
+        CBDesc.Name           = "Benchmark constant buffer";
+        CBDesc.uiSizeInBytes  = 256;
+        CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        CBDesc.Usage          = USAGE_DYNAMIC;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, BufferData(), &m_pConstantBuffer[i]);
+
+        if (!m_pVertexBuffer[i] || !m_pConstantBuffer[i])
+            LOG_ERROR_AND_THROW("Failed to create benchmark buffers");
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Benchmark texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.MipLevels = 1;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    m_pDevice->CreateTexture(TexDesc, TextureData(), &m_pTexture);
+    if (!m_pTexture)
+        LOG_ERROR_AND_THROW("Failed to create benchmark texture");
+
+    m_SRBs.resize(m_Settings.MaxContexts);
+    m_ConstantsVariables.resize(m_Settings.MaxContexts);
+    for (Uint32 ctx = 0; ctx < m_Settings.MaxContexts; ++ctx)
+    {
+        m_pPSO[0]->CreateShaderResourceBinding(&m_SRBs[ctx]);
+        m_ConstantsVariables[ctx] = m_SRBs[ctx]->GetVariable(SHADER_TYPE_VERTEX, "cbConstants");
+        m_ConstantsVariables[ctx]->Set(m_pConstantBuffer[0]);
+        m_SRBs[ctx]->GetVariable(SHADER_TYPE_PIXEL, "g_Texture")->Set(m_pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    }
+}
+
+DrawCallBenchmark::~DrawCallBenchmark()
+{
+}
+
+const Char* DrawCallBenchmark::GetOperationName(OPERATION Operation)
+{
+    static_assert(OPERATION_NUM_OPERATIONS == 6, "Please update the switch below to handle the new operation");
+    switch (Operation)
+    {
+        case OPERATION_SET_PIPELINE_STATE:      return "IDeviceContext::SetPipelineState";
+        case OPERATION_COMMIT_SHADER_RESOURCES: return "IDeviceContext::CommitShaderResources";
+        case OPERATION_SET_VERTEX_BUFFERS:      return "IDeviceContext::SetVertexBuffers";
+        case OPERATION_DRAW:                    return "IDeviceContext::Draw";
+        case OPERATION_MAP_UNMAP:               return "IBuffer::Map/Unmap";
+        case OPERATION_SET_SHADER_VARIABLE:     return "IShaderVariable::Set";
+        default: UNEXPECTED("Unexpected operation"); return "<Unknown>";
+    }
+}
+
+void DrawCallBenchmark::PrepareContext(OPERATION Operation, Uint32 Ctx)
+{
+    auto* pCtx = m_DeferredContexts[Ctx].RawPtr();
+    pCtx->SetRenderTargets(0, nullptr, nullptr);
+    pCtx->SetPipelineState(m_pPSO[0]);
+    if (Operation == OPERATION_DRAW)
+    {
+        // Draw command verifies that dynamic buffers have been mapped in the current frame
+        PVoid pData = nullptr;
+        m_pConstantBuffer[0]->Map(pCtx, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        m_pConstantBuffer[0]->Unmap(pCtx, MAP_WRITE, MAP_FLAG_DISCARD);
+        pCtx->CommitShaderResources(m_SRBs[Ctx], COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES);
+        IBuffer* pBuffs[] = {m_pVertexBuffer[0]};
+        Uint32 Offsets[] = {0};
+        pCtx->SetVertexBuffers(0, 1, pBuffs, Offsets, SET_VERTEX_BUFFERS_FLAG_RESET);
+    }
+}
+
+double DrawCallBenchmark::RecordCalls(OPERATION Operation, Uint32 Ctx)
+{
+    auto* pCtx = m_DeferredContexts[Ctx].RawPtr();
+    const auto NumCalls = m_Settings.CallsPerFrame;
+
+    Timer timer;
+    switch (Operation)
+    {
+        case OPERATION_SET_PIPELINE_STATE:
+            for (Uint32 call = 0; call < NumCalls; ++call)
+                pCtx->SetPipelineState(m_pPSO[call & 0x01]);
+        break;
+
+        case OPERATION_COMMIT_SHADER_RESOURCES:
+        {
+            auto* pSRB = m_SRBs[Ctx].RawPtr();
+            for (Uint32 call = 0; call < NumCalls; ++call)
+                pCtx->CommitShaderResources(pSRB, COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES);
+        }
+        break;
+
+        case OPERATION_SET_VERTEX_BUFFERS:
+        {
+            IBuffer* pBuffs[] = {m_pVertexBuffer[0], m_pVertexBuffer[1]};
+            Uint32 Offsets[] = {0};
+            for (Uint32 call = 0; call < NumCalls; ++call)
+                pCtx->SetVertexBuffers(0, 1, &pBuffs[call & 0x01], Offsets, SET_VERTEX_BUFFERS_FLAG_RESET);
+        }
+        break;
+
+        case OPERATION_DRAW:
+        {
+            DrawAttribs DrawAttrs;
+            DrawAttrs.NumVertices = 3;
+            for (Uint32 call = 0; call < NumCalls; ++call)
+            {
+                DrawAttrs.StartVertexLocation = (call * 3) % 1024;
+                pCtx->Draw(DrawAttrs);
+            }
+        }
+        break;
+
+        case OPERATION_MAP_UNMAP:
+        {
+            auto* pBuffer = m_pConstantBuffer[0].RawPtr();
+            for (Uint32 call = 0; call < NumCalls; ++call)
+            {
+                PVoid pData = nullptr;
+                pBuffer->Map(pCtx, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+                if (pData != nullptr)
+                    *reinterpret_cast<Uint32*>(pData) = call;
+                pBuffer->Unmap(pCtx, MAP_WRITE, MAP_FLAG_DISCARD);
+            }
+        }
+        break;
+
+        case OPERATION_SET_SHADER_VARIABLE:
+        {
+            auto* pVar = m_ConstantsVariables[Ctx];
+            for (Uint32 call = 0; call < NumCalls; ++call)
+                pVar->Set(m_pConstantBuffer[call & 0x01]);
+        }
+        break;
+
+        default:
+            UNEXPECTED("Unexpected operation");
+    }
+    return timer.GetElapsedTime();
+}
+
+BenchmarkResult DrawCallBenchmark::MeasureOperation(OPERATION Operation, Uint32 NumContexts)
+{
+    std::vector<double> ContextTimes(NumContexts);
+    std::vector< RefCntAutoPtr<ICommandList> > CommandLists(NumContexts);
+    std::vector<std::thread> Threads(NumContexts);
+    double WallTime = 0;
+
+    for (Uint32 frame = 0; frame < m_Settings.NumFrames; ++frame)
+    {
+        std::atomic<Uint32> NumReadyThreads{0};
+        std::atomic<bool>   Start{false};
+        std::vector<double> FrameTimes(NumContexts);
+        for (Uint32 ctx = 0; ctx < NumContexts; ++ctx)
+        {
+            Threads[ctx] = std::thread(
+                [&, ctx]()
+                {
+                    PrepareContext(Operation, ctx);
+                    NumReadyThreads.fetch_add(1);
+                    // Start all contexts at the same time to measure contention
+                    while (!Start.load())
+                        std::this_thread::yield();
+                    FrameTimes[ctx] = RecordCalls(Operation, ctx);
+                    m_DeferredContexts[ctx]->FinishCommandList(&CommandLists[ctx]);
+                }
+            );
+        }
+
+        while (NumReadyThreads.load() < NumContexts)
+            std::this_thread::yield();
+        Start.store(true);
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        double FrameWallTime = 0;
+        for (Uint32 ctx = 0; ctx < NumContexts; ++ctx)
+        {
+            ContextTimes[ctx] += FrameTimes[ctx];
+            FrameWallTime = std::max(FrameWallTime, FrameTimes[ctx]);
+        }
+        WallTime += FrameWallTime;
+
+        for (auto& pCmdList : CommandLists)
+        {
+            m_pImmediateContext->ExecuteCommandList(pCmdList);
+            pCmdList.Release();
+        }
+        for (Uint32 ctx = 0; ctx < NumContexts; ++ctx)
+            m_DeferredContexts[ctx]->FinishFrame();
+        m_pSwapChain->Present(0);
+    }
+
+    BenchmarkResult Result;
+    Result.Name        = GetOperationName(Operation);
+    Result.NumContexts = NumContexts;
+    const auto CallsPerContext = Uint64{m_Settings.CallsPerFrame} * Uint64{m_Settings.NumFrames};
+    Result.TotalCalls  = CallsPerContext * NumContexts;
+
+    double TotalTime = 0;
+    double MinTime = ContextTimes[0];
+    double MaxTime = ContextTimes[0];
+    for (auto Time : ContextTimes)
+    {
+        TotalTime += Time;
+        MinTime = std::min(MinTime, Time);
+        MaxTime = std::max(MaxTime, Time);
+    }
+    Result.NsPerCall      = TotalTime * 1e+9 / static_cast<double>(Result.TotalCalls);
+    Result.MinNsPerCall   = MinTime   * 1e+9 / static_cast<double>(CallsPerContext);
+    Result.MaxNsPerCall   = MaxTime   * 1e+9 / static_cast<double>(CallsPerContext);
+    Result.CallsPerSecond = WallTime > 0 ? static_cast<double>(Result.TotalCalls) / WallTime : 0;
+    return Result;
+}
+
+void DrawCallBenchmark::Run(Uint32 NumContexts, std::vector<BenchmarkResult>& Results)
+{
+    VERIFY(NumContexts > 0 && NumContexts <= m_Settings.MaxContexts, "Number of contexts (", NumContexts, ") must be in range [1, ", m_Settings.MaxContexts, "]");
+    for (Uint32 Op = 0; Op < OPERATION_NUM_OPERATIONS; ++Op)
+        Results.push_back(MeasureOperation(static_cast<OPERATION>(Op), NumContexts));
+}
+
+}
@@ -0,0 +1,154 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+#include "FixedBlockAllocatorBenchmark.h"
+#include "FixedBlockMemoryAllocator.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+FixedBlockAllocatorBenchmark::FixedBlockAllocatorBenchmark(const FixedBlockAllocatorSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.OperationsPerThread > 0 && m_Settings.BlocksPerThread > 0 && m_Settings.NumRuns > 0);
+    VERIFY_EXPR(m_Settings.BlockSize >= sizeof(Uint64) && m_Settings.NumBlocksInPage > 0);
+}
+
+double FixedBlockAllocatorBenchmark::Measure(Uint32 NumThreads, bool ThreadCaching)
+{
+    const auto BlockSize = m_Settings.BlockSize;
+
+    double BestTime = -1;
+    for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+    {
+        FixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), BlockSize, m_Settings.NumBlocksInPage, ThreadCaching);
+
+        std::vector<std::vector<Uint64*>> LiveBlocks(NumThreads);
+        std::atomic<bool> Failed{false};
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+
+        Timer timer;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&, t]()
+                {
+                    auto& Blocks = LiveBlocks[t];
+                    Blocks.reserve(m_Settings.BlocksPerThread);
+                    std::mt19937 Rng(t);
+                    for (Uint32 op = 0; op < m_Settings.OperationsPerThread; ++op)
+                    {
+                        // Keep the number of live blocks around BlocksPerThread
+                        bool Allocate = Blocks.size() < m_Settings.BlocksPerThread / 2 || 
+                                        (Blocks.size() < m_Settings.BlocksPerThread && (Rng() & 0x01) != 0);
+                        if (Allocate)
+                        {
+                            auto* pBlock = reinterpret_cast<Uint64*>(Allocator.Allocate(BlockSize, "Benchmark block", __FILE__, __LINE__));
+                            pBlock[0] = Uint64{t} << 32 | op;
+                            Blocks.push_back(pBlock);
+                        }
+                        else
+                        {
+                            auto Ind = Rng() % Blocks.size();
+                            auto* pBlock = Blocks[Ind];
+                            if ((pBlock[0] >> 32) != t)
+                                Failed = true;
+                            Allocator.Free(pBlock);
+                            Blocks[Ind] = Blocks.back();
+                            Blocks.pop_back();
+                        }
+                    }
+                }
+            );
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+        auto RunTime = timer.GetElapsedTime();
+
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            for (auto* pBlock : LiveBlocks[t])
+            {
+                if ((pBlock[0] >> 32) != t)
+                    Failed = true;
+                Allocator.Free(pBlock);
+            }
+        }
+
+        if (Failed)
+        {
+            LOG_ERROR_MESSAGE("A block has been allocated twice");
+            return -1;
+        }
+        BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+    }
+    return BestTime;
+}
+
+bool FixedBlockAllocatorBenchmark::Run(std::vector<FixedBlockAllocatorResult>& Results)
+{
+    auto MaxThreads = m_Settings.MaxThreads != 0 ? m_Settings.MaxThreads : 32;
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    for (auto NumThreads : ThreadCounts)
+    {
+        std::cerr << "Allocating blocks from " << NumThreads << (NumThreads == 1 ? " thread\n" : " threads\n");
+
+        double MutexTime = 0;
+        for (bool ThreadCaching : {false, true})
+        {
+            auto Time = Measure(NumThreads, ThreadCaching);
+            if (Time < 0)
+                return false;
+            if (!ThreadCaching)
+                MutexTime = Time;
+
+            FixedBlockAllocatorResult Result;
+            Result.NumThreads          = NumThreads;
+            Result.Mode                = ThreadCaching ? "thread_cache" : "mutex";
+            Result.Seconds             = Time;
+            Result.NsPerOperation      = Time * 1e9 / m_Settings.OperationsPerThread;
+            Result.OperationsPerSecond = Time > 0 ? static_cast<double>(NumThreads) * m_Settings.OperationsPerThread / Time : 0;
+            Result.Speedup             = Time > 0 ? MutexTime / Time : 0;
+            Results.push_back(Result);
+        }
+    }
+
+    return true;
+}
+
+}
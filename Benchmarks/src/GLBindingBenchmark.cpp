@@ -0,0 +1,377 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <iostream>
+
+#ifndef GLEW_STATIC
+#   define GLEW_STATIC
+#endif
+#include "GL/glew.h"
+#include "GLBindingBenchmark.h"
+#include "OffscreenGLContext.h"
+#include "RenderDeviceFactoryOpenGL.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct GLCallCounters
+{
+    Uint64 UniformBlockBindings = 0;
+    Uint64 SamplerUniforms      = 0;
+    Uint64 BufferBindings       = 0;
+    Uint64 ActiveTextures       = 0;
+    Uint64 SamplerBindings      = 0;
+};
+GLCallCounters g_Counters;
+
+PFNGLUNIFORMBLOCKBINDINGPROC g_UniformBlockBinding = nullptr;
+PFNGLUNIFORM1IPROC           g_Uniform1i           = nullptr;
+PFNGLPROGRAMUNIFORM1IPROC    g_ProgramUniform1i    = nullptr;
+PFNGLBINDBUFFERBASEPROC      g_BindBufferBase      = nullptr;
+PFNGLBINDBUFFERRANGEPROC     g_BindBufferRange     = nullptr;
+PFNGLACTIVETEXTUREPROC       g_ActiveTexture       = nullptr;
+PFNGLBINDSAMPLERPROC         g_BindSampler         = nullptr;
+
+void GLAPIENTRY CountedUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+    ++g_Counters.UniformBlockBindings;
+    g_UniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+}
+
+void GLAPIENTRY CountedUniform1i(GLint location, GLint v0)
+{
+    ++g_Counters.SamplerUniforms;
+    g_Uniform1i(location, v0);
+}
+
+void GLAPIENTRY CountedProgramUniform1i(GLuint program, GLint location, GLint v0)
+{
+    ++g_Counters.SamplerUniforms;
+    g_ProgramUniform1i(program, location, v0);
+}
+
+void GLAPIENTRY CountedBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    ++g_Counters.BufferBindings;
+    g_BindBufferBase(target, index, buffer);
+}
+
+void GLAPIENTRY CountedBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    ++g_Counters.BufferBindings;
+    g_BindBufferRange(target, index, buffer, offset, size);
+}
+
+void GLAPIENTRY CountedActiveTexture(GLenum texture)
+{
+    ++g_Counters.ActiveTextures;
+    g_ActiveTexture(texture);
+}
+
+void GLAPIENTRY CountedBindSampler(GLuint unit, GLuint sampler)
+{
+    ++g_Counters.SamplerBindings;
+    g_BindSampler(unit, sampler);
+}
+
+// Replaces GLEW function pointers with the counting wrappers. Must be called after GLEW is initialized.
+void InstallCallCounters()
+{
+#define INSTALL_COUNTER(GlewFunc, Original, Counted) \
+    if (Original == nullptr && GlewFunc != nullptr)  \
+    {                                                \
+        Original = GlewFunc;                         \
+        GlewFunc = Counted;                          \
+    }
+
+    INSTALL_COUNTER(__glewUniformBlockBinding, g_UniformBlockBinding, CountedUniformBlockBinding)
+    INSTALL_COUNTER(__glewUniform1i,           g_Uniform1i,           CountedUniform1i)
+    INSTALL_COUNTER(__glewProgramUniform1i,    g_ProgramUniform1i,    CountedProgramUniform1i)
+    INSTALL_COUNTER(__glewBindBufferBase,      g_BindBufferBase,      CountedBindBufferBase)
+    INSTALL_COUNTER(__glewBindBufferRange,     g_BindBufferRange,     CountedBindBufferRange)
+    INSTALL_COUNTER(__glewActiveTexture,       g_ActiveTexture,       CountedActiveTexture)
+    INSTALL_COUNTER(__glewBindSampler,         g_BindSampler,         CountedBindSampler)
+#undef INSTALL_COUNTER
+}
+
+const char* VSSource = R"(
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+uniform cbTransform
+{
+    vec4 g_Offset;
+};
+
+uniform cbScale
+{
+    vec4 g_Scale;
+};
+
+void main()
+{
+    vec2 UV = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    gl_Position = vec4((UV * 2.0 - 1.0) * g_Scale.xy + g_Offset.xy, 0.0, 1.0);
+}
+)";
+
+const char* PSSource = R"(
+uniform cbMaterial
+{
+    vec4 g_Tint;
+};
+
+uniform sampler2D g_Texture0;
+uniform sampler2D g_Texture1;
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = g_Tint * texture(g_Texture0, vec2(0.5, 0.5)) + texture(g_Texture1, vec2(0.5, 0.5));
+}
+)";
+
+}
+
+struct GLBindingBenchmark::Impl
+{
+    // Must be destroyed after all engine objects
+    std::unique_ptr<OffscreenGLContext> pGLContext;
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    RefCntAutoPtr<ITexture>       pRenderTarget;
+    RefCntAutoPtr<IPipelineState> pPSO;
+
+    // Two sets of resources, so that switching between SRBs changes every binding
+    RefCntAutoPtr<IBuffer>                pConstantBuffers[2][3];
+    RefCntAutoPtr<ITexture>               pTextures[2][2];
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[2];
+
+    ~Impl()
+    {
+        // Engine objects must be released while the context is current
+        for (auto& pSRB : pSRBs)
+            pSRB.Release();
+        for (auto& Buffers : pConstantBuffers)
+            for (auto& pBuffer : Buffers)
+                pBuffer.Release();
+        for (auto& Textures : pTextures)
+            for (auto& pTexture : Textures)
+                pTexture.Release();
+        pPSO.Release();
+        pRenderTarget.Release();
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    void CreateResources()
+    {
+        ShaderCreationAttribs CreationAttribs;
+        CreationAttribs.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+        CreationAttribs.Desc.DefaultVariableType = SHADER_VARIABLE_TYPE_MUTABLE;
+
+        RefCntAutoPtr<IShader> pVS;
+        CreationAttribs.Source          = VSSource;
+        CreationAttribs.Desc.Name       = "GL binding benchmark VS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        pDevice->CreateShader(CreationAttribs, &pVS);
+
+        RefCntAutoPtr<IShader> pPS;
+        CreationAttribs.Source          = PSSource;
+        CreationAttribs.Desc.Name       = "GL binding benchmark PS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        pDevice->CreateShader(CreationAttribs, &pPS);
+        if (!pVS || !pPS)
+            LOG_ERROR_AND_THROW("Failed to create benchmark shaders");
+
+        TextureDesc RTDesc;
+        RTDesc.Name      = "GL binding benchmark render target";
+        RTDesc.Type      = RESOURCE_DIM_TEX_2D;
+        RTDesc.Width     = 64;
+        RTDesc.Height    = 64;
+        RTDesc.MipLevels = 1;
+        RTDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        RTDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(RTDesc, TextureData(), &pRenderTarget);
+        if (!pRenderTarget)
+            LOG_ERROR_AND_THROW("Failed to create render target");
+
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = "GL binding benchmark PSO";
+        auto& GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = pVS;
+        GraphicsPipeline.pPS = pPS;
+        GraphicsPipeline.NumRenderTargets  = 1;
+        GraphicsPipeline.RTVFormats[0]     = RTDesc.Format;
+        GraphicsPipeline.DSVFormat         = TEX_FORMAT_UNKNOWN;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+        if (!pPSO)
+            LOG_ERROR_AND_THROW("Failed to create benchmark pipeline state");
+
+        static const char* CBNames[] = {"cbTransform", "cbScale", "cbMaterial"};
+        static const SHADER_TYPE CBShaders[] = {SHADER_TYPE_VERTEX, SHADER_TYPE_VERTEX, SHADER_TYPE_PIXEL};
+        for (Uint32 set = 0; set < 2; ++set)
+        {
+            pPSO->CreateShaderResourceBinding(&pSRBs[set]);
+
+            const float CBData[4] = {0.25f, 0.25f, 0.25f, 1.f};
+            BufferDesc CBDesc;
+            CBDesc.Name          = "GL binding benchmark constant buffer";
+            CBDesc.uiSizeInBytes = sizeof(CBData);
+            CBDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+            CBDesc.Usage         = USAGE_DEFAULT;
+            BufferData InitData;
+            InitData.pData    = CBData;
+            InitData.DataSize = sizeof(CBData);
+            for (Uint32 cb = 0; cb < _countof(CBNames); ++cb)
+            {
+                pDevice->CreateBuffer(CBDesc, InitData, &pConstantBuffers[set][cb]);
+                if (!pConstantBuffers[set][cb])
+                    LOG_ERROR_AND_THROW("Failed to create constant buffer");
+                pSRBs[set]->GetVariable(CBShaders[cb], CBNames[cb])->Set(pConstantBuffers[set][cb]);
+            }
+
+            TextureDesc TexDesc;
+            TexDesc.Name      = "GL binding benchmark texture";
+            TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width     = 16;
+            TexDesc.Height    = 16;
+            TexDesc.MipLevels = 1;
+            TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+            for (Uint32 tex = 0; tex < 2; ++tex)
+            {
+                pDevice->CreateTexture(TexDesc, TextureData(), &pTextures[set][tex]);
+                if (!pTextures[set][tex])
+                    LOG_ERROR_AND_THROW("Failed to create texture");
+                pSRBs[set]->GetVariable(SHADER_TYPE_PIXEL, tex == 0 ? "g_Texture0" : "g_Texture1")->Set(pTextures[set][tex]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+            }
+        }
+    }
+};
+
+GLBindingBenchmark::GLBindingBenchmark(const GLBindingSettings& Settings) :
+    m_Settings(Settings),
+    m_pImpl(new Impl)
+{
+    VERIFY_EXPR(m_Settings.NumDraws > 0 && m_Settings.NumRuns > 0);
+
+    m_pImpl->pGLContext.reset(new OffscreenGLContext);
+
+    EngineGLAttribs EngineAttribs;
+    GetEngineFactoryOpenGL()->AttachToActiveGLContext(EngineAttribs, &m_pImpl->pDevice, &m_pImpl->pContext, 0);
+    if (!m_pImpl->pDevice)
+        LOG_ERROR_AND_THROW("Failed to create OpenGL render device");
+
+    // GLEW has been initialized by the engine
+    InstallCallCounters();
+
+    m_pImpl->CreateResources();
+}
+
+GLBindingBenchmark::~GLBindingBenchmark()
+{
+}
+
+bool GLBindingBenchmark::Run(std::vector<GLBindingResult>& Results)
+{
+    auto* pContext = m_pImpl->pContext.RawPtr();
+    const auto NumDraws = m_Settings.NumDraws;
+
+    ITextureView* pRTV[] = {m_pImpl->pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+    pContext->SetRenderTargets(1, pRTV, nullptr);
+    pContext->SetPipelineState(m_pImpl->pPSO);
+
+    DrawAttribs DrawAttrs;
+    DrawAttrs.NumVertices = 4;
+
+    for (int Alternate = 0; Alternate < 2; ++Alternate)
+    {
+        const char* Name = Alternate ? "Alternating SRBs" : "Same SRB";
+        std::cerr << "Drawing " << NumDraws << " times with " << Name << '\n';
+
+        double BestTime = 0;
+        GLCallCounters Counters;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            // Bind the first set, so that every run starts from the same state
+            pContext->CommitShaderResources(m_pImpl->pSRBs[0], COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES);
+            pContext->Draw(DrawAttrs);
+            pContext->Flush();
+            glFinish();
+
+            g_Counters = GLCallCounters();
+            Timer timer;
+            for (Uint32 draw = 0; draw < NumDraws; ++draw)
+            {
+                auto* pSRB = m_pImpl->pSRBs[Alternate ? (draw & 0x01) ^ 0x01 : 0].RawPtr();
+                pContext->CommitShaderResources(pSRB, COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES);
+                pContext->Draw(DrawAttrs);
+            }
+            auto RunTime = timer.GetElapsedTime();
+            Counters = g_Counters;
+
+            pContext->Flush();
+            glFinish();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        GLBindingResult Result;
+        Result.Name      = Name;
+        Result.NumDraws  = NumDraws;
+        Result.Seconds   = BestTime;
+        Result.NsPerDraw = BestTime * 1e+9 / NumDraws;
+        Result.UniformBlockBindingsPerDraw = static_cast<double>(Counters.UniformBlockBindings) / NumDraws;
+        Result.SamplerUniformsPerDraw      = static_cast<double>(Counters.SamplerUniforms)      / NumDraws;
+        Result.BufferBindingsPerDraw       = static_cast<double>(Counters.BufferBindings)       / NumDraws;
+        Result.ActiveTexturesPerDraw       = static_cast<double>(Counters.ActiveTextures)       / NumDraws;
+        Result.SamplerBindingsPerDraw      = static_cast<double>(Counters.SamplerBindings)      / NumDraws;
+        Results.push_back(Result);
+
+        if (Counters.UniformBlockBindings != 0 || Counters.SamplerUniforms != 0)
+        {
+            LOG_ERROR_MESSAGE(Name, ": ", Counters.UniformBlockBindings, " uniform block bindings and ", Counters.SamplerUniforms, 
+                              " sampler uniforms were set while drawing. Program bindings are expected to be assigned when programs are linked");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
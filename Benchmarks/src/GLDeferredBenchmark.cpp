@@ -0,0 +1,452 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+
+#ifndef GLEW_STATIC
+#   define GLEW_STATIC
+#endif
+#include "GL/glew.h"
+#include "GLDeferredBenchmark.h"
+#include "OffscreenGLContext.h"
+#include "RenderDeviceFactoryOpenGL.h"
+#include "TextureGL.h"
+#include "CommandList.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char* VSSource = R"(
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+uniform cbDraw
+{
+    vec4 g_Rect;
+    vec4 g_Color;
+};
+
+layout(location = 0) flat out vec4 vs_Color;
+
+void main()
+{
+    vec2 UV = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    gl_Position = vec4((UV * 2.0 - 1.0) * g_Rect.zw + g_Rect.xy, 0.0, 1.0);
+    vs_Color = g_Color;
+}
+)";
+
+const char* PSSource = R"(
+layout(location = 0) flat in vec4 vs_Color;
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = vs_Color;
+}
+)";
+
+const Uint32 RTSize = 64;
+
+// Pixel covered by the draw. Consecutive draws cover consecutive pixels, so every
+// pixel is overwritten by every RTSize * RTSize-th draw.
+Uint32 GetDrawPixel(Uint32 Draw)
+{
+    return Draw % (RTSize * RTSize);
+}
+
+// Color written by the draw, every component is a multiple of 1/255, so that the
+// color is exactly representable in the render target
+void GetDrawColor(Uint32 Draw, Uint8* RGBA)
+{
+    RGBA[0] = static_cast<Uint8>( Draw        & 0xFF);
+    RGBA[1] = static_cast<Uint8>((Draw >>  8) & 0xFF);
+    RGBA[2] = static_cast<Uint8>((Draw >> 16) & 0xFF);
+    RGBA[3] = 0xFF;
+}
+
+struct DrawConstants
+{
+    float Rect[4];
+    float Color[4];
+};
+
+}
+
+struct GLDeferredBenchmark::Impl
+{
+    // Must be destroyed after all engine objects
+    std::unique_ptr<OffscreenGLContext> pGLContext;
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    RefCntAutoPtr<ITexture>       pRenderTarget;
+    RefCntAutoPtr<IPipelineState> pPSO;
+
+    // Every deferred context maps its own buffer, the immediate context uses the first one
+    std::vector< RefCntAutoPtr<IDeviceContext> >         pDeferredContexts;
+    std::vector< RefCntAutoPtr<IBuffer> >                pBuffers;
+    std::vector< RefCntAutoPtr<IShaderResourceBinding> > pSRBs;
+
+    ~Impl()
+    {
+        // Engine objects must be released while the context is current
+        pSRBs.clear();
+        pBuffers.clear();
+        pDeferredContexts.clear();
+        pPSO.Release();
+        pRenderTarget.Release();
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    void CreateResources()
+    {
+        ShaderCreationAttribs CreationAttribs;
+        CreationAttribs.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+        CreationAttribs.Desc.DefaultVariableType = SHADER_VARIABLE_TYPE_MUTABLE;
+
+        RefCntAutoPtr<IShader> pVS;
+        CreationAttribs.Source          = VSSource;
+        CreationAttribs.Desc.Name       = "GL deferred benchmark VS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        pDevice->CreateShader(CreationAttribs, &pVS);
+
+        RefCntAutoPtr<IShader> pPS;
+        CreationAttribs.Source          = PSSource;
+        CreationAttribs.Desc.Name       = "GL deferred benchmark PS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        pDevice->CreateShader(CreationAttribs, &pPS);
+        if (!pVS || !pPS)
+            LOG_ERROR_AND_THROW("Failed to create benchmark shaders");
+
+        TextureDesc RTDesc;
+        RTDesc.Name      = "GL deferred benchmark render target";
+        RTDesc.Type      = RESOURCE_DIM_TEX_2D;
+        RTDesc.Width     = RTSize;
+        RTDesc.Height    = RTSize;
+        RTDesc.MipLevels = 1;
+        RTDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        RTDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(RTDesc, TextureData(), &pRenderTarget);
+        if (!pRenderTarget)
+            LOG_ERROR_AND_THROW("Failed to create render target");
+
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = "GL deferred benchmark PSO";
+        auto& GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = pVS;
+        GraphicsPipeline.pPS = pPS;
+        GraphicsPipeline.NumRenderTargets  = 1;
+        GraphicsPipeline.RTVFormats[0]     = RTDesc.Format;
+        GraphicsPipeline.DSVFormat         = TEX_FORMAT_UNKNOWN;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+        if (!pPSO)
+            LOG_ERROR_AND_THROW("Failed to create benchmark pipeline state");
+
+        BufferDesc CBDesc;
+        CBDesc.Name           = "GL deferred benchmark constant buffer";
+        CBDesc.uiSizeInBytes  = sizeof(DrawConstants);
+        CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        CBDesc.Usage          = USAGE_DYNAMIC;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        const auto NumBuffers = std::max(pDeferredContexts.size(), size_t{1});
+        pBuffers.resize(NumBuffers);
+        pSRBs.resize(NumBuffers);
+        for (size_t buff = 0; buff < NumBuffers; ++buff)
+        {
+            pDevice->CreateBuffer(CBDesc, BufferData(), &pBuffers[buff]);
+            if (!pBuffers[buff])
+                LOG_ERROR_AND_THROW("Failed to create constant buffer");
+            pPSO->CreateShaderResourceBinding(&pSRBs[buff]);
+            pSRBs[buff]->GetVariable(SHADER_TYPE_VERTEX, "cbDraw")->Set(pBuffers[buff]);
+        }
+    }
+
+    // Issues draws [FirstDraw, EndDraw) of the scene to the context
+    static bool DrawScene(IDeviceContext* pCtx, ITexture* pRenderTarget, IPipelineState* pPSO, IBuffer* pBuffer, 
+                          IShaderResourceBinding* pSRB, Uint32 FirstDraw, Uint32 EndDraw)
+    {
+        ITextureView* pRTV[] = {pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pCtx->SetRenderTargets(1, pRTV, nullptr);
+        pCtx->SetPipelineState(pPSO);
+
+        DrawAttribs DrawAttrs;
+        DrawAttrs.NumVertices = 4;
+        for (Uint32 draw = FirstDraw; draw < EndDraw; ++draw)
+        {
+            PVoid pData = nullptr;
+            pBuffer->Map(pCtx, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+            if (pData == nullptr)
+                return false;
+
+            const auto Pixel = GetDrawPixel(draw);
+            Uint8 RGBA[4];
+            GetDrawColor(draw, RGBA);
+            auto& Constants = *reinterpret_cast<DrawConstants*>(pData);
+            // The quad covers exactly one pixel
+            Constants.Rect[0] = (static_cast<float>(Pixel % RTSize) + 0.5f) * 2.f / RTSize - 1.f;
+            Constants.Rect[1] = (static_cast<float>(Pixel / RTSize) + 0.5f) * 2.f / RTSize - 1.f;
+            Constants.Rect[2] = 1.f / RTSize;
+            Constants.Rect[3] = 1.f / RTSize;
+            for (int c = 0; c < 4; ++c)
+                Constants.Color[c] = static_cast<float>(RGBA[c]) / 255.f;
+            pBuffer->Unmap(pCtx, MAP_WRITE, MAP_FLAG_DISCARD);
+
+            pCtx->CommitShaderResources(pSRB, 0);
+            pCtx->Draw(DrawAttrs);
+        }
+        return true;
+    }
+
+    void ClearRenderTarget()
+    {
+        ITextureView* pRTV[] = {pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pContext->SetRenderTargets(1, pRTV, nullptr);
+        const float Zero[4] = {};
+        pContext->ClearRenderTarget(pRTV[0], Zero);
+        pContext->Flush();
+        glFinish();
+    }
+
+    // Reads all render target pixels, the first row is the bottom one
+    bool ReadPixels(std::vector<Uint8>& Pixels)
+    {
+        RefCntAutoPtr<ITextureGL> pTextureGL;
+        pRenderTarget->QueryInterface(IID_TextureGL, reinterpret_cast<IObject**>(static_cast<ITextureGL**>(&pTextureGL)));
+        if (!pTextureGL)
+            return false;
+
+        Pixels.resize(RTSize * RTSize * 4);
+        GLuint FBO = 0;
+        glGenFramebuffers(1, &FBO);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pTextureGL->GetGLTextureHandle(), 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, RTSize, RTSize, GL_RGBA, GL_UNSIGNED_BYTE, Pixels.data());
+        bool Succeeded = glGetError() == GL_NO_ERROR;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &FBO);
+
+        // The context must not rely on the framebuffer bindings it has cached
+        pContext->InvalidateState();
+        return Succeeded;
+    }
+};
+
+GLDeferredBenchmark::GLDeferredBenchmark(const GLDeferredSettings& Settings) :
+    m_Settings(Settings),
+    m_pImpl(new Impl)
+{
+    VERIFY_EXPR(m_Settings.NumDraws > 0 && m_Settings.NumRuns > 0);
+
+    auto MaxThreads = m_Settings.MaxThreads;
+    if (MaxThreads == 0)
+        MaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    m_pImpl->pGLContext.reset(new OffscreenGLContext);
+
+    // The immediate context is followed by the deferred contexts
+    std::vector<IDeviceContext*> ppContexts(1 + MaxThreads);
+    EngineGLAttribs EngineAttribs;
+    GetEngineFactoryOpenGL()->AttachToActiveGLContext(EngineAttribs, &m_pImpl->pDevice, ppContexts.data(), MaxThreads);
+    if (!m_pImpl->pDevice)
+        LOG_ERROR_AND_THROW("Failed to create OpenGL render device");
+
+    // Take ownership of the references returned by the factory
+    m_pImpl->pContext.Attach(ppContexts[0]);
+    m_pImpl->pDeferredContexts.resize(MaxThreads);
+    for (Uint32 ctx = 0; ctx < MaxThreads; ++ctx)
+        m_pImpl->pDeferredContexts[ctx].Attach(ppContexts[1 + ctx]);
+
+    m_pImpl->CreateResources();
+}
+
+GLDeferredBenchmark::~GLDeferredBenchmark()
+{
+}
+
+bool GLDeferredBenchmark::Run(std::vector<GLDeferredResult>& Results)
+{
+    auto& Impl = *m_pImpl;
+    auto* pContext = Impl.pContext.RawPtr();
+    const auto NumDraws   = m_Settings.NumDraws;
+    const auto MaxThreads = static_cast<Uint32>(Impl.pDeferredContexts.size());
+
+    // Every pixel keeps the color of the last draw that covers it
+    std::vector<Uint8> ExpectedPixels(RTSize * RTSize * 4, 0);
+    for (Uint32 draw = NumDraws > RTSize * RTSize ? NumDraws - RTSize * RTSize : 0; draw < NumDraws; ++draw)
+        GetDrawColor(draw, &ExpectedPixels[GetDrawPixel(draw) * 4]);
+
+    std::vector<Uint8> Pixels;
+    auto VerifyImage = [&](const char* Name)
+    {
+        if (!Impl.ReadPixels(Pixels))
+        {
+            LOG_ERROR_MESSAGE(Name, ": failed to read the render target");
+            return false;
+        }
+        auto Mismatch = std::mismatch(Pixels.begin(), Pixels.end(), ExpectedPixels.begin());
+        if (Mismatch.first != Pixels.end())
+        {
+            const auto Pixel = static_cast<Uint32>(Mismatch.first - Pixels.begin()) / 4;
+            LOG_ERROR_MESSAGE(Name, ": pixel (", Pixel % RTSize, ", ", Pixel / RTSize, ") does not match the color written by the last draw that covers it");
+            return false;
+        }
+        return true;
+    };
+
+    std::cerr << "Drawing " << NumDraws << " quads on the immediate context\n";
+    double ImmediateTime = 0;
+    for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+    {
+        Impl.ClearRenderTarget();
+
+        Timer timer;
+        if (!Impl.DrawScene(pContext, Impl.pRenderTarget, Impl.pPSO, Impl.pBuffers[0], Impl.pSRBs[0], 0, NumDraws))
+        {
+            LOG_ERROR_MESSAGE("Failed to map the constant buffer in the immediate context");
+            return false;
+        }
+        pContext->Flush();
+        glFinish();
+        auto RunTime = timer.GetElapsedTime();
+        pContext->FinishFrame();
+
+        if (!VerifyImage("Immediate context"))
+            return false;
+        ImmediateTime = run == 0 ? RunTime : std::min(ImmediateTime, RunTime);
+    }
+
+    GLDeferredResult ImmediateResult;
+    ImmediateResult.Name           = "Immediate";
+    ImmediateResult.NumThreads     = 0;
+    ImmediateResult.NumDraws       = NumDraws;
+    ImmediateResult.ExecuteSeconds = ImmediateTime;
+    ImmediateResult.TotalSeconds   = ImmediateTime;
+    ImmediateResult.Speedup        = 1.0;
+    Results.push_back(ImmediateResult);
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    double SingleThreadRecordTime = 0;
+    for (auto NumThreads : ThreadCounts)
+    {
+        std::cerr << "Recording " << NumDraws << " quads on " << NumThreads << (NumThreads == 1 ? " deferred context\n" : " deferred contexts\n");
+
+        double BestRecordTime = 0, BestExecuteTime = 0, BestTotalTime = 0;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            Impl.ClearRenderTarget();
+
+            std::vector< RefCntAutoPtr<ICommandList> > pCommandLists(NumThreads);
+            std::atomic<bool> Failed{false};
+            std::vector<std::thread> Threads;
+            Threads.reserve(NumThreads);
+
+            Timer timer;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&Impl, &pCommandLists, &Failed, t, NumThreads, NumDraws]()
+                    {
+                        // Every thread records a contiguous range of draws, so that executing
+                        // the command lists in order reproduces the immediate submission
+                        const auto FirstDraw = static_cast<Uint32>(Uint64{NumDraws} *  t      / NumThreads);
+                        const auto EndDraw   = static_cast<Uint32>(Uint64{NumDraws} * (t + 1) / NumThreads);
+                        auto* pDeferredCtx = Impl.pDeferredContexts[t].RawPtr();
+                        if (!Impl.DrawScene(pDeferredCtx, Impl.pRenderTarget, Impl.pPSO, Impl.pBuffers[t], Impl.pSRBs[t], FirstDraw, EndDraw))
+                            Failed = true;
+                        pDeferredCtx->FinishCommandList(&pCommandLists[t]);
+                    }
+                );
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+            auto RecordTime = timer.GetElapsedTime();
+
+            if (Failed)
+            {
+                LOG_ERROR_MESSAGE("Failed to map the constant buffer in a deferred context");
+                return false;
+            }
+
+            Timer ExecuteTimer;
+            for (auto& pCommandList : pCommandLists)
+                pContext->ExecuteCommandList(pCommandList);
+            pContext->Flush();
+            glFinish();
+            auto ExecuteTime = ExecuteTimer.GetElapsedTime();
+            pCommandLists.clear();
+            pContext->FinishFrame();
+
+            if (!VerifyImage("Deferred contexts"))
+                return false;
+
+            if (run == 0 || RecordTime + ExecuteTime < BestTotalTime)
+            {
+                BestRecordTime  = RecordTime;
+                BestExecuteTime = ExecuteTime;
+                BestTotalTime   = RecordTime + ExecuteTime;
+            }
+        }
+
+        if (NumThreads == 1)
+            SingleThreadRecordTime = BestRecordTime;
+
+        GLDeferredResult Result;
+        Result.Name           = "Deferred";
+        Result.NumThreads     = NumThreads;
+        Result.NumDraws       = NumDraws;
+        Result.RecordSeconds  = BestRecordTime;
+        Result.ExecuteSeconds = BestExecuteTime;
+        Result.TotalSeconds   = BestTotalTime;
+        Result.RecordSpeedup  = BestRecordTime > 0 ? SingleThreadRecordTime / BestRecordTime : 0;
+        Result.Speedup        = BestTotalTime  > 0 ? ImmediateTime / BestTotalTime : 0;
+        Results.push_back(Result);
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,286 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <iostream>
+
+#ifndef GLEW_STATIC
+#   define GLEW_STATIC
+#endif
+#include "GL/glew.h"
+#include "GLDynamicBufferBenchmark.h"
+#include "OffscreenGLContext.h"
+#include "RenderDeviceFactoryOpenGL.h"
+#include "TextureGL.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char* VSSource = R"(
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    vec2 UV = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    gl_Position = vec4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* PSSource = R"(
+uniform cbColor
+{
+    vec4 g_Color;
+};
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = g_Color;
+}
+)";
+
+// Color written by the draw, every component is a multiple of 1/255, so that the
+// color is exactly representable in the render target
+void GetDrawColor(Uint32 Frame, Uint32 Draw, float* Color)
+{
+    Color[0] = static_cast<float>(Draw  & 0xFF) / 255.f;
+    Color[1] = static_cast<float>(Frame & 0xFF) / 255.f;
+    Color[2] = static_cast<float>((Draw >> 8) & 0xFF) / 255.f;
+    Color[3] = 1.f;
+}
+
+struct Scenario
+{
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    RefCntAutoPtr<ITexture>       pRenderTarget;
+    RefCntAutoPtr<IPipelineState> pPSO;
+
+    std::vector< RefCntAutoPtr<IBuffer> >                pBuffers;
+    std::vector< RefCntAutoPtr<IShaderResourceBinding> > pSRBs;
+
+    Scenario(Uint32 DynamicHeapSize, Uint32 NumBuffers)
+    {
+        EngineGLAttribs EngineAttribs;
+        EngineAttribs.DynamicHeapSize = DynamicHeapSize;
+        GetEngineFactoryOpenGL()->AttachToActiveGLContext(EngineAttribs, &pDevice, &pContext, 0);
+        if (!pDevice)
+            LOG_ERROR_AND_THROW("Failed to create OpenGL render device");
+
+        ShaderCreationAttribs CreationAttribs;
+        CreationAttribs.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+        CreationAttribs.Desc.DefaultVariableType = SHADER_VARIABLE_TYPE_MUTABLE;
+
+        RefCntAutoPtr<IShader> pVS;
+        CreationAttribs.Source          = VSSource;
+        CreationAttribs.Desc.Name       = "GL dynamic buffer benchmark VS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        pDevice->CreateShader(CreationAttribs, &pVS);
+
+        RefCntAutoPtr<IShader> pPS;
+        CreationAttribs.Source          = PSSource;
+        CreationAttribs.Desc.Name       = "GL dynamic buffer benchmark PS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        pDevice->CreateShader(CreationAttribs, &pPS);
+        if (!pVS || !pPS)
+            LOG_ERROR_AND_THROW("Failed to create benchmark shaders");
+
+        TextureDesc RTDesc;
+        RTDesc.Name      = "GL dynamic buffer benchmark render target";
+        RTDesc.Type      = RESOURCE_DIM_TEX_2D;
+        RTDesc.Width     = 16;
+        RTDesc.Height    = 16;
+        RTDesc.MipLevels = 1;
+        RTDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        RTDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(RTDesc, TextureData(), &pRenderTarget);
+        if (!pRenderTarget)
+            LOG_ERROR_AND_THROW("Failed to create render target");
+
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = "GL dynamic buffer benchmark PSO";
+        auto& GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = pVS;
+        GraphicsPipeline.pPS = pPS;
+        GraphicsPipeline.NumRenderTargets  = 1;
+        GraphicsPipeline.RTVFormats[0]     = RTDesc.Format;
+        GraphicsPipeline.DSVFormat         = TEX_FORMAT_UNKNOWN;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+        if (!pPSO)
+            LOG_ERROR_AND_THROW("Failed to create benchmark pipeline state");
+
+        BufferDesc CBDesc;
+        CBDesc.Name           = "GL dynamic buffer benchmark constant buffer";
+        CBDesc.uiSizeInBytes  = sizeof(float) * 4;
+        CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        CBDesc.Usage          = USAGE_DYNAMIC;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pBuffers.resize(NumBuffers);
+        pSRBs.resize(NumBuffers);
+        for (Uint32 buff = 0; buff < NumBuffers; ++buff)
+        {
+            pDevice->CreateBuffer(CBDesc, BufferData(), &pBuffers[buff]);
+            if (!pBuffers[buff])
+                LOG_ERROR_AND_THROW("Failed to create constant buffer");
+            pPSO->CreateShaderResourceBinding(&pSRBs[buff]);
+            pSRBs[buff]->GetVariable(SHADER_TYPE_PIXEL, "cbColor")->Set(pBuffers[buff]);
+        }
+    }
+
+    // Reads the color of the render target center
+    bool ReadCenterColor(Uint8* RGBA)
+    {
+        RefCntAutoPtr<ITextureGL> pTextureGL;
+        pRenderTarget->QueryInterface(IID_TextureGL, reinterpret_cast<IObject**>(static_cast<ITextureGL**>(&pTextureGL)));
+        if (!pTextureGL)
+            return false;
+
+        GLuint FBO = 0;
+        glGenFramebuffers(1, &FBO);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pTextureGL->GetGLTextureHandle(), 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        const auto& RTDesc = pRenderTarget->GetDesc();
+        glReadPixels(RTDesc.Width / 2, RTDesc.Height / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, RGBA);
+        bool Succeeded = glGetError() == GL_NO_ERROR;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &FBO);
+
+        // The context must not rely on the framebuffer bindings it has cached
+        pContext->InvalidateState();
+        return Succeeded;
+    }
+};
+
+}
+
+GLDynamicBufferBenchmark::GLDynamicBufferBenchmark(const GLDynamicBufferSettings& Settings) :
+    m_Settings(Settings),
+    m_pGLContext(new OffscreenGLContext)
+{
+    VERIFY_EXPR(m_Settings.NumFrames > 0 && m_Settings.DrawsPerFrame > 0 && m_Settings.NumBuffers > 0 && m_Settings.NumRuns > 0);
+}
+
+GLDynamicBufferBenchmark::~GLDynamicBufferBenchmark()
+{
+}
+
+bool GLDynamicBufferBenchmark::Run(std::vector<GLDynamicBufferResult>& Results)
+{
+    const auto NumFrames     = m_Settings.NumFrames;
+    const auto DrawsPerFrame = m_Settings.DrawsPerFrame;
+    const auto NumDraws      = NumFrames * DrawsPerFrame;
+
+    static const struct
+    {
+        const char* Name;
+        Uint32      DynamicHeapSize;
+    } Scenarios[] = 
+    {
+        {"glMapBufferRange", 0},
+        {"Dynamic heap",     EngineGLAttribs().DynamicHeapSize}
+    };
+
+    const auto FirstResult = Results.size();
+    for (const auto& ScenarioInfo : Scenarios)
+    {
+        std::cerr << "Drawing " << NumFrames << " frames of " << DrawsPerFrame << " draws with " << ScenarioInfo.Name << '\n';
+        Scenario Scn(ScenarioInfo.DynamicHeapSize, m_Settings.NumBuffers);
+        auto* pContext = Scn.pContext.RawPtr();
+
+        ITextureView* pRTV[] = {Scn.pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        DrawAttribs DrawAttrs;
+        DrawAttrs.NumVertices = 4;
+
+        double BestTime = 0;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            pContext->SetRenderTargets(1, pRTV, nullptr);
+            pContext->SetPipelineState(Scn.pPSO);
+            glFinish();
+
+            Timer timer;
+            for (Uint32 frame = 0; frame < NumFrames; ++frame)
+            {
+                for (Uint32 draw = 0; draw < DrawsPerFrame; ++draw)
+                {
+                    const auto BufferIndex = draw % m_Settings.NumBuffers;
+                    auto* pBuffer = Scn.pBuffers[BufferIndex].RawPtr();
+                    PVoid pData = nullptr;
+                    pBuffer->Map(pContext, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+                    GetDrawColor(frame, draw, reinterpret_cast<float*>(pData));
+                    pBuffer->Unmap(pContext, MAP_WRITE, MAP_FLAG_DISCARD);
+
+                    pContext->CommitShaderResources(Scn.pSRBs[BufferIndex], 0);
+                    pContext->Draw(DrawAttrs);
+                }
+                pContext->Flush();
+                pContext->FinishFrame();
+            }
+            glFinish();
+            auto RunTime = timer.GetElapsedTime();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        Uint8 RGBA[4] = {};
+        float ExpectedColor[4];
+        GetDrawColor(NumFrames - 1, DrawsPerFrame - 1, ExpectedColor);
+        bool ColorMatches = Scn.ReadCenterColor(RGBA);
+        for (int c = 0; c < 4 && ColorMatches; ++c)
+            ColorMatches = RGBA[c] == static_cast<Uint8>(ExpectedColor[c] * 255.f + 0.5f);
+        if (!ColorMatches)
+        {
+            LOG_ERROR_MESSAGE(ScenarioInfo.Name, ": rendered color (", Uint32{RGBA[0]}, ", ", Uint32{RGBA[1]}, ", ", Uint32{RGBA[2]}, ", ", Uint32{RGBA[3]}, 
+                              ") does not match the color written to the buffer by the last draw");
+            return false;
+        }
+
+        GLDynamicBufferResult Result;
+        Result.Name            = ScenarioInfo.Name;
+        Result.DynamicHeapSize = ScenarioInfo.DynamicHeapSize;
+        Result.NumDraws        = NumDraws;
+        Result.Seconds         = BestTime;
+        Result.NsPerDraw       = BestTime * 1e+9 / NumDraws;
+        Result.DrawsPerSecond  = NumDraws / BestTime;
+        Result.Speedup         = Results.size() > FirstResult ? Results[FirstResult].Seconds / BestTime : 1.0;
+        Results.push_back(Result);
+    }
+
+    return true;
+}
+
+}
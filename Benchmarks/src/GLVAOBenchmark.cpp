@@ -0,0 +1,378 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <iostream>
+
+#ifndef GLEW_STATIC
+#   define GLEW_STATIC
+#endif
+#include "GL/glew.h"
+#include "GLVAOBenchmark.h"
+#include "OffscreenGLContext.h"
+#include "RenderDeviceFactoryOpenGL.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char* VSSource = R"(
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+layout(location = 0) in vec2 in_Pos;
+layout(location = 1) in vec4 in_Color;
+
+out vec4 vs_Color;
+
+void main()
+{
+    gl_Position = vec4(in_Pos, 0.0, 1.0);
+    vs_Color = in_Color;
+}
+)";
+
+const char* PSSource = R"(
+in vec4 vs_Color;
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    out_Color = vs_Color;
+}
+)";
+
+}
+
+struct GLVAOBenchmark::Impl
+{
+    // Must be destroyed after all engine objects
+    std::unique_ptr<OffscreenGLContext> pGLContext;
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    RefCntAutoPtr<ITexture>       pRenderTarget;
+    RefCntAutoPtr<IPipelineState> pPSO;
+
+    // Positions are taken from one of the buffers, colors always come from the same buffer
+    std::vector< RefCntAutoPtr<IBuffer> > pPositionBuffers;
+    RefCntAutoPtr<IBuffer>                pColorBuffer;
+
+    ~Impl()
+    {
+        pPositionBuffers.clear();
+        pColorBuffer.Release();
+        pPSO.Release();
+        pRenderTarget.Release();
+        pContext.Release();
+        pDevice.Release();
+    }
+
+    RefCntAutoPtr<IBuffer> CreatePositionBuffer()
+    {
+        static const float Positions[] = {-1.f, -1.f,  -1.f, +1.f,  +1.f, -1.f};
+
+        BufferDesc VBDesc;
+        VBDesc.Name          = "GL VAO benchmark position buffer";
+        VBDesc.uiSizeInBytes = sizeof(Positions);
+        VBDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        VBDesc.Usage         = USAGE_STATIC;
+        BufferData InitData;
+        InitData.pData    = Positions;
+        InitData.DataSize = sizeof(Positions);
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(VBDesc, InitData, &pBuffer);
+        if (!pBuffer)
+            LOG_ERROR_AND_THROW("Failed to create vertex buffer");
+        return pBuffer;
+    }
+
+    void CreateResources(Uint32 NumVertexBuffers)
+    {
+        ShaderCreationAttribs CreationAttribs;
+        CreationAttribs.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+
+        RefCntAutoPtr<IShader> pVS;
+        CreationAttribs.Source          = VSSource;
+        CreationAttribs.Desc.Name       = "GL VAO benchmark VS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        pDevice->CreateShader(CreationAttribs, &pVS);
+
+        RefCntAutoPtr<IShader> pPS;
+        CreationAttribs.Source          = PSSource;
+        CreationAttribs.Desc.Name       = "GL VAO benchmark PS";
+        CreationAttribs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        pDevice->CreateShader(CreationAttribs, &pPS);
+        if (!pVS || !pPS)
+            LOG_ERROR_AND_THROW("Failed to create benchmark shaders");
+
+        TextureDesc RTDesc;
+        RTDesc.Name      = "GL VAO benchmark render target";
+        RTDesc.Type      = RESOURCE_DIM_TEX_2D;
+        RTDesc.Width     = 16;
+        RTDesc.Height    = 16;
+        RTDesc.MipLevels = 1;
+        RTDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        RTDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(RTDesc, TextureData(), &pRenderTarget);
+        if (!pRenderTarget)
+            LOG_ERROR_AND_THROW("Failed to create render target");
+
+        LayoutElement LayoutElems[] =
+        {
+            LayoutElement(0, 0, 2, VT_FLOAT32, False),
+            LayoutElement(1, 1, 4, VT_FLOAT32, False)
+        };
+
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = "GL VAO benchmark PSO";
+        auto& GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = pVS;
+        GraphicsPipeline.pPS = pPS;
+        GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+        GraphicsPipeline.InputLayout.NumElements    = _countof(LayoutElems);
+        GraphicsPipeline.NumRenderTargets  = 1;
+        GraphicsPipeline.RTVFormats[0]     = RTDesc.Format;
+        GraphicsPipeline.DSVFormat         = TEX_FORMAT_UNKNOWN;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+        if (!pPSO)
+            LOG_ERROR_AND_THROW("Failed to create benchmark pipeline state");
+
+        pPositionBuffers.resize(NumVertexBuffers);
+        for (auto& pBuffer : pPositionBuffers)
+            pBuffer = CreatePositionBuffer();
+
+        static const float Colors[] = 
+        {
+            1.f, 0.f, 0.f, 1.f,
+            0.f, 1.f, 0.f, 1.f,
+            0.f, 0.f, 1.f, 1.f
+        };
+        BufferDesc VBDesc;
+        VBDesc.Name          = "GL VAO benchmark color buffer";
+        VBDesc.uiSizeInBytes = sizeof(Colors);
+        VBDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        VBDesc.Usage         = USAGE_STATIC;
+        BufferData InitData;
+        InitData.pData    = Colors;
+        InitData.DataSize = sizeof(Colors);
+        pDevice->CreateBuffer(VBDesc, InitData, &pColorBuffer);
+        if (!pColorBuffer)
+            LOG_ERROR_AND_THROW("Failed to create vertex buffer");
+    }
+
+    void Draw(IBuffer* pPositionBuffer)
+    {
+        IBuffer* pBuffers[] = {pPositionBuffer, pColorBuffer};
+        Uint32 Offsets[] = {0, 0};
+        pContext->SetVertexBuffers(0, _countof(pBuffers), pBuffers, Offsets, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        DrawAttribs DrawAttrs;
+        DrawAttrs.NumVertices = 3;
+        pContext->Draw(DrawAttrs);
+    }
+};
+
+GLVAOBenchmark::GLVAOBenchmark(const GLVAOSettings& Settings) :
+    m_Settings(Settings),
+    m_pImpl(new Impl)
+{
+    VERIFY_EXPR(m_Settings.NumDraws > 0 && m_Settings.NumVertexBuffers > 0 && m_Settings.NumRuns > 0);
+
+    m_pImpl->pGLContext.reset(new OffscreenGLContext);
+
+    EngineGLAttribs EngineAttribs;
+    GetEngineFactoryOpenGL()->AttachToActiveGLContext(EngineAttribs, &m_pImpl->pDevice, &m_pImpl->pContext, 0);
+    if (!m_pImpl->pDevice)
+        LOG_ERROR_AND_THROW("Failed to create OpenGL render device");
+
+    m_pImpl->CreateResources(m_Settings.NumVertexBuffers);
+}
+
+GLVAOBenchmark::~GLVAOBenchmark()
+{
+}
+
+bool GLVAOBenchmark::Run(std::vector<GLVAOResult>& Results)
+{
+    auto& Impl = *m_pImpl;
+    auto* pContext = Impl.pContext.RawPtr();
+    const auto NumDraws = m_Settings.NumDraws;
+    const auto NumVertexBuffers = m_Settings.NumVertexBuffers;
+
+    ITextureView* pRTV[] = {Impl.pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+    pContext->SetRenderTargets(1, pRTV, nullptr);
+    pContext->SetPipelineState(Impl.pPSO);
+
+    // Create VAOs for all buffers, so that draw scenarios only measure cache hits
+    for (auto& pBuffer : Impl.pPositionBuffers)
+        Impl.Draw(pBuffer);
+    pContext->Flush();
+    glFinish();
+
+    enum class DrawMode
+    {
+        NoLookup,
+        SameBuffers,
+        CyclingBuffers
+    };
+    static const struct
+    {
+        const char* Name;
+        DrawMode    Mode;
+    } DrawScenarios[] =
+    {
+        {"No VAO lookup",          DrawMode::NoLookup},
+        {"Same vertex buffers",    DrawMode::SameBuffers},
+        {"Cycling vertex buffers", DrawMode::CyclingBuffers}
+    };
+
+    for (const auto& Scenario : DrawScenarios)
+    {
+        std::cerr << "Drawing " << NumDraws << " times: " << Scenario.Name << '\n';
+
+        double BestTime = 0;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            // Without the lookup, the VAO set up by this draw is used by all measured draws
+            Impl.Draw(Impl.pPositionBuffers[0]);
+            DrawAttribs DrawAttrs;
+            DrawAttrs.NumVertices = 3;
+
+            Timer timer;
+            for (Uint32 draw = 0; draw < NumDraws; ++draw)
+            {
+                switch (Scenario.Mode)
+                {
+                    case DrawMode::NoLookup:       pContext->Draw(DrawAttrs);                                  break;
+                    case DrawMode::SameBuffers:    Impl.Draw(Impl.pPositionBuffers[0]);                        break;
+                    case DrawMode::CyclingBuffers: Impl.Draw(Impl.pPositionBuffers[draw % NumVertexBuffers]); break;
+                }
+            }
+            auto RunTime = timer.GetElapsedTime();
+
+            pContext->Flush();
+            glFinish();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        GLVAOResult Result;
+        Result.Name           = Scenario.Name;
+        Result.NumOperations  = NumDraws;
+        Result.Seconds        = BestTime;
+        Result.NsPerOperation = BestTime * 1e+9 / NumDraws;
+        Results.push_back(Result);
+    }
+
+    {
+        const char* Name = "Buffer release";
+        std::cerr << "Releasing " << NumDraws << " vertex buffers referenced by cached VAOs\n";
+
+        double BestTime = 0;
+        std::vector< RefCntAutoPtr<IBuffer> > pTempBuffers(NumDraws);
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            for (auto& pBuffer : pTempBuffers)
+            {
+                pBuffer = Impl.CreatePositionBuffer();
+                Impl.Draw(pBuffer);
+            }
+            // The context keeps the last buffer bound
+            Impl.Draw(Impl.pPositionBuffers[0]);
+            pContext->Flush();
+            glFinish();
+
+            // The cache may evict VAOs of released buffers when the next draw looks it up,
+            // so the draw is measured as well
+            Timer timer;
+            for (auto& pBuffer : pTempBuffers)
+                pBuffer.Release();
+            Impl.Draw(Impl.pPositionBuffers[1 % NumVertexBuffers]);
+            auto RunTime = timer.GetElapsedTime();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        GLVAOResult Result;
+        Result.Name           = Name;
+        Result.NumOperations  = NumDraws;
+        Result.Seconds        = BestTime;
+        Result.NsPerOperation = BestTime * 1e+9 / NumDraws;
+        Results.push_back(Result);
+    }
+
+    {
+        const char* Name = "Buffer release per draw";
+        std::cerr << "Releasing one of " << NumDraws << " vertex buffers referenced by cached VAOs before every draw\n";
+
+        double BestTime = 0;
+        std::vector< RefCntAutoPtr<IBuffer> > pTempBuffers(NumDraws);
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            for (auto& pBuffer : pTempBuffers)
+            {
+                pBuffer = Impl.CreatePositionBuffer();
+                Impl.Draw(pBuffer);
+            }
+            Impl.Draw(Impl.pPositionBuffers[0]);
+            pContext->Flush();
+            glFinish();
+
+            // Every draw evicts the VAO of one released buffer from the cache that holds
+            // VAOs of all remaining buffers
+            Timer timer;
+            for (Uint32 draw = 0; draw < NumDraws; ++draw)
+            {
+                pTempBuffers[draw].Release();
+                Impl.Draw(Impl.pPositionBuffers[draw % NumVertexBuffers]);
+            }
+            auto RunTime = timer.GetElapsedTime();
+
+            pContext->Flush();
+            glFinish();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        GLVAOResult Result;
+        Result.Name           = Name;
+        Result.NumOperations  = NumDraws;
+        Result.Seconds        = BestTime;
+        Result.NsPerOperation = BestTime * 1e+9 / NumDraws;
+        Results.push_back(Result);
+    }
+
+    return true;
+}
+
+}
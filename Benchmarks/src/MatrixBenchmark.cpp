@@ -0,0 +1,214 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <random>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <functional>
+
+#include "MatrixBenchmark.h"
+#include "Timer.h"
+#include "Errors.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+MatrixBenchmark::MatrixBenchmark(const MatrixBenchmarkSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.NumElements > 0 && m_Settings.NumRuns > 0);
+
+    const auto NumElements = m_Settings.NumElements;
+    m_Left.resize(NumElements);
+    m_Right.resize(NumElements);
+    m_Points.resize(NumElements);
+    m_Matrices.resize(NumElements);
+    m_ReferenceMatrices.resize(NumElements);
+    m_Vectors.resize(NumElements);
+    m_ReferenceVectors.resize(NumElements);
+
+    // Fixed seed makes results comparable between runs
+    std::mt19937 Rng(0);
+    std::uniform_real_distribution<float> AngleDistr(0.f, 2.f * PI_F);
+    std::uniform_real_distribution<float> PosDistr(-500.f, 500.f);
+    std::uniform_real_distribution<float> ScaleDistr(0.5f, 2.f);
+    auto RandomTransform = [&]()
+    {
+        return scaleMatrix(ScaleDistr(Rng), ScaleDistr(Rng), ScaleDistr(Rng)) *
+               rotationY(AngleDistr(Rng)) * rotationX(AngleDistr(Rng)) *
+               translationMatrix(PosDistr(Rng), PosDistr(Rng), PosDistr(Rng));
+    };
+    for (Uint32 i = 0; i < NumElements; ++i)
+    {
+        m_Left[i]   = RandomTransform();
+        m_Right[i]  = RandomTransform();
+        m_Points[i] = float3(PosDistr(Rng), PosDistr(Rng), PosDistr(Rng));
+    }
+
+    m_ViewProj = rotationY(PI_F / 3.f) * translationMatrix(0, -10, 100) * Projection(PI_F / 4.f, 16.f / 9.f, 1.f, 1000.f, false);
+}
+
+template<typename TFunc>
+double MatrixBenchmark::Measure(TFunc Func)
+{
+    double BestTime = 0;
+    for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+    {
+        Timer timer;
+        Func();
+        auto RunTime = timer.GetElapsedTime();
+        BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+    }
+    return BestTime;
+}
+
+bool MatrixBenchmark::Run(std::vector<MatrixBenchmarkResult>& Results)
+{
+    const size_t NumElements = m_Settings.NumElements;
+
+    auto AddResult = [&](const char* Name, double Seconds, double ScalarSeconds)
+    {
+        MatrixBenchmarkResult Result;
+        Result.Name              = Name;
+        Result.NumElements       = NumElements;
+        Result.Seconds           = Seconds;
+        Result.ElementsPerSecond = Seconds > 0 ? static_cast<double>(NumElements) / Seconds : 0;
+        Result.Speedup           = Seconds > 0 ? ScalarSeconds / Seconds : 0;
+        Results.push_back(Result);
+    };
+
+    // The results must be identical, so the comparison is bitwise
+    auto VerifyResults = [&](const char* Name, const void* pResults, const void* pReference, size_t ElementSize)
+    {
+        const auto* pRes = reinterpret_cast<const Uint8*>(pResults);
+        const auto* pRef = reinterpret_cast<const Uint8*>(pReference);
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            if (memcmp(pRes + i * ElementSize, pRef + i * ElementSize, ElementSize) != 0)
+            {
+                LOG_ERROR_MESSAGE("Element ", i, " computed by ", Name, " differs from the scalar result");
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto MeasureMatrices = [&](const char* ScalarName, const char* BulkName, const std::function<void()>& Scalar, const std::function<void()>& Bulk)
+    {
+        std::cerr << "Processing " << NumElements << " matrices with " << ScalarName << '\n';
+        auto ScalarTime = Measure(Scalar);
+        AddResult(ScalarName, ScalarTime, ScalarTime);
+
+        std::cerr << "Processing " << NumElements << " matrices with " << BulkName << '\n';
+        auto BulkTime = Measure(Bulk);
+        if (!VerifyResults(BulkName, m_Matrices.data(), m_ReferenceMatrices.data(), sizeof(float4x4)))
+            return false;
+        AddResult(BulkName, BulkTime, ScalarTime);
+        return true;
+    };
+
+    auto MeasureVectors = [&](const char* ScalarName, const char* BulkName, const std::function<void()>& Scalar, const std::function<void()>& Bulk)
+    {
+        std::cerr << "Processing " << NumElements << " vectors with " << ScalarName << '\n';
+        auto ScalarTime = Measure(Scalar);
+        AddResult(ScalarName, ScalarTime, ScalarTime);
+
+        std::cerr << "Processing " << NumElements << " vectors with " << BulkName << '\n';
+        auto BulkTime = Measure(Bulk);
+        if (!VerifyResults(BulkName, m_Vectors.data(), m_ReferenceVectors.data(), sizeof(float3)))
+            return false;
+        AddResult(BulkName, BulkTime, ScalarTime);
+        return true;
+    };
+
+    if (!MeasureMatrices("mul(float4x4, float4x4)", "MultiplyMatrices(float4x4*, float4x4*)",
+            [&]()
+            {
+                for (size_t i = 0; i < NumElements; ++i)
+                    m_ReferenceMatrices[i] = mul(m_Left[i], m_Right[i]);
+            },
+            [&]()
+            {
+                MultiplyMatrices(m_Left.data(), m_Right.data(), NumElements, m_Matrices.data());
+            }))
+        return false;
+
+    if (!MeasureMatrices("mul(float4x4, ViewProj)", "MultiplyMatrices(float4x4*, ViewProj)",
+            [&]()
+            {
+                for (size_t i = 0; i < NumElements; ++i)
+                    m_ReferenceMatrices[i] = mul(m_Left[i], m_ViewProj);
+            },
+            [&]()
+            {
+                MultiplyMatrices(m_Left.data(), m_ViewProj, NumElements, m_Matrices.data());
+            }))
+        return false;
+
+    if (!MeasureMatrices("inverseMatrix()", "InvertMatrices()",
+            [&]()
+            {
+                for (size_t i = 0; i < NumElements; ++i)
+                    m_ReferenceMatrices[i] = inverseMatrix(m_Left[i]);
+            },
+            [&]()
+            {
+                InvertMatrices(m_Left.data(), NumElements, m_Matrices.data());
+            }))
+        return false;
+
+    if (!MeasureVectors("float3 * float4x4", "TransformPoints()",
+            [&]()
+            {
+                for (size_t i = 0; i < NumElements; ++i)
+                    m_ReferenceVectors[i] = m_Points[i] * m_ViewProj;
+            },
+            [&]()
+            {
+                TransformPoints(m_Points.data(), NumElements, m_ViewProj, m_Vectors.data());
+            }))
+        return false;
+
+    if (!MeasureVectors("float4(float3, 0) * float4x4", "TransformNormals()",
+            [&]()
+            {
+                for (size_t i = 0; i < NumElements; ++i)
+                {
+                    const auto& n = m_Points[i];
+                    auto v = float4(n.x, n.y, n.z, 0) * m_Left[0];
+                    m_ReferenceVectors[i] = float3(v.x, v.y, v.z);
+                }
+            },
+            [&]()
+            {
+                TransformNormals(m_Points.data(), NumElements, m_Left[0], m_Vectors.data());
+            }))
+        return false;
+
+    return true;
+}
+
+}
@@ -0,0 +1,342 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <random>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+#include "MemoryPageIndexBenchmark.h"
+#include "VariableSizeAllocationsManager.h"
+#include "PageFreeSpaceIndex.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Align.h"
+#include "Timer.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+MemoryPageIndexBenchmark::MemoryPageIndexBenchmark(const MemoryPageIndexSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.NumAllocations > 0 && m_Settings.PageSize > 0 && m_Settings.AllocationsPerFrame > 0 && m_Settings.NumRuns > 0);
+
+    struct TraceDesc
+    {
+        const char* Name;
+        // Fraction of allocations that are textures
+        double TextureFraction;
+        // Fraction of allocations that live for a long time, such as level resources
+        double LongLivedFraction;
+    };
+    static const TraceDesc TraceDescs[] = 
+    {
+        {"buffers",   0.00, 0.0},
+        {"mixed",     0.15, 0.0},
+        {"streaming", 0.15, 0.5}
+    };
+
+    const auto NumAllocations = m_Settings.NumAllocations;
+    for (const auto& Desc : TraceDescs)
+    {
+        // Fixed seed makes results comparable between runs
+        std::mt19937 Rng(0);
+        std::uniform_real_distribution<double> Distr01(0.0, 1.0);
+        // Sizes are distributed log-uniformly: buffers take from 256 bytes to 256 KB,
+        // textures take from 64 KB to 32 MB
+        auto RandomSize = [&](double MinLog2, double MaxLog2)
+        {
+            return static_cast<Uint64>(std::exp2(MinLog2 + (MaxLog2 - MinLog2) * Distr01(Rng)));
+        };
+        std::uniform_int_distribution<Uint32> ShortLifetimeDistr(1, 4096);
+        std::uniform_int_distribution<Uint32> LongLifetimeDistr(std::max(NumAllocations / 4, 1u), std::max(NumAllocations / 2, 1u));
+
+        Trace NewTrace;
+        NewTrace.Name = Desc.Name;
+        NewTrace.Ops.resize(NumAllocations);
+        // Allocations ordered by the index of the operation that releases them
+        std::multimap<Uint32, Uint32> ReleaseQueue;
+        for (Uint32 i = 0; i < NumAllocations; ++i)
+        {
+            auto& Op = NewTrace.Ops[i];
+            while (!ReleaseQueue.empty() && ReleaseQueue.begin()->first <= i)
+            {
+                Op.Released.push_back(ReleaseQueue.begin()->second);
+                ReleaseQueue.erase(ReleaseQueue.begin());
+            }
+
+            Op.Id = i;
+            if (Distr01(Rng) < Desc.TextureFraction)
+            {
+                Op.Size      = RandomSize(16, 25);
+                Op.Alignment = 65536;
+            }
+            else
+            {
+                Op.Size      = RandomSize(8, 18);
+                Op.Alignment = 256;
+            }
+            auto Lifetime = Distr01(Rng) < Desc.LongLivedFraction ? LongLifetimeDistr(Rng) : ShortLifetimeDistr(Rng);
+            ReleaseQueue.emplace(i + Lifetime, i);
+        }
+        m_Traces.emplace_back(std::move(NewTrace));
+    }
+}
+
+namespace
+{
+
+struct TracePage
+{
+    TracePage(size_t Size, bool _IsDedicated) :
+        AllocationMgr(Size, DefaultRawMemoryAllocator::GetAllocator()),
+        IsDedicated  (_IsDedicated)
+    {}
+
+    VariableSizeAllocationsManager AllocationMgr;
+    const bool IsDedicated;
+};
+
+struct TraceAllocation
+{
+    TracePage* pPage           = nullptr;
+    size_t     UnalignedOffset = 0;
+    size_t     Size            = 0;
+};
+
+}
+
+bool MemoryPageIndexBenchmark::Replay(const Trace& trace, Strategy strategy, MemoryPageIndexResult& Result)
+{
+    std::vector<std::unique_ptr<TracePage>> Pages;
+    PageFreeSpaceIndex<TracePage>           FreeSpaceIndex;
+    bool                                    IsIndexStale = false;
+    std::vector<TraceAllocation>            Allocations(trace.Ops.size());
+
+    const bool UseIndex     = strategy != Strategy::FirstFit;
+    const bool UseDedicated = strategy == Strategy::BestFitDedicated && m_Settings.DedicatedAllocationThreshold != 0;
+
+    Uint64 CurrAllocatedSize = 0;
+    Uint64 CurrUsedSize      = 0;
+    double FragmentationSum  = 0;
+    Uint32 NumFrames         = 0;
+    Result.PagesCreated      = 0;
+    Result.PeakPages         = 0;
+    Result.PeakAllocatedSize = 0;
+    Result.PeakUsedSize      = 0;
+
+    auto CreatePage = [&](size_t PageSize, bool IsDedicated) -> TracePage&
+    {
+        Pages.emplace_back(new TracePage{PageSize, IsDedicated});
+        CurrAllocatedSize += PageSize;
+        ++Result.PagesCreated;
+        Result.PeakPages         = std::max(Result.PeakPages, static_cast<Uint32>(Pages.size()));
+        Result.PeakAllocatedSize = std::max(Result.PeakAllocatedSize, CurrAllocatedSize);
+        return *Pages.back();
+    };
+
+    auto Release = [&](TraceAllocation& Allocation)
+    {
+        Allocation.pPage->AllocationMgr.Free(Allocation.UnalignedOffset, Allocation.Size);
+        if (!Allocation.pPage->IsDedicated)
+            IsIndexStale = true;
+        CurrUsedSize -= Allocation.Size;
+        Allocation = TraceAllocation{};
+    };
+
+    auto RefreshFreeSpaceIndex = [&]()
+    {
+        if (!IsIndexStale)
+            return false;
+        FreeSpaceIndex.Refresh([](TracePage& Page){ return Page.AllocationMgr.GetFreeSize(); });
+        IsIndexStale = false;
+        return true;
+    };
+
+    // Releases empty pages the same way VulkanMemoryManager::ShrinkMemory() does with zero reserve size
+    auto ShrinkMemory = [&]()
+    {
+        if (UseIndex)
+            RefreshFreeSpaceIndex();
+        for (size_t i = 0; i < Pages.size(); )
+        {
+            auto& Page = *Pages[i];
+            if (Page.AllocationMgr.IsEmpty())
+            {
+                CurrAllocatedSize -= Page.AllocationMgr.GetMaxSize();
+                if (UseIndex && !Page.IsDedicated)
+                    FreeSpaceIndex.RemovePage(&Page);
+                if (UseIndex)
+                {
+                    std::swap(Pages[i], Pages.back());
+                }
+                else
+                {
+                    // First fit depends on the page order
+                    std::rotate(Pages.begin() + i, Pages.begin() + i + 1, Pages.end());
+                }
+                Pages.pop_back();
+            }
+            else
+                ++i;
+        }
+    };
+
+    bool Succeeded = true;
+    for (size_t op = 0; op < trace.Ops.size(); ++op)
+    {
+        const auto& Op = trace.Ops[op];
+        for (auto Id : Op.Released)
+            Release(Allocations[Id]);
+
+        const auto Size      = static_cast<size_t>(Op.Size);
+        const auto Alignment = static_cast<size_t>(Op.Alignment);
+        VariableSizeAllocationsManager::Allocation Allocation;
+        TracePage* pPage = nullptr;
+        if (UseDedicated && Size >= m_Settings.DedicatedAllocationThreshold)
+        {
+            pPage = &CreatePage(Align(Size, Alignment), true);
+            Allocation = pPage->AllocationMgr.Allocate(Size, Alignment);
+        }
+        else
+        {
+            if (UseIndex)
+            {
+                auto TryAllocate = [&](TracePage& Page)
+                {
+                    Allocation = Page.AllocationMgr.Allocate(Size, Alignment);
+                    return Allocation.Size;
+                };
+                // The same refresh policy as in VulkanMemoryManager::Allocate()
+                pPage = FreeSpaceIndex.Allocate(Size, TryAllocate);
+                if (pPage == nullptr && RefreshFreeSpaceIndex())
+                    pPage = FreeSpaceIndex.Allocate(Size, TryAllocate);
+            }
+            else
+            {
+                for (auto& Page : Pages)
+                {
+                    Allocation = Page->AllocationMgr.Allocate(Size, Alignment);
+                    if (Allocation.IsValid())
+                    {
+                        pPage = Page.get();
+                        break;
+                    }
+                }
+            }
+
+            if (pPage == nullptr)
+            {
+                size_t PageSize = m_Settings.PageSize;
+                while (PageSize < Size)
+                    PageSize *= 2;
+                pPage = &CreatePage(PageSize, false);
+                Allocation = pPage->AllocationMgr.Allocate(Size, Alignment);
+                if (UseIndex)
+                    FreeSpaceIndex.AddPage(pPage, PageSize - Allocation.Size);
+            }
+        }
+
+        if (!Allocation.IsValid() || 
+            Align(Allocation.UnalignedOffset, Alignment) + Size > Allocation.UnalignedOffset + Allocation.Size ||
+            Allocation.UnalignedOffset + Allocation.Size > pPage->AllocationMgr.GetMaxSize())
+        {
+            LOG_ERROR_MESSAGE("Allocation ", Op.Id, " of trace '", trace.Name, "' failed or does not fit into its page");
+            Succeeded = false;
+            break;
+        }
+
+        Allocations[Op.Id] = TraceAllocation{pPage, Allocation.UnalignedOffset, Allocation.Size};
+        CurrUsedSize += Allocation.Size;
+        Result.PeakUsedSize = std::max(Result.PeakUsedSize, CurrUsedSize);
+
+        if ((op + 1) % m_Settings.AllocationsPerFrame == 0)
+        {
+            ShrinkMemory();
+            if (CurrAllocatedSize > 0)
+            {
+                FragmentationSum += 1.0 - static_cast<double>(CurrUsedSize) / static_cast<double>(CurrAllocatedSize);
+                ++NumFrames;
+            }
+        }
+    }
+
+    for (auto& Allocation : Allocations)
+    {
+        if (Allocation.pPage != nullptr)
+            Release(Allocation);
+    }
+    for (const auto& Page : Pages)
+    {
+        if (!Page->AllocationMgr.IsEmpty())
+        {
+            LOG_ERROR_MESSAGE("Not all memory in a page of trace '", trace.Name, "' has been released");
+            Succeeded = false;
+        }
+    }
+
+    Result.Fragmentation = NumFrames > 0 ? FragmentationSum / NumFrames : 0;
+    return Succeeded;
+}
+
+bool MemoryPageIndexBenchmark::Run(std::vector<MemoryPageIndexResult>& Results)
+{
+    static const std::pair<Strategy, const char*> Strategies[] =
+    {
+        {Strategy::FirstFit,         "first_fit"},
+        {Strategy::BestFit,          "best_fit"},
+        {Strategy::BestFitDedicated, "best_fit_dedicated"}
+    };
+
+    for (const auto& trace : m_Traces)
+    {
+        for (const auto& strategy : Strategies)
+        {
+            MemoryPageIndexResult Result;
+            Result.Trace    = trace.Name;
+            Result.Strategy = strategy.second;
+            double BestTime = 0;
+            for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+            {
+                Timer timer;
+                if (!Replay(trace, strategy.first, Result))
+                    return false;
+                auto RunTime = timer.GetElapsedTime();
+                BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+            }
+
+            const auto NumAllocations = static_cast<double>(trace.Ops.size());
+            Result.Seconds              = BestTime;
+            Result.NsPerAllocation      = BestTime * 1e+9 / NumAllocations;
+            Result.AllocationsPerSecond = BestTime > 0 ? NumAllocations / BestTime : 0;
+            Results.emplace_back(std::move(Result));
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,131 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#ifndef GLEW_STATIC
+#   define GLEW_STATIC
+#endif
+#include "GL/glew.h"
+#include <GL/glx.h>
+
+// Undefine defines from GL/glx.h -> X11/Xlib.h that conflict with the engine types
+#ifdef Bool
+#   undef Bool
+#endif
+#ifdef True
+#   undef True
+#endif
+#ifdef False
+#   undef False
+#endif
+#ifdef Status
+#   undef Status
+#endif
+#ifdef Success
+#   undef Success
+#endif
+
+#include "OffscreenGLContext.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+struct OffscreenGLContext::GLXObjects
+{
+    Display*    pDisplay = nullptr;
+    GLXContext  Context  = nullptr;
+    GLXPbuffer  PBuffer  = 0;
+
+    ~GLXObjects()
+    {
+        if (pDisplay != nullptr)
+        {
+            glXMakeContextCurrent(pDisplay, 0, 0, nullptr);
+            if (PBuffer != 0)
+                glXDestroyPbuffer(pDisplay, PBuffer);
+            if (Context != nullptr)
+                glXDestroyContext(pDisplay, Context);
+            XCloseDisplay(pDisplay);
+        }
+    }
+};
+
+OffscreenGLContext::OffscreenGLContext() : 
+    m_pGLX(new GLXObjects)
+{
+    auto& GLX = *m_pGLX;
+    GLX.pDisplay = XOpenDisplay(nullptr);
+    if (GLX.pDisplay == nullptr)
+        LOG_ERROR_AND_THROW("Failed to open X display. Run the benchmark under an X server, e.g. xvfb-run");
+
+    static const int FBConfigAttribs[] =
+    {
+        GLX_DRAWABLE_TYPE, GLX_PBUFFER_BIT,
+        GLX_RENDER_TYPE,   GLX_RGBA_BIT,
+        GLX_RED_SIZE,      8,
+        GLX_GREEN_SIZE,    8,
+        GLX_BLUE_SIZE,     8,
+        GLX_ALPHA_SIZE,    8,
+        None
+    };
+    int NumConfigs = 0;
+    GLXFBConfig* pConfigs = glXChooseFBConfig(GLX.pDisplay, DefaultScreen(GLX.pDisplay), FBConfigAttribs, &NumConfigs);
+    if (pConfigs == nullptr || NumConfigs == 0)
+        LOG_ERROR_AND_THROW("Failed to find suitable GLX frame buffer configuration");
+    auto FBConfig = pConfigs[0];
+    XFree(pConfigs);
+
+    auto glXCreateContextAttribsARB = reinterpret_cast<PFNGLXCREATECONTEXTATTRIBSARBPROC>(
+        glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB")));
+    if (glXCreateContextAttribsARB == nullptr)
+        LOG_ERROR_AND_THROW("glXCreateContextAttribsARB is not supported");
+
+    // Shaders are compiled with #version 430 core
+    static const int ContextAttribs[] =
+    {
+        GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
+        GLX_CONTEXT_MINOR_VERSION_ARB, 3,
+        GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+        None
+    };
+    GLX.Context = glXCreateContextAttribsARB(GLX.pDisplay, FBConfig, nullptr, 1, ContextAttribs);
+    if (GLX.Context == nullptr)
+        LOG_ERROR_AND_THROW("Failed to create OpenGL 4.3 core context");
+
+    static const int PBufferAttribs[] =
+    {
+        GLX_PBUFFER_WIDTH,  16,
+        GLX_PBUFFER_HEIGHT, 16,
+        None
+    };
+    GLX.PBuffer = glXCreatePbuffer(GLX.pDisplay, FBConfig, PBufferAttribs);
+    if (!glXMakeContextCurrent(GLX.pDisplay, GLX.PBuffer, GLX.PBuffer, GLX.Context))
+        LOG_ERROR_AND_THROW("Failed to make GL context current");
+}
+
+OffscreenGLContext::~OffscreenGLContext()
+{
+}
+
+}
@@ -0,0 +1,249 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <iostream>
+
+#include "RingBufferBenchmark.h"
+#include "RingBuffer.h"
+#include "DynamicHeap.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Ring buffer guarded by a single mutex, as MasterBlockRingBufferBasedManager
+// was implemented before it moved to ConcurrentRingBuffer
+class MutexRingBufferManager
+{
+public:
+    using OffsetType = RingBuffer::OffsetType;
+    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+
+    MutexRingBufferManager(IMemoryAllocator& Allocator, Uint32 Size) :
+        m_RingBuffer(Size, Allocator)
+    {}
+
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        return m_RingBuffer.Allocate(Size, Alignment);
+    }
+
+    void FinishFrame(Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        m_RingBuffer.FinishCurrentFrame(FenceValue);
+    }
+
+    void ReleaseFrames(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        m_RingBuffer.ReleaseCompletedFrames(CompletedFenceValue);
+    }
+
+    bool IsEmpty()
+    {
+        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        return m_RingBuffer.IsEmpty();
+    }
+
+private:
+    std::mutex m_RingBufferMtx;
+    RingBuffer m_RingBuffer;
+};
+
+// Exposes master block allocation of the lock-free manager used by dynamic heaps
+class ConcurrentRingBufferManager : public DynamicHeap::MasterBlockRingBufferBasedManager
+{
+public:
+    ConcurrentRingBufferManager(IMemoryAllocator& Allocator, Uint32 Size) :
+        MasterBlockRingBufferBasedManager(Allocator, Size)
+    {}
+
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        return AllocateMasterBlock(Size, Alignment);
+    }
+
+    void FinishFrame(Uint64 FenceValue)
+    {
+        DiscardMasterBlocks(m_Blocks, FenceValue);
+    }
+
+    void ReleaseFrames(Uint64 CompletedFenceValue)
+    {
+        ReleaseStaleBlocks(CompletedFenceValue);
+    }
+
+    bool IsEmpty()const
+    {
+        return GetUsedSize() == 0;
+    }
+
+private:
+    // Ring buffer manager does not track individual blocks
+    std::vector<MasterBlock> m_Blocks;
+};
+
+}
+
+RingBufferBenchmark::RingBufferBenchmark(const RingBufferSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.AllocationsPerThread > 0 && m_Settings.NumRuns > 0 && m_Settings.FramesInFlight > 0);
+    VERIFY_EXPR(IsPowerOfTwo(m_Settings.Alignment) && m_Settings.MaxAllocationSize >= m_Settings.Alignment && m_Settings.BufferSize >= m_Settings.MaxAllocationSize);
+}
+
+template<typename ManagerType>
+double RingBufferBenchmark::Measure(Uint32 NumThreads, Uint64& FullBufferRetries)
+{
+    const Uint32 MaxAllocationUnits = m_Settings.MaxAllocationSize / m_Settings.Alignment;
+
+    double BestTime = -1;
+    for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+    {
+        ManagerType Mgr(DefaultRawMemoryAllocator::GetAllocator(), m_Settings.BufferSize);
+
+        std::atomic<bool>   Failed{false};
+        std::atomic<Uint32> NumActiveThreads{NumThreads};
+        std::atomic<Uint64> NumRetries{0};
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+
+        Timer timer;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&, t]()
+                {
+                    std::mt19937 Rng(t);
+                    Uint64 Retries = 0;
+                    for (Uint32 i = 0; i < m_Settings.AllocationsPerThread; ++i)
+                    {
+                        size_t Size = (Rng() % MaxAllocationUnits + 1) * m_Settings.Alignment;
+                        auto Offset = Mgr.Allocate(Size, m_Settings.Alignment);
+                        while (Offset == ManagerType::InvalidOffset)
+                        {
+                            // The buffer is full: wait for the frame thread to release old frames
+                            ++Retries;
+                            std::this_thread::yield();
+                            Offset = Mgr.Allocate(Size, m_Settings.Alignment);
+                        }
+                        if ((Offset % m_Settings.Alignment) != 0 || Offset + Size > m_Settings.BufferSize)
+                            Failed = true;
+                    }
+                    NumRetries += Retries;
+                    --NumActiveThreads;
+                }
+            );
+        }
+
+        // Finish frames and release the ones the emulated GPU has completed
+        Uint64 FenceValue = 0;
+        while (NumActiveThreads.load() > 0)
+        {
+            ++FenceValue;
+            Mgr.FinishFrame(FenceValue);
+            if (FenceValue > m_Settings.FramesInFlight)
+                Mgr.ReleaseFrames(FenceValue - m_Settings.FramesInFlight);
+            std::this_thread::yield();
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+        auto RunTime = timer.GetElapsedTime();
+
+        ++FenceValue;
+        Mgr.FinishFrame(FenceValue);
+        Mgr.ReleaseFrames(FenceValue);
+
+        if (Failed)
+        {
+            LOG_ERROR_MESSAGE("A master block is misaligned or out of the buffer bounds");
+            return -1;
+        }
+        if (!Mgr.IsEmpty())
+        {
+            LOG_ERROR_MESSAGE("The ring buffer is not empty after all frames have been released");
+            return -1;
+        }
+        if (run == 0 || RunTime < BestTime)
+        {
+            BestTime          = RunTime;
+            FullBufferRetries = NumRetries;
+        }
+    }
+    return BestTime;
+}
+
+bool RingBufferBenchmark::Run(std::vector<RingBufferResult>& Results)
+{
+    auto MaxThreads = m_Settings.MaxThreads != 0 ? m_Settings.MaxThreads : 32;
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    for (auto NumThreads : ThreadCounts)
+    {
+        std::cerr << "Allocating master blocks from " << NumThreads << (NumThreads == 1 ? " thread\n" : " threads\n");
+
+        double MutexTime = 0;
+        for (bool Concurrent : {false, true})
+        {
+            Uint64 FullBufferRetries = 0;
+            auto Time = Concurrent ? 
+                Measure<ConcurrentRingBufferManager>(NumThreads, FullBufferRetries) :
+                Measure<MutexRingBufferManager>     (NumThreads, FullBufferRetries);
+            if (Time < 0)
+                return false;
+            if (!Concurrent)
+                MutexTime = Time;
+
+            RingBufferResult Result;
+            Result.NumThreads          = NumThreads;
+            Result.Mode                = Concurrent ? "concurrent" : "mutex";
+            Result.Seconds             = Time;
+            Result.NsPerOperation      = Time * 1e9 / m_Settings.AllocationsPerThread;
+            Result.OperationsPerSecond = Time > 0 ? static_cast<double>(NumThreads) * m_Settings.AllocationsPerThread / Time : 0;
+            Result.Speedup             = Time > 0 ? MutexTime / Time : 0;
+            Result.FullBufferRetries   = FullBufferRetries;
+            Results.push_back(Result);
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,150 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <array>
+
+#include "SamplerRegistryBenchmark.h"
+#include "RenderDeviceFactoryNull.h"
+#include "Timer.h"
+#include "Errors.h"
+
+namespace Diligent
+{
+
+SamplerRegistryBenchmark::SamplerRegistryBenchmark(const SamplerRegistrySettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.CallsPerThread > 0 && m_Settings.NumSamplerDescs > 1 && m_Settings.NumRuns > 0);
+
+    auto* pFactoryNull = GetEngineFactoryNull();
+
+    EngineNullAttribs EngineAttribs;
+    IDeviceContext* pImmediateContext = nullptr;
+    pFactoryNull->CreateDeviceAndContextsNull(EngineAttribs, &m_pDevice, &pImmediateContext, 0);
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Failed to create Null render device");
+    pImmediateContext->Release();
+
+    // Descriptions only differ in values that participate in comparison and hashing
+    m_SamplerDescs.resize(m_Settings.NumSamplerDescs);
+    for (Uint32 i = 0; i < m_Settings.NumSamplerDescs; ++i)
+    {
+        auto& Desc = m_SamplerDescs[i];
+        Desc.MinFilter     = (i & 0x01) ? FILTER_TYPE_LINEAR : FILTER_TYPE_POINT;
+        Desc.MagFilter     = (i & 0x02) ? FILTER_TYPE_LINEAR : FILTER_TYPE_POINT;
+        Desc.AddressU      = (i & 0x04) ? TEXTURE_ADDRESS_WRAP : TEXTURE_ADDRESS_CLAMP;
+        Desc.MaxAnisotropy = 1 + ((i >> 3) & 0x0F);
+        Desc.MipLODBias    = static_cast<float>(i >> 7);
+    }
+}
+
+bool SamplerRegistryBenchmark::RunThread(Uint32 ThreadId)
+{
+    const Uint32 NumDescs = m_Settings.NumSamplerDescs;
+    // The most recently created samplers are released when they are pushed out of the ring
+    std::array<RefCntAutoPtr<ISampler>, 8> RecentSamplers;
+    // Different threads walk the descriptions in different order
+    Uint32 DescInd = (ThreadId * 7919) % NumDescs;
+    const Uint32 Stride = 2 * ThreadId + 1;
+    for (Uint32 call = 0; call < m_Settings.CallsPerThread; ++call)
+    {
+        DescInd = (DescInd + Stride) % NumDescs;
+        const auto& Desc = m_SamplerDescs[DescInd];
+
+        RefCntAutoPtr<ISampler> pSampler;
+        m_pDevice->CreateSampler(Desc, &pSampler);
+        if (!pSampler || !(pSampler->GetDesc() == Desc))
+            return false;
+
+        RecentSamplers[call % RecentSamplers.size()] = std::move(pSampler);
+    }
+    return true;
+}
+
+bool SamplerRegistryBenchmark::Run(std::vector<SamplerRegistryResult>& Results)
+{
+    auto MaxThreads = m_Settings.MaxThreads;
+    if (MaxThreads == 0)
+        MaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    // Samplers for the first half of descriptions stay alive during the whole benchmark
+    std::vector<RefCntAutoPtr<ISampler>> ResidentSamplers(m_Settings.NumSamplerDescs / 2);
+    for (size_t i = 0; i < ResidentSamplers.size(); ++i)
+        m_pDevice->CreateSampler(m_SamplerDescs[i], &ResidentSamplers[i]);
+
+    for (auto NumThreads : ThreadCounts)
+    {
+        std::cerr << "Creating samplers from " << NumThreads << (NumThreads == 1 ? " thread\n" : " threads\n");
+
+        double BestTime = 0;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            std::atomic<bool> Failed{false};
+            std::vector<std::thread> Threads;
+            Threads.reserve(NumThreads);
+
+            Timer timer;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [this, t, &Failed]()
+                    {
+                        if (!RunThread(t))
+                            Failed = true;
+                    }
+                );
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+            auto RunTime = timer.GetElapsedTime();
+
+            if (Failed)
+            {
+                LOG_ERROR_MESSAGE("CreateSampler() failed or returned a sampler with a different description");
+                return false;
+            }
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+        }
+
+        SamplerRegistryResult Result;
+        Result.NumThreads     = NumThreads;
+        Result.Seconds        = BestTime;
+        Result.NsPerCall      = BestTime * 1e9 / m_Settings.CallsPerThread;
+        Result.CallsPerSecond = BestTime > 0 ? static_cast<double>(NumThreads) * m_Settings.CallsPerThread / BestTime : 0;
+        Results.push_back(Result);
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,168 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <sstream>
+#include <algorithm>
+#include <iostream>
+
+#include "ShaderCompilationBenchmark.h"
+#include "GLSL2SPIRV.h"
+#include "Timer.h"
+#include "Errors.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+// Generates fragment shader with NumFunctions functions. Variant changes constants
+// so that every shader in the batch is different
+static std::string GenerateShaderSource(Uint32 Variant, Uint32 NumFunctions)
+{
+    std::stringstream ss;
+    ss << "#version 450\n"
+          "layout(location = 0) in  vec4 in_Color;\n"
+          "layout(location = 1) in  vec2 in_UV;\n"
+          "layout(location = 0) out vec4 out_Color;\n"
+          "layout(std140) uniform cbConstants\n"
+          "{\n"
+          "    vec4 g_Params[16];\n"
+          "};\n"
+          "uniform sampler2D g_Texture;\n";
+
+    for (Uint32 f = 0; f < NumFunctions; ++f)
+    {
+        ss << "vec4 Function" << f << "(vec4 v)\n"
+              "{\n"
+              "    for (int i = 0; i < 4; ++i)\n"
+              "    {\n"
+              "        v = sin(v * g_Params[" << (f % 16) << "]) + cos(v.yzwx) * " << (Variant + f + 1) << ".0;\n"
+              "        v.xy += texture(g_Texture, v.zw + in_UV).xy * g_Params[" << ((f + Variant) % 16) << "].zw;\n"
+              "    }\n"
+              "    return normalize(v + vec4(" << f << ".0, " << Variant << ".0, 1.0, 0.5));\n"
+              "}\n";
+    }
+
+    ss << "void main()\n"
+          "{\n"
+          "    vec4 v = in_Color;\n";
+    for (Uint32 f = 0; f < NumFunctions; ++f)
+        ss << "    v = Function" << f << "(v);\n";
+    ss << "    out_Color = v;\n"
+          "}\n";
+
+    return ss.str();
+}
+
+ShaderCompilationBenchmark::ShaderCompilationBenchmark(const ShaderCompilationSettings& Settings) :
+    m_Settings(Settings)
+{
+    VERIFY_EXPR(m_Settings.NumShaders > 0 && m_Settings.NumRuns > 0);
+
+    InitializeGlslang();
+
+    m_Sources.reserve(m_Settings.NumShaders);
+    for (Uint32 shader = 0; shader < m_Settings.NumShaders; ++shader)
+        m_Sources.emplace_back(GenerateShaderSource(shader, 32));
+}
+
+ShaderCompilationBenchmark::~ShaderCompilationBenchmark()
+{
+    FinalizeGlslang();
+}
+
+bool ShaderCompilationBenchmark::Run(std::vector<ShaderCompilationResult>& Results)
+{
+    std::vector<GLSLtoSPIRVJob> Jobs(m_Sources.size());
+    for (size_t job = 0; job < Jobs.size(); ++job)
+    {
+        Jobs[job].ShaderType   = SHADER_TYPE_PIXEL;
+        Jobs[job].ShaderSource = m_Sources[job].c_str();
+    }
+    const auto NumJobs = static_cast<Uint32>(Jobs.size());
+
+    auto MaxThreads = m_Settings.MaxThreads;
+    if (MaxThreads == 0)
+        MaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<Uint32> ThreadCounts;
+    for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+        ThreadCounts.push_back(NumThreads);
+    ThreadCounts.push_back(MaxThreads);
+
+    std::vector<GLSLtoSPIRVResult> ReferenceResults;
+    double SingleThreadTime = 0;
+    for (auto NumThreads : ThreadCounts)
+    {
+        std::cerr << "Compiling " << NumJobs << " shaders with " << NumThreads << (NumThreads == 1 ? " thread\n" : " threads\n");
+
+        double BestTime = 0;
+        for (Uint32 run = 0; run < m_Settings.NumRuns; ++run)
+        {
+            Timer timer;
+            auto BatchResults = GLSLtoSPIRVBatch(Jobs.data(), NumJobs, NumThreads);
+            auto RunTime = timer.GetElapsedTime();
+            BestTime = run == 0 ? RunTime : std::min(BestTime, RunTime);
+
+            if (ReferenceResults.empty())
+            {
+                for (Uint32 job = 0; job < NumJobs; ++job)
+                {
+                    if (BatchResults[job].SPIRV.empty())
+                    {
+                        LOG_ERROR_MESSAGE("Failed to compile shader ", job, ":\n", BatchResults[job].Log);
+                        return false;
+                    }
+                }
+                ReferenceResults = std::move(BatchResults);
+            }
+            else
+            {
+                for (Uint32 job = 0; job < NumJobs; ++job)
+                {
+                    if (BatchResults[job].SPIRV != ReferenceResults[job].SPIRV)
+                    {
+                        LOG_ERROR_MESSAGE("Byte code of shader ", job, " compiled with ", NumThreads, " threads differs from the single-thread byte code");
+                        return false;
+                    }
+                }
+            }
+        }
+
+        if (NumThreads == 1)
+            SingleThreadTime = BestTime;
+
+        ShaderCompilationResult Result;
+        Result.NumThreads       = NumThreads;
+        Result.NumShaders       = NumJobs;
+        Result.Seconds          = BestTime;
+        Result.ShadersPerSecond = BestTime > 0 ? NumJobs / BestTime : 0;
+        Result.Speedup          = BestTime > 0 ? SingleThreadTime / BestTime : 0;
+        Results.push_back(Result);
+    }
+
+    return true;
+}
+
+}
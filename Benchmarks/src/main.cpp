@@ -0,0 +1,336 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "DrawCallBenchmark.h"
+#include "BenchmarkReport.h"
+#include "BoxCullingBenchmark.h"
+#include "MatrixBenchmark.h"
+#include "SamplerRegistryBenchmark.h"
+#include "MemoryPageIndexBenchmark.h"
+#include "AllocationsManagerBenchmark.h"
+#include "FixedBlockAllocatorBenchmark.h"
+#include "RingBufferBenchmark.h"
+#if VULKAN_SUPPORTED
+#   include "ShaderCompilationBenchmark.h"
+#endif
+#if GL_SUPPORTED && PLATFORM_LINUX
+#   include "GLBindingBenchmark.h"
+#   include "GLDynamicBufferBenchmark.h"
+#   include "GLDeferredBenchmark.h"
+#   include "GLVAOBenchmark.h"
+#endif
+
+using namespace Diligent;
+
+namespace
+{
+
+// Options shared by all benchmark modes
+struct BenchmarkOptions
+{
+    std::string OutputPath;
+    Uint32      MaxThreads = 0;
+};
+
+template<typename SettingsType, typename ResultType>
+int WriteReport(const std::string& OutputPath, 
+                void (*WriteReportFunc)(std::ostream&, const SettingsType&, const std::vector<ResultType>&),
+                const SettingsType& Settings,
+                const std::vector<ResultType>& Results)
+{
+    if (OutputPath.empty())
+    {
+        WriteReportFunc(std::cout, Settings, Results);
+    }
+    else
+    {
+        std::ofstream Stream(OutputPath);
+        if (!Stream)
+        {
+            std::cerr << "Failed to open output file " << OutputPath << '\n';
+            return -1;
+        }
+        WriteReportFunc(Stream, Settings, Results);
+    }
+    return 0;
+}
+
+// Runs a benchmark whose constructor takes the settings and whose Run() method fills the results,
+// and writes the report. The constructor may throw std::runtime_error if the benchmark fails to initialize.
+template<typename BenchmarkType, typename SettingsType, typename ResultType>
+int RunBenchmark(const char*             Name,
+                 const SettingsType&     Settings,
+                 const BenchmarkOptions& Options,
+                 void (*WriteReportFunc)(std::ostream&, const SettingsType&, const std::vector<ResultType>&))
+{
+    std::vector<ResultType> Results;
+    try
+    {
+        BenchmarkType Benchmark(Settings);
+        if (!Benchmark.Run(Results))
+        {
+            std::cerr << Name << " benchmark failed\n";
+            return -1;
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        std::cerr << "Failed to initialize the " << Name << " benchmark\n";
+        return -1;
+    }
+    return WriteReport(Options.OutputPath, WriteReportFunc, Settings, Results);
+}
+
+// Benchmark mode that replaces the default draw call benchmark. The mode is selected by its
+// command line flag followed by the problem size N, which is never zero.
+struct BenchmarkMode
+{
+    const char* Flag;
+    const char* Usage;
+    int (*Run)(Uint32 N, const BenchmarkOptions& Options);
+};
+
+// To add a benchmark mode, add an entry to this table and describe the mode in readme.md
+const BenchmarkMode BenchmarkModes[] =
+{
+    {
+        "--boxes", "Instead of draw calls, measure frustum culling of N bounding boxes",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            BoxCullingSettings Settings;
+            Settings.NumBoxes = N;
+            return RunBenchmark<BoxCullingBenchmark>("Box culling", Settings, Options, WriteBoxCullingReport);
+        }
+    },
+    {
+        "--matrices", "Instead of draw calls, measure bulk matrix operations on N elements",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            MatrixBenchmarkSettings Settings;
+            Settings.NumElements = N;
+            return RunBenchmark<MatrixBenchmark>("Matrix", Settings, Options, WriteMatrixReport);
+        }
+    },
+    {
+        "--samplers", "Instead of draw calls, measure N sampler creations per thread",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            SamplerRegistrySettings Settings;
+            Settings.CallsPerThread = N;
+            Settings.MaxThreads     = Options.MaxThreads;
+            return RunBenchmark<SamplerRegistryBenchmark>("Sampler registry", Settings, Options, WriteSamplerRegistryReport);
+        }
+    },
+    {
+        "--memory-trace", "Instead of draw calls, measure Vulkan memory page selection on traces of N allocations",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            MemoryPageIndexSettings Settings;
+            Settings.NumAllocations = N;
+            return RunBenchmark<MemoryPageIndexBenchmark>("Memory page index", Settings, Options, WriteMemoryPageIndexReport);
+        }
+    },
+    {
+        "--allocations", "Instead of draw calls, compare variable-size allocations managers on traces of N allocations",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            AllocationsManagerSettings Settings;
+            Settings.NumAllocations = N;
+            return RunBenchmark<AllocationsManagerBenchmark>("Allocations manager", Settings, Options, WriteAllocationsManagerReport);
+        }
+    },
+    {
+        "--block-allocator", "Instead of draw calls, measure N fixed-size block allocations and releases per thread",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            FixedBlockAllocatorSettings Settings;
+            Settings.OperationsPerThread = N;
+            Settings.MaxThreads          = Options.MaxThreads;
+            return RunBenchmark<FixedBlockAllocatorBenchmark>("Fixed block allocator", Settings, Options, WriteFixedBlockAllocatorReport);
+        }
+    },
+    {
+        "--ring-buffer", "Instead of draw calls, measure N dynamic heap master block allocations per thread",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            RingBufferSettings Settings;
+            Settings.AllocationsPerThread = N;
+            Settings.MaxThreads           = Options.MaxThreads;
+            return RunBenchmark<RingBufferBenchmark>("Ring buffer", Settings, Options, WriteRingBufferReport);
+        }
+    },
+#if VULKAN_SUPPORTED
+    {
+        "--shaders", "Instead of draw calls, measure compilation of N GLSL shaders to SPIR-V",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            ShaderCompilationSettings Settings;
+            Settings.NumShaders = N;
+            Settings.MaxThreads = Options.MaxThreads;
+            return RunBenchmark<ShaderCompilationBenchmark>("Shader compilation", Settings, Options, WriteShaderCompilationReport);
+        }
+    },
+#endif
+#if GL_SUPPORTED && PLATFORM_LINUX
+    {
+        "--gl-bindings", "Instead of draw calls, count GL binding calls made by N OpenGL draws",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            GLBindingSettings Settings;
+            Settings.NumDraws = N;
+            return RunBenchmark<GLBindingBenchmark>("GL binding", Settings, Options, WriteGLBindingReport);
+        }
+    },
+    {
+        "--gl-dynamic", "Instead of draw calls, measure N frames of OpenGL draws that map dynamic buffers",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            GLDynamicBufferSettings Settings;
+            Settings.NumFrames = N;
+            return RunBenchmark<GLDynamicBufferBenchmark>("GL dynamic buffer", Settings, Options, WriteGLDynamicBufferReport);
+        }
+    },
+    {
+        "--gl-deferred", "Instead of draw calls, measure N OpenGL draws recorded in parallel on deferred contexts",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            GLDeferredSettings Settings;
+            Settings.NumDraws   = N;
+            Settings.MaxThreads = Options.MaxThreads;
+            return RunBenchmark<GLDeferredBenchmark>("GL deferred", Settings, Options, WriteGLDeferredReport);
+        }
+    },
+    {
+        "--gl-vao", "Instead of draw calls, measure N OpenGL draws that look up the vertex array object cache",
+        [](Uint32 N, const BenchmarkOptions& Options)
+        {
+            GLVAOSettings Settings;
+            Settings.NumDraws = N;
+            return RunBenchmark<GLVAOBenchmark>("GL VAO", Settings, Options, WriteGLVAOReport);
+        }
+    },
+#endif
+};
+
+void PrintUsage(const char* ExeName)
+{
+    std::cerr << "Usage: " << ExeName << " [options]\n"
+                 "  --max-contexts <N>  Maximum number of contexts, up to 64 (default: 64)\n"
+                 "  --frames <N>        Number of frames every operation is measured for (default: 16)\n"
+                 "  --calls <N>         Number of calls every context makes per frame (default: 4096)\n"
+                 "  --output <file>     Write JSON report to the file instead of the standard output\n"
+                 "  --max-threads <N>   Maximum number of sampler creation, shader compiler, allocator or GL recording threads (default: number of hardware threads, 32 for --block-allocator and --ring-buffer)\n";
+    for (const auto& Mode : BenchmarkModes)
+    {
+        std::string Flag = std::string{"  "} + Mode.Flag + " <N>";
+        Flag.resize(std::max(Flag.length() + 1, size_t{22}), ' ');
+        std::cerr << Flag << Mode.Usage << '\n';
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkSettings Settings;
+    BenchmarkOptions Options;
+    const BenchmarkMode* pMode = nullptr;
+    Uint32 ModeN = 0;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        const bool HasValue = arg + 1 < argc;
+        if (!HasValue)
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+
+        if (strcmp(argv[arg], "--max-contexts") == 0)
+            Settings.MaxContexts = static_cast<Uint32>(atoi(argv[++arg]));
+        else if (strcmp(argv[arg], "--frames") == 0)
+            Settings.NumFrames = static_cast<Uint32>(atoi(argv[++arg]));
+        else if (strcmp(argv[arg], "--calls") == 0)
+            Settings.CallsPerFrame = static_cast<Uint32>(atoi(argv[++arg]));
+        else if (strcmp(argv[arg], "--output") == 0)
+            Options.OutputPath = argv[++arg];
+        else if (strcmp(argv[arg], "--max-threads") == 0)
+            Options.MaxThreads = static_cast<Uint32>(atoi(argv[++arg]));
+        else
+        {
+            auto ModeIt = std::find_if(std::begin(BenchmarkModes), std::end(BenchmarkModes),
+                                       [&](const BenchmarkMode& Mode){ return strcmp(argv[arg], Mode.Flag) == 0; });
+            if (ModeIt == std::end(BenchmarkModes))
+            {
+                PrintUsage(argv[0]);
+                return -1;
+            }
+            pMode = &*ModeIt;
+            ModeN = static_cast<Uint32>(atoi(argv[++arg]));
+        }
+    }
+
+    if (Settings.MaxContexts == 0 || Settings.MaxContexts > 64 || Settings.NumFrames == 0 || Settings.CallsPerFrame == 0)
+    {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    if (pMode != nullptr)
+    {
+        if (ModeN == 0)
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+        return pMode->Run(ModeN, Options);
+    }
+
+    std::vector<BenchmarkResult> Results;
+    try
+    {
+        DrawCallBenchmark Benchmark(Settings);
+        for (Uint32 NumContexts = 1; NumContexts <= Settings.MaxContexts; NumContexts *= 2)
+        {
+            std::cerr << "Running benchmark with " << NumContexts << (NumContexts == 1 ? " context\n" : " contexts\n");
+            Benchmark.Run(NumContexts, Results);
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        std::cerr << "Failed to initialize the benchmark\n";
+        return -1;
+    }
+
+    return WriteReport(Options.OutputPath, WriteBenchmarkReport, Settings, Results);
+}
@@ -272,6 +272,35 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt &ViewFrustumExt, cons
     return BoxVisibility::Intersecting;
 }
 
+// Bounding boxes stored as structure of arrays: every array
+// holds one coordinate of all boxes
+struct BoundBoxArrays
+{
+    const float* MinX = nullptr;
+    const float* MaxX = nullptr;
+    const float* MinY = nullptr;
+    const float* MaxY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+// Tests NumBoxes bounding boxes against the view frustum and writes the visibility of
+// every box to pVisibility as static_cast<Diligent::Uint8>(BoxVisibility). The result
+// for every box is the same as returned by GetBoxVisibility<TestFullVisibility>().
+// Boxes are processed by AVX, SSE or NEON instructions depending on the instruction
+// set the library is compiled for, and by scalar code otherwise.
+void GetBoxesVisibility(const ViewFrustum&    Frustum,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        Diligent::Uint8*      pVisibility,
+                        bool                  TestFullVisibility);
+
+void GetBoxesVisibility(const ViewFrustumExt& FrustumExt,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        Diligent::Uint8*      pVisibility,
+                        bool                  TestFullVisibility);
+
 inline float GetPointToBoxDistance(const BoundBox &BndBox, const float3 &Pos)
 {
     VERIFY_EXPR(BndBox.fMaxX >= BndBox.fMinX && 
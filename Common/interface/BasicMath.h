@@ -1387,6 +1387,33 @@ inline float4x4 inverseMatrix(const float4x4& m)
     return inv;
 }
 
+// Bulk matrix and vector operations. Every result is bit-for-bit identical to the
+// result of the corresponding scalar operation. The data are processed by SSE or
+// NEON instructions depending on the instruction set the library is compiled for,
+// and by scalar code otherwise. Source and destination arrays do not need to be
+// aligned, so the results can be written directly to a mapped buffer. The destination
+// may be the same array as the source, but the arrays must not partially overlap.
+
+// pDst[i] = mul(pLeft[i], pRight[i])
+void MultiplyMatrices(const float4x4* pLeft, const float4x4* pRight, size_t Count, float4x4* pDst);
+
+// pDst[i] = mul(pLeft[i], Right)
+void MultiplyMatrices(const float4x4* pLeft, const float4x4& Right, size_t Count, float4x4* pDst);
+
+// pDst[i] = inverseMatrix(pSrc[i])
+void InvertMatrices(const float4x4* pSrc, size_t Count, float4x4* pDst);
+
+// pDst[i] = pSrc[i] * m
+void TransformVectors(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst);
+
+// pDst[i] = pSrc[i] * m, i.e. the point is transformed as float4(pSrc[i], 1)
+// and divided by w
+void TransformPoints(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst);
+
+// pDst[i] = float3(float4(pSrc[i], 0) * m), i.e. the direction is transformed by
+// the upper 3x3 part of the matrix. The result is not normalized.
+void TransformNormals(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst);
+
 namespace std
 {
     template<typename T>
@@ -28,6 +28,8 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 #include <cstring>
@@ -49,10 +51,19 @@ namespace Diligent
 #endif
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// When thread caching is enabled, every thread keeps two magazines of free blocks. Most
+/// allocations and releases are served from these magazines without any synchronization.
+/// Full and empty magazines are exchanged through a lock-free depot, and the allocator mutex 
+/// is only taken when blocks are moved between magazines and pages or new magazines are created.
+/// When the depot already holds MaxDepotFullMagazines full magazines, blocks of the next full
+/// magazine are returned to their pages, which are found by a binary search over pages sorted by
+/// their start address. Note that blocks cached by a thread that has exited are only reclaimed
+/// when the allocator is destroyed.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, bool ThreadCaching = false);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -69,6 +80,10 @@ private:
 
     void CreateNewPage();
 
+    void* AllocateCached();
+    void FreeCached(void* Ptr);
+    size_t FindPage(const void* Ptr)const;
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -198,6 +213,7 @@ private:
 
         bool HasSpace()const{return m_NumFreeBlocks>0;}
         bool HasAllocations()const{return m_NumFreeBlocks<m_NumInitializedBlocks;}
+        Uint32 GetNumAllocatedBlocks()const{return m_pOwnerAllocator->m_NumBlocksInPage - m_NumFreeBlocks;}
     private:
 
         MemoryPage(const MemoryPage&)=delete;
@@ -221,6 +237,66 @@ private:
     IMemoryAllocator &m_RawMemoryAllocator;
     size_t m_BlockSize;
     Uint32 m_NumBlocksInPage;
+
+    // Members below are only used in thread caching mode
+
+    static constexpr Uint32 MagazineCapacity      = 32;
+    static constexpr Uint32 InvalidMagazineIndex  = static_cast<Uint32>(-1);
+    // Magazine chunk k contains (FirstChunkSize << k) magazines
+    static constexpr Uint32 FirstChunkSizeLog2    = 4;
+    static constexpr Uint32 MaxMagazineChunks     = 32 - FirstChunkSizeLog2;
+    // Maximum number of full magazines in the depot before blocks are returned to pages
+    static constexpr Int32  MaxDepotFullMagazines = 16;
+
+    struct Magazine
+    {
+        // Next magazine in the depot stack
+        std::atomic<Uint32> NextIdx{InvalidMagazineIndex};
+        Uint32 NumBlocks = 0;
+        void*  Blocks[MagazineCapacity];
+
+        bool IsFull() const{return NumBlocks == MagazineCapacity;}
+        bool IsEmpty()const{return NumBlocks == 0;}
+    };
+
+    struct MagazineRef
+    {
+        Uint32    Idx  = InvalidMagazineIndex;
+        Magazine* pMag = nullptr;
+    };
+
+    struct ThreadCache
+    {
+        MagazineRef     Loaded;
+        MagazineRef     Previous;
+        std::thread::id ThreadId;
+    };
+
+    ThreadCache* GetThreadCache();
+    MagazineRef  CreateMagazine();
+    Magazine*    GetMagazine(Uint32 Idx)const;
+    void         ReturnBlocksToPages(Magazine& Mag);
+
+    // The depot keeps magazines in lock-free stacks referenced by indices. The upper 32 bits of
+    // the stack head contain a tag that is incremented on every update to avoid ABA problem.
+    void        PushMagazine(std::atomic<Uint64>& Stack, MagazineRef Mag);
+    MagazineRef PopMagazine (std::atomic<Uint64>& Stack);
+
+    const bool   m_ThreadCaching;
+    const Uint64 m_AllocatorId;
+
+    std::atomic<Magazine*> m_MagazineChunks[MaxMagazineChunks];
+    Uint32                 m_NumMagazines = 0; // Protected by m_Mutex
+
+    std::atomic<Uint64> m_FullMagazines {InvalidMagazineIndex};
+    std::atomic<Uint64> m_EmptyMagazines{InvalidMagazineIndex};
+    // Approximate number of magazines in m_FullMagazines
+    std::atomic<Int32>  m_NumFullMagazines{0};
+
+    // Page ids sorted by the page start address, protected by m_Mutex
+    std::vector<size_t, STDAllocatorRawMem<size_t> > m_PagesByAddress;
+
+    std::vector<ThreadCache*, STDAllocatorRawMem<ThreadCache*> > m_ThreadCaches;
 };
 
 IMemoryAllocator& GetRawAllocator();
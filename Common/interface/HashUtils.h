@@ -120,10 +120,20 @@ namespace Diligent
             MakeCopy( Str.c_str() );
         }
 
+        // Creates the key that references the string without copying it and 
+        // uses the hash of the string computed earlier by CStringHash<Char>
+        static HashMapStringKey FromHash(const Char* Str, size_t StrHash)
+        {
+            HashMapStringKey Key(Str);
+            VERIFY(StrHash == CStringHash<Char>()(Str), "Incorrect string hash");
+            Key.Hash = StrHash;
+            return Key;
+        }
+
         HashMapStringKey(HashMapStringKey &&Key) :
             StringBuff( std::move(Key.StringBuff) ),
             StrPtr( std::move(Key.StrPtr) ),
-            Hash(0)
+            Hash( Key.Hash )
         {
             Key.StrPtr = nullptr;
             Key.Hash = 0;
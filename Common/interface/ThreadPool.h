@@ -0,0 +1,107 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.h"
+
+namespace ThreadingTools
+{
+
+// Fixed-size pool of worker threads that execute tasks in the order they were enqueued
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t NumThreads)
+    {
+        VERIFY(NumThreads > 0, "Number of threads must not be 0");
+        m_WorkerThreads.reserve(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+            m_WorkerThreads.emplace_back(&ThreadPool::WorkerThreadFunc, this);
+    }
+
+    ThreadPool             (const ThreadPool&) = delete;
+    ThreadPool             (ThreadPool&&)      = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+    ThreadPool& operator = (ThreadPool&&)      = delete;
+
+    // Executes all tasks that are still in the queue and waits for the worker threads to finish
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_QueueMtx);
+            m_Stop = true;
+        }
+        m_WakeUpCondVar.notify_all();
+        for (auto& Thread : m_WorkerThreads)
+            Thread.join();
+        VERIFY(m_Tasks.empty(), "Not all tasks have been executed");
+    }
+
+    void EnqueueTask(std::function<void()> Task)
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_QueueMtx);
+            VERIFY(!m_Stop, "Enqueuing task to the pool that is being destroyed");
+            m_Tasks.emplace_back(std::move(Task));
+        }
+        m_WakeUpCondVar.notify_one();
+    }
+
+    size_t GetNumThreads()const { return m_WorkerThreads.size(); }
+
+private:
+    void WorkerThreadFunc()
+    {
+        for (;;)
+        {
+            std::function<void()> Task;
+            {
+                std::unique_lock<std::mutex> Lock(m_QueueMtx);
+                m_WakeUpCondVar.wait(Lock, [this]{ return m_Stop || !m_Tasks.empty(); });
+                // Drain the queue before exiting
+                if (m_Tasks.empty())
+                    return;
+                Task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            Task();
+        }
+    }
+
+    std::mutex                        m_QueueMtx;
+    std::condition_variable           m_WakeUpCondVar;
+    std::deque<std::function<void()>> m_Tasks;
+    bool                              m_Stop = false;
+    std::vector<std::thread>          m_WorkerThreads;
+};
+
+}
@@ -0,0 +1,313 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include <algorithm>
+#include "AdvancedMath.h"
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define BOX_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define BOX_CULLING_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#   define BOX_CULLING_NEON 1
+#endif
+
+using Diligent::Uint8;
+
+namespace
+{
+
+// Frustum plane prepared for testing boxes stored as structure of arrays.
+// As the normal is the same for all boxes, the coordinates of the corners that
+// are farthest along and against the normal are selected once per plane.
+struct CullingPlane
+{
+    float Nx, Ny, Nz, D;
+    const float* MaxPointX;
+    const float* MaxPointY;
+    const float* MaxPointZ;
+    const float* MinPointX;
+    const float* MinPointY;
+    const float* MinPointZ;
+};
+
+// Bounds of the frustum corners used by the ViewFrustumExt test
+struct FrustumCornerBounds
+{
+    float MinX, MaxX, MinY, MaxY, MinZ, MaxZ;
+};
+
+struct ScalarOps
+{
+    static constexpr size_t Width = 1;
+    using Reg  = float;
+    using Mask = bool;
+
+    static Reg  Load (const float* p)   { return *p; }
+    static Reg  Set1 (float f)          { return f; }
+    static Reg  Mul  (Reg a, Reg b)     { return a * b; }
+    static Reg  Add  (Reg a, Reg b)     { return a + b; }
+    static Mask Less     (Reg a, Reg b) { return a <  b; }
+    static Mask Greater  (Reg a, Reg b) { return a >  b; }
+    static Mask LessEq   (Reg a, Reg b) { return a <= b; }
+    static Mask GreaterEq(Reg a, Reg b) { return a >= b; }
+    static Mask Or    (Mask a, Mask b)  { return a || b; }
+    static Mask And   (Mask a, Mask b)  { return a && b; }
+    static Mask AndNot(Mask a, Mask b)  { return !a && b; }
+    static Mask True () { return true;  }
+    static Mask False() { return false; }
+    static int  Bits (Mask m) { return m ? 1 : 0; }
+};
+
+#if BOX_CULLING_AVX
+struct AVXOps
+{
+    static constexpr size_t Width = 8;
+    using Reg  = __m256;
+    using Mask = __m256;
+
+    static Reg  Load (const float* p)   { return _mm256_loadu_ps(p); }
+    static Reg  Set1 (float f)          { return _mm256_set1_ps(f); }
+    static Reg  Mul  (Reg a, Reg b)     { return _mm256_mul_ps(a, b); }
+    static Reg  Add  (Reg a, Reg b)     { return _mm256_add_ps(a, b); }
+    static Mask Less     (Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask Greater  (Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask LessEq   (Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask GreaterEq(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask Or    (Mask a, Mask b)  { return _mm256_or_ps(a, b); }
+    static Mask And   (Mask a, Mask b)  { return _mm256_and_ps(a, b); }
+    static Mask AndNot(Mask a, Mask b)  { return _mm256_andnot_ps(a, b); }
+    static Mask True () { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Mask False() { return _mm256_setzero_ps(); }
+    static int  Bits (Mask m) { return _mm256_movemask_ps(m); }
+};
+using BatchOps = AVXOps;
+#elif BOX_CULLING_SSE
+struct SSEOps
+{
+    static constexpr size_t Width = 4;
+    using Reg  = __m128;
+    using Mask = __m128;
+
+    static Reg  Load (const float* p)   { return _mm_loadu_ps(p); }
+    static Reg  Set1 (float f)          { return _mm_set1_ps(f); }
+    static Reg  Mul  (Reg a, Reg b)     { return _mm_mul_ps(a, b); }
+    static Reg  Add  (Reg a, Reg b)     { return _mm_add_ps(a, b); }
+    static Mask Less     (Reg a, Reg b) { return _mm_cmplt_ps(a, b); }
+    static Mask Greater  (Reg a, Reg b) { return _mm_cmpgt_ps(a, b); }
+    static Mask LessEq   (Reg a, Reg b) { return _mm_cmple_ps(a, b); }
+    static Mask GreaterEq(Reg a, Reg b) { return _mm_cmpge_ps(a, b); }
+    static Mask Or    (Mask a, Mask b)  { return _mm_or_ps(a, b); }
+    static Mask And   (Mask a, Mask b)  { return _mm_and_ps(a, b); }
+    static Mask AndNot(Mask a, Mask b)  { return _mm_andnot_ps(a, b); }
+    static Mask True () { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Mask False() { return _mm_setzero_ps(); }
+    static int  Bits (Mask m) { return _mm_movemask_ps(m); }
+};
+using BatchOps = SSEOps;
+#elif BOX_CULLING_NEON
+struct NEONOps
+{
+    static constexpr size_t Width = 4;
+    using Reg  = float32x4_t;
+    using Mask = uint32x4_t;
+
+    static Reg  Load (const float* p)   { return vld1q_f32(p); }
+    static Reg  Set1 (float f)          { return vdupq_n_f32(f); }
+    static Reg  Mul  (Reg a, Reg b)     { return vmulq_f32(a, b); }
+    static Reg  Add  (Reg a, Reg b)     { return vaddq_f32(a, b); }
+    static Mask Less     (Reg a, Reg b) { return vcltq_f32(a, b); }
+    static Mask Greater  (Reg a, Reg b) { return vcgtq_f32(a, b); }
+    static Mask LessEq   (Reg a, Reg b) { return vcleq_f32(a, b); }
+    static Mask GreaterEq(Reg a, Reg b) { return vcgeq_f32(a, b); }
+    static Mask Or    (Mask a, Mask b)  { return vorrq_u32(a, b); }
+    static Mask And   (Mask a, Mask b)  { return vandq_u32(a, b); }
+    // vbicq_u32(b, a) computes b & ~a
+    static Mask AndNot(Mask a, Mask b)  { return vbicq_u32(b, a); }
+    static Mask True () { return vdupq_n_u32(0xFFFFFFFFu); }
+    static Mask False() { return vdupq_n_u32(0); }
+    static int  Bits (Mask m)
+    {
+        return static_cast<int>((vgetq_lane_u32(m, 0) & 1u)       | 
+                                (vgetq_lane_u32(m, 1) & 1u) << 1u | 
+                                (vgetq_lane_u32(m, 2) & 1u) << 2u | 
+                                (vgetq_lane_u32(m, 3) & 1u) << 3u);
+    }
+};
+using BatchOps = NEONOps;
+#else
+using BatchOps = ScalarOps;
+#endif
+
+// Processes boxes [Start, End), where End - Start must be a multiple of TOps::Width
+template<typename TOps>
+size_t CullBoxes(const CullingPlane         Planes[],
+                 const FrustumCornerBounds* pCornerBounds,
+                 const BoundBoxArrays&      Boxes,
+                 size_t                     Start,
+                 size_t                     End,
+                 Uint8*                     pVisibility,
+                 bool                       TestFullVisibility)
+{
+    using Reg  = typename TOps::Reg;
+    using Mask = typename TOps::Mask;
+    const Reg Zero = TOps::Set1(0.f);
+
+    size_t i = Start;
+    for (; i + TOps::Width <= End; i += TOps::Width)
+    {
+        Mask Invisible    = TOps::False();
+        Mask FullyVisible = TestFullVisibility ? TOps::True() : TOps::False();
+        for (int p = 0; p < 6; ++p)
+        {
+            const auto& Plane = Planes[p];
+            const Reg Nx = TOps::Set1(Plane.Nx);
+            const Reg Ny = TOps::Set1(Plane.Ny);
+            const Reg Nz = TOps::Set1(Plane.Nz);
+            const Reg D  = TOps::Set1(Plane.D);
+
+            // Same operation order as in dot(MaxPoint, Normal) + Plane.Distance
+            Reg DMax = TOps::Add(TOps::Add(TOps::Mul(TOps::Load(Plane.MaxPointX + i), Nx), 
+                                           TOps::Mul(TOps::Load(Plane.MaxPointY + i), Ny)),
+                                           TOps::Mul(TOps::Load(Plane.MaxPointZ + i), Nz));
+            DMax = TOps::Add(DMax, D);
+            Invisible = TOps::Or(Invisible, TOps::Less(DMax, Zero));
+
+            if (TestFullVisibility)
+            {
+                Reg DMin = TOps::Add(TOps::Add(TOps::Mul(TOps::Load(Plane.MinPointX + i), Nx), 
+                                               TOps::Mul(TOps::Load(Plane.MinPointY + i), Ny)),
+                                               TOps::Mul(TOps::Load(Plane.MinPointZ + i), Nz));
+                DMin = TOps::Add(DMin, D);
+                FullyVisible = TOps::And(FullyVisible, TOps::Greater(DMin, Zero));
+            }
+        }
+
+        if (pCornerBounds != nullptr)
+        {
+            // Intersecting box is invisible if all frustum corners are outside one of its planes
+            const auto& CB = *pCornerBounds;
+            Mask CornersOutside =              TOps::LessEq   (TOps::Set1(CB.MaxX), TOps::Load(Boxes.MinX + i));
+            CornersOutside = TOps::Or(CornersOutside, TOps::GreaterEq(TOps::Set1(CB.MinX), TOps::Load(Boxes.MaxX + i)));
+            CornersOutside = TOps::Or(CornersOutside, TOps::LessEq   (TOps::Set1(CB.MaxY), TOps::Load(Boxes.MinY + i)));
+            CornersOutside = TOps::Or(CornersOutside, TOps::GreaterEq(TOps::Set1(CB.MinY), TOps::Load(Boxes.MaxY + i)));
+            CornersOutside = TOps::Or(CornersOutside, TOps::LessEq   (TOps::Set1(CB.MaxZ), TOps::Load(Boxes.MinZ + i)));
+            CornersOutside = TOps::Or(CornersOutside, TOps::GreaterEq(TOps::Set1(CB.MinZ), TOps::Load(Boxes.MaxZ + i)));
+            Invisible = TOps::Or(Invisible, TOps::AndNot(FullyVisible, CornersOutside));
+        }
+
+        const int InvisibleBits    = TOps::Bits(Invisible);
+        const int FullyVisibleBits = TOps::Bits(FullyVisible);
+        for (size_t l = 0; l < TOps::Width; ++l)
+        {
+            BoxVisibility Visibility = BoxVisibility::Intersecting;
+            if (InvisibleBits & (1 << l))
+                Visibility = BoxVisibility::Invisible;
+            else if (FullyVisibleBits & (1 << l))
+                Visibility = BoxVisibility::FullyVisible;
+            pVisibility[i + l] = static_cast<Uint8>(Visibility);
+        }
+    }
+
+    return i;
+}
+
+void PrepareCullingPlanes(const ViewFrustum& Frustum, const BoundBoxArrays& Boxes, CullingPlane Planes[])
+{
+    const Plane3D* pPlanes = reinterpret_cast<const Plane3D*>(&Frustum);
+    for (int p = 0; p < 6; ++p)
+    {
+        const auto& Normal = pPlanes[p].Normal;
+        auto& Plane = Planes[p];
+        Plane.Nx = Normal.x;
+        Plane.Ny = Normal.y;
+        Plane.Nz = Normal.z;
+        Plane.D  = pPlanes[p].Distance;
+        // Same selection as in GetBoxVisibilityAgainstPlane()
+        Plane.MaxPointX = (Normal.x > 0) ? Boxes.MaxX : Boxes.MinX;
+        Plane.MaxPointY = (Normal.y > 0) ? Boxes.MaxY : Boxes.MinY;
+        Plane.MaxPointZ = (Normal.z > 0) ? Boxes.MaxZ : Boxes.MinZ;
+        Plane.MinPointX = (Normal.x > 0) ? Boxes.MinX : Boxes.MaxX;
+        Plane.MinPointY = (Normal.y > 0) ? Boxes.MinY : Boxes.MaxY;
+        Plane.MinPointZ = (Normal.z > 0) ? Boxes.MinZ : Boxes.MaxZ;
+    }
+}
+
+void CullBoxes(const ViewFrustum&         Frustum,
+               const FrustumCornerBounds* pCornerBounds,
+               const BoundBoxArrays&      Boxes,
+               size_t                     NumBoxes,
+               Uint8*                     pVisibility,
+               bool                       TestFullVisibility)
+{
+    VERIFY_EXPR(NumBoxes == 0 || (pVisibility != nullptr &&
+                                  Boxes.MinX != nullptr && Boxes.MaxX != nullptr && 
+                                  Boxes.MinY != nullptr && Boxes.MaxY != nullptr && 
+                                  Boxes.MinZ != nullptr && Boxes.MaxZ != nullptr));
+
+    CullingPlane Planes[6];
+    PrepareCullingPlanes(Frustum, Boxes, Planes);
+
+    auto Processed = CullBoxes<BatchOps>(Planes, pCornerBounds, Boxes, 0, NumBoxes, pVisibility, TestFullVisibility);
+    // Process remaining boxes one by one
+    CullBoxes<ScalarOps>(Planes, pCornerBounds, Boxes, Processed, NumBoxes, pVisibility, TestFullVisibility);
+}
+
+}
+
+void GetBoxesVisibility(const ViewFrustum&    Frustum,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        Uint8*                pVisibility,
+                        bool                  TestFullVisibility)
+{
+    CullBoxes(Frustum, nullptr, Boxes, NumBoxes, pVisibility, TestFullVisibility);
+}
+
+void GetBoxesVisibility(const ViewFrustumExt& FrustumExt,
+                        const BoundBoxArrays& Boxes,
+                        size_t                NumBoxes,
+                        Uint8*                pVisibility,
+                        bool                  TestFullVisibility)
+{
+    FrustumCornerBounds CornerBounds;
+    CornerBounds.MinX = CornerBounds.MaxX = FrustumExt.FrustumCorners[0].x;
+    CornerBounds.MinY = CornerBounds.MaxY = FrustumExt.FrustumCorners[0].y;
+    CornerBounds.MinZ = CornerBounds.MaxZ = FrustumExt.FrustumCorners[0].z;
+    for (int c = 1; c < 8; ++c)
+    {
+        const auto& Corner = FrustumExt.FrustumCorners[c];
+        CornerBounds.MinX = std::min(CornerBounds.MinX, Corner.x);
+        CornerBounds.MaxX = std::max(CornerBounds.MaxX, Corner.x);
+        CornerBounds.MinY = std::min(CornerBounds.MinY, Corner.y);
+        CornerBounds.MaxY = std::max(CornerBounds.MaxY, Corner.y);
+        CornerBounds.MinZ = std::min(CornerBounds.MinZ, Corner.z);
+        CornerBounds.MaxZ = std::max(CornerBounds.MaxZ, Corner.z);
+    }
+    CullBoxes(FrustumExt, &CornerBounds, Boxes, NumBoxes, pVisibility, TestFullVisibility);
+}
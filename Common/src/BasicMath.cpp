@@ -0,0 +1,330 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "BasicMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define MATRIX_MATH_SSE 1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+    // 32-bit ARM does not have vector division, which is required for the exact results
+#   include <arm_neon.h>
+#   define MATRIX_MATH_NEON 1
+#endif
+
+namespace
+{
+
+#if MATRIX_MATH_SSE
+struct SIMDOps
+{
+    using Reg = __m128;
+
+    static Reg  Load  (const float* p)    { return _mm_loadu_ps(p); }
+    static void Store (float* p, Reg v)   { _mm_storeu_ps(p, v); }
+    static void Store3(float* p, Reg v)
+    {
+        _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+    static Reg  Set1  (float f)           { return _mm_set1_ps(f); }
+    static Reg  Zero  ()                  { return _mm_setzero_ps(); }
+    static Reg  Add   (Reg a, Reg b)      { return _mm_add_ps(a, b); }
+    static Reg  Sub   (Reg a, Reg b)      { return _mm_sub_ps(a, b); }
+    static Reg  Mul   (Reg a, Reg b)      { return _mm_mul_ps(a, b); }
+    static Reg  Div   (Reg a, Reg b)      { return _mm_div_ps(a, b); }
+    static Reg  Neg   (Reg a)             { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+
+    template<int Lane>
+    static Reg  Splat (Reg v)             { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+    static void Transpose(Reg& r0, Reg& r1, Reg& r2, Reg& r3)
+    {
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    }
+};
+#elif MATRIX_MATH_NEON
+struct SIMDOps
+{
+    using Reg = float32x4_t;
+
+    static Reg  Load  (const float* p)    { return vld1q_f32(p); }
+    static void Store (float* p, Reg v)   { vst1q_f32(p, v); }
+    static void Store3(float* p, Reg v)
+    {
+        vst1_f32(p, vget_low_f32(v));
+        vst1q_lane_f32(p + 2, v, 2);
+    }
+    static Reg  Set1  (float f)           { return vdupq_n_f32(f); }
+    static Reg  Zero  ()                  { return vdupq_n_f32(0.f); }
+    static Reg  Add   (Reg a, Reg b)      { return vaddq_f32(a, b); }
+    static Reg  Sub   (Reg a, Reg b)      { return vsubq_f32(a, b); }
+    static Reg  Mul   (Reg a, Reg b)      { return vmulq_f32(a, b); }
+    static Reg  Div   (Reg a, Reg b)      { return vdivq_f32(a, b); }
+    static Reg  Neg   (Reg a)             { return vnegq_f32(a); }
+
+    template<int Lane>
+    static Reg  Splat (Reg v)             { return vdupq_n_f32(vgetq_lane_f32(v, Lane)); }
+
+    static void Transpose(Reg& r0, Reg& r1, Reg& r2, Reg& r3)
+    {
+        auto t01 = vtrnq_f32(r0, r1);
+        auto t23 = vtrnq_f32(r2, r3);
+        r0 = vcombine_f32(vget_low_f32 (t01.val[0]), vget_low_f32 (t23.val[0]));
+        r1 = vcombine_f32(vget_low_f32 (t01.val[1]), vget_low_f32 (t23.val[1]));
+        r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+    }
+};
+#endif
+
+#if MATRIX_MATH_SSE || MATRIX_MATH_NEON
+
+// All kernels below perform exactly the same floating point operations in the same
+// order as the scalar code in BasicMath.h, which makes the results bit-exact. Note
+// that scalar mul() starts the accumulation from zero, which is preserved as
+// 0 + (-0) is +0.
+
+using Ops = SIMDOps;
+using Reg = Ops::Reg;
+
+inline void LoadRows(const float4x4& m, Reg Rows[4])
+{
+    for (int r = 0; r < 4; ++r)
+        Rows[r] = Ops::Load(m[r]);
+}
+
+// Row of mul(Left, Right): sum over k of Left[row][k] * Right[k]
+inline Reg MulRow(Reg LeftRow, const Reg RightRows[4])
+{
+    auto Row = Ops::Zero();
+    Row = Ops::Add(Row, Ops::Mul(Ops::Splat<0>(LeftRow), RightRows[0]));
+    Row = Ops::Add(Row, Ops::Mul(Ops::Splat<1>(LeftRow), RightRows[1]));
+    Row = Ops::Add(Row, Ops::Mul(Ops::Splat<2>(LeftRow), RightRows[2]));
+    Row = Ops::Add(Row, Ops::Mul(Ops::Splat<3>(LeftRow), RightRows[3]));
+    return Row;
+}
+
+inline void MulMatrix(const float4x4& Left, const Reg RightRows[4], float4x4& Dst)
+{
+    // All rows are loaded before anything is written to support in-place operation
+    Reg LeftRows[4];
+    LoadRows(Left, LeftRows);
+    for (int r = 0; r < 4; ++r)
+        Ops::Store(Dst[r], MulRow(LeftRows[r], RightRows));
+}
+
+// Same as determinant(float3x3) for the matrix composed of the arguments
+inline Reg Determinant3x3(Reg m11, Reg m12, Reg m13,
+                          Reg m21, Reg m22, Reg m23,
+                          Reg m31, Reg m32, Reg m33)
+{
+    auto det = Ops::Zero();
+    det = Ops::Add(det, Ops::Mul(m11, Ops::Sub(Ops::Mul(m22, m33), Ops::Mul(m32, m23))));
+    det = Ops::Sub(det, Ops::Mul(m12, Ops::Sub(Ops::Mul(m21, m33), Ops::Mul(m31, m23))));
+    det = Ops::Add(det, Ops::Mul(m13, Ops::Sub(Ops::Mul(m21, m32), Ops::Mul(m31, m22))));
+    return det;
+}
+
+// Inverts four matrices at once. Every register holds the same element of the four
+// matrices, so the kernel literally repeats inverseMatrix() with vector operations.
+inline void InvertFourMatrices(const float4x4* pSrc, float4x4* pDst)
+{
+    Reg m[16];
+    for (int r = 0; r < 4; ++r)
+    {
+        Reg* Row = m + r * 4;
+        Row[0] = Ops::Load(pSrc[0][r]);
+        Row[1] = Ops::Load(pSrc[1][r]);
+        Row[2] = Ops::Load(pSrc[2][r]);
+        Row[3] = Ops::Load(pSrc[3][r]);
+        Ops::Transpose(Row[0], Row[1], Row[2], Row[3]);
+    }
+
+    // Cofactors: inv[r][c] = (-1)^(r+c) * determinant of the minor that excludes row r and column c
+    Reg inv[16];
+    for (int r = 0; r < 4; ++r)
+    {
+        const int Rows[3] = {r > 0 ? 0 : 1, r > 1 ? 1 : 2, r > 2 ? 2 : 3};
+        for (int c = 0; c < 4; ++c)
+        {
+            const int Cols[3] = {c > 0 ? 0 : 1, c > 1 ? 1 : 2, c > 2 ? 2 : 3};
+#define M(i, j) m[Rows[i] * 4 + Cols[j]]
+            auto det = Determinant3x3(M(0, 0), M(0, 1), M(0, 2),
+                                      M(1, 0), M(1, 1), M(1, 2),
+                                      M(2, 0), M(2, 1), M(2, 2));
+#undef M
+            inv[r * 4 + c] = ((r + c) & 0x01) ? Ops::Neg(det) : det;
+        }
+    }
+
+    auto det = Ops::Add(Ops::Add(Ops::Add(Ops::Mul(m[0], inv[0]), Ops::Mul(m[1], inv[1])), Ops::Mul(m[2], inv[2])), Ops::Mul(m[3], inv[3]));
+    auto InvDet = Ops::Div(Ops::Set1(1.0f), det);
+
+    // The inverse matrix is the transposed matrix of cofactors divided by the determinant
+    for (int r = 0; r < 4; ++r)
+    {
+        Reg Row[4];
+        for (int c = 0; c < 4; ++c)
+            Row[c] = Ops::Mul(inv[c * 4 + r], InvDet);
+        Ops::Transpose(Row[0], Row[1], Row[2], Row[3]);
+        Ops::Store(pDst[0][r], Row[0]);
+        Ops::Store(pDst[1][r], Row[1]);
+        Ops::Store(pDst[2][r], Row[2]);
+        Ops::Store(pDst[3][r], Row[3]);
+    }
+}
+
+#endif
+
+}
+
+#if MATRIX_MATH_SSE || MATRIX_MATH_NEON
+
+void MultiplyMatrices(const float4x4* pLeft, const float4x4* pRight, size_t Count, float4x4* pDst)
+{
+    for (size_t i = 0; i < Count; ++i)
+    {
+        Reg RightRows[4];
+        LoadRows(pRight[i], RightRows);
+        MulMatrix(pLeft[i], RightRows, pDst[i]);
+    }
+}
+
+void MultiplyMatrices(const float4x4* pLeft, const float4x4& Right, size_t Count, float4x4* pDst)
+{
+    Reg RightRows[4];
+    LoadRows(Right, RightRows);
+    for (size_t i = 0; i < Count; ++i)
+        MulMatrix(pLeft[i], RightRows, pDst[i]);
+}
+
+void InvertMatrices(const float4x4* pSrc, size_t Count, float4x4* pDst)
+{
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+        InvertFourMatrices(pSrc + i, pDst + i);
+    for (; i < Count; ++i)
+        pDst[i] = inverseMatrix(pSrc[i]);
+}
+
+void TransformVectors(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst)
+{
+    Reg Rows[4];
+    LoadRows(m, Rows);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        auto v = Ops::Load(&pSrc[i].x);
+        auto Res = Ops::Mul(Ops::Splat<0>(v), Rows[0]);
+        Res = Ops::Add(Res, Ops::Mul(Ops::Splat<1>(v), Rows[1]));
+        Res = Ops::Add(Res, Ops::Mul(Ops::Splat<2>(v), Rows[2]));
+        Res = Ops::Add(Res, Ops::Mul(Ops::Splat<3>(v), Rows[3]));
+        Ops::Store(&pDst[i].x, Res);
+    }
+}
+
+void TransformPoints(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst)
+{
+    Reg Rows[4];
+    LoadRows(m, Rows);
+    // w * m[3] with w == 1
+    const auto WRow = Ops::Mul(Ops::Set1(1.f), Rows[3]);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& p = pSrc[i];
+        auto Res = Ops::Mul(Ops::Set1(p.x), Rows[0]);
+        Res = Ops::Add(Res, Ops::Mul(Ops::Set1(p.y), Rows[1]));
+        Res = Ops::Add(Res, Ops::Mul(Ops::Set1(p.z), Rows[2]));
+        Res = Ops::Add(Res, WRow);
+        Res = Ops::Div(Res, Ops::Splat<3>(Res));
+        Ops::Store3(&pDst[i].x, Res);
+    }
+}
+
+void TransformNormals(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst)
+{
+    Reg Rows[4];
+    LoadRows(m, Rows);
+    // w * m[3] with w == 0
+    const auto WRow = Ops::Mul(Ops::Zero(), Rows[3]);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& n = pSrc[i];
+        auto Res = Ops::Mul(Ops::Set1(n.x), Rows[0]);
+        Res = Ops::Add(Res, Ops::Mul(Ops::Set1(n.y), Rows[1]));
+        Res = Ops::Add(Res, Ops::Mul(Ops::Set1(n.z), Rows[2]));
+        Res = Ops::Add(Res, WRow);
+        Ops::Store3(&pDst[i].x, Res);
+    }
+}
+
+#else
+
+void MultiplyMatrices(const float4x4* pLeft, const float4x4* pRight, size_t Count, float4x4* pDst)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = mul(pLeft[i], pRight[i]);
+}
+
+void MultiplyMatrices(const float4x4* pLeft, const float4x4& Right, size_t Count, float4x4* pDst)
+{
+    // Right may be one of the destination matrices
+    const auto RightCopy = Right;
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = mul(pLeft[i], RightCopy);
+}
+
+void InvertMatrices(const float4x4* pSrc, size_t Count, float4x4* pDst)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = inverseMatrix(pSrc[i]);
+}
+
+void TransformVectors(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst)
+{
+    const auto Matrix = m;
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * Matrix;
+}
+
+void TransformPoints(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst)
+{
+    const auto Matrix = m;
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * Matrix;
+}
+
+void TransformNormals(const float3* pSrc, size_t Count, const float4x4& m, float3* pDst)
+{
+    const auto Matrix = m;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& n = pSrc[i];
+        auto v = float4(n.x, n.y, n.z, 0) * Matrix;
+        pDst[i] = float3(v.x, v.y, v.z);
+    }
+}
+
+#endif
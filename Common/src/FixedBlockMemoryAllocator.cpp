@@ -22,21 +22,68 @@
  */
 
 #include "pch.h"
+#include <algorithm>
+#include <functional>
 #include "FixedBlockMemoryAllocator.h"
+#include "PlatformMisc.h"
 
 namespace Diligent
 {
+    namespace
+    {
+        // Every thread keeps pointers to its caches of all allocators it has used, keyed by the
+        // allocator id. Allocator ids are never reused, so an entry can never reference a destroyed
+        // allocator. Entries of destroyed allocators are pruned when the map grows.
+        struct ThreadCacheMap
+        {
+            Uint64 LastAllocatorId = 0;
+            void*  pLastCache      = nullptr;
+            size_t PruneThreshold  = 64;
+            std::unordered_map<Uint64, void*> Caches;
+        };
+        thread_local ThreadCacheMap ThreadCaches;
+
+        // Ids of thread caching allocators that are alive
+        struct LiveAllocatorIds
+        {
+            std::mutex                 Mtx;
+            std::unordered_set<Uint64> Ids;
+        };
+        LiveAllocatorIds& GetLiveAllocatorIds()
+        {
+            static LiveAllocatorIds Ids;
+            return Ids;
+        }
+
+        std::atomic<Uint64> NextAllocatorId{1};
+    }
+
     FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                          size_t            BlockSize,
-                                                         Uint32            NumBlocksInPage) :
+                                                         Uint32            NumBlocksInPage,
+                                                         bool              ThreadCaching) :
         m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
         m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>")),
         m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
         m_RawMemoryAllocator(RawMemoryAllocator),
         m_BlockSize         (BlockSize),
-        m_NumBlocksInPage   (NumBlocksInPage)
+        m_NumBlocksInPage   (NumBlocksInPage),
+        m_ThreadCaching     (ThreadCaching),
+        m_AllocatorId       (ThreadCaching ? NextAllocatorId.fetch_add(1) : 0),
+        m_PagesByAddress    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for vector<size_t>")),
+        m_ThreadCaches      (STD_ALLOCATOR_RAW_MEM(ThreadCache*, RawMemoryAllocator, "Allocator for vector<ThreadCache*>"))
     {
-        if (BlockSize > 0)
+        for (auto &Chunk : m_MagazineChunks)
+            Chunk.store(nullptr);
+
+        if (m_ThreadCaching)
+        {
+            auto &LiveIds = GetLiveAllocatorIds();
+            std::lock_guard<std::mutex> LockGuard(LiveIds.Mtx);
+            LiveIds.Ids.insert(m_AllocatorId);
+        }
+
+        if (BlockSize > 0 && !m_ThreadCaching)
         {
             // Allocate one page
             CreateNewPage();
@@ -45,26 +92,95 @@ namespace Diligent
 
     FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
     {
-#ifdef _DEBUG
-        for (size_t p = 0; p < m_PagePool.size(); ++p)
+        if (m_ThreadCaching)
         {
-            VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
-            VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+            {
+                auto &LiveIds = GetLiveAllocatorIds();
+                std::lock_guard<std::mutex> LockGuard(LiveIds.Mtx);
+                LiveIds.Ids.erase(m_AllocatorId);
+            }
+
+#ifdef _DEBUG
+            size_t NumAllocatedBlocks = 0;
+            for (const auto &Page : m_PagePool)
+                NumAllocatedBlocks += Page.GetNumAllocatedBlocks();
+
+            size_t NumCachedBlocks = 0;
+            for (Uint32 m = 0; m < m_NumMagazines; ++m)
+                NumCachedBlocks += GetMagazine(m)->NumBlocks;
+            VERIFY(NumCachedBlocks == NumAllocatedBlocks, "Memory leak detected: ", NumAllocatedBlocks - NumCachedBlocks, " block(s) have not been released");
+#endif
+            for (Uint32 k = 0; k < MaxMagazineChunks; ++k)
+            {
+                auto *pChunk = m_MagazineChunks[k].load();
+                if (pChunk == nullptr)
+                    break;
+                for (Uint32 m = 0; m < (1u << (FirstChunkSizeLog2 + k)); ++m)
+                    pChunk[m].~Magazine();
+                m_RawMemoryAllocator.Free(pChunk);
+            }
+
+            for (auto *pCache : m_ThreadCaches)
+            {
+                pCache->~ThreadCache();
+                m_RawMemoryAllocator.Free(pCache);
+            }
         }
+        else
+        {
+#ifdef _DEBUG
+            for (size_t p = 0; p < m_PagePool.size(); ++p)
+            {
+                VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
+                VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+            }
 #endif
+        }
     }
 
     void FixedBlockMemoryAllocator::CreateNewPage()
     {
         m_PagePool.emplace_back( *this );
-        m_AvailablePages.insert( m_PagePool.size()-1 );
-        m_AddrToPageId.reserve( m_PagePool.size()*m_NumBlocksInPage );
+        auto PageId = m_PagePool.size()-1;
+        m_AvailablePages.insert( PageId );
+        if (m_ThreadCaching)
+        {
+            auto *pPageStart = m_PagePool[PageId].GetBlockStartAddress(0);
+            auto InsertPos = std::upper_bound(m_PagesByAddress.begin(), m_PagesByAddress.end(), pPageStart,
+                [this](const void* pAddr, size_t Id)
+                {
+                    return std::less<const void*>()(pAddr, m_PagePool[Id].GetBlockStartAddress(0));
+                });
+            m_PagesByAddress.insert(InsertPos, PageId);
+        }
+        else
+            m_AddrToPageId.reserve( m_PagePool.size()*m_NumBlocksInPage );
+    }
+
+    // Must be called while m_Mutex is locked
+    size_t FixedBlockMemoryAllocator::FindPage(const void* Ptr)const
+    {
+        // Find the first page that starts after the pointer, the owning page is the one before it
+        auto PageIt = std::upper_bound(m_PagesByAddress.begin(), m_PagesByAddress.end(), Ptr,
+            [this](const void* pAddr, size_t Id)
+            {
+                return std::less<const void*>()(pAddr, m_PagePool[Id].GetBlockStartAddress(0));
+            });
+        VERIFY(PageIt != m_PagesByAddress.begin(), "Address does not belong to any page");
+        auto PageId = *(PageIt - 1);
+        VERIFY(reinterpret_cast<const Uint8*>(Ptr) < reinterpret_cast<const Uint8*>(m_PagePool[PageId].GetBlockStartAddress(0)) + m_BlockSize * m_NumBlocksInPage,
+               "Address does not belong to any page");
+        return PageId;
     }
 
-    void* FixedBlockMemoryAllocator::Allocate( size_t Size, const Char* dbgDescription, const char* dbgFileName, const  Int32 dbgLineNumber)
+    void* FixedBlockMemoryAllocator::Allocate( size_t Size, const Char* /*dbgDescription*/, const char* /*dbgFileName*/, const  Int32 /*dbgLineNumber*/)
     {
         VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-        
+        (void)Size;
+
+        if (m_ThreadCaching)
+            return AllocateCached();
+
         std::lock_guard<std::mutex> LockGuard(m_Mutex);
         
         if (m_AvailablePages.empty())
@@ -86,6 +202,12 @@ namespace Diligent
 
     void FixedBlockMemoryAllocator::Free(void *Ptr)
     {
+        if (m_ThreadCaching)
+        {
+            FreeCached(Ptr);
+            return;
+        }
+
         std::lock_guard<std::mutex> LockGuard(m_Mutex);
         auto PageIdIt = m_AddrToPageId.find(Ptr);
         if (PageIdIt != m_AddrToPageId.end())
@@ -109,4 +231,237 @@ namespace Diligent
             UNEXPECTED("Address not found in the allocations list - double freeing memory?");
         }
     }
+
+    FixedBlockMemoryAllocator::Magazine* FixedBlockMemoryAllocator::GetMagazine(Uint32 Idx)const
+    {
+        VERIFY_EXPR(Idx != InvalidMagazineIndex);
+        // Chunk k contains magazines [FirstChunkSize * (2^k - 1), FirstChunkSize * (2^(k+1) - 1))
+        auto BiasedIdx = Idx + (1u << FirstChunkSizeLog2);
+        auto Chunk = PlatformMisc::GetMSB(BiasedIdx) - FirstChunkSizeLog2;
+        VERIFY_EXPR(Chunk < MaxMagazineChunks);
+        auto *pChunk = m_MagazineChunks[Chunk].load(std::memory_order_acquire);
+        VERIFY(pChunk != nullptr, "Magazine chunk has not been initialized");
+        return pChunk + (BiasedIdx - (1u << (FirstChunkSizeLog2 + Chunk)));
+    }
+
+    // Must be called while m_Mutex is locked
+    FixedBlockMemoryAllocator::MagazineRef FixedBlockMemoryAllocator::CreateMagazine()
+    {
+        MagazineRef Mag;
+        Mag.Idx = m_NumMagazines;
+        auto BiasedIdx = Mag.Idx + (1u << FirstChunkSizeLog2);
+        auto Chunk = PlatformMisc::GetMSB(BiasedIdx) - FirstChunkSizeLog2;
+        if (Chunk >= MaxMagazineChunks)
+        {
+            LOG_ERROR_AND_THROW("Too many magazines");
+        }
+
+        if (m_MagazineChunks[Chunk].load(std::memory_order_relaxed) == nullptr)
+        {
+            auto ChunkSize = 1u << (FirstChunkSizeLog2 + Chunk);
+            auto *pChunk = reinterpret_cast<Magazine*>(
+                m_RawMemoryAllocator.Allocate(sizeof(Magazine) * ChunkSize, "FixedBlockMemoryAllocator magazine chunk", __FILE__, __LINE__)
+                );
+            for (Uint32 m = 0; m < ChunkSize; ++m)
+                new(pChunk + m) Magazine;
+            m_MagazineChunks[Chunk].store(pChunk, std::memory_order_release);
+        }
+        ++m_NumMagazines;
+        Mag.pMag = GetMagazine(Mag.Idx);
+        return Mag;
+    }
+
+    void FixedBlockMemoryAllocator::PushMagazine(std::atomic<Uint64>& Stack, MagazineRef Mag)
+    {
+        auto Head = Stack.load(std::memory_order_relaxed);
+        Uint64 NewHead;
+        do
+        {
+            Mag.pMag->NextIdx.store(static_cast<Uint32>(Head), std::memory_order_relaxed);
+            NewHead = ((Head >> 32) + 1) << 32 | Mag.Idx;
+            // Release semantics makes magazine contents visible to the thread that pops it
+        } while (!Stack.compare_exchange_weak(Head, NewHead, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    FixedBlockMemoryAllocator::MagazineRef FixedBlockMemoryAllocator::PopMagazine(std::atomic<Uint64>& Stack)
+    {
+        MagazineRef Mag;
+        auto Head = Stack.load(std::memory_order_acquire);
+        Uint64 NewHead;
+        do
+        {
+            Mag.Idx = static_cast<Uint32>(Head);
+            if (Mag.Idx == InvalidMagazineIndex)
+                return MagazineRef{};
+            // Magazines are never released while the allocator is alive, so reading a
+            // stale link is safe: the tag check will fail and the loop will retry
+            Mag.pMag = GetMagazine(Mag.Idx);
+            auto NextIdx = Mag.pMag->NextIdx.load(std::memory_order_relaxed);
+            NewHead = ((Head >> 32) + 1) << 32 | NextIdx;
+        } while (!Stack.compare_exchange_weak(Head, NewHead, std::memory_order_acquire, std::memory_order_acquire));
+        return Mag;
+    }
+
+    // Must be called while m_Mutex is locked
+    void FixedBlockMemoryAllocator::ReturnBlocksToPages(Magazine& Mag)
+    {
+        for (Uint32 b = 0; b < Mag.NumBlocks; ++b)
+        {
+            auto PageId = FindPage(Mag.Blocks[b]);
+            m_PagePool[PageId].DeAllocate(Mag.Blocks[b]);
+            m_AvailablePages.insert(PageId);
+        }
+        Mag.NumBlocks = 0;
+    }
+
+    FixedBlockMemoryAllocator::ThreadCache* FixedBlockMemoryAllocator::GetThreadCache()
+    {
+        auto &CacheMap = ThreadCaches;
+        if (CacheMap.LastAllocatorId == m_AllocatorId)
+            return reinterpret_cast<ThreadCache*>(CacheMap.pLastCache);
+
+        ThreadCache* pCache = nullptr;
+        auto CacheIt = CacheMap.Caches.find(m_AllocatorId);
+        if (CacheIt != CacheMap.Caches.end())
+        {
+            pCache = reinterpret_cast<ThreadCache*>(CacheIt->second);
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> LockGuard(m_Mutex);
+                // Thread ids may be reused after a thread exits, in which case
+                // the new thread inherits the magazines of the old one
+                auto ThisThreadId = std::this_thread::get_id();
+                for (auto *pTC : m_ThreadCaches)
+                {
+                    if (pTC->ThreadId == ThisThreadId)
+                    {
+                        pCache = pTC;
+                        break;
+                    }
+                }
+
+                if (pCache == nullptr)
+                {
+                    auto *pRawMem = m_RawMemoryAllocator.Allocate(sizeof(ThreadCache), "FixedBlockMemoryAllocator thread cache", __FILE__, __LINE__);
+                    pCache = new(pRawMem) ThreadCache;
+                    pCache->ThreadId = ThisThreadId;
+                    pCache->Loaded   = CreateMagazine();
+                    pCache->Previous = CreateMagazine();
+                    m_ThreadCaches.push_back(pCache);
+                }
+            }
+
+            if (CacheMap.Caches.size() >= CacheMap.PruneThreshold)
+            {
+                auto &LiveIds = GetLiveAllocatorIds();
+                {
+                    std::lock_guard<std::mutex> LockGuard(LiveIds.Mtx);
+                    for (auto It = CacheMap.Caches.begin(); It != CacheMap.Caches.end(); )
+                    {
+                        if (LiveIds.Ids.find(It->first) == LiveIds.Ids.end())
+                            It = CacheMap.Caches.erase(It);
+                        else
+                            ++It;
+                    }
+                }
+                CacheMap.PruneThreshold = std::max(size_t{64}, CacheMap.Caches.size() * 2);
+            }
+            CacheMap.Caches.emplace(m_AllocatorId, pCache);
+        }
+
+        CacheMap.LastAllocatorId = m_AllocatorId;
+        CacheMap.pLastCache      = pCache;
+        return pCache;
+    }
+
+    void* FixedBlockMemoryAllocator::AllocateCached()
+    {
+        auto &Cache = *GetThreadCache();
+        if (Cache.Loaded.pMag->IsEmpty())
+        {
+            if (!Cache.Previous.pMag->IsEmpty())
+            {
+                std::swap(Cache.Loaded, Cache.Previous);
+            }
+            else
+            {
+                auto FullMag = PopMagazine(m_FullMagazines);
+                if (FullMag.pMag != nullptr)
+                {
+                    m_NumFullMagazines.fetch_sub(1, std::memory_order_relaxed);
+                    // Both magazines are empty: return one of them to the depot and load the full one
+                    PushMagazine(m_EmptyMagazines, Cache.Previous);
+                    Cache.Previous = Cache.Loaded;
+                    Cache.Loaded   = FullMag;
+                }
+                else
+                {
+                    // The depot has no full magazines: take blocks from pages
+                    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+                    auto &Mag = *Cache.Loaded.pMag;
+                    while (!Mag.IsFull())
+                    {
+                        if (m_AvailablePages.empty())
+                            CreateNewPage();
+                        auto PageIt = m_AvailablePages.begin();
+                        auto &Page = m_PagePool[*PageIt];
+                        Mag.Blocks[Mag.NumBlocks++] = Page.Allocate();
+                        if (!Page.HasSpace())
+                            m_AvailablePages.erase(PageIt);
+                    }
+                }
+            }
+        }
+
+        auto &Mag = *Cache.Loaded.pMag;
+        VERIFY_EXPR(!Mag.IsEmpty());
+        auto *Ptr = Mag.Blocks[--Mag.NumBlocks];
+        FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+        return Ptr;
+    }
+
+    void FixedBlockMemoryAllocator::FreeCached(void *Ptr)
+    {
+        VERIFY_EXPR(Ptr != nullptr);
+        FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+
+        auto &Cache = *GetThreadCache();
+        if (Cache.Loaded.pMag->IsFull())
+        {
+            if (!Cache.Previous.pMag->IsFull())
+            {
+                std::swap(Cache.Loaded, Cache.Previous);
+            }
+            else if (m_NumFullMagazines.load(std::memory_order_relaxed) >= MaxDepotFullMagazines)
+            {
+                // The depot already holds enough blocks for other threads: return
+                // blocks of one of the magazines to their pages and load it
+                {
+                    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+                    ReturnBlocksToPages(*Cache.Previous.pMag);
+                }
+                std::swap(Cache.Loaded, Cache.Previous);
+            }
+            else
+            {
+                // Both magazines are full: hand one of them over to the depot and load an empty one
+                auto EmptyMag = PopMagazine(m_EmptyMagazines);
+                if (EmptyMag.pMag == nullptr)
+                {
+                    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+                    EmptyMag = CreateMagazine();
+                }
+                PushMagazine(m_FullMagazines, Cache.Previous);
+                m_NumFullMagazines.fetch_add(1, std::memory_order_relaxed);
+                Cache.Previous = Cache.Loaded;
+                Cache.Loaded   = EmptyMag;
+            }
+        }
+
+        auto &Mag = *Cache.Loaded.pMag;
+        VERIFY_EXPR(!Mag.IsFull());
+        Mag.Blocks[Mag.NumBlocks++] = Ptr;
+    }
 }
@@ -24,14 +24,46 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include "Shader.h"
 #include "DataBlob.h"
+#include "ShaderCache.h"
 
 namespace Diligent
 {
 
 void InitializeGlslang();
 void FinalizeGlslang();
+// Returns the string that identifies the compiler and its version
+const char* GetGLSLtoSPIRVCompilerVersion();
 std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char* ShaderSource, IDataBlob** ppCompilerOutput);
 
+// Shader compiled by GLSLtoSPIRVBatch()
+struct GLSLtoSPIRVJob
+{
+    SHADER_TYPE ShaderType   = SHADER_TYPE_UNKNOWN;
+    const char* ShaderSource = nullptr;
+};
+
+// Result of compiling one shader by GLSLtoSPIRVBatch()
+struct GLSLtoSPIRVResult
+{
+    // Empty if the shader failed to compile
+    std::vector<unsigned int> SPIRV;
+    // Parser and linker diagnostics
+    std::string Log;
+};
+
+// Compiles NumJobs shaders on NumThreads threads (0 means the number of hardware threads), the calling
+// thread being one of them. The other threads are taken from a pool that is kept between calls and is
+// destroyed by FinalizeGlslang(). Every thread owns its compiler objects, so the only shared state is the
+// process-wide state set up by InitializeGlslang(), which must be called before this function.
+// Results are returned in the order of the jobs regardless of the number of threads. Errors are not
+// logged, and are only reported in GLSLtoSPIRVResult::Log.
+std::vector<GLSLtoSPIRVResult> GLSLtoSPIRVBatch(const GLSLtoSPIRVJob* pJobs, Uint32 NumJobs, Uint32 NumThreads = 0);
+
+// Builds GLSL source of the Vulkan shader and compiles it to SPIR-V. If the shader cache is provided,
+// the byte code is looked up in the cache first, and newly compiled byte code is stored in the cache.
+std::vector<unsigned int> BuildSPIRV(const ShaderCreationAttribs& CreationAttribs, ShaderCache* pCache);
+
 }
\ No newline at end of file
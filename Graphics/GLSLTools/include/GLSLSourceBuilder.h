@@ -25,6 +25,7 @@
 
 #include "BasicTypes.h"
 #include "Shader.h"
+#include "ShaderCache.h"
 
 namespace Diligent
 {
@@ -35,6 +36,27 @@ enum TargetGLSLCompiler
     driver
 };
 
-String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions = nullptr);
+// Shader source split into the definitions generated by the engine (GLSL version, platform,
+// shader type and macros) and the source provided by the application.
+struct ExpandedShaderSource
+{
+    String Definitions;
+    String Source;
+};
+
+// If ExpandIncludes is true, all #include directives in the source of HLSL shaders are expanded, so that
+// the source fully identifies the shader. This is only required to compute the cache key, as the converter
+// otherwise expands the includes itself.
+ExpandedShaderSource ExpandShaderSource(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions, bool ExpandIncludes);
+
+// Computes the key that identifies the result of the shader compilation in the shader cache.
+// CompilerVersion must identify the compiler that processes the GLSL source and its version.
+ShaderCache::Key ComputeShaderCacheKey(const ExpandedShaderSource& ExpandedSource, const ShaderCreationAttribs& CreationAttribs, const char* CompilerVersion);
+
+String BuildGLSLSourceString(const ExpandedShaderSource& ExpandedSource, const ShaderCreationAttribs& CreationAttribs);
+
+// If the shader cache is provided, HLSL shaders converted to GLSL are looked up in the 
+// cache first, and the results of new conversions are stored in the cache.
+String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions = nullptr, ShaderCache* pCache = nullptr);
 
 }
\ No newline at end of file
@@ -43,6 +43,7 @@
 #include "HashUtils.h"
 #include "RefCntAutoPtr.h"
 #include "StringPool.h"
+#include "ShaderCache.h"
 
 namespace spirv_cross
 {
@@ -108,6 +109,14 @@ struct SPIRVShaderResourceAttribs
                                SHADER_VARIABLE_TYPE         _VarType,
                                Int32                        _StaticSamplerInd)noexcept;
 
+    SPIRVShaderResourceAttribs(const char*          _Name,
+                               Uint16               _ArraySize,
+                               ResourceType         _Type,
+                               SHADER_VARIABLE_TYPE _VarType,
+                               Int32                _StaticSamplerInd,
+                               uint32_t             _BindingDecorationOffset,
+                               uint32_t             _DescriptorSetDecorationOffset)noexcept;
+
     String GetPrintName(Uint32 ArrayInd)const
     {
         VERIFY_EXPR(ArrayInd < ArraySize);
@@ -140,6 +149,14 @@ public:
                          std::vector<uint32_t>  spirv_binary,
                          const ShaderDesc&      shaderDesc);
 
+    /// Loads resources from the reflection data written by SerializeReflection() without
+    /// parsing SPIR-V. Throws an exception if the data is not valid.
+    SPIRVShaderResources(IMemoryAllocator&      Allocator,
+                         IRenderDevice*         pRenderDevice,
+                         const void*            pReflectionData,
+                         size_t                 DataSize,
+                         const ShaderDesc&      shaderDesc);
+
     SPIRVShaderResources             (const SPIRVShaderResources&) = delete;
     SPIRVShaderResources             (SPIRVShaderResources&&)      = delete;
     SPIRVShaderResources& operator = (const SPIRVShaderResources&) = delete;
@@ -277,6 +294,17 @@ public:
     std::string DumpResources();
 
     bool IsCompatibleWith(const SPIRVShaderResources& Resources)const;
+
+    /// Writes reflected attributes of all resources, names included, to a compact binary blob.
+    /// Variable types and static samplers are not written as they are defined by the shader description.
+    void SerializeReflection(std::vector<Uint8>& Data)const;
+
+    /// Version of the reflection data format. Must be incremented whenever the format
+    /// or the way resources are reflected changes.
+    static constexpr Uint32 ReflectionDataVersion = 1;
+
+    /// Returns the key of the reflection data of the SPIR-V binary in the shader cache
+    static ShaderCache::Key GetReflectionCacheKey(const std::vector<uint32_t>& SPIRV);
     
     //size_t GetHash()const;
 
@@ -292,6 +320,10 @@ protected:
                     Uint32              NumStaticSamplers,
                     size_t              ResourceNamesPoolSize);
 
+    // Creates static samplers and verifies that all variables and static samplers 
+    // from the shader description are found in the shader
+    void InitializeStaticSamplers(IRenderDevice* pRenderDevice, const ShaderDesc& shaderDesc);
+
     __forceinline SPIRVShaderResourceAttribs& GetResAttribs(Uint32 n, Uint32 NumResources, Uint32 Offset)noexcept
     {
         VERIFY(n < NumResources, "Resource index (", n, ") is out of range. Resource array size: ", NumResources);
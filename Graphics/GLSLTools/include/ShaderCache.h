@@ -0,0 +1,136 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderCache class
+
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Persistent content-addressed cache of shader compilation results
+
+/// Every entry is identified by a 128-bit hash of all inputs that affect the result: the expanded 
+/// shader source, macro definitions, entry point, shader type and the version of the compiler.
+/// The cache file consists of a header, an index of entries sorted by key, and the entry data.
+/// The file is memory-mapped when the cache is opened, and lookups of existing entries are served 
+/// directly from the mapped index. New entries are kept in memory and are written to the file 
+/// by Flush() or when the cache is destroyed.
+///
+/// All methods are thread-safe.
+class ShaderCache
+{
+public:
+    struct Key
+    {
+        Uint64 Hash[2] = {};
+
+        bool operator == (const Key& K)const { return Hash[0] == K.Hash[0] && Hash[1] == K.Hash[1]; }
+        bool operator != (const Key& K)const { return !(*this == K); }
+        bool operator <  (const Key& K)const { return Hash[0] < K.Hash[0] || Hash[0] == K.Hash[0] && Hash[1] < K.Hash[1]; }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K)const { return static_cast<size_t>(K.Hash[0] ^ K.Hash[1]); }
+        };
+    };
+
+    /// Accumulates the inputs of a shader compilation and computes the cache key
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder& Add(const void* pData, size_t Size);
+        KeyBuilder& Add(const Char* Str);
+        KeyBuilder& Add(const String& Str) { return Add(Str.c_str(), Str.length()); }
+        KeyBuilder& Add(Uint32 Value)      { return Add(&Value, sizeof(Value)); }
+
+        Key Finish()const;
+
+    private:
+        // Every input is prefixed with its size, so that different sequences 
+        // of inputs never produce the same byte stream
+        std::vector<Uint8> m_Data;
+    };
+
+    struct Statistics
+    {
+        Uint32 NumHits    = 0;
+        Uint32 NumMisses  = 0;
+        Uint32 NumStores  = 0;
+        Uint32 NumEntries = 0;
+        Uint64 DataSize   = 0; // Total size of the data of all entries
+    };
+
+    /// Opens the cache file. If the file does not exist or is not a valid cache file, 
+    /// the cache starts empty and the file will be created when the cache is flushed.
+    explicit ShaderCache(const Char* FilePath);
+    ~ShaderCache();
+
+    ShaderCache             (const ShaderCache&) = delete;
+    ShaderCache             (ShaderCache&&)      = delete;
+    ShaderCache& operator = (const ShaderCache&) = delete;
+    ShaderCache& operator = (ShaderCache&&)      = delete;
+
+    /// Copies the data of the entry to Data and returns true if the entry is found
+    bool Find(const Key& K, std::vector<Uint8>& Data);
+
+    /// Adds new entry to the cache. Entries that are already present are not replaced.
+    void Store(const Key& K, const void* pData, size_t Size);
+
+    /// Writes all new entries to the cache file
+    bool Flush();
+
+    Statistics GetStatistics();
+
+    const String& GetFilePath()const { return m_FilePath; }
+
+private:
+    class  MappedFile;
+    struct FileHeader;
+    struct IndexEntry;
+
+    void OpenFile();
+    const IndexEntry* FindInFile(const Key& K)const;
+    bool FlushInternal();
+
+    const String m_FilePath;
+
+    std::mutex m_Mutex;
+    std::unique_ptr<MappedFile> m_pFile;
+    const IndexEntry*           m_pIndex          = nullptr;
+    Uint32                      m_NumIndexEntries = 0;
+
+    std::unordered_map<Key, std::vector<Uint8>, Key::Hasher> m_NewEntries;
+    Statistics m_Stats;
+};
+
+}
@@ -36,13 +36,44 @@
 #	include "SPIRV/GlslangToSpv.h"
 #endif
 
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <algorithm>
+
 #include "GLSL2SPIRV.h"
+#include "GLSLSourceBuilder.h"
 #include "DebugUtilities.h"
 #include "DataBlobImpl.h"
+#include "ThreadPool.h"
 
 namespace Diligent
 {
 
+#if !PLATFORM_ANDROID
+// Worker threads of GLSLtoSPIRVBatch(). The pool is created by the first batch that needs it and is reused
+// by the following batches. It is replaced by a larger pool if a batch requests more threads, and is destroyed
+// by FinalizeGlslang(). Batches hold a reference to the pool, so a replaced pool is destroyed by the last batch
+// that uses it.
+static std::mutex                                  g_CompilerPoolMtx;
+static std::shared_ptr<ThreadingTools::ThreadPool> g_pCompilerPool;
+
+static std::shared_ptr<ThreadingTools::ThreadPool> GetCompilerPool(Uint32 NumWorkers)
+{
+    std::lock_guard<std::mutex> Lock(g_CompilerPoolMtx);
+    if (!g_pCompilerPool || g_pCompilerPool->GetNumThreads() < NumWorkers)
+    {
+        // The calling thread compiles as well, so a pool of one thread less than the number of
+        // hardware threads serves all batches that use the default number of threads
+        const auto DefaultNumWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        g_pCompilerPool = std::make_shared<ThreadingTools::ThreadPool>(std::max(NumWorkers, DefaultNumWorkers));
+    }
+    return g_pCompilerPool;
+}
+#endif
+
 void InitializeGlslang()
 {
 #if !PLATFORM_ANDROID
@@ -53,6 +84,11 @@ void InitializeGlslang()
 void FinalizeGlslang()
 {
 #if !PLATFORM_ANDROID
+    {
+        // Worker threads must be joined before the process-wide state is released
+        std::lock_guard<std::mutex> Lock(g_CompilerPoolMtx);
+        g_pCompilerPool.reset();
+    }
     glslang::FinalizeProcess();
 #endif
 }
@@ -279,26 +315,27 @@ static void InitializeCompilerOutputBlob(const char* ShaderSource, const std::st
     pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
 }
 
-std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char* ShaderSource, IDataBlob** ppCompilerOutput) 
+const char* GetGLSLtoSPIRVCompilerVersion()
 {
 #if PLATFORM_ANDROID
-
-    // On Android, use shaderc instead.
-    shaderc::Compiler compiler;
-    shaderc::SpvCompilationResult module =
-        compiler.CompileGlslToSpv(pshader, strlen(pshader), MapShadercType(shader_type), "shader");
-    if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
-        LOGE("Error: Id=%d, Msg=%s", module.GetCompilationStatus(), module.GetErrorMessage().c_str());
-        return false;
-    }
-    std::vector<unsigned int> spirv;
-    spirv.assign(module.cbegin(), module.cend());
-
+    return "shaderc";
 #else
+    static const std::string Version = std::string("glslang ") + glslang::GetGlslVersionString() + 
+                                       ", SPIR-V generator " + std::to_string(glslang::GetSpirvGeneratorVersion());
+    return Version.c_str();
+#endif
+}
 
+#if !PLATFORM_ANDROID
+// Compiles the shader using compiler objects local to the calling thread. Returns empty 
+// byte code and the compiler diagnostics if the shader fails to compile.
+static std::vector<unsigned int> CompileShader(SHADER_TYPE             ShaderType,
+                                               const char*             ShaderSource,
+                                               const TBuiltInResource& Resources,
+                                               std::string&            Log)
+{
     EShLanguage ShLang = ShaderTypeToShLanguage(ShaderType);
     glslang::TShader Shader(ShLang);
-    TBuiltInResource Resources = InitResources();
 
     // Enable SPIR-V and Vulkan rules when parsing GLSL
     EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
@@ -309,16 +346,13 @@ std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char*
     Shader.setAutoMapBindings(true);
     if (!Shader.parse(&Resources, 100, false, messages))
     {
-        std::string Log(Shader.getInfoLog());
+        Log = "Failed to parse shader source: \n";
+        Log.append(Shader.getInfoLog());
         if(*Shader.getInfoDebugLog() != '\0')
         {
             Log.push_back('\n');
             Log.append(Shader.getInfoDebugLog());
         }
-        LOG_ERROR_MESSAGE("Failed to parse shader source: \n", Log);
-        if(ppCompilerOutput != nullptr)
-            InitializeCompilerOutputBlob(ShaderSource, Log, ppCompilerOutput);
-
         return {};
     }
 
@@ -326,16 +360,13 @@ std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char*
     Program.addShader(&Shader);
     if (!Program.link(messages))
     {
-        std::string Log(Shader.getInfoLog());
-        if(*Shader.getInfoDebugLog() != '\0')
+        Log = "Failed to link program: \n";
+        Log.append(Program.getInfoLog());
+        if(*Program.getInfoDebugLog() != '\0')
         {
             Log.push_back('\n');
-            Log.append(Shader.getInfoDebugLog());
+            Log.append(Program.getInfoDebugLog());
         }
-        LOG_ERROR_MESSAGE("Failed to link program: \n", Log);
-        if(ppCompilerOutput != nullptr)
-            InitializeCompilerOutputBlob(ShaderSource, Log, ppCompilerOutput);
-
         return {};
     }
 
@@ -345,9 +376,134 @@ std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char*
 
     std::vector<unsigned int> spirv;
     glslang::GlslangToSpv(*Program.getIntermediate(ShLang), spirv);
+    return spirv;
+}
+#endif
+
+std::vector<unsigned int> GLSLtoSPIRV(const SHADER_TYPE ShaderType, const char* ShaderSource, IDataBlob** ppCompilerOutput) 
+{
+#if PLATFORM_ANDROID
+
+    // On Android, use shaderc instead.
+    shaderc::Compiler compiler;
+    shaderc::SpvCompilationResult module =
+        compiler.CompileGlslToSpv(pshader, strlen(pshader), MapShadercType(shader_type), "shader");
+    if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
+        LOGE("Error: Id=%d, Msg=%s", module.GetCompilationStatus(), module.GetErrorMessage().c_str());
+        return false;
+    }
+    std::vector<unsigned int> spirv;
+    spirv.assign(module.cbegin(), module.cend());
+
+#else
+
+    TBuiltInResource Resources = InitResources();
+    std::string Log;
+    auto spirv = CompileShader(ShaderType, ShaderSource, Resources, Log);
+    if (spirv.empty())
+    {
+        LOG_ERROR_MESSAGE(Log);
+        if(ppCompilerOutput != nullptr)
+            InitializeCompilerOutputBlob(ShaderSource, Log, ppCompilerOutput);
+    }
 #endif
 
-    return std::move(spirv);
+    return spirv;
+}
+
+std::vector<GLSLtoSPIRVResult> GLSLtoSPIRVBatch(const GLSLtoSPIRVJob* pJobs, Uint32 NumJobs, Uint32 NumThreads)
+{
+    std::vector<GLSLtoSPIRVResult> Results(NumJobs);
+    if (NumJobs == 0)
+        return Results;
+
+#if PLATFORM_ANDROID
+    // shaderc compiler is not used from multiple threads
+    for (Uint32 job = 0; job < NumJobs; ++job)
+        Results[job].SPIRV = GLSLtoSPIRV(pJobs[job].ShaderType, pJobs[job].ShaderSource, nullptr);
+#else
+    if (NumThreads == 0)
+        NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    NumThreads = std::min(NumThreads, NumJobs);
+
+    // A worker task may only start after the calling thread has compiled all jobs, for instance when
+    // the pool is busy with another batch, so the state the tasks share is kept alive by the tasks
+    struct BatchState
+    {
+        std::atomic<Uint32>     NextJob{0};
+        std::mutex              CompletedJobsMtx;
+        std::condition_variable CompletedJobsCondVar;
+        Uint32                  NumCompletedJobs = 0;
+    };
+    auto pState = std::make_shared<BatchState>();
+
+    // Threads take jobs one at a time, so that long shaders do not leave other threads idle.
+    // Every job writes to its own slot in the results array, which makes the order deterministic.
+    // A thread that has not taken any job never accesses the jobs or the results.
+    auto* pResults = Results.data();
+    auto CompileJobs = [pState, pJobs, pResults, NumJobs]()
+    {
+        auto job = pState->NextJob.fetch_add(1);
+        if (job >= NumJobs)
+            return;
+
+        TBuiltInResource Resources = InitResources();
+        Uint32 NumCompiledJobs = 0;
+        for (; job < NumJobs; job = pState->NextJob.fetch_add(1))
+        {
+            const auto& Job = pJobs[job];
+            auto&    Result = pResults[job];
+            VERIFY_EXPR(Job.ShaderSource != nullptr);
+            Result.SPIRV = CompileShader(Job.ShaderType, Job.ShaderSource, Resources, Result.Log);
+            ++NumCompiledJobs;
+        }
+
+        std::lock_guard<std::mutex> Lock(pState->CompletedJobsMtx);
+        pState->NumCompletedJobs += NumCompiledJobs;
+        if (pState->NumCompletedJobs == NumJobs)
+            pState->CompletedJobsCondVar.notify_all();
+    };
+
+    if (NumThreads > 1)
+    {
+        auto pPool = GetCompilerPool(NumThreads - 1);
+        for (Uint32 t = 1; t < NumThreads; ++t)
+            pPool->EnqueueTask(CompileJobs);
+    }
+    CompileJobs();
+
+    std::unique_lock<std::mutex> Lock(pState->CompletedJobsMtx);
+    pState->CompletedJobsCondVar.wait(Lock, [&]{ return pState->NumCompletedJobs == NumJobs; });
+#endif
+
+    return Results;
+}
+
+std::vector<unsigned int> BuildSPIRV(const ShaderCreationAttribs& CreationAttribs, ShaderCache* pCache)
+{
+    // Includes only need to be expanded to compute the cache key
+    auto ExpandedSource = ExpandShaderSource(CreationAttribs, TargetGLSLCompiler::glslang, "#define TARGET_API_VULKAN 1\n", pCache != nullptr);
+
+    ShaderCache::Key CacheKey;
+    if (pCache != nullptr)
+    {
+        CacheKey = ComputeShaderCacheKey(ExpandedSource, CreationAttribs, GetGLSLtoSPIRVCompilerVersion());
+        std::vector<Uint8> CachedByteCode;
+        if (pCache->Find(CacheKey, CachedByteCode) && CachedByteCode.size() % sizeof(unsigned int) == 0)
+        {
+            std::vector<unsigned int> SPIRV(CachedByteCode.size() / sizeof(unsigned int));
+            memcpy(SPIRV.data(), CachedByteCode.data(), CachedByteCode.size());
+            return SPIRV;
+        }
+    }
+
+    auto GLSLSource = BuildGLSLSourceString(ExpandedSource, CreationAttribs);
+    auto SPIRV = GLSLtoSPIRV(CreationAttribs.Desc.ShaderType, GLSLSource.c_str(), CreationAttribs.ppCompilerOutput);
+    // Failed compilations are not cached
+    if (pCache != nullptr && !SPIRV.empty())
+        pCache->Store(CacheKey, SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+
+    return SPIRV;
 }
 
 }
@@ -32,9 +32,10 @@
 namespace Diligent
 {
 
-String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions)
+ExpandedShaderSource ExpandShaderSource(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions, bool ExpandIncludes)
 {
-    String GLSLSource;
+    ExpandedShaderSource ExpandedSource;
+    auto& GLSLSource = ExpandedSource.Definitions;
 
     auto ShaderType = CreationAttribs.Desc.ShaderType;
 
@@ -228,6 +229,38 @@ String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, Targe
         SourceLen = pFileData->GetSize();
     }
 
+    ExpandedSource.Source.assign(ShaderSource, SourceLen);
+    if (ExpandIncludes && CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL && CreationAttribs.pShaderSourceStreamFactory != nullptr)
+    {
+        // Expand includes so that the source fully identifies the shader. 
+        // The converter will not find any #include directives in the expanded source.
+        HLSL2GLSLConverterImpl::InsertIncludes(ExpandedSource.Source, CreationAttribs.pShaderSourceStreamFactory);
+    }
+
+    return ExpandedSource;
+}
+
+ShaderCache::Key ComputeShaderCacheKey(const ExpandedShaderSource& ExpandedSource, const ShaderCreationAttribs& CreationAttribs, const char* CompilerVersion)
+{
+    ShaderCache::KeyBuilder Builder;
+    Builder.Add(CompilerVersion)
+           .Add(static_cast<Uint32>(CreationAttribs.Desc.ShaderType))
+           .Add(static_cast<Uint32>(CreationAttribs.SourceLanguage))
+           .Add(ExpandedSource.Definitions)
+           .Add(ExpandedSource.Source);
+    if (CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+    {
+        Builder.Add(HLSL2GLSLConverterImpl::Revision)
+               .Add(CreationAttribs.EntryPoint)
+               .Add(CreationAttribs.CombinedSamplerSuffix)
+               .Add(CreationAttribs.UseCombinedTextureSamplers ? Uint32{1} : Uint32{0});
+    }
+    return Builder.Finish();
+}
+
+String BuildGLSLSourceString(const ExpandedShaderSource& ExpandedSource, const ShaderCreationAttribs& CreationAttribs)
+{
+    auto GLSLSource = ExpandedSource.Definitions;
     if (CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
     {
         if (!CreationAttribs.UseCombinedTextureSamplers)
@@ -239,8 +272,8 @@ String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, Targe
         HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
         Attribs.pSourceStreamFactory = CreationAttribs.pShaderSourceStreamFactory;
         Attribs.ppConversionStream = CreationAttribs.ppConversionStream;
-        Attribs.HLSLSource = ShaderSource;
-        Attribs.NumSymbols = SourceLen;
+        Attribs.HLSLSource = ExpandedSource.Source.c_str();
+        Attribs.NumSymbols = ExpandedSource.Source.length();
         Attribs.EntryPoint = CreationAttribs.EntryPoint;
         Attribs.ShaderType = CreationAttribs.Desc.ShaderType;
         Attribs.IncludeDefinitions = true;
@@ -251,9 +284,27 @@ String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, Targe
         GLSLSource.append(ConvertedSource);
     }
     else
-        GLSLSource.append(ShaderSource, SourceLen);
+        GLSLSource.append(ExpandedSource.Source);
 
     return GLSLSource;
 }
 
+String BuildGLSLSourceString(const ShaderCreationAttribs& CreationAttribs, TargetGLSLCompiler TargetCompiler, const char* ExtraDefinitions, ShaderCache* pCache)
+{
+    // GLSL shaders are used as is, so only the results of HLSL conversion are cached
+    const bool UseCache = pCache != nullptr && CreationAttribs.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL;
+    auto ExpandedSource = ExpandShaderSource(CreationAttribs, TargetCompiler, ExtraDefinitions, UseCache);
+    if (!UseCache)
+        return BuildGLSLSourceString(ExpandedSource, CreationAttribs);
+
+    auto CacheKey = ComputeShaderCacheKey(ExpandedSource, CreationAttribs, "GLSL");
+    std::vector<Uint8> CachedSource;
+    if (pCache->Find(CacheKey, CachedSource))
+        return String(reinterpret_cast<const Char*>(CachedSource.data()), CachedSource.size());
+
+    auto GLSLSource = BuildGLSLSourceString(ExpandedSource, CreationAttribs);
+    pCache->Store(CacheKey, GLSLSource.data(), GLSLSource.length());
+    return GLSLSource;
+}
+
 }
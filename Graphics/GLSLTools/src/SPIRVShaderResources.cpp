@@ -22,6 +22,7 @@
  */
 
 #include <iomanip>
+#include <cstring>
 #include "SPIRVShaderResources.h"
 #include "spirv_cross.hpp"
 #include "ShaderBase.h"
@@ -63,13 +64,30 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const spirv_cross::Compil
                                                        ResourceType                  _Type, 
                                                        SHADER_VARIABLE_TYPE          _VarType,
                                                        Int32                         _StaticSamplerInd)noexcept :
+    SPIRVShaderResourceAttribs(_Name,
+                               GetResourceArraySize<Uint16>(Compiler, Res),
+                               _Type,
+                               _VarType,
+                               _StaticSamplerInd,
+                               GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationBinding),
+                               GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationDescriptorSet))
+{
+}
+
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*          _Name,
+                                                       Uint16               _ArraySize,
+                                                       ResourceType         _Type,
+                                                       SHADER_VARIABLE_TYPE _VarType,
+                                                       Int32                _StaticSamplerInd,
+                                                       uint32_t             _BindingDecorationOffset,
+                                                       uint32_t             _DescriptorSetDecorationOffset)noexcept :
     Name(_Name),
-    ArraySize(GetResourceArraySize<decltype(ArraySize)>(Compiler, Res)),
+    ArraySize(_ArraySize),
     Type(_Type),
     VarType(_VarType),
     StaticSamplerInd(static_cast<decltype(StaticSamplerInd)>(_StaticSamplerInd)),
-    BindingDecorationOffset(GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationBinding)),
-    DescriptorSetDecorationOffset(GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationDescriptorSet))
+    BindingDecorationOffset(_BindingDecorationOffset),
+    DescriptorSetDecorationOffset(_DescriptorSetDecorationOffset)
 {
     VERIFY(_StaticSamplerInd >= std::numeric_limits<decltype(StaticSamplerInd)>::min() && 
            _StaticSamplerInd <= std::numeric_limits<decltype(StaticSamplerInd)>::max(), "Static sampler index is out of representable range" );
@@ -243,6 +261,171 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator,
 
     VERIFY(m_ResourceNames.GetRemainingSize() == 0, "Names pool must be empty");
 
+    InitializeStaticSamplers(pRenderDevice, shaderDesc);
+}
+
+namespace
+{
+
+// Reflection data layout:
+//
+//  | Header | Resource 0 | Resource 1 | ... | Resource N-1 | Resource names |
+//
+// Resources are stored in the same order as in the memory buffer. Resource names are 
+// null-terminated strings, and every resource stores the offset of its name.
+struct ReflectionDataHeader
+{
+    static constexpr Uint32 MagicNumber = 0x52525344; // 'DSRR'
+
+    Uint32 Magic;
+    Uint32 Version;
+    // Number of resources of every kind, in the order of the memory buffer: 
+    // UBs, SBs, StrgImgs, SmplImgs, ACs, SepImgs, SepSamplers
+    Uint32 NumResources[7];
+    Uint32 NamesPoolSize;
+};
+
+struct ReflectionDataResource
+{
+    Uint32 BindingDecorationOffset;
+    Uint32 DescriptorSetDecorationOffset;
+    Uint32 NameOffset;
+    Uint16 ArraySize;
+    Uint8  Type;
+    Uint8  Padding;
+};
+static_assert(sizeof(ReflectionDataResource) == 16, "Reflection data format must not depend on the compiler");
+
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator, 
+                                           IRenderDevice*            pRenderDevice,
+                                           const void*               pReflectionData,
+                                           size_t                    DataSize,
+                                           const ShaderDesc&         shaderDesc) :
+    m_ShaderType(shaderDesc.ShaderType)
+{
+    // Validate the data before allocating memory so that no cleanup is required
+    const auto* pData = reinterpret_cast<const Uint8*>(pReflectionData);
+    if (pData == nullptr || DataSize < sizeof(ReflectionDataHeader))
+        LOG_ERROR_AND_THROW("Shader resource reflection data is too small");
+
+    ReflectionDataHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != ReflectionDataHeader::MagicNumber || Header.Version != ReflectionDataVersion)
+        LOG_ERROR_AND_THROW("Shader resource reflection data has unexpected format or version");
+
+    Uint64 TotalResources = 0;
+    for (auto NumRes : Header.NumResources)
+        TotalResources += NumRes;
+    if (TotalResources > std::numeric_limits<OffsetType>::max())
+        LOG_ERROR_AND_THROW("Shader resource reflection data is corrupted: too many resources");
+
+    const auto* pResources = pData + sizeof(Header);
+    const auto* pNames     = pResources + TotalResources * sizeof(ReflectionDataResource);
+    if (DataSize != sizeof(Header) + TotalResources * sizeof(ReflectionDataResource) + Header.NamesPoolSize)
+        LOG_ERROR_AND_THROW("Shader resource reflection data is corrupted: unexpected size");
+    if (Header.NamesPoolSize > 0 && pNames[Header.NamesPoolSize - 1] != '\0')
+        LOG_ERROR_AND_THROW("Shader resource reflection data is corrupted: names are not terminated");
+
+    size_t NamesSize = 0;
+    for (Uint32 res = 0; res < TotalResources; ++res)
+    {
+        ReflectionDataResource Res;
+        memcpy(&Res, pResources + res * sizeof(Res), sizeof(Res));
+        if (Res.NameOffset >= Header.NamesPoolSize || Res.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes)
+            LOG_ERROR_AND_THROW("Shader resource reflection data is corrupted: invalid resource ", res);
+        NamesSize += strlen(reinterpret_cast<const char*>(pNames + Res.NameOffset)) + 1;
+    }
+
+    Initialize(Allocator, 
+               Header.NumResources[0],
+               Header.NumResources[1],
+               Header.NumResources[2],
+               Header.NumResources[3],
+               Header.NumResources[4],
+               Header.NumResources[5],
+               Header.NumResources[6],
+               shaderDesc.NumStaticSamplers,
+               NamesSize);
+
+    for (Uint32 res = 0; res < TotalResources; ++res)
+    {
+        ReflectionDataResource Res;
+        memcpy(&Res, pResources + res * sizeof(Res), sizeof(Res));
+        auto ResType = static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type);
+        const auto* Name = m_ResourceNames.CopyString(reinterpret_cast<const char*>(pNames + Res.NameOffset));
+        Int32 StaticSamplerInd = -1;
+        if (ResType == SPIRVShaderResourceAttribs::ResourceType::SampledImage       ||
+            ResType == SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer ||
+            ResType == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler)
+        {
+            StaticSamplerInd = FindStaticSampler(shaderDesc, Name);
+        }
+        new (&GetResource(res))
+            SPIRVShaderResourceAttribs(Name,
+                                       Res.ArraySize,
+                                       ResType,
+                                       GetShaderVariableType(Name, shaderDesc),
+                                       StaticSamplerInd,
+                                       Res.BindingDecorationOffset,
+                                       Res.DescriptorSetDecorationOffset);
+    }
+    VERIFY(m_ResourceNames.GetRemainingSize() == 0, "Names pool must be empty");
+
+    InitializeStaticSamplers(pRenderDevice, shaderDesc);
+}
+
+void SPIRVShaderResources::SerializeReflection(std::vector<Uint8>& Data)const
+{
+    ReflectionDataHeader Header = {};
+    Header.Magic   = ReflectionDataHeader::MagicNumber;
+    Header.Version = ReflectionDataVersion;
+    Header.NumResources[0] = GetNumUBs();
+    Header.NumResources[1] = GetNumSBs();
+    Header.NumResources[2] = GetNumImgs();
+    Header.NumResources[3] = GetNumSmplImgs();
+    Header.NumResources[4] = GetNumACs();
+    Header.NumResources[5] = GetNumSepImgs();
+    Header.NumResources[6] = GetNumSepSmpls();
+    for (Uint32 res = 0; res < GetTotalResources(); ++res)
+        Header.NamesPoolSize += static_cast<Uint32>(strlen(GetResource(res).Name) + 1);
+
+    const auto ResourcesOffset = sizeof(Header);
+    const auto NamesOffset     = ResourcesOffset + GetTotalResources() * sizeof(ReflectionDataResource);
+    Data.resize(NamesOffset + Header.NamesPoolSize);
+    memcpy(Data.data(), &Header, sizeof(Header));
+
+    Uint32 NameOffset = 0;
+    for (Uint32 res = 0; res < GetTotalResources(); ++res)
+    {
+        const auto& Attribs = GetResource(res);
+        ReflectionDataResource Res = {};
+        Res.BindingDecorationOffset       = Attribs.BindingDecorationOffset;
+        Res.DescriptorSetDecorationOffset = Attribs.DescriptorSetDecorationOffset;
+        Res.NameOffset                    = NameOffset;
+        Res.ArraySize                     = Attribs.ArraySize;
+        Res.Type                          = static_cast<Uint8>(Attribs.Type);
+        memcpy(Data.data() + ResourcesOffset + res * sizeof(Res), &Res, sizeof(Res));
+
+        auto NameLen = strlen(Attribs.Name) + 1;
+        memcpy(Data.data() + NamesOffset + NameOffset, Attribs.Name, NameLen);
+        NameOffset += static_cast<Uint32>(NameLen);
+    }
+    VERIFY_EXPR(NameOffset == Header.NamesPoolSize);
+}
+
+ShaderCache::Key SPIRVShaderResources::GetReflectionCacheKey(const std::vector<uint32_t>& SPIRV)
+{
+    ShaderCache::KeyBuilder Builder;
+    Builder.Add("SPIRVShaderResources")
+           .Add(ReflectionDataVersion)
+           .Add(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+    return Builder.Finish();
+}
+
+void SPIRVShaderResources::InitializeStaticSamplers(IRenderDevice* pRenderDevice, const ShaderDesc& shaderDesc)
+{
     for (Uint32 s = 0; s < m_NumStaticSamplers; ++s)
     {
         SamplerPtrType &pStaticSampler = GetStaticSampler(s);
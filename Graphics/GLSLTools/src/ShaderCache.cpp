@@ -0,0 +1,506 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <cstdio>
+#include <cstring>
+
+#if PLATFORM_WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <Windows.h>
+#elif PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_ANDROID || PLATFORM_IOS
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   define SHADER_CACHE_USE_MMAP 1
+#endif
+
+#include "ShaderCache.h"
+#include "Errors.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+// The file is stored in the native byte order of the platform that created it
+struct ShaderCache::FileHeader
+{
+    static constexpr Uint32 ExpectedMagic  = 0x48534744; // 'DGSH'
+    static constexpr Uint32 CurrentVersion = 1;
+
+    Uint32 Magic      = ExpectedMagic;
+    Uint32 Version    = CurrentVersion;
+    Uint32 NumEntries = 0;
+    Uint32 Reserved   = 0;
+};
+
+struct ShaderCache::IndexEntry
+{
+    Key    EntryKey;
+    // Offset of the entry data from the beginning of the file
+    Uint64 Offset = 0;
+    Uint64 Size   = 0;
+};
+
+static_assert(sizeof(ShaderCache::Key) == 16, "Unexpected key size");
+
+// Returns the path of the temporary file the cache is written to before it replaces the cache file.
+// The name is unique to the process and the flush, so that several processes or cache instances
+// that flush the same file at the same time never write to the same temporary file.
+static String GetTempFilePath(const String& FilePath)
+{
+    static std::atomic<Uint32> FlushCounter{0};
+#if PLATFORM_WIN32
+    const auto ProcessId = static_cast<Uint64>(GetCurrentProcessId());
+#elif SHADER_CACHE_USE_MMAP
+    const auto ProcessId = static_cast<Uint64>(getpid());
+#else
+    const auto ProcessId = static_cast<Uint64>(std::random_device{}());
+#endif
+    return FilePath + '.' + std::to_string(ProcessId) + '.' + std::to_string(FlushCounter++) + ".tmp";
+}
+
+
+// Read-only view of the cache file contents
+class ShaderCache::MappedFile
+{
+public:
+    MappedFile(const Char* Path)
+    {
+#if PLATFORM_WIN32
+        m_hFile = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER FileSize = {};
+        if (!GetFileSizeEx(m_hFile, &FileSize) || FileSize.QuadPart == 0)
+            return;
+
+        m_hMapping = CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_hMapping == NULL)
+            return;
+
+        m_pData = reinterpret_cast<const Uint8*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_pData != nullptr)
+            m_Size = static_cast<size_t>(FileSize.QuadPart);
+#elif SHADER_CACHE_USE_MMAP
+        auto fd = open(Path, O_RDONLY);
+        if (fd < 0)
+            return;
+
+        struct stat FileStat;
+        if (fstat(fd, &FileStat) == 0 && FileStat.st_size > 0)
+        {
+            auto* pData = mmap(nullptr, static_cast<size_t>(FileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pData != MAP_FAILED)
+            {
+                m_pData = reinterpret_cast<const Uint8*>(pData);
+                m_Size  = static_cast<size_t>(FileStat.st_size);
+            }
+        }
+        // The mapping remains valid after the file is closed
+        close(fd);
+#else
+        // Memory mapping is not available on this platform, so read the whole file
+        auto* pFile = fopen(Path, "rb");
+        if (pFile == nullptr)
+            return;
+
+        fseek(pFile, 0, SEEK_END);
+        auto FileSize = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+        if (FileSize > 0)
+        {
+            m_Data.resize(static_cast<size_t>(FileSize));
+            if (fread(m_Data.data(), 1, m_Data.size(), pFile) == m_Data.size())
+            {
+                m_pData = m_Data.data();
+                m_Size  = m_Data.size();
+            }
+        }
+        fclose(pFile);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#if PLATFORM_WIN32
+        if (m_pData != nullptr)
+            UnmapViewOfFile(m_pData);
+        if (m_hMapping != NULL)
+            CloseHandle(m_hMapping);
+        if (m_hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hFile);
+#elif SHADER_CACHE_USE_MMAP
+        if (m_pData != nullptr)
+            munmap(const_cast<Uint8*>(m_pData), m_Size);
+#endif
+    }
+
+    MappedFile             (const MappedFile&) = delete;
+    MappedFile             (MappedFile&&)      = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+    MappedFile& operator = (MappedFile&&)      = delete;
+
+    const Uint8* GetData()const { return m_pData; }
+    size_t       GetSize()const { return m_Size;  }
+
+private:
+#if PLATFORM_WIN32
+    HANDLE m_hFile    = INVALID_HANDLE_VALUE;
+    HANDLE m_hMapping = NULL;
+#elif !SHADER_CACHE_USE_MMAP
+    std::vector<Uint8> m_Data;
+#endif
+    const Uint8* m_pData = nullptr;
+    size_t       m_Size  = 0;
+};
+
+
+// MurmurHash3 was written by Austin Appleby, and is placed in the public domain.
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+static inline Uint64 RotL64(Uint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline Uint64 FMix64(Uint64 k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+static void MurmurHash3_x64_128(const void* pKey, size_t Len, Uint64 Seed, Uint64 Out[2])
+{
+    const auto* pData = reinterpret_cast<const Uint8*>(pKey);
+    const size_t NumBlocks = Len / 16;
+
+    auto h1 = Seed;
+    auto h2 = Seed;
+
+    const Uint64 c1 = 0x87c37b91114253d5ull;
+    const Uint64 c2 = 0x4cf5ad432745937full;
+
+    for (size_t i = 0; i < NumBlocks; ++i)
+    {
+        Uint64 k1, k2;
+        memcpy(&k1, pData + i * 16,     sizeof(k1));
+        memcpy(&k2, pData + i * 16 + 8, sizeof(k2));
+
+        k1 *= c1; k1 = RotL64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = RotL64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = RotL64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = RotL64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const auto* pTail = pData + NumBlocks * 16;
+    Uint64 k1 = 0;
+    Uint64 k2 = 0;
+    switch (Len & 15)
+    {
+        case 15: k2 ^= Uint64{pTail[14]} << 48;
+        case 14: k2 ^= Uint64{pTail[13]} << 40;
+        case 13: k2 ^= Uint64{pTail[12]} << 32;
+        case 12: k2 ^= Uint64{pTail[11]} << 24;
+        case 11: k2 ^= Uint64{pTail[10]} << 16;
+        case 10: k2 ^= Uint64{pTail[ 9]} << 8;
+        case  9: k2 ^= Uint64{pTail[ 8]} << 0;
+                 k2 *= c2; k2 = RotL64(k2, 33); k2 *= c1; h2 ^= k2;
+
+        case  8: k1 ^= Uint64{pTail[ 7]} << 56;
+        case  7: k1 ^= Uint64{pTail[ 6]} << 48;
+        case  6: k1 ^= Uint64{pTail[ 5]} << 40;
+        case  5: k1 ^= Uint64{pTail[ 4]} << 32;
+        case  4: k1 ^= Uint64{pTail[ 3]} << 24;
+        case  3: k1 ^= Uint64{pTail[ 2]} << 16;
+        case  2: k1 ^= Uint64{pTail[ 1]} << 8;
+        case  1: k1 ^= Uint64{pTail[ 0]} << 0;
+                 k1 *= c1; k1 = RotL64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= static_cast<Uint64>(Len);
+    h2 ^= static_cast<Uint64>(Len);
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = FMix64(h1);
+    h2 = FMix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    Out[0] = h1;
+    Out[1] = h2;
+}
+
+
+ShaderCache::KeyBuilder& ShaderCache::KeyBuilder::Add(const void* pData, size_t Size)
+{
+    auto Size64 = static_cast<Uint64>(Size);
+    const auto* pSize = reinterpret_cast<const Uint8*>(&Size64);
+    m_Data.insert(m_Data.end(), pSize, pSize + sizeof(Size64));
+    if (Size > 0)
+    {
+        const auto* pBytes = reinterpret_cast<const Uint8*>(pData);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+    }
+    return *this;
+}
+
+ShaderCache::KeyBuilder& ShaderCache::KeyBuilder::Add(const Char* Str)
+{
+    // Null and empty strings are distinguished
+    if (Str == nullptr)
+        return Add(Uint32{0xFFFFFFFF});
+    else
+        return Add(Str, strlen(Str));
+}
+
+ShaderCache::Key ShaderCache::KeyBuilder::Finish()const
+{
+    Key K;
+    MurmurHash3_x64_128(m_Data.data(), m_Data.size(), 0, K.Hash);
+    return K;
+}
+
+
+ShaderCache::ShaderCache(const Char* FilePath) : 
+    m_FilePath(FilePath != nullptr ? FilePath : "")
+{
+    VERIFY(!m_FilePath.empty(), "Shader cache file path must not be empty");
+    OpenFile();
+}
+
+ShaderCache::~ShaderCache()
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    FlushInternal();
+}
+
+void ShaderCache::OpenFile()
+{
+    m_pIndex = nullptr;
+    m_NumIndexEntries = 0;
+    m_pFile.reset(new MappedFile(m_FilePath.c_str()));
+
+    const auto* pData = m_pFile->GetData();
+    const auto  Size  = m_pFile->GetSize();
+    if (pData == nullptr)
+        return;
+
+    FileHeader Header;
+    if (Size < sizeof(Header))
+    {
+        LOG_WARNING_MESSAGE("Shader cache file '", m_FilePath, "' is corrupted and will be overwritten");
+        return;
+    }
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != FileHeader::ExpectedMagic || Header.Version != FileHeader::CurrentVersion)
+    {
+        LOG_WARNING_MESSAGE("Shader cache file '", m_FilePath, "' has incompatible format and will be overwritten");
+        return;
+    }
+
+    const auto* pIndex = reinterpret_cast<const IndexEntry*>(pData + sizeof(Header));
+    bool IsValid = sizeof(Header) + Uint64{Header.NumEntries} * sizeof(IndexEntry) <= Size;
+    for (Uint32 i = 0; IsValid && i < Header.NumEntries; ++i)
+    {
+        const auto& Entry = pIndex[i];
+        IsValid = Entry.Offset <= Size && Entry.Size <= Size - Entry.Offset && 
+                  (i == 0 || pIndex[i-1].EntryKey < Entry.EntryKey);
+    }
+    if (!IsValid)
+    {
+        LOG_WARNING_MESSAGE("Shader cache file '", m_FilePath, "' is corrupted and will be overwritten");
+        return;
+    }
+
+    m_pIndex = pIndex;
+    m_NumIndexEntries = Header.NumEntries;
+}
+
+const ShaderCache::IndexEntry* ShaderCache::FindInFile(const Key& K)const
+{
+    auto* pIndexEnd = m_pIndex + m_NumIndexEntries;
+    auto* pEntry = std::lower_bound(m_pIndex, pIndexEnd, K, 
+        [](const IndexEntry& Entry, const Key& K)
+        {
+            return Entry.EntryKey < K;
+        });
+    return (pEntry != pIndexEnd && pEntry->EntryKey == K) ? pEntry : nullptr;
+}
+
+bool ShaderCache::Find(const Key& K, std::vector<Uint8>& Data)
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    auto NewEntryIt = m_NewEntries.find(K);
+    if (NewEntryIt != m_NewEntries.end())
+    {
+        Data = NewEntryIt->second;
+        ++m_Stats.NumHits;
+        return true;
+    }
+
+    if (const auto* pEntry = FindInFile(K))
+    {
+        const auto* pEntryData = m_pFile->GetData() + pEntry->Offset;
+        Data.assign(pEntryData, pEntryData + pEntry->Size);
+        ++m_Stats.NumHits;
+        return true;
+    }
+
+    ++m_Stats.NumMisses;
+    return false;
+}
+
+void ShaderCache::Store(const Key& K, const void* pData, size_t Size)
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    if (FindInFile(K) != nullptr)
+        return;
+
+    const auto* pBytes = reinterpret_cast<const Uint8*>(pData);
+    auto Inserted = m_NewEntries.emplace(K, std::vector<Uint8>(pBytes, pBytes + Size));
+    if (Inserted.second)
+        ++m_Stats.NumStores;
+}
+
+bool ShaderCache::Flush()
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    return FlushInternal();
+}
+
+bool ShaderCache::FlushInternal()
+{
+    if (m_NewEntries.empty())
+        return true;
+
+    struct EntryData
+    {
+        const Key*   pKey;
+        const Uint8* pData;
+        size_t       Size;
+        bool operator < (const EntryData& Entry)const { return *pKey < *Entry.pKey; }
+    };
+    std::vector<EntryData> Entries;
+    Entries.reserve(m_NumIndexEntries + m_NewEntries.size());
+    for (Uint32 i = 0; i < m_NumIndexEntries; ++i)
+    {
+        const auto& Entry = m_pIndex[i];
+        Entries.emplace_back(EntryData{&Entry.EntryKey, m_pFile->GetData() + Entry.Offset, static_cast<size_t>(Entry.Size)});
+    }
+    for (const auto& NewEntry : m_NewEntries)
+        Entries.emplace_back(EntryData{&NewEntry.first, NewEntry.second.data(), NewEntry.second.size()});
+    std::sort(Entries.begin(), Entries.end());
+
+    // Write the new file next to the existing one, and replace the existing file 
+    // only when all data has been successfully written
+    auto TmpFilePath = GetTempFilePath(m_FilePath);
+    auto* pFile = fopen(TmpFilePath.c_str(), "wb");
+    if (pFile == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader cache file '", TmpFilePath, "'");
+        return false;
+    }
+
+    FileHeader Header;
+    Header.NumEntries = static_cast<Uint32>(Entries.size());
+    bool Success = fwrite(&Header, sizeof(Header), 1, pFile) == 1;
+
+    auto Offset = Uint64{sizeof(Header)} + Entries.size() * sizeof(IndexEntry);
+    for (const auto& Entry : Entries)
+    {
+        IndexEntry IdxEntry;
+        IdxEntry.EntryKey = *Entry.pKey;
+        IdxEntry.Offset   = Offset;
+        IdxEntry.Size     = Entry.Size;
+        Success = Success && fwrite(&IdxEntry, sizeof(IdxEntry), 1, pFile) == 1;
+        Offset += Entry.Size;
+    }
+
+    for (const auto& Entry : Entries)
+    {
+        if (Entry.Size > 0)
+            Success = Success && fwrite(Entry.pData, Entry.Size, 1, pFile) == 1;
+    }
+    Success = (fclose(pFile) == 0) && Success;
+
+    if (!Success)
+    {
+        LOG_ERROR_MESSAGE("Failed to write shader cache file '", TmpFilePath, "'");
+        remove(TmpFilePath.c_str());
+        return false;
+    }
+
+    // The existing file must be unmapped before it can be replaced
+    m_pIndex = nullptr;
+    m_NumIndexEntries = 0;
+    m_pFile.reset();
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    // rename() does not replace existing files on Windows
+    remove(m_FilePath.c_str());
+#endif
+    if (rename(TmpFilePath.c_str(), m_FilePath.c_str()) != 0)
+    {
+        LOG_ERROR_MESSAGE("Failed to replace shader cache file '", m_FilePath, "'");
+        remove(TmpFilePath.c_str());
+        OpenFile();
+        return false;
+    }
+
+    OpenFile();
+    VERIFY(m_NumIndexEntries == Entries.size(), "Unexpected number of entries in the shader cache file");
+    m_NewEntries.clear();
+    return true;
+}
+
+ShaderCache::Statistics ShaderCache::GetStatistics()
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    auto Stats = m_Stats;
+    Stats.NumEntries = m_NumIndexEntries + static_cast<Uint32>(m_NewEntries.size());
+    Stats.DataSize = 0;
+    for (Uint32 i = 0; i < m_NumIndexEntries; ++i)
+        Stats.DataSize += m_pIndex[i].Size;
+    for (const auto& NewEntry : m_NewEntries)
+        Stats.DataSize += NewEntry.second.size();
+    return Stats;
+}
+
+}
@@ -0,0 +1,191 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <vector>
+#include "MemoryAllocator.h"
+#include "STDAllocator.h"
+#include "DebugUtilities.h"
+#include "Align.h"
+
+namespace Diligent
+{
+    /// Implementation of a ring buffer that allows allocations from multiple threads.
+
+    /// Head and tail are tracked as monotonically increasing 64-bit positions, so that the used
+    /// size is always Head - Tail and full and empty states never need to be distinguished.
+    /// The offset in the buffer is the position modulo the buffer size. Allocate() advances
+    /// the head with compare-and-swap and is lock-free.
+    ///
+    /// Frame heads are kept in a fixed-size circular array. FinishCurrentFrame() and
+    /// ReleaseCompletedFrames() may be called concurrently with Allocate(), but must not be
+    /// called concurrently with each other.
+    class ConcurrentRingBuffer
+    {
+    public:
+        using OffsetType = size_t;
+        static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+        ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator &Allocator, Uint32 MaxFramesInFlight = 64) :
+            m_FrameHeads(MaxFramesInFlight, FrameHeadAttribs{}, STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for vector<FrameHeadAttribs>")),
+            m_MaxSize(MaxSize)
+        {
+            VERIFY_EXPR(MaxFramesInFlight > 0);
+        }
+
+        ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+        ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+        ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+        ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+
+        ~ConcurrentRingBuffer()
+        {
+            VERIFY(GetUsedSize()==0, "All space in the ring buffer must be released");
+        }
+
+        OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+        {
+            VERIFY_EXPR(Size > 0);
+            VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+            Size = Align(Size, Alignment);
+            if (Size > m_MaxSize)
+                return InvalidOffset;
+
+            auto Head = m_Head.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                auto Tail = m_Tail.load(std::memory_order_acquire);
+                auto HeadOffset = static_cast<OffsetType>(Head % m_MaxSize);
+                auto Offset = Align(HeadOffset, Alignment);
+                Uint64 NewHead = 0;
+                if (Offset + Size <= m_MaxSize)
+                {
+                    //                    HeadOffset
+                    //         Tail       |  Offset         MaxSize
+                    //          |         |  |               |
+                    //  [       xxxxxxxxxx...+++++++         ]
+                    //
+                    NewHead = Head + (Offset - HeadOffset) + Size;
+                }
+                else
+                {
+                    // Allocate from the beginning of the buffer. The space up to the end
+                    // of the buffer is wasted and is released with the current frame
+                    //
+                    // Offset         Tail          HeadOffset        MaxSize
+                    //  |              |                |               |
+                    //  [+++++++       xxxxxxxxxxxxxxxxx~~~~~~~~~~~~~~~~]
+                    //
+                    Offset  = 0;
+                    NewHead = Head + (m_MaxSize - HeadOffset) + Size;
+                }
+
+                if (NewHead - Tail > m_MaxSize)
+                    return InvalidOffset;
+
+                if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_relaxed))
+                    return Offset;
+            }
+        }
+
+        // FenceValue is the fence value associated with the command list in which the head
+        // could have been referenced last time
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        void FinishCurrentFrame(Uint64 FenceValue)
+        {
+            auto Head = m_Head.load(std::memory_order_relaxed);
+            // Ignore zero-size frames
+            if (Head == m_LastFrameHead)
+                return;
+            m_LastFrameHead = Head;
+
+            const auto NumFrames = m_NumFrames;
+            const auto MaxFrames = static_cast<Uint32>(m_FrameHeads.size());
+            if (NumFrames > 0)
+            {
+                const auto &LastFrame = m_FrameHeads[(m_FirstFrame + NumFrames - 1) % MaxFrames];
+                VERIFY(FenceValue >= LastFrame.FenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", LastFrame.FenceValue, ")");
+                if (NumFrames == MaxFrames)
+                {
+                    // The array is full: merge the frame with the last one. This only postpones
+                    // the release of the last frame until the current one is completed
+                    auto &Frame = m_FrameHeads[(m_FirstFrame + NumFrames - 1) % MaxFrames];
+                    Frame.FenceValue = FenceValue;
+                    Frame.Head       = Head;
+                    return;
+                }
+            }
+
+            auto &Frame = m_FrameHeads[(m_FirstFrame + NumFrames) % MaxFrames];
+            Frame.FenceValue = FenceValue;
+            Frame.Head       = Head;
+            ++m_NumFrames;
+        }
+
+        // CompletedFenceValue indicates GPU progress
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+        {
+            // We can release all heads whose associated fence value is less than or equal to CompletedFenceValue
+            const auto MaxFrames = static_cast<Uint32>(m_FrameHeads.size());
+            while (m_NumFrames > 0 && m_FrameHeads[m_FirstFrame].FenceValue <= CompletedFenceValue)
+            {
+                VERIFY_EXPR(m_FrameHeads[m_FirstFrame].Head >= m_Tail.load(std::memory_order_relaxed));
+                // Release semantics guarantees that the memory is not handed out to
+                // other threads before all operations preceding the release are complete
+                m_Tail.store(m_FrameHeads[m_FirstFrame].Head, std::memory_order_release);
+                m_FirstFrame = (m_FirstFrame + 1) % MaxFrames;
+                --m_NumFrames;
+            }
+        }
+
+        OffsetType GetMaxSize() const { return m_MaxSize; }
+        OffsetType GetUsedSize()const { return static_cast<OffsetType>(m_Head.load() - m_Tail.load()); }
+        bool       IsFull()     const { return GetUsedSize()==m_MaxSize; };
+        bool       IsEmpty()    const { return GetUsedSize()==0; };
+
+    private:
+        struct FrameHeadAttribs
+        {
+            // Fence value associated with the command list in which
+            // the allocation could have been referenced last time
+            Uint64 FenceValue = 0;
+            // Head position at the end of the frame
+            Uint64 Head       = 0;
+        };
+
+        std::vector<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs> > m_FrameHeads;
+        Uint32              m_FirstFrame    = 0;
+        Uint32              m_NumFrames     = 0;
+        Uint64              m_LastFrameHead = 0;
+
+        std::atomic<Uint64> m_Head{0};
+        std::atomic<Uint64> m_Tail{0};
+        const OffsetType    m_MaxSize;
+    };
+}
@@ -0,0 +1,161 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Index of memory pages ordered by the amount of free space that is used to select
+// the page for a new suballocation
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+    // The class keeps pointers to memory pages sorted by the amount of free space in ascending 
+    // order. A new allocation is placed in the page with the least free space that can accommodate 
+    // it (best fit), so that large free ranges in other pages are kept for large requests, and 
+    // mostly empty pages can become completely free and be released.
+    //
+    //   Free space:  | 1 MB  | 3 MB  | 3 MB  | 12 MB | 16 MB |
+    //                              ^
+    //                              |
+    //   Allocate(2 MB) ------------'  lower_bound, then try pages to the right until one succeeds
+    //
+    // Pages with more free space than the request may still fail to accommodate it if the space 
+    // is fragmented, in which case the next page is tried. 
+    //
+    // The index does not own the pages and is not thread-safe. Free space of a page only decreases 
+    // when an allocation is made through Allocate(), which updates the index. When memory is released
+    // without going through the index, the owner must call Update() or Refresh(). A stale index
+    // only underestimates free space: it may skip a page that could accommodate the request,
+    // which results in a new page being created, but never affects correctness.
+    template<typename PageType, typename SizeType = size_t>
+    class PageFreeSpaceIndex
+    {
+    public:
+        void AddPage(PageType* pPage, SizeType FreeSpace)
+        {
+            VERIFY_EXPR(pPage != nullptr && FindPage(pPage) == m_Pages.end());
+            auto InsertPos = std::upper_bound(m_Pages.begin(), m_Pages.end(), FreeSpace, 
+                [](SizeType Space, const PageInfo& Page){ return Space < Page.FreeSpace; });
+            m_Pages.emplace(InsertPos, PageInfo{FreeSpace, pPage});
+        }
+
+        void RemovePage(PageType* pPage)
+        {
+            auto it = FindPage(pPage);
+            VERIFY(it != m_Pages.end(), "The page is not in the index");
+            if (it != m_Pages.end())
+                m_Pages.erase(it);
+        }
+
+        // Updates free space of a single page
+        void Update(PageType* pPage, SizeType FreeSpace)
+        {
+            RemovePage(pPage);
+            AddPage(pPage, FreeSpace);
+        }
+
+        // Re-reads free space of all pages. GetFreeSpace is called as GetFreeSpace(PageType&)
+        template<typename GetFreeSpaceType>
+        void Refresh(GetFreeSpaceType GetFreeSpace)
+        {
+            for (auto& Page : m_Pages)
+                Page.FreeSpace = GetFreeSpace(*Page.pPage);
+            // Only few pages typically change between refreshes, so the array is almost sorted
+            // and insertion sort is much faster than a general sort
+            for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
+            {
+                if (it == m_Pages.begin() || (it-1)->FreeSpace <= it->FreeSpace)
+                    continue;
+                auto InsertPos = std::upper_bound(m_Pages.begin(), it, it->FreeSpace,
+                    [](SizeType Space, const PageInfo& Page){ return Space < Page.FreeSpace; });
+                std::rotate(InsertPos, it, it + 1);
+            }
+        }
+
+        // Tries pages that have at least Size bytes of free space starting from the page with the 
+        // least free space. TryAllocate is called as TryAllocate(PageType&) and must return the size 
+        // reserved in the page or zero if the allocation failed. Returns the page that accommodated 
+        // the allocation, or null if no page could.
+        template<typename TryAllocateType>
+        PageType* Allocate(SizeType Size, TryAllocateType TryAllocate)
+        {
+            // Fast path: no page has enough free space
+            if (m_Pages.empty() || m_Pages.back().FreeSpace < Size)
+                return nullptr;
+
+            auto it = std::lower_bound(m_Pages.begin(), m_Pages.end(), Size,
+                [](const PageInfo& Page, SizeType Space){ return Page.FreeSpace < Space; });
+            for (; it != m_Pages.end(); ++it)
+            {
+                auto ReservedSize = TryAllocate(*it->pPage);
+                if (ReservedSize != 0)
+                {
+                    auto* pPage = it->pPage;
+                    // Reserved size may include alignment padding and exceed the recorded free space
+                    // if the index underestimates it
+                    auto FreeSpace = it->FreeSpace - std::min(ReservedSize, it->FreeSpace);
+                    // Free space only decreased, so the page only needs to move towards the front
+                    auto NewPos = std::upper_bound(m_Pages.begin(), it, FreeSpace, 
+                        [](SizeType Space, const PageInfo& Page){ return Space < Page.FreeSpace; });
+                    std::move_backward(NewPos, it, it + 1);
+                    *NewPos = PageInfo{FreeSpace, pPage};
+                    return pPage;
+                }
+            }
+
+            return nullptr;
+        }
+
+        size_t GetNumPages()const { return m_Pages.size(); }
+
+        SizeType GetMaxFreeSpace()const { return m_Pages.empty() ? 0 : m_Pages.back().FreeSpace; }
+
+        // Calls Handler(PageType&) for every page in ascending order of free space
+        template<typename HandlerType>
+        void ProcessPages(HandlerType Handler)const
+        {
+            for (const auto& Page : m_Pages)
+                Handler(*Page.pPage);
+        }
+
+    private:
+        struct PageInfo
+        {
+            SizeType  FreeSpace;
+            PageType* pPage;
+        };
+
+        typename std::vector<PageInfo>::iterator FindPage(PageType* pPage)
+        {
+            return std::find_if(m_Pages.begin(), m_Pages.end(), [pPage](const PageInfo& Page){ return Page.pPage == pPage; });
+        }
+
+        std::vector<PageInfo> m_Pages;
+    };
+}
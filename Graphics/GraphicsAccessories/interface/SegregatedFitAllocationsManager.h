@@ -0,0 +1,671 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Segregated-fit (TLSF-style) engine that handles free memory block management
+// to accommodate variable-size allocation requests
+
+#pragma once
+
+#include <vector>
+
+#include "VariableSizeAllocationsManager.h"
+#include "PlatformMisc.h"
+
+namespace Diligent
+{
+    // The class implements the same contract as VariableSizeAllocationsManager, but uses
+    // two-level segregated free lists instead of ordered maps, so that both Allocate() and
+    // Free() run in constant time.
+    //
+    // Free blocks are distributed between size classes. The first level splits the size range
+    // into powers of two, the second level linearly subdivides every power-of-two range into
+    // SLIndexCount classes. Two bitmaps track non-empty classes, so that the smallest suitable
+    // class is found with two bit scans:
+    //
+    //   FL Bitmap    0 0 1 0 1 ...
+    //                    |   |
+    //   SL Bitmaps       |   '--> 0 1 0 0 ... 0 0      m_FreeLists[fl][sl] -> Block -> Block -> ...
+    //                    '------> 1 0 0 1 ... 0 0
+    //
+    // Like VariableSizeAllocationsManager, the class keeps track of free blocks only and does not
+    // record allocation sizes. Instead of storing boundary tags in the managed memory (which may
+    // not be CPU-accessible), start and end offsets of every free block are kept in two flat
+    // open-addressing tables. When a block is released, its left and right free neighbors are
+    // found by looking up the block's start offset in the end-tag table and its end offset in the
+    // start-tag table.
+    //
+    // Free block descriptors are stored in a contiguous array and are referenced by indices,
+    // so that no memory is allocated or released when blocks are split or merged.
+    class SegregatedFitAllocationsManager
+    {
+    public:
+        using OffsetType = VariableSizeAllocationsManager::OffsetType;
+        using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    private:
+        static constexpr Uint32     InvalidIndex     = static_cast<Uint32>(-1);
+        // Number of second-level classes in every power-of-two range is 2^SLIndexCountLog2
+        static constexpr Uint32     SLIndexCountLog2 = 4;
+        static constexpr Uint32     SLIndexCount     = 1 << SLIndexCountLog2;
+        // Blocks smaller than this size are linearly mapped to the classes of the first list
+        static constexpr OffsetType SmallBlockSize   = OffsetType{1} << SLIndexCountLog2;
+        static constexpr Uint32     FLIndexCount     = sizeof(OffsetType)*8 - SLIndexCountLog2 + 1;
+        static_assert(FLIndexCount <= 64, "First-level bitmap must fit into 64 bits");
+
+        struct FreeBlockInfo
+        {
+            OffsetType Offset   = 0;
+            OffsetType Size     = 0;
+            // Links in the free list of the block's size class. For unused
+            // descriptors, NextFree references the next unused descriptor
+            Uint32     PrevFree = InvalidIndex;
+            Uint32     NextFree = InvalidIndex;
+        };
+
+        // Flat open-addressing (linear probing) table that maps block boundary offset to the
+        // index of the block descriptor
+        class BoundaryTagTable
+        {
+        public:
+            BoundaryTagTable(IMemoryAllocator &Allocator) :
+                m_Entries(InitialCapacity, TagEntry{}, STD_ALLOCATOR_RAW_MEM(TagEntry, Allocator, "Allocator for vector<TagEntry>"))
+            {}
+
+            BoundaryTagTable(BoundaryTagTable&& rhs)noexcept :
+                m_Entries(std::move(rhs.m_Entries)),
+                m_Count  (rhs.m_Count)
+            {
+                rhs.m_Count = 0;
+            }
+
+            BoundaryTagTable& operator = (BoundaryTagTable&& rhs)noexcept
+            {
+                m_Entries   = std::move(rhs.m_Entries);
+                m_Count     = rhs.m_Count;
+                rhs.m_Count = 0;
+                return *this;
+            }
+
+            BoundaryTagTable             (const BoundaryTagTable&) = delete;
+            BoundaryTagTable& operator = (const BoundaryTagTable&) = delete;
+
+            Uint32 Find(OffsetType Key)const
+            {
+                const auto Mask = m_Entries.size()-1;
+                for(auto i = Hash(Key) & Mask; m_Entries[i].BlockIdx != InvalidIndex; i = (i+1) & Mask)
+                {
+                    if(m_Entries[i].Key == Key)
+                        return m_Entries[i].BlockIdx;
+                }
+                return InvalidIndex;
+            }
+
+            void Insert(OffsetType Key, Uint32 BlockIdx)
+            {
+                VERIFY_EXPR(BlockIdx != InvalidIndex);
+                if( (m_Count+1)*2 > m_Entries.size() )
+                    Rehash(m_Entries.size()*2);
+
+                const auto Mask = m_Entries.size()-1;
+                auto i = Hash(Key) & Mask;
+                while(m_Entries[i].BlockIdx != InvalidIndex)
+                {
+                    VERIFY(m_Entries[i].Key != Key, "Boundary tag ", Key, " is already in the table");
+                    i = (i+1) & Mask;
+                }
+                m_Entries[i].Key      = Key;
+                m_Entries[i].BlockIdx = BlockIdx;
+                ++m_Count;
+            }
+
+            void Erase(OffsetType Key)
+            {
+                const auto Mask = m_Entries.size()-1;
+                auto i = Hash(Key) & Mask;
+                while(m_Entries[i].BlockIdx == InvalidIndex || m_Entries[i].Key != Key)
+                {
+                    if(m_Entries[i].BlockIdx == InvalidIndex)
+                    {
+                        UNEXPECTED("Boundary tag ", Key, " is not found in the table");
+                        return;
+                    }
+                    i = (i+1) & Mask;
+                }
+
+                // Backward-shift deletion keeps probe sequences intact without tombstones
+                for(auto j = (i+1) & Mask; m_Entries[j].BlockIdx != InvalidIndex; j = (j+1) & Mask)
+                {
+                    // Home slot of the entry in slot j
+                    auto k = Hash(m_Entries[j].Key) & Mask;
+                    // The entry can be moved to the hole at i only if its home slot
+                    // does not lie cyclically within (i, j]
+                    bool CanMove = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+                    if (CanMove)
+                    {
+                        m_Entries[i] = m_Entries[j];
+                        i = j;
+                    }
+                }
+                m_Entries[i] = TagEntry{};
+                --m_Count;
+            }
+
+            size_t GetCount()const{return m_Count;}
+
+        private:
+            struct TagEntry
+            {
+                OffsetType Key      = 0;
+                Uint32     BlockIdx = InvalidIndex;
+            };
+            using TEntriesVector = std::vector<TagEntry, STDAllocatorRawMem<TagEntry>>;
+
+            static size_t Hash(OffsetType Key)
+            {
+                // Fibonacci hashing spreads aligned offsets across the table
+                return static_cast<size_t>( (static_cast<Uint64>(Key) * 0x9E3779B97F4A7C15ull) >> 32 );
+            }
+
+            void Rehash(size_t NewCapacity)
+            {
+                VERIFY_EXPR(IsPowerOfTwo(NewCapacity));
+                TEntriesVector NewEntries(NewCapacity, TagEntry{}, m_Entries.get_allocator());
+                const auto Mask = NewCapacity-1;
+                for(const auto &Entry : m_Entries)
+                {
+                    if (Entry.BlockIdx == InvalidIndex)
+                        continue;
+                    auto i = Hash(Entry.Key) & Mask;
+                    while(NewEntries[i].BlockIdx != InvalidIndex)
+                        i = (i+1) & Mask;
+                    NewEntries[i] = Entry;
+                }
+                m_Entries.swap(NewEntries);
+            }
+
+            static constexpr size_t InitialCapacity = 64;
+            TEntriesVector m_Entries;
+            size_t         m_Count = 0;
+        };
+
+    public:
+        SegregatedFitAllocationsManager(OffsetType MaxSize, IMemoryAllocator &Allocator) :
+            m_Blocks(STD_ALLOCATOR_RAW_MEM(FreeBlockInfo, Allocator, "Allocator for vector<FreeBlockInfo>")),
+            m_BlocksByStart(Allocator),
+            m_BlocksByEnd  (Allocator),
+            m_MaxSize (MaxSize),
+            m_FreeSize(MaxSize)
+        {
+            for(Uint32 fl=0; fl < FLIndexCount; ++fl)
+            {
+                m_SLBitmaps[fl] = 0;
+                for(Uint32 sl=0; sl < SLIndexCount; ++sl)
+                    m_FreeLists[fl][sl] = InvalidIndex;
+            }
+
+            // Insert single maximum-size block
+            AddNewBlock(0, m_MaxSize);
+            ResetCurrAlignment();
+
+#ifdef _DEBUG
+            DbgVerifyList();
+#endif
+        }
+
+        ~SegregatedFitAllocationsManager()
+        {
+#ifdef _DEBUG
+            if( m_NumFreeBlocks != 0 )
+            {
+                VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+                auto BlockIdx = m_BlocksByStart.Find(0);
+                VERIFY(BlockIdx != InvalidIndex, "Head chunk offset is expected to be 0");
+                VERIFY(m_Blocks[BlockIdx].Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+                VERIFY_EXPR(m_BlocksByEnd.Find(m_MaxSize) == BlockIdx);
+            }
+#endif
+        }
+
+        SegregatedFitAllocationsManager(SegregatedFitAllocationsManager&& rhs)noexcept :
+            m_Blocks          (std::move(rhs.m_Blocks)),
+            m_BlocksByStart   (std::move(rhs.m_BlocksByStart)),
+            m_BlocksByEnd     (std::move(rhs.m_BlocksByEnd)),
+            m_FirstUnusedBlock(rhs.m_FirstUnusedBlock),
+            m_NumFreeBlocks   (rhs.m_NumFreeBlocks),
+            m_FLBitmap        (rhs.m_FLBitmap),
+            m_MaxSize         (rhs.m_MaxSize),
+            m_FreeSize        (rhs.m_FreeSize),
+            m_CurrAlignment   (rhs.m_CurrAlignment)
+        {
+            for(Uint32 fl=0; fl < FLIndexCount; ++fl)
+            {
+                m_SLBitmaps[fl] = rhs.m_SLBitmaps[fl];
+                for(Uint32 sl=0; sl < SLIndexCount; ++sl)
+                    m_FreeLists[fl][sl] = rhs.m_FreeLists[fl][sl];
+            }
+
+            rhs.m_FirstUnusedBlock = InvalidIndex;
+            rhs.m_NumFreeBlocks    = 0;
+            rhs.m_FLBitmap         = 0;
+            rhs.m_MaxSize          = 0;
+            rhs.m_FreeSize         = 0;
+            rhs.m_CurrAlignment    = 0;
+        }
+
+        SegregatedFitAllocationsManager& operator = (SegregatedFitAllocationsManager&& rhs)noexcept
+        {
+            m_Blocks           = std::move(rhs.m_Blocks);
+            m_BlocksByStart    = std::move(rhs.m_BlocksByStart);
+            m_BlocksByEnd      = std::move(rhs.m_BlocksByEnd);
+            m_FirstUnusedBlock = rhs.m_FirstUnusedBlock;
+            m_NumFreeBlocks    = rhs.m_NumFreeBlocks;
+            m_FLBitmap         = rhs.m_FLBitmap;
+            m_MaxSize          = rhs.m_MaxSize;
+            m_FreeSize         = rhs.m_FreeSize;
+            m_CurrAlignment    = rhs.m_CurrAlignment;
+            for(Uint32 fl=0; fl < FLIndexCount; ++fl)
+            {
+                m_SLBitmaps[fl] = rhs.m_SLBitmaps[fl];
+                for(Uint32 sl=0; sl < SLIndexCount; ++sl)
+                    m_FreeLists[fl][sl] = rhs.m_FreeLists[fl][sl];
+            }
+
+            rhs.m_FirstUnusedBlock = InvalidIndex;
+            rhs.m_NumFreeBlocks    = 0;
+            rhs.m_FLBitmap         = 0;
+            rhs.m_MaxSize          = 0;
+            rhs.m_FreeSize         = 0;
+            rhs.m_CurrAlignment    = 0;
+
+            return *this;
+        }
+        SegregatedFitAllocationsManager             (const SegregatedFitAllocationsManager&) = delete;
+        SegregatedFitAllocationsManager& operator = (const SegregatedFitAllocationsManager&) = delete;
+
+        // Offset returned by Allocate() may not be aligned, but the size of the allocation
+        // is sufficient to properly align it
+        Allocation Allocate(OffsetType Size, OffsetType Alignment)
+        {
+            VERIFY_EXPR(Size > 0);
+            VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+            Size = Align(Size, Alignment);
+            if(m_FreeSize < Size)
+                return Allocation::InvalidAllocation();
+
+            auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+            // Get a block that is large enough to encompass Size + AlignmentReserve bytes
+            auto BlockIdx = FindSuitableBlock(Size + AlignmentReserve);
+            if(BlockIdx == InvalidIndex)
+                return Allocation::InvalidAllocation();
+
+            const auto &Block = m_Blocks[BlockIdx];
+            VERIFY_EXPR(Size + AlignmentReserve <= Block.Size);
+
+            //         Block.Offset
+            //        |                                  |
+            //        |<-----------Block.Size----------->|
+            //        |<------Size------>|<---NewSize--->|
+            //        |                  |
+            //      Offset              NewOffset
+            //
+            auto Offset = Block.Offset;
+            VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+            auto AlignedOffset = Align(Offset, Alignment);
+            auto AdjustedSize = Size + (AlignedOffset - Offset);
+            VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
+            auto NewOffset = Offset + AdjustedSize;
+            auto NewSize = Block.Size - AdjustedSize;
+            if (NewSize > 0)
+            {
+                // End tag of the block remains the same
+                ResizeBlock(BlockIdx, NewOffset, NewSize);
+            }
+            else
+            {
+                RemoveBlock(BlockIdx);
+            }
+
+            m_FreeSize -= AdjustedSize;
+
+            if ((Size & (m_CurrAlignment-1)) != 0)
+            {
+                if (IsPowerOfTwo(Size))
+                {
+                    VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                    m_CurrAlignment = Size;
+                }
+                else
+                {
+                    m_CurrAlignment = std::min(m_CurrAlignment, Alignment);
+                }
+            }
+
+#ifdef _DEBUG
+            DbgVerifyList();
+#endif
+            return Allocation{Offset, AdjustedSize};
+        }
+
+        void Free(Allocation&& allocation)
+        {
+            Free(allocation.UnalignedOffset, allocation.Size);
+            allocation = Allocation{};
+        }
+
+        void Free(OffsetType Offset, OffsetType Size)
+        {
+            VERIFY_EXPR(Size > 0 && Offset+Size <= m_MaxSize);
+            VERIFY(m_BlocksByStart.Find(Offset) == InvalidIndex, "Block at offset ", Offset, " is already free");
+
+            // Free block that ends where the released block starts
+            auto PrevBlockIdx = m_BlocksByEnd.Find(Offset);
+            // Free block that starts where the released block ends
+            auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+
+            if(PrevBlockIdx != InvalidIndex)
+            {
+                //  PrevBlock.Offset             Offset
+                //       |                          |
+                //       |<-----PrevBlock.Size----->|<------Size-------->|
+                //
+                auto NewSize = m_Blocks[PrevBlockIdx].Size + Size;
+                if(NextBlockIdx != InvalidIndex)
+                {
+                    //   PrevBlock.Offset           Offset            NextBlock.Offset
+                    //     |                          |                    |
+                    //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+                    //
+                    NewSize += m_Blocks[NextBlockIdx].Size;
+                    RemoveBlock(NextBlockIdx);
+                }
+                ResizeBlock(PrevBlockIdx, m_Blocks[PrevBlockIdx].Offset, NewSize);
+            }
+            else if(NextBlockIdx != InvalidIndex)
+            {
+                //   PrevBlock.Offset                   Offset            NextBlock.Offset
+                //     |                                  |                    |
+                //     |<-----PrevBlock.Size----->| ~ ~ ~ |<------Size-------->|<-----NextBlock.Size----->|
+                //
+                ResizeBlock(NextBlockIdx, Offset, Size + m_Blocks[NextBlockIdx].Size);
+            }
+            else
+            {
+                //   PrevBlock.Offset                   Offset                     NextBlock.Offset
+                //     |                                  |                            |
+                //     |<-----PrevBlock.Size----->| ~ ~ ~ |<------Size-------->| ~ ~ ~ |<-----NextBlock.Size----->|
+                //
+                AddNewBlock(Offset, Size);
+            }
+
+            m_FreeSize += Size;
+            if(IsEmpty())
+            {
+                // Reset current alignment
+                VERIFY_EXPR(m_NumFreeBlocks == 1);
+                ResetCurrAlignment();
+            }
+
+#ifdef _DEBUG
+            DbgVerifyList();
+#endif
+        }
+
+        bool IsFull() const{ return m_FreeSize==0; };
+        bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+        OffsetType GetMaxSize() const{return m_MaxSize;}
+        OffsetType GetFreeSize()const{return m_FreeSize;}
+        OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+
+#ifdef _DEBUG
+        size_t DbgGetNumFreeBlocks()const{return m_NumFreeBlocks;}
+#endif
+
+    private:
+        // Computes size class that contains blocks of the given size
+        static void MapSizeToClass(OffsetType Size, Uint32 &fl, Uint32 &sl)
+        {
+            VERIFY_EXPR(Size > 0);
+            if(Size < SmallBlockSize)
+            {
+                fl = 0;
+                sl = static_cast<Uint32>(Size);
+            }
+            else
+            {
+                auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+                sl = static_cast<Uint32>(Size >> (MSB - SLIndexCountLog2)) ^ SLIndexCount;
+                fl = MSB - SLIndexCountLog2 + 1;
+            }
+        }
+
+        // Finds a free block that is at least Size bytes large
+        Uint32 FindSuitableBlock(OffsetType Size)const
+        {
+            // Round the size up to the next class boundary, so that every block
+            // in the found class is guaranteed to be large enough
+            auto RoundedSize = Size;
+            if(Size >= SmallBlockSize)
+            {
+                auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+                auto Round = (OffsetType{1} << (MSB - SLIndexCountLog2)) - 1;
+                RoundedSize = (Size <= ~OffsetType{0} - Round) ? Size + Round : 0;
+            }
+
+            if (RoundedSize != 0)
+            {
+                Uint32 fl = 0, sl = 0;
+                MapSizeToClass(RoundedSize, fl, sl);
+
+                auto SLMap = m_SLBitmaps[fl] & (~Uint32{0} << sl);
+                if (SLMap == 0)
+                {
+                    // No suitable blocks in this range - look at the next non-empty range
+                    auto FLMap = (fl+1 < FLIndexCount) ? m_FLBitmap & (~Uint64{0} << (fl+1)) : 0;
+                    if (FLMap != 0)
+                    {
+                        fl = PlatformMisc::GetLSB(FLMap);
+                        SLMap = m_SLBitmaps[fl];
+                        VERIFY(SLMap != 0, "Second-level bitmap of a non-empty range must not be zero");
+                    }
+                }
+
+                if (SLMap != 0)
+                {
+                    sl = PlatformMisc::GetLSB(SLMap);
+                    auto BlockIdx = m_FreeLists[fl][sl];
+                    VERIFY_EXPR(BlockIdx != InvalidIndex && m_Blocks[BlockIdx].Size >= Size);
+                    return BlockIdx;
+                }
+            }
+
+            // All classes above the requested one are empty. The block may still be found
+            // in the class that contains the requested size itself. This only happens when
+            // the heap is close to full, so linear search is acceptable.
+            Uint32 fl = 0, sl = 0;
+            MapSizeToClass(Size, fl, sl);
+            for(auto BlockIdx = m_FreeLists[fl][sl]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            {
+                if(m_Blocks[BlockIdx].Size >= Size)
+                    return BlockIdx;
+            }
+
+            return InvalidIndex;
+        }
+
+        void LinkBlock(Uint32 BlockIdx)
+        {
+            auto &Block = m_Blocks[BlockIdx];
+            Uint32 fl = 0, sl = 0;
+            MapSizeToClass(Block.Size, fl, sl);
+            auto &Head = m_FreeLists[fl][sl];
+            Block.PrevFree = InvalidIndex;
+            Block.NextFree = Head;
+            if(Head != InvalidIndex)
+                m_Blocks[Head].PrevFree = BlockIdx;
+            Head = BlockIdx;
+            m_SLBitmaps[fl] |= Uint32{1} << sl;
+            m_FLBitmap |= Uint64{1} << fl;
+        }
+
+        void UnlinkBlock(Uint32 BlockIdx)
+        {
+            auto &Block = m_Blocks[BlockIdx];
+            if(Block.NextFree != InvalidIndex)
+                m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+            if(Block.PrevFree != InvalidIndex)
+            {
+                m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+            }
+            else
+            {
+                Uint32 fl = 0, sl = 0;
+                MapSizeToClass(Block.Size, fl, sl);
+                VERIFY_EXPR(m_FreeLists[fl][sl] == BlockIdx);
+                m_FreeLists[fl][sl] = Block.NextFree;
+                if(Block.NextFree == InvalidIndex)
+                {
+                    m_SLBitmaps[fl] &= ~(Uint32{1} << sl);
+                    if(m_SLBitmaps[fl] == 0)
+                        m_FLBitmap &= ~(Uint64{1} << fl);
+                }
+            }
+            Block.PrevFree = InvalidIndex;
+            Block.NextFree = InvalidIndex;
+        }
+
+        void AddNewBlock(OffsetType Offset, OffsetType Size)
+        {
+            Uint32 BlockIdx = m_FirstUnusedBlock;
+            if(BlockIdx != InvalidIndex)
+            {
+                m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+            }
+            else
+            {
+                BlockIdx = static_cast<Uint32>(m_Blocks.size());
+                m_Blocks.emplace_back();
+            }
+
+            auto &Block = m_Blocks[BlockIdx];
+            Block.Offset = Offset;
+            Block.Size   = Size;
+            LinkBlock(BlockIdx);
+            m_BlocksByStart.Insert(Offset, BlockIdx);
+            m_BlocksByEnd.Insert(Offset + Size, BlockIdx);
+            ++m_NumFreeBlocks;
+        }
+
+        void RemoveBlock(Uint32 BlockIdx)
+        {
+            UnlinkBlock(BlockIdx);
+            auto &Block = m_Blocks[BlockIdx];
+            m_BlocksByStart.Erase(Block.Offset);
+            m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+            Block.NextFree = m_FirstUnusedBlock;
+            m_FirstUnusedBlock = BlockIdx;
+            --m_NumFreeBlocks;
+        }
+
+        // Moves the block to the new range and updates only the boundary tags that have changed
+        void ResizeBlock(Uint32 BlockIdx, OffsetType NewOffset, OffsetType NewSize)
+        {
+            UnlinkBlock(BlockIdx);
+            auto &Block = m_Blocks[BlockIdx];
+            if(Block.Offset != NewOffset)
+            {
+                m_BlocksByStart.Erase(Block.Offset);
+                m_BlocksByStart.Insert(NewOffset, BlockIdx);
+            }
+            if(Block.Offset + Block.Size != NewOffset + NewSize)
+            {
+                m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+                m_BlocksByEnd.Insert(NewOffset + NewSize, BlockIdx);
+            }
+            Block.Offset = NewOffset;
+            Block.Size   = NewSize;
+            LinkBlock(BlockIdx);
+        }
+
+        void ResetCurrAlignment()
+        {
+            for(m_CurrAlignment = 1; m_CurrAlignment*2 <= m_MaxSize; m_CurrAlignment *= 2);
+        }
+
+#ifdef _DEBUG
+        void DbgVerifyList()
+        {
+            OffsetType TotalFreeSize = 0;
+            size_t NumBlocks = 0;
+
+            VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+            for(Uint32 fl=0; fl < FLIndexCount; ++fl)
+            {
+                VERIFY_EXPR( ((m_FLBitmap & (Uint64{1} << fl)) != 0) == (m_SLBitmaps[fl] != 0) );
+                for(Uint32 sl=0; sl < SLIndexCount; ++sl)
+                {
+                    VERIFY_EXPR( ((m_SLBitmaps[fl] & (Uint32{1} << sl)) != 0) == (m_FreeLists[fl][sl] != InvalidIndex) );
+                    auto PrevBlockIdx = InvalidIndex;
+                    for(auto BlockIdx = m_FreeLists[fl][sl]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                    {
+                        const auto &Block = m_Blocks[BlockIdx];
+                        VERIFY_EXPR(Block.PrevFree == PrevBlockIdx);
+                        Uint32 BlockFL = 0, BlockSL = 0;
+                        MapSizeToClass(Block.Size, BlockFL, BlockSL);
+                        VERIFY(BlockFL == fl && BlockSL == sl, "Block is in the wrong size class");
+                        VERIFY_EXPR(Block.Offset + Block.Size <= m_MaxSize);
+                        VERIFY( (Block.Offset & (m_CurrAlignment-1)) == 0, "Block offset (", Block.Offset, ") is not ", m_CurrAlignment, "-aligned" );
+                        if (Block.Offset + Block.Size < m_MaxSize)
+                            VERIFY( (Block.Size & (m_CurrAlignment-1)) == 0, "All block sizes except for the last one must be ", m_CurrAlignment, "-aligned" );
+                        VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+                        VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+                        VERIFY(m_BlocksByEnd.Find(Block.Offset) == InvalidIndex, "Unmerged adjacent blocks detected" );
+                        TotalFreeSize += Block.Size;
+                        ++NumBlocks;
+                        PrevBlockIdx = BlockIdx;
+                    }
+                }
+            }
+
+            VERIFY_EXPR(NumBlocks == m_NumFreeBlocks);
+            VERIFY_EXPR(m_BlocksByStart.GetCount() == m_NumFreeBlocks);
+            VERIFY_EXPR(m_BlocksByEnd.GetCount() == m_NumFreeBlocks);
+            VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+        }
+#endif
+
+        std::vector<FreeBlockInfo, STDAllocatorRawMem<FreeBlockInfo>> m_Blocks;
+        BoundaryTagTable m_BlocksByStart;
+        BoundaryTagTable m_BlocksByEnd;
+        Uint32 m_FirstUnusedBlock = InvalidIndex;
+        size_t m_NumFreeBlocks    = 0;
+
+        Uint64 m_FLBitmap = 0;
+        Uint32 m_SLBitmaps[FLIndexCount];
+        Uint32 m_FreeLists[FLIndexCount][SLIndexCount];
+
+        OffsetType m_MaxSize       = 0;
+        OffsetType m_FreeSize      = 0;
+        OffsetType m_CurrAlignment = 0;
+        // When adding new members, do not forget to update move ctor and move assignment operator
+    };
+}
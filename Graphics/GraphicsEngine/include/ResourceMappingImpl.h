@@ -42,6 +42,12 @@ namespace Diligent
         {
         }
 
+        ResMappingHashKey(const Char* Str, size_t StrHash, Uint32 ArrInd):
+            StrKey(HashMapStringKey::FromHash(Str, StrHash)),
+            ArrayIndex(ArrInd)
+        {
+        }
+
         ResMappingHashKey(ResMappingHashKey&& rhs) : 
             StrKey(std::move(rhs.StrKey)),
             ArrayIndex(rhs.ArrayIndex)
@@ -89,6 +95,13 @@ namespace Diligent
 {
     class FixedBlockMemoryAllocator;
 
+    // {7BCCC2CD-C217-48D3-B912-13095672FC2C}
+    /// Interface ID that is only recognized by ResourceMappingImpl. Resource mappings passed to the engine 
+    /// may be implemented by the application, so the engine queries this ID before it calls the methods
+    /// of the implementation directly.
+    static constexpr INTERFACE_ID IID_ResourceMappingImpl =
+    { 0x7bccc2cd, 0xc217, 0x48d3, { 0xb9, 0x12, 0x13, 0x09, 0x56, 0x72, 0xfc, 0x2c } };
+
     /// Implementation of the resource mapping
     class ResourceMappingImpl : public ObjectBase<IResourceMapping>
     {
@@ -118,6 +131,9 @@ namespace Diligent
         /// Implementation of IResourceMapping::GetResource()
         virtual void GetResource( const Char* Name, IDeviceObject** ppResource, Uint32 ArrayIndex )override final;
 
+        /// Same as GetResource(), but uses the hash of the name computed by CStringHash<Char>
+        void GetResource( const Char* Name, size_t NameHash, IDeviceObject** ppResource, Uint32 ArrayIndex );
+
         /// Returns number of resources in the resource mapping.
         virtual size_t GetSize()override final;
 
@@ -125,6 +141,8 @@ namespace Diligent
 
         ThreadingTools::LockHelper Lock();
 
+        void FindResource( ResMappingHashKey&& Key, IDeviceObject** ppResource );
+
         ThreadingTools::LockFlag m_LockFlag;
         typedef std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject> > HashTableElem;
         std::unordered_map< ResMappingHashKey, RefCntAutoPtr<IDeviceObject>, std::hash<ResMappingHashKey>, std::equal_to<ResMappingHashKey>, STDAllocatorRawMem<HashTableElem>  > m_HashTable;
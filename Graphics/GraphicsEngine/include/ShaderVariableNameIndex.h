@@ -0,0 +1,160 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderVariableNameIndex class and Diligent::GetResourceFromMapping function
+
+#include <vector>
+#include <cstring>
+#include "BasicTypes.h"
+#include "HashUtils.h"
+#include "STDAllocator.h"
+#include "ResourceMappingImpl.h"
+#include "RefCntAutoPtr.h"
+
+namespace Diligent
+{
+
+/// Hash index that maps names of shader variables to their indices.
+
+/// The index is built once when a resource layout is initialized and is not modified afterwards.
+/// It is an open-addressing table that is at most half full. Every slot keeps the full hash 
+/// of the name, so names are only compared when the hashes match. Name hashes are also kept 
+/// by variable index, so that BindResources() does not need to hash names every time.
+class ShaderVariableNameIndex
+{
+public:
+    static constexpr Uint32 InvalidIndex = static_cast<Uint32>(-1);
+
+    ShaderVariableNameIndex(IMemoryAllocator& Allocator) :
+        m_Slots     (STD_ALLOCATOR_RAW_MEM(Slot,   Allocator, "Allocator for vector<ShaderVariableNameIndex::Slot>")),
+        m_NameHashes(STD_ALLOCATOR_RAW_MEM(size_t, Allocator, "Allocator for vector<size_t>"))
+    {}
+
+    ShaderVariableNameIndex            (const ShaderVariableNameIndex&) = delete;
+    ShaderVariableNameIndex& operator= (const ShaderVariableNameIndex&) = delete;
+    ShaderVariableNameIndex            (ShaderVariableNameIndex&&)      = default;
+    ShaderVariableNameIndex& operator= (ShaderVariableNameIndex&&)      = delete;
+
+    static size_t HashName(const Char* Name)
+    {
+        return CStringHash<Char>()(Name);
+    }
+
+    /// Builds the index of NumNames names. GetName(i) must return the name of the i-th
+    /// variable, and the names must stay alive while the index is used. If several variables
+    /// have the same name, the name is mapped to the first one.
+    template<typename TGetName>
+    void Initialize(Uint32 NumNames, TGetName GetName)
+    {
+        VERIFY(m_NameHashes.empty(), "The index has already been initialized");
+        if (NumNames == 0)
+            return;
+
+        Uint32 TableSize = 2;
+        while (TableSize < NumNames * 2)
+            TableSize *= 2;
+        m_Mask = TableSize - 1;
+        m_Slots.resize(TableSize);
+        m_NameHashes.resize(NumNames);
+
+        for (Uint32 i = 0; i < NumNames; ++i)
+        {
+            const Char* Name = GetName(i);
+            auto Hash = HashName(Name);
+            m_NameHashes[i] = Hash;
+            for (auto s = static_cast<Uint32>(Hash) & m_Mask; ; s = (s + 1) & m_Mask)
+            {
+                auto& CurrSlot = m_Slots[s];
+                if (CurrSlot.Index == InvalidIndex)
+                {
+                    CurrSlot.Hash  = Hash;
+                    CurrSlot.Name  = Name;
+                    CurrSlot.Index = i;
+                    break;
+                }
+                if (CurrSlot.Hash == Hash && strcmp(CurrSlot.Name, Name) == 0)
+                    break;
+            }
+        }
+    }
+
+    /// Returns the index of the variable with the given name, or InvalidIndex if there is no such variable
+    Uint32 Find(const Char* Name)const
+    {
+        if (m_Slots.empty())
+            return InvalidIndex;
+
+        auto Hash = HashName(Name);
+        for (auto s = static_cast<Uint32>(Hash) & m_Mask; ; s = (s + 1) & m_Mask)
+        {
+            const auto& CurrSlot = m_Slots[s];
+            if (CurrSlot.Index == InvalidIndex)
+                return InvalidIndex;
+            if (CurrSlot.Hash == Hash && strcmp(CurrSlot.Name, Name) == 0)
+                return CurrSlot.Index;
+        }
+    }
+
+    /// Returns the hash of the name of the i-th variable
+    size_t GetNameHash(Uint32 Index)const
+    {
+        VERIFY_EXPR(Index < m_NameHashes.size());
+        return m_NameHashes[Index];
+    }
+
+private:
+    struct Slot
+    {
+        size_t      Hash  = 0;
+        const Char* Name  = nullptr;
+        Uint32      Index = InvalidIndex;
+    };
+
+    std::vector<Slot,   STDAllocatorRawMem<Slot>   > m_Slots;
+    std::vector<size_t, STDAllocatorRawMem<size_t> > m_NameHashes;
+    Uint32 m_Mask = 0;
+};
+
+/// Gets the resource from the resource mapping using the hash of the name computed 
+/// by ShaderVariableNameIndex::HashName() if the mapping was created by the render device.
+/// Applications may pass their own implementations of IResourceMapping, which are accessed
+/// through the interface method with the name only.
+inline void GetResourceFromMapping(IResourceMapping* pResourceMapping,
+                                   const Char*       Name,
+                                   size_t            NameHash,
+                                   Uint32            ArrayIndex,
+                                   IDeviceObject**   ppResource)
+{
+    RefCntAutoPtr<IObject> pMappingImpl;
+    pResourceMapping->QueryInterface(IID_ResourceMappingImpl, &pMappingImpl);
+    if (pMappingImpl)
+        static_cast<ResourceMappingImpl*>(pResourceMapping)->GetResource(Name, NameHash, ppResource, ArrayIndex);
+    else
+        pResourceMapping->GetResource(Name, ppResource, ArrayIndex);
+}
+
+}
@@ -28,6 +28,9 @@
 
 #include "DeviceObject.h"
 #include <unordered_map>
+#include <array>
+#include <memory>
+#include <algorithm>
 #include "STDAllocator.h"
 
 namespace Diligent
@@ -54,17 +57,27 @@ namespace Diligent
     /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
     /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
     /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+    /// \remarks
+    /// The registry is split into NumShards shards selected by the hash of the description. Every shard 
+    /// has its own lock, so threads that look up different descriptions rarely contend. Expired references 
+    /// are removed incrementally: every Add() checks at most BucketsToPurgePerAdd buckets of the shard's hash 
+    /// map if the shard has outstanding deleted objects, and Find() removes expired references it encounters.
     template<typename ResourceDescType>
     class StateObjectsRegistry
     {
     public:
-        /// Number of outstanding deleted objects to purge the registry.
-        static constexpr int DeletedObjectsToPurge = 32;
+        /// Number of shards, must be a power of two
+        static constexpr Uint32 NumShards = 16;
+
+        /// Maximum number of hash map buckets that Add() checks for expired references
+        static constexpr size_t BucketsToPurgePerAdd = 1;
 
         StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-            m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >") ),
             m_RegistryName( RegistryName )
-        {}
+        {
+            for (auto& Shard : m_Shards)
+                Shard.pDescToObjHashMap.reset( new HashMapType(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >") ) );
+        }
         
         ~StateObjectsRegistry()
         {
@@ -74,7 +87,10 @@ namespace Diligent
             // may only be expired references in the registry. After we
             // purge it, the registry must be empty.
             Purge();
-            VERIFY( m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty" );
+            for (auto& Shard : m_Shards)
+            {
+                VERIFY( Shard.pDescToObjHashMap->empty(), "DescToObjHashMap is not empty" );
+            }
         }
 
         /// Adds a new object to the registry
@@ -82,27 +98,22 @@ namespace Diligent
         /// \param [in] ObjectDesc - object description.
         /// \param [in] pObject - pointer to the object.
         /// 
-        /// Besides adding a new object, the function also checks the number of
-        /// outstanding deleted objects and calls Purge() if the number has reached
-        /// the threshold value DeletedObjectsToPurge. Creating a state object is 
-        /// assumed to be an expensive operation and should be performed during
-        /// the initialization. Occasional purge operations should not add significant
-        /// cost to it.
+        /// Besides adding a new object, the function also removes expired references
+        /// from a few buckets of the shard if objects have been deleted from it.
+        /// This bounds the cost of every call, while all expired references 
+        /// are eventually removed as the buckets are visited in round-robin order.
         void Add( const ResourceDescType& ObjectDesc, IDeviceObject* pObject )
         {
-            ThreadingTools::LockHelper Lock( m_LockFlag );
+            auto& Shard = GetShard( ObjectDesc );
+            ThreadingTools::LockHelper Lock( Shard.LockFlag );
+            auto& DescToObjHashMap = *Shard.pDescToObjHashMap;
 
-            // If the number of outstanding deleted objects reached the threshold value,
-            // purge the registry. Since we have exclusive access now, it is safe
-            // to do.
-            if( m_NumDeletedObjects >= DeletedObjectsToPurge )
-            {
-                Purge();
-                m_NumDeletedObjects = 0;
-            }
+            // Since we have exclusive access to the shard now, it is safe to purge it.
+            if( Shard.NumDeletedObjects > 0 )
+                PurgeBuckets( Shard, BucketsToPurgePerAdd );
 
             // Try to construct the new element in place
-            auto Elems = m_DescToObjHashMap.emplace( std::make_pair( ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject) ) );
+            auto Elems = DescToObjHashMap.emplace( std::make_pair( ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject) ) );
             // It is theorertically possible that the same object can be found
             // in the registry. This might happen if two threads try to create
             // the same object at the same time. They both will not find the
@@ -130,10 +141,12 @@ namespace Diligent
         {
             VERIFY( *ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks" );
             *ppObject = nullptr;
-            ThreadingTools::LockHelper Lock( m_LockFlag );
+            auto& Shard = GetShard( Desc );
+            ThreadingTools::LockHelper Lock( Shard.LockFlag );
+            auto& DescToObjHashMap = *Shard.pDescToObjHashMap;
 
-            auto It = m_DescToObjHashMap.find( Desc );
-            if( It != m_DescToObjHashMap.end() )
+            auto It = DescToObjHashMap.find( Desc );
+            if( It != DescToObjHashMap.end() )
             {
                 // Try to obtain strong reference to the object.
                 // This is an atomic operation and we either get
@@ -148,58 +161,102 @@ namespace Diligent
                 else
                 {
                     // Expired object found: remove it from the map
-                    m_DescToObjHashMap.erase(It);
-                    Atomics::AtomicDecrement(m_NumDeletedObjects);
+                    DescToObjHashMap.erase(It);
+                    Atomics::AtomicDecrement(Shard.NumDeletedObjects);
                 }
             }
         }
 
-        /// Purges outstanding deleted objects from the registry
+        /// Purges all outstanding deleted objects from the registry
         void Purge()
         {
-            Uint32 NumPurgedObjects = 0;
-            auto It = m_DescToObjHashMap.begin();
-            while(  It != m_DescToObjHashMap.end() )
+            for (auto& Shard : m_Shards)
             {
-                auto NextIt = It;
-                ++NextIt;
-                // Note that IsValid() is not a thread-safe function in the sense that it 
-                // can give false positive results. The only thread-safe way to check if the
-                // object is alive is to lock the weak pointer, but that requires thread 
-                // synchronization. We will immediately unlock the pointer anyway, so we
-                // want to detect 100% expired pointers. IsValid() does provide that information
-                // because once a weak pointer becomes invalid, it will be invalid
-                // until it is destroyed. It is not a problem if we miss an expired weak
-                // pointer as it will definitiely be removed next time.
-                if( !It->second.IsValid() )
-                {
-                    m_DescToObjHashMap.erase( It );
-                    ++NumPurgedObjects;
-                }
-
-                It = NextIt;
+                ThreadingTools::LockHelper Lock( Shard.LockFlag );
+                PurgeBuckets( Shard, Shard.pDescToObjHashMap->bucket_count() );
             }
-            LOG_INFO_MESSAGE( "Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry" );
         }
 
-        /// Increments the number of outstanding deleted objects.
-        /// When this number reaches DeletedObjectsToPurge, Purge() will
-        /// be called.
-        void ReportDeletedObject()
+        /// Increments the number of outstanding deleted objects in the shard 
+        /// the object description belongs to. While this number is not zero, 
+        /// Add() removes expired references from the shard.
+        void ReportDeletedObject( const ResourceDescType& ObjectDesc )
         {
-            Atomics::AtomicIncrement(m_NumDeletedObjects);
+            Atomics::AtomicIncrement( GetShard( ObjectDesc ).NumDeletedObjects );
         }
 
     private:
-        /// Lock flag to protect the m_DescToObjHashMap
-        ThreadingTools::LockFlag m_LockFlag;
-        
-        /// Nmber of outstanding deleted objects that have not been purged
-        Atomics::AtomicLong m_NumDeletedObjects;
-
         /// Hash map that stores weak pointers to the referenced objects
         typedef std::pair< const ResourceDescType, RefCntWeakPtr<IDeviceObject> > HashMapElem;
-        std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem> > m_DescToObjHashMap;
+        typedef std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem> > HashMapType;
+
+        struct RegistryShard
+        {
+            /// Lock flag to protect the hash map and the purge position
+            ThreadingTools::LockFlag LockFlag;
+
+            /// Number of outstanding deleted objects that have not been purged
+            Atomics::AtomicLong NumDeletedObjects;
+
+            /// Index of the next bucket to check for expired references
+            size_t NextBucketToPurge = 0;
+
+            std::unique_ptr<HashMapType> pDescToObjHashMap;
+
+            RegistryShard()
+            {
+                NumDeletedObjects = 0;
+            }
+        };
+
+        RegistryShard& GetShard( const ResourceDescType& Desc )
+        {
+            // Use the upper bits of the multiplicative hash so that the shard index does not 
+            // correlate with the bucket index the hash map derives from the lower bits
+            Uint64 Hash = static_cast<Uint64>( std::hash<ResourceDescType>()(Desc) );
+            auto ShardInd = static_cast<size_t>( (Hash * 0x9E3779B97F4A7C15ull) >> 60 );
+            static_assert(NumShards == 16, "The shift above assumes 16 shards");
+            return m_Shards[ShardInd];
+        }
+
+        /// Removes expired references from at most NumBuckets buckets of the shard's hash map. 
+        /// The shard must be locked by the caller.
+        static void PurgeBuckets( RegistryShard& Shard, size_t NumBuckets )
+        {
+            auto& DescToObjHashMap = *Shard.pDescToObjHashMap;
+            const auto BucketCount = DescToObjHashMap.bucket_count();
+            NumBuckets = std::min( NumBuckets, BucketCount );
+            for( size_t b = 0; b < NumBuckets; ++b )
+            {
+                // Bucket count changes when the map is rehashed, which only makes some buckets to be checked again
+                auto Bucket = Shard.NextBucketToPurge++ % BucketCount;
+                // Elements cannot be erased through local iterators, so find the first expired element 
+                // in the bucket, erase it through the regular iterator and start over. Buckets contain 
+                // very few elements.
+                for(;;)
+                {
+                    auto It = DescToObjHashMap.begin(Bucket);
+                    // Note that IsValid() is not a thread-safe function in the sense that it 
+                    // can give false positive results. The only thread-safe way to check if the
+                    // object is alive is to lock the weak pointer, but that requires thread 
+                    // synchronization. We will immediately unlock the pointer anyway, so we
+                    // want to detect 100% expired pointers. IsValid() does provide that information
+                    // because once a weak pointer becomes invalid, it will be invalid
+                    // until it is destroyed. It is not a problem if we miss an expired weak
+                    // pointer as it will definitiely be removed next time.
+                    while( It != DescToObjHashMap.end(Bucket) && It->second.IsValid() )
+                        ++It;
+                    if( It == DescToObjHashMap.end(Bucket) )
+                        break;
+
+                    DescToObjHashMap.erase( DescToObjHashMap.find( It->first ) );
+                    Atomics::AtomicDecrement( Shard.NumDeletedObjects );
+                }
+            }
+            Shard.NextBucketToPurge %= BucketCount;
+        }
+
+        std::array<RegistryShard, NumShards> m_Shards;
 
         /// Registry name used for debug output
         const String m_RegistryName;
@@ -38,7 +38,8 @@ namespace Diligent
         D3D12,      ///< D3D12 device
         OpenGL,     ///< OpenGL device 
         OpenGLES,   ///< OpenGLES device
-        Vulkan      ///< Vulkan device
+        Vulkan,     ///< Vulkan device
+        Null        ///< Null device that records commands into CPU memory
     };
 
     /// Texture sampler capabilities
@@ -129,6 +130,10 @@ namespace Diligent
         {
             return DevType == DeviceType::Vulkan;
         }
+        bool IsNullDevice()const
+        {
+            return DevType == DeviceType::Null;
+        }
 
         struct NDCAttribs
         {
@@ -1391,6 +1391,18 @@ namespace Diligent
         /// pages when resources are released
         Uint32 HostVisibleMemoryReserveSize = 256 << 20;
 
+        /// Allocations of this size or larger are placed into separate device memory 
+        /// objects rather than shared memory pages. Such memory is released back to 
+        /// the system as soon as the resource is destroyed. 0 disables dedicated allocations.
+        Uint32 DedicatedAllocationThreshold = 8 << 20;
+
+        /// Maximum number of bytes the memory defragmenter moves at the end of every frame. 
+        /// The defragmenter moves vertex, index and indirect argument buffers out of sparse 
+        /// device-local memory pages, so that the pages can be released. 0 disables defragmentation.
+        /// \note  When defragmentation is enabled, VkBuffer handles of such buffers may change
+        ///        at the end of any frame. Defragmentation is suspended while the device has deferred contexts.
+        Uint32 MemoryDefragmentationBudget = 0;
+
         /// Page size of the upload heap that is allocated by immediate/deferred
         /// contexts from the global memory manager to perform lock-free dynamic
         /// suballocations.
@@ -1404,6 +1416,39 @@ namespace Diligent
         /// Size of the memory chunk suballocated by immediate/deferred context from
         /// the global dynamic heap to perform lock-free dynamic suballocations
         Uint32 DynamicHeapPageSize = 256 << 10;
+
+        /// Path to the file of the persistent shader cache that stores SPIR-V
+        /// byte code of compiled shaders. If null, the cache is not used.
+        const Char* ShaderCacheFilePath = nullptr;
+
+        /// Share Vulkan descriptor sets of static and mutable variables between shader resource 
+        /// binding objects that use the same pipeline layout and reference the same resources.
+        /// This reduces descriptor pool memory and descriptor updates when many SRBs are identical,
+        /// but every SRB commit looks up its descriptor set in the cache after any resource change.
+        bool EnableDescriptorSetCache = false;
+
+        /// Path to the file that stores Vulkan pipeline cache data. If the file exists and was created
+        /// by the same driver and physical device, pipelines are created using the cached data. 
+        /// The cache is written back to the file when the device is destroyed.
+        const Char* PipelineCacheFilePath = nullptr;
+
+        /// Number of worker threads that initialize pipeline states created by 
+        /// IRenderDeviceVk::CreatePipelineStateAsync(). The threads are started when the first 
+        /// asynchronous pipeline state is requested. 0 means one less than the number of hardware threads.
+        Uint32 NumAsyncPipelineThreads = 0;
+
+        /// Page size of the staging heap that is used to upload initial data of buffers and textures.
+        Uint32 InitialDataUploadPageSize = 4 << 20;
+
+        /// Maximum number of buffer and texture initializations that are recorded into one transient
+        /// command buffer before it is submitted to the queue. Pending uploads are also submitted by 
+        /// IRenderDeviceVk::FlushPendingUploads() and before every command buffer of the immediate context. 
+        /// 1 submits every initialization separately.
+        Uint32 MaxPendingInitialDataUploads = 256;
+
+        /// Maximum amount of pending staging data of buffer and texture initializations. When the 
+        /// amount is reached, the pending uploads are submitted to the queue.
+        Uint32 MaxPendingInitialDataSize = 64 << 20;
     };
 
     /// Box
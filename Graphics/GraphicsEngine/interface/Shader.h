@@ -252,10 +252,12 @@ struct ShaderCreationAttribs
     /// Compiled shader bytecode. 
     
     /// If shader byte code is provided, FilePath and Source members must be null
-    /// \note. This option is currently only supported for D3D11 and D3D12. 
-    ///        The bytecode must contain reflection information. If shaders were compiled 
-    ///        using fxc, make sure that /Qstrip_reflect option is *not* specified.
+    /// \note. This option is currently only supported for D3D11, D3D12 and Vulkan. 
+    ///        For D3D11 and D3D12, the bytecode must contain reflection information. If shaders 
+    ///        were compiled using fxc, make sure that /Qstrip_reflect option is *not* specified.
     ///        Also, shaders need to be compiled against 4.0 profile or higher.
+    ///        For Vulkan, the bytecode must be SPIR-V that keeps resource names, e.g. compiled
+    ///        from GLSL without stripping debug information.
     const void *ByteCode = nullptr;
 
     /// Size of the compiled shader bytecode
@@ -33,7 +33,20 @@ namespace Diligent
     {
     }
 
-    IMPLEMENT_QUERY_INTERFACE( ResourceMappingImpl, IID_ResourceMapping, TObjectBase )
+    void ResourceMappingImpl::QueryInterface( const Diligent::INTERFACE_ID &IID, IObject **ppInterface )
+    {
+        if( ppInterface == nullptr )
+            return;
+        if( IID == IID_ResourceMapping || IID == IID_ResourceMappingImpl )
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            TObjectBase::QueryInterface( IID, ppInterface );
+        }
+    }
 
     ThreadingTools::LockHelper ResourceMappingImpl::Lock()
     {
@@ -94,6 +107,21 @@ namespace Diligent
         if( *Name == 0 )
             return;
 
+        // Name will be implicitly converted to HashMapStringKey without making a copy
+        FindResource( ResMappingHashKey(Name, false, ArrayIndex), ppResource );
+    }
+
+    void ResourceMappingImpl::GetResource( const Char *Name, size_t NameHash, IDeviceObject **ppResource, Uint32 ArrayIndex )
+    {
+        VERIFY(Name, "Name is null");
+        if( *Name == 0 )
+            return;
+
+        FindResource( ResMappingHashKey(Name, NameHash, ArrayIndex), ppResource );
+    }
+
+    void ResourceMappingImpl::FindResource( ResMappingHashKey&& Key, IDeviceObject **ppResource )
+    {
         VERIFY( ppResource, "Null pointer provided" );
         if(!ppResource)
             return;
@@ -104,8 +132,7 @@ namespace Diligent
         auto LockHelper = Lock();
 
         // Find an object with the requested name
-        // Name will be implicitly converted to HashMapStringKey without making a copy
-        auto It = m_HashTable.find( ResMappingHashKey(Name, false, ArrayIndex) );
+        auto It = m_HashTable.find( Key );
         if( It != m_HashTable.end() )
         {
             *ppResource = It->second.RawPtr();
@@ -33,6 +33,7 @@
 #include "STDAllocator.h"
 #include "ShaderVariableD3DBase.h"
 #include "ShaderResourcesD3D11.h"
+#include "ShaderVariableNameIndex.h"
 
 namespace Diligent
 {
@@ -340,6 +341,9 @@ private:
 
     std::shared_ptr<const ShaderResourcesD3D11> m_pResources;
     IObject& m_Owner;
+
+    // Indexes variables in the same order as GetShaderVariable(Uint32)
+    ShaderVariableNameIndex m_NameIndex;
 };
 
 }
@@ -38,7 +38,8 @@ namespace Diligent
 {
 
 ShaderResourceLayoutD3D11::ShaderResourceLayoutD3D11(IObject& Owner) : 
-    m_Owner(Owner)
+    m_Owner(Owner),
+    m_NameIndex(GetRawAllocator())
 {
 }
 
@@ -242,6 +243,8 @@ void ShaderResourceLayoutD3D11::Initialize(std::shared_ptr<const ShaderResources
     VERIFY(bufUav == m_NumBufUAVs,  "Not all Buf UAVs are initialized which will cause a crash when dtor is called");
     VERIFY(sam    == m_NumSamplers, "Not all samplers are initialized which will cause a crash when dtor is called");
 
+    m_NameIndex.Initialize(GetTotalResourceCount(), [&](Uint32 v){ return GetShaderVariable(v)->GetName(); });
+
     // Shader resource cache in the SRB is initialized by the constructor of ShaderResourceBindingD3D11Impl to
     // hold all variable types. The corresponding layout in the SRB is initialized to keep mutable and dynamic 
     // variables only
@@ -691,7 +694,7 @@ public:
     }
 
     template<typename ResourceType>
-    void Bind( ResourceType &Res)
+    void Bind( ResourceType &Res, size_t NameHash)
     {
         if ( (Flags & (1 << Res.Attribs.GetVariableType())) == 0 )
             return;
@@ -703,7 +706,7 @@ public:
 
             const auto* VarName = Res.Attribs.Name;
             RefCntAutoPtr<IDeviceObject> pRes;
-            ResourceMapping.GetResource( VarName, &pRes, elem );
+            GetResourceFromMapping( &ResourceMapping, VarName, NameHash, elem, &pRes );
             if (pRes)
             {
                 //  Call non-virtual function
@@ -740,63 +743,41 @@ void ShaderResourceLayoutD3D11::BindResources( IResourceMapping* pResourceMappin
     HandleResources(
         [&](ConstBuffBindInfo& cb)
         {
-            BindResHelper.Bind(cb);
+            BindResHelper.Bind(cb, m_NameIndex.GetNameHash(GetVariableIndex(cb)));
         },
 
         [&](TexSRVBindInfo& ts)
         {
-            BindResHelper.Bind(ts);
+            BindResHelper.Bind(ts, m_NameIndex.GetNameHash(GetVariableIndex(ts)));
         },
 
         [&](TexUAVBindInfo& uav)
         {
-            BindResHelper.Bind(uav);
+            BindResHelper.Bind(uav, m_NameIndex.GetNameHash(GetVariableIndex(uav)));
         },
 
         [&](BuffSRVBindInfo& srv)
         {
-            BindResHelper.Bind(srv);
+            BindResHelper.Bind(srv, m_NameIndex.GetNameHash(GetVariableIndex(srv)));
         },
 
         [&](BuffUAVBindInfo& uav)
         {
-            BindResHelper.Bind(uav);
+            BindResHelper.Bind(uav, m_NameIndex.GetNameHash(GetVariableIndex(uav)));
         },
 
         [&](SamplerBindInfo& sam)
         {
             if (!m_pResources->IsUsingCombinedTextureSamplers())
-                BindResHelper.Bind(sam);
+                BindResHelper.Bind(sam, m_NameIndex.GetNameHash(GetVariableIndex(sam)));
         }
     );
 }
 
 IShaderVariable* ShaderResourceLayoutD3D11::GetShaderVariable(const Char* Name)
 {
-    for (Uint32 cb = 0; cb < m_NumCBs; ++cb)
-        if (strcmp(GetCB(cb).Attribs.Name, Name) == 0)
-            return &GetCB(cb);
-    for (Uint32 t = 0; t < m_NumTexSRVs; ++t)
-        if (strcmp(GetTexSRV(t).Attribs.Name, Name) == 0 )
-            return &GetTexSRV(t);
-    for (Uint32 u = 0; u < m_NumTexUAVs; ++u)
-        if (strcmp(GetTexUAV(u).Attribs.Name, Name) == 0 )
-            return &GetTexUAV(u);
-    for (Uint32 s = 0; s < m_NumBufSRVs; ++s)
-        if (strcmp(GetBufSRV(s).Attribs.Name, Name) == 0 )
-            return &GetBufSRV(s);
-    for (Uint32 u = 0; u < m_NumBufUAVs; ++u)
-        if (strcmp(GetBufUAV(u).Attribs.Name, Name) == 0 )
-            return &GetBufUAV(u);
-    
-    if (!m_pResources->IsUsingCombinedTextureSamplers())
-    {
-        for (Uint32 s = 0; s < m_NumSamplers; ++s)
-            if (strcmp(GetSampler(s).Attribs.Name, Name) == 0 )
-                return &GetSampler(s);
-    }
-
-    return nullptr;
+    auto Index = m_NameIndex.Find(Name);
+    return Index != ShaderVariableNameIndex::InvalidIndex ? GetShaderVariable(Index) : nullptr;
 }
 
 Uint32 ShaderResourceLayoutD3D11::GetVariableIndex(const ShaderVariableD3D11Base& Variable)const
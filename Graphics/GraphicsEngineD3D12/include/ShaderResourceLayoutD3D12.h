@@ -100,6 +100,7 @@
 #include "ShaderBase.h"
 #include "ShaderResourcesD3D12.h"
 #include "ShaderResourceCacheD3D12.h"
+#include "ShaderVariableNameIndex.h"
 
 namespace Diligent
 {
@@ -246,17 +247,59 @@ public:
 
     const bool IsUsingSeparateSamplers() const {return !m_pResources->IsUsingCombinedTextureSamplers();}
 
-private:
-    const D3D12Resource& GetAssignedSampler(const D3D12Resource& TexSrv)const;
-          D3D12Resource& GetAssignedSampler(const D3D12Resource& TexSrv);
+    // Returns the index of the resource in the layout, or ShaderVariableNameIndex::InvalidIndex
+    // if the layout has no resource with the given name
+    Uint32 FindResource(const Char* Name)const
+    {
+        return m_NameIndex.Find(Name);
+    }
 
-    const Char* GetShaderName()const;
+    Uint32 GetResourceIndex(const D3D12Resource& Res)const
+    {
+        auto Index = static_cast<Uint32>(&Res - reinterpret_cast<const D3D12Resource*>(m_ResourceBuffer.get()));
+        VERIFY(Index < GetTotalResourceCount(), "The resource does not belong to this layout");
+        return Index;
+    }
+
+    // Returns the hash of the resource name that can be used with GetResourceFromMapping()
+    size_t GetResourceNameHash(Uint32 r)const
+    {
+        return m_NameIndex.GetNameHash(r);
+    }
+
+    const D3D12Resource& GetResource(Uint32 r)const
+    {
+        VERIFY_EXPR(r < GetTotalResourceCount());
+        auto* Resource = reinterpret_cast<const D3D12Resource*>(m_ResourceBuffer.get());
+        return Resource[r];
+    }
 
     Uint32 GetTotalSrvCbvUavCount()const
     {
         VERIFY_EXPR(m_CbvSrvUavOffsets[0] == 0);
         return m_CbvSrvUavOffsets[SHADER_VARIABLE_TYPE_NUM_TYPES];
     }
+
+    Uint32 GetSrvCbvUavOffset(SHADER_VARIABLE_TYPE VarType, Uint32 r)const
+    {
+        Uint32 Offset = m_CbvSrvUavOffsets[VarType] + r;
+        VERIFY_EXPR( Offset < m_CbvSrvUavOffsets[VarType+1] );
+        return Offset;
+    }
+
+    Uint32 GetSamplerOffset(SHADER_VARIABLE_TYPE VarType, Uint32 s)const
+    {
+        auto Offset = m_SamplersOffsets[VarType] + s;
+        VERIFY_EXPR( Offset < m_SamplersOffsets[VarType+1] );
+        return Offset;
+    }
+
+private:
+    const D3D12Resource& GetAssignedSampler(const D3D12Resource& TexSrv)const;
+          D3D12Resource& GetAssignedSampler(const D3D12Resource& TexSrv);
+
+    const Char* GetShaderName()const;
+
     Uint32 GetTotalSamplerCount()const
     {
         return m_SamplersOffsets[SHADER_VARIABLE_TYPE_NUM_TYPES] - m_SamplersOffsets[0];
@@ -272,31 +315,13 @@ private:
         auto* Resource = reinterpret_cast<D3D12Resource*>(m_ResourceBuffer.get());
         return Resource[r];
     }
-    const D3D12Resource& GetResource(Uint32 r)const
-    {
-        VERIFY_EXPR(r < GetTotalResourceCount());
-        auto* Resource = reinterpret_cast<const D3D12Resource*>(m_ResourceBuffer.get());
-        return Resource[r];
-    }
 
-    Uint32 GetSrvCbvUavOffset(SHADER_VARIABLE_TYPE VarType, Uint32 r)const
-    {
-        Uint32 Offset = m_CbvSrvUavOffsets[VarType] + r;
-        VERIFY_EXPR( Offset < m_CbvSrvUavOffsets[VarType+1] );
-        return Offset;
-    }
     D3D12Resource& GetSrvCbvUav(SHADER_VARIABLE_TYPE VarType, Uint32 r)
     {
         VERIFY_EXPR( r < GetCbvSrvUavCount(VarType) );
         return GetResource(GetSrvCbvUavOffset(VarType,r));
     }
 
-    Uint32 GetSamplerOffset(SHADER_VARIABLE_TYPE VarType, Uint32 s)const
-    {
-        auto Offset = m_SamplersOffsets[VarType] + s;
-        VERIFY_EXPR( Offset < m_SamplersOffsets[VarType+1] );
-        return Offset;
-    }
     D3D12Resource& GetSampler(SHADER_VARIABLE_TYPE VarType, Uint32 s)
     {
         VERIFY_EXPR( s < GetSamplerCount(VarType) );
@@ -312,6 +337,8 @@ private:
                         const std::array<Uint32, SHADER_VARIABLE_TYPE_NUM_TYPES>& CbvSrvUavCount,
                         const std::array<Uint32, SHADER_VARIABLE_TYPE_NUM_TYPES>& SamplerCount);
 
+    void InitializeNameIndex();
+
     std::unique_ptr<void, STDDeleterRawMem<void> > m_ResourceBuffer;
     std::array<Uint16, SHADER_VARIABLE_TYPE_NUM_TYPES + 1> m_CbvSrvUavOffsets = {};
     std::array<Uint16, SHADER_VARIABLE_TYPE_NUM_TYPES + 1> m_SamplersOffsets  = {};
@@ -321,6 +348,8 @@ private:
     // We must use shared_ptr to reference ShaderResources instance, because
     // there may be multiple objects referencing the same set of resources
     std::shared_ptr<const ShaderResourcesD3D12> m_pResources;
+
+    ShaderVariableNameIndex                     m_NameIndex;
 };
 
 }
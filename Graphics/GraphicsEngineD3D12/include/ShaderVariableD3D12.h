@@ -112,6 +112,7 @@ private:
     // continuous memory. If allocation granularity == 1, raw allocator is used.
     ShaderVariableD3D12Impl*         m_pVariables     = nullptr;
     Uint32                           m_NumVariables = 0;
+    Uint32                           m_AllowedTypeBits = 0;
 
 #ifdef _DEBUG
     IMemoryAllocator*                m_pDbgAllocator = nullptr;
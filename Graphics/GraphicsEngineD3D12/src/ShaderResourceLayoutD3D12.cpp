@@ -38,7 +38,8 @@ namespace Diligent
 {
  
 ShaderResourceLayoutD3D12::ShaderResourceLayoutD3D12(IObject& Owner) : 
-    m_Owner(Owner)
+    m_Owner(Owner),
+    m_NameIndex(GetRawAllocator())
 {
 }
 
@@ -106,6 +107,11 @@ void ShaderResourceLayoutD3D12::AllocateMemory(IMemoryAllocator&
     m_ResourceBuffer = std::unique_ptr<void, STDDeleterRawMem<void> >(pRawMem, Allocator);
 }
 
+void ShaderResourceLayoutD3D12::InitializeNameIndex()
+{
+    m_NameIndex.Initialize(GetTotalResourceCount(), [&](Uint32 r){ return GetResource(r).Attribs.Name; });
+}
+
 
 // http://diligentgraphics.com/diligent-engine/architecture/d3d12/shader-resource-layout#Initializing-Shader-Resource-Layouts-and-Root-Signature-in-a-Pipeline-State-Object
 // http://diligentgraphics.com/diligent-engine/architecture/d3d12/shader-resource-cache#Initializing-Shader-Resource-Layouts-in-a-Pipeline-State
@@ -302,6 +308,8 @@ void ShaderResourceLayoutD3D12::Initialize(ID3D12Device*
     }
 #endif
 
+    InitializeNameIndex();
+
     if(pResourceCache)
     {
         // Initialize resource cache to store static resources
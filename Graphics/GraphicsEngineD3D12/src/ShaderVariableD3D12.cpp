@@ -62,6 +62,7 @@ void ShaderVariableManagerD3D12::Initialize(const ShaderResourceLayoutD3D12& Src
 #endif
 
     const Uint32 AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
+    m_AllowedTypeBits = AllowedTypeBits;
     VERIFY_EXPR(m_NumVariables == 0);
     auto MemSize = GetRequiredMemorySize(SrcLayout, AllowedVarTypes, NumAllowedTypes, m_NumVariables);
     
@@ -119,17 +120,38 @@ void ShaderVariableManagerD3D12::Destroy(IMemoryAllocator &Allocator)
 
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Name)
 {
-    ShaderVariableD3D12Impl* pVar = nullptr;
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    if (m_NumVariables == 0)
+        return nullptr;
+
+    const auto& Layout = *m_pResourceLayout;
+    auto ResIndex = Layout.FindResource(Name);
+    if (ResIndex == ShaderVariableNameIndex::InvalidIndex)
+        return nullptr;
+
+    const auto VarType   = Layout.GetResource(ResIndex).Attribs.GetVariableType();
+    const bool IsSampler = ResIndex >= Layout.GetTotalSrvCbvUavCount();
+    if (!IsAllowedType(VarType, m_AllowedTypeBits) || (IsSampler && !Layout.IsUsingSeparateSamplers()))
+        return nullptr;
+
+    // Variables are created in the same order as in Initialize(): for every allowed 
+    // type, Srv/Cbv/Uavs are followed by samplers if separate samplers are used
+    Uint32 VarInd = 0;
+    for (SHADER_VARIABLE_TYPE t = SHADER_VARIABLE_TYPE_STATIC; t < VarType; t = static_cast<SHADER_VARIABLE_TYPE>(t+1))
     {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.m_Resource.Attribs.Name, Name) == 0)
+        if (IsAllowedType(t, m_AllowedTypeBits))
         {
-            pVar = &Var;
-            break;
+            VarInd += Layout.GetCbvSrvUavCount(t);
+            if (Layout.IsUsingSeparateSamplers())
+                VarInd += Layout.GetSamplerCount(t);
         }
     }
-    return pVar;
+    if (IsSampler)
+        VarInd += Layout.GetCbvSrvUavCount(VarType) + (ResIndex - Layout.GetSamplerOffset(VarType, 0));
+    else
+        VarInd += ResIndex - Layout.GetSrvCbvUavOffset(VarType, 0);
+
+    VERIFY_EXPR(VarInd < m_NumVariables && &m_pVariables[VarInd].m_Resource == &Layout.GetResource(ResIndex));
+    return m_pVariables + VarInd;
 }
 
 
@@ -172,6 +194,7 @@ void ShaderVariableManagerD3D12::BindResources( IResourceMapping* pResourceMappi
     if ( (Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0 )
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    const auto& Layout = *m_pResourceLayout;
     for (Uint32 v=0; v < m_NumVariables; ++v)
     {
         auto &Var = m_pVariables[v];
@@ -180,6 +203,7 @@ void ShaderVariableManagerD3D12::BindResources( IResourceMapping* pResourceMappi
         if ( (Flags & (1 << Res.Attribs.GetVariableType())) == 0 )
             continue;
 
+        const auto NameHash = Layout.GetResourceNameHash(Layout.GetResourceIndex(Res));
         for (Uint32 ArrInd = 0; ArrInd < Res.Attribs.BindCount; ++ArrInd)
         {
             if( (Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(ArrInd, *m_pResourceCache) )
@@ -187,7 +211,7 @@ void ShaderVariableManagerD3D12::BindResources( IResourceMapping* pResourceMappi
 
             RefCntAutoPtr<IDeviceObject> pObj;
             VERIFY_EXPR(pResourceMapping != nullptr);
-            pResourceMapping->GetResource( Res.Attribs.Name, &pObj, ArrInd );
+            GetResourceFromMapping( pResourceMapping, Res.Attribs.Name, NameHash, ArrInd, &pObj );
             if ( pObj )
             {
                 //  Call non-virtual function
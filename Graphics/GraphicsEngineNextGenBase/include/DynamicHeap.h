@@ -31,7 +31,7 @@
 #include <vector>
 #include <atomic>
 #include "VariableSizeAllocationsManager.h"
-#include "RingBuffer.h"
+#include "ConcurrentRingBuffer.h"
 
 namespace Diligent
 {
@@ -47,9 +47,9 @@ namespace DynamicHeap
 class MasterBlockRingBufferBasedManager
 {
 public:
-    using OffsetType  = RingBuffer::OffsetType;
-    using MasterBlock = RingBuffer::OffsetType;
-    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+    using OffsetType  = ConcurrentRingBuffer::OffsetType;
+    using MasterBlock = ConcurrentRingBuffer::OffsetType;
+    static constexpr const OffsetType InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
 
     MasterBlockRingBufferBasedManager(IMemoryAllocator& Allocator, 
                                       Uint32            Size) : 
@@ -63,13 +63,14 @@ public:
 
     void DiscardMasterBlocks(std::vector<MasterBlock>& /*Blocks*/, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        // Frame bookkeeping is only synchronized with itself, allocations are lock-free
+        std::lock_guard<std::mutex> Lock(m_FramesMtx);
         m_RingBuffer.FinishCurrentFrame(FenceValue);
     }
 
     void ReleaseStaleBlocks(Uint64 LastCompletedFenceValue)
     {
-        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
+        std::lock_guard<std::mutex> Lock(m_FramesMtx);
         m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
     }
 
@@ -79,13 +80,12 @@ public:
 protected:
     MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
     {
-        std::lock_guard<std::mutex> Lock(m_RingBufferMtx);
         return m_RingBuffer.Allocate(SizeInBytes, Alignment);
     }
 
 private:
-    std::mutex m_RingBufferMtx;
-    RingBuffer m_RingBuffer;
+    std::mutex           m_FramesMtx;
+    ConcurrentRingBuffer m_RingBuffer;
 };
 
 
@@ -0,0 +1,96 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BufferNullImpl class
+
+#include "Buffer.h"
+#include "RenderDevice.h"
+#include "BufferBase.h"
+#include "BufferViewNullImpl.h"
+#include "DynamicHeapNull.h"
+#include "STDAllocator.h"
+
+namespace Diligent
+{
+
+class FixedBlockMemoryAllocator;
+class DeviceContextNullImpl;
+
+/// Implementation of the Diligent::IBuffer interface in the Null back-end
+
+/// Contents of default, static and cpu-accessible buffers is kept in system memory.
+/// Dynamic buffers do not have their own storage: every context maps them to 
+/// the memory allocated from its dynamic heap.
+class BufferNullImpl final : public BufferBase<IBuffer, RenderDeviceNullImpl, BufferViewNullImpl, FixedBlockMemoryAllocator>
+{
+public:
+    using TBufferBase = BufferBase<IBuffer, RenderDeviceNullImpl, BufferViewNullImpl, FixedBlockMemoryAllocator>;
+
+    BufferNullImpl(IReferenceCounters*        pRefCounters, 
+                   FixedBlockMemoryAllocator& BuffViewObjMemAllocator, 
+                   RenderDeviceNullImpl*      pDeviceNull, 
+                   const BufferDesc&          BuffDesc, 
+                   const BufferData&          BuffData = BufferData(),
+                   bool                       bIsDeviceInternal = false);
+    ~BufferNullImpl();
+
+    virtual void UpdateData( IDeviceContext* pContext, Uint32 Offset, Uint32 Size, const PVoid pData )override final;
+    virtual void CopyData( IDeviceContext* pContext, IBuffer* pSrcBuffer, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size )override final;
+    virtual void Map( IDeviceContext* pContext, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData )override final;
+    virtual void Unmap( IDeviceContext* pContext, MAP_TYPE MapType, Uint32 MapFlags )override final;
+
+    virtual void* GetNativeHandle()override final{ return m_pData; }
+
+    /// Returns pointer to the buffer contents as seen by the given context
+    Uint8* GetCPUAddress(Uint32 CtxId)
+    {
+        if (m_Desc.Usage == USAGE_DYNAMIC)
+        {
+            VERIFY_EXPR(CtxId < m_DynamicAllocations.size());
+            return m_DynamicAllocations[CtxId].pData;
+        }
+        else
+            return m_pData;
+    }
+
+#ifdef DEVELOPMENT
+    void DvpVerifyDynamicAllocation(DeviceContextNullImpl* pCtx)const;
+#endif
+
+private:
+    virtual void CreateViewInternal( const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView )override final;
+
+    // Storage for non-dynamic buffers
+    Uint8* m_pData = nullptr;
+
+#ifdef DEVELOPMENT
+    std::vector< std::pair<MAP_TYPE, Uint32> > m_DvpMapType;
+#endif
+
+    std::vector<DynamicAllocationNull, STDAllocatorRawMem<DynamicAllocationNull> > m_DynamicAllocations;
+};
+
+}
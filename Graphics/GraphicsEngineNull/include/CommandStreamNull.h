@@ -0,0 +1,326 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandStreamNull class and Null command structures
+
+#include <vector>
+#include <type_traits>
+#include "DeviceContext.h"
+#include "MemoryAllocator.h"
+#include "STDAllocator.h"
+#include "RefCntAutoPtr.h"
+
+namespace Diligent
+{
+
+class PipelineStateNullImpl;
+class ShaderResourceBindingNullImpl;
+class BufferNullImpl;
+class TextureNullImpl;
+class TextureViewNullImpl;
+
+enum class CommandTypeNull : Uint32
+{
+    SetPipelineState,
+    CommitShaderResources,
+    SetStencilRef,
+    SetBlendFactors,
+    SetVertexBuffers,
+    SetIndexBuffer,
+    SetViewports,
+    SetScissorRects,
+    SetRenderTargets,
+    Draw,
+    DispatchCompute,
+    ClearDepthStencil,
+    ClearRenderTarget,
+    UpdateBuffer,
+    CopyBuffer,
+    UpdateTexture,
+    CopyTexture,
+    GenerateMips
+};
+
+// Every command is a POD structure optionally followed by a variable-size payload.
+// Commands hold raw pointers; the stream keeps strong references to the objects
+// that are accessed when the commands are executed (see CommandStreamNull::AddReference()).
+
+struct SetPipelineStateCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetPipelineState;
+    PipelineStateNullImpl* pPSO = nullptr;
+};
+
+struct CommitShaderResourcesCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::CommitShaderResources;
+    ShaderResourceBindingNullImpl* pSRB = nullptr;
+    // Number of IDeviceObject* pointers in the payload
+    Uint32 NumResources = 0;
+};
+
+struct SetStencilRefCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetStencilRef;
+    Uint32 StencilRef = 0;
+};
+
+struct SetBlendFactorsCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetBlendFactors;
+    Float32 BlendFactors[4] = {};
+};
+
+struct VertexStreamNull
+{
+    BufferNullImpl* pBuffer = nullptr;
+    Uint32          Offset  = 0;
+    Uint32          Stride  = 0;
+};
+
+struct SetVertexBuffersCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetVertexBuffers;
+    // Number of VertexStreamNull structures in the payload
+    Uint32 NumStreams = 0;
+};
+
+struct SetIndexBufferCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetIndexBuffer;
+    BufferNullImpl* pBuffer   = nullptr;
+    Uint32          Offset    = 0;
+    VALUE_TYPE      IndexType = VT_UNDEFINED;
+};
+
+struct SetViewportsCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetViewports;
+    // Number of Viewport structures in the payload
+    Uint32 NumViewports = 0;
+};
+
+struct SetScissorRectsCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetScissorRects;
+    // Number of Rect structures in the payload
+    Uint32 NumRects = 0;
+};
+
+struct SetRenderTargetsCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::SetRenderTargets;
+    TextureViewNullImpl* ppRTVs[MaxRenderTargets] = {};
+    TextureViewNullImpl* pDSV = nullptr;
+    Uint32 NumRenderTargets   = 0;
+};
+
+struct DrawCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::Draw;
+    DrawAttribs Attribs;
+};
+
+struct DispatchComputeCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::DispatchCompute;
+    DispatchComputeAttribs Attribs;
+};
+
+struct ClearDepthStencilCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::ClearDepthStencil;
+    TextureViewNullImpl* pDSV = nullptr;
+    Uint32  ClearFlags = 0;
+    Float32 Depth      = 1.f;
+    Uint8   Stencil    = 0;
+};
+
+struct ClearRenderTargetCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::ClearRenderTarget;
+    TextureViewNullImpl* pRTV = nullptr;
+    Float32 Color[4] = {};
+};
+
+struct UpdateBufferCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::UpdateBuffer;
+    BufferNullImpl* pBuffer = nullptr;
+    Uint32          Offset  = 0;
+    // Size of the data in the payload
+    Uint32          Size    = 0;
+};
+
+struct CopyBufferCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::CopyBuffer;
+    // If pSrcBuffer is null, the source data is stored in the payload
+    BufferNullImpl* pSrcBuffer = nullptr;
+    Uint32          SrcOffset  = 0;
+    BufferNullImpl* pDstBuffer = nullptr;
+    Uint32          DstOffset  = 0;
+    Uint32          Size       = 0;
+};
+
+struct UpdateTextureCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::UpdateTexture;
+    TextureNullImpl* pTexture = nullptr;
+    Uint32 MipLevel = 0;
+    Uint32 Slice    = 0;
+    Box    DstBox;
+    // If pSrcBuffer is null, tightly packed data is stored in the payload
+    BufferNullImpl* pSrcBuffer = nullptr;
+    Uint32 SrcOffset      = 0;
+    Uint32 SrcStride      = 0;
+    Uint32 SrcDepthStride = 0;
+};
+
+struct CopyTextureCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::CopyTexture;
+    TextureNullImpl* pSrcTexture = nullptr;
+    Uint32 SrcMipLevel = 0;
+    Uint32 SrcSlice    = 0;
+    Box    SrcBox;
+    TextureNullImpl* pDstTexture = nullptr;
+    Uint32 DstMipLevel = 0;
+    Uint32 DstSlice    = 0;
+    Uint32 DstX = 0;
+    Uint32 DstY = 0;
+    Uint32 DstZ = 0;
+};
+
+struct GenerateMipsCmdNull
+{
+    static constexpr CommandTypeNull Type = CommandTypeNull::GenerateMips;
+    TextureViewNullImpl* pTexView = nullptr;
+};
+
+
+/// Linear stream of commands recorded by a Null device context
+
+/// Commands are stored back to back in a single growable memory block. Every command 
+/// is preceded by a header that contains its type and total size, which makes
+/// the stream trivially traversable and the command memory reusable after Reset().
+class CommandStreamNull
+{
+public:
+    CommandStreamNull(IMemoryAllocator& Allocator);
+    ~CommandStreamNull();
+
+    CommandStreamNull            (CommandStreamNull&& Stream);
+    CommandStreamNull            (const CommandStreamNull&)  = delete;
+    CommandStreamNull& operator= (const CommandStreamNull&)  = delete;
+    CommandStreamNull& operator= (CommandStreamNull&&)       = delete;
+
+    template<typename CommandType>
+    CommandType& AddCommand(size_t PayloadSize = 0)
+    {
+        static_assert(std::is_trivially_destructible<CommandType>::value, "Commands must be trivially destructible");
+        static_assert(alignof(CommandType) <= CommandAlignment, "Command alignment exceeds the alignment of the stream");
+        auto CmdSize = AlignSize(sizeof(CommandHeader) + AlignSize(sizeof(CommandType)) + PayloadSize);
+        auto* pHeader = reinterpret_cast<CommandHeader*>(Reserve(CmdSize));
+        pHeader->Type = CommandType::Type;
+        pHeader->Size = static_cast<Uint32>(CmdSize);
+        ++m_NumCommands;
+        return *new(pHeader + 1) CommandType;
+    }
+
+    template<typename CommandType>
+    static Uint8* GetPayload(CommandType& Cmd)
+    {
+        return reinterpret_cast<Uint8*>(&Cmd) + AlignSize(sizeof(CommandType));
+    }
+
+    template<typename CommandType>
+    static const Uint8* GetPayload(const CommandType& Cmd)
+    {
+        return reinterpret_cast<const Uint8*>(&Cmd) + AlignSize(sizeof(CommandType));
+    }
+
+    /// Keeps a strong reference to the object until the stream is reset
+    void AddReference(IObject* pObject)
+    {
+        m_References.emplace_back(pObject);
+    }
+
+    /// Calls Handler(CommandTypeNull Type, const void* pCommand) for every command in the stream
+    template<typename HandlerType>
+    void ProcessCommands(HandlerType Handler)const
+    {
+        size_t Offset = 0;
+        while (Offset < m_Size)
+        {
+            const auto* pHeader = reinterpret_cast<const CommandHeader*>(m_pData + Offset);
+            Handler(pHeader->Type, pHeader + 1);
+            Offset += pHeader->Size;
+        }
+        VERIFY_EXPR(Offset == m_Size);
+    }
+
+    /// Discards all commands, but keeps the memory for reuse
+    void Reset();
+
+    bool   IsEmpty()         const {return m_NumCommands == 0;}
+    Uint32 GetNumCommands()  const {return m_NumCommands;}
+    size_t GetSize()         const {return m_Size;}
+
+private:
+    struct CommandHeader
+    {
+        CommandTypeNull Type;
+        Uint32          Size;
+    };
+    static constexpr size_t CommandAlignment = 8;
+    static_assert(sizeof(CommandHeader) % CommandAlignment == 0, "Header size must be a multiple of the command alignment");
+
+    static constexpr size_t AlignSize(size_t Size)
+    {
+        return (Size + (CommandAlignment-1)) & ~(CommandAlignment-1);
+    }
+
+    Uint8* Reserve(size_t Size)
+    {
+        if (m_Size + Size > m_Capacity)
+            Grow(m_Size + Size);
+        auto* pData = m_pData + m_Size;
+        m_Size += Size;
+        return pData;
+    }
+    void Grow(size_t RequiredCapacity);
+
+    IMemoryAllocator& m_Allocator;
+    Uint8*  m_pData       = nullptr;
+    size_t  m_Size        = 0;
+    size_t  m_Capacity    = 0;
+    Uint32  m_NumCommands = 0;
+
+    std::vector< RefCntAutoPtr<IObject>, STDAllocatorRawMem<RefCntAutoPtr<IObject>> > m_References;
+};
+
+}
@@ -0,0 +1,160 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DeviceContextNullImpl class
+
+#include <vector>
+#include "DeviceContext.h"
+#include "DeviceContextBase.h"
+#include "BufferNullImpl.h"
+#include "TextureNullImpl.h"
+#include "TextureViewNullImpl.h"
+#include "PipelineStateNullImpl.h"
+#include "CommandStreamNull.h"
+#include "DynamicHeapNull.h"
+#include "FixedBlockMemoryAllocator.h"
+#include "EngineNullAttribs.h"
+
+namespace Diligent
+{
+
+class FenceNullImpl;
+class ShaderResourceBindingNullImpl;
+
+/// Implementation of the Diligent::IDeviceContext interface in the Null back-end
+
+/// The context performs the same state tracking and validation as other back-ends, 
+/// but records all commands into a CPU-side command stream instead of submitting them
+/// to a GPU. When the immediate context is flushed, commands that modify buffer and 
+/// texture contents are executed on the CPU, and all other commands are discarded.
+class DeviceContextNullImpl final : public DeviceContextBase<IDeviceContext, BufferNullImpl, TextureViewNullImpl, PipelineStateNullImpl>
+{
+public:
+    using TDeviceContextBase = DeviceContextBase<IDeviceContext, BufferNullImpl, TextureViewNullImpl, PipelineStateNullImpl>;
+
+    DeviceContextNullImpl(IReferenceCounters*          pRefCounters,
+                          IMemoryAllocator&            Allocator,
+                          class RenderDeviceNullImpl*  pDevice,
+                          const EngineNullAttribs&     EngineAttribs,
+                          bool                         bIsDeferred,
+                          Uint32                       ContextId);
+    ~DeviceContextNullImpl();
+
+    virtual void SetPipelineState(IPipelineState* pPipelineState)override final;
+
+    virtual void TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)override final;
+
+    virtual void CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, Uint32 Flags)override final;
+
+    virtual void SetStencilRef(Uint32 StencilRef)override final;
+
+    virtual void SetBlendFactors(const float* pBlendFactors = nullptr)override final;
+
+    virtual void SetVertexBuffers( Uint32 StartSlot, Uint32 NumBuffersSet, IBuffer **ppBuffers, Uint32* pOffsets, Uint32 Flags )override final;
+    
+    virtual void InvalidateState()override final;
+
+    virtual void SetIndexBuffer( IBuffer* pIndexBuffer, Uint32 ByteOffset )override final;
+
+    virtual void SetViewports( Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight )override final;
+
+    virtual void SetScissorRects( Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight )override final;
+
+    virtual void SetRenderTargets( Uint32 NumRenderTargets, ITextureView* ppRenderTargets[], ITextureView* pDepthStencil )override final;
+
+    virtual void Draw( DrawAttribs &DrawAttribs )override final;
+
+    virtual void DispatchCompute( const DispatchComputeAttribs &DispatchAttrs )override final;
+
+    virtual void ClearDepthStencil( ITextureView* pView, Uint32 ClearFlags, float fDepth, Uint8 Stencil)override final;
+
+    virtual void ClearRenderTarget( ITextureView* pView, const float *RGBA )override final;
+
+    virtual void Flush()override final;
+
+    virtual void FinishFrame()override final;
+
+    virtual void FinishCommandList(class ICommandList **ppCommandList)override final;
+
+    virtual void ExecuteCommandList(class ICommandList* pCommandList)override final;
+
+    virtual void SignalFence(IFence* pFence, Uint64 Value)override final;
+
+    /// Unbinds all render targets. Used when resizing the swap chain.
+    void ResetRenderTargets();
+
+    void UpdateBufferRegion(BufferNullImpl* pBuffer, Uint32 Offset, Uint32 Size, const void* pData);
+    void CopyBufferRegion(BufferNullImpl* pSrcBuffer, Uint32 SrcOffset, BufferNullImpl* pDstBuffer, Uint32 DstOffset, Uint32 Size);
+
+    void UpdateTextureRegion(const TextureSubResData& SubresData, TextureNullImpl& Texture, Uint32 MipLevel, Uint32 Slice, const Box& DstBox);
+    void CopyTextureRegion(TextureNullImpl* pSrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box& SrcBox,
+                           TextureNullImpl* pDstTexture, Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ);
+
+    void GenerateMips(TextureViewNullImpl& TexView);
+
+    /// Allocates memory for a dynamic buffer from the context's dynamic heap
+    DynamicAllocationNull AllocateDynamicSpace(size_t NumBytes, size_t Alignment);
+
+    Uint32 GetContextId()const{return m_ContextId;}
+    Int64  GetContextFrameNumber()const{return m_ContextFrameNumber;}
+
+    /// Returns the stream of commands recorded since the last flush
+    const CommandStreamNull& GetCommandStream()const{return m_CmdStream;}
+
+    size_t GetDynamicHeapPeakSize()const{return m_DynamicHeap.GetPeakAllocatedSize();}
+
+private:
+    template<bool TransitionResources, bool CommitResources>
+    void TransitionAndCommitShaderResources(IPipelineState* pPSO, IShaderResourceBinding* pShaderResourceBinding);
+
+    void CommitVertexBuffers(PipelineStateNullImpl* pPipelineStateNull);
+    void CommitIndexBuffer(VALUE_TYPE IndexType);
+    void CommitRenderTargets();
+
+    /// Executes the commands that modify resource contents
+    void ExecuteCommands(const CommandStreamNull& CmdStream);
+
+    CommandStreamNull m_CmdStream;
+    DynamicHeapNull   m_DynamicHeap;
+
+    const Uint32 m_ContextId;
+    Int64        m_ContextFrameNumber = 0;
+
+    /// Number of draw and dispatch commands after which the immediate context is flushed
+    const Uint32 m_NumCommandsToFlush;
+    Uint32       m_NumDrawCommands = 0;
+
+    bool       m_bCommittedVBsUpToDate = false;
+    bool       m_bCommittedIBUpToDate  = false;
+    VALUE_TYPE m_CommittedIBFormat     = VT_UNDEFINED;
+
+    /// Fences signaled when the context is flushed next time
+    std::vector< std::pair<RefCntAutoPtr<FenceNullImpl>, Uint64> > m_PendingFences;
+
+    FixedBlockMemoryAllocator m_CmdListAllocator;
+};
+
+}
@@ -0,0 +1,95 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DynamicHeapNull class
+
+#include <vector>
+#include "MemoryAllocator.h"
+#include "STDAllocator.h"
+
+namespace Diligent
+{
+
+struct DynamicAllocationNull
+{
+    DynamicAllocationNull(){}
+    DynamicAllocationNull(Uint8* _pData, size_t _Size) :
+        pData(_pData),
+        Size (_Size)
+    {}
+
+    Uint8* pData = nullptr;
+    size_t Size  = 0;
+#ifdef DEVELOPMENT
+    Int64 dvpFrameNumber = 0;
+#endif
+};
+
+/// Per-context heap that provides CPU memory for dynamic buffers.
+
+/// Memory is suballocated linearly from fixed-size pages. All pages are recycled when the
+/// context finishes the frame, since the contents of dynamic resources is discarded at
+/// the end of every frame. Allocations that do not fit into a page get a dedicated page 
+/// that is released together with the others.
+class DynamicHeapNull
+{
+public:
+    DynamicHeapNull(IMemoryAllocator& Allocator, size_t PageSize);
+    ~DynamicHeapNull();
+
+    DynamicHeapNull            (const DynamicHeapNull&) = delete;
+    DynamicHeapNull            (DynamicHeapNull&&)      = delete;
+    DynamicHeapNull& operator= (const DynamicHeapNull&) = delete;
+    DynamicHeapNull& operator= (DynamicHeapNull&&)      = delete;
+
+    DynamicAllocationNull Allocate(size_t SizeInBytes, size_t Alignment);
+    void ReleaseAllocatedPages();
+
+    size_t GetAllocatedSize()const{return m_AllocatedSize;}
+    size_t GetPeakAllocatedSize()const{return m_PeakAllocatedSize;}
+
+private:
+    struct Page
+    {
+        Uint8* pData;
+        size_t Size;
+    };
+    Page CreatePage(size_t Size);
+
+    IMemoryAllocator& m_Allocator;
+    const size_t      m_PageSize;
+
+    std::vector<Page, STDAllocatorRawMem<Page> > m_UsedPages;
+    std::vector<Page, STDAllocatorRawMem<Page> > m_AvailablePages;
+
+    // Offset in the last used page
+    size_t m_CurrOffset = 0;
+    // Total size of all allocations in the current frame
+    size_t m_AllocatedSize = 0;
+    size_t m_PeakAllocatedSize = 0;
+};
+
+}
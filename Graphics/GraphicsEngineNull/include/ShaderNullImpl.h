@@ -0,0 +1,89 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderNullImpl class
+
+#include "Shader.h"
+#include "RenderDevice.h"
+#include "ShaderBase.h"
+#include "ShaderResourceLayoutNull.h"
+
+namespace Diligent
+{
+
+class RenderDeviceNullImpl;
+
+/// Implementation of the Diligent::IShader interface in the Null back-end
+
+/// The shader source is not compiled. Shader resources are the variables 
+/// listed in the shader description.
+class ShaderNullImpl final : public ShaderBase<IShader, RenderDeviceNullImpl>
+{
+public:
+    using TShaderBase = ShaderBase<IShader, RenderDeviceNullImpl>;
+
+    ShaderNullImpl(IReferenceCounters*          pRefCounters,
+                   RenderDeviceNullImpl*        pDeviceNull,
+                   const ShaderCreationAttribs& CreationAttribs,
+                   bool                         bIsDeviceInternal = false);
+
+    virtual void BindResources( IResourceMapping* pResourceMapping, Uint32 Flags )override final
+    {
+        m_StaticResLayout.BindResources(pResourceMapping, Flags);
+    }
+    
+    virtual IShaderVariable* GetShaderVariable( const Char* Name )override final
+    {
+        return m_StaticResLayout.GetShaderVariable(Name);
+    }
+
+    virtual Uint32 GetVariableCount() const override final
+    {
+        return m_StaticResLayout.GetTotalResourceCount();
+    }
+
+    virtual IShaderVariable* GetShaderVariable(Uint32 Index)override final
+    {
+        return m_StaticResLayout.GetShaderVariable(Index);
+    }
+
+    const ShaderResourceLayoutNull& GetStaticResourceLayout()const{ return m_StaticResLayout; }
+
+    Uint32 GetShaderTypeIndex()const{ return m_ShaderTypeIndex; }
+
+    /// Hash of the shader resource layout, i.e. of the names and types of all shader variables
+    size_t GetResourceLayoutHash()const{ return m_ResourceLayoutHash; }
+
+    bool IsCompatibleWith(const ShaderNullImpl& Shader)const;
+
+private:
+    ShaderResourceCacheNull  m_StaticResCache;
+    ShaderResourceLayoutNull m_StaticResLayout;
+    size_t                   m_ResourceLayoutHash = 0;
+    Uint32                   m_ShaderTypeIndex; // VS == 0, PS == 1, GS == 2, HS == 3, DS == 4, CS == 5
+};
+
+}
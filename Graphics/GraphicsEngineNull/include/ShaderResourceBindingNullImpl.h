@@ -0,0 +1,95 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceBindingNullImpl class
+
+#include "ShaderResourceBinding.h"
+#include "ShaderResourceBindingBase.h"
+#include "ShaderResourceLayoutNull.h"
+
+namespace Diligent
+{
+
+class FixedBlockMemoryAllocator;
+class PipelineStateNullImpl;
+
+/// Implementation of the Diligent::IShaderResourceBinding interface in the Null back-end
+class ShaderResourceBindingNullImpl final : public ShaderResourceBindingBase<IShaderResourceBinding>
+{
+public:
+    using TBase = ShaderResourceBindingBase<IShaderResourceBinding>;
+
+    ShaderResourceBindingNullImpl(IReferenceCounters*    pRefCounters,
+                                  PipelineStateNullImpl* pPSO,
+                                  bool                   IsInternal);
+    ~ShaderResourceBindingNullImpl();
+
+    virtual void BindResources(Uint32 ShaderFlags, IResourceMapping* pResMapping, Uint32 Flags)override final;
+
+    virtual IShaderVariable* GetVariable(SHADER_TYPE ShaderType, const char *Name)override final;
+
+    virtual Uint32 GetVariableCount(SHADER_TYPE ShaderType) const override final;
+
+    virtual IShaderVariable* GetVariable(SHADER_TYPE ShaderType, Uint32 Index)override final;
+
+    ShaderResourceCacheNull&  GetResourceCache (Uint32 Ind){VERIFY_EXPR(Ind < m_NumActiveShaders); return m_pBoundResourceCaches[Ind];}
+    ShaderResourceLayoutNull& GetResourceLayout(Uint32 Ind){VERIFY_EXPR(Ind < m_NumActiveShaders); return m_pResourceLayouts[Ind];}
+
+    void BindStaticShaderResources();
+    inline bool IsStaticResourcesBound(){return m_bIsStaticResourcesBound;}
+
+    Uint32 GetNumActiveShaders()
+    {
+        return static_cast<Uint32>(m_NumActiveShaders);
+    }
+
+    /// Returns the total number of resources in all shader stages
+    Uint32 GetTotalResourceCount()const{return m_TotalResourceCount;}
+
+    /// Writes raw pointers to the resources of all shader stages to the provided array
+    void CopyResourcePointers(IDeviceObject** ppObjects)const;
+
+#ifdef DEVELOPMENT
+    void dvpVerifyBindings()const;
+#endif
+
+private:
+    // The caches are indexed by the shader order in the PSO, not shader index
+    ShaderResourceCacheNull*  m_pBoundResourceCaches = nullptr;
+    ShaderResourceLayoutNull* m_pResourceLayouts     = nullptr;
+
+    Int8 m_ShaderTypeIndex[6] = {};
+
+    // Resource layout index in m_ResourceLayouts[] array for every shader stage
+    Int8 m_ResourceLayoutIndex[6];
+    Uint8 m_NumActiveShaders = 0;
+
+    Uint32 m_TotalResourceCount = 0;
+
+    bool m_bIsStaticResourcesBound = false;
+};
+
+}
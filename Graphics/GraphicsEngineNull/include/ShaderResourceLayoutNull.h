@@ -0,0 +1,174 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderResourceLayoutNull and Diligent::ShaderResourceCacheNull classes
+
+#include <vector>
+#include "Shader.h"
+#include "ShaderBase.h"
+#include "STDAllocator.h"
+#include "RefCntAutoPtr.h"
+#include "ShaderVariableNameIndex.h"
+
+namespace Diligent
+{
+
+class ShaderNullImpl;
+
+/// Stores the objects bound to shader resources.
+
+/// Every resource of a shader occupies one slot in the cache, the slot index is the index of
+/// the resource in the shader. A shader keeps the cache for its static resources, a shader 
+/// resource binding object keeps one cache per shader stage.
+class ShaderResourceCacheNull
+{
+public:
+    ShaderResourceCacheNull(IMemoryAllocator& Allocator) :
+        m_Resources(STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<IDeviceObject>, Allocator, "Allocator for vector<RefCntAutoPtr<IDeviceObject>>"))
+    {}
+
+    ShaderResourceCacheNull            (const ShaderResourceCacheNull&) = delete;
+    ShaderResourceCacheNull            (ShaderResourceCacheNull&&)      = delete;
+    ShaderResourceCacheNull& operator= (const ShaderResourceCacheNull&) = delete;
+    ShaderResourceCacheNull& operator= (ShaderResourceCacheNull&&)      = delete;
+
+    void Initialize(Uint32 NumResources)
+    {
+        VERIFY(m_Resources.empty(), "Resource cache has already been initialized");
+        m_Resources.resize(NumResources);
+    }
+
+    void SetResource(Uint32 Offset, RefCntAutoPtr<IDeviceObject>&& pObject)
+    {
+        VERIFY_EXPR(Offset < m_Resources.size());
+        m_Resources[Offset] = std::move(pObject);
+    }
+
+    IDeviceObject* GetResource(Uint32 Offset)const
+    {
+        VERIFY_EXPR(Offset < m_Resources.size());
+        return const_cast<IDeviceObject*>(m_Resources[Offset].RawPtr());
+    }
+
+    /// Writes raw pointers to all cached objects to the provided array
+    void CopyResourcePointers(IDeviceObject** ppObjects)const
+    {
+        for(Uint32 res=0; res < GetSize(); ++res)
+            *(ppObjects++) = GetResource(res);
+    }
+
+    Uint32 GetSize()const{ return static_cast<Uint32>(m_Resources.size()); }
+
+private:
+    std::vector<RefCntAutoPtr<IDeviceObject>, STDAllocatorRawMem<RefCntAutoPtr<IDeviceObject>> > m_Resources;
+};
+
+
+/// Exposes shader variables of the selected types and binds resources to the slots of the resource cache.
+
+/// The Null back-end does not reflect shader code, so shader resources are the variables
+/// listed in the shader description. Every variable is a single non-array resource.
+class ShaderResourceLayoutNull
+{
+public:
+    ShaderResourceLayoutNull(IObject& Owner, IMemoryAllocator& Allocator);
+
+    ShaderResourceLayoutNull            (const ShaderResourceLayoutNull&) = delete;
+    ShaderResourceLayoutNull            (ShaderResourceLayoutNull&&)      = delete;
+    ShaderResourceLayoutNull& operator= (const ShaderResourceLayoutNull&) = delete;
+    ShaderResourceLayoutNull& operator= (ShaderResourceLayoutNull&&)      = delete;
+
+    /// Creates variables for all shader resources of the allowed types. 
+    /// The resource cache must be initialized to hold all resources of the shader.
+    void Initialize(const ShaderNullImpl&       Shader,
+                    const SHADER_VARIABLE_TYPE* AllowedVarTypes,
+                    Uint32                      NumAllowedTypes,
+                    ShaderResourceCacheNull&    ResourceCache);
+
+    struct ShaderVariableNullImpl final : ShaderVariableBase
+    {
+        ShaderVariableNullImpl(ShaderResourceLayoutNull& ParentResLayout, 
+                               const ShaderVariableDesc& VarDesc,
+                               Uint32                    _CacheOffset) :
+            ShaderVariableBase(ParentResLayout.m_Owner),
+            Name            (VarDesc.Name),
+            Type            (VarDesc.Type),
+            CacheOffset     (_CacheOffset),
+            m_ParentResLayout(ParentResLayout)
+        {}
+
+        virtual void Set(IDeviceObject* pObject)override final
+        {
+            BindResource(pObject, 0);
+        }
+
+        virtual void SetArray(IDeviceObject* const* ppObjects, Uint32 FirstElement, Uint32 NumElements)override final
+        {
+            for(Uint32 elem=0; elem < NumElements; ++elem)
+                BindResource(ppObjects[elem], FirstElement+elem);
+        }
+
+        virtual SHADER_VARIABLE_TYPE GetType()const override final{ return Type; }
+        virtual Uint32 GetArraySize()const override final{ return 1; }
+        virtual const Char* GetName()const override final{ return Name; }
+        virtual Uint32 GetIndex()const override final{ return m_ParentResLayout.GetVariableIndex(*this); }
+
+        void BindResource(IDeviceObject* pObject, Uint32 ArrayIndex);
+        bool IsBound(Uint32 ArrayIndex)const;
+
+        const Char* const          Name;
+        const SHADER_VARIABLE_TYPE Type;
+        const Uint32               CacheOffset;
+
+    private:
+        ShaderResourceLayoutNull& m_ParentResLayout;
+    };
+
+    /// Copies the resources of all variables of this layout from its cache to the destination cache
+    void CopyResources(ShaderResourceCacheNull& DstCache)const;
+
+    void BindResources( IResourceMapping* pResourceMapping, Uint32 Flags );
+
+    IShaderVariable* GetShaderVariable( const Char* Name );
+    IShaderVariable* GetShaderVariable( Uint32 Index );
+    Uint32 GetVariableIndex(const ShaderVariableNullImpl& Variable)const;
+    Uint32 GetTotalResourceCount()const{ return static_cast<Uint32>(m_Variables.size()); }
+
+    const Char* GetShaderName()const{ return m_ShaderName; }
+
+#ifdef DEVELOPMENT
+    void dvpVerifyBindings()const;
+#endif
+
+private:
+    IObject&                 m_Owner;
+    const Char*              m_ShaderName     = "";
+    ShaderResourceCacheNull* m_pResourceCache = nullptr;
+    std::vector<ShaderVariableNullImpl, STDAllocatorRawMem<ShaderVariableNullImpl> > m_Variables;
+    ShaderVariableNameIndex  m_NameIndex;
+};
+
+}
@@ -0,0 +1,69 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SwapChainNullImpl class
+
+#include "SwapChain.h"
+#include "SwapChainBase.h"
+
+namespace Diligent
+{
+
+class IMemoryAllocator;
+/// Implementation of the Diligent::ISwapChain interface in the Null back-end
+
+/// The swap chain is not associated with any window. Back buffer and depth buffer
+/// are regular textures, and Present() flushes the immediate context and finishes the frame.
+class SwapChainNullImpl final : public SwapChainBase<ISwapChain>
+{
+public:
+    using TSwapChainBase = SwapChainBase<ISwapChain>;
+
+    SwapChainNullImpl(IReferenceCounters*           pRefCounters,
+                      const SwapChainDesc&          SwapChainDesc, 
+                      class RenderDeviceNullImpl*   pRenderDeviceNull,
+                      class DeviceContextNullImpl*  pImmediateContextNull);
+    ~SwapChainNullImpl();
+
+    virtual void Present(Uint32 SyncInterval)override final;
+
+    virtual void Resize( Uint32 NewWidth, Uint32 NewHeight )override final;
+
+    virtual void SetFullscreenMode(const DisplayModeAttribs &DisplayMode)override final;
+
+    virtual void SetWindowedMode()override final;
+
+    virtual ITextureView* GetCurrentBackBufferRTV()override final{return m_pRenderTargetView;}
+    virtual ITextureView* GetDepthBufferDSV()override final{return m_pDepthStencilView;}
+
+private:
+    void CreateRTVandDSV();
+
+    RefCntAutoPtr<ITextureView> m_pRenderTargetView;
+    RefCntAutoPtr<ITextureView> m_pDepthStencilView;
+};
+
+}
@@ -0,0 +1,122 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TextureNullImpl class
+
+#include "Texture.h"
+#include "RenderDevice.h"
+#include "TextureBase.h"
+#include "TextureViewNullImpl.h"
+#include "STDAllocator.h"
+
+namespace Diligent
+{
+
+class FixedBlockMemoryAllocator;
+
+/// Implementation of the Diligent::ITexture interface in the Null back-end
+
+/// Texture contents is kept in system memory as tightly packed subresources. Array slices 
+/// are stored one after another, every slice contains the full mip chain.
+/// The memory is allocated when the texture is first written to.
+class TextureNullImpl final : public TextureBase<ITexture, RenderDeviceNullImpl, TextureViewNullImpl, FixedBlockMemoryAllocator>
+{
+public:
+    using TTextureBase = TextureBase<ITexture, RenderDeviceNullImpl, TextureViewNullImpl, FixedBlockMemoryAllocator>;
+
+    TextureNullImpl(IReferenceCounters*        pRefCounters,
+                    FixedBlockMemoryAllocator& TexViewObjAllocator,
+                    RenderDeviceNullImpl*      pDeviceNull, 
+                    const TextureDesc&         TexDesc, 
+                    const TextureData&         InitData = TextureData(),
+                    bool                       bIsDeviceInternal = false);
+    ~TextureNullImpl();
+
+    virtual void UpdateData( IDeviceContext* pContext, Uint32 MipLevel, Uint32 Slice, const Box& DstBox, const TextureSubResData& SubresData )override final;
+
+    virtual void CopyData(IDeviceContext* pContext, 
+                          ITexture*       pSrcTexture, 
+                          Uint32          SrcMipLevel,
+                          Uint32          SrcSlice,
+                          const Box*      pSrcBox,
+                          Uint32          DstMipLevel,
+                          Uint32          DstSlice,
+                          Uint32          DstX,
+                          Uint32          DstY,
+                          Uint32          DstZ)override final;
+
+    virtual void Map(IDeviceContext*           pContext,
+                     Uint32                    MipLevel,
+                     Uint32                    ArraySlice,
+                     MAP_TYPE                  MapType,
+                     Uint32                    MapFlags,
+                     const Box*                pMapRegion,
+                     MappedTextureSubresource& MappedData)override final;
+    virtual void Unmap(IDeviceContext* pContext, Uint32 MipLevel, Uint32 ArraySlice)override final;
+
+    virtual void* GetNativeHandle()override final{ return m_pData; }
+
+    /// Computes the size of the tightly packed data of the region:
+    /// the size of one row of texel blocks, the number of block rows and the depth
+    void GetRegionSize(const Box& Region, Uint32& RowSize, Uint32& NumRows, Uint32& Depth)const;
+
+    /// Writes the data to the region of the subresource
+    void WriteRegion(Uint32 MipLevel, Uint32 Slice, const Box& Region, const void* pSrcData, Uint32 SrcStride, Uint32 SrcDepthStride);
+
+    /// Copies the region of the source texture subresource to this texture
+    void CopyRegion(TextureNullImpl& SrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box& SrcBox,
+                    Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ);
+
+private:
+    virtual void CreateViewInternal( const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView )override final;
+
+    struct MipLevelLayout
+    {
+        // Offset from the beginning of the array slice
+        size_t Offset  = 0;
+        Uint32 RowSize = 0;
+        Uint32 NumRows = 0;
+        Uint32 Depth   = 0;
+
+        size_t GetDepthSliceSize()const{ return size_t{RowSize} * size_t{NumRows}; }
+    };
+
+    Uint8* GetRegionAddress(Uint32 MipLevel, Uint32 Slice, Uint32 X, Uint32 Y, Uint32 Z);
+    void AllocateStorage();
+
+    std::vector<MipLevelLayout, STDAllocatorRawMem<MipLevelLayout> > m_MipLevels;
+    size_t m_ArraySliceSize = 0;
+    Uint32 m_NumArraySlices = 0;
+
+    Uint32 m_BlockWidth  = 1;
+    Uint32 m_BlockHeight = 1;
+    // Size of one texel or one compressed block, in bytes
+    Uint32 m_BlockSize   = 0;
+
+    Uint8* m_pData = nullptr;
+};
+
+}
@@ -0,0 +1,44 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Definition of the Engine Null attribs
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+    /// Attributes of the Null engine implementation
+    struct EngineNullAttribs : public EngineCreationAttribs
+    {
+        /// Size of the pages that device contexts allocate memory 
+        /// for dynamic buffers from, in bytes.
+        Uint32 DynamicHeapPageSize = 256 << 10;
+
+        /// Number of draw and dispatch commands after which the immediate
+        /// context executes its command stream.
+        Uint32 NumCommandsToFlush = 2048;
+    };
+}
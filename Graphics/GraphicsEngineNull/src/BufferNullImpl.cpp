@@ -0,0 +1,234 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "BufferNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "DeviceContextNullImpl.h"
+#include "GraphicsAccessories.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+BufferNullImpl :: BufferNullImpl(IReferenceCounters*        pRefCounters, 
+                                 FixedBlockMemoryAllocator& BuffViewObjMemAllocator, 
+                                 RenderDeviceNullImpl*      pDeviceNull, 
+                                 const BufferDesc&          BuffDesc, 
+                                 const BufferData&          BuffData,
+                                 bool                       bIsDeviceInternal) : 
+    TBufferBase(pRefCounters, BuffViewObjMemAllocator, pDeviceNull, BuffDesc, bIsDeviceInternal),
+#ifdef DEVELOPMENT
+    m_DvpMapType(1 + pDeviceNull->GetNumDeferredContexts()),
+#endif
+    m_DynamicAllocations(STD_ALLOCATOR_RAW_MEM(DynamicAllocationNull, GetRawAllocator(), "Allocator for vector<DynamicAllocationNull>"))
+{
+#define LOG_BUFFER_ERROR_AND_THROW(...) LOG_ERROR_AND_THROW("Buffer \"", BuffDesc.Name ? BuffDesc.Name : "", "\": ", ##__VA_ARGS__);
+
+    if( m_Desc.uiSizeInBytes == 0 )
+        LOG_BUFFER_ERROR_AND_THROW("Buffer size must not be zero")
+
+    if( m_Desc.Usage == USAGE_STATIC && BuffData.pData == nullptr )
+        LOG_BUFFER_ERROR_AND_THROW("Static buffer must be initialized with data at creation time")
+
+    if( m_Desc.Usage == USAGE_DYNAMIC && BuffData.pData != nullptr )
+        LOG_BUFFER_ERROR_AND_THROW("Dynamic buffer must be initialized via Map()")
+
+    if (m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
+    {
+        if (m_Desc.CPUAccessFlags != CPU_ACCESS_WRITE && m_Desc.CPUAccessFlags != CPU_ACCESS_READ)
+            LOG_BUFFER_ERROR_AND_THROW("Exactly one of the CPU_ACCESS_WRITE or CPU_ACCESS_READ flags must be specified for a cpu-accessible buffer")
+
+        if (m_Desc.CPUAccessFlags == CPU_ACCESS_WRITE)
+        {
+            if(BuffData.pData != nullptr )
+                LOG_BUFFER_ERROR_AND_THROW("CPU-writable staging buffers must be updated via map")
+        }
+    }
+#undef LOG_BUFFER_ERROR_AND_THROW
+
+    if (m_Desc.Usage == USAGE_DYNAMIC)
+    {
+        m_DynamicAllocations.resize(1 + pDeviceNull->GetNumDeferredContexts());
+    }
+    else
+    {
+        m_pData = reinterpret_cast<Uint8*>(ALLOCATE(GetRawAllocator(), "Memory for Null buffer data", m_Desc.uiSizeInBytes));
+        size_t InitDataSize = 0;
+        if (BuffData.pData != nullptr && BuffData.DataSize > 0)
+        {
+            InitDataSize = std::min(size_t{BuffData.DataSize}, size_t{m_Desc.uiSizeInBytes});
+            memcpy(m_pData, BuffData.pData, InitDataSize);
+        }
+        memset(m_pData + InitDataSize, 0, m_Desc.uiSizeInBytes - InitDataSize);
+    }
+}
+
+BufferNullImpl :: ~BufferNullImpl()
+{
+    if (m_pData != nullptr)
+        GetRawAllocator().Free(m_pData);
+}
+
+void BufferNullImpl::UpdateData( IDeviceContext* pContext, Uint32 Offset, Uint32 Size, const PVoid pData )
+{
+    TBufferBase::UpdateData( pContext, Offset, Size, pData );
+
+    auto* pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    pDeviceContextNull->UpdateBufferRegion(this, Offset, Size, pData);
+}
+
+void BufferNullImpl :: CopyData(IDeviceContext* pContext, IBuffer* pSrcBuffer, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size)
+{
+    TBufferBase::CopyData( pContext, pSrcBuffer, SrcOffset, DstOffset, Size );
+
+    auto* pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    pDeviceContextNull->CopyBufferRegion(ValidatedCast<BufferNullImpl>(pSrcBuffer), SrcOffset, this, DstOffset, Size);
+}
+
+void BufferNullImpl :: Map(IDeviceContext* pContext, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData)
+{
+    TBufferBase::Map( pContext, MapType, MapFlags, pMappedData );
+    pMappedData = nullptr;
+
+    auto* pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    auto CtxId = pDeviceContextNull->GetContextId();
+#ifdef DEVELOPMENT
+    m_DvpMapType[CtxId] = std::make_pair(MapType, MapFlags);
+#endif
+
+    if (m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
+    {
+        if (pDeviceContextNull->IsDeferred())
+        {
+            LOG_ERROR_MESSAGE("Failed to map buffer '", m_Desc.Name, "': cpu-accessible buffers can only be mapped by the immediate context");
+            return;
+        }
+
+        // Execute all pending commands that may read or write the buffer
+        if ((MapFlags & MAP_FLAG_DO_NOT_SYNCHRONIZE) == 0)
+            pDeviceContextNull->Flush();
+
+        pMappedData = m_pData;
+    }
+    else if (m_Desc.Usage == USAGE_DYNAMIC)
+    {
+        if (MapType != MAP_WRITE)
+        {
+            LOG_ERROR_MESSAGE("Failed to map buffer '", m_Desc.Name, "': dynamic buffers can only be mapped for writing");
+            return;
+        }
+
+#ifdef DEVELOPMENT
+        if( (MapFlags & (MAP_FLAG_DISCARD | MAP_FLAG_DO_NOT_SYNCHRONIZE)) == 0 )
+        {
+            LOG_ERROR_MESSAGE("Failed to map buffer '", m_Desc.Name, "': dynamic buffer must be mapped for writing with MAP_FLAG_DISCARD or MAP_FLAG_DO_NOT_SYNCHRONIZE flag. Context Id: ", CtxId);
+            return;
+        }
+#endif
+
+        auto& DynAllocation = m_DynamicAllocations[CtxId];
+        if ( (MapFlags & MAP_FLAG_DISCARD) != 0 || DynAllocation.pData == nullptr )
+        {
+            DynAllocation = pDeviceContextNull->AllocateDynamicSpace(m_Desc.uiSizeInBytes, 16);
+        }
+        else
+        {
+            VERIFY_EXPR(MapFlags & MAP_FLAG_DO_NOT_SYNCHRONIZE);
+            // Reuse the same allocation
+        }
+        pMappedData = DynAllocation.pData;
+    }
+    else
+    {
+        LOG_ERROR("Only USAGE_DYNAMIC and USAGE_CPU_ACCESSIBLE buffers can be mapped");
+    }
+}
+
+void BufferNullImpl::Unmap( IDeviceContext* pContext, MAP_TYPE MapType, Uint32 MapFlags )
+{
+    TBufferBase::Unmap( pContext, MapType, MapFlags );
+
+#ifdef DEVELOPMENT
+    auto* pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    auto CtxId = pDeviceContextNull->GetContextId();
+    if (m_DvpMapType[CtxId].first != MapType)
+    {
+        LOG_ERROR_MESSAGE("Failed to unmap buffer '", m_Desc.Name, "': Map type (", GetMapTypeString(MapType), ") does not match the type provided to Map() (", GetMapTypeString(m_DvpMapType[CtxId].first), "). Context Id: ", CtxId);
+        return;
+    }
+    if (m_DvpMapType[CtxId].second != MapFlags)
+    {
+        LOG_ERROR_MESSAGE("Failed to unmap buffer '", m_Desc.Name, "': Map flags (", MapFlags, ") do not match the flags provided to Map() (", m_DvpMapType[CtxId].second, "). Context Id: ", CtxId);
+        return;
+    }
+    m_DvpMapType[CtxId] = std::make_pair(static_cast<MAP_TYPE>(-1), static_cast<Uint32>(-1));
+#endif
+
+    // The data is written directly to the buffer storage or to the 
+    // dynamic allocation, so there is nothing to do
+}
+
+void BufferNullImpl::CreateViewInternal( const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView )
+{
+    VERIFY( ppView != nullptr, "Null pointer provided" );
+    if( !ppView )return;
+    VERIFY( *ppView == nullptr, "Overwriting reference to existing object may cause memory leaks" );
+
+    *ppView = nullptr;
+
+    try
+    {
+        auto& BuffViewAllocator = m_pDevice->GetBuffViewObjAllocator();
+        VERIFY( &BuffViewAllocator == &m_dbgBuffViewAllocator, "Buff view allocator does not match allocator provided at buffer initialization" );
+
+        BufferViewDesc ViewDesc = OrigViewDesc;
+        if( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS || ViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE )
+        {
+            CorrectBufferViewDesc( ViewDesc );
+            *ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewNullImpl instance", BufferViewNullImpl, bIsDefaultView ? this : nullptr)
+                                (GetDevice(), ViewDesc, this, bIsDefaultView );
+        }
+
+        if( !bIsDefaultView && *ppView )
+            (*ppView)->AddRef();
+    }
+    catch( const std::runtime_error & )
+    {
+        const auto *ViewTypeName = GetBufferViewTypeLiteralName(OrigViewDesc.ViewType);
+        LOG_ERROR("Failed to create view \"", OrigViewDesc.Name ? OrigViewDesc.Name : "", "\" (", ViewTypeName, ") for buffer \"", m_Desc.Name, "\"" );
+    }
+}
+
+#ifdef DEVELOPMENT
+void BufferNullImpl::DvpVerifyDynamicAllocation(DeviceContextNullImpl* pCtx)const
+{
+    auto ContextId = pCtx->GetContextId();
+    const auto& DynAlloc = m_DynamicAllocations[ContextId];
+    auto CurrentFrame = pCtx->GetContextFrameNumber();
+    DEV_CHECK_ERR(DynAlloc.pData != nullptr, "Dynamic buffer '", m_Desc.Name, "' has not been mapped before its first use. Context Id: ", ContextId, ". Note: memory for dynamic buffers is allocated when a buffer is mapped.");
+    DEV_CHECK_ERR(DynAlloc.dvpFrameNumber == CurrentFrame, "Dynamic allocation of dynamic buffer '", m_Desc.Name, "' in frame ", CurrentFrame, " is out-of-date. Note: contents of all dynamic resources is discarded at the end of every frame. A buffer must be mapped before its first use in any frame.");
+}
+#endif
+
+}
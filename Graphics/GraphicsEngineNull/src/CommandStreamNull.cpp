@@ -0,0 +1,81 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "CommandStreamNull.h"
+
+namespace Diligent
+{
+
+CommandStreamNull::CommandStreamNull(IMemoryAllocator& Allocator) :
+    m_Allocator (Allocator),
+    m_References(STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<IObject>, Allocator, "Allocator for vector<RefCntAutoPtr<IObject>>"))
+{
+}
+
+CommandStreamNull::CommandStreamNull(CommandStreamNull&& Stream) :
+    m_Allocator  (Stream.m_Allocator),
+    m_pData      (Stream.m_pData),
+    m_Size       (Stream.m_Size),
+    m_Capacity   (Stream.m_Capacity),
+    m_NumCommands(Stream.m_NumCommands),
+    m_References (std::move(Stream.m_References))
+{
+    Stream.m_pData       = nullptr;
+    Stream.m_Size        = 0;
+    Stream.m_Capacity    = 0;
+    Stream.m_NumCommands = 0;
+    Stream.m_References.clear();
+}
+
+CommandStreamNull::~CommandStreamNull()
+{
+    if (m_pData != nullptr)
+        m_Allocator.Free(m_pData);
+}
+
+void CommandStreamNull::Grow(size_t RequiredCapacity)
+{
+    auto NewCapacity = std::max(m_Capacity * 2, size_t{4096});
+    while (NewCapacity < RequiredCapacity)
+        NewCapacity *= 2;
+
+    auto* pNewData = reinterpret_cast<Uint8*>(m_Allocator.Allocate(NewCapacity, "Null command stream", __FILE__, __LINE__));
+    if (m_pData != nullptr)
+    {
+        // All commands are trivially copyable
+        memcpy(pNewData, m_pData, m_Size);
+        m_Allocator.Free(m_pData);
+    }
+    m_pData    = pNewData;
+    m_Capacity = NewCapacity;
+}
+
+void CommandStreamNull::Reset()
+{
+    m_Size        = 0;
+    m_NumCommands = 0;
+    m_References.clear();
+}
+
+}
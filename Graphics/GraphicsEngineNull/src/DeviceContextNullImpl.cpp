@@ -0,0 +1,638 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "DeviceContextNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "ShaderResourceBindingNullImpl.h"
+#include "CommandListNullImpl.h"
+#include "FenceNullImpl.h"
+#include "SwapChain.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+DeviceContextNullImpl::DeviceContextNullImpl(IReferenceCounters*      pRefCounters,
+                                             IMemoryAllocator&        Allocator,
+                                             RenderDeviceNullImpl*    pDevice,
+                                             const EngineNullAttribs& EngineAttribs,
+                                             bool                     bIsDeferred,
+                                             Uint32                   ContextId) :
+    TDeviceContextBase  (pRefCounters, pDevice, bIsDeferred),
+    m_CmdStream         (Allocator),
+    m_DynamicHeap       (Allocator, EngineAttribs.DynamicHeapPageSize),
+    m_ContextId         (ContextId),
+    m_NumCommandsToFlush(bIsDeferred ? 0 : EngineAttribs.NumCommandsToFlush),
+    m_CmdListAllocator  (GetRawAllocator(), sizeof(CommandListNullImpl), 64)
+{
+}
+
+DeviceContextNullImpl::~DeviceContextNullImpl()
+{
+    if (m_bIsDeferred)
+    {
+        if (!m_CmdStream.IsEmpty())
+            LOG_ERROR_MESSAGE("There are outstanding commands in deferred context #", m_ContextId, " being destroyed, which indicates that FinishCommandList() has not been called.");
+    }
+    else
+    {
+        Flush();
+    }
+}
+
+void DeviceContextNullImpl::SetPipelineState(IPipelineState* pPipelineState)
+{
+    auto* pPipelineStateNull = ValidatedCast<PipelineStateNullImpl>(pPipelineState);
+    // Vertex buffer strides are defined by the pipeline state
+    if (m_pPipelineState != pPipelineStateNull)
+        m_bCommittedVBsUpToDate = false;
+
+    TDeviceContextBase::SetPipelineState( pPipelineStateNull, 0 /*Dummy*/ );
+
+    auto& Cmd = m_CmdStream.AddCommand<SetPipelineStateCmdNull>();
+    Cmd.pPSO = pPipelineStateNull;
+}
+
+template<bool TransitionResources,
+         bool CommitResources>
+void DeviceContextNullImpl::TransitionAndCommitShaderResources(IPipelineState* pPSO, IShaderResourceBinding* pShaderResourceBinding)
+{
+    static_assert(TransitionResources || CommitResources, "At least one of TransitionResources or CommitResources flags is expected to be true");
+
+    auto* pPipelineStateNull = ValidatedCast<PipelineStateNullImpl>( pPSO );
+    auto* pShaderResBindingNull = ValidatedCast<ShaderResourceBindingNullImpl>(pShaderResourceBinding);
+    if (!pShaderResBindingNull)
+    {
+        pShaderResBindingNull = pPipelineStateNull->GetDefaultResourceBinding();
+    }
+#ifdef DEVELOPMENT
+    else
+    {
+        if (pPipelineStateNull->IsIncompatibleWith(pShaderResourceBinding->GetPipelineState()))
+        {
+            LOG_ERROR_MESSAGE("Shader resource binding does not match Pipeline State");
+            return;
+        }
+    }
+#endif
+
+    if (!pShaderResBindingNull->IsStaticResourcesBound())
+        pShaderResBindingNull->BindStaticShaderResources();
+
+    VERIFY(pShaderResBindingNull->GetNumActiveShaders() == pPipelineStateNull->GetNumShaders(), "Number of active shaders in shader resource binding is not consistent with the number of shaders in the pipeline state");
+
+#ifdef DEVELOPMENT
+    pShaderResBindingNull->dvpVerifyBindings();
+#endif
+
+    // There are no resource states to track in the Null back-end, so transition is a no-op
+    if (CommitResources)
+    {
+        auto NumResources = pShaderResBindingNull->GetTotalResourceCount();
+        auto& Cmd = m_CmdStream.AddCommand<CommitShaderResourcesCmdNull>(sizeof(IDeviceObject*) * NumResources);
+        Cmd.pSRB         = pShaderResBindingNull;
+        Cmd.NumResources = NumResources;
+        pShaderResBindingNull->CopyResourcePointers(reinterpret_cast<IDeviceObject**>(CommandStreamNull::GetPayload(Cmd)));
+    }
+}
+
+void DeviceContextNullImpl::TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding)
+{
+    TransitionAndCommitShaderResources<true, false>(pPipelineState, pShaderResourceBinding);
+}
+
+void DeviceContextNullImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, Uint32 Flags)
+{
+    if (!TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, Flags, 0 /*Dummy*/))
+        return;
+
+    if (Flags & COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES)
+        TransitionAndCommitShaderResources<true, true>(m_pPipelineState, pShaderResourceBinding);
+    else
+        TransitionAndCommitShaderResources<false, true>(m_pPipelineState, pShaderResourceBinding);
+}
+
+void DeviceContextNullImpl::SetStencilRef(Uint32 StencilRef)
+{
+    if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
+    {
+        auto& Cmd = m_CmdStream.AddCommand<SetStencilRefCmdNull>();
+        Cmd.StencilRef = m_StencilRef;
+    }
+}
+
+void DeviceContextNullImpl::SetBlendFactors(const float* pBlendFactors)
+{
+    if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
+    {
+        auto& Cmd = m_CmdStream.AddCommand<SetBlendFactorsCmdNull>();
+        for (Uint32 f = 0; f < 4; ++f)
+            Cmd.BlendFactors[f] = m_BlendFactors[f];
+    }
+}
+
+void DeviceContextNullImpl::SetVertexBuffers( Uint32 StartSlot, Uint32 NumBuffersSet, IBuffer **ppBuffers, Uint32* pOffsets, Uint32 Flags )
+{
+    TDeviceContextBase::SetVertexBuffers( StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags );
+    m_bCommittedVBsUpToDate = false;
+}
+
+void DeviceContextNullImpl::InvalidateState()
+{
+    TDeviceContextBase::InvalidateState();
+    m_bCommittedVBsUpToDate = false;
+    m_bCommittedIBUpToDate  = false;
+    m_CommittedIBFormat     = VT_UNDEFINED;
+}
+
+void DeviceContextNullImpl::SetIndexBuffer( IBuffer* pIndexBuffer, Uint32 ByteOffset )
+{
+    TDeviceContextBase::SetIndexBuffer( pIndexBuffer, ByteOffset );
+    m_bCommittedIBUpToDate = false;
+}
+
+void DeviceContextNullImpl::SetViewports( Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight )
+{
+    TDeviceContextBase::SetViewports( NumViewports, pViewports, RTWidth, RTHeight );
+
+    auto& Cmd = m_CmdStream.AddCommand<SetViewportsCmdNull>(sizeof(Viewport) * m_NumViewports);
+    Cmd.NumViewports = m_NumViewports;
+    auto* pDstViewports = reinterpret_cast<Viewport*>(CommandStreamNull::GetPayload(Cmd));
+    for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
+        pDstViewports[vp] = m_Viewports[vp];
+}
+
+void DeviceContextNullImpl::SetScissorRects( Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight )
+{
+    TDeviceContextBase::SetScissorRects( NumRects, pRects, RTWidth, RTHeight );
+
+    auto& Cmd = m_CmdStream.AddCommand<SetScissorRectsCmdNull>(sizeof(Rect) * m_NumScissorRects);
+    Cmd.NumRects = m_NumScissorRects;
+    auto* pDstRects = reinterpret_cast<Rect*>(CommandStreamNull::GetPayload(Cmd));
+    for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
+        pDstRects[sr] = m_ScissorRects[sr];
+}
+
+void DeviceContextNullImpl::CommitRenderTargets()
+{
+    VERIFY( m_NumBoundRenderTargets <= MaxRenderTargets, "Too many render targets are bound" );
+
+    auto& Cmd = m_CmdStream.AddCommand<SetRenderTargetsCmdNull>();
+    // Default framebuffer views are bound by the base class
+    Cmd.NumRenderTargets = std::min(m_NumBoundRenderTargets, Uint32{MaxRenderTargets});
+    for (Uint32 rt = 0; rt < Cmd.NumRenderTargets; ++rt)
+        Cmd.ppRTVs[rt] = m_pBoundRenderTargets[rt].RawPtr();
+    Cmd.pDSV = m_pBoundDepthStencil.RawPtr();
+}
+
+void DeviceContextNullImpl::ResetRenderTargets()
+{
+    TDeviceContextBase::ResetRenderTargets();
+    m_CmdStream.AddCommand<SetRenderTargetsCmdNull>();
+}
+
+void DeviceContextNullImpl::SetRenderTargets( Uint32 NumRenderTargets, ITextureView* ppRenderTargets[], ITextureView* pDepthStencil )
+{
+    if (TDeviceContextBase::SetRenderTargets( NumRenderTargets, ppRenderTargets, pDepthStencil ))
+    {
+        CommitRenderTargets();
+
+        // Set the viewport to match the render target size
+        SetViewports(1, nullptr, 0, 0);
+    }
+}
+
+void DeviceContextNullImpl::CommitIndexBuffer(VALUE_TYPE IndexType)
+{
+    if (!m_pIndexBuffer)
+    {
+        LOG_ERROR_MESSAGE( "Index buffer is not set up for indexed draw command" );
+        return;
+    }
+
+    if (IndexType != VT_UINT16 && IndexType != VT_UINT32)
+    {
+        LOG_ERROR_MESSAGE( "Unsupported index format. Only R16_UINT and R32_UINT are allowed." );
+        return;
+    }
+
+    auto& Cmd = m_CmdStream.AddCommand<SetIndexBufferCmdNull>();
+    Cmd.pBuffer   = m_pIndexBuffer.RawPtr();
+    Cmd.Offset    = m_IndexDataStartOffset;
+    Cmd.IndexType = IndexType;
+
+    m_CommittedIBFormat    = IndexType;
+    m_bCommittedIBUpToDate = true;
+}
+
+void DeviceContextNullImpl::CommitVertexBuffers(PipelineStateNullImpl* pPipelineStateNull)
+{
+    VERIFY( m_NumVertexStreams <= MaxBufferSlots, "Too many buffers are being set" );
+
+    auto& Cmd = m_CmdStream.AddCommand<SetVertexBuffersCmdNull>(sizeof(VertexStreamNull) * m_NumVertexStreams);
+    Cmd.NumStreams = m_NumVertexStreams;
+    auto* pStreams = reinterpret_cast<VertexStreamNull*>(CommandStreamNull::GetPayload(Cmd));
+    const auto* Strides = pPipelineStateNull->GetBufferStrides();
+    for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
+    {
+        auto& CurrStream = m_VertexStreams[Slot];
+        pStreams[Slot].pBuffer = CurrStream.pBuffer.RawPtr();
+        pStreams[Slot].Offset  = CurrStream.Offset;
+        pStreams[Slot].Stride  = Strides[Slot];
+    }
+
+    m_bCommittedVBsUpToDate = true;
+}
+
+void DeviceContextNullImpl::Draw( DrawAttribs &drawAttribs )
+{
+#ifdef DEVELOPMENT
+    if (!DvpVerifyDrawArguments(drawAttribs))
+        return;
+#endif
+
+    if (m_pPipelineState->GetNumBufferSlotsUsed() > 0 && !m_bCommittedVBsUpToDate)
+    {
+        VERIFY( m_NumVertexStreams >= m_pPipelineState->GetNumBufferSlotsUsed(), "Currently bound pipeline state \"", m_pPipelineState->GetDesc().Name, "\" expects ", m_pPipelineState->GetNumBufferSlotsUsed(), " input buffer slots, but only ", m_NumVertexStreams, " is bound");
+        CommitVertexBuffers(m_pPipelineState);
+    }
+
+    if (drawAttribs.IsIndexed)
+    {
+        if (m_CommittedIBFormat != drawAttribs.IndexType)
+            m_bCommittedIBUpToDate = false;
+        if (!m_bCommittedIBUpToDate)
+            CommitIndexBuffer(drawAttribs.IndexType);
+    }
+
+#ifdef DEVELOPMENT
+    for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
+    {
+        auto* pBufferNull = m_VertexStreams[Slot].pBuffer.RawPtr();
+        if (pBufferNull != nullptr && pBufferNull->GetDesc().Usage == USAGE_DYNAMIC)
+            pBufferNull->DvpVerifyDynamicAllocation(this);
+    }
+    if (drawAttribs.IsIndexed && m_pIndexBuffer && m_pIndexBuffer->GetDesc().Usage == USAGE_DYNAMIC)
+        m_pIndexBuffer->DvpVerifyDynamicAllocation(this);
+#endif
+
+    auto& Cmd = m_CmdStream.AddCommand<DrawCmdNull>();
+    Cmd.Attribs = drawAttribs;
+
+    if (++m_NumDrawCommands == m_NumCommandsToFlush)
+        Flush();
+}
+
+void DeviceContextNullImpl::DispatchCompute( const DispatchComputeAttribs &DispatchAttrs )
+{
+#ifdef DEVELOPMENT
+    if (!DvpVerifyDispatchArguments(DispatchAttrs))
+        return;
+#endif
+
+    auto& Cmd = m_CmdStream.AddCommand<DispatchComputeCmdNull>();
+    Cmd.Attribs = DispatchAttrs;
+
+    if (++m_NumDrawCommands == m_NumCommandsToFlush)
+        Flush();
+}
+
+void DeviceContextNullImpl::ClearDepthStencil( ITextureView* pView, Uint32 ClearFlags, float fDepth, Uint8 Stencil )
+{
+    if (pView == nullptr)
+    {
+        if (m_pSwapChain)
+        {
+            pView = m_pSwapChain->GetDepthBufferDSV();
+        }
+        else
+        {
+            LOG_ERROR("Failed to clear default depth stencil buffer: swap chain is not initialized in the device context");
+            return;
+        }
+    }
+
+#ifdef DEVELOPMENT
+    const auto& ViewDesc = pView->GetDesc();
+    VERIFY( ViewDesc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL, "Incorrect view type: depth stencil is expected" );
+#endif
+
+    // The clear is recorded, but not executed: the Null back-end does not rasterize
+    auto& Cmd = m_CmdStream.AddCommand<ClearDepthStencilCmdNull>();
+    Cmd.pDSV       = ValidatedCast<TextureViewNullImpl>(pView);
+    Cmd.ClearFlags = ClearFlags;
+    Cmd.Depth      = fDepth;
+    Cmd.Stencil    = Stencil;
+}
+
+void DeviceContextNullImpl::ClearRenderTarget( ITextureView* pView, const float *RGBA )
+{
+    if (pView == nullptr)
+    {
+        if (m_pSwapChain != nullptr)
+        {
+            pView = m_pSwapChain->GetCurrentBackBufferRTV();
+        }
+        else
+        {
+            LOG_ERROR("Failed to clear default render target: swap chain is not initialized in the device context");
+            return;
+        }
+    }
+
+#ifdef DEVELOPMENT
+    const auto& ViewDesc = pView->GetDesc();
+    VERIFY( ViewDesc.ViewType == TEXTURE_VIEW_RENDER_TARGET, "Incorrect view type: render target is expected" );
+#endif
+
+    auto& Cmd = m_CmdStream.AddCommand<ClearRenderTargetCmdNull>();
+    Cmd.pRTV = ValidatedCast<TextureViewNullImpl>(pView);
+    if (RGBA != nullptr)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            Cmd.Color[c] = RGBA[c];
+    }
+}
+
+void DeviceContextNullImpl::UpdateBufferRegion(BufferNullImpl* pBuffer, Uint32 Offset, Uint32 Size, const void* pData)
+{
+#ifdef DEVELOPMENT
+    if (pBuffer->GetDesc().Usage == USAGE_DYNAMIC)
+    {
+        LOG_ERROR("Dynamic buffers must be updated via Map()");
+        return;
+    }
+    if (Offset + Size > pBuffer->GetDesc().uiSizeInBytes)
+    {
+        LOG_ERROR("Update region is out of buffer bounds which will result in an undefined behavior");
+    }
+#endif
+
+    auto& Cmd = m_CmdStream.AddCommand<UpdateBufferCmdNull>(Size);
+    Cmd.pBuffer = pBuffer;
+    Cmd.Offset  = Offset;
+    Cmd.Size    = Size;
+    memcpy(CommandStreamNull::GetPayload(Cmd), pData, Size);
+    m_CmdStream.AddReference(pBuffer);
+}
+
+void DeviceContextNullImpl::CopyBufferRegion(BufferNullImpl* pSrcBuffer, Uint32 SrcOffset, BufferNullImpl* pDstBuffer, Uint32 DstOffset, Uint32 Size)
+{
+#ifdef DEVELOPMENT
+    if (pDstBuffer->GetDesc().Usage == USAGE_DYNAMIC)
+    {
+        LOG_ERROR("Dynamic buffers cannot be copy destinations");
+        return;
+    }
+#endif
+
+    // Contents of a dynamic buffer is only valid in the current frame,
+    // so the source data is copied to the command stream
+    const bool SnapshotSrcData = pSrcBuffer->GetDesc().Usage == USAGE_DYNAMIC;
+#ifdef DEVELOPMENT
+    if (SnapshotSrcData)
+        pSrcBuffer->DvpVerifyDynamicAllocation(this);
+#endif
+
+    auto& Cmd = m_CmdStream.AddCommand<CopyBufferCmdNull>(SnapshotSrcData ? Size : 0);
+    Cmd.SrcOffset  = SrcOffset;
+    Cmd.pDstBuffer = pDstBuffer;
+    Cmd.DstOffset  = DstOffset;
+    Cmd.Size       = Size;
+    if (SnapshotSrcData)
+    {
+        memcpy(CommandStreamNull::GetPayload(Cmd), pSrcBuffer->GetCPUAddress(m_ContextId) + SrcOffset, Size);
+    }
+    else
+    {
+        Cmd.pSrcBuffer = pSrcBuffer;
+        m_CmdStream.AddReference(pSrcBuffer);
+    }
+    m_CmdStream.AddReference(pDstBuffer);
+}
+
+void DeviceContextNullImpl::UpdateTextureRegion(const TextureSubResData& SubresData, TextureNullImpl& Texture, Uint32 MipLevel, Uint32 Slice, const Box& DstBox)
+{
+    auto* pSrcBufferNull = ValidatedCast<BufferNullImpl>(SubresData.pSrcBuffer);
+
+    Uint32 RowSize = 0, NumRows = 0, Depth = 0;
+    Texture.GetRegionSize(DstBox, RowSize, NumRows, Depth);
+
+    const Uint8* pSrcData = nullptr;
+    if (pSrcBufferNull == nullptr)
+    {
+        pSrcData = reinterpret_cast<const Uint8*>(SubresData.pData);
+    }
+    else if (pSrcBufferNull->GetDesc().Usage == USAGE_DYNAMIC)
+    {
+        // Contents of a dynamic buffer is only valid in the current frame
+#ifdef DEVELOPMENT
+        pSrcBufferNull->DvpVerifyDynamicAllocation(this);
+#endif
+        pSrcData = pSrcBufferNull->GetCPUAddress(m_ContextId) + SubresData.SrcOffset;
+    }
+
+    // CPU data is copied to the command stream as tightly packed rows
+    const size_t PayloadSize = pSrcData != nullptr ? size_t{RowSize} * NumRows * Depth : 0;
+    auto& Cmd = m_CmdStream.AddCommand<UpdateTextureCmdNull>(PayloadSize);
+    Cmd.pTexture = &Texture;
+    Cmd.MipLevel = MipLevel;
+    Cmd.Slice    = Slice;
+    Cmd.DstBox   = DstBox;
+    if (pSrcData != nullptr)
+    {
+        auto* pDstData = CommandStreamNull::GetPayload(Cmd);
+        for (Uint32 z = 0; z < Depth; ++z)
+        {
+            for (Uint32 row = 0; row < NumRows; ++row)
+            {
+                memcpy(pDstData + (size_t{z} * NumRows + row) * RowSize,
+                       pSrcData + size_t{z} * SubresData.DepthStride + size_t{row} * SubresData.Stride,
+                       RowSize);
+            }
+        }
+        Cmd.SrcStride      = RowSize;
+        Cmd.SrcDepthStride = RowSize * NumRows;
+    }
+    else
+    {
+        Cmd.pSrcBuffer     = pSrcBufferNull;
+        Cmd.SrcOffset      = SubresData.SrcOffset;
+        Cmd.SrcStride      = SubresData.Stride;
+        Cmd.SrcDepthStride = SubresData.DepthStride;
+        m_CmdStream.AddReference(pSrcBufferNull);
+    }
+    m_CmdStream.AddReference(&Texture);
+}
+
+void DeviceContextNullImpl::CopyTextureRegion(TextureNullImpl* pSrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box& SrcBox,
+                                              TextureNullImpl* pDstTexture, Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ)
+{
+    auto& Cmd = m_CmdStream.AddCommand<CopyTextureCmdNull>();
+    Cmd.pSrcTexture = pSrcTexture;
+    Cmd.SrcMipLevel = SrcMipLevel;
+    Cmd.SrcSlice    = SrcSlice;
+    Cmd.SrcBox      = SrcBox;
+    Cmd.pDstTexture = pDstTexture;
+    Cmd.DstMipLevel = DstMipLevel;
+    Cmd.DstSlice    = DstSlice;
+    Cmd.DstX        = DstX;
+    Cmd.DstY        = DstY;
+    Cmd.DstZ        = DstZ;
+    m_CmdStream.AddReference(pSrcTexture);
+    m_CmdStream.AddReference(pDstTexture);
+}
+
+void DeviceContextNullImpl::GenerateMips(TextureViewNullImpl& TexView)
+{
+    // Mip generation is recorded, but the contents of the mip levels is not computed
+    auto& Cmd = m_CmdStream.AddCommand<GenerateMipsCmdNull>();
+    Cmd.pTexView = &TexView;
+}
+
+DynamicAllocationNull DeviceContextNullImpl::AllocateDynamicSpace(size_t NumBytes, size_t Alignment)
+{
+    auto DynAlloc = m_DynamicHeap.Allocate(NumBytes, Alignment);
+#ifdef DEVELOPMENT
+    DynAlloc.dvpFrameNumber = m_ContextFrameNumber;
+#endif
+    return DynAlloc;
+}
+
+void DeviceContextNullImpl::ExecuteCommands(const CommandStreamNull& CmdStream)
+{
+    CmdStream.ProcessCommands(
+        [this](CommandTypeNull Type, const void* pCommand)
+        {
+            switch (Type)
+            {
+                case CommandTypeNull::UpdateBuffer:
+                {
+                    const auto& Cmd = *reinterpret_cast<const UpdateBufferCmdNull*>(pCommand);
+                    memcpy(Cmd.pBuffer->GetCPUAddress(m_ContextId) + Cmd.Offset, CommandStreamNull::GetPayload(Cmd), Cmd.Size);
+                    break;
+                }
+
+                case CommandTypeNull::CopyBuffer:
+                {
+                    const auto& Cmd = *reinterpret_cast<const CopyBufferCmdNull*>(pCommand);
+                    const auto* pSrcData = Cmd.pSrcBuffer != nullptr ?
+                        Cmd.pSrcBuffer->GetCPUAddress(m_ContextId) + Cmd.SrcOffset :
+                        CommandStreamNull::GetPayload(Cmd);
+                    // Source and destination regions may overlap
+                    memmove(Cmd.pDstBuffer->GetCPUAddress(m_ContextId) + Cmd.DstOffset, pSrcData, Cmd.Size);
+                    break;
+                }
+
+                case CommandTypeNull::UpdateTexture:
+                {
+                    const auto& Cmd = *reinterpret_cast<const UpdateTextureCmdNull*>(pCommand);
+                    const auto* pSrcData = Cmd.pSrcBuffer != nullptr ?
+                        Cmd.pSrcBuffer->GetCPUAddress(m_ContextId) + Cmd.SrcOffset :
+                        CommandStreamNull::GetPayload(Cmd);
+                    Cmd.pTexture->WriteRegion(Cmd.MipLevel, Cmd.Slice, Cmd.DstBox, pSrcData, Cmd.SrcStride, Cmd.SrcDepthStride);
+                    break;
+                }
+
+                case CommandTypeNull::CopyTexture:
+                {
+                    const auto& Cmd = *reinterpret_cast<const CopyTextureCmdNull*>(pCommand);
+                    Cmd.pDstTexture->CopyRegion(*Cmd.pSrcTexture, Cmd.SrcMipLevel, Cmd.SrcSlice, Cmd.SrcBox,
+                                                Cmd.DstMipLevel, Cmd.DstSlice, Cmd.DstX, Cmd.DstY, Cmd.DstZ);
+                    break;
+                }
+
+                default:
+                    // State, draw, dispatch and clear commands have no effect on resource contents
+                    break;
+            }
+        }
+    );
+}
+
+void DeviceContextNullImpl::Flush()
+{
+    if (m_bIsDeferred)
+    {
+        LOG_ERROR_MESSAGE("Flush() should only be called for immediate contexts");
+        return;
+    }
+
+    ExecuteCommands(m_CmdStream);
+    m_CmdStream.Reset();
+    m_NumDrawCommands = 0;
+
+    // All commands preceding the signals have now been executed
+    for (auto& Fence : m_PendingFences)
+        Fence.first->SetCompletedValue(Fence.second);
+    m_PendingFences.clear();
+}
+
+void DeviceContextNullImpl::FinishFrame()
+{
+    // Command streams never reference dynamic heap memory, so all pages 
+    // can be recycled without waiting for the recorded commands
+    m_DynamicHeap.ReleaseAllocatedPages();
+    ++m_ContextFrameNumber;
+}
+
+void DeviceContextNullImpl::FinishCommandList(ICommandList **ppCommandList)
+{
+    VERIFY(m_bIsDeferred, "Only deferred context can record command list");
+
+    auto* pDeviceNull = m_pDevice.RawPtr<RenderDeviceNullImpl>();
+    CommandListNullImpl* pCmdListNull( NEW_RC_OBJ(m_CmdListAllocator, "CommandListNullImpl instance", CommandListNullImpl)(pDeviceNull, std::move(m_CmdStream)) );
+    pCmdListNull->QueryInterface( IID_CommandList, reinterpret_cast<IObject**>(ppCommandList) );
+
+    m_NumDrawCommands = 0;
+
+    // Device context is now in default state
+    InvalidateState();
+}
+
+void DeviceContextNullImpl::ExecuteCommandList(ICommandList* pCommandList)
+{
+    if (m_bIsDeferred)
+    {
+        LOG_ERROR("Only immediate context can execute command list");
+        return;
+    }
+
+    // Execute the commands recorded by this context first to preserve the order
+    Flush();
+
+    auto* pCmdListNull = ValidatedCast<CommandListNullImpl>(pCommandList);
+    ExecuteCommands(pCmdListNull->GetCommandStream());
+
+    // Device context is now in default state
+    InvalidateState();
+}
+
+void DeviceContextNullImpl::SignalFence(IFence* pFence, Uint64 Value)
+{
+    VERIFY(!m_bIsDeferred, "Fence can only be signalled from immediate context");
+    m_PendingFences.emplace_back(RefCntAutoPtr<FenceNullImpl>(ValidatedCast<FenceNullImpl>(pFence)), Value);
+}
+
+}
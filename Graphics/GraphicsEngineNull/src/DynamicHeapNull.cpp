@@ -0,0 +1,108 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "DynamicHeapNull.h"
+#include "Align.h"
+
+namespace Diligent
+{
+
+DynamicHeapNull::DynamicHeapNull(IMemoryAllocator& Allocator, size_t PageSize) :
+    m_Allocator     (Allocator),
+    m_PageSize      (PageSize),
+    m_UsedPages     (STD_ALLOCATOR_RAW_MEM(Page, Allocator, "Allocator for vector<Page>")),
+    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(Page, Allocator, "Allocator for vector<Page>"))
+{
+    VERIFY_EXPR(m_PageSize > 0);
+}
+
+DynamicHeapNull::~DynamicHeapNull()
+{
+    ReleaseAllocatedPages();
+    for (auto& Page : m_AvailablePages)
+        m_Allocator.Free(Page.pData);
+    if (m_PeakAllocatedSize > 0)
+        LOG_INFO_MESSAGE("Dynamic heap: peak allocated size: ", m_PeakAllocatedSize, " bytes");
+}
+
+DynamicHeapNull::Page DynamicHeapNull::CreatePage(size_t Size)
+{
+    Page NewPage;
+    NewPage.pData = reinterpret_cast<Uint8*>(m_Allocator.Allocate(Size, "Dynamic heap page", __FILE__, __LINE__));
+    NewPage.Size  = Size;
+    return NewPage;
+}
+
+DynamicAllocationNull DynamicHeapNull::Allocate(size_t SizeInBytes, size_t Alignment)
+{
+    VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+    VERIFY(Alignment <= 16, "Alignment (", Alignment, ") exceeds the alignment of the raw allocator");
+    SizeInBytes = Align(SizeInBytes, Alignment);
+
+    m_AllocatedSize += SizeInBytes;
+    m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_AllocatedSize);
+
+    if (SizeInBytes > m_PageSize)
+    {
+        // Dedicated page is inserted before the current one so that
+        // the current page can still be used for small allocations
+        auto DedicatedPage = CreatePage(SizeInBytes);
+        m_UsedPages.insert(m_UsedPages.empty() ? m_UsedPages.end() : m_UsedPages.end()-1, DedicatedPage);
+        return DynamicAllocationNull{DedicatedPage.pData, SizeInBytes};
+    }
+
+    auto Offset = Align(m_CurrOffset, Alignment);
+    if (m_UsedPages.empty() || m_UsedPages.back().Size != m_PageSize || Offset + SizeInBytes > m_PageSize)
+    {
+        if (!m_AvailablePages.empty())
+        {
+            m_UsedPages.push_back(m_AvailablePages.back());
+            m_AvailablePages.pop_back();
+        }
+        else
+        {
+            m_UsedPages.push_back(CreatePage(m_PageSize));
+        }
+        Offset = 0;
+    }
+
+    m_CurrOffset = Offset + SizeInBytes;
+    return DynamicAllocationNull{m_UsedPages.back().pData + Offset, SizeInBytes};
+}
+
+void DynamicHeapNull::ReleaseAllocatedPages()
+{
+    for (auto& Page : m_UsedPages)
+    {
+        if (Page.Size == m_PageSize)
+            m_AvailablePages.push_back(Page);
+        else
+            m_Allocator.Free(Page.pData);
+    }
+    m_UsedPages.clear();
+    m_CurrOffset = 0;
+    m_AllocatedSize = 0;
+}
+
+}
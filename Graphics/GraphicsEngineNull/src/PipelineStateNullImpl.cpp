@@ -0,0 +1,133 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "PipelineStateNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "ShaderResourceBindingNullImpl.h"
+#include "GraphicsAccessories.h"
+#include "HashUtils.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+PipelineStateNullImpl::PipelineStateNullImpl(IReferenceCounters*      pRefCounters,
+                                             RenderDeviceNullImpl*    pDeviceNull,
+                                             const PipelineStateDesc& PipelineDesc,
+                                             bool                     bIsDeviceInternal) : 
+    TPipelineStateBase(pRefCounters, pDeviceNull, PipelineDesc, bIsDeviceInternal),
+    m_pDefaultShaderResBinding( nullptr, STDDeleter<ShaderResourceBindingNullImpl, FixedBlockMemoryAllocator>(pDeviceNull->GetSRBAllocator()) )
+{
+    if (PipelineDesc.IsComputePipeline)
+    {
+        auto* pCS = ValidatedCast<ShaderNullImpl>(PipelineDesc.ComputePipeline.pCS);
+        m_pCS = pCS;
+        if (m_pCS == nullptr)
+        {
+            LOG_ERROR_AND_THROW("Compute shader is null");
+        }
+
+        if (m_pCS && m_pCS->GetDesc().ShaderType != SHADER_TYPE_COMPUTE)
+        {
+            LOG_ERROR_AND_THROW(GetShaderTypeLiteralName(SHADER_TYPE_COMPUTE), " shader is expeceted while ", GetShaderTypeLiteralName(m_pCS->GetDesc().ShaderType), " provided");
+        }
+        m_ShaderResourceLayoutHash = pCS->GetResourceLayoutHash();
+    }
+    else
+    {
+
+#define INIT_SHADER(ShortName, ExpectedType)\
+        {                                   \
+            auto* pShader = ValidatedCast<ShaderNullImpl>(PipelineDesc.GraphicsPipeline.p##ShortName); \
+            m_p##ShortName = pShader;  \
+            if (m_p##ShortName && m_p##ShortName->GetDesc().ShaderType != ExpectedType)   \
+            {   \
+                LOG_ERROR_AND_THROW( GetShaderTypeLiteralName(ExpectedType), " shader is expeceted while ", GetShaderTypeLiteralName(m_p##ShortName->GetDesc().ShaderType)," provided" );   \
+            }   \
+            if(pShader!=nullptr)    \
+                HashCombine(m_ShaderResourceLayoutHash, pShader->GetResourceLayoutHash() );   \
+        }
+
+        INIT_SHADER(VS, SHADER_TYPE_VERTEX);
+        INIT_SHADER(PS, SHADER_TYPE_PIXEL);
+        INIT_SHADER(GS, SHADER_TYPE_GEOMETRY);
+        INIT_SHADER(DS, SHADER_TYPE_DOMAIN);
+        INIT_SHADER(HS, SHADER_TYPE_HULL);
+#undef INIT_SHADER
+
+        if (m_pVS == nullptr)
+        {
+            LOG_ERROR_AND_THROW("Vertex shader is null");
+        }
+    }
+
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+    {
+        if (GetShader<const ShaderNullImpl>(s)->GetDesc().NumVariables != 0)
+            m_HasShaderResources = true;
+    }
+
+    auto &SRBAllocator = pDeviceNull->GetSRBAllocator();
+    m_pDefaultShaderResBinding.reset( NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingNullImpl instance", ShaderResourceBindingNullImpl, this)(this, true) );
+}
+
+PipelineStateNullImpl::~PipelineStateNullImpl()
+{
+}
+
+void PipelineStateNullImpl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding)
+{
+    auto &SRBAllocator = m_pDevice->GetSRBAllocator();
+    auto pShaderResBinding = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingNullImpl instance", ShaderResourceBindingNullImpl)(this, false);
+    pShaderResBinding->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(static_cast<IShaderResourceBinding**>(ppShaderResourceBinding)));
+}
+
+bool PipelineStateNullImpl::IsCompatibleWith(const IPipelineState* pPSO)const
+{
+    VERIFY_EXPR(pPSO != nullptr);
+
+    if (pPSO == this)
+        return true;
+    
+    const PipelineStateNullImpl* pPSONull = ValidatedCast<const PipelineStateNullImpl>(pPSO);
+    if (m_ShaderResourceLayoutHash != pPSONull->m_ShaderResourceLayoutHash)
+        return false;
+
+    if (m_NumShaders != pPSONull->m_NumShaders)
+        return false;
+
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+    {
+        auto* pShader0 = GetShader<const ShaderNullImpl>(s);
+        auto* pShader1 = pPSONull->GetShader<const ShaderNullImpl>(s);
+        if (pShader0->GetShaderTypeIndex() != pShader1->GetShaderTypeIndex())
+            return false;
+        if (!pShader0->IsCompatibleWith(*pShader1))
+            return false;
+    }
+    
+    return true;
+}
+
+}
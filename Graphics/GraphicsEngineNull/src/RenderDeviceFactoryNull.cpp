@@ -0,0 +1,187 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+/// \file
+/// Routines that initialize Null engine implementation
+
+#include "pch.h"
+#include "RenderDeviceFactoryNull.h"
+#include "RenderDeviceNullImpl.h"
+#include "DeviceContextNullImpl.h"
+#include "SwapChainNullImpl.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+/// Engine factory for Null implementation
+class EngineFactoryNullImpl : public IEngineFactoryNull
+{
+public:
+    static EngineFactoryNullImpl* GetInstance()
+    {
+        static EngineFactoryNullImpl TheFactory;
+        return &TheFactory;
+    }
+
+    void CreateDeviceAndContextsNull( const EngineNullAttribs& EngineAttribs, 
+                                      IRenderDevice**          ppDevice, 
+                                      IDeviceContext**         ppContexts,
+                                      Uint32                   NumDeferredContexts )override final;
+
+    void CreateSwapChainNull( IRenderDevice*       pDevice, 
+                              IDeviceContext*      pImmediateContext, 
+                              const SwapChainDesc& SCDesc, 
+                              ISwapChain**         ppSwapChain )override final;
+};
+
+/// Creates render device and device contexts for Null backend
+
+/// \param [in] EngineAttribs - Engine creation attributes.
+/// \param [out] ppDevice - Address of the memory location where pointer to 
+///                         the created device will be written
+/// \param [out] ppContexts - Address of the memory location where pointers to 
+///                           the contexts will be written. The new immediate 
+///                           context goes at position 0. If NumDeferredContexts > 0,
+///                           pointers to the deferred contexts are written afterwards.
+/// \param [in] NumDeferredContexts - Number of deferred contexts. If non-zero number
+///                                   of deferred contexts is requested, pointers to the
+///                                   contexts are written to ppContexts array starting 
+///                                   at position 1
+void EngineFactoryNullImpl::CreateDeviceAndContextsNull( const EngineNullAttribs& EngineAttribs, 
+                                                         IRenderDevice**          ppDevice, 
+                                                         IDeviceContext**         ppContexts,
+                                                         Uint32                   NumDeferredContexts )
+{
+    VERIFY( ppDevice && ppContexts, "Null pointer provided" );
+    if( !ppDevice || !ppContexts )
+        return;
+
+    SetRawAllocator(EngineAttribs.pRawMemAllocator);
+
+    *ppDevice = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1 + NumDeferredContexts));
+
+    try
+    {
+        auto &RawMemAllocator = GetRawAllocator();
+        RenderDeviceNullImpl *pRenderDeviceNull( NEW_RC_OBJ(RawMemAllocator, "RenderDeviceNullImpl instance", RenderDeviceNullImpl)(RawMemAllocator, EngineAttribs, NumDeferredContexts ) );
+        pRenderDeviceNull->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice) );
+
+        RefCntAutoPtr<DeviceContextNullImpl> pImmediateCtxNull( NEW_RC_OBJ(RawMemAllocator, "DeviceContextNullImpl instance", DeviceContextNullImpl)(RawMemAllocator, pRenderDeviceNull, EngineAttribs, false, 0) );
+        // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceNull will
+        // keep a weak reference to the context
+        pImmediateCtxNull->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts) );
+        pRenderDeviceNull->SetImmediateContext(pImmediateCtxNull);
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
+        {
+            RefCntAutoPtr<DeviceContextNullImpl> pDeferredCtxNull( NEW_RC_OBJ(RawMemAllocator, "DeviceContextNullImpl instance", DeviceContextNullImpl)(RawMemAllocator, pRenderDeviceNull, EngineAttribs, true, 1+DeferredCtx) );
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceNull will
+            // keep a weak reference to the context
+            pDeferredCtxNull->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx) );
+            pRenderDeviceNull->SetDeferredContext(DeferredCtx, pDeferredCtxNull);
+        }
+    }
+    catch( const std::runtime_error & )
+    {
+        if( *ppDevice )
+        {
+            (*ppDevice)->Release();
+            *ppDevice = nullptr;
+        }
+        for(Uint32 ctx=0; ctx < 1 + NumDeferredContexts; ++ctx)
+        {
+            if( ppContexts[ctx] != nullptr )
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
+        }
+
+        LOG_ERROR( "Failed to create device and contexts" );
+    }
+}
+
+/// Creates a swap chain for Null engine implementation
+
+/// \param [in] pDevice - Pointer to the render device
+/// \param [in] pImmediateContext - Pointer to the immediate device context
+/// \param [in] SCDesc - Swap chain description. Width and height must not be zero, 
+///                      as there is no window to query the size from.
+/// \param [out] ppSwapChain    - Address of the memory location where pointer to the new 
+///                               swap chain will be written
+void EngineFactoryNullImpl::CreateSwapChainNull( IRenderDevice*       pDevice, 
+                                                 IDeviceContext*      pImmediateContext, 
+                                                 const SwapChainDesc& SCDesc, 
+                                                 ISwapChain**         ppSwapChain )
+{
+    VERIFY( ppSwapChain, "Null pointer provided" );
+    if( !ppSwapChain )
+        return;
+
+    *ppSwapChain = nullptr;
+
+    try
+    {
+        auto *pDeviceNull = ValidatedCast<RenderDeviceNullImpl>( pDevice );
+        auto *pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pImmediateContext);
+        auto &RawMemAllocator = GetRawAllocator();
+        auto *pSwapChainNull = NEW_RC_OBJ(RawMemAllocator, "SwapChainNullImpl instance", SwapChainNullImpl)(SCDesc, pDeviceNull, pDeviceContextNull);
+        pSwapChainNull->QueryInterface( IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain) );
+
+        pDeviceContextNull->SetSwapChain(pSwapChainNull);
+        // Bind default render target
+        pDeviceContextNull->SetRenderTargets( 0, nullptr, nullptr );
+        // Set default viewport
+        pDeviceContextNull->SetViewports( 1, nullptr, 0, 0 );
+        
+        auto NumDeferredCtx = pDeviceNull->GetNumDeferredContexts();
+        for (size_t ctx = 0; ctx < NumDeferredCtx; ++ctx)
+        {
+            if (auto pDeferredCtx = pDeviceNull->GetDeferredContext(ctx))
+            {
+                auto *pDeferredCtxNull = pDeferredCtx.RawPtr<DeviceContextNullImpl>();
+                pDeferredCtxNull->SetSwapChain(pSwapChainNull);
+            }
+        }
+    }
+    catch( const std::runtime_error & )
+    {
+        if( *ppSwapChain )
+        {
+            (*ppSwapChain)->Release();
+            *ppSwapChain = nullptr;
+        }
+
+        LOG_ERROR( "Failed to create the swap chain" );
+    }
+}
+
+
+IEngineFactoryNull* GetEngineFactoryNull()
+{
+    return EngineFactoryNullImpl::GetInstance();
+}
+
+}
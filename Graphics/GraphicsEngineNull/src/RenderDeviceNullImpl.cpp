@@ -0,0 +1,175 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "RenderDeviceNullImpl.h"
+#include "DeviceContextNullImpl.h"
+#include "BufferNullImpl.h"
+#include "ShaderNullImpl.h"
+#include "TextureNullImpl.h"
+#include "SamplerNullImpl.h"
+#include "TextureViewNullImpl.h"
+#include "PipelineStateNullImpl.h"
+#include "ShaderResourceBindingNullImpl.h"
+#include "FenceNullImpl.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+RenderDeviceNullImpl :: RenderDeviceNullImpl(IReferenceCounters*      pRefCounters,
+                                             IMemoryAllocator&        RawMemAllocator,
+                                             const EngineNullAttribs& EngineAttribs,
+                                             Uint32                   NumDeferredContexts) : 
+    TRenderDeviceBase
+    {
+        pRefCounters,
+        RawMemAllocator,
+        NumDeferredContexts,
+        sizeof(TextureNullImpl),
+        sizeof(TextureViewNullImpl),
+        sizeof(BufferNullImpl),
+        sizeof(BufferViewNullImpl),
+        sizeof(ShaderNullImpl),
+        sizeof(SamplerNullImpl),
+        sizeof(PipelineStateNullImpl),
+        sizeof(ShaderResourceBindingNullImpl),
+        sizeof(FenceNullImpl)
+    },
+    m_EngineAttribs(EngineAttribs)
+{
+    m_DeviceCaps.DevType = DeviceType::Null;
+    m_DeviceCaps.MajorVersion = 1;
+    m_DeviceCaps.MinorVersion = 0;
+    m_DeviceCaps.bSeparableProgramSupported = True;
+    m_DeviceCaps.bMultithreadedResourceCreationSupported = True;
+    // There is no hardware to query, so all formats are reported as supported
+    for(int fmt = 1; fmt < m_TextureFormatsInfo.size(); ++fmt)
+        m_TextureFormatsInfo[fmt].Supported = true;
+}
+
+void RenderDeviceNullImpl::TestTextureFormat( TEXTURE_FORMAT TexFormat )
+{
+    auto &TexFormatInfo = m_TextureFormatsInfo[TexFormat];
+    VERIFY( TexFormatInfo.Supported, "Texture format is not supported" );
+
+    const bool IsDepthFormat = TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH || 
+                               TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
+    const bool IsCompressedFormat = TexFormatInfo.ComponentType == COMPONENT_TYPE_COMPRESSED;
+
+    TexFormatInfo.ColorRenderable = !IsDepthFormat && !IsCompressedFormat;
+    TexFormatInfo.DepthRenderable = IsDepthFormat;
+    TexFormatInfo.Tex1DFmt        = !IsCompressedFormat;
+    TexFormatInfo.Tex2DFmt        = true;
+    TexFormatInfo.Tex3DFmt        = !IsDepthFormat;
+    TexFormatInfo.TexCubeFmt      = true;
+    TexFormatInfo.SampleCounts    = IsCompressedFormat ? 0x01 : 0x0F;
+}
+
+void RenderDeviceNullImpl :: CreateBuffer(const BufferDesc& BuffDesc, const BufferData& BuffData, IBuffer** ppBuffer)
+{
+    CreateDeviceObject("buffer", BuffDesc, ppBuffer, 
+        [&]()
+        {
+            BufferNullImpl* pBufferNull( NEW_RC_OBJ(m_BufObjAllocator, "BufferNullImpl instance", BufferNullImpl)
+                                                   (m_BuffViewObjAllocator, this, BuffDesc, BuffData ) );
+            pBufferNull->QueryInterface( IID_Buffer, reinterpret_cast<IObject**>(ppBuffer) );
+            pBufferNull->CreateDefaultViews();
+            OnCreateDeviceObject( pBufferNull );
+        } 
+    );
+}
+
+void RenderDeviceNullImpl :: CreateShader(const ShaderCreationAttribs& ShaderCreationAttribs, IShader** ppShader)
+{
+    CreateDeviceObject( "shader", ShaderCreationAttribs.Desc, ppShader, 
+        [&]()
+        {
+            ShaderNullImpl* pShaderNull( NEW_RC_OBJ(m_ShaderObjAllocator, "ShaderNullImpl instance", ShaderNullImpl)
+                                                   (this, ShaderCreationAttribs ) );
+            pShaderNull->QueryInterface( IID_Shader, reinterpret_cast<IObject**>(ppShader) );
+
+            OnCreateDeviceObject( pShaderNull );
+        } 
+    );
+}
+
+void RenderDeviceNullImpl :: CreateTexture(const TextureDesc& TexDesc, const TextureData& Data, ITexture** ppTexture)
+{
+    CreateDeviceObject( "texture", TexDesc, ppTexture, 
+        [&]()
+        {
+            TextureNullImpl* pTextureNull = NEW_RC_OBJ(m_TexObjAllocator, "TextureNullImpl instance", TextureNullImpl)
+                                                      (m_TexViewObjAllocator, this, TexDesc, Data );
+            pTextureNull->QueryInterface( IID_Texture, reinterpret_cast<IObject**>(ppTexture) );
+            pTextureNull->CreateDefaultViews();
+            OnCreateDeviceObject( pTextureNull );
+        } 
+    );
+}
+
+void RenderDeviceNullImpl :: CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler)
+{
+    CreateDeviceObject( "sampler", SamplerDesc, ppSampler, 
+        [&]()
+        {
+            m_SamplersRegistry.Find( SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler) );
+            if(* ppSampler == nullptr )
+            {
+                SamplerNullImpl* pSamplerNull( NEW_RC_OBJ(m_SamplerObjAllocator, "SamplerNullImpl instance",  SamplerNullImpl)
+                                                         (this, SamplerDesc ) );
+                pSamplerNull->QueryInterface( IID_Sampler, reinterpret_cast<IObject**>(ppSampler) );
+                OnCreateDeviceObject( pSamplerNull );
+                m_SamplersRegistry.Add( SamplerDesc,* ppSampler );
+            }
+        }
+    );
+}
+
+void RenderDeviceNullImpl::CreatePipelineState(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)
+{
+    CreateDeviceObject( "Pipeline state", PipelineDesc, ppPipelineState, 
+        [&]()
+        {
+            PipelineStateNullImpl* pPipelineStateNull( NEW_RC_OBJ(m_PSOAllocator, "PipelineStateNullImpl instance", PipelineStateNullImpl)
+                                                                 (this, PipelineDesc ) );
+            pPipelineStateNull->QueryInterface( IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState) );
+            OnCreateDeviceObject( pPipelineStateNull );
+        } 
+    );
+}
+
+void RenderDeviceNullImpl::CreateFence(const FenceDesc& Desc, IFence** ppFence)
+{
+    CreateDeviceObject( "Fence", Desc, ppFence, 
+        [&]()
+        {
+            FenceNullImpl* pFenceNull( NEW_RC_OBJ(m_FenceAllocator, "FenceNullImpl instance", FenceNullImpl)
+                                                 (this, Desc) );
+            pFenceNull->QueryInterface( IID_Fence, reinterpret_cast<IObject**>(ppFence) );
+            OnCreateDeviceObject( pFenceNull );
+        }
+    );
+}
+
+}
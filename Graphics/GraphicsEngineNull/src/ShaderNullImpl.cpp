@@ -0,0 +1,95 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "FileStream.h"
+#include "HashUtils.h"
+
+namespace Diligent
+{
+
+ShaderNullImpl::ShaderNullImpl(IReferenceCounters*          pRefCounters,
+                               RenderDeviceNullImpl*        pDeviceNull,
+                               const ShaderCreationAttribs& CreationAttribs,
+                               bool                         bIsDeviceInternal) : 
+    TShaderBase(pRefCounters, pDeviceNull, CreationAttribs.Desc, bIsDeviceInternal),
+    m_StaticResCache (GetRawAllocator()),
+    m_StaticResLayout(*this, GetRawAllocator()),
+    m_ShaderTypeIndex(Diligent::GetShaderTypeIndex(CreationAttribs.Desc.ShaderType))
+{
+    if (CreationAttribs.Source != nullptr)
+    {
+        VERIFY(CreationAttribs.FilePath == nullptr, "'FilePath' is expected to be null when shader source code is provided");
+    }
+    else if (CreationAttribs.FilePath != nullptr)
+    {
+        VERIFY(CreationAttribs.pShaderSourceStreamFactory, "Input stream factory is null");
+        RefCntAutoPtr<IFileStream> pSourceStream;
+        CreationAttribs.pShaderSourceStreamFactory->CreateInputStream(CreationAttribs.FilePath, &pSourceStream);
+        if (pSourceStream == nullptr)
+            LOG_ERROR_AND_THROW("Failed to open shader source file");
+    }
+    else if (CreationAttribs.ByteCode == nullptr || CreationAttribs.ByteCodeSize == 0)
+    {
+        LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
+    }
+
+    for (Uint32 v = 0; v < m_Desc.NumVariables; ++v)
+    {
+        const auto& VarDesc = m_Desc.VariableDesc[v];
+        for (Uint32 prev = 0; prev < v; ++prev)
+        {
+            if (strcmp(m_Desc.VariableDesc[prev].Name, VarDesc.Name) == 0)
+                LOG_ERROR_AND_THROW("Shader variable '", VarDesc.Name, "' is defined more than once");
+        }
+        HashCombine(m_ResourceLayoutHash, CStringHash<Char>()(VarDesc.Name), static_cast<Uint32>(VarDesc.Type));
+    }
+
+    m_StaticResCache.Initialize(m_Desc.NumVariables);
+    const SHADER_VARIABLE_TYPE StaticVarType = SHADER_VARIABLE_TYPE_STATIC;
+    m_StaticResLayout.Initialize(*this, &StaticVarType, 1, m_StaticResCache);
+}
+
+bool ShaderNullImpl::IsCompatibleWith(const ShaderNullImpl& Shader)const
+{
+    if (m_ResourceLayoutHash != Shader.m_ResourceLayoutHash)
+        return false;
+
+    const auto& OtherDesc = Shader.GetDesc();
+    if (m_Desc.NumVariables != OtherDesc.NumVariables)
+        return false;
+
+    for (Uint32 v = 0; v < m_Desc.NumVariables; ++v)
+    {
+        const auto& Var0 = m_Desc.VariableDesc[v];
+        const auto& Var1 = OtherDesc.VariableDesc[v];
+        if (Var0.Type != Var1.Type || strcmp(Var0.Name, Var1.Name) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+}
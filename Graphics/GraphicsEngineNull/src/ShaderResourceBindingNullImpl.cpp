@@ -0,0 +1,194 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderResourceBindingNullImpl.h"
+#include "PipelineStateNullImpl.h"
+#include "ShaderNullImpl.h"
+#include "GraphicsAccessories.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+ShaderResourceBindingNullImpl::ShaderResourceBindingNullImpl( IReferenceCounters*    pRefCounters,
+                                                              PipelineStateNullImpl* pPSO,
+                                                              bool                   IsInternal) :
+    TBase( pRefCounters, pPSO, IsInternal )
+{
+    for(size_t s=0; s < _countof(m_ResourceLayoutIndex); ++s)
+        m_ResourceLayoutIndex[s] = -1;
+
+    auto ppShaders = pPSO->GetShaders();
+    m_NumActiveShaders = static_cast<Uint8>( pPSO->GetNumShaders() );
+
+    auto& RawAllocator = GetRawAllocator();
+    auto *pResLayoutRawMem = ALLOCATE(RawAllocator, "Raw memory for ShaderResourceLayoutNull", m_NumActiveShaders * sizeof(ShaderResourceLayoutNull));
+    m_pResourceLayouts = reinterpret_cast<ShaderResourceLayoutNull*>(pResLayoutRawMem);
+
+    auto *pResCacheRawMem = ALLOCATE(RawAllocator, "Raw memory for ShaderResourceCacheNull", m_NumActiveShaders * sizeof(ShaderResourceCacheNull));
+    m_pBoundResourceCaches = reinterpret_cast<ShaderResourceCacheNull*>(pResCacheRawMem);
+
+    for (Uint8 s = 0; s < m_NumActiveShaders; ++s)
+    {
+        auto *pShaderNull = ValidatedCast<ShaderNullImpl>(ppShaders[s]);
+        auto ShaderInd = pShaderNull->GetShaderTypeIndex();
+        VERIFY_EXPR(static_cast<Int32>(ShaderInd) == GetShaderTypeIndex(pShaderNull->GetDesc().ShaderType));
+
+        // Initialize resource cache to have enough space to contain all shader resources, including static ones
+        // Static resources are copied before resources are committed
+        auto NumResources = pShaderNull->GetDesc().NumVariables;
+        new (m_pBoundResourceCaches+s) ShaderResourceCacheNull(RawAllocator);
+        m_pBoundResourceCaches[s].Initialize(NumResources);
+        m_TotalResourceCount += NumResources;
+
+        // Shader resource layout will only contain dynamic and mutable variables
+        SHADER_VARIABLE_TYPE VarTypes[] = {SHADER_VARIABLE_TYPE_MUTABLE, SHADER_VARIABLE_TYPE_DYNAMIC};
+        new (m_pResourceLayouts + s) ShaderResourceLayoutNull(*this, RawAllocator);
+        m_pResourceLayouts[s].Initialize(*pShaderNull, VarTypes, _countof(VarTypes), m_pBoundResourceCaches[s]);
+
+        m_ResourceLayoutIndex[ShaderInd] = s;
+        m_ShaderTypeIndex[s] = static_cast<Int8>(ShaderInd);
+    }
+}
+
+ShaderResourceBindingNullImpl::~ShaderResourceBindingNullImpl()
+{
+    for(Uint32 l = 0; l < m_NumActiveShaders; ++l)
+    {
+        m_pResourceLayouts[l].~ShaderResourceLayoutNull();
+    }
+    GetRawAllocator().Free(m_pResourceLayouts);
+
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+    {
+        m_pBoundResourceCaches[s].~ShaderResourceCacheNull();
+    }
+    GetRawAllocator().Free(m_pBoundResourceCaches);
+}
+
+void ShaderResourceBindingNullImpl::BindResources(Uint32 ShaderFlags, IResourceMapping* pResMapping, Uint32 Flags)
+{
+    for(Uint32 ResLayoutInd = 0; ResLayoutInd < m_NumActiveShaders; ++ResLayoutInd)
+    {
+        if(ShaderFlags & GetShaderTypeFromIndex(m_ShaderTypeIndex[ResLayoutInd]))
+        {
+            m_pResourceLayouts[ResLayoutInd].BindResources(pResMapping, Flags);
+        }
+    }
+}
+
+void ShaderResourceBindingNullImpl::BindStaticShaderResources()
+{
+    if (m_bIsStaticResourcesBound)
+    {
+        LOG_ERROR("Static resources already bound");
+        return;
+    }
+
+    auto *pPSONull = ValidatedCast<PipelineStateNullImpl>(GetPipelineState());
+    auto NumShaders = pPSONull->GetNumShaders();
+    VERIFY_EXPR(NumShaders == m_NumActiveShaders);
+
+    for (Uint32 shader = 0; shader < NumShaders; ++shader)
+    {
+        auto *pShaderNull = pPSONull->GetShader<ShaderNullImpl>(shader);
+#ifdef DEVELOPMENT
+        pShaderNull->GetStaticResourceLayout().dvpVerifyBindings();
+#endif
+
+#ifdef _DEBUG
+        auto ShaderTypeInd = pShaderNull->GetShaderTypeIndex();
+        auto ResourceLayoutInd = m_ResourceLayoutIndex[ShaderTypeInd];
+        VERIFY_EXPR(ResourceLayoutInd == static_cast<Int8>(shader) );
+#endif
+        pShaderNull->GetStaticResourceLayout().CopyResources( m_pBoundResourceCaches[shader] );
+    }
+
+    m_bIsStaticResourcesBound = true;
+}
+
+void ShaderResourceBindingNullImpl::CopyResourcePointers(IDeviceObject** ppObjects)const
+{
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+    {
+        const auto& ResourceCache = m_pBoundResourceCaches[s];
+        ResourceCache.CopyResourcePointers(ppObjects);
+        ppObjects += ResourceCache.GetSize();
+    }
+}
+
+#ifdef DEVELOPMENT
+void ShaderResourceBindingNullImpl::dvpVerifyBindings()const
+{
+    for (Uint32 s = 0; s < m_NumActiveShaders; ++s)
+    {
+        m_pResourceLayouts[s].dvpVerifyBindings();
+        // Static resource bindings are verified in BindStaticShaderResources()
+    }
+}
+#endif
+
+IShaderVariable* ShaderResourceBindingNullImpl::GetVariable(SHADER_TYPE ShaderType, const char* Name)
+{
+    auto Ind = GetShaderTypeIndex(ShaderType);
+    VERIFY_EXPR(Ind >= 0 && Ind < _countof(m_ResourceLayoutIndex));
+    auto ResLayoutIndex = m_ResourceLayoutIndex[Ind];
+    if( ResLayoutIndex < 0 )
+    {
+        LOG_WARNING_MESSAGE("Unable to find mutable/dynamic variable '", Name, "': shader stage ", GetShaderTypeLiteralName(ShaderType), " is inactive");
+        return nullptr;
+    }
+
+    return m_pResourceLayouts[ResLayoutIndex].GetShaderVariable(Name);
+}
+
+Uint32 ShaderResourceBindingNullImpl::GetVariableCount(SHADER_TYPE ShaderType) const
+{
+    auto Ind = GetShaderTypeIndex(ShaderType);
+    VERIFY_EXPR(Ind >= 0 && Ind < _countof(m_ResourceLayoutIndex));
+    auto ResLayoutIndex = m_ResourceLayoutIndex[Ind];
+    if( ResLayoutIndex < 0 )
+    {
+        LOG_WARNING_MESSAGE("Unable to get the number of mutable/dynamic variables: shader stage ", GetShaderTypeLiteralName(ShaderType), " is inactive");
+        return 0;
+    }
+
+    return m_pResourceLayouts[ResLayoutIndex].GetTotalResourceCount();
+}
+
+IShaderVariable* ShaderResourceBindingNullImpl::GetVariable(SHADER_TYPE ShaderType, Uint32 Index)
+{
+    auto Ind = GetShaderTypeIndex(ShaderType);
+    VERIFY_EXPR(Ind >= 0 && Ind < _countof(m_ResourceLayoutIndex));
+    auto ResLayoutIndex = m_ResourceLayoutIndex[Ind];
+    if( ResLayoutIndex < 0 )
+    {
+        LOG_ERROR("Unable to get mutable/dynamic variable at index ", Index, ": shader stage ", GetShaderTypeLiteralName(ShaderType), " is inactive");
+        return nullptr;
+    }
+
+    return m_pResourceLayouts[ResLayoutIndex].GetShaderVariable(Index);
+}
+
+}
@@ -0,0 +1,237 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderResourceLayoutNull.h"
+#include "ShaderNullImpl.h"
+#include "ResourceMapping.h"
+#include "Buffer.h"
+#include "BufferView.h"
+#include "TextureView.h"
+#include "Sampler.h"
+#include "GraphicsAccessories.h"
+
+namespace Diligent
+{
+
+ShaderResourceLayoutNull::ShaderResourceLayoutNull(IObject& Owner, IMemoryAllocator& Allocator) :
+    m_Owner(Owner),
+    m_Variables(STD_ALLOCATOR_RAW_MEM(ShaderVariableNullImpl, Allocator, "Allocator for vector<ShaderVariableNullImpl>")),
+    m_NameIndex(Allocator)
+{
+}
+
+static bool IsAllowedType(SHADER_VARIABLE_TYPE VarType, const SHADER_VARIABLE_TYPE* AllowedVarTypes, Uint32 NumAllowedTypes)
+{
+    for(Uint32 t=0; t < NumAllowedTypes; ++t)
+        if (AllowedVarTypes[t] == VarType)
+            return true;
+    return false;
+}
+
+void ShaderResourceLayoutNull::Initialize(const ShaderNullImpl&       Shader,
+                                          const SHADER_VARIABLE_TYPE* AllowedVarTypes,
+                                          Uint32                      NumAllowedTypes,
+                                          ShaderResourceCacheNull&    ResourceCache)
+{
+    VERIFY(m_Variables.empty(), "Resource layout has already been initialized");
+
+    const auto& ShdrDesc = Shader.GetDesc();
+    VERIFY(ResourceCache.GetSize() == ShdrDesc.NumVariables, "Resource cache is expected to hold all resources of the shader");
+    m_ShaderName     = ShdrDesc.Name;
+    m_pResourceCache = &ResourceCache;
+
+    Uint32 NumVariables = 0;
+    for(Uint32 v=0; v < ShdrDesc.NumVariables; ++v)
+    {
+        if (IsAllowedType(ShdrDesc.VariableDesc[v].Type, AllowedVarTypes, NumAllowedTypes))
+            ++NumVariables;
+    }
+
+    // Variables are referenced by pointers, so the vector must never be reallocated
+    m_Variables.reserve(NumVariables);
+    for(Uint32 v=0; v < ShdrDesc.NumVariables; ++v)
+    {
+        const auto& VarDesc = ShdrDesc.VariableDesc[v];
+        if (IsAllowedType(VarDesc.Type, AllowedVarTypes, NumAllowedTypes))
+            m_Variables.emplace_back(*this, VarDesc, v);
+    }
+    VERIFY_EXPR(m_Variables.size() == NumVariables);
+
+    m_NameIndex.Initialize(NumVariables, [&](Uint32 v){ return m_Variables[v].Name; });
+}
+
+
+#define LOG_RESOURCE_BINDING_ERROR(ResType, pResource, VarName, ShaderName, ...)\
+do{                                                                             \
+    const auto* ResName = pResource->GetDesc().Name;                            \
+    LOG_ERROR_MESSAGE( "Failed to bind ", ResType, " '", ResName, "' to variable '", VarName,\
+                       "' in shader '", ShaderName, "'. ", __VA_ARGS__ );       \
+}while(false)
+
+void ShaderResourceLayoutNull::ShaderVariableNullImpl::BindResource(IDeviceObject* pObject, Uint32 ArrayIndex)
+{
+    DEV_CHECK_ERR(ArrayIndex == 0, "Array index (", ArrayIndex, ") is out of range for variable '", Name, "'. Max allowed index: 0");
+    if (ArrayIndex != 0)
+        return;
+
+    auto& ResourceCache = *m_ParentResLayout.m_pResourceCache;
+
+    if (pObject != nullptr)
+    {
+        // We cannot use ValidatedCast<> here as the resource retrieved from the
+        // resource mapping can be of wrong type
+        RefCntAutoPtr<IBuffer> pBuffer(pObject, IID_Buffer);
+        if (pBuffer)
+        {
+#ifdef DEVELOPMENT
+            if ((pBuffer->GetDesc().BindFlags & BIND_UNIFORM_BUFFER) == 0)
+            {
+                LOG_RESOURCE_BINDING_ERROR("buffer", pObject, Name, m_ParentResLayout.GetShaderName(), "Buffer was not created with BIND_UNIFORM_BUFFER flag.");
+                return;
+            }
+#endif
+        }
+        else if (!RefCntAutoPtr<ITextureView>(pObject, IID_TextureView) && 
+                 !RefCntAutoPtr<IBufferView> (pObject, IID_BufferView)  &&
+                 !RefCntAutoPtr<ISampler>    (pObject, IID_Sampler))
+        {
+            LOG_RESOURCE_BINDING_ERROR("resource", pObject, Name, m_ParentResLayout.GetShaderName(), "Incorrect resource type: texture view, buffer, buffer view or sampler is expected.");
+            return;
+        }
+    }
+    RefCntAutoPtr<IDeviceObject> pResource(pObject);
+
+#ifdef DEVELOPMENT
+    if (Type != SHADER_VARIABLE_TYPE_DYNAMIC)
+    {
+        auto* pCachedResource = ResourceCache.GetResource(CacheOffset);
+        if (pCachedResource != nullptr && pCachedResource != pObject)
+        {
+            auto VarTypeStr = GetShaderVariableTypeLiteralName(Type);
+            LOG_ERROR_MESSAGE( "Non-null resource is already bound to ", VarTypeStr, " shader variable '", Name, "' in shader '", m_ParentResLayout.GetShaderName(), "'. Attempting to bind another resource or null is an error and may cause unpredicted behavior. Use another shader resource binding instance or label the variable as dynamic." );
+        }
+    }
+#endif
+
+    ResourceCache.SetResource(CacheOffset, std::move(pResource));
+}
+
+bool ShaderResourceLayoutNull::ShaderVariableNullImpl::IsBound(Uint32 ArrayIndex)const
+{
+    VERIFY_EXPR(ArrayIndex == 0);
+    return m_ParentResLayout.m_pResourceCache->GetResource(CacheOffset) != nullptr;
+}
+
+
+void ShaderResourceLayoutNull::CopyResources(ShaderResourceCacheNull& DstCache)const
+{
+    VERIFY(m_pResourceCache != nullptr, "Resource cache is null");
+    VERIFY(DstCache.GetSize() == m_pResourceCache->GetSize(), "Source and destination caches are expected to have the same size");
+    for(const auto& Var : m_Variables)
+    {
+        RefCntAutoPtr<IDeviceObject> pResource(m_pResourceCache->GetResource(Var.CacheOffset));
+        DstCache.SetResource(Var.CacheOffset, std::move(pResource));
+    }
+}
+
+void ShaderResourceLayoutNull::BindResources( IResourceMapping* pResourceMapping, Uint32 Flags )
+{
+    if (pResourceMapping == nullptr)
+    {
+        LOG_ERROR_MESSAGE( "Failed to bind resources in shader '", GetShaderName(), "': resource mapping is null" );
+        return;
+    }
+    
+    if ( (Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0 )
+        Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
+
+    for(Uint32 v=0; v < GetTotalResourceCount(); ++v)
+    {
+        auto& Var = m_Variables[v];
+        if ( (Flags & (1 << Var.Type)) == 0 )
+            continue;
+
+        if ( (Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Var.IsBound(0) )
+            continue;
+
+        RefCntAutoPtr<IDeviceObject> pRes;
+        GetResourceFromMapping( pResourceMapping, Var.Name, m_NameIndex.GetNameHash(v), 0, &pRes );
+        if (pRes)
+        {
+            //  Call non-virtual function
+            Var.BindResource(pRes, 0);
+        }
+        else
+        {
+            if ( (Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) && !Var.IsBound(0) )
+                LOG_ERROR_MESSAGE( "Cannot bind resource to shader variable '", Var.Name, "': resource not found in the resource mapping" );
+        }
+    }
+}
+
+IShaderVariable* ShaderResourceLayoutNull::GetShaderVariable(const Char* Name)
+{
+    auto Index = m_NameIndex.Find(Name);
+    return Index != ShaderVariableNameIndex::InvalidIndex ? &m_Variables[Index] : nullptr;
+}
+
+IShaderVariable* ShaderResourceLayoutNull::GetShaderVariable( Uint32 Index )
+{
+    if (Index >= GetTotalResourceCount())
+    {
+        LOG_ERROR("Invalid resource index ", Index);
+        return nullptr;
+    }
+    return &m_Variables[Index];
+}
+
+Uint32 ShaderResourceLayoutNull::GetVariableIndex(const ShaderVariableNullImpl& Variable)const
+{
+    if (m_Variables.empty())
+    {
+        LOG_ERROR("This shader resource layout does not have resources");
+        return static_cast<Uint32>(-1);
+    }
+
+    auto Offset = &Variable - m_Variables.data();
+    if (Offset < 0 || Offset >= static_cast<std::ptrdiff_t>(m_Variables.size()))
+    {
+        LOG_ERROR("Failed to get variable index. The variable ", &Variable, " does not belong to this shader resource layout");
+        return static_cast<Uint32>(-1);
+    }
+    return static_cast<Uint32>(Offset);
+}
+
+#ifdef DEVELOPMENT
+void ShaderResourceLayoutNull::dvpVerifyBindings()const
+{
+    for(const auto& Var : m_Variables)
+    {
+        if (!Var.IsBound(0))
+            LOG_ERROR_MESSAGE( "No resource is bound to ", GetShaderVariableTypeLiteralName(Var.Type), " variable '", Var.Name, "' in shader '", GetShaderName(), "'" );
+    }
+}
+#endif
+
+}
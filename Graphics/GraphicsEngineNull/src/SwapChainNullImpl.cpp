@@ -0,0 +1,141 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "SwapChainNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "DeviceContextNullImpl.h"
+
+namespace Diligent
+{
+
+SwapChainNullImpl::SwapChainNullImpl(IReferenceCounters*    pRefCounters,
+                                     const SwapChainDesc&   SCDesc, 
+                                     RenderDeviceNullImpl*  pRenderDeviceNull, 
+                                     DeviceContextNullImpl* pImmediateContextNull) : 
+    TSwapChainBase( pRefCounters, pRenderDeviceNull, pImmediateContextNull, SCDesc)
+{
+    if (m_SwapChainDesc.Width == 0 || m_SwapChainDesc.Height == 0)
+    {
+        LOG_ERROR_AND_THROW("Swap chain width and height must not be zero: there is no window to get the size from");
+    }
+
+    CreateRTVandDSV();
+}
+
+SwapChainNullImpl::~SwapChainNullImpl()
+{
+}
+
+void SwapChainNullImpl::CreateRTVandDSV()
+{
+    m_pRenderTargetView.Release();
+    m_pDepthStencilView.Release();
+
+    TextureDesc BackBufferDesc;
+    BackBufferDesc.Name        = "Main back buffer";
+    BackBufferDesc.Type        = RESOURCE_DIM_TEX_2D;
+    BackBufferDesc.Width       = m_SwapChainDesc.Width;
+    BackBufferDesc.Height      = m_SwapChainDesc.Height;
+    BackBufferDesc.MipLevels   = 1;
+    BackBufferDesc.ArraySize   = 1;
+    BackBufferDesc.Format      = m_SwapChainDesc.ColorBufferFormat;
+    BackBufferDesc.SampleCount = m_SwapChainDesc.SamplesCount;
+    BackBufferDesc.Usage       = USAGE_DEFAULT;
+    BackBufferDesc.BindFlags   = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    RefCntAutoPtr<ITexture> pBackBuffer;
+    m_pRenderDevice->CreateTexture(BackBufferDesc, TextureData{}, &pBackBuffer);
+    m_pRenderTargetView = pBackBuffer->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+    TextureDesc DepthBufferDesc;
+    DepthBufferDesc.Name        = "Main depth buffer";
+    DepthBufferDesc.Type        = RESOURCE_DIM_TEX_2D;
+    DepthBufferDesc.Width       = m_SwapChainDesc.Width;
+    DepthBufferDesc.Height      = m_SwapChainDesc.Height;
+    DepthBufferDesc.MipLevels   = 1;
+    DepthBufferDesc.ArraySize   = 1;
+    DepthBufferDesc.Format      = m_SwapChainDesc.DepthBufferFormat;
+    DepthBufferDesc.SampleCount = m_SwapChainDesc.SamplesCount;
+    DepthBufferDesc.Usage       = USAGE_DEFAULT;
+    DepthBufferDesc.BindFlags   = BIND_DEPTH_STENCIL;
+    RefCntAutoPtr<ITexture> pDepthBuffer;
+    m_pRenderDevice->CreateTexture(DepthBufferDesc, TextureData{}, &pDepthBuffer);
+    m_pDepthStencilView = pDepthBuffer->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+}
+
+void SwapChainNullImpl::Present(Uint32 SyncInterval)
+{
+    auto pDeviceContext = m_wpDeviceContext.Lock();
+    if( !pDeviceContext )
+    {
+        LOG_ERROR_MESSAGE( "Immediate context has been released" );
+        return;
+    }
+
+    auto* pImmediateCtxNull = pDeviceContext.RawPtr<DeviceContextNullImpl>();
+    pImmediateCtxNull->Flush();
+    pImmediateCtxNull->FinishFrame();
+}
+
+void SwapChainNullImpl::Resize( Uint32 NewWidth, Uint32 NewHeight )
+{
+    if( TSwapChainBase::Resize(NewWidth, NewHeight) )
+    {
+        auto pDeviceContext = m_wpDeviceContext.Lock();
+        VERIFY( pDeviceContext, "Immediate context has been released" );
+        if( pDeviceContext )
+        {
+            auto* pImmediateCtxNull = pDeviceContext.RawPtr<DeviceContextNullImpl>();
+            bool bIsDefaultFBBound = pImmediateCtxNull->IsDefaultFBBound();
+            if (bIsDefaultFBBound)
+                pImmediateCtxNull->ResetRenderTargets();
+
+            try
+            {
+                CreateRTVandDSV();
+            }
+            catch (const std::runtime_error &)
+            {
+                LOG_ERROR("Failed to resize the swap chain");
+            }
+
+            if (bIsDefaultFBBound)
+            {
+                // Set default render target and viewport
+                pImmediateCtxNull->SetRenderTargets(0, nullptr, nullptr);
+                pImmediateCtxNull->SetViewports(1, nullptr, 0, 0);
+            }
+        }
+    }
+}
+
+void SwapChainNullImpl::SetFullscreenMode(const DisplayModeAttribs &DisplayMode)
+{
+    UNSUPPORTED("Null swap chain does not support switching to the fullscreen mode");
+}
+
+void SwapChainNullImpl::SetWindowedMode()
+{
+}
+
+}
@@ -0,0 +1,338 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "TextureNullImpl.h"
+#include "RenderDeviceNullImpl.h"
+#include "DeviceContextNullImpl.h"
+#include "GraphicsAccessories.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+TextureNullImpl :: TextureNullImpl(IReferenceCounters*        pRefCounters,
+                                   FixedBlockMemoryAllocator& TexViewObjAllocator,
+                                   RenderDeviceNullImpl*      pDeviceNull, 
+                                   const TextureDesc&         TexDesc, 
+                                   const TextureData&         InitData,
+                                   bool                       bIsDeviceInternal) : 
+    TTextureBase(pRefCounters, TexViewObjAllocator, pDeviceNull, TexDesc, bIsDeviceInternal),
+    m_MipLevels(STD_ALLOCATOR_RAW_MEM(MipLevelLayout, GetRawAllocator(), "Allocator for vector<MipLevelLayout>"))
+{
+    if( m_Desc.Usage == USAGE_STATIC && InitData.pSubResources == nullptr )
+        LOG_ERROR_AND_THROW("Static Texture must be initialized with data at creation time");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        VERIFY_EXPR(FmtAttribs.BlockWidth > 1 && FmtAttribs.BlockHeight > 1);
+        m_BlockWidth  = FmtAttribs.BlockWidth;
+        m_BlockHeight = FmtAttribs.BlockHeight;
+        m_BlockSize   = Uint32{FmtAttribs.ComponentSize}; // ComponentSize is the block size
+    }
+    else
+    {
+        m_BlockSize = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+    }
+
+    m_NumArraySlices = m_Desc.Type == RESOURCE_DIM_TEX_3D ? 1 : m_Desc.ArraySize;
+    m_MipLevels.resize(m_Desc.MipLevels);
+    for(Uint32 Mip = 0; Mip < m_Desc.MipLevels; ++Mip)
+    {
+        auto& MipLayout = m_MipLevels[Mip];
+        auto MipWidth  = std::max(m_Desc.Width  >> Mip, 1u);
+        auto MipHeight = std::max(m_Desc.Height >> Mip, 1u);
+        MipLayout.Offset  = m_ArraySliceSize;
+        MipLayout.RowSize = (MipWidth  + m_BlockWidth - 1) / m_BlockWidth * m_BlockSize;
+        MipLayout.NumRows = (MipHeight + m_BlockHeight- 1) / m_BlockHeight;
+        MipLayout.Depth   = m_Desc.Type == RESOURCE_DIM_TEX_3D ? std::max(m_Desc.Depth >> Mip, 1u) : 1;
+        m_ArraySliceSize += MipLayout.GetDepthSliceSize() * MipLayout.Depth;
+    }
+
+    if (InitData.pSubResources != nullptr)
+    {
+        Uint32 ExpectedNumSubresources = m_Desc.MipLevels * m_NumArraySlices;
+        if (InitData.NumSubresources != ExpectedNumSubresources)
+            LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", ExpectedNumSubresources, " expected, while ", InitData.NumSubresources, " provided");
+
+        AllocateStorage();
+        Uint32 Subres = 0;
+        for(Uint32 Slice = 0; Slice < m_NumArraySlices; ++Slice)
+        {
+            for(Uint32 Mip = 0; Mip < m_Desc.MipLevels; ++Mip)
+            {
+                const auto& SubResData = InitData.pSubResources[Subres++];
+                if (SubResData.pData == nullptr)
+                    LOG_ERROR_AND_THROW("Textures can only be initialized from CPU data");
+
+                Box FullMipBox;
+                FullMipBox.MaxX = std::max(m_Desc.Width  >> Mip, 1u);
+                FullMipBox.MaxY = std::max(m_Desc.Height >> Mip, 1u);
+                FullMipBox.MaxZ = m_MipLevels[Mip].Depth;
+                WriteRegion(Mip, Slice, FullMipBox, SubResData.pData, SubResData.Stride, SubResData.DepthStride);
+            }
+        }
+    }
+    else if (m_Desc.Usage == USAGE_DYNAMIC || m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
+    {
+        // Mappable textures expose their storage directly
+        AllocateStorage();
+    }
+}
+
+TextureNullImpl :: ~TextureNullImpl()
+{
+    if (m_pData != nullptr)
+        GetRawAllocator().Free(m_pData);
+}
+
+void TextureNullImpl::AllocateStorage()
+{
+    if (m_pData != nullptr)
+        return;
+
+    auto StorageSize = m_ArraySliceSize * m_NumArraySlices;
+    m_pData = reinterpret_cast<Uint8*>(ALLOCATE(GetRawAllocator(), "Memory for Null texture data", StorageSize));
+    memset(m_pData, 0, StorageSize);
+}
+
+Uint8* TextureNullImpl::GetRegionAddress(Uint32 MipLevel, Uint32 Slice, Uint32 X, Uint32 Y, Uint32 Z)
+{
+    VERIFY_EXPR(MipLevel < m_MipLevels.size() && Slice < m_NumArraySlices);
+    AllocateStorage();
+    const auto& MipLayout = m_MipLevels[MipLevel];
+    VERIFY(X % m_BlockWidth == 0 && Y % m_BlockHeight == 0, "Region must be aligned by the compressed block size");
+    return m_pData + 
+           m_ArraySliceSize * Slice + 
+           MipLayout.Offset + 
+           MipLayout.GetDepthSliceSize() * Z + 
+           size_t{MipLayout.RowSize} * (Y / m_BlockHeight) + 
+           size_t{X / m_BlockWidth} * m_BlockSize;
+}
+
+void TextureNullImpl::GetRegionSize(const Box& Region, Uint32& RowSize, Uint32& NumRows, Uint32& Depth)const
+{
+    VERIFY_EXPR(Region.MaxX > Region.MinX);
+    auto Width  = Region.MaxX - Region.MinX;
+    auto Height = std::max(Region.MaxY, Region.MinY + 1) - Region.MinY;
+    RowSize = (Width  + m_BlockWidth - 1) / m_BlockWidth * m_BlockSize;
+    NumRows = (Height + m_BlockHeight- 1) / m_BlockHeight;
+    Depth   = std::max(Region.MaxZ, Region.MinZ + 1) - Region.MinZ;
+}
+
+void TextureNullImpl::WriteRegion(Uint32 MipLevel, Uint32 Slice, const Box& Region, const void* pSrcData, Uint32 SrcStride, Uint32 SrcDepthStride)
+{
+    Uint32 RowSize = 0, NumRows = 0, Depth = 0;
+    GetRegionSize(Region, RowSize, NumRows, Depth);
+
+    // Block-aligned regions of coarse mip levels may extend past the mip level boundary
+    const auto& MipLayout = m_MipLevels[MipLevel];
+    const auto X0 = Region.MinX / m_BlockWidth * m_BlockSize;
+    const auto Y0 = Region.MinY / m_BlockHeight;
+    VERIFY_EXPR(X0 < MipLayout.RowSize && Y0 < MipLayout.NumRows && Region.MinZ < MipLayout.Depth);
+    RowSize = std::min(RowSize, MipLayout.RowSize - X0);
+    NumRows = std::min(NumRows, MipLayout.NumRows - Y0);
+    Depth   = std::min(Depth,   MipLayout.Depth   - Region.MinZ);
+    VERIFY(NumRows == 1 || SrcStride >= RowSize, "Source data stride (", SrcStride, ") is smaller than the row size (", RowSize, ")");
+
+    auto* pDstData = GetRegionAddress(MipLevel, Slice, Region.MinX, Region.MinY, Region.MinZ);
+    for(Uint32 z = 0; z < Depth; ++z)
+    {
+        for(Uint32 row = 0; row < NumRows; ++row)
+        {
+            const auto* pSrcRow = reinterpret_cast<const Uint8*>(pSrcData) + size_t{SrcDepthStride} * z + size_t{SrcStride} * row;
+            auto* pDstRow = pDstData + MipLayout.GetDepthSliceSize() * z + size_t{MipLayout.RowSize} * row;
+            // Source and destination may reside in the same texture
+            memmove(pDstRow, pSrcRow, RowSize);
+        }
+    }
+}
+
+void TextureNullImpl::CopyRegion(TextureNullImpl& SrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box& SrcBox,
+                                 Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ)
+{
+    const auto& SrcMipLayout = SrcTexture.m_MipLevels[SrcMipLevel];
+    const auto* pSrcData = SrcTexture.GetRegionAddress(SrcMipLevel, SrcSlice, SrcBox.MinX, SrcBox.MinY, SrcBox.MinZ);
+
+    Box DstBox;
+    DstBox.MinX = DstX;
+    DstBox.MaxX = DstX + (SrcBox.MaxX - SrcBox.MinX);
+    DstBox.MinY = DstY;
+    DstBox.MaxY = DstY + std::max(SrcBox.MaxY - SrcBox.MinY, 1u);
+    DstBox.MinZ = DstZ;
+    DstBox.MaxZ = DstZ + std::max(SrcBox.MaxZ - SrcBox.MinZ, 1u);
+    WriteRegion(DstMipLevel, DstSlice, DstBox, pSrcData, SrcMipLayout.RowSize, static_cast<Uint32>(SrcMipLayout.GetDepthSliceSize()));
+}
+
+void TextureNullImpl::UpdateData( IDeviceContext* pContext, Uint32 MipLevel, Uint32 Slice, const Box& DstBox, const TextureSubResData& SubresData )
+{
+    TTextureBase::UpdateData( pContext, MipLevel, Slice, DstBox, SubresData );
+    // OpenGL backend uses UpdateData() to initialize textures, so we can't check the usage in ValidateUpdateDataParams()
+    DEV_CHECK_ERR( m_Desc.Usage == USAGE_DEFAULT, "Only USAGE_DEFAULT textures should be updated with UpdateData()" );
+
+    auto* pCtxNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    pCtxNull->UpdateTextureRegion(SubresData, *this, MipLevel, Slice, DstBox);
+}
+
+void TextureNullImpl ::  CopyData(IDeviceContext* pContext, 
+                                  ITexture*       pSrcTexture, 
+                                  Uint32          SrcMipLevel,
+                                  Uint32          SrcSlice,
+                                  const Box*      pSrcBox,
+                                  Uint32          DstMipLevel,
+                                  Uint32          DstSlice,
+                                  Uint32          DstX,
+                                  Uint32          DstY,
+                                  Uint32          DstZ)
+{
+    TTextureBase::CopyData( pContext, pSrcTexture, SrcMipLevel, SrcSlice, pSrcBox,
+                            DstMipLevel, DstSlice, DstX, DstY, DstZ );
+
+    auto* pSrcTexNull = ValidatedCast<TextureNullImpl>( pSrcTexture );
+
+    Box SrcBox;
+    if( pSrcBox )
+    {
+        SrcBox = *pSrcBox;
+    }
+    else
+    {
+        const auto& SrcDesc = pSrcTexNull->GetDesc();
+        SrcBox.MaxX = std::max(SrcDesc.Width  >> SrcMipLevel, 1u);
+        SrcBox.MaxY = std::max(SrcDesc.Height >> SrcMipLevel, 1u);
+        if(SrcDesc.Type == RESOURCE_DIM_TEX_3D)
+            SrcBox.MaxZ = std::max(SrcDesc.Depth >> SrcMipLevel, 1u);
+        else
+            SrcBox.MaxZ = 1;
+    }
+
+    auto* pCtxNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    pCtxNull->CopyTextureRegion(pSrcTexNull, SrcMipLevel, SrcSlice, SrcBox, this, DstMipLevel, DstSlice, DstX, DstY, DstZ);
+}
+
+void TextureNullImpl :: Map(IDeviceContext*           pContext,
+                            Uint32                    MipLevel,
+                            Uint32                    ArraySlice,
+                            MAP_TYPE                  MapType,
+                            Uint32                    MapFlags,
+                            const Box*                pMapRegion,
+                            MappedTextureSubresource& MappedData)
+{
+    TTextureBase::Map(pContext, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
+
+    auto* pDeviceContextNull = ValidatedCast<DeviceContextNullImpl>(pContext);
+    MappedData = MappedTextureSubresource{};
+
+    if (m_Desc.Usage != USAGE_DYNAMIC && m_Desc.Usage != USAGE_CPU_ACCESSIBLE)
+    {
+        LOG_ERROR_MESSAGE("Failed to map texture '", m_Desc.Name, "': only USAGE_DYNAMIC and USAGE_CPU_ACCESSIBLE textures can be mapped");
+        return;
+    }
+
+    if (pDeviceContextNull->IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Failed to map texture '", m_Desc.Name, "': textures can only be mapped by the immediate context");
+        return;
+    }
+
+    Box FullExtentBox;
+    if (pMapRegion == nullptr)
+    {
+        FullExtentBox.MaxX = std::max(m_Desc.Width  >> MipLevel, 1u);
+        FullExtentBox.MaxY = std::max(m_Desc.Height >> MipLevel, 1u);
+        if (m_Desc.Type == RESOURCE_DIM_TEX_3D)
+            FullExtentBox.MaxZ = std::max(m_Desc.Depth >> MipLevel, 1u);
+        pMapRegion = &FullExtentBox;
+    }
+
+    // Execute all pending commands that may read or write the texture
+    if ((MapFlags & MAP_FLAG_DO_NOT_SYNCHRONIZE) == 0)
+        pDeviceContextNull->Flush();
+
+    const auto& MipLayout = m_MipLevels[MipLevel];
+    MappedData.pData       = GetRegionAddress(MipLevel, ArraySlice, pMapRegion->MinX, pMapRegion->MinY, pMapRegion->MinZ);
+    MappedData.Stride      = MipLayout.RowSize;
+    MappedData.DepthStride = static_cast<Uint32>(MipLayout.GetDepthSliceSize());
+}
+
+void TextureNullImpl::Unmap(IDeviceContext* pContext, Uint32 MipLevel, Uint32 ArraySlice)
+{
+    TTextureBase::Unmap(pContext, MipLevel, ArraySlice);
+    // Mapped memory is the texture storage itself, so there is nothing to do
+}
+
+void TextureNullImpl::CreateViewInternal( const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView )
+{
+    VERIFY( ppView != nullptr, "View pointer address is null" );
+    if( !ppView )return;
+    VERIFY( *ppView == nullptr, "Overwriting reference to existing object may cause memory leaks" );
+    
+    *ppView = nullptr;
+
+    try
+    {
+        auto& TexViewAllocator = m_pDevice->GetTexViewObjAllocator();
+        VERIFY( &TexViewAllocator == &m_dbgTexViewObjAllocator, "Texture view allocator does not match allocator provided during texture initialization" );
+
+        auto UpdatedViewDesc = ViewDesc;
+        CorrectTextureViewDesc( UpdatedViewDesc );
+
+        switch( UpdatedViewDesc.ViewType )
+        {
+            case TEXTURE_VIEW_SHADER_RESOURCE:
+                VERIFY( m_Desc.BindFlags & BIND_SHADER_RESOURCE, "BIND_SHADER_RESOURCE flag is not set" );
+            break;
+
+            case TEXTURE_VIEW_RENDER_TARGET:
+                VERIFY( m_Desc.BindFlags & BIND_RENDER_TARGET, "BIND_RENDER_TARGET flag is not set" );
+            break;
+
+            case TEXTURE_VIEW_DEPTH_STENCIL:
+                VERIFY( m_Desc.BindFlags & BIND_DEPTH_STENCIL, "BIND_DEPTH_STENCIL is not set" );
+            break;
+
+            case TEXTURE_VIEW_UNORDERED_ACCESS:
+                VERIFY( m_Desc.BindFlags & BIND_UNORDERED_ACCESS, "BIND_UNORDERED_ACCESS flag is not set" );
+            break;
+
+            default: UNEXPECTED( "Unknown view type" ); break;
+        }
+
+        auto pViewNull = NEW_RC_OBJ(TexViewAllocator, "TextureViewNullImpl instance", TextureViewNullImpl, bIsDefaultView ? this : nullptr)
+                                    (GetDevice(), UpdatedViewDesc, this, bIsDefaultView );
+        VERIFY( pViewNull->GetDesc().ViewType == ViewDesc.ViewType, "Incorrect view type" );
+
+        if( bIsDefaultView )
+            *ppView = pViewNull;
+        else
+            pViewNull->QueryInterface(IID_TextureView, reinterpret_cast<IObject**>(ppView) );
+    }
+    catch( const std::runtime_error & )
+    {
+        const auto *ViewTypeName = GetTexViewTypeLiteralName(ViewDesc.ViewType);
+        LOG_ERROR("Failed to create view \"", ViewDesc.Name ? ViewDesc.Name : "", "\" (", ViewTypeName, ") for texture \"", m_Desc.Name ? m_Desc.Name : "", "\"" );
+    }
+}
+
+}
@@ -30,6 +30,7 @@
 #include "BaseInterfacesGL.h"
 #include "BufferViewGLImpl.h"
 #include "RenderDeviceGLImpl.h"
+#include "GLDynamicHeap.h"
 
 namespace Diligent
 {
@@ -81,6 +82,13 @@ private:
     Uint32 m_uiMapTarget;
     const GLenum m_GLUsageHint;
     const Bool m_bUseMapWriteDiscardBugWA;
+    // Dynamic buffers that are only bound as uniform buffers are mapped by suballocating
+    // the dynamic heap of the immediate context, see DeviceContextGLImpl::MapDynamicUniformBuffer()
+    const Bool m_bIsDynamicUniformBuffer;
+    // Range of the dynamic heap that holds the buffer contents. When valid, the range rather than
+    // m_GlBuffer is bound to the uniform buffer slot. The contents are copied to m_GlBuffer when
+    // the frame is finished or when the buffer is used in any other way
+    GLDynamicHeap::Allocation m_DynamicAllocation;
 };
 
 }
@@ -31,17 +31,27 @@
 #include "BufferGLImpl.h"
 #include "TextureViewGLImpl.h"
 #include "PipelineStateGLImpl.h"
+#include "GLCommandStream.h"
+#include "GLDynamicHeap.h"
+#include "FixedBlockMemoryAllocator.h"
 
 namespace Diligent
 {
 
+struct EngineGLAttribs;
+
 /// Implementation of the Diligent::IDeviceContextGL interface
+
+/// A deferred context never calls OpenGL. It validates the commands, resolves the resources they
+/// use and records them into a GLCommandStream, which may happen on any thread. The stream is replayed
+/// by the immediate context in ExecuteCommandList(), so that only the OpenGL calls are serialized.
 class DeviceContextGLImpl final : public DeviceContextBase<IDeviceContextGL, BufferGLImpl, TextureViewGLImpl, PipelineStateGLImpl>
 {
 public:
     using TDeviceContextBase = DeviceContextBase<IDeviceContextGL, BufferGLImpl, TextureViewGLImpl, PipelineStateGLImpl>;
 
-    DeviceContextGLImpl( IReferenceCounters *pRefCounters, class RenderDeviceGLImpl *pDeviceGL, bool bIsDeferred );
+    DeviceContextGLImpl( IReferenceCounters *pRefCounters, class RenderDeviceGLImpl *pDeviceGL, const EngineGLAttribs &EngineAttribs, bool bIsDeferred );
+    ~DeviceContextGLImpl();
 
     /// Queries the specific interface, see IObject::QueryInterface() for details.
     virtual void QueryInterface( const Diligent::INTERFACE_ID &IID, IObject **ppInterface )override final;
@@ -90,6 +100,58 @@ public:
 
     void BindProgramResources( Uint32 &NewMemoryBarriers, IShaderResourceBinding *pResBinding );
 
+    // Resource bound to a program binding point, as resolved from the committed shader resource binding
+    struct ProgramResourceBinding
+    {
+        enum RESOURCE_TYPE : Uint8
+        {
+            UniformBuffer,
+            Texture,
+            TexelBuffer,
+            Image,
+            StorageBuffer
+        };
+        RESOURCE_TYPE  Type;
+        Uint32         BindingPoint;
+        IDeviceObject* pResource; // BufferGLImpl, TextureViewGLImpl or BufferViewGLImpl
+        IObject*       pSampler;  // SamplerGLImpl used with a texture, may be null
+    };
+
+    // Draw command translated to OpenGL parameters
+    struct GLDrawAttribs
+    {
+        GLenum        Topology             = 0;
+        Int32         NumPatchVertices     = 0;
+        GLenum        IndexType            = 0; // 0 for non-indexed draws
+        Uint32        FirstIndexByteOffset = 0;
+        Uint32        NumVertices          = 0;
+        Uint32        NumIndices           = 0;
+        Uint32        NumInstances         = 0;
+        Int32         BaseVertex           = 0;
+        Uint32        FirstInstance        = 0;
+        Uint32        StartVertex          = 0;
+        BufferGLImpl* pIndirectDrawAttribs = nullptr;
+        Uint32        IndirectDrawArgsOffset = 0;
+    };
+
+    // Record resource operations in a deferred context. The operations are
+    // performed by the immediate context when the command list is executed.
+    void  RecordUpdateBuffer  ( BufferGLImpl *pBuffer, Uint32 Offset, Uint32 Size, const void *pData );
+    void  RecordCopyBuffer    ( BufferGLImpl *pDstBuffer, BufferGLImpl *pSrcBuffer, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size );
+    void* RecordMapBuffer     ( BufferGLImpl *pBuffer, MAP_TYPE MapType, Uint32 MapFlags );
+    void  RecordUnmapBuffer   ( BufferGLImpl *pBuffer, MAP_TYPE MapType, Uint32 MapFlags );
+    void  RecordUpdateTexture ( class TextureBaseGL *pTexture, Uint32 MipLevel, Uint32 Slice, const Box &DstBox, const TextureSubResData &SubresData );
+    void  RecordCopyTexture   ( class TextureBaseGL *pDstTexture, class TextureBaseGL *pSrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box &SrcBox,
+                                Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ );
+    void  RecordGenerateMips  ( TextureViewGLImpl *pTexView );
+
+    // Suballocates the dynamic heap for the buffer mapped with MAP_FLAG_DISCARD, or returns the memory
+    // of the current allocation when the buffer is mapped with MAP_FLAG_DO_NOT_SYNCHRONIZE.
+    // Returns null if the buffer must be mapped by glMapBufferRange().
+    void* MapDynamicUniformBuffer( BufferGLImpl &Buffer, Uint32 MapFlags );
+    // Copies the contents of the buffer from the dynamic heap to the buffer's own storage
+    void  RetireDynamicAllocation( BufferGLImpl &Buffer );
+
     GLContextState &GetContextState(){return m_ContextState;}
     
     void CommitRenderTargets();
@@ -102,11 +164,45 @@ protected:
     GLContextState m_ContextState;
 
 private:
+    void GatherProgramResources( IShaderResourceBinding *pResBinding, std::vector<ProgramResourceBinding> &Bindings );
+    void ApplyProgramResources( const ProgramResourceBinding *pBindings, size_t NumBindings, Uint32 &NewMemoryBarriers );
+    void CommitProgramResources( const ProgramResourceBinding *pBindings, size_t NumBindings );
+
+    void PrepareDraw( const DrawAttribs &drawAttribs, GLDrawAttribs &GLAttribs );
+    void ExecuteDraw( const GLDrawAttribs &GLAttribs );
+
+    void ReplayCommands( const GLCommandStream &Commands );
+
+    void BindDynamicUniformBuffers();
+    void RetireDynamicBuffers();
+
     Uint32 m_CommitedResourcesTentativeBarriers;
 
+    std::vector<ProgramResourceBinding> m_ResourceBindings;
+
+    // Commands recorded by a deferred context
+    GLCommandStream m_Commands;
+    FixedBlockMemoryAllocator m_CmdListAllocator;
+    // Buffers mapped in a deferred context and the memory returned to the application
+    std::vector< std::pair<BufferGLImpl*, void*> > m_MappedBuffers;
+
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
     std::vector<class BufferGLImpl*> m_BoundWritableBuffers;
 
+    // Persistently mapped heap for dynamic uniform buffers. Only the immediate
+    // context has the heap, and only if the device supports buffer storage.
+    std::unique_ptr<GLDynamicHeap> m_pDynamicHeap;
+    // Buffers that have been mapped through the heap in the current frame
+    std::vector< RefCntAutoPtr<BufferGLImpl> > m_MappedDynamicBuffers;
+    // Dynamic uniform buffers of the committed resources and their binding points. They are
+    // bound before every draw or dispatch, as the buffer may be mapped after it is committed.
+    std::vector< std::pair<Uint32, BufferGLImpl*> > m_BoundDynamicUniformBuffers;
+
+    // VAO cache of the GL context of the last draw. VAOs cannot be shared between GL
+    // contexts, and the device only needs to be asked for the cache when the context changes.
+    GLContext::NativeGLContextType m_VAOCacheContext = {};
+    class VAOCache* m_pVAOCache = nullptr;
+
     bool m_bVAOIsUpToDate = false;
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 };
@@ -0,0 +1,169 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include "BasicTypes.h"
+#include "Object.h"
+#include "RefCntAutoPtr.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+
+/// Compact binary stream of commands recorded by a deferred OpenGL context
+
+/// Every command is a header followed by a POD payload that is stored contiguously in the stream.
+/// Variable-size command parameters (arrays, data to upload) are allocated from the parameter arena
+/// whose memory is never moved, so that commands may keep pointers to it. The stream also keeps
+/// strong references to all objects used by the commands until it is destroyed or reset.
+/// The stream is not thread-safe: it is filled by one thread and then replayed by the immediate context.
+class GLCommandStream
+{
+public:
+    struct CommandHeader
+    {
+        Uint16 Id   = 0;
+        Uint16 Size = 0; ///< Size of the command including the header, in bytes
+    };
+
+    GLCommandStream() = default;
+
+    GLCommandStream(const GLCommandStream&)  = delete;
+    GLCommandStream(      GLCommandStream&&) = default;
+    GLCommandStream& operator = (const GLCommandStream&)  = delete;
+    GLCommandStream& operator = (      GLCommandStream&&) = default;
+
+    /// Appends a new command to the stream and returns the reference to its payload,
+    /// which remains valid until the next command is added. CommandType::Id identifies the command.
+    template<typename CommandType>
+    CommandType& AddCommand()
+    {
+        static_assert(std::is_trivially_destructible<CommandType>::value, "Commands must be trivially destructible");
+        static_assert(alignof(CommandType) <= CommandAlignment, "Command alignment is too large");
+        constexpr size_t CommandSize = AlignCommandSize(PayloadOffset + sizeof(CommandType));
+        static_assert(CommandSize <= 0xFFFF, "Command is too large");
+
+        const auto Offset = m_Commands.size();
+        m_Commands.resize(Offset + CommandSize);
+        auto* pHeader = reinterpret_cast<CommandHeader*>(m_Commands.data() + Offset);
+        pHeader->Id   = static_cast<Uint16>(CommandType::Id);
+        pHeader->Size = static_cast<Uint16>(CommandSize);
+        ++m_NumCommands;
+        return *new(m_Commands.data() + Offset + PayloadOffset) CommandType;
+    }
+
+    /// Returns the header of the command at the given offset. The offset of the
+    /// next command is the offset of this command plus CommandHeader::Size.
+    const CommandHeader& GetHeader(size_t Offset)const
+    {
+        VERIFY_EXPR(Offset + sizeof(CommandHeader) <= m_Commands.size());
+        return *reinterpret_cast<const CommandHeader*>(m_Commands.data() + Offset);
+    }
+
+    /// Returns the payload of the command at the given offset
+    template<typename CommandType>
+    const CommandType& GetCommand(size_t Offset)const
+    {
+        VERIFY(GetHeader(Offset).Size == AlignCommandSize(PayloadOffset + sizeof(CommandType)), "Unexpected command size");
+        return *reinterpret_cast<const CommandType*>(m_Commands.data() + Offset + PayloadOffset);
+    }
+
+    /// Allocates memory for command parameters. The memory stays valid
+    /// and is never moved until the stream is reset or destroyed.
+    void* AllocateParams(size_t Size, size_t Alignment = CommandAlignment);
+
+    /// Copies an array of POD values to the parameter arena
+    template<typename Type>
+    Type* CopyParams(const Type* pSrc, size_t Count)
+    {
+        static_assert(std::is_trivially_copyable<Type>::value, "Only trivially copyable types can be copied to the parameter arena");
+        if (Count == 0)
+            return nullptr;
+        auto* pDst = reinterpret_cast<Type*>(AllocateParams(sizeof(Type) * Count, alignof(Type)));
+        memcpy(pDst, pSrc, sizeof(Type) * Count);
+        return pDst;
+    }
+
+    /// Keeps a strong reference to an object used by the commands
+    void AddReference(IObject* pObject)
+    {
+        if (pObject != nullptr)
+            m_References.emplace_back(pObject);
+    }
+
+    /// Removes all commands, releases parameter memory and object references.
+    /// The memory of the command stream itself is retained.
+    void Reset();
+
+    size_t GetSize()       const { return m_Commands.size(); }
+    Uint32 GetNumCommands()const { return m_NumCommands;     }
+    bool   IsEmpty()       const { return m_NumCommands == 0; }
+
+private:
+    static constexpr size_t CommandAlignment = sizeof(void*) > 8 ? sizeof(void*) : 8;
+    static constexpr size_t PayloadOffset    = (sizeof(CommandHeader) + CommandAlignment - 1) & ~(CommandAlignment - 1);
+    static constexpr size_t ParamPageSize    = 64 << 10;
+
+    static constexpr size_t AlignCommandSize(size_t Size)
+    {
+        return (Size + CommandAlignment - 1) & ~(CommandAlignment - 1);
+    }
+
+    // Commands are stored in a vector of aligned words to guarantee the alignment of the payloads
+    struct alignas(CommandAlignment) CommandWord { Uint8 Bytes[CommandAlignment]; };
+    class CommandBuffer
+    {
+    public:
+        Uint8* data()             { return reinterpret_cast<Uint8*>(m_Words.data()); }
+        const Uint8* data()const  { return reinterpret_cast<const Uint8*>(m_Words.data()); }
+        size_t size()const        { return m_Words.size() * CommandAlignment; }
+        void resize(size_t Size)  { VERIFY_EXPR(Size % CommandAlignment == 0); m_Words.resize(Size / CommandAlignment); }
+        void clear()              { m_Words.clear(); }
+    private:
+        std::vector<CommandWord> m_Words;
+    };
+
+    CommandBuffer m_Commands;
+    Uint32        m_NumCommands = 0;
+
+    // Parameter pages of ParamPageSize bytes; allocations are made from the last page
+    std::vector<std::unique_ptr<Uint8[]>> m_ParamPages;
+    // Offset of the first free byte in the last parameter page
+    size_t m_ParamPageOffset = 0;
+    // Parameter blocks that are too large to be allocated from pages
+    std::vector<std::unique_ptr<Uint8[]>> m_LargeParamBlocks;
+
+    std::vector<RefCntAutoPtr<IObject>> m_References;
+};
+
+}
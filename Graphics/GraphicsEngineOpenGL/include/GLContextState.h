@@ -43,6 +43,9 @@ public:
     void SetActiveTexture( Int32 Index );
     void BindTexture( Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj &Tex);
     void BindSampler( Uint32 Index, const GLObjectWrappers::GLSamplerObj &GLSampler);
+    void BindUniformBuffer( Uint32 Index, const GLObjectWrappers::GLBufferObj &Buff );
+    // Size must be non-zero; the range is not rebound if the same buffer range is already bound to the slot
+    void BindUniformBufferRange( Uint32 Index, const GLObjectWrappers::GLBufferObj &Buff, GLintptr Offset, GLsizeiptr Size );
     void BindImage( Uint32 Index, class TextureViewGLImpl *pTexView, GLint MipLevel, GLboolean IsLayered, GLint Layer, GLenum Access, GLenum Format );
     void EnsureMemoryBarrier(Uint32 RequiredBarriers, class AsyncWritableResource *pRes = nullptr);
     void SetPendingMemoryBarriers( Uint32 PendingBarriers );
@@ -99,6 +102,13 @@ private:
     Diligent::UniqueIdentifier m_FBOId = -1;
     std::vector< Diligent::UniqueIdentifier > m_BoundTextures;
     std::vector< Diligent::UniqueIdentifier > m_BoundSamplers;
+    struct BoundUniformBufferInfo
+    {
+        Diligent::UniqueIdentifier BufferID = -1;
+        GLintptr   Offset = 0;
+        GLsizeiptr Size   = 0; // Zero if the entire buffer is bound
+    };
+    std::vector< BoundUniformBufferInfo > m_BoundUniformBuffers;
     struct BoundImageInfo
     {
         Diligent::UniqueIdentifier InterfaceID = -1;
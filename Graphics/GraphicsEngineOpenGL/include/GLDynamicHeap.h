@@ -0,0 +1,99 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDynamicHeap class
+
+#include "BasicTypes.h"
+#include "RingBuffer.h"
+#include "RefCntAutoPtr.h"
+#include "Fence.h"
+#include "GLObjectWrapper.h"
+
+namespace Diligent
+{
+
+class RenderDeviceGLImpl;
+class DeviceContextGLImpl;
+
+/// Persistently mapped buffer that provides memory for dynamic uniform buffers of the immediate context
+
+/// The heap is one GL buffer created with glBufferStorage() and mapped once with persistent and
+/// coherent flags. Every Map(MAP_WRITE, MAP_FLAG_DISCARD) of a dynamic uniform buffer suballocates
+/// a new range from the ring buffer instead of calling glMapBufferRange(), and the range is bound
+/// with glBindBufferRange(). At the end of every frame, the heap signals a fence, and the space
+/// used by the frame is reused once the GPU has passed the fence.
+class GLDynamicHeap
+{
+public:
+    struct Allocation
+    {
+        size_t Offset = RingBuffer::InvalidOffset; ///< Offset from the start of the heap buffer
+        size_t Size   = 0;
+
+        bool IsValid()const { return Offset != RingBuffer::InvalidOffset; }
+    };
+
+    GLDynamicHeap(RenderDeviceGLImpl* pDeviceGL, Uint32 Size);
+    ~GLDynamicHeap();
+
+    GLDynamicHeap            (const GLDynamicHeap&) = delete;
+    GLDynamicHeap            (GLDynamicHeap&&)      = delete;
+    GLDynamicHeap& operator= (const GLDynamicHeap&) = delete;
+    GLDynamicHeap& operator= (GLDynamicHeap&&)      = delete;
+
+    /// Returns true if the device supports persistently mapped buffers
+    static bool IsSupported();
+
+    /// Allocates Size bytes aligned by GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. Returns
+    /// an invalid allocation if the heap has no free space that the GPU has finished using.
+    Allocation Allocate(Uint32 Size);
+
+    /// Signals the fence that guards the allocations made since the previous call,
+    /// and releases the space used by the frames that the GPU has completed.
+    void FinishFrame(DeviceContextGLImpl& Ctx);
+
+    void* GetCPUAddress(const Allocation& Alloc)const
+    {
+        VERIFY_EXPR(Alloc.IsValid() && Alloc.Offset + Alloc.Size <= m_RingBuffer.GetMaxSize());
+        return m_pCPUAddress + Alloc.Offset;
+    }
+
+    const GLObjectWrappers::GLBufferObj& GetGLBuffer()const { return m_GLBuffer; }
+
+    size_t GetUsedSize()const { return m_RingBuffer.GetUsedSize(); }
+
+private:
+    GLObjectWrappers::GLBufferObj m_GLBuffer;
+    Uint8*                        m_pCPUAddress = nullptr;
+    RingBuffer                    m_RingBuffer;
+    size_t                        m_Alignment = 256;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue = 1;
+};
+
+}
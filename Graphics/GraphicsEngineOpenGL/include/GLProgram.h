@@ -39,6 +39,7 @@ namespace Diligent
                            Uint32 NumVars, 
                            const StaticSamplerDesc *StaticSamplers,
                            Uint32 NumStaticSamplers,
+                           const GLProgramBindingRange& Bindings,
                            IObject &Owner);
 
         void BindConstantResources(IResourceMapping *pResourceMapping, Uint32 Flags);
@@ -27,6 +27,7 @@
 #include "ShaderBase.h"
 #include "SamplerGLImpl.h"
 #include "HashUtils.h"
+#include "ShaderVariableNameIndex.h"
 
 #ifdef _DEBUG
 #   define VERIFY_RESOURCE_BINDINGS
@@ -34,6 +35,8 @@
 
 namespace Diligent
 {
+    struct GLProgramBindingRange;
+
     class GLProgramResources
     {
     public:
@@ -50,7 +53,8 @@ namespace Diligent
                           const ShaderVariableDesc*  VariableDesc, 
                           Uint32                     NumVars,
                           const StaticSamplerDesc*   StaticSamplers,
-                          Uint32                     NumStaticSamplers);
+                          Uint32                     NumStaticSamplers,
+                          const GLProgramBindingRange& Bindings);
 
         void Clone(const GLProgramResources& SrcLayout, 
                    SHADER_VARIABLE_TYPE*     VarTypes, 
@@ -63,6 +67,7 @@ namespace Diligent
                                   size_t               _ArraySize,
                                   SHADER_VARIABLE_TYPE _VarType) :
                 Name      ( std::move(_Name) ),
+                NameHash  ( ShaderVariableNameIndex::HashName(Name.c_str()) ),
                 pResources(_ArraySize),
                 VarType   (_VarType)
             {
@@ -81,6 +86,8 @@ namespace Diligent
             }
 
             String                                      Name;
+            // Hash of the name that is used to look up resources in the resource mapping
+            const size_t                                NameHash;
             std::vector< RefCntAutoPtr<IDeviceObject> > pResources;
             const SHADER_VARIABLE_TYPE                  VarType;
         };
@@ -90,23 +97,29 @@ namespace Diligent
             UniformBufferInfo(String               _Name,
                               size_t               _ArraySize,
                               SHADER_VARIABLE_TYPE _VarType,
-                              GLint                _Index) :
+                              GLint                _Index,
+                              GLuint               _Binding) :
                 GLProgramVariableBase(std::move(_Name), _ArraySize, _VarType),
-                Index(_Index)
+                Index  (_Index),
+                Binding(_Binding)
             {}
 
             bool IsCompatibleWith(const UniformBufferInfo& UBI)const
             {
-                return Index == UBI.Index &&
+                return Index   == UBI.Index &&
+                       Binding == UBI.Binding &&
                        GLProgramVariableBase::IsCompatibleWith(UBI);
             }
 
             size_t GetHash()const
             {
-                return ComputeHash(Index, GLProgramVariableBase::GetHash());
+                return ComputeHash(Index, Binding, GLProgramVariableBase::GetHash());
             }
 
             const GLuint Index;
+            // Uniform buffer binding point of the first array element. It is assigned when
+            // the program is linked, and array elements use consecutive binding points.
+            GLuint       Binding;
         };
         std::vector<UniformBufferInfo>& GetUniformBlocks(){ return m_UniformBlocks; }
 
@@ -117,27 +130,33 @@ namespace Diligent
                         SHADER_VARIABLE_TYPE _VarType,
                         GLint                _Location,
                         GLenum               _Type,
+                        GLuint               _TextureUnit,
                         class SamplerGLImpl* _pStaticSampler) :
                 GLProgramVariableBase(std::move(_Name), _ArraySize, _VarType),
                 Location      (_Location),
                 Type          (_Type),
+                TextureUnit   (_TextureUnit),
                 pStaticSampler(_pStaticSampler)
             {}
 
             bool IsCompatibleWith(const SamplerInfo& SI)const
             {
-                return Location == SI.Location &&
-                       Type     == SI.Type &&
+                return Location    == SI.Location &&
+                       Type        == SI.Type &&
+                       TextureUnit == SI.TextureUnit &&
                        GLProgramVariableBase::IsCompatibleWith(SI);
             }
 
             size_t GetHash()const
             {
-                return ComputeHash(Location, Type, GLProgramVariableBase::GetHash());
+                return ComputeHash(Location, Type, TextureUnit, GLProgramVariableBase::GetHash());
             }
 
             const GLint                        Location;
             const GLenum                       Type;
+            // Texture unit of the first array element. It is assigned when the program
+            // is linked, and array elements use consecutive units.
+            GLuint                             TextureUnit;
             RefCntAutoPtr<class SamplerGLImpl> pStaticSampler;
         };
         std::vector<SamplerInfo>& GetSamplers(){ return m_Samplers; }
@@ -265,6 +284,7 @@ namespace Diligent
 
     private:
         void InitVariables(IObject &Owner);
+        void AssignBindings(class RenderDeviceGLImpl* pDeviceGLImpl, GLuint GLProgram, const GLProgramBindingRange& Bindings);
 
         std::vector<UniformBufferInfo> m_UniformBlocks;
         std::vector<SamplerInfo>       m_Samplers;
@@ -31,7 +31,7 @@ namespace Diligent
 class RenderDeviceGLESImpl final : public RenderDeviceGLImpl
 {
 public:
-    RenderDeviceGLESImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs );
+    RenderDeviceGLESImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs, Uint32 NumDeferredContexts );
 
     virtual void QueryInterface( const Diligent::INTERFACE_ID &IID, IObject **ppInterface );
 
@@ -30,6 +30,7 @@
 #include "FBOCache.h"
 #include "TexRegionRender.h"
 #include "EngineGLAttribs.h"
+#include "ShaderCache.h"
 
 enum class GPU_VENDOR
 {
@@ -48,6 +49,15 @@ struct GPUInfo
 namespace Diligent
 {
 
+/// Uniform buffer binding points and texture units available to the resources of a GL program
+struct GLProgramBindingRange
+{
+    Uint32 FirstUniformBuffer = 0;
+    Uint32 NumUniformBuffers  = 0;
+    Uint32 FirstTextureUnit   = 0;
+    Uint32 NumTextureUnits    = 0;
+};
+
 /// Implementation of the render device interface in OpenGL
 // RenderDeviceGLESImpl is inherited from RenderDeviceGLImpl
 class RenderDeviceGLImpl : public RenderDeviceBase<IGLDeviceBaseInterface>
@@ -55,7 +65,7 @@ class RenderDeviceGLImpl : public RenderDeviceBase<IGLDeviceBaseInterface>
 public:
     using TRenderDeviceBase = RenderDeviceBase<IGLDeviceBaseInterface>;
 
-    RenderDeviceGLImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs );
+    RenderDeviceGLImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs, Uint32 NumDeferredContexts );
     ~RenderDeviceGLImpl();
     virtual void QueryInterface( const Diligent::INTERFACE_ID &IID, IObject **ppInterface )override;
     
@@ -94,6 +104,15 @@ public:
     size_t GetCommandQueueCount()const { return 1; }
     Uint64 GetCommandQueueMask()const { return Uint64{1};}
 
+    // Returns null if the shader cache is not used
+    ShaderCache* GetShaderCache(){ return m_pShaderCache.get(); }
+
+    // Returns the binding points that are assigned to the resources of a program when it is linked.
+    // A separable program only gets the range of its shader stage, so that it can be combined with
+    // programs of other stages in any pipeline. SHADER_TYPE_UNKNOWN denotes a program that is linked
+    // from all shaders of a pipeline.
+    GLProgramBindingRange GetProgramBindingRange(SHADER_TYPE ShaderType)const;
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -117,7 +136,13 @@ protected:
 
     GPUInfo m_GPUInfo;
 
-    TexRegionRender m_TexRegionRender;
+    // Created after the device caps have been queried, as its shaders are linked with the binding ranges
+    std::unique_ptr<TexRegionRender> m_pTexRegionRender;
+
+    std::unique_ptr<ShaderCache> m_pShaderCache;
+
+    GLint m_MaxUniformBufferBindings = 0;
+    GLint m_MaxCombinedTextureUnits  = 0;
     
 private:
     virtual void TestTextureFormat( TEXTURE_FORMAT TexFormat )override final;
@@ -23,18 +23,32 @@
 
 #pragma once
 
-#include <cstring>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
 #include "GraphicsTypes.h"
 #include "Buffer.h"
 #include "InputLayout.h"
 #include "LockHelper.h"
-#include "HashUtils.h"
+#include "UniqueIdentifier.h"
 #include "DeviceContextBase.h"
 #include "BaseInterfacesGL.h"
 
 namespace Diligent
 {
 
+/// Cache of vertex array objects of one GL context.
+
+/// VAOs cannot be shared between GL contexts, so the device keeps one cache per native context.
+/// GetVAO() and GetEmptyVAO() must only be called by the thread that has the context current, and
+/// the lookup is not locked. The cache is a flat open-addressing hash table keyed by unique IDs
+/// of the pipeline state and the buffers, which, unlike pointers, are never reused. Thus entries
+/// that reference destroyed objects can never be hit, and OnDestroyBuffer()/OnDestroyPSO(), which
+/// may be called by any thread, only record the ID. The recorded entries are evicted by GetVAO() and
+/// PurgeStaleEntries() on the thread that owns the context, which is also the only thread that can
+/// delete VAOs. Entries that reference destroyed vertex or index buffers are evicted by the next call,
+/// since the VAOs keep the storage of the buffers alive. They are found through the lists of entries
+/// every buffer is referenced by and are erased in place. Other entries are evicted in batches.
 class VAOCache
 {
 public:
@@ -45,9 +59,8 @@ public:
     VAOCache(      VAOCache&&) = delete;
     VAOCache& operator = (const VAOCache&)  = delete;
     VAOCache& operator = (      VAOCache&&) = delete;
-    
-    
 
+    /// Returns the VAO for the pipeline state and the buffers. The reference is only valid until the next call.
     const GLObjectWrappers::GLVertexArrayObj& GetVAO( IPipelineState *pPSO,
                                                       IBuffer *pIndexBuffer,
                                                       VertexStreamInfo<class BufferGLImpl> VertexStreams[],
@@ -58,76 +71,83 @@ public:
     void OnDestroyBuffer(IBuffer *pBuffer);
     void OnDestroyPSO(IPipelineState *pPSO);
 
+    /// Evicts entries that reference destroyed objects if necessary. Called by GetVAO() and
+    /// once per frame by the immediate context, so that buffer storage is released without draws.
+    void PurgeStaleEntries();
+
 private:
-    // This structure is used as the key to find VAO
-    struct VAOCacheKey
+    // VAO encapsulates both input layout and all bound buffers.
+    // PSO uniquely defines the layout (attrib pointers, divisors, etc.),
+    // so we do not need to add individual layout elements to the key.
+    // The key needs to contain all bound buffers.
+    struct StreamKey
     {
-        VAOCacheKey(const IPipelineState* pso, const IBuffer* indBuffer) : 
-            pPSO(pso),
-            pIndexBuffer(indBuffer),
-            NumUsedSlots(0)
-        {}
-
-        // Note that the the pointers are used for ordering only
-        // They are not used to access the objects
-
-        // VAO encapsulates both input layout and all bound buffers
-        // PSO uniqly defines the layout (attrib pointers, divisors, etc.),
-        // so we do not need to add individual layout elements to the key
-        // The keey needs to contain all bound buffers
-        const IPipelineState* const pPSO;
-        const IBuffer* const pIndexBuffer;
-        Uint32 NumUsedSlots;
-        struct StreamAttribs
-        {
-            const IBuffer* pBuffer;
-            Uint32 Stride;
-            Uint32 Offset;
-        }Streams[MaxBufferSlots];
-        
-        mutable size_t Hash = 0;
-
-        bool operator == (const VAOCacheKey &Key)const
-        {
-            return pPSO            == Key.pPSO            &&
-                   pIndexBuffer    == Key.pIndexBuffer    &&
-                   NumUsedSlots    == Key.NumUsedSlots    &&
-                   std::memcmp(Streams, Key.Streams, sizeof(StreamAttribs) * NumUsedSlots) == 0;
-        }
+        UniqueIdentifier BufferId; // Zero for slots that are not used by the layout
+        Uint32           Stride;
+        Uint32           Offset;
     };
 
-    struct VAOCacheKeyHashFunc
+    struct CacheEntry
     {
-        std::size_t operator() ( const VAOCacheKey& Key )const
-        {
-            if (Key.Hash == 0)
-            {
-                std::size_t Seed = 0;
-                HashCombine(Seed, Key.pPSO, Key.NumUsedSlots);
-                if (Key.pIndexBuffer)
-                    HashCombine(Seed, Key.pIndexBuffer);
-                for (Uint32 slot = 0; slot < Key.NumUsedSlots; ++slot)
-                {
-                    auto &CurrStream = Key.Streams[slot];
-                    if (CurrStream.pBuffer)
-                    {
-                        HashCombine(Seed, CurrStream.pBuffer);
-                        HashCombine(Seed, CurrStream.Offset);
-                        HashCombine(Seed, CurrStream.Stride);
-                    }
-                }
-                Key.Hash = Seed;
-            }
-            return Key.Hash;
-        }
+        size_t           Hash          = 0;
+        UniqueIdentifier PSOId         = 0; // Zero marks an empty slot of the table
+        UniqueIdentifier IndexBufferId = 0;
+        // Identifies the entry in the lists of the buffers, as the entry may move within the table
+        Uint64           Serial        = 0;
+        Uint32           NumUsedSlots  = 0;
+        // Index of the first stream of the entry in m_Streams
+        Uint32           FirstStream   = 0;
+        GLObjectWrappers::GLVertexArrayObj VAO{false};
     };
 
+    // Returns the index of the entry with the key or of the empty slot where it should be inserted
+    size_t FindEntry(size_t Hash, UniqueIdentifier PSOId, UniqueIdentifier IndexBufferId, const StreamKey* Streams, Uint32 NumUsedSlots)const;
+
+    // Evicts entries that reference destroyed objects and rehashes remaining entries into a table of the given capacity
+    void PurgeAndRehash(size_t Capacity);
+
+    // Evicts entries that reference destroyed vertex and index buffers without rehashing the table
+    void EvictDestroyedVertexBuffers();
+
+    // Removes the entry from the lists of its buffers and erases it with backward-shift deletion
+    void EraseEntry(size_t Idx);
+
+    // Returns IDs of distinct vertex and index buffers referenced by the entry
+    Uint32 GetBufferIds(const CacheEntry& Entry, UniqueIdentifier BufferIds[])const;
+
+    // Reference to an entry that uses the buffer. The entry is found by probing the table from
+    // the hash for the serial number.
+    struct EntryRef
+    {
+        size_t Hash;
+        Uint64 Serial;
+    };
 
-    friend class RenderDeviceGLImpl;
-    ThreadingTools::LockFlag m_CacheLockFlag;
-    std::unordered_map<VAOCacheKey, GLObjectWrappers::GLVertexArrayObj, VAOCacheKeyHashFunc> m_Cache;
-    std::unordered_multimap<const IPipelineState*, VAOCacheKey> m_PSOToKey;
-    std::unordered_multimap<const IBuffer*, VAOCacheKey> m_BuffToKey;
+    // Entries of the open-addressing table with linear probing. The capacity is a power
+    // of two, and the table is at most half full.
+    std::vector<CacheEntry> m_Entries;
+    size_t                  m_NumEntries = 0;
+    std::vector<StreamKey>  m_Streams;
+    // Number of elements of m_Streams that belong to entries of the table. Streams of erased
+    // entries remain in the array until the table is rehashed.
+    size_t                  m_NumUsedStreams = 0;
+    Uint64                  m_NextEntrySerial = 1;
+
+    // Entries that reference every vertex and index buffer
+    std::unordered_map<UniqueIdentifier, std::vector<EntryRef>> m_BufferEntries;
+
+    // Protects the lists of destroyed objects only
+    ThreadingTools::LockFlag      m_CacheLockFlag;
+    std::vector<UniqueIdentifier> m_DestroyedVertexBuffers;
+    std::vector<UniqueIdentifier> m_DestroyedBuffers;
+    std::vector<UniqueIdentifier> m_DestroyedPSOs;
+    // Incremented every time a vertex or index buffer is destroyed, and every time another object
+    // is destroyed. Compared against the purged generations by PurgeStaleEntries() to find out without
+    // locking whether destroyed objects have not yet been purged.
+    std::atomic<Uint64> m_DestroyedVertexBuffersGeneration{0};
+    std::atomic<Uint64> m_DestroyedObjectsGeneration{0};
+    Uint64              m_PurgedVertexBuffersGeneration = 0;
+    Uint64              m_PurgedGeneration              = 0;
 
     // Any draw command fails if no VAO is bound. We will use this empty
     // VAO for draw commands with null input layout, such as these that
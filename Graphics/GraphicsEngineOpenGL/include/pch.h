@@ -34,6 +34,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <limits>
 
 #if PLATFORM_WIN32
 
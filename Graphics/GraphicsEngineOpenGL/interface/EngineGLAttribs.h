@@ -44,5 +44,14 @@ namespace Diligent
         /// For linux platform only, this is the pointer to the display
         void *pDisplay = nullptr;
 #endif
+
+        /// Path to the file of the persistent shader cache that stores HLSL shaders
+        /// converted to GLSL. If null, the cache is not used.
+        const Char* ShaderCacheFilePath = nullptr;
+
+        /// Size of the persistently mapped buffer that the immediate context suballocates
+        /// to map dynamic uniform buffers. If zero, or if the device does not support
+        /// GL_ARB_buffer_storage, dynamic buffers are mapped with glMapBufferRange().
+        Uint32 DynamicHeapSize = 8 << 20;
     };
 }
@@ -63,14 +63,16 @@ class IEngineFactoryOpenGL
 public:
     virtual void CreateDeviceAndSwapChainGL(const EngineGLAttribs& CreationAttribs,
                                             IRenderDevice **ppDevice,
-                                            IDeviceContext **ppImmediateContext,
+                                            IDeviceContext **ppContexts,
                                             const SwapChainDesc& SCDesc,
-                                            ISwapChain **ppSwapChain ) = 0;
+                                            ISwapChain **ppSwapChain,
+                                            Uint32 NumDeferredContexts ) = 0;
     virtual void CreateHLSL2GLSLConverter(IHLSL2GLSLConverter **ppConverter) = 0;
     
     virtual void AttachToActiveGLContext( const EngineGLAttribs& CreationAttribs,
                                           IRenderDevice **ppDevice,
-                                          IDeviceContext **ppImmediateContext ) = 0;
+                                          IDeviceContext **ppContexts,
+                                          Uint32 NumDeferredContexts ) = 0;
 };
 
 
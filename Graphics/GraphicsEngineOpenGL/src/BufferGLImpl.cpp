@@ -41,6 +41,11 @@ static bool GetUseMapWriteDiscardBugWA(RenderDeviceGLImpl *pDeviceGL)
     return pDeviceGL->GetGPUInfo().Vendor == GPU_VENDOR::INTEL;
 }
 
+static bool IsDynamicUniformBuffer(const BufferDesc& Desc)
+{
+    return Desc.Usage == USAGE_DYNAMIC && Desc.BindFlags == BIND_UNIFORM_BUFFER;
+}
+
 static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 {
     GLenum Target = GL_ARRAY_BUFFER;
@@ -77,7 +82,8 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters *pRefCounters,
     m_GlBuffer(true), // Create buffer immediately
     m_uiMapTarget(0),
     m_GLUsageHint(UsageToGLUsage(BuffDesc.Usage)),
-    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL))
+    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL)),
+    m_bIsDynamicUniformBuffer(IsDynamicUniformBuffer(BuffDesc))
 {
     if( BuffDesc.Usage == USAGE_STATIC && BuffData.pData == nullptr )
         LOG_ERROR_AND_THROW("Static buffer must be initialized with data at creation time");
@@ -173,7 +179,8 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters *pRefCounters,
     m_GlBuffer(true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)),
     m_uiMapTarget(0),
     m_GLUsageHint(UsageToGLUsage(BuffDesc.Usage)),
-    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL))
+    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL)),
+    m_bIsDynamicUniformBuffer(IsDynamicUniformBuffer(BuffDesc))
 {
 }
 
@@ -189,6 +196,11 @@ void BufferGLImpl :: UpdateData(IDeviceContext *pContext, Uint32 Offset, Uint32
     TBufferBase::UpdateData( pContext, Offset, Size, pData );
 
     auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
+    if (pDeviceContextGL->IsDeferred())
+    {
+        pDeviceContextGL->RecordUpdateBuffer(this, Offset, Size, pData);
+        return;
+    }
 
     BufferMemoryBarrier(
         GL_BUFFER_UPDATE_BARRIER_BIT,// Reads or writes to buffer objects via any OpenGL API functions that allow 
@@ -212,6 +224,18 @@ void BufferGLImpl :: CopyData(IDeviceContext *pContext, IBuffer *pSrcBuffer, Uin
 
     auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
     auto *pSrcBufferGL = static_cast<BufferGLImpl*>( pSrcBuffer );
+    if (pDeviceContextGL->IsDeferred())
+    {
+        pDeviceContextGL->RecordCopyBuffer(this, pSrcBufferGL, SrcOffset, DstOffset, Size);
+        return;
+    }
+
+    // Both buffers must hold their contents in their own storage
+    if (m_DynamicAllocation.IsValid())
+        pDeviceContextGL->RetireDynamicAllocation(*this);
+    if (pSrcBufferGL->m_DynamicAllocation.IsValid())
+        pDeviceContextGL->RetireDynamicAllocation(*pSrcBufferGL);
+
     BufferMemoryBarrier(
         GL_BUFFER_UPDATE_BARRIER_BIT,// Reads or writes to buffer objects via any OpenGL API functions that allow 
                                      // modifying their contents will reflect data written by shaders prior to the barrier. 
@@ -238,9 +262,28 @@ void BufferGLImpl :: CopyData(IDeviceContext *pContext, IBuffer *pSrcBuffer, Uin
 void BufferGLImpl :: Map(IDeviceContext *pContext, MAP_TYPE MapType, Uint32 MapFlags, PVoid &pMappedData)
 {
     TBufferBase::Map( pContext, MapType, MapFlags, pMappedData );
-    VERIFY( m_uiMapTarget == 0, "Buffer is already mapped");
 
     auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
+    if (pDeviceContextGL->IsDeferred())
+    {
+        // The data is written to the command list memory and is copied to the buffer when
+        // the command list is executed
+        pMappedData = pDeviceContextGL->RecordMapBuffer(this, MapType, MapFlags);
+        return;
+    }
+
+    if (m_bIsDynamicUniformBuffer && MapType == MAP_WRITE)
+    {
+        // Returns null if the context has no dynamic heap or if the heap is full
+        pMappedData = pDeviceContextGL->MapDynamicUniformBuffer(*this, MapFlags);
+        if (pMappedData != nullptr)
+            return;
+    }
+
+    VERIFY( m_uiMapTarget == 0, "Buffer is already mapped");
+    if (m_DynamicAllocation.IsValid())
+        pDeviceContextGL->RetireDynamicAllocation(*this);
+
     BufferMemoryBarrier(
         GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT,// Access by the client to persistent mapped regions of buffer 
                                             // objects will reflect data written by shaders prior to the barrier. 
@@ -322,6 +365,20 @@ void BufferGLImpl::Unmap( IDeviceContext *pContext, MAP_TYPE MapType, Uint32 Map
 {
     TBufferBase::Unmap(pContext, MapType, MapFlags);
 
+    auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
+    if (pDeviceContextGL->IsDeferred())
+    {
+        pDeviceContextGL->RecordUnmapBuffer(this, MapType, MapFlags);
+        return;
+    }
+
+    if (m_uiMapTarget == 0 && m_DynamicAllocation.IsValid())
+    {
+        // The buffer was mapped through the dynamic heap, which is coherently mapped
+        // all the time, so there is nothing to do
+        return;
+    }
+
     glBindBuffer(m_uiMapTarget, m_GlBuffer);
     auto Result = glUnmapBuffer(m_uiMapTarget);
     // glUnmapBuffer() returns TRUE unless data values in the buffer�s data store have
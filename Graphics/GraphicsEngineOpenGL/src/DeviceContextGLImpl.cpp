@@ -45,19 +45,235 @@
 #include "PipelineStateGLImpl.h"
 #include "FenceGLImpl.h"
 #include "ShaderResourceBindingGLImpl.h"
+#include "CommandListGLImpl.h"
+#include "EngineGLAttribs.h"
 
 using namespace std;
 
 namespace Diligent
 {
-    DeviceContextGLImpl::DeviceContextGLImpl( IReferenceCounters *pRefCounters, class RenderDeviceGLImpl *pDeviceGL, bool bIsDeferred ) : 
+    namespace
+    {
+        // Commands recorded by deferred contexts. Every command is a POD structure; arrays
+        // and data are stored in the parameter arena of the command stream, and the stream
+        // keeps strong references to all objects the command refers to.
+        enum class GLCommandId : Uint16
+        {
+            SetPipelineState,
+            CommitShaderResources,
+            SetStencilRef,
+            SetBlendFactors,
+            SetVertexBuffers,
+            SetIndexBuffer,
+            InvalidateState,
+            SetViewports,
+            SetScissorRects,
+            SetRenderTargets,
+            Draw,
+            DispatchCompute,
+            ClearDepthStencil,
+            ClearRenderTarget,
+            UpdateBuffer,
+            CopyBuffer,
+            WriteBuffer,
+            UpdateTexture,
+            CopyTexture,
+            GenerateMips
+        };
+
+        struct SetPipelineStateCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetPipelineState;
+            PipelineStateGLImpl* pPSO;
+        };
+
+        struct CommitShaderResourcesCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::CommitShaderResources;
+            const DeviceContextGLImpl::ProgramResourceBinding* pBindings;
+            Uint32                                             NumBindings;
+        };
+
+        struct SetStencilRefCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetStencilRef;
+            Uint32 StencilRef;
+        };
+
+        struct SetBlendFactorsCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetBlendFactors;
+            float BlendFactors[4];
+        };
+
+        struct SetVertexBuffersCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetVertexBuffers;
+            IBuffer**     ppBuffers;
+            const Uint32* pOffsets;
+            Uint32        StartSlot;
+            Uint32        NumBuffersSet;
+            Uint32        Flags;
+        };
+
+        struct SetIndexBufferCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetIndexBuffer;
+            IBuffer* pIndexBuffer;
+            Uint32   ByteOffset;
+        };
+
+        struct InvalidateStateCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::InvalidateState;
+        };
+
+        struct SetViewportsCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetViewports;
+            const Viewport* pViewports;
+            Uint32          NumViewports;
+            Uint32          RTWidth;
+            Uint32          RTHeight;
+        };
+
+        struct SetScissorRectsCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetScissorRects;
+            const Rect* pRects;
+            Uint32      NumRects;
+            Uint32      RTWidth;
+            Uint32      RTHeight;
+        };
+
+        struct SetRenderTargetsCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::SetRenderTargets;
+            ITextureView** ppRenderTargets;
+            ITextureView*  pDepthStencil;
+            Uint32         NumRenderTargets;
+        };
+
+        struct DrawCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::Draw;
+            DeviceContextGLImpl::GLDrawAttribs Attribs;
+        };
+
+        struct DispatchComputeCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::DispatchCompute;
+            DispatchComputeAttribs Attribs;
+        };
+
+        struct ClearDepthStencilCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::ClearDepthStencil;
+            ITextureView* pView;
+            Uint32        ClearFlags;
+            float         fDepth;
+            Uint8         Stencil;
+        };
+
+        struct ClearRenderTargetCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::ClearRenderTarget;
+            ITextureView* pView;
+            float         RGBA[4];
+            bool          DefaultColor;
+        };
+
+        struct UpdateBufferCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::UpdateBuffer;
+            BufferGLImpl* pBuffer;
+            const void*   pData;
+            Uint32        Offset;
+            Uint32        Size;
+        };
+
+        struct CopyBufferCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::CopyBuffer;
+            BufferGLImpl* pDstBuffer;
+            BufferGLImpl* pSrcBuffer;
+            Uint32        SrcOffset;
+            Uint32        DstOffset;
+            Uint32        Size;
+        };
+
+        // Contents of a buffer that was mapped with MAP_FLAG_DISCARD
+        struct WriteBufferCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::WriteBuffer;
+            BufferGLImpl* pBuffer;
+            const void*   pData;
+            Uint32        MapFlags;
+        };
+
+        struct UpdateTextureCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::UpdateTexture;
+            TextureBaseGL*    pTexture;
+            Uint32            MipLevel;
+            Uint32            Slice;
+            Box               DstBox;
+            TextureSubResData SubresData;
+        };
+
+        struct CopyTextureCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::CopyTexture;
+            TextureBaseGL* pDstTexture;
+            TextureBaseGL* pSrcTexture;
+            Uint32         SrcMipLevel;
+            Uint32         SrcSlice;
+            Box            SrcBox;
+            Uint32         DstMipLevel;
+            Uint32         DstSlice;
+            Uint32         DstX;
+            Uint32         DstY;
+            Uint32         DstZ;
+        };
+
+        struct GenerateMipsCmd
+        {
+            static constexpr GLCommandId Id = GLCommandId::GenerateMips;
+            TextureViewGLImpl* pTexView;
+        };
+    }
+
+    DeviceContextGLImpl::DeviceContextGLImpl( IReferenceCounters *pRefCounters, class RenderDeviceGLImpl *pDeviceGL, const EngineGLAttribs &EngineAttribs, bool bIsDeferred ) : 
         TDeviceContextBase(pRefCounters, pDeviceGL, bIsDeferred),
         m_ContextState(pDeviceGL),
         m_CommitedResourcesTentativeBarriers(0),
+        m_CmdListAllocator(GetRawAllocator(), sizeof(CommandListGLImpl), 64 ),
         m_DefaultFBO(false)
     {
         m_BoundWritableTextures.reserve( 16 );
         m_BoundWritableBuffers.reserve( 16 );
+        m_ResourceBindings.reserve( 32 );
+
+        // Deferred contexts never call OpenGL, and the buffers they map are written
+        // by the immediate context when the command list is executed
+        if (!bIsDeferred && EngineAttribs.DynamicHeapSize != 0)
+        {
+            if (GLDynamicHeap::IsSupported())
+            {
+                m_pDynamicHeap.reset( new GLDynamicHeap(pDeviceGL, EngineAttribs.DynamicHeapSize) );
+                m_MappedDynamicBuffers.reserve( 64 );
+                m_BoundDynamicUniformBuffers.reserve( 16 );
+            }
+            else
+                LOG_INFO_MESSAGE("Persistently mapped buffers are not supported. Dynamic uniform buffers will be mapped with glMapBufferRange()");
+        }
+    }
+
+    DeviceContextGLImpl::~DeviceContextGLImpl()
+    {
+        // Buffers that outlive the context must keep their contents
+        if (m_pDynamicHeap)
+            RetireDynamicBuffers();
     }
 
     IMPLEMENT_QUERY_INTERFACE( DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase )
@@ -68,6 +284,13 @@ namespace Diligent
         auto* pPipelineStateGLImpl = ValidatedCast<PipelineStateGLImpl>(pPipelineState);
         TDeviceContextBase::SetPipelineState(pPipelineStateGLImpl, 0 /*Dummy*/);
 
+        if (m_bIsDeferred)
+        {
+            m_Commands.AddCommand<SetPipelineStateCmd>().pPSO = pPipelineStateGLImpl;
+            m_Commands.AddReference(pPipelineStateGLImpl);
+            return;
+        }
+
         const auto& Desc = pPipelineStateGLImpl->GetDesc();
         if (Desc.IsComputePipeline)
         {
@@ -135,11 +358,34 @@ namespace Diligent
         if(!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, Flags, 0))
             return;
 
+        m_ResourceBindings.clear();
+        GatherProgramResources( pShaderResourceBinding, m_ResourceBindings );
+
+        if (m_bIsDeferred)
+        {
+            // Resources are resolved when the command is recorded, so that later changes
+            // of the shader resource binding do not affect the command list
+            auto& Cmd = m_Commands.AddCommand<CommitShaderResourcesCmd>();
+            Cmd.pBindings   = m_Commands.CopyParams(m_ResourceBindings.data(), m_ResourceBindings.size());
+            Cmd.NumBindings = static_cast<Uint32>(m_ResourceBindings.size());
+            for (const auto& Binding : m_ResourceBindings)
+            {
+                m_Commands.AddReference(Binding.pResource);
+                m_Commands.AddReference(Binding.pSampler);
+            }
+            return;
+        }
+
+        CommitProgramResources( m_ResourceBindings.data(), m_ResourceBindings.size() );
+    }
+
+    void DeviceContextGLImpl::CommitProgramResources( const ProgramResourceBinding *pBindings, size_t NumBindings )
+    {
         if(m_CommitedResourcesTentativeBarriers != 0)
             LOG_INFO_MESSAGE("Not all tentative resource barriers have been executed since the last call to CommitShaderResources(). Did you forget to call Draw()/DispatchCompute() ?");
 
         m_CommitedResourcesTentativeBarriers = 0;
-        BindProgramResources( m_CommitedResourcesTentativeBarriers, pShaderResourceBinding );
+        ApplyProgramResources( pBindings, NumBindings, m_CommitedResourcesTentativeBarriers );
         // m_CommitedResourcesTentativeBarriers will contain memory barriers that will be required 
         // AFTER the actual draw/dispatch command is executed. Before that they have no meaning
     }
@@ -148,6 +394,11 @@ namespace Diligent
     {
         if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
         {
+            if (m_bIsDeferred)
+            {
+                m_Commands.AddCommand<SetStencilRefCmd>().StencilRef = StencilRef;
+                return;
+            }
             m_ContextState.SetStencilRef(GL_FRONT, StencilRef);
             m_ContextState.SetStencilRef(GL_BACK, StencilRef);
         }
@@ -157,6 +408,13 @@ namespace Diligent
     {
         if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
         {
+            if (m_bIsDeferred)
+            {
+                auto& Cmd = m_Commands.AddCommand<SetBlendFactorsCmd>();
+                for (int i = 0; i < 4; ++i)
+                    Cmd.BlendFactors[i] = m_BlendFactors[i];
+                return;
+            }
             m_ContextState.SetBlendFactors(m_BlendFactors);
         }
     }
@@ -164,6 +422,18 @@ namespace Diligent
     void DeviceContextGLImpl::SetVertexBuffers( Uint32 StartSlot, Uint32 NumBuffersSet, IBuffer **ppBuffers, Uint32 *pOffsets, Uint32 Flags )
     {
         TDeviceContextBase::SetVertexBuffers( StartSlot, NumBuffersSet, ppBuffers, pOffsets, Flags );
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<SetVertexBuffersCmd>();
+            Cmd.ppBuffers     = m_Commands.CopyParams(ppBuffers, NumBuffersSet);
+            Cmd.pOffsets      = pOffsets != nullptr ? m_Commands.CopyParams(pOffsets, NumBuffersSet) : nullptr;
+            Cmd.StartSlot     = StartSlot;
+            Cmd.NumBuffersSet = NumBuffersSet;
+            Cmd.Flags         = Flags;
+            for (Uint32 buff = 0; buff < NumBuffersSet; ++buff)
+                m_Commands.AddReference(ppBuffers[buff]);
+            return;
+        }
         m_bVAOIsUpToDate = false;
     }
 
@@ -171,15 +441,30 @@ namespace Diligent
     {
         TDeviceContextBase::InvalidateState();
 
+        if (m_bIsDeferred)
+        {
+            m_Commands.AddCommand<InvalidateStateCmd>();
+            return;
+        }
+
         m_ContextState.Invalidate();
         m_BoundWritableTextures.clear();
         m_BoundWritableBuffers.clear();
+        m_BoundDynamicUniformBuffers.clear();
         m_bVAOIsUpToDate = false;
     }
 
     void DeviceContextGLImpl::SetIndexBuffer( IBuffer *pIndexBuffer, Uint32 ByteOffset )
     {
         TDeviceContextBase::SetIndexBuffer( pIndexBuffer, ByteOffset );
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<SetIndexBufferCmd>();
+            Cmd.pIndexBuffer = pIndexBuffer;
+            Cmd.ByteOffset   = ByteOffset;
+            m_Commands.AddReference(pIndexBuffer);
+            return;
+        }
         m_bVAOIsUpToDate = false;
     }
 
@@ -187,6 +472,16 @@ namespace Diligent
     {
         TDeviceContextBase::SetViewports( NumViewports, pViewports, RTWidth, RTHeight  );
 
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<SetViewportsCmd>();
+            Cmd.pViewports   = m_Commands.CopyParams(m_Viewports, m_NumViewports);
+            Cmd.NumViewports = m_NumViewports;
+            Cmd.RTWidth      = RTWidth;
+            Cmd.RTHeight     = RTHeight;
+            return;
+        }
+
         VERIFY( NumViewports == m_NumViewports, "Unexpected number of viewports" );
         if( NumViewports == 1 )
         {
@@ -250,6 +545,16 @@ namespace Diligent
     {
         TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<SetScissorRectsCmd>();
+            Cmd.pRects   = m_Commands.CopyParams(m_ScissorRects, m_NumScissorRects);
+            Cmd.NumRects = m_NumScissorRects;
+            Cmd.RTWidth  = RTWidth;
+            Cmd.RTHeight = RTHeight;
+            return;
+        }
+
         VERIFY( NumRects == m_NumScissorRects, "Unexpected number of scissor rects" );
         if( NumRects == 1 )
         {
@@ -332,11 +637,37 @@ namespace Diligent
     void DeviceContextGLImpl::SetRenderTargets( Uint32 NumRenderTargets, ITextureView *ppRenderTargets[], ITextureView *pDepthStencil )
     {
         if( TDeviceContextBase::SetRenderTargets( NumRenderTargets, ppRenderTargets, pDepthStencil ) )
+        {
+            if (m_bIsDeferred)
+            {
+                auto& Cmd = m_Commands.AddCommand<SetRenderTargetsCmd>();
+                Cmd.ppRenderTargets  = m_Commands.CopyParams(ppRenderTargets, NumRenderTargets);
+                Cmd.pDepthStencil    = pDepthStencil;
+                Cmd.NumRenderTargets = NumRenderTargets;
+                for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+                    m_Commands.AddReference(ppRenderTargets[rt]);
+                m_Commands.AddReference(pDepthStencil);
+
+                // CommitRenderTargets() resets the viewport when the command is executed
+                Uint32 RTWidth = 0, RTHeight = 0;
+                TDeviceContextBase::SetViewports(1, nullptr, RTWidth, RTHeight);
+                return;
+            }
             CommitRenderTargets();
+        }
     }
 
     void DeviceContextGLImpl::BindProgramResources( Uint32 &NewMemoryBarriers, IShaderResourceBinding *pResBinding )
     {
+        m_ResourceBindings.clear();
+        GatherProgramResources( pResBinding, m_ResourceBindings );
+        ApplyProgramResources( m_ResourceBindings.data(), m_ResourceBindings.size(), NewMemoryBarriers );
+    }
+
+    void DeviceContextGLImpl::GatherProgramResources( IShaderResourceBinding *pResBinding, std::vector<ProgramResourceBinding> &Bindings )
+    {
+        // This method does not call OpenGL, so that deferred contexts can resolve
+        // the resources on any thread
         auto *pRenderDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
         if (!m_pPipelineState)
         {
@@ -347,27 +678,11 @@ namespace Diligent
 
         const auto &DeviceCaps = pRenderDeviceGL->GetDeviceCaps();
         auto &Prog = m_pPipelineState->GetGLProgram();
-        auto &Pipeline = m_pPipelineState->GetGLProgramPipeline( m_ContextState.GetCurrentGLContext() );
-        VERIFY( Prog ^ Pipeline, "Only one of program or pipeline can be specified" );
-        if( !(Prog || Pipeline) )
-        {
-            LOG_ERROR_MESSAGE("No program/program pipeline is set for the draw call");
-            return;
-        }
         auto ProgramPipelineSupported = DeviceCaps.bSeparableProgramSupported;
 
-        // WARNING: glUseProgram() overrides glBindProgramPipeline(). That is, if you have a program in use and
-        // a program pipeline bound, all rendering will use the program that is in use, not the pipeline programs!!!
-        // So make sure that glUseProgram(0) has been called if pipeline is in use
-        m_ContextState.SetProgram( Prog );
-        if( ProgramPipelineSupported )
-            m_ContextState.SetPipeline( Pipeline );
-
+        // Uniform block bindings and sampler uniforms are assigned once when the program is linked
+        // (see GLProgramResources::AssignBindings()), so only the objects need to be bound.
         size_t NumPrograms = ProgramPipelineSupported ? m_pPipelineState->GetNumShaders() : 1;
-        GLuint UniformBuffBindPoint = 0;
-        GLuint TextureIndex = 0;
-        m_BoundWritableTextures.clear();
-        m_BoundWritableBuffers.clear();
         for( size_t ProgNum = 0; ProgNum < NumPrograms; ++ProgNum )
         {
             auto *pShaderGL = static_cast<ShaderGLImpl*>(m_pPipelineState->GetShaders()[ProgNum]);
@@ -385,8 +700,15 @@ namespace Diligent
 #ifdef VERIFY_RESOURCE_BINDINGS
                 ProgResources.dbgVerifyResourceBindings();
 #endif
-                
-                GLuint GLProgID = GLProgramObj;
+
+#define LOG_MISSING_BINDING(VarType, Res, ArrInd)\
+                do{                                      \
+                    if(Res->pResources.size()>1)         \
+                        LOG_ERROR_MESSAGE( "No ", VarType, " is bound to \"", Res->Name, '[', ArrInd, "]\" variable in shader \"", pShaderGL->GetDesc().Name, "\"" );\
+                    else                                 \
+                        LOG_ERROR_MESSAGE( "No ", VarType, " is bound to \"", Res->Name, "\" variable in shader \"", pShaderGL->GetDesc().Name, "\"" );\
+                }while(false)
+
                 auto &UniformBlocks = ProgResources.GetUniformBlocks();
                 for( auto it = UniformBlocks.begin(); it != UniformBlocks.end(); ++it )
                 {
@@ -394,34 +716,9 @@ namespace Diligent
                     {
                         auto& Resource = it->pResources[ArrInd];
                         if (Resource)
-                        {
-                            auto *pBufferOGL = Resource.RawPtr<BufferGLImpl>();
-                            pBufferOGL->BufferMemoryBarrier(
-                                GL_UNIFORM_BARRIER_BIT,// Shader uniforms sourced from buffer objects after the barrier 
-                                                       // will reflect data written by shaders prior to the barrier
-                                m_ContextState);
-
-                            glBindBufferBase(GL_UNIFORM_BUFFER, UniformBuffBindPoint, pBufferOGL->m_GlBuffer);
-                            CHECK_GL_ERROR("Failed to bind uniform buffer");
-                            //glBindBufferRange(GL_UNIFORM_BUFFER, it->Index, pBufferOGL->m_GlBuffer, 0, pBufferOGL->GetDesc().uiSizeInBytes);
-
-                            glUniformBlockBinding(GLProgID, it->Index + ArrInd, UniformBuffBindPoint);
-                            CHECK_GL_ERROR("glUniformBlockBinding() failed");
-
-                            ++UniformBuffBindPoint;
-                        }
+                            Bindings.push_back( ProgramResourceBinding{ProgramResourceBinding::UniformBuffer, it->Binding + ArrInd, Resource.RawPtr(), nullptr} );
                         else
-                        {
-#define LOG_MISSING_BINDING(VarType, Res, ArrInd)\
-                            do{                                      \
-                                if(Res->pResources.size()>1)         \
-                                    LOG_ERROR_MESSAGE( "No ", VarType, " is bound to \"", Res->Name, '[', ArrInd, "]\" variable in shader \"", pShaderGL->GetDesc().Name, "\"" );\
-                                else                                 \
-                                    LOG_ERROR_MESSAGE( "No ", VarType, " is bound to \"", Res->Name, "\" variable in shader \"", pShaderGL->GetDesc().Name, "\"" );\
-                            }while(false)
-
                             LOG_MISSING_BINDING("uniform buffer", it, ArrInd);
-                        }
                     }
                 }
 
@@ -433,36 +730,15 @@ namespace Diligent
                         auto &Resource = it->pResources[ArrInd];
                         if( Resource )
                         {
+                            const auto TextureIndex = it->TextureUnit + ArrInd;
                             if( it->Type == GL_SAMPLER_BUFFER ||
                                 it->Type == GL_INT_SAMPLER_BUFFER ||
                                 it->Type == GL_UNSIGNED_INT_SAMPLER_BUFFER )
                             {
-                                auto *pBufViewOGL = Resource.RawPtr<BufferViewGLImpl>();
-                                auto *pBuffer = pBufViewOGL->GetBuffer();
-
-                                m_ContextState.BindTexture( TextureIndex, GL_TEXTURE_BUFFER, pBufViewOGL->GetTexBufferHandle() );
-                                m_ContextState.BindSampler( TextureIndex, GLObjectWrappers::GLSamplerObj(false) ); // Use default texture sampling parameters
-
-                                CHECK_DYNAMIC_TYPE( BufferGLImpl, pBuffer );
-                                static_cast<BufferGLImpl*>(pBuffer)->BufferMemoryBarrier(
-                                    GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
-                                                                  // memory via buffer textures, after the barrier will reflect data 
-                                                                  // written by shaders prior to the barrier
-                                    m_ContextState);
+                                Bindings.push_back( ProgramResourceBinding{ProgramResourceBinding::TexelBuffer, TextureIndex, Resource.RawPtr(), nullptr} );
                             }
                             else
                             {
-                                auto *pTexViewOGL = Resource.RawPtr<TextureViewGLImpl>();
-                                m_ContextState.BindTexture( TextureIndex, pTexViewOGL->GetBindTarget(), pTexViewOGL->GetHandle() );
-
-                                auto *pTexture = pTexViewOGL->GetTexture();
-                                CHECK_DYNAMIC_TYPE( TextureBaseGL, pTexture );
-                                static_cast<TextureBaseGL*>(pTexture)->TextureMemoryBarrier(
-                                    GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
-                                                                  // memory via buffer textures, after the barrier will reflect data 
-                                                                  // written by shaders prior to the barrier
-                                    m_ContextState);
-
                                 SamplerGLImpl *pSamplerGL = nullptr;
                                 if (it->pStaticSampler)
                                 {
@@ -470,31 +746,11 @@ namespace Diligent
                                 }
                                 else
                                 {
-                                    auto pSampler = pTexViewOGL->GetSampler();
+                                    auto pSampler = Resource.RawPtr<TextureViewGLImpl>()->GetSampler();
                                     pSamplerGL = ValidatedCast<SamplerGLImpl>( pSampler );
                                 }
-                            
-                                if( pSamplerGL )
-                                {
-                                    m_ContextState.BindSampler( TextureIndex, pSamplerGL->GetHandle() );
-                                }
+                                Bindings.push_back( ProgramResourceBinding{ProgramResourceBinding::Texture, TextureIndex, Resource.RawPtr(), pSamplerGL} );
                             }
-
-                            // Texture is now bound to texture slot TextureIndex.
-                            // We now need to set the program uniform to use that slot
-                            if( ProgramPipelineSupported )
-                            {
-                                // glProgramUniform1i does not require program to be bound to the pipeline
-                                glProgramUniform1i( GLProgramObj, it->Location + ArrInd, TextureIndex );
-                            }
-                            else
-                            {
-                                // glUniform1i requires program to be bound to the pipeline
-                                glUniform1i( it->Location + ArrInd, TextureIndex );
-                            }
-                            CHECK_GL_ERROR( "Failed to bind sampler uniform to texture slot" );
-
-                            ++TextureIndex;
                         }
                         else
                         {
@@ -511,61 +767,9 @@ namespace Diligent
                     {
                         auto &Resource = it->pResources[ArrInd];
                         if( Resource )
-                        {
-                            auto *pTexViewOGL = Resource.RawPtr<TextureViewGLImpl>();
-                            const auto &ViewDesc = pTexViewOGL->GetDesc();
-
-                            if( ViewDesc.AccessFlags & UAV_ACCESS_FLAG_WRITE )
-                            {
-                                auto *pTex = pTexViewOGL->GetTexture();
-                                CHECK_DYNAMIC_TYPE( TextureBaseGL, pTex );
-                                auto *pTexGL = static_cast<TextureBaseGL*>(pTex);
-
-                                pTexGL->TextureMemoryBarrier(
-                                    GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,// Memory accesses using shader image load, store, and atomic built-in 
-                                                                       // functions issued after the barrier will reflect data written by shaders 
-                                                                       // prior to the barrier. Additionally, image stores and atomics issued after 
-                                                                       // the barrier will not execute until all memory accesses (e.g., loads, 
-                                                                       // stores, texture fetches, vertex fetches) initiated prior to the barrier 
-                                                                       // complete.
-                                    m_ContextState);
-                                // We cannot set pending memory barriers here, because
-                                // if some texture is bound twice, the logic will fail
-                                m_BoundWritableTextures.push_back( pTexGL );
-                            }
-
-        #ifdef _DEBUG
-                            // Check that the texure being bound has immutable storage
-                            {
-                                m_ContextState.BindTexture( -1, pTexViewOGL->GetBindTarget(), pTexViewOGL->GetHandle() );
-                                GLint IsImmutable = 0;
-                                glGetTexParameteriv( pTexViewOGL->GetBindTarget(), GL_TEXTURE_IMMUTABLE_FORMAT, &IsImmutable );
-                                CHECK_GL_ERROR( "glGetTexParameteriv() failed" );
-                                VERIFY( IsImmutable, "Only immutable textures can be bound to pipeline using glBindImageTexture()" );
-                                m_ContextState.BindTexture( -1, pTexViewOGL->GetBindTarget(), GLObjectWrappers::GLTextureObj(false) );
-                            }
-        #endif
-                            auto GlTexFormat = TexFormatToGLInternalTexFormat( ViewDesc.Format );
-                            // Note that if a format qulifier is specified in the shader, the format
-                            // must match it
-
-                            GLboolean Layered = ViewDesc.NumArraySlices > 1 && ViewDesc.FirstArraySlice == 0;
-                            // If "layered" is TRUE, the entire Mip level is bound. Layer parameter is ignored in this
-                            // case. If "layered" is FALSE, only the single layer identified by "layer" will
-                            // be bound. When "layered" is FALSE, the single bound layer is treated as a 2D texture.
-                            GLint Layer = ViewDesc.FirstArraySlice;
-
-                            auto GLAccess = AccessFlags2GLAccess( ViewDesc.AccessFlags );
-                            // WARNING: Texture being bound to the image unit must be complete
-                            // That means that if an integer texture is being bound, its 
-                            // GL_TEXTURE_MIN_FILTER and GL_TEXTURE_MAG_FILTER must be NEAREST,
-                            // otherwise it will be incomplete
-                            m_ContextState.BindImage( it->BindingPoint + ArrInd, pTexViewOGL, ViewDesc.MostDetailedMip, Layered, Layer, GLAccess, GlTexFormat );
-                        }
+                            Bindings.push_back( ProgramResourceBinding{ProgramResourceBinding::Image, it->BindingPoint + ArrInd, Resource.RawPtr(), nullptr} );
                         else
-                        {
                             LOG_MISSING_BINDING("image", it, ArrInd);
-                        }
                     }
                 }
 #endif
@@ -578,33 +782,193 @@ namespace Diligent
                     {
                         auto &Resource = it->pResources[ArrInd];
                         if( Resource )
-                        {
-                            auto *pBufferViewOGL = Resource.RawPtr<BufferViewGLImpl>();
-                            const auto &ViewDesc = pBufferViewOGL->GetDesc();
-                            VERIFY( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS || ViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE, "Unexpceted buffer view type" );
+                            Bindings.push_back( ProgramResourceBinding{ProgramResourceBinding::StorageBuffer, it->Binding + ArrInd, Resource.RawPtr(), nullptr} );
+                        else
+                            LOG_MISSING_BINDING("shader storage block", it, ArrInd);
+                    }
+                }
+#endif
+#undef LOG_MISSING_BINDING
+            }
+        }
+    }
 
-                            auto *pBuffer = pBufferViewOGL->GetBuffer();
-                            CHECK_DYNAMIC_TYPE( BufferGLImpl, pBuffer );
-                            auto *pBufferOGL = static_cast<BufferGLImpl*>(pBuffer);
+    void DeviceContextGLImpl::ApplyProgramResources( const ProgramResourceBinding *pBindings, size_t NumBindings, Uint32 &NewMemoryBarriers )
+    {
+        auto *pRenderDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
+        if (!m_pPipelineState)
+        {
+            LOG_ERROR("No pipeline state is bound");
+            return;
+        }
 
-                            pBufferOGL->BufferMemoryBarrier(
-                                GL_SHADER_STORAGE_BARRIER_BIT,// Accesses to shader storage blocks after the barrier 
-                                                              // will reflect writes prior to the barrier
-                                m_ContextState);
+        const auto &DeviceCaps = pRenderDeviceGL->GetDeviceCaps();
+        auto &Prog = m_pPipelineState->GetGLProgram();
+        auto &Pipeline = m_pPipelineState->GetGLProgramPipeline( m_ContextState.GetCurrentGLContext() );
+        VERIFY( Prog ^ Pipeline, "Only one of program or pipeline can be specified" );
+        if( !(Prog || Pipeline) )
+        {
+            LOG_ERROR_MESSAGE("No program/program pipeline is set for the draw call");
+            return;
+        }
+        auto ProgramPipelineSupported = DeviceCaps.bSeparableProgramSupported;
 
-                            glBindBufferRange( GL_SHADER_STORAGE_BUFFER, it->Binding + ArrInd, pBufferOGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth );
-                            CHECK_GL_ERROR( "Failed to bind shader storage buffer" );
+        // WARNING: glUseProgram() overrides glBindProgramPipeline(). That is, if you have a program in use and
+        // a program pipeline bound, all rendering will use the program that is in use, not the pipeline programs!!!
+        // So make sure that glUseProgram(0) has been called if pipeline is in use
+        m_ContextState.SetProgram( Prog );
+        if( ProgramPipelineSupported )
+            m_ContextState.SetPipeline( Pipeline );
 
-                            if( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS )
-                                m_BoundWritableBuffers.push_back( pBufferOGL );
-                        }
-                        else
-                        {
-                            LOG_MISSING_BINDING("shader storage block", it, ArrInd);
-                        }
+        // GLContextState skips the objects that are already bound to the same points.
+        m_BoundWritableTextures.clear();
+        m_BoundWritableBuffers.clear();
+        m_BoundDynamicUniformBuffers.clear();
+        for( size_t i = 0; i < NumBindings; ++i )
+        {
+            const auto &Binding = pBindings[i];
+            switch( Binding.Type )
+            {
+                case ProgramResourceBinding::UniformBuffer:
+                {
+                    auto *pBufferOGL = ValidatedCast<BufferGLImpl>(Binding.pResource);
+                    pBufferOGL->BufferMemoryBarrier(
+                        GL_UNIFORM_BARRIER_BIT,// Shader uniforms sourced from buffer objects after the barrier 
+                                               // will reflect data written by shaders prior to the barrier
+                        m_ContextState);
+
+                    if( m_pDynamicHeap && pBufferOGL->m_bIsDynamicUniformBuffer )
+                    {
+                        // The buffer or the heap range is bound by BindDynamicUniformBuffers()
+                        m_BoundDynamicUniformBuffers.emplace_back(Binding.BindingPoint, pBufferOGL);
                     }
+                    else
+                        m_ContextState.BindUniformBuffer(Binding.BindingPoint, pBufferOGL->m_GlBuffer);
                 }
+                break;
+
+                case ProgramResourceBinding::TexelBuffer:
+                {
+                    const GLint TextureIndex = static_cast<GLint>(Binding.BindingPoint);
+                    auto *pBufViewOGL = ValidatedCast<BufferViewGLImpl>(Binding.pResource);
+                    auto *pBuffer = pBufViewOGL->GetBuffer();
+
+                    m_ContextState.BindTexture( TextureIndex, GL_TEXTURE_BUFFER, pBufViewOGL->GetTexBufferHandle() );
+                    m_ContextState.BindSampler( TextureIndex, GLObjectWrappers::GLSamplerObj(false) ); // Use default texture sampling parameters
+
+                    CHECK_DYNAMIC_TYPE( BufferGLImpl, pBuffer );
+                    static_cast<BufferGLImpl*>(pBuffer)->BufferMemoryBarrier(
+                        GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
+                                                      // memory via buffer textures, after the barrier will reflect data 
+                                                      // written by shaders prior to the barrier
+                        m_ContextState);
+                }
+                break;
+
+                case ProgramResourceBinding::Texture:
+                {
+                    const GLint TextureIndex = static_cast<GLint>(Binding.BindingPoint);
+                    auto *pTexViewOGL = ValidatedCast<TextureViewGLImpl>(Binding.pResource);
+                    m_ContextState.BindTexture( TextureIndex, pTexViewOGL->GetBindTarget(), pTexViewOGL->GetHandle() );
+
+                    auto *pTexture = pTexViewOGL->GetTexture();
+                    CHECK_DYNAMIC_TYPE( TextureBaseGL, pTexture );
+                    static_cast<TextureBaseGL*>(pTexture)->TextureMemoryBarrier(
+                        GL_TEXTURE_FETCH_BARRIER_BIT, // Texture fetches from shaders, including fetches from buffer object 
+                                                      // memory via buffer textures, after the barrier will reflect data 
+                                                      // written by shaders prior to the barrier
+                        m_ContextState);
+
+                    if( Binding.pSampler != nullptr )
+                    {
+                        m_ContextState.BindSampler( TextureIndex, ValidatedCast<SamplerGLImpl>(Binding.pSampler)->GetHandle() );
+                    }
+                }
+                break;
+
+#if GL_ARB_shader_image_load_store
+                case ProgramResourceBinding::Image:
+                {
+                    auto *pTexViewOGL = ValidatedCast<TextureViewGLImpl>(Binding.pResource);
+                    const auto &ViewDesc = pTexViewOGL->GetDesc();
+
+                    if( ViewDesc.AccessFlags & UAV_ACCESS_FLAG_WRITE )
+                    {
+                        auto *pTex = pTexViewOGL->GetTexture();
+                        CHECK_DYNAMIC_TYPE( TextureBaseGL, pTex );
+                        auto *pTexGL = static_cast<TextureBaseGL*>(pTex);
+
+                        pTexGL->TextureMemoryBarrier(
+                            GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,// Memory accesses using shader image load, store, and atomic built-in 
+                                                               // functions issued after the barrier will reflect data written by shaders 
+                                                               // prior to the barrier. Additionally, image stores and atomics issued after 
+                                                               // the barrier will not execute until all memory accesses (e.g., loads, 
+                                                               // stores, texture fetches, vertex fetches) initiated prior to the barrier 
+                                                               // complete.
+                            m_ContextState);
+                        // We cannot set pending memory barriers here, because
+                        // if some texture is bound twice, the logic will fail
+                        m_BoundWritableTextures.push_back( pTexGL );
+                    }
+
+#ifdef _DEBUG
+                    // Check that the texure being bound has immutable storage
+                    {
+                        m_ContextState.BindTexture( -1, pTexViewOGL->GetBindTarget(), pTexViewOGL->GetHandle() );
+                        GLint IsImmutable = 0;
+                        glGetTexParameteriv( pTexViewOGL->GetBindTarget(), GL_TEXTURE_IMMUTABLE_FORMAT, &IsImmutable );
+                        CHECK_GL_ERROR( "glGetTexParameteriv() failed" );
+                        VERIFY( IsImmutable, "Only immutable textures can be bound to pipeline using glBindImageTexture()" );
+                        m_ContextState.BindTexture( -1, pTexViewOGL->GetBindTarget(), GLObjectWrappers::GLTextureObj(false) );
+                    }
+#endif
+                    auto GlTexFormat = TexFormatToGLInternalTexFormat( ViewDesc.Format );
+                    // Note that if a format qulifier is specified in the shader, the format
+                    // must match it
+
+                    GLboolean Layered = ViewDesc.NumArraySlices > 1 && ViewDesc.FirstArraySlice == 0;
+                    // If "layered" is TRUE, the entire Mip level is bound. Layer parameter is ignored in this
+                    // case. If "layered" is FALSE, only the single layer identified by "layer" will
+                    // be bound. When "layered" is FALSE, the single bound layer is treated as a 2D texture.
+                    GLint Layer = ViewDesc.FirstArraySlice;
+
+                    auto GLAccess = AccessFlags2GLAccess( ViewDesc.AccessFlags );
+                    // WARNING: Texture being bound to the image unit must be complete
+                    // That means that if an integer texture is being bound, its 
+                    // GL_TEXTURE_MIN_FILTER and GL_TEXTURE_MAG_FILTER must be NEAREST,
+                    // otherwise it will be incomplete
+                    m_ContextState.BindImage( Binding.BindingPoint, pTexViewOGL, ViewDesc.MostDetailedMip, Layered, Layer, GLAccess, GlTexFormat );
+                }
+                break;
+#endif
+
+#if GL_ARB_shader_storage_buffer_object
+                case ProgramResourceBinding::StorageBuffer:
+                {
+                    auto *pBufferViewOGL = ValidatedCast<BufferViewGLImpl>(Binding.pResource);
+                    const auto &ViewDesc = pBufferViewOGL->GetDesc();
+                    VERIFY( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS || ViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE, "Unexpceted buffer view type" );
+
+                    auto *pBuffer = pBufferViewOGL->GetBuffer();
+                    CHECK_DYNAMIC_TYPE( BufferGLImpl, pBuffer );
+                    auto *pBufferOGL = static_cast<BufferGLImpl*>(pBuffer);
+
+                    pBufferOGL->BufferMemoryBarrier(
+                        GL_SHADER_STORAGE_BARRIER_BIT,// Accesses to shader storage blocks after the barrier 
+                                                      // will reflect writes prior to the barrier
+                        m_ContextState);
+
+                    glBindBufferRange( GL_SHADER_STORAGE_BUFFER, Binding.BindingPoint, pBufferOGL->m_GlBuffer, ViewDesc.ByteOffset, ViewDesc.ByteWidth );
+                    CHECK_GL_ERROR( "Failed to bind shader storage buffer" );
+
+                    if( ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS )
+                        m_BoundWritableBuffers.push_back( pBufferOGL );
+                }
+                break;
 #endif
+
+                default:
+                    UNEXPECTED("Unexpected resource type");
             }
         }
 
@@ -658,6 +1022,43 @@ namespace Diligent
 #endif
     }
 
+    void DeviceContextGLImpl::PrepareDraw( const DrawAttribs &drawAttribs, GLDrawAttribs &GLAttribs )
+    {
+        const auto& PipelineDesc = m_pPipelineState->GetDesc().GraphicsPipeline;
+        auto Topology = PipelineDesc.PrimitiveTopology;
+        if (Topology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST)
+        {
+#if GL_ARB_tessellation_shader
+            GLAttribs.Topology = GL_PATCHES;
+            GLAttribs.NumPatchVertices = static_cast<Int32>(Topology - PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST + 1);
+#else
+            UNSUPPORTED("Tessellation is not supported");
+#endif
+        }
+        else
+        {
+            GLAttribs.Topology = PrimitiveTopologyToGLTopology( Topology );
+        }
+
+        if( drawAttribs.IsIndexed )
+        {
+            GLAttribs.IndexType = TypeToGLType( drawAttribs.IndexType );
+            VERIFY( GLAttribs.IndexType == GL_UNSIGNED_BYTE || GLAttribs.IndexType == GL_UNSIGNED_SHORT || GLAttribs.IndexType == GL_UNSIGNED_INT,
+                    "Unsupported index type" );
+            VERIFY( m_pIndexBuffer, "Index Buffer is not bound to the pipeline" );
+            GLAttribs.FirstIndexByteOffset = static_cast<Uint32>(GetValueSize( drawAttribs.IndexType )) * drawAttribs.FirstIndexLocation + m_IndexDataStartOffset;
+        }
+
+        GLAttribs.NumVertices            = drawAttribs.NumVertices;
+        GLAttribs.NumIndices             = drawAttribs.NumIndices;
+        GLAttribs.NumInstances           = drawAttribs.NumInstances;
+        GLAttribs.BaseVertex             = static_cast<Int32>(drawAttribs.BaseVertex);
+        GLAttribs.FirstInstance          = drawAttribs.FirstInstanceLocation;
+        GLAttribs.StartVertex            = drawAttribs.StartVertexLocation;
+        GLAttribs.pIndirectDrawAttribs   = static_cast<BufferGLImpl*>(drawAttribs.pIndirectDrawAttribs);
+        GLAttribs.IndirectDrawArgsOffset = drawAttribs.IndirectDrawArgsOffset;
+    }
+
     void DeviceContextGLImpl::Draw( DrawAttribs &drawAttribs )
     {
 #ifdef DEVELOPMENT
@@ -665,13 +1066,36 @@ namespace Diligent
             return;
 #endif
 
-        auto *pRenderDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
-        auto CurrNativeGLContext = pRenderDeviceGL->m_GLContext.GetCurrentNativeGLContext();
+        GLDrawAttribs GLAttribs;
+        PrepareDraw( drawAttribs, GLAttribs );
+
+        if (m_bIsDeferred)
+        {
+            m_Commands.AddCommand<DrawCmd>().Attribs = GLAttribs;
+            m_Commands.AddReference(drawAttribs.pIndirectDrawAttribs);
+            return;
+        }
+
+        ExecuteDraw( GLAttribs );
+    }
+
+    void DeviceContextGLImpl::ExecuteDraw( const GLDrawAttribs &GLAttribs )
+    {
         const auto& PipelineDesc = m_pPipelineState->GetDesc().GraphicsPipeline;
+        const bool IsIndexed = GLAttribs.IndexType != 0;
+        BindDynamicUniformBuffers();
         if(!m_bVAOIsUpToDate)
         {
-            auto &VAOCache = pRenderDeviceGL->GetVAOCache(CurrNativeGLContext);
-            IBuffer *pIndexBuffer = drawAttribs.IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
+            // Like FBOs and program pipelines, VAOs are cached for the context set by UpdateCurrentGLContext(),
+            // so that the native context does not need to be queried every time vertex buffers change
+            auto CurrNativeGLContext = m_ContextState.GetCurrentGLContext();
+            if (m_pVAOCache == nullptr || m_VAOCacheContext != CurrNativeGLContext)
+            {
+                m_pVAOCache = &m_pDevice.RawPtr<RenderDeviceGLImpl>()->GetVAOCache(CurrNativeGLContext);
+                m_VAOCacheContext = CurrNativeGLContext;
+            }
+            auto &VAOCache = *m_pVAOCache;
+            IBuffer *pIndexBuffer = IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
             if(PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr)
             {
                 const auto& VAO = VAOCache.GetVAO( m_pPipelineState, pIndexBuffer, m_VertexStreams, m_NumVertexStreams, m_ContextState );
@@ -688,32 +1112,13 @@ namespace Diligent
             m_bVAOIsUpToDate = true;
         }
 
-        GLenum GlTopology;
-        auto Topology = PipelineDesc.PrimitiveTopology;
-        if (Topology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST)
-        {
+        const auto GlTopology = GLAttribs.Topology;
 #if GL_ARB_tessellation_shader
-            GlTopology = GL_PATCHES;
-            auto NumVertices = static_cast<Int32>(Topology - PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST + 1);
-            m_ContextState.SetNumPatchVertices(NumVertices);
-#else
-            UNSUPPORTED("Tessellation is not supported");
+        if (GlTopology == GL_PATCHES)
+            m_ContextState.SetNumPatchVertices(GLAttribs.NumPatchVertices);
 #endif
-        }
-        else
-        {
-            GlTopology = PrimitiveTopologyToGLTopology( Topology );
-        }
-        GLenum IndexType = 0;
-        Uint32 FirstIndexByteOffset = 0;
-        if( drawAttribs.IsIndexed )
-        {
-            IndexType = TypeToGLType( drawAttribs.IndexType );
-            VERIFY( IndexType == GL_UNSIGNED_BYTE || IndexType == GL_UNSIGNED_SHORT || IndexType == GL_UNSIGNED_INT,
-                    "Unsupported index type" );
-            VERIFY( m_pIndexBuffer, "Index Buffer is not bound to the pipeline" );
-            FirstIndexByteOffset = static_cast<Uint32>(GetValueSize( drawAttribs.IndexType )) * drawAttribs.FirstIndexLocation + m_IndexDataStartOffset;
-        }
+        const auto IndexType = GLAttribs.IndexType;
+        const auto FirstIndexByteOffset = GLAttribs.FirstIndexByteOffset;
 
         // NOTE: Base Vertex and Base Instance versions are not supported even in OpenGL ES 3.1
         // This functionality can be emulated by adjusting stream offsets. This, however may cause
@@ -721,7 +1126,7 @@ namespace Diligent
         // such cases is left to the application
 
         // http://www.opengl.org/wiki/Vertex_Rendering
-        auto *pIndirectDrawAttribsGL = static_cast<BufferGLImpl*>(drawAttribs.pIndirectDrawAttribs);
+        auto *pIndirectDrawAttribsGL = GLAttribs.pIndirectDrawAttribs;
         if (pIndirectDrawAttribsGL != nullptr)
         {
 #if GL_ARB_draw_indirect
@@ -738,7 +1143,7 @@ namespace Diligent
 
             glBindBuffer( GL_DRAW_INDIRECT_BUFFER, pIndirectDrawAttribsGL->m_GlBuffer );
 
-            if( drawAttribs.IsIndexed )
+            if( IsIndexed )
             {
                 //typedef  struct {
                 //    GLuint  count;
@@ -747,7 +1152,7 @@ namespace Diligent
                 //    GLuint  baseVertex;
                 //    GLuint  baseInstance;
                 //} DrawElementsIndirectCommand;
-                glDrawElementsIndirect( GlTopology, IndexType, reinterpret_cast<const void*>( static_cast<size_t>(drawAttribs.IndirectDrawArgsOffset) ) );
+                glDrawElementsIndirect( GlTopology, IndexType, reinterpret_cast<const void*>( static_cast<size_t>(GLAttribs.IndirectDrawArgsOffset) ) );
                 // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
                 CHECK_GL_ERROR( "glDrawElementsIndirect() failed" );
             }
@@ -759,7 +1164,7 @@ namespace Diligent
                 //   GLuint  first;
                 //   GLuint  baseInstance;
                 //} DrawArraysIndirectCommand;
-                glDrawArraysIndirect( GlTopology, reinterpret_cast<const void*>( static_cast<size_t>(drawAttribs.IndirectDrawArgsOffset) ) );
+                glDrawArraysIndirect( GlTopology, reinterpret_cast<const void*>( static_cast<size_t>(GLAttribs.IndirectDrawArgsOffset) ) );
                 // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
                 CHECK_GL_ERROR( "glDrawArraysIndirect() failed" );
             }
@@ -771,44 +1176,44 @@ namespace Diligent
         }
         else
         {
-            if( drawAttribs.NumInstances > 1 )
+            if( GLAttribs.NumInstances > 1 )
             {
-                if( drawAttribs.IsIndexed )
+                if( IsIndexed )
                 {
-                    if( drawAttribs.BaseVertex )
+                    if( GLAttribs.BaseVertex )
                     {
-                        if( drawAttribs.FirstInstanceLocation )
-                            glDrawElementsInstancedBaseVertexBaseInstance( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.BaseVertex, drawAttribs.FirstInstanceLocation );
+                        if( GLAttribs.FirstInstance )
+                            glDrawElementsInstancedBaseVertexBaseInstance( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), GLAttribs.NumInstances, GLAttribs.BaseVertex, GLAttribs.FirstInstance );
                         else
-                            glDrawElementsInstancedBaseVertex( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.BaseVertex );
+                            glDrawElementsInstancedBaseVertex( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), GLAttribs.NumInstances, GLAttribs.BaseVertex );
                     }
                     else
                     {
-                        if( drawAttribs.FirstInstanceLocation )
-                            glDrawElementsInstancedBaseInstance( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances, drawAttribs.FirstInstanceLocation );
+                        if( GLAttribs.FirstInstance )
+                            glDrawElementsInstancedBaseInstance( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), GLAttribs.NumInstances, GLAttribs.FirstInstance );
                         else
-                            glDrawElementsInstanced( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.NumInstances );
+                            glDrawElementsInstanced( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), GLAttribs.NumInstances );
                     }
                 }
                 else
                 {
-                    if( drawAttribs.FirstInstanceLocation )
-                        glDrawArraysInstancedBaseInstance( GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices, drawAttribs.NumInstances, drawAttribs.FirstInstanceLocation );
+                    if( GLAttribs.FirstInstance )
+                        glDrawArraysInstancedBaseInstance( GlTopology, GLAttribs.StartVertex, GLAttribs.NumVertices, GLAttribs.NumInstances, GLAttribs.FirstInstance );
                     else
-                        glDrawArraysInstanced( GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices, drawAttribs.NumInstances );
+                        glDrawArraysInstanced( GlTopology, GLAttribs.StartVertex, GLAttribs.NumVertices, GLAttribs.NumInstances );
                 }
             }
             else
             {
-                if( drawAttribs.IsIndexed )
+                if( IsIndexed )
                 {
-                    if( drawAttribs.BaseVertex )
-                        glDrawElementsBaseVertex( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), drawAttribs.BaseVertex );
+                    if( GLAttribs.BaseVertex )
+                        glDrawElementsBaseVertex( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ), GLAttribs.BaseVertex );
                     else
-                        glDrawElements( GlTopology, drawAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ) );
+                        glDrawElements( GlTopology, GLAttribs.NumIndices, IndexType, reinterpret_cast<GLvoid*>( static_cast<size_t>(FirstIndexByteOffset) ) );
                 }
                 else
-                    glDrawArrays( GlTopology, drawAttribs.StartVertexLocation, drawAttribs.NumVertices );
+                    glDrawArrays( GlTopology, GLAttribs.StartVertex, GLAttribs.NumVertices );
             }
             CHECK_GL_ERROR( "OpenGL draw command failed" );
         }
@@ -828,7 +1233,15 @@ namespace Diligent
             return;
 #endif
 
+        if (m_bIsDeferred)
+        {
+            m_Commands.AddCommand<DispatchComputeCmd>().Attribs = DispatchAttrs;
+            m_Commands.AddReference(DispatchAttrs.pIndirectDispatchAttribs);
+            return;
+        }
+
 #if GL_ARB_compute_shader
+        BindDynamicUniformBuffers();
         if( DispatchAttrs.pIndirectDispatchAttribs )
         {
             CHECK_DYNAMIC_TYPE( BufferGLImpl, DispatchAttrs.pIndirectDispatchAttribs );
@@ -868,6 +1281,17 @@ namespace Diligent
 
     void DeviceContextGLImpl::ClearDepthStencil( ITextureView *pView, Uint32 ClearFlags, float fDepth, Uint8 Stencil )
     {
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<ClearDepthStencilCmd>();
+            Cmd.pView      = pView;
+            Cmd.ClearFlags = ClearFlags;
+            Cmd.fDepth     = fDepth;
+            Cmd.Stencil    = Stencil;
+            m_Commands.AddReference(pView);
+            return;
+        }
+
         // Unlike OpenGL, in D3D10+, the full extent of the resource view is always cleared. 
         // Viewport and scissor settings are not applied.
         if( pView != nullptr )
@@ -910,6 +1334,17 @@ namespace Diligent
 
     void DeviceContextGLImpl::ClearRenderTarget( ITextureView *pView, const float *RGBA )
     {
+        if (m_bIsDeferred)
+        {
+            auto& Cmd = m_Commands.AddCommand<ClearRenderTargetCmd>();
+            Cmd.pView        = pView;
+            Cmd.DefaultColor = RGBA == nullptr;
+            for (int i = 0; i < 4; ++i)
+                Cmd.RGBA[i] = RGBA != nullptr ? RGBA[i] : 0.f;
+            m_Commands.AddReference(pView);
+            return;
+        }
+
         // Unlike OpenGL, in D3D10+, the full extent of the resource view is always cleared. 
         // Viewport and scissor settings are not applied.
 
@@ -970,23 +1405,445 @@ namespace Diligent
 
     void DeviceContextGLImpl::Flush()
     {
+        if (m_bIsDeferred)
+        {
+            LOG_ERROR("Flush() should only be called for immediate contexts");
+            return;
+        }
         glFlush();
     }
 
     void DeviceContextGLImpl::FinishFrame()
     {
+        if (m_bIsDeferred)
+        {
+            LOG_ERROR("FinishFrame() should only be called for immediate contexts");
+            return;
+        }
+
+        if (m_pDynamicHeap)
+        {
+            // Heap space used by this frame is reused once the GPU has passed the fence,
+            // so the buffers that are not mapped again must keep their contents in their own storage
+            RetireDynamicBuffers();
+            m_pDynamicHeap->FinishFrame(*this);
+        }
+
+        // Release VAOs of destroyed buffers even if no more draw commands are issued in this GL context
+        if (m_pVAOCache != nullptr && m_VAOCacheContext == m_ContextState.GetCurrentGLContext())
+            m_pVAOCache->PurgeStaleEntries();
+    }
+
+    void* DeviceContextGLImpl::MapDynamicUniformBuffer( BufferGLImpl &Buffer, Uint32 MapFlags )
+    {
+        VERIFY_EXPR(!m_bIsDeferred && Buffer.m_bIsDynamicUniformBuffer);
+        if (!m_pDynamicHeap)
+            return nullptr;
+
+        if ((MapFlags & MAP_FLAG_DISCARD) == 0)
+        {
+            // MAP_FLAG_DO_NOT_SYNCHRONIZE: the application overwrites the data the GPU may still be using
+            return Buffer.m_DynamicAllocation.IsValid() ? m_pDynamicHeap->GetCPUAddress(Buffer.m_DynamicAllocation) : nullptr;
+        }
+
+        const auto Size = Buffer.GetDesc().uiSizeInBytes;
+        auto Allocation = m_pDynamicHeap->Allocate(Size);
+        if (!Allocation.IsValid())
+        {
+            // The application does not finish frames often enough or the heap is too small.
+            // Finish the frame to let the heap reuse the space the GPU has completed.
+            FinishFrame();
+            Allocation = m_pDynamicHeap->Allocate(Size);
+            if (!Allocation.IsValid())
+                return nullptr;
+        }
+
+        if (!Buffer.m_DynamicAllocation.IsValid())
+            m_MappedDynamicBuffers.emplace_back(&Buffer);
+        // The previous allocation is released by the heap when the frame is completed
+        Buffer.m_DynamicAllocation = Allocation;
+        return m_pDynamicHeap->GetCPUAddress(Allocation);
+    }
+
+    void DeviceContextGLImpl::RetireDynamicAllocation( BufferGLImpl &Buffer )
+    {
+        VERIFY_EXPR(m_pDynamicHeap && Buffer.m_DynamicAllocation.IsValid());
+        Buffer.BufferMemoryBarrier( GL_BUFFER_UPDATE_BARRIER_BIT, m_ContextState );
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, Buffer.m_GlBuffer);
+        glBindBuffer(GL_COPY_READ_BUFFER, m_pDynamicHeap->GetGLBuffer());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, Buffer.m_DynamicAllocation.Offset, 0, Buffer.m_DynamicAllocation.Size);
+        CHECK_GL_ERROR("glCopyBufferSubData() failed");
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        // The buffer stays in m_MappedDynamicBuffers until the frame is finished
+        Buffer.m_DynamicAllocation = GLDynamicHeap::Allocation();
+    }
+
+    void DeviceContextGLImpl::RetireDynamicBuffers()
+    {
+        for (auto &pBuffer : m_MappedDynamicBuffers)
+        {
+            if (pBuffer->m_DynamicAllocation.IsValid())
+                RetireDynamicAllocation(*pBuffer);
+        }
+        m_MappedDynamicBuffers.clear();
+    }
+
+    void DeviceContextGLImpl::BindDynamicUniformBuffers()
+    {
+        for (const auto &BindPointBuffer : m_BoundDynamicUniformBuffers)
+        {
+            const auto &Buffer = *BindPointBuffer.second;
+            const auto &Allocation = Buffer.m_DynamicAllocation;
+            if (Allocation.IsValid())
+                m_ContextState.BindUniformBufferRange(BindPointBuffer.first, m_pDynamicHeap->GetGLBuffer(), Allocation.Offset, Allocation.Size);
+            else
+                m_ContextState.BindUniformBuffer(BindPointBuffer.first, Buffer.m_GlBuffer);
+        }
     }
 
     void DeviceContextGLImpl::FinishCommandList(class ICommandList **ppCommandList)
     {
-        LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+        if (!m_bIsDeferred)
+        {
+            LOG_ERROR("Only deferred context can record command list");
+            return;
+        }
+
+        VERIFY(m_MappedBuffers.empty(), "All buffers mapped in the deferred context must be unmapped before the command list is finished");
+        m_MappedBuffers.clear();
+
+        auto *pDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
+        CommandListGLImpl *pCmdListGL( NEW_RC_OBJ(m_CmdListAllocator, "CommandListGLImpl instance", CommandListGLImpl)(pDeviceGL, std::move(m_Commands)) );
+        pCmdListGL->QueryInterface( IID_CommandList, reinterpret_cast<IObject**>(ppCommandList) );
+        m_Commands.Reset();
+
+        // Device context is now in default state. The state is reset directly as there
+        // is no need to record the command: the immediate context is invalidated when
+        // the command list is executed
+        TDeviceContextBase::InvalidateState();
     }
 
     void DeviceContextGLImpl::ExecuteCommandList(class ICommandList *pCommandList)
     {
-        LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+        if (m_bIsDeferred)
+        {
+            LOG_ERROR("Only immediate context can execute command list");
+            return;
+        }
+
+        // Command lists are always recorded from the default state, and the
+        // context is left in the default state after the command list is executed
+        InvalidateState();
+
+        auto *pCmdListGL = ValidatedCast<CommandListGLImpl>(pCommandList);
+        ReplayCommands( pCmdListGL->GetCommands() );
+
+        InvalidateState();
     }
 
+    void DeviceContextGLImpl::ReplayCommands( const GLCommandStream &Commands )
+    {
+        VERIFY_EXPR(!m_bIsDeferred);
+
+        size_t Offset = 0;
+        const auto StreamSize = Commands.GetSize();
+        while (Offset < StreamSize)
+        {
+            const auto &Header = Commands.GetHeader(Offset);
+            switch (static_cast<GLCommandId>(Header.Id))
+            {
+                case GLCommandId::SetPipelineState:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetPipelineStateCmd>(Offset);
+                    SetPipelineState(Cmd.pPSO);
+                }
+                break;
+
+                case GLCommandId::CommitShaderResources:
+                {
+                    // Resources have been resolved by the deferred context, so
+                    // only the GL objects need to be bound
+                    const auto &Cmd = Commands.GetCommand<CommitShaderResourcesCmd>(Offset);
+                    CommitProgramResources(Cmd.pBindings, Cmd.NumBindings);
+                }
+                break;
+
+                case GLCommandId::SetStencilRef:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetStencilRefCmd>(Offset);
+                    SetStencilRef(Cmd.StencilRef);
+                }
+                break;
+
+                case GLCommandId::SetBlendFactors:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetBlendFactorsCmd>(Offset);
+                    SetBlendFactors(Cmd.BlendFactors);
+                }
+                break;
+
+                case GLCommandId::SetVertexBuffers:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetVertexBuffersCmd>(Offset);
+                    SetVertexBuffers(Cmd.StartSlot, Cmd.NumBuffersSet, Cmd.ppBuffers, const_cast<Uint32*>(Cmd.pOffsets), Cmd.Flags);
+                }
+                break;
+
+                case GLCommandId::SetIndexBuffer:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetIndexBufferCmd>(Offset);
+                    SetIndexBuffer(Cmd.pIndexBuffer, Cmd.ByteOffset);
+                }
+                break;
+
+                case GLCommandId::InvalidateState:
+                    InvalidateState();
+                break;
+
+                case GLCommandId::SetViewports:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetViewportsCmd>(Offset);
+                    SetViewports(Cmd.NumViewports, Cmd.pViewports, Cmd.RTWidth, Cmd.RTHeight);
+                }
+                break;
+
+                case GLCommandId::SetScissorRects:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetScissorRectsCmd>(Offset);
+                    SetScissorRects(Cmd.NumRects, Cmd.pRects, Cmd.RTWidth, Cmd.RTHeight);
+                }
+                break;
+
+                case GLCommandId::SetRenderTargets:
+                {
+                    const auto &Cmd = Commands.GetCommand<SetRenderTargetsCmd>(Offset);
+                    SetRenderTargets(Cmd.NumRenderTargets, Cmd.ppRenderTargets, Cmd.pDepthStencil);
+                }
+                break;
+
+                case GLCommandId::Draw:
+                {
+                    const auto &Cmd = Commands.GetCommand<DrawCmd>(Offset);
+                    ExecuteDraw(Cmd.Attribs);
+                }
+                break;
+
+                case GLCommandId::DispatchCompute:
+                {
+                    const auto &Cmd = Commands.GetCommand<DispatchComputeCmd>(Offset);
+                    DispatchCompute(Cmd.Attribs);
+                }
+                break;
+
+                case GLCommandId::ClearDepthStencil:
+                {
+                    const auto &Cmd = Commands.GetCommand<ClearDepthStencilCmd>(Offset);
+                    ClearDepthStencil(Cmd.pView, Cmd.ClearFlags, Cmd.fDepth, Cmd.Stencil);
+                }
+                break;
+
+                case GLCommandId::ClearRenderTarget:
+                {
+                    const auto &Cmd = Commands.GetCommand<ClearRenderTargetCmd>(Offset);
+                    ClearRenderTarget(Cmd.pView, Cmd.DefaultColor ? nullptr : Cmd.RGBA);
+                }
+                break;
+
+                case GLCommandId::UpdateBuffer:
+                {
+                    const auto &Cmd = Commands.GetCommand<UpdateBufferCmd>(Offset);
+                    Cmd.pBuffer->UpdateData(this, Cmd.Offset, Cmd.Size, const_cast<void*>(Cmd.pData));
+                }
+                break;
+
+                case GLCommandId::CopyBuffer:
+                {
+                    const auto &Cmd = Commands.GetCommand<CopyBufferCmd>(Offset);
+                    Cmd.pDstBuffer->CopyData(this, Cmd.pSrcBuffer, Cmd.SrcOffset, Cmd.DstOffset, Cmd.Size);
+                }
+                break;
+
+                case GLCommandId::WriteBuffer:
+                {
+                    const auto &Cmd = Commands.GetCommand<WriteBufferCmd>(Offset);
+                    PVoid pMappedData = nullptr;
+                    Cmd.pBuffer->Map(this, MAP_WRITE, Cmd.MapFlags, pMappedData);
+                    if (pMappedData != nullptr)
+                        memcpy(pMappedData, Cmd.pData, Cmd.pBuffer->GetDesc().uiSizeInBytes);
+                    Cmd.pBuffer->Unmap(this, MAP_WRITE, Cmd.MapFlags);
+                }
+                break;
+
+                case GLCommandId::UpdateTexture:
+                {
+                    const auto &Cmd = Commands.GetCommand<UpdateTextureCmd>(Offset);
+                    static_cast<ITexture*>(Cmd.pTexture)->UpdateData(this, Cmd.MipLevel, Cmd.Slice, Cmd.DstBox, Cmd.SubresData);
+                }
+                break;
+
+                case GLCommandId::CopyTexture:
+                {
+                    const auto &Cmd = Commands.GetCommand<CopyTextureCmd>(Offset);
+                    Cmd.pDstTexture->CopyData(this, Cmd.pSrcTexture, Cmd.SrcMipLevel, Cmd.SrcSlice, &Cmd.SrcBox, Cmd.DstMipLevel, Cmd.DstSlice, Cmd.DstX, Cmd.DstY, Cmd.DstZ);
+                }
+                break;
+
+                case GLCommandId::GenerateMips:
+                {
+                    const auto &Cmd = Commands.GetCommand<GenerateMipsCmd>(Offset);
+                    Cmd.pTexView->GenerateMips(this);
+                }
+                break;
+
+                default:
+                    UNEXPECTED("Unexpected command");
+            }
+
+            VERIFY_EXPR(Header.Size != 0);
+            Offset += Header.Size;
+        }
+    }
+
+    void DeviceContextGLImpl::RecordUpdateBuffer( BufferGLImpl *pBuffer, Uint32 Offset, Uint32 Size, const void *pData )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        auto& Cmd = m_Commands.AddCommand<UpdateBufferCmd>();
+        Cmd.pBuffer = pBuffer;
+        Cmd.pData   = m_Commands.CopyParams(reinterpret_cast<const Uint8*>(pData), Size);
+        Cmd.Offset  = Offset;
+        Cmd.Size    = Size;
+        m_Commands.AddReference(pBuffer);
+    }
+
+    void DeviceContextGLImpl::RecordCopyBuffer( BufferGLImpl *pDstBuffer, BufferGLImpl *pSrcBuffer, Uint32 SrcOffset, Uint32 DstOffset, Uint32 Size )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        auto& Cmd = m_Commands.AddCommand<CopyBufferCmd>();
+        Cmd.pDstBuffer = pDstBuffer;
+        Cmd.pSrcBuffer = pSrcBuffer;
+        Cmd.SrcOffset  = SrcOffset;
+        Cmd.DstOffset  = DstOffset;
+        Cmd.Size       = Size;
+        m_Commands.AddReference(pDstBuffer);
+        m_Commands.AddReference(pSrcBuffer);
+    }
+
+    void* DeviceContextGLImpl::RecordMapBuffer( BufferGLImpl *pBuffer, MAP_TYPE MapType, Uint32 MapFlags )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        if (MapType != MAP_WRITE || (MapFlags & MAP_FLAG_DISCARD) == 0)
+        {
+            LOG_ERROR_MESSAGE("Buffer '", pBuffer->GetDesc().Name, "' cannot be mapped in a deferred context: only MAP_WRITE with MAP_FLAG_DISCARD flag is supported");
+            return nullptr;
+        }
+
+        for (const auto& MappedBuffer : m_MappedBuffers)
+        {
+            if (MappedBuffer.first == pBuffer)
+            {
+                LOG_ERROR_MESSAGE("Buffer '", pBuffer->GetDesc().Name, "' is already mapped");
+                return nullptr;
+            }
+        }
+
+        // The memory is allocated from the parameter arena and is written to the buffer
+        // when the command list is executed
+        auto* pData = m_Commands.AllocateParams(pBuffer->GetDesc().uiSizeInBytes);
+        m_MappedBuffers.emplace_back(pBuffer, pData);
+        return pData;
+    }
+
+    void DeviceContextGLImpl::RecordUnmapBuffer( BufferGLImpl *pBuffer, MAP_TYPE MapType, Uint32 MapFlags )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        auto it = m_MappedBuffers.begin();
+        while (it != m_MappedBuffers.end() && it->first != pBuffer)
+            ++it;
+        if (it == m_MappedBuffers.end())
+        {
+            LOG_ERROR_MESSAGE("Buffer '", pBuffer->GetDesc().Name, "' has not been mapped in this context");
+            return;
+        }
+
+        auto& Cmd = m_Commands.AddCommand<WriteBufferCmd>();
+        Cmd.pBuffer  = pBuffer;
+        Cmd.pData    = it->second;
+        Cmd.MapFlags = MapFlags;
+        m_Commands.AddReference(pBuffer);
+        m_MappedBuffers.erase(it);
+    }
+
+    void DeviceContextGLImpl::RecordUpdateTexture( TextureBaseGL *pTexture, Uint32 MipLevel, Uint32 Slice, const Box &DstBox, const TextureSubResData &SubresData )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        auto& Cmd = m_Commands.AddCommand<UpdateTextureCmd>();
+        Cmd.pTexture   = pTexture;
+        Cmd.MipLevel   = MipLevel;
+        Cmd.Slice      = Slice;
+        Cmd.DstBox     = DstBox;
+        Cmd.SubresData = SubresData;
+        m_Commands.AddReference(pTexture);
+
+        if (SubresData.pSrcBuffer != nullptr)
+        {
+            // The data is read from the buffer when the command list is executed
+            m_Commands.AddReference(SubresData.pSrcBuffer);
+        }
+        else if (SubresData.pData != nullptr)
+        {
+            const auto& FmtAttribs = GetTextureFormatAttribs(pTexture->GetDesc().Format);
+            const Uint32 UpdateWidth  = DstBox.MaxX - DstBox.MinX;
+            const Uint32 UpdateHeight = DstBox.MaxY - DstBox.MinY;
+            const Uint32 UpdateDepth  = DstBox.MaxZ - DstBox.MinZ;
+            size_t RowSize = 0;
+            Uint32 NumRows = 0;
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+            {
+                RowSize = size_t{(UpdateWidth + FmtAttribs.BlockWidth - 1) / FmtAttribs.BlockWidth} * FmtAttribs.ComponentSize;
+                NumRows = (UpdateHeight + FmtAttribs.BlockHeight - 1) / FmtAttribs.BlockHeight;
+            }
+            else
+            {
+                RowSize = size_t{UpdateWidth} * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+                NumRows = UpdateHeight;
+            }
+
+            if (RowSize != 0 && NumRows != 0 && UpdateDepth != 0)
+            {
+                const size_t DataSize = size_t{UpdateDepth - 1} * SubresData.DepthStride + size_t{NumRows - 1} * SubresData.Stride + RowSize;
+                Cmd.SubresData.pData = m_Commands.CopyParams(reinterpret_cast<const Uint8*>(SubresData.pData), DataSize);
+            }
+        }
+    }
+
+    void DeviceContextGLImpl::RecordCopyTexture( TextureBaseGL *pDstTexture, TextureBaseGL *pSrcTexture, Uint32 SrcMipLevel, Uint32 SrcSlice, const Box &SrcBox,
+                                                 Uint32 DstMipLevel, Uint32 DstSlice, Uint32 DstX, Uint32 DstY, Uint32 DstZ )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        auto& Cmd = m_Commands.AddCommand<CopyTextureCmd>();
+        Cmd.pDstTexture = pDstTexture;
+        Cmd.pSrcTexture = pSrcTexture;
+        Cmd.SrcMipLevel = SrcMipLevel;
+        Cmd.SrcSlice    = SrcSlice;
+        Cmd.SrcBox      = SrcBox;
+        Cmd.DstMipLevel = DstMipLevel;
+        Cmd.DstSlice    = DstSlice;
+        Cmd.DstX        = DstX;
+        Cmd.DstY        = DstY;
+        Cmd.DstZ        = DstZ;
+        m_Commands.AddReference(pDstTexture);
+        m_Commands.AddReference(pSrcTexture);
+    }
+
+    void DeviceContextGLImpl::RecordGenerateMips( TextureViewGLImpl *pTexView )
+    {
+        VERIFY_EXPR(m_bIsDeferred);
+        m_Commands.AddCommand<GenerateMipsCmd>().pTexView = pTexView;
+        m_Commands.AddReference(pTexView);
+    }
     void DeviceContextGLImpl::SignalFence(IFence* pFence, Uint64 Value)
     {
         VERIFY(!m_bIsDeferred, "Fence can only be signalled from immediate context");
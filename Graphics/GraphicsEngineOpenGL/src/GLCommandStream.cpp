@@ -0,0 +1,66 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "GLCommandStream.h"
+
+namespace Diligent
+{
+
+void* GLCommandStream::AllocateParams(size_t Size, size_t Alignment)
+{
+    VERIFY((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    VERIFY(Alignment <= CommandAlignment, "Alignment is too large");
+
+    if (Size > ParamPageSize / 4)
+    {
+        // Large blocks are allocated separately, so that the remaining
+        // space in the current page can still be used
+        m_LargeParamBlocks.emplace_back(new Uint8[Size]);
+        return m_LargeParamBlocks.back().get();
+    }
+
+    auto AlignedOffset = (m_ParamPageOffset + Alignment - 1) & ~(Alignment - 1);
+    if (m_ParamPages.empty() || AlignedOffset + Size > ParamPageSize)
+    {
+        m_ParamPages.emplace_back(new Uint8[ParamPageSize]);
+        AlignedOffset = 0;
+    }
+
+    m_ParamPageOffset = AlignedOffset + Size;
+    return m_ParamPages.back().get() + AlignedOffset;
+}
+
+void GLCommandStream::Reset()
+{
+    m_Commands.clear();
+    m_NumCommands = 0;
+    m_ParamPages.clear();
+    m_ParamPageOffset = 0;
+    m_LargeParamBlocks.clear();
+    m_References.clear();
+}
+
+}
@@ -55,6 +55,7 @@ namespace Diligent
 
         m_BoundTextures.reserve( m_Caps.m_iMaxCombinedTexUnits );
         m_BoundSamplers.reserve( 32 );
+        m_BoundUniformBuffers.reserve( 32 );
         m_BoundImages.reserve( 32 );
 
         Invalidate();
@@ -89,6 +90,7 @@ namespace Diligent
         
         m_BoundTextures.clear();
         m_BoundSamplers.clear();
+        m_BoundUniformBuffers.clear();
         m_BoundImages.clear();
 
         m_DSState = DepthStencilGLState();
@@ -230,6 +232,41 @@ namespace Diligent
         }
     }
 
+    void GLContextState::BindUniformBuffer( Uint32 Index, const GLObjectWrappers::GLBufferObj &Buff )
+    {
+        if( Index >= m_BoundUniformBuffers.size() )
+            m_BoundUniformBuffers.resize( Index + 1 );
+
+        auto &BoundBuffer = m_BoundUniformBuffers[Index];
+        GLuint GLBufferHandle = 0;
+        // The slot must be rebound if a range of the same buffer is currently bound to it
+        if( UpdateBoundObject( BoundBuffer.BufferID, Buff, GLBufferHandle ) || BoundBuffer.Size != 0 )
+        {
+            BoundBuffer.Offset = 0;
+            BoundBuffer.Size = 0;
+            glBindBufferBase( GL_UNIFORM_BUFFER, Index, GLBufferHandle );
+            CHECK_GL_ERROR( "Failed to bind uniform buffer to slot ", Index );
+        }
+    }
+
+    void GLContextState::BindUniformBufferRange( Uint32 Index, const GLObjectWrappers::GLBufferObj &Buff, GLintptr Offset, GLsizeiptr Size )
+    {
+        VERIFY( Size != 0, "Range size must not be zero" );
+        if( Index >= m_BoundUniformBuffers.size() )
+            m_BoundUniformBuffers.resize( Index + 1 );
+
+        auto &BoundBuffer = m_BoundUniformBuffers[Index];
+        GLuint GLBufferHandle = 0;
+        bool BufferChanged = UpdateBoundObject( BoundBuffer.BufferID, Buff, GLBufferHandle );
+        if( BufferChanged || BoundBuffer.Offset != Offset || BoundBuffer.Size != Size )
+        {
+            BoundBuffer.Offset = Offset;
+            BoundBuffer.Size = Size;
+            glBindBufferRange( GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size );
+            CHECK_GL_ERROR( "Failed to bind uniform buffer range to slot ", Index );
+        }
+    }
+
     void GLContextState::BindImage( Uint32 Index,
         TextureViewGLImpl *pTexView,
         GLint MipLevel,
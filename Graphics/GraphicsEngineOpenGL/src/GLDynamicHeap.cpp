@@ -0,0 +1,126 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "GLDynamicHeap.h"
+#include "RenderDeviceGLImpl.h"
+#include "DeviceContextGLImpl.h"
+#include "FenceGLImpl.h"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+bool GLDynamicHeap::IsSupported()
+{
+#if GL_ARB_buffer_storage
+    return glBufferStorage != nullptr;
+#else
+    return false;
+#endif
+}
+
+GLDynamicHeap::GLDynamicHeap(RenderDeviceGLImpl* pDeviceGL, Uint32 Size) :
+    m_GLBuffer(true), // Create buffer immediately
+    m_RingBuffer(Size, GetRawAllocator())
+{
+#if GL_ARB_buffer_storage
+    VERIFY(IsSupported(), "Persistently mapped buffers are not supported");
+
+    GLint Alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+    CHECK_GL_ERROR("Failed to get uniform buffer offset alignment");
+    if (Alignment > 0)
+        m_Alignment = static_cast<size_t>(Alignment);
+
+    // GL_COPY_WRITE_BUFFER target is not used by anything else, so binding
+    // the buffer to it does not disturb the tracked context state
+    const GLbitfield Flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_GLBuffer);
+    // Immutable storage is required to keep the buffer mapped while it is used by the GPU.
+    // With GL_MAP_COHERENT_BIT, CPU writes become visible to all commands issued after them
+    // without explicit flushes
+    glBufferStorage(GL_COPY_WRITE_BUFFER, Size, nullptr, Flags);
+    CHECK_GL_ERROR_AND_THROW("glBufferStorage() failed");
+    m_pCPUAddress = reinterpret_cast<Uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, Size, Flags));
+    CHECK_GL_ERROR_AND_THROW("glMapBufferRange() failed");
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (m_pCPUAddress == nullptr)
+        LOG_ERROR_AND_THROW("Failed to persistently map dynamic heap buffer");
+
+    FenceDesc Desc;
+    Desc.Name = "GL dynamic heap fence";
+    pDeviceGL->CreateFence(Desc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create dynamic heap fence");
+
+    LOG_INFO_MESSAGE("Created ", Size >> 10, " KB persistently mapped dynamic heap");
+#else
+    LOG_ERROR_AND_THROW("Persistently mapped buffers are not supported");
+#endif
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // The GL buffer is not released until the GPU has finished using it, so
+    // all frames can be released without waiting for the fence
+    m_RingBuffer.FinishCurrentFrame(m_NextFenceValue);
+    m_RingBuffer.ReleaseCompletedFrames(m_NextFenceValue);
+
+    if (m_pCPUAddress != nullptr)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_GLBuffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+}
+
+GLDynamicHeap::Allocation GLDynamicHeap::Allocate(Uint32 Size)
+{
+    Allocation Alloc;
+    Alloc.Offset = m_RingBuffer.Allocate(Size, m_Alignment);
+    if (!Alloc.IsValid())
+    {
+        // Release the frames that have completed since the last frame was finished
+        m_RingBuffer.ReleaseCompletedFrames(m_pFence->GetCompletedValue());
+        Alloc.Offset = m_RingBuffer.Allocate(Size, m_Alignment);
+    }
+    if (Alloc.IsValid())
+        Alloc.Size = Size;
+    return Alloc;
+}
+
+void GLDynamicHeap::FinishFrame(DeviceContextGLImpl& Ctx)
+{
+    if (!m_RingBuffer.IsEmpty())
+    {
+        Ctx.SignalFence(m_pFence, m_NextFenceValue);
+        m_RingBuffer.FinishCurrentFrame(m_NextFenceValue);
+        ++m_NextFenceValue;
+    }
+    m_RingBuffer.ReleaseCompletedFrames(m_pFence->GetCompletedValue());
+}
+
+}
@@ -44,10 +44,11 @@ namespace Diligent
                                   Uint32 NumVars, 
                                   const StaticSamplerDesc *StaticSamplers,
                                   Uint32 NumStaticSamplers,
+                                  const GLProgramBindingRange& Bindings,
                                   IObject &Owner)
     {
         GLuint GLProgram = static_cast<GLuint>(*this);
-        m_AllResources.LoadUniforms(pDeviceGLImpl, GLProgram, DefaultVariableType, VariableDesc, NumVars, StaticSamplers, NumStaticSamplers);
+        m_AllResources.LoadUniforms(pDeviceGLImpl, GLProgram, DefaultVariableType, VariableDesc, NumVars, StaticSamplers, NumStaticSamplers, Bindings);
 
         SHADER_VARIABLE_TYPE VarTypes[] = {SHADER_VARIABLE_TYPE_STATIC};
         m_ConstantResources.Clone(m_AllResources, VarTypes, _countof(VarTypes), Owner);
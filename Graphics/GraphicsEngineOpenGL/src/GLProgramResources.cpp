@@ -50,7 +50,8 @@ namespace Diligent
                                           const ShaderVariableDesc *VariableDesc, 
                                           Uint32 NumVars,
                                           const StaticSamplerDesc *StaticSamplers,
-                                          Uint32 NumStaticSamplers)
+                                          Uint32 NumStaticSamplers,
+                                          const GLProgramBindingRange& Bindings)
     {
         VERIFY(GLProgram != 0, "Null GL program");
 
@@ -187,7 +188,7 @@ namespace Diligent
                             break;
                         }
                     }
-                    m_Samplers.emplace_back( Name.data(), size, VarType, UniformLocation, dataType, pStaticSampler );
+                    m_Samplers.emplace_back( Name.data(), size, VarType, UniformLocation, dataType, 0, pStaticSampler );
                     break;
                 }
 
@@ -294,7 +295,7 @@ namespace Diligent
 
             
             auto VarType = GetShaderVariableType(Name.data(), DefaultVariableType, VariableDesc, NumVars);
-            m_UniformBlocks.emplace_back( Name.data(), ArraySize, VarType, UniformBlockIndex );
+            m_UniformBlocks.emplace_back( Name.data(), ArraySize, VarType, UniformBlockIndex, 0 );
         }
 
 #if GL_ARB_shader_storage_buffer_object
@@ -346,6 +347,70 @@ namespace Diligent
         }
 #endif
 
+        AssignBindings(pDeviceGLImpl, GLProgram, Bindings);
+    }
+
+    void GLProgramResources::AssignBindings(RenderDeviceGLImpl *pDeviceGLImpl, GLuint GLProgram, const GLProgramBindingRange& Bindings)
+    {
+        // Uniform block bindings and sampler uniform values are part of the program state, so they
+        // are set once here. Committing resources then only needs to bind objects to these points.
+        Uint32 NumUniformBuffers = 0;
+        for (const auto& ub : m_UniformBlocks)
+            NumUniformBuffers += static_cast<Uint32>(ub.pResources.size());
+        if (NumUniformBuffers > Bindings.NumUniformBuffers)
+            LOG_ERROR_AND_THROW("The program uses ", NumUniformBuffers, " uniform buffers, while only ", Bindings.NumUniformBuffers, " binding points are available to it");
+
+        Uint32 NumTextureUnits = 0;
+        for (const auto& sam : m_Samplers)
+            NumTextureUnits += static_cast<Uint32>(sam.pResources.size());
+        if (NumTextureUnits > Bindings.NumTextureUnits)
+            LOG_ERROR_AND_THROW("The program uses ", NumTextureUnits, " textures, while only ", Bindings.NumTextureUnits, " texture units are available to it");
+
+        GLuint UniformBufferBinding = Bindings.FirstUniformBuffer;
+        for (auto& ub : m_UniformBlocks)
+        {
+            ub.Binding = UniformBufferBinding;
+            for (Uint32 ArrInd = 0; ArrInd < ub.pResources.size(); ++ArrInd)
+            {
+                glUniformBlockBinding(GLProgram, ub.Index + ArrInd, UniformBufferBinding++);
+                CHECK_GL_ERROR_AND_THROW("glUniformBlockBinding() failed");
+            }
+        }
+
+        if (m_Samplers.empty())
+            return;
+
+        // glProgramUniform1i() is available if separable programs are supported. Otherwise the program
+        // is temporarily made current, and the previous program is restored to keep GLContextState valid
+        const bool UseProgramUniform = pDeviceGLImpl->GetDeviceCaps().bSeparableProgramSupported;
+        GLint CurrentProgram = 0;
+        if (!UseProgramUniform)
+        {
+            glGetIntegerv(GL_CURRENT_PROGRAM, &CurrentProgram);
+            glUseProgram(GLProgram);
+            CHECK_GL_ERROR_AND_THROW("Failed to set GL program");
+        }
+
+        GLuint TextureUnit = Bindings.FirstTextureUnit;
+        for (auto& sam : m_Samplers)
+        {
+            sam.TextureUnit = TextureUnit;
+            for (Uint32 ArrInd = 0; ArrInd < sam.pResources.size(); ++ArrInd)
+            {
+                if (UseProgramUniform)
+                    glProgramUniform1i(GLProgram, sam.Location + ArrInd, TextureUnit);
+                else
+                    glUniform1i(sam.Location + ArrInd, TextureUnit);
+                CHECK_GL_ERROR("Failed to bind sampler uniform to texture unit");
+                ++TextureUnit;
+            }
+        }
+
+        if (!UseProgramUniform)
+        {
+            glUseProgram(CurrentProgram);
+            CHECK_GL_ERROR("Failed to restore GL program");
+        }
     }
 
     static bool CheckType(SHADER_VARIABLE_TYPE Type, SHADER_VARIABLE_TYPE* AllowedTypes, Uint32 NumAllowedTypes)
@@ -365,13 +430,13 @@ namespace Diligent
         for (auto& ub : SrcLayout.m_UniformBlocks)
         {
             if(CheckType(ub.VarType, VarTypes, NumVarTypes))
-                m_UniformBlocks.emplace_back( ub.Name, ub.pResources.size(), ub.VarType, ub.Index );
+                m_UniformBlocks.emplace_back( ub.Name, ub.pResources.size(), ub.VarType, ub.Index, ub.Binding );
         }
 
         for (auto& sam : SrcLayout.m_Samplers)
         {
             if(CheckType(sam.VarType, VarTypes, NumVarTypes))
-                m_Samplers.emplace_back( sam.Name, sam.pResources.size(), sam.VarType, sam.Location, sam.Type, const_cast<SamplerGLImpl*>(sam.pStaticSampler.RawPtr()) );
+                m_Samplers.emplace_back( sam.Name, sam.pResources.size(), sam.VarType, sam.Location, sam.Type, sam.TextureUnit, const_cast<SamplerGLImpl*>(sam.pStaticSampler.RawPtr()) );
         }
 
         for (auto& img : SrcLayout.m_Images)
@@ -442,7 +507,7 @@ namespace Diligent
                     continue; // Skip already resolved resources
 
                 RefCntAutoPtr<IDeviceObject> pNewRes;
-                pResourceMapping->GetResource( Name.c_str(), static_cast<IDeviceObject**>(&pNewRes), ArrInd );
+                GetResourceFromMapping( pResourceMapping, Name.c_str(), res.NameHash, ArrInd, static_cast<IDeviceObject**>(&pNewRes) );
 
                 if (pNewRes != nullptr)
                 {
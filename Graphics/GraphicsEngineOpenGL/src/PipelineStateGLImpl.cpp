@@ -125,7 +125,7 @@ void PipelineStateGLImpl::LinkGLProgram(bool bIsProgramPipelineSupported)
         }
 
         auto pDeviceGL = static_cast<RenderDeviceGLImpl*>( GetDevice() );
-        m_GLProgram.InitResources(pDeviceGL, DefaultVarType, MergedVarTypesArray.data(), static_cast<Uint32>(MergedVarTypesArray.size()), MergedStSamArray.data(), static_cast<Uint32>(MergedStSamArray.size()), *this);
+        m_GLProgram.InitResources(pDeviceGL, DefaultVarType, MergedVarTypesArray.data(), static_cast<Uint32>(MergedVarTypesArray.size()), MergedStSamArray.data(), static_cast<Uint32>(MergedStSamArray.size()), pDeviceGL->GetProgramBindingRange(SHADER_TYPE_UNKNOWN), *this);
 
         m_ShaderResourceLayoutHash = m_GLProgram.GetAllResources().GetHash();
     }   
@@ -69,15 +69,17 @@ public:
 
     virtual void CreateDeviceAndSwapChainGL(const EngineGLAttribs& CreationAttribs,
                                             IRenderDevice **ppDevice,
-                                            IDeviceContext **ppImmediateContext,
+                                            IDeviceContext **ppContexts,
                                             const SwapChainDesc& SCDesc, 
-                                            ISwapChain **ppSwapChain )override final;
+                                            ISwapChain **ppSwapChain,
+                                            Uint32 NumDeferredContexts )override final;
 
     virtual void CreateHLSL2GLSLConverter(IHLSL2GLSLConverter **ppConverter)override final;
 
     virtual void AttachToActiveGLContext( const EngineGLAttribs& CreationAttribs,
                                           IRenderDevice **ppDevice,
-                                          IDeviceContext **ppImmediateContext )override final;
+                                          IDeviceContext **ppContexts,
+                                          Uint32 NumDeferredContexts )override final;
 };
 
 
@@ -87,26 +89,34 @@ public:
 /// \param [in] CreationAttribs - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to 
 ///                         the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to 
-///                                   the immediate context will be written.
+/// \param [out] ppContexts - Address of the memory location where pointers to 
+///                           the contexts will be written. Pointer to the immediate 
+///                           context goes at position 0. If NumDeferredContexts > 0,
+///                           pointers to the deferred contexts go afterwards.
 /// \param [in] SCDesc - Swap chain description.
 /// \param [out] ppSwapChain    - Address of the memory location where pointer to the new 
 ///                               swap chain will be written.
+/// \param [in] NumDeferredContexts - Number of deferred contexts. If non-zero number
+///                                   of deferred contexts is requested, pointers to the
+///                                   contexts are written to ppContexts array starting 
+///                                   at position 1. Deferred contexts record commands that
+///                                   are executed by the immediate context.
 void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLAttribs& CreationAttribs,
                                                          IRenderDevice **ppDevice,
-                                                         IDeviceContext **ppImmediateContext,
+                                                         IDeviceContext **ppContexts,
                                                          const SwapChainDesc& SCDesc, 
-                                                         ISwapChain **ppSwapChain )
+                                                         ISwapChain **ppSwapChain,
+                                                         Uint32 NumDeferredContexts )
 {
     if (CreationAttribs.DebugMessageCallback != nullptr)
         SetDebugMessageCallback(CreationAttribs.DebugMessageCallback);
 
-    VERIFY( ppDevice && ppImmediateContext && ppSwapChain, "Null pointer provided" );
-    if( !ppDevice || !ppImmediateContext || !ppSwapChain )
+    VERIFY( ppDevice && ppContexts && ppSwapChain, "Null pointer provided" );
+    if( !ppDevice || !ppContexts || !ppSwapChain )
         return;
 
     *ppDevice = nullptr;
-    *ppImmediateContext = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1+NumDeferredContexts));
     *ppSwapChain = nullptr;
 
     try
@@ -114,15 +124,26 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLAttribs&
         SetRawAllocator(CreationAttribs.pRawMemAllocator);
         auto &RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceGLImpl *pRenderDeviceOpenGL( NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, CreationAttribs) );
+        RenderDeviceGLImpl *pRenderDeviceOpenGL( NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, CreationAttribs, NumDeferredContexts) );
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice) );
 
-        DeviceContextGLImpl *pDeviceContextOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false ) );
+        DeviceContextGLImpl *pDeviceContextOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, CreationAttribs, false ) );
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext) );
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts) );
         pRenderDeviceOpenGL->SetImmediateContext(pDeviceContextOpenGL);
 
+        for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
+        {
+            // Deferred contexts never call OpenGL: they record commands that are
+            // executed by the immediate context
+            RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, CreationAttribs, true ) );
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx) );
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxOpenGL);
+        }
+
         TSwapChain *pSwapChainGL = NEW_RC_OBJ(RawMemAllocator, "SwapChainGLImpl instance", TSwapChain)(CreationAttribs, SCDesc, pRenderDeviceOpenGL, pDeviceContextOpenGL );
         pSwapChainGL->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain) );
 
@@ -130,6 +151,12 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLAttribs&
         // Bind default framebuffer and viewport
         pDeviceContextOpenGL->SetRenderTargets( 0, nullptr, nullptr );
         pDeviceContextOpenGL->SetViewports( 1, nullptr, 0, 0 );
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
+        {
+            // Do not bind default render target and viewport to be consistent with other backends
+            ValidatedCast<DeviceContextGLImpl>(ppContexts[1 + DeferredCtx])->SetSwapChain(pSwapChainGL);
+        }
     }
     catch( const std::runtime_error & )
     {
@@ -139,10 +166,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLAttribs&
             *ppDevice = nullptr;
         }
 
-        if( *ppImmediateContext )
+        for(Uint32 ctx=0; ctx < 1 + NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if( ppContexts[ctx] != nullptr )
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         if( *ppSwapChain )
@@ -161,35 +191,54 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLAttribs&
 /// \param [in] CreationAttribs - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to 
 ///                         the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to 
-///                                   the immediate context will be written.
+/// \param [out] ppContexts - Address of the memory location where pointers to 
+///                           the contexts will be written. Pointer to the immediate 
+///                           context goes at position 0. If NumDeferredContexts > 0,
+///                           pointers to the deferred contexts go afterwards.
+/// \param [in] NumDeferredContexts - Number of deferred contexts. If non-zero number
+///                                   of deferred contexts is requested, pointers to the
+///                                   contexts are written to ppContexts array starting 
+///                                   at position 1. Deferred contexts record commands that
+///                                   are executed by the immediate context.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext( const EngineGLAttribs& CreationAttribs,
                                                        IRenderDevice **ppDevice,
-                                                       IDeviceContext **ppImmediateContext )
+                                                       IDeviceContext **ppContexts,
+                                                       Uint32 NumDeferredContexts )
 {
     if (CreationAttribs.DebugMessageCallback != nullptr)
         SetDebugMessageCallback(CreationAttribs.DebugMessageCallback);
 
-    VERIFY( ppDevice && ppImmediateContext, "Null pointer provided" );
-    if( !ppDevice || !ppImmediateContext )
+    VERIFY( ppDevice && ppContexts, "Null pointer provided" );
+    if( !ppDevice || !ppContexts )
         return;
 
     *ppDevice = nullptr;
-    *ppImmediateContext = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (1+NumDeferredContexts));
 
     try
     {
         SetRawAllocator(CreationAttribs.pRawMemAllocator);
         auto &RawMemAllocator = GetRawAllocator();
 
-        RenderDeviceGLImpl *pRenderDeviceOpenGL( NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, CreationAttribs) );
+        RenderDeviceGLImpl *pRenderDeviceOpenGL( NEW_RC_OBJ(RawMemAllocator, "TRenderDeviceGLImpl instance", TRenderDeviceGLImpl)(RawMemAllocator, CreationAttribs, NumDeferredContexts) );
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice) );
 
-        DeviceContextGLImpl *pDeviceContextOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, false ) );
+        DeviceContextGLImpl *pDeviceContextOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, CreationAttribs, false ) );
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext) );
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts) );
         pRenderDeviceOpenGL->SetImmediateContext(pDeviceContextOpenGL);
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
+        {
+            // Deferred contexts never call OpenGL: they record commands that are
+            // executed by the immediate context
+            RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxOpenGL( NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(pRenderDeviceOpenGL, CreationAttribs, true ) );
+            // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+            // keep a weak reference to the context
+            pDeferredCtxOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx) );
+            pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxOpenGL);
+        }
     }
     catch( const std::runtime_error & )
     {
@@ -199,10 +248,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext( const EngineGLAttribs& Cr
             *ppDevice = nullptr;
         }
 
-        if( *ppImmediateContext )
+        for(Uint32 ctx=0; ctx < 1 + NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if( ppContexts[ctx] != nullptr )
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR( "Failed to initialize OpenGL-based render device" );
@@ -27,8 +27,8 @@
 
 namespace Diligent
 {
-    RenderDeviceGLESImpl::RenderDeviceGLESImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs ) :
-        RenderDeviceGLImpl( pRefCounters, RawMemAllocator, InitAttribs )
+    RenderDeviceGLESImpl::RenderDeviceGLESImpl( IReferenceCounters *pRefCounters, IMemoryAllocator &RawMemAllocator, const EngineGLAttribs &InitAttribs, Uint32 NumDeferredContexts ) :
+        RenderDeviceGLImpl( pRefCounters, RawMemAllocator, InitAttribs, NumDeferredContexts )
     {
     }
 
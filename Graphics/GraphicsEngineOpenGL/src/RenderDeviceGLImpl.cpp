@@ -47,12 +47,12 @@
 namespace Diligent
 {
 
-RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemoryAllocator& RawMemAllocator, const EngineGLAttribs& InitAttribs):
+RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemoryAllocator& RawMemAllocator, const EngineGLAttribs& InitAttribs, Uint32 NumDeferredContexts):
     TRenderDeviceBase
     {
         pRefCounters,
         RawMemAllocator,
-        0,
+        NumDeferredContexts,
         sizeof(TextureBaseGL),
         sizeof(TextureViewGLImpl),
         sizeof(BufferGLImpl),
@@ -64,8 +64,7 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemo
         sizeof(FenceGLImpl)
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext(InitAttribs, m_DeviceCaps),
-    m_TexRegionRender(this)
+    m_GLContext(InitAttribs, m_DeviceCaps)
 {
     GLint NumExtensions = 0;
     glGetIntegerv( GL_NUM_EXTENSIONS,& NumExtensions );
@@ -81,6 +80,8 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemo
     FlagSupportedTexFormats();
     QueryDeviceCaps();
 
+    m_pTexRegionRender.reset( new TexRegionRender(this) );
+
     std::basic_string<GLubyte> glstrVendor = glGetString( GL_VENDOR );
     std::string Vendor = StrToLower(std::string(glstrVendor.begin(), glstrVendor.end()));
     LOG_INFO_MESSAGE("GPU Vendor: ", Vendor);
@@ -94,10 +95,18 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemo
         m_GPUInfo.Vendor = GPU_VENDOR::ATI;
     else if( Vendor.find( "qualcomm" ) )
         m_GPUInfo.Vendor = GPU_VENDOR::QUALCOMM;
+
+    if( InitAttribs.ShaderCacheFilePath != nullptr )
+        m_pShaderCache.reset( new ShaderCache(InitAttribs.ShaderCacheFilePath) );
 }
 
 RenderDeviceGLImpl :: ~RenderDeviceGLImpl()
 {
+    if( m_pShaderCache )
+    {
+        auto Stats = m_pShaderCache->GetStatistics();
+        LOG_INFO_MESSAGE("Shader cache '", m_pShaderCache->GetFilePath(), "': ", Stats.NumHits, " hits, ", Stats.NumMisses, " misses, ", Stats.NumStores, " new entries");
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE( RenderDeviceGLImpl, IID_RenderDeviceGL, TRenderDeviceBase )
@@ -697,6 +706,49 @@ void RenderDeviceGLImpl :: QueryDeviceCaps()
         if( glGetError() != GL_NO_ERROR )
             m_DeviceCaps.bWireframeFillSupported = False;
     }
+
+    glGetIntegerv( GL_MAX_UNIFORM_BUFFER_BINDINGS, &m_MaxUniformBufferBindings );
+    CHECK_GL_ERROR( "Failed to get the maximum number of uniform buffer bindings" );
+    glGetIntegerv( GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &m_MaxCombinedTextureUnits );
+    CHECK_GL_ERROR( "Failed to get the maximum number of combined texture image units" );
+}
+
+GLProgramBindingRange RenderDeviceGLImpl::GetProgramBindingRange(SHADER_TYPE ShaderType)const
+{
+    GLProgramBindingRange Range;
+    Range.NumUniformBuffers = static_cast<Uint32>(m_MaxUniformBufferBindings);
+    // The last texture unit is used by GLContextState to bind textures that are being updated or queried
+    Range.NumTextureUnits   = static_cast<Uint32>(std::max(m_MaxCombinedTextureUnits - 1, 0));
+
+    // Compute shaders are never combined with other stages, so they can use all binding points as well
+    if( ShaderType == SHADER_TYPE_UNKNOWN || ShaderType == SHADER_TYPE_COMPUTE )
+        return Range;
+
+    Uint32 NumStages = 2; // Vertex and pixel
+    const Uint32 GSStage = NumStages;
+    if( m_DeviceCaps.bGeometryShadersSupported )
+        ++NumStages;
+    const Uint32 HSStage = NumStages;
+    if( m_DeviceCaps.bTessellationSupported )
+        NumStages += 2;
+
+    Uint32 Stage = 0;
+    switch( ShaderType )
+    {
+        case SHADER_TYPE_VERTEX:   Stage = 0;           break;
+        case SHADER_TYPE_PIXEL:    Stage = 1;           break;
+        case SHADER_TYPE_GEOMETRY: Stage = GSStage;     break;
+        case SHADER_TYPE_HULL:     Stage = HSStage;     break;
+        case SHADER_TYPE_DOMAIN:   Stage = HSStage + 1; break;
+        default: UNEXPECTED("Unexpected shader type");
+    }
+    VERIFY(Stage < NumStages, "The shader stage is not supported by the device");
+
+    Range.NumUniformBuffers /= NumStages;
+    Range.NumTextureUnits   /= NumStages;
+    Range.FirstUniformBuffer = Range.NumUniformBuffers * Stage;
+    Range.FirstTextureUnit   = Range.NumTextureUnits   * Stage;
+    return Range;
 }
 
 
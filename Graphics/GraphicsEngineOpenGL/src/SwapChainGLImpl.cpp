@@ -75,6 +75,12 @@ void SwapChainGLImpl::Present(Uint32 SyncInterval)
     auto *pDeviceGL = m_pRenderDevice.RawPtr<RenderDeviceGLImpl>();
     auto &GLContext = pDeviceGL->m_GLContext;
     GLContext.SwapBuffers();
+
+    auto pDeviceContext = m_wpDeviceContext.Lock();
+    if (pDeviceContext)
+        ValidatedCast<DeviceContextGLImpl>(pDeviceContext.RawPtr())->FinishFrame();
+    else
+        LOG_ERROR_MESSAGE("Immediate context has been released");
 #elif PLATFORM_MACOS
     LOG_ERROR("Swap buffers operation must be performed by the app on MacOS");
 #else
@@ -99,7 +99,14 @@ Texture1D_OGL::~Texture1D_OGL()
 
 void Texture1D_OGL::UpdateData( IDeviceContext *pContext, Uint32 MipLevel, Uint32 Slice, const Box &DstBox, const TextureSubResData &SubresData )
 {
-    auto &ContextState = ValidatedCast<DeviceContextGLImpl>(pContext)->GetContextState();
+    auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
+    if (pDeviceContextGL->IsDeferred())
+    {
+        pDeviceContextGL->RecordUpdateTexture(this, MipLevel, Slice, DstBox, SubresData);
+        return;
+    }
+
+    auto &ContextState = pDeviceContextGL->GetContextState();
     TextureBaseGL::UpdateData(ContextState, pContext, MipLevel, Slice, DstBox, SubresData);
 
     ContextState.BindTexture( -1, m_BindTarget, m_GlTexture );
@@ -123,7 +123,14 @@ Texture2DArray_OGL::~Texture2DArray_OGL()
 
 void Texture2DArray_OGL::UpdateData(IDeviceContext *pContext, Uint32 MipLevel, Uint32 Slice, const Box &DstBox, const TextureSubResData &SubresData)
 {
-    auto &ContextState = ValidatedCast<DeviceContextGLImpl>(pContext)->GetContextState();
+    auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
+    if (pDeviceContextGL->IsDeferred())
+    {
+        pDeviceContextGL->RecordUpdateTexture(this, MipLevel, Slice, DstBox, SubresData);
+        return;
+    }
+
+    auto &ContextState = pDeviceContextGL->GetContextState();
     TextureBaseGL::UpdateData(ContextState, pContext, MipLevel, Slice, DstBox, SubresData);
 
     ContextState.BindTexture(-1, m_BindTarget, m_GlTexture);
@@ -399,6 +399,12 @@ void TextureBaseGL :: CopyData(IDeviceContext *pContext,
     TTextureBase::CopyData( pContext, pSrcTexture, SrcMipLevel, SrcSlice, pSrcBox,
                             DstMipLevel, DstSlice, DstX, DstY, DstZ );
 
+    if (pDeviceCtxGL->IsDeferred())
+    {
+        pDeviceCtxGL->RecordCopyTexture(this, pSrcTextureGL, SrcMipLevel, SrcSlice, *pSrcBox, DstMipLevel, DstSlice, DstX, DstY, DstZ);
+        return;
+    }
+
 #if GL_ARB_copy_image
     if( glCopyImageSubData )
     {
@@ -438,7 +444,7 @@ void TextureBaseGL :: CopyData(IDeviceContext *pContext,
         auto &TexViewObjAllocator = pRenderDeviceGL->GetTexViewObjAllocator();
         VERIFY( &TexViewObjAllocator == &m_dbgTexViewObjAllocator, "Texture view allocator does not match allocator provided during texture initialization" );
 
-        auto &TexRegionRender = pRenderDeviceGL->m_TexRegionRender;
+        auto &TexRegionRender = *pRenderDeviceGL->m_pTexRegionRender;
         TexRegionRender.SetStates(pDeviceCtxGL);
 
         // Create temporary SRV for the entire source texture
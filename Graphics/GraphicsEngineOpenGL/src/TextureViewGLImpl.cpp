@@ -75,6 +75,12 @@ namespace Diligent
     void TextureViewGLImpl::GenerateMips( IDeviceContext *pContext )
     {
         auto pCtxGL = ValidatedCast<DeviceContextGLImpl>( pContext );
+        if (pCtxGL->IsDeferred())
+        {
+            pCtxGL->RecordGenerateMips(this);
+            return;
+        }
+
         auto &GLState = pCtxGL->GetContextState();
         auto BindTarget = GetBindTarget();
         GLState.BindTexture( -1, BindTarget, GetHandle() );
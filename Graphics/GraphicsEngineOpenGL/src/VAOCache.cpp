@@ -23,6 +23,8 @@
 
 #include "pch.h"
 
+#include <algorithm>
+#include <cstring>
 #include "VAOCache.h"
 #include "RenderDeviceGLImpl.h"
 #include "GLObjectWrapper.h"
@@ -34,41 +36,260 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// Initial number of slots in the hash table
+const size_t MinCacheCapacity = 64;
+
+// Number of destroyed pipeline states and buffers that cannot be bound as vertex or index buffers
+// that are allowed to accumulate before the cache is purged, in addition to half the number of
+// cached VAOs. The purge visits every entry of the table, so its cost is amortized over the destroyed
+// objects. Cached VAOs only reference such objects by their IDs and do not keep them alive.
+const Uint64 MinPurgeThreshold = 64;
+
+inline size_t HashValue(size_t Hash, Uint64 Value)
+{
+    Uint64 Mixed = (Uint64{Hash} ^ Value) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(Mixed ^ (Mixed >> 29));
+}
+
+}
+
 VAOCache::VAOCache() : 
     m_EmptyVAO(true)
 {
-    m_Cache.max_load_factor(0.5f);
-    m_PSOToKey.max_load_factor(0.5f);
-    m_BuffToKey.max_load_factor(0.5f);
 }
 
 VAOCache::~VAOCache()
 {
-    VERIFY(m_Cache.empty(), "VAO cache is not empty. Are there any unreleased objects?");
-    VERIFY(m_PSOToKey.empty(), "PSOToKey hash is not empty" );
-    VERIFY(m_BuffToKey.empty(), "BuffToKey hash is not empty");
+    // All objects must have been destroyed by now, so the purge is expected to evict every entry
+    PurgeAndRehash(m_Entries.size());
+    VERIFY(m_NumEntries == 0, "VAO cache is not empty. Are there any unreleased objects?");
 }
 
 void VAOCache::OnDestroyBuffer(IBuffer *pBuffer)
 {
+    auto BufferId = ValidatedCast<BufferGLImpl>(pBuffer)->GetUniqueID();
+    const bool IsVertexOrIndexBuffer = (pBuffer->GetDesc().BindFlags & (BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER)) != 0;
     ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
-    auto EqualRange = m_BuffToKey.equal_range(pBuffer);
-    for(auto It = EqualRange.first; It != EqualRange.second; ++It)
+    if (IsVertexOrIndexBuffer)
+    {
+        m_DestroyedVertexBuffers.push_back(BufferId);
+        ++m_DestroyedVertexBuffersGeneration;
+    }
+    else
     {
-        m_Cache.erase(It->second);
+        m_DestroyedBuffers.push_back(BufferId);
+        ++m_DestroyedObjectsGeneration;
     }
-    m_BuffToKey.erase(EqualRange.first, EqualRange.second);
 }
 
 void VAOCache::OnDestroyPSO(IPipelineState *pPSO)
 {
+    auto PSOId = ValidatedCast<PipelineStateGLImpl>(pPSO)->GetUniqueID();
     ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
-    auto EqualRange = m_PSOToKey.equal_range(pPSO);
-    for(auto It = EqualRange.first; It != EqualRange.second; ++It)
+    m_DestroyedPSOs.push_back(PSOId);
+    ++m_DestroyedObjectsGeneration;
+}
+
+size_t VAOCache::FindEntry(size_t Hash, UniqueIdentifier PSOId, UniqueIdentifier IndexBufferId, const StreamKey* Streams, Uint32 NumUsedSlots)const
+{
+    VERIFY_EXPR(!m_Entries.empty());
+    const size_t Mask = m_Entries.size() - 1;
+    // The table is at most half full, so the search always reaches an empty slot
+    for (size_t Idx = Hash & Mask; ; Idx = (Idx + 1) & Mask)
     {
-        m_Cache.erase(It->second);
+        const auto& Entry = m_Entries[Idx];
+        if (Entry.PSOId == 0)
+            return Idx;
+
+        if (Entry.Hash          == Hash          &&
+            Entry.PSOId         == PSOId         &&
+            Entry.IndexBufferId == IndexBufferId &&
+            Entry.NumUsedSlots  == NumUsedSlots  &&
+            (NumUsedSlots == 0 || std::memcmp(&m_Streams[Entry.FirstStream], Streams, sizeof(StreamKey) * NumUsedSlots) == 0))
+            return Idx;
     }
-    m_PSOToKey.erase(EqualRange.first, EqualRange.second);
+}
+
+void VAOCache::PurgeAndRehash(size_t Capacity)
+{
+    VERIFY((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    std::vector<UniqueIdentifier> DestroyedBuffers, DestroyedPSOs;
+    {
+        ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+        DestroyedBuffers.swap(m_DestroyedBuffers);
+        DestroyedBuffers.insert(DestroyedBuffers.end(), m_DestroyedVertexBuffers.begin(), m_DestroyedVertexBuffers.end());
+        m_DestroyedVertexBuffers.clear();
+        DestroyedPSOs.swap(m_DestroyedPSOs);
+        m_PurgedGeneration              = m_DestroyedObjectsGeneration;
+        m_PurgedVertexBuffersGeneration = m_DestroyedVertexBuffersGeneration;
+    }
+    std::sort(DestroyedBuffers.begin(), DestroyedBuffers.end());
+    std::sort(DestroyedPSOs.begin(), DestroyedPSOs.end());
+
+    auto IsDestroyed = [](const std::vector<UniqueIdentifier>& DestroyedIds, UniqueIdentifier Id)
+    {
+        return std::binary_search(DestroyedIds.begin(), DestroyedIds.end(), Id);
+    };
+
+    std::vector<CacheEntry> OldEntries(Capacity);
+    std::vector<StreamKey> OldStreams;
+    m_Entries.swap(OldEntries);
+    m_Streams.swap(OldStreams);
+    m_Streams.reserve(m_NumUsedStreams);
+    m_NumEntries = 0;
+    m_BufferEntries.clear();
+
+    const size_t Mask = Capacity - 1;
+    for (auto& Entry : OldEntries)
+    {
+        if (Entry.PSOId == 0)
+            continue;
+
+        const auto* Streams = OldStreams.data() + Entry.FirstStream;
+        bool IsStale = IsDestroyed(DestroyedPSOs, Entry.PSOId) ||
+                       (Entry.IndexBufferId != 0 && IsDestroyed(DestroyedBuffers, Entry.IndexBufferId));
+        for (Uint32 Slot = 0; Slot < Entry.NumUsedSlots && !IsStale; ++Slot)
+            IsStale = Streams[Slot].BufferId != 0 && IsDestroyed(DestroyedBuffers, Streams[Slot].BufferId);
+        // VAOs of stale entries are deleted together with the old table. This happens
+        // on the thread that owns the GL context, so the VAOs are deleted in the right context.
+        if (IsStale)
+            continue;
+
+        // All keys in the table are unique, so the entry goes to the first empty slot
+        auto Idx = Entry.Hash & Mask;
+        while (m_Entries[Idx].PSOId != 0)
+            Idx = (Idx + 1) & Mask;
+
+        Entry.FirstStream = static_cast<Uint32>(m_Streams.size());
+        m_Streams.insert(m_Streams.end(), Streams, Streams + Entry.NumUsedSlots);
+
+        UniqueIdentifier BufferIds[MaxBufferSlots + 1];
+        auto NumBufferIds = GetBufferIds(Entry, BufferIds);
+        for (Uint32 i = 0; i < NumBufferIds; ++i)
+            m_BufferEntries[BufferIds[i]].push_back(EntryRef{Entry.Hash, Entry.Serial});
+
+        m_Entries[Idx] = std::move(Entry);
+        ++m_NumEntries;
+    }
+    m_NumUsedStreams = m_Streams.size();
+    VERIFY_EXPR(m_NumEntries * 2 <= Capacity);
+}
+
+Uint32 VAOCache::GetBufferIds(const CacheEntry& Entry, UniqueIdentifier BufferIds[])const
+{
+    Uint32 NumBufferIds = 0;
+    auto AddBufferId = [&](UniqueIdentifier BufferId)
+    {
+        if (BufferId != 0 && std::find(BufferIds, BufferIds + NumBufferIds, BufferId) == BufferIds + NumBufferIds)
+            BufferIds[NumBufferIds++] = BufferId;
+    };
+
+    AddBufferId(Entry.IndexBufferId);
+    for (Uint32 Slot = 0; Slot < Entry.NumUsedSlots; ++Slot)
+        AddBufferId(m_Streams[Entry.FirstStream + Slot].BufferId);
+    return NumBufferIds;
+}
+
+void VAOCache::EraseEntry(size_t Idx)
+{
+    auto& Entry = m_Entries[Idx];
+    VERIFY_EXPR(Entry.PSOId != 0);
+
+    UniqueIdentifier BufferIds[MaxBufferSlots + 1];
+    auto NumBufferIds = GetBufferIds(Entry, BufferIds);
+    for (Uint32 i = 0; i < NumBufferIds; ++i)
+    {
+        // The list of the destroyed buffer that is being evicted has already been removed
+        auto ListIt = m_BufferEntries.find(BufferIds[i]);
+        if (ListIt == m_BufferEntries.end())
+            continue;
+
+        auto& Refs = ListIt->second;
+        auto RefIt = std::find_if(Refs.begin(), Refs.end(), [&](const EntryRef& Ref){ return Ref.Serial == Entry.Serial; });
+        VERIFY_EXPR(RefIt != Refs.end());
+        if (RefIt != Refs.end())
+        {
+            *RefIt = Refs.back();
+            Refs.pop_back();
+        }
+        if (Refs.empty())
+            m_BufferEntries.erase(ListIt);
+    }
+
+    m_NumUsedStreams -= Entry.NumUsedSlots;
+    --m_NumEntries;
+    // The VAO is deleted on the thread that owns the GL context
+    Entry = CacheEntry{};
+
+    // Move entries that follow the erased one back, so that no probe sequence
+    // is interrupted by the empty slot
+    const size_t Mask = m_Entries.size() - 1;
+    size_t Hole = Idx;
+    for (size_t Next = (Hole + 1) & Mask; m_Entries[Next].PSOId != 0; Next = (Next + 1) & Mask)
+    {
+        // The entry can be moved to the hole unless its home slot lies between the hole and the entry
+        const size_t Home = m_Entries[Next].Hash & Mask;
+        if (((Next - Home) & Mask) >= ((Next - Hole) & Mask))
+        {
+            m_Entries[Hole] = std::move(m_Entries[Next]);
+            m_Entries[Next] = CacheEntry{};
+            Hole = Next;
+        }
+    }
+}
+
+void VAOCache::EvictDestroyedVertexBuffers()
+{
+    std::vector<UniqueIdentifier> DestroyedVertexBuffers;
+    {
+        ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+        DestroyedVertexBuffers.swap(m_DestroyedVertexBuffers);
+        m_PurgedVertexBuffersGeneration = m_DestroyedVertexBuffersGeneration;
+    }
+
+    const size_t Mask = m_Entries.size() - 1;
+    for (auto BufferId : DestroyedVertexBuffers)
+    {
+        // Buffers that have never been used by a draw are not referenced by any entry
+        auto ListIt = m_BufferEntries.find(BufferId);
+        if (ListIt == m_BufferEntries.end())
+            continue;
+
+        auto Refs = std::move(ListIt->second);
+        m_BufferEntries.erase(ListIt);
+        for (const auto& Ref : Refs)
+        {
+            auto Idx = Ref.Hash & Mask;
+            while (m_Entries[Idx].PSOId != 0 && m_Entries[Idx].Serial != Ref.Serial)
+                Idx = (Idx + 1) & Mask;
+            VERIFY(m_Entries[Idx].PSOId != 0, "The entry that references the buffer is not found in the table");
+            if (m_Entries[Idx].PSOId != 0)
+                EraseEntry(Idx);
+        }
+    }
+
+    // Streams of erased entries are reclaimed when they outnumber the streams in use
+    if (m_Streams.size() > m_NumUsedStreams * 2 + MinCacheCapacity)
+        PurgeAndRehash(m_Entries.size());
+}
+
+void VAOCache::PurgeStaleEntries()
+{
+    // Stale entries can never be hit as unique IDs are not reused, so destroyed pipeline states and other
+    // objects are evicted in batches by rehashing the table, which evicts destroyed vertex buffers as well.
+    // A VAO attachment keeps the storage of a destroyed buffer object alive until the VAO is deleted,
+    // so entries that reference destroyed vertex or index buffers are otherwise evicted right away in place,
+    // unless so many buffers have been destroyed that rehashing the table is cheaper.
+    const auto PurgeThreshold = std::max(MinPurgeThreshold, Uint64{m_NumEntries / 2});
+    const auto NumDestroyedVertexBuffers = m_DestroyedVertexBuffersGeneration.load() - m_PurgedVertexBuffersGeneration;
+    if (m_DestroyedObjectsGeneration.load() - m_PurgedGeneration > PurgeThreshold || NumDestroyedVertexBuffers > PurgeThreshold)
+        PurgeAndRehash(m_Entries.size());
+    else if (NumDestroyedVertexBuffers != 0)
+        EvictDestroyedVertexBuffers();
 }
 
 const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO,
@@ -77,8 +298,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO
                                                             Uint32 NumVertexStreams,
                                                             GLContextState &GLContextState )
 {
-    // Lock the cache
-    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    PurgeStaleEntries();
 
     IBuffer* VertexBuffers[MaxBufferSlots];
     for (Uint32 s = 0; s < NumVertexStreams; ++s)
@@ -92,7 +312,10 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO
     Uint32 NumElems = InputLayout.NumElements;
     const Uint32 *Strides = pPSOGL->GetBufferStrides();
     // Construct the key
-    VAOCacheKey Key(pPSO, pIndexBuffer);
+    const UniqueIdentifier PSOId = pPSOGL->GetUniqueID();
+    const UniqueIdentifier IndexBufferId = pIndexBuffer != nullptr ? ValidatedCast<BufferGLImpl>(pIndexBuffer)->GetUniqueID() : 0;
+    StreamKey Streams[MaxBufferSlots];
+    Uint32 NumUsedSlots = 0;
     
     {
         auto LayoutIt = LayoutElems;
@@ -109,15 +332,15 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO
                 VERIFY(BuffSlot >= MaxBufferSlots, "Incorrect input slot");
                 continue;
             }
-            auto MaxUsedSlot = std::max(Key.NumUsedSlots, BuffSlot + 1);
-            for (Uint32 s = Key.NumUsedSlots; s < MaxUsedSlot; ++s)
-                Key.Streams[s] = VAOCacheKey::StreamAttribs{};
-            Key.NumUsedSlots = MaxUsedSlot;
+            auto MaxUsedSlot = std::max(NumUsedSlots, BuffSlot + 1);
+            for (Uint32 s = NumUsedSlots; s < MaxUsedSlot; ++s)
+                Streams[s] = StreamKey{};
+            NumUsedSlots = MaxUsedSlot;
 
             auto &CurrStream = VertexStreams[BuffSlot];
             auto Stride = Strides[BuffSlot];
             auto &pCurrBuf = VertexBuffers[BuffSlot];
-            auto &CurrStreamKey = Key.Streams[BuffSlot];
+            auto &CurrStreamKey = Streams[BuffSlot];
             if (pCurrBuf == nullptr)
             {
                 pCurrBuf = CurrStream.pBuffer;
@@ -130,14 +353,14 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO
                                                        // from the GL_VERTEX_ARRAY_BUFFER_BINDING bindings
                     GLContextState);
 
-                CurrStreamKey.pBuffer = pCurrBuf;
+                CurrStreamKey.BufferId = CurrStream.pBuffer->GetUniqueID();
                 CurrStreamKey.Stride = Stride;
                 CurrStreamKey.Offset = CurrStream.Offset;
             }
             else
             {
                 VERIFY(pCurrBuf == CurrStream.pBuffer, "Buffer no longer exists");
-                VERIFY(CurrStreamKey.pBuffer == pCurrBuf, "Unexpected buffer");
+                VERIFY(CurrStreamKey.BufferId == CurrStream.pBuffer->GetUniqueID(), "Unexpected buffer");
                 VERIFY(CurrStreamKey.Stride == Stride, "Unexpected buffer stride");
                 VERIFY(CurrStreamKey.Offset == CurrStream.Offset, "Unexpected buffer offset");
             }
@@ -154,78 +377,99 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO( IPipelineState *pPSO
             GLContextState);
     }
 
-    // Try to find VAO in the map
-    auto It = m_Cache.find(Key);
-    if( It != m_Cache.end() )
+    size_t Hash = HashValue(HashValue(0, PSOId), IndexBufferId);
+    for (Uint32 Slot = 0; Slot < NumUsedSlots; ++Slot)
     {
-        return It->second;
+        const auto& CurrStreamKey = Streams[Slot];
+        Hash = HashValue(Hash, CurrStreamKey.BufferId);
+        Hash = HashValue(Hash, (Uint64{CurrStreamKey.Stride} << 32) | CurrStreamKey.Offset);
     }
-    else
+
+    // Try to find VAO in the cache
+    size_t Idx = 0;
+    if (!m_Entries.empty())
     {
-        // Create new VAO
-        GLObjectWrappers::GLVertexArrayObj NewVAO(true);
+        Idx = FindEntry(Hash, PSOId, IndexBufferId, Streams, NumUsedSlots);
+        if (m_Entries[Idx].PSOId != 0)
+            return m_Entries[Idx].VAO;
+    }
 
-        // Initialize VAO
-        GLContextState.BindVAO( NewVAO );
-        auto LayoutIt = LayoutElems;
-        for( size_t Elem = 0; Elem < NumElems; ++Elem, ++LayoutIt )
-        {
-            auto BuffSlot = LayoutIt->BufferSlot;
-            if( BuffSlot >= NumVertexStreams || BuffSlot >= MaxBufferSlots )
-            {
-                UNEXPECTED( "Incorrect input buffer slot" );
-                continue;
-            }
-            // Get buffer through the strong reference. Note that we are not
-            // using pointers stored in the key for safety
-            auto &CurrStream = VertexStreams[BuffSlot];
-            auto Stride = Strides[BuffSlot];
-            auto *pBuff = VertexBuffers[BuffSlot];
-            VERIFY( pBuff != nullptr, "Vertex buffer is null" );
-            const BufferGLImpl *pBufferOGL = static_cast<const BufferGLImpl*>( pBuff );
-
-            glBindBuffer(GL_ARRAY_BUFFER, pBufferOGL->m_GlBuffer);
-            GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>( static_cast<size_t>( CurrStream.Offset + LayoutIt->RelativeOffset ) );
-            auto GlType = TypeToGLType(LayoutIt->ValueType);
-            if( !LayoutIt->IsNormalized &&
-                (LayoutIt->ValueType == VT_INT8  || 
-                 LayoutIt->ValueType == VT_INT16 ||
-                 LayoutIt->ValueType == VT_INT32 ||
-                 LayoutIt->ValueType == VT_UINT8 || 
-                 LayoutIt->ValueType == VT_UINT16||
-                 LayoutIt->ValueType == VT_UINT32 ) )
-                glVertexAttribIPointer(LayoutIt->InputIndex, LayoutIt->NumComponents, GlType, Stride, DataStartOffset );
-            else
-                glVertexAttribPointer(LayoutIt->InputIndex, LayoutIt->NumComponents, GlType, LayoutIt->IsNormalized, Stride, DataStartOffset );
+    // Keep the table at most half full
+    if ((m_NumEntries + 1) * 2 > m_Entries.size())
+    {
+        PurgeAndRehash(std::max(m_Entries.size() * 2, MinCacheCapacity));
+        Idx = FindEntry(Hash, PSOId, IndexBufferId, Streams, NumUsedSlots);
+    }
 
-            if( LayoutIt->Frequency == LayoutElement::FREQUENCY_PER_INSTANCE )
-            {
-                // If divisor is zero, then the attribute acts like normal, being indexed by the array or index 
-                // buffer. If divisor is non-zero, then the current instance is divided by this divisor, and 
-                // the result of that is used to access the attribute array.
-                glVertexAttribDivisor(LayoutIt->InputIndex, LayoutIt->InstanceDataStepRate);
-            }
-	        glEnableVertexAttribArray(LayoutIt->InputIndex);
-        }
-        if( pIndexBuffer )
+    // Create new VAO
+    GLObjectWrappers::GLVertexArrayObj NewVAO(true);
+
+    // Initialize VAO
+    GLContextState.BindVAO( NewVAO );
+    auto LayoutIt = LayoutElems;
+    for( size_t Elem = 0; Elem < NumElems; ++Elem, ++LayoutIt )
+    {
+        auto BuffSlot = LayoutIt->BufferSlot;
+        if( BuffSlot >= NumVertexStreams || BuffSlot >= MaxBufferSlots )
         {
-            const BufferGLImpl *pIndBufferOGL = static_cast<const BufferGLImpl*>( pIndexBuffer );
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pIndBufferOGL->m_GlBuffer);
+            UNEXPECTED( "Incorrect input buffer slot" );
+            continue;
         }
-            
-        auto NewElems = m_Cache.emplace( std::make_pair(Key, std::move(NewVAO)) );
-        // New element must be actually inserted
-        VERIFY( NewElems.second, "New element was not inserted into the cache" ); 
-        m_PSOToKey.insert( std::make_pair(Key.pPSO, Key) );
-        for(Uint32 Slot = 0; Slot < Key.NumUsedSlots; ++Slot)
+        // Get buffer through the strong reference, the key only stores its unique ID
+        auto &CurrStream = VertexStreams[BuffSlot];
+        auto Stride = Strides[BuffSlot];
+        auto *pBuff = VertexBuffers[BuffSlot];
+        VERIFY( pBuff != nullptr, "Vertex buffer is null" );
+        const BufferGLImpl *pBufferOGL = static_cast<const BufferGLImpl*>( pBuff );
+
+        glBindBuffer(GL_ARRAY_BUFFER, pBufferOGL->m_GlBuffer);
+        GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>( static_cast<size_t>( CurrStream.Offset + LayoutIt->RelativeOffset ) );
+        auto GlType = TypeToGLType(LayoutIt->ValueType);
+        if( !LayoutIt->IsNormalized &&
+            (LayoutIt->ValueType == VT_INT8  || 
+             LayoutIt->ValueType == VT_INT16 ||
+             LayoutIt->ValueType == VT_INT32 ||
+             LayoutIt->ValueType == VT_UINT8 || 
+             LayoutIt->ValueType == VT_UINT16||
+             LayoutIt->ValueType == VT_UINT32 ) )
+            glVertexAttribIPointer(LayoutIt->InputIndex, LayoutIt->NumComponents, GlType, Stride, DataStartOffset );
+        else
+            glVertexAttribPointer(LayoutIt->InputIndex, LayoutIt->NumComponents, GlType, LayoutIt->IsNormalized, Stride, DataStartOffset );
+
+        if( LayoutIt->Frequency == LayoutElement::FREQUENCY_PER_INSTANCE )
         {
-            auto *pCurrBuff = Key.Streams[Slot].pBuffer;
-            if( pCurrBuff )
-                m_BuffToKey.insert( std::make_pair(pCurrBuff, Key) );
+            // If divisor is zero, then the attribute acts like normal, being indexed by the array or index 
+            // buffer. If divisor is non-zero, then the current instance is divided by this divisor, and 
+            // the result of that is used to access the attribute array.
+            glVertexAttribDivisor(LayoutIt->InputIndex, LayoutIt->InstanceDataStepRate);
         }
-
-        return NewElems.first->second;
+	    glEnableVertexAttribArray(LayoutIt->InputIndex);
     }
+    if( pIndexBuffer )
+    {
+        const BufferGLImpl *pIndBufferOGL = static_cast<const BufferGLImpl*>( pIndexBuffer );
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pIndBufferOGL->m_GlBuffer);
+    }
+
+    auto &NewEntry = m_Entries[Idx];
+    VERIFY(NewEntry.PSOId == 0, "The slot is not empty");
+    NewEntry.Hash          = Hash;
+    NewEntry.PSOId         = PSOId;
+    NewEntry.IndexBufferId = IndexBufferId;
+    NewEntry.Serial        = m_NextEntrySerial++;
+    NewEntry.NumUsedSlots  = NumUsedSlots;
+    NewEntry.FirstStream   = static_cast<Uint32>(m_Streams.size());
+    NewEntry.VAO           = std::move(NewVAO);
+    m_Streams.insert(m_Streams.end(), Streams, Streams + NumUsedSlots);
+    m_NumUsedStreams += NumUsedSlots;
+    ++m_NumEntries;
+
+    UniqueIdentifier BufferIds[MaxBufferSlots + 1];
+    auto NumBufferIds = GetBufferIds(NewEntry, BufferIds);
+    for (Uint32 i = 0; i < NumBufferIds; ++i)
+        m_BufferEntries[BufferIds[i]].push_back(EntryRef{Hash, NewEntry.Serial});
+
+    return NewEntry.VAO;
 }
 
 const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetEmptyVAO()
@@ -111,14 +111,20 @@ public:
         return m_AccessFlags;
     }
 
+    // Returns true if the buffer can be moved to other memory by MemoryDefragmenter
+    bool IsRelocatable()const;
+    const VulkanUtilities::VulkanMemoryAllocation& GetMemoryAllocation()const{return m_MemoryAllocation;}
+
 private:
     friend class DeviceContextVkImpl;
 
     virtual void CreateViewInternal( const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView )override;
 
     VulkanUtilities::BufferViewWrapper CreateView(struct BufferViewDesc &ViewDesc);
-    VkAccessFlags m_AccessFlags            = 0;
-    Uint32        m_DynamicOffsetAlignment = 0;
+    VkAccessFlags      m_AccessFlags            = 0;
+    Uint32             m_DynamicOffsetAlignment = 0;
+    // Usage flags are required to recreate the buffer when it is relocated
+    VkBufferUsageFlags m_VkUsageFlags           = 0;
 
 #ifdef DEVELOPMENT
     std::vector< std::pair<MAP_TYPE, Uint32> > m_DvpMapType;
@@ -0,0 +1,188 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DescriptorSetCache class
+
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include "UniqueIdentifier.h"
+#include "DescriptorPoolManager.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Content-addressed cache of descriptor sets for static and mutable shader resources.
+// Shader resource bindings that use the same descriptor set layout and reference the same
+// resources share one Vulkan descriptor set. Every shared set is reference-counted by the
+// SRBs that use it. When the last reference is released, the set is moved into the release
+// queue by DescriptorSetAllocation's destructor.
+//
+// Resources are identified by their unique IDs that are never reused. A cached set cannot
+// outlive any resource it references because every SRB that uses the set keeps strong
+// references to all its resources.
+class DescriptorSetCache
+{
+public:
+    DescriptorSetCache(RenderDeviceVkImpl& DeviceVkImpl) :
+        m_DeviceVk(DeviceVkImpl)
+    {}
+
+    DescriptorSetCache             (const DescriptorSetCache&) = delete;
+    DescriptorSetCache             (DescriptorSetCache&&)      = delete;
+    DescriptorSetCache& operator = (const DescriptorSetCache&) = delete;
+    DescriptorSetCache& operator = (DescriptorSetCache&&)      = delete;
+
+    ~DescriptorSetCache();
+
+    struct Key
+    {
+        VkDescriptorSetLayout         SetLayout = VK_NULL_HANDLE;
+        // Unique IDs of all resources in the set in the order they are stored in the resource cache,
+        // 0 for unbound resources
+        std::vector<UniqueIdentifier> ResourceIds;
+
+        bool operator == (const Key& rhs)const;
+        size_t GetHash()const;
+
+    private:
+        mutable size_t Hash = 0;
+    };
+
+    // Reference to the shared descriptor set. The reference is released
+    // when the object is destroyed.
+    class SharedDescriptorSet
+    {
+    public:
+        SharedDescriptorSet()noexcept{}
+
+        SharedDescriptorSet             (const SharedDescriptorSet&) = delete;
+        SharedDescriptorSet& operator = (const SharedDescriptorSet&) = delete;
+
+        SharedDescriptorSet(SharedDescriptorSet&& rhs)noexcept :
+            m_pCache(rhs.m_pCache),
+            m_pKey  (rhs.m_pKey),
+            m_vkSet (rhs.m_vkSet)
+        {
+            rhs.Reset();
+        }
+
+        SharedDescriptorSet& operator = (SharedDescriptorSet&& rhs)noexcept
+        {
+            Release();
+
+            m_pCache = rhs.m_pCache;
+            m_pKey   = rhs.m_pKey;
+            m_vkSet  = rhs.m_vkSet;
+
+            rhs.Reset();
+
+            return *this;
+        }
+
+        ~SharedDescriptorSet()
+        {
+            Release();
+        }
+
+        operator bool()const
+        {
+            return m_vkSet != VK_NULL_HANDLE;
+        }
+
+        void Release();
+
+        VkDescriptorSet GetVkDescriptorSet()const {return m_vkSet;}
+
+    private:
+        friend class DescriptorSetCache;
+        SharedDescriptorSet(DescriptorSetCache& Cache, const Key& SetKey, VkDescriptorSet vkSet)noexcept :
+            m_pCache(&Cache),
+            m_pKey  (&SetKey),
+            m_vkSet (vkSet)
+        {}
+
+        void Reset()
+        {
+            m_pCache = nullptr;
+            m_pKey   = nullptr;
+            m_vkSet  = VK_NULL_HANDLE;
+        }
+
+        DescriptorSetCache* m_pCache = nullptr;
+        // Points to the key stored in the cache, which is valid while the set is referenced
+        const Key*          m_pKey   = nullptr;
+        VkDescriptorSet     m_vkSet  = VK_NULL_HANDLE;
+    };
+
+    // Returns the shared set with the given key, or an empty reference if there is no such set
+    SharedDescriptorSet Find(const Key& SetKey);
+
+    // Adds a new set whose descriptors have been written by the caller. If another thread
+    // has already added a set with the same key, returns that set and leaves Allocation
+    // untouched, so that it is released by the caller.
+    SharedDescriptorSet Insert(Key&& SetKey, DescriptorSetAllocation&& Allocation);
+
+    struct Statistics
+    {
+        Uint32 NumHits    = 0;
+        Uint32 NumMisses  = 0;
+        Uint32 NumEntries = 0; // Number of descriptor sets currently in the cache
+    };
+    Statistics GetStatistics();
+
+private:
+    void ReleaseSet(const Key& SetKey);
+
+    struct Entry
+    {
+        Entry(DescriptorSetAllocation&& _Allocation) :
+            Allocation(std::move(_Allocation))
+        {}
+
+        DescriptorSetAllocation Allocation;
+        Uint32                  RefCount = 0;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator() (const Key& SetKey)const
+        {
+            return SetKey.GetHash();
+        }
+    };
+
+    RenderDeviceVkImpl& m_DeviceVk;
+
+    std::mutex m_Mutex;
+    std::unordered_map<Key, Entry, KeyHash> m_Cache;
+    Statistics m_Stats;
+};
+
+}
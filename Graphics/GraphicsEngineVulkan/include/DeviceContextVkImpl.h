@@ -122,6 +122,10 @@ public:
     void UpdateBufferRegion(class BufferVkImpl* pBuffVk, const void* pData, Uint64 DstOffset, Uint64 NumBytes);
 
     void CopyBufferRegion(class BufferVkImpl* pSrcBuffVk, class BufferVkImpl* pDstBuffVk, Uint64 SrcOffset, Uint64 DstOffset, Uint64 NumBytes);
+
+    // Moves the buffer to a new VkBuffer in a denser memory page and records the copy command.
+    // Returns false if no existing page can accommodate the buffer.
+    bool RelocateBuffer(class BufferVkImpl& BuffVk);
     void CopyTextureRegion(class TextureVkImpl* pSrcTexture, class TextureVkImpl* pDstTexture, const VkImageCopy &CopyRegion);
 
     void UpdateTextureRegion(const void*          pSrcData,
@@ -220,6 +224,10 @@ private:
         /// Flag indicating if currently committed index buffer is up to date
         bool CommittedIBUpToDate = false;
 
+        /// Flag indicating that the bound pipeline state was not ready when it was set.
+        /// Draw, dispatch and commit commands are skipped until another pipeline state is set.
+        bool PipelineStateNotReady = false;
+
         Uint32 NumCommands = 0;
     }m_State;
 
@@ -0,0 +1,107 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::MemoryDefragmenter class
+
+#include <mutex>
+#include <vector>
+#include <unordered_set>
+#include "VulkanUtilities/VulkanMemoryManager.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+class DeviceContextVkImpl;
+class BufferVkImpl;
+
+/// Incrementally moves buffers out of sparse device memory pages, so that the pages become 
+/// empty and are released by VulkanMemoryManager::ShrinkMemory()
+
+/// Only buffers that are not referenced by descriptor sets or views can be moved (see 
+/// BufferVkImpl::IsRelocatable()), because descriptor sets written with the old VkBuffer 
+/// handle would not be updated. Such buffers register themselves at creation time.
+/// 
+/// At the end of every frame, the immediate context calls Defragment(). The defragmenter 
+/// selects a page whose allocations all belong to registered buffers and whose memory would be 
+/// released once it is empty, and moves the buffers to denser existing pages within the byte 
+/// budget. A page may take several frames to evacuate. Every buffer gets a new VkBuffer bound to 
+/// the new memory, and the contents are copied by the GPU. The old buffer and memory are retired 
+/// through the release queue, so commands that have already been recorded keep using them.
+class MemoryDefragmenter
+{
+public:
+    MemoryDefragmenter(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize BudgetPerFrame);
+
+    MemoryDefragmenter             (const MemoryDefragmenter&) = delete;
+    MemoryDefragmenter             (MemoryDefragmenter&&)      = delete;
+    MemoryDefragmenter& operator = (const MemoryDefragmenter&) = delete;
+    MemoryDefragmenter& operator = (MemoryDefragmenter&&)      = delete;
+
+    ~MemoryDefragmenter();
+
+    void RegisterBuffer  (BufferVkImpl* pBuffer);
+    void UnregisterBuffer(BufferVkImpl* pBuffer);
+
+    /// Records copy commands of buffers moved in this frame into the context command buffer.
+    /// Returns true if any commands have been recorded.
+    bool Defragment(DeviceContextVkImpl& ImmediateCtx);
+
+    struct Statistics
+    {
+        Uint64 NumBuffersMoved    = 0;
+        Uint64 BytesMoved         = 0;
+        Uint64 NumPagesEvacuated  = 0;
+        // Total size of evacuated pages, which is the amount of device memory that is released
+        Uint64 EvacuatedPagesSize = 0;
+    };
+    Statistics GetStatistics();
+
+private:
+    // Selects the page to evacuate and fills m_PageBuffers. The defragmenter must be locked
+    bool SelectPage();
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+    const VkDeviceSize  m_BudgetPerFrame;
+
+    std::mutex m_Mtx;
+
+    std::unordered_set<BufferVkImpl*> m_Buffers;
+
+    // Buffers that remain in the page being evacuated
+    std::vector<BufferVkImpl*> m_PageBuffers;
+    VkDeviceSize               m_EvacuatedPageSize = 0;
+
+    // Selecting a page requires visiting all registered buffers, so after selection fails, 
+    // it is not repeated for a number of frames
+    static constexpr Uint32 SelectionInterval = 16;
+    Uint32 m_FramesToNextSelection = 0;
+
+    Statistics m_Stats;
+};
+
+}
@@ -0,0 +1,88 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineCache class
+
+#include <vector>
+#include <mutex>
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+#include "VulkanUtilities/VulkanLogicalDevice.h"
+
+namespace Diligent
+{
+
+/// Device-wide Vulkan pipeline cache that is used to create all pipelines
+
+/// If the file path is specified, the cache is initialized from the file when it is created,
+/// and the cache data are written back to the file when the cache is destroyed.
+/// The data are only used if the header written by the driver matches the vendor, 
+/// device and pipeline cache UUID of the physical device; otherwise the cache starts empty.
+class PipelineCache
+{
+public:
+    PipelineCache(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                  const VkPhysicalDeviceProperties&           DeviceProps,
+                  const Char*                                 FilePath);
+
+    PipelineCache             (const PipelineCache&) = delete;
+    PipelineCache             (PipelineCache&&)      = delete;
+    PipelineCache& operator = (const PipelineCache&) = delete;
+    PipelineCache& operator = (PipelineCache&&)      = delete;
+
+    ~PipelineCache();
+
+    VkPipelineCache GetVkPipelineCache()const{return m_VkPipelineCache;}
+
+    /// Returns the serialized cache data, or an empty vector if the data cannot be retrieved
+    std::vector<Uint8> GetData()const;
+
+    /// Merges the serialized data of another cache into this cache. Returns false
+    /// if the data are not compatible with the physical device.
+    bool Merge(const void* pData, size_t DataSize);
+
+    /// Writes the cache data to the file. Returns false if the cache has no file or if writing failed.
+    bool Save();
+
+    /// Checks if the cache data were produced by the same driver and physical device
+    bool IsCompatible(const void* pData, size_t DataSize)const;
+
+private:
+    const VulkanUtilities::VulkanLogicalDevice& m_LogicalDevice;
+    
+    const Uint32 m_VendorID;
+    const Uint32 m_DeviceID;
+    Uint8        m_PipelineCacheUUID[VK_UUID_SIZE];
+
+    const String m_FilePath;
+
+    // Host access to the destination cache of vkMergePipelineCaches must be externally synchronized
+    std::mutex m_MergeMtx;
+
+    VulkanUtilities::PipelineCacheWrapper m_VkPipelineCache;
+};
+
+}
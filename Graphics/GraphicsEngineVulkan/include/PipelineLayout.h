@@ -82,6 +82,18 @@ public:
         return m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    // Returns the index of the descriptor set shared by static and mutable variables,
+    // or -1 if the layout has no such variables
+    Int32 GetStaticAndMutableDescriptorSetIndex()const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_STATIC).SetIndex;
+    }
+
+    VkDescriptorSetLayout GetStaticAndMutableDescriptorSetVkLayout()const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_STATIC).VkLayout;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
@@ -27,6 +27,7 @@
 /// Declaration of Diligent::PipelineStateVkImpl class
 
 #include <array>
+#include <atomic>
 
 #include "RenderDeviceVk.h"
 #include "PipelineStateVk.h"
@@ -39,6 +40,7 @@
 #include "VulkanUtilities/VulkanCommandBuffer.h"
 #include "PipelineLayout.h"
 #include "RenderDeviceVkImpl.h"
+#include "Signal.h"
 
 namespace Diligent
 {
@@ -51,7 +53,9 @@ class PipelineStateVkImpl final : public PipelineStateBase<IPipelineStateVk, Ren
 public:
     using TPipelineStateBase = PipelineStateBase<IPipelineStateVk, RenderDeviceVkImpl>;
 
-    PipelineStateVkImpl( IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const PipelineStateDesc &PipelineDesc );
+    // If DeferInitialization is true, the constructor only validates the description, and the 
+    // object must be initialized by InitializeDeferred(), which is typically called by a worker thread
+    PipelineStateVkImpl( IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const PipelineStateDesc &PipelineDesc, bool DeferInitialization = false );
     ~PipelineStateVkImpl();
 
     virtual void QueryInterface( const Diligent::INTERFACE_ID &IID, IObject** ppInterface );
@@ -60,9 +64,19 @@ public:
 
     virtual bool IsCompatibleWith(const IPipelineState* pPSO)const override final;
 
-    virtual VkRenderPass GetVkRenderPass()const override final{return m_RenderPass;}
+    virtual VkRenderPass GetVkRenderPass()const override final{return IsReady() ? m_RenderPass : VK_NULL_HANDLE;}
 
-    virtual VkPipeline GetVkPipeline()const override final { return m_Pipeline; }
+    virtual VkPipeline GetVkPipeline()const override final { return IsReady() ? static_cast<VkPipeline>(m_Pipeline) : VK_NULL_HANDLE; }
+
+    virtual PIPELINE_STATE_STATUS GetStatus()const override final { return m_Status.load(); }
+
+    virtual PIPELINE_STATE_STATUS WaitForCompletion()const override final;
+
+    bool IsReady()const { return m_Status.load() == PIPELINE_STATE_STATUS_READY; }
+
+    // Performs the initialization skipped by the constructor and signals the completion.
+    // Errors are reported through the pipeline state status.
+    void InitializeDeferred();
 
     void CommitAndTransitionShaderResources(IShaderResourceBinding*                 pShaderResourceBinding, 
                                             DeviceContextVkImpl*                    pCtxVkImpl,
@@ -99,6 +113,11 @@ public:
 
 
 private:
+    void Initialize();
+
+    // Assigns the shared descriptor set for static and mutable resources from the descriptor set cache
+    void AssignSharedDescriptorSet(DescriptorSetCache& SetCache, ShaderResourceCacheVk& ResourceCache)const;
+
     ShaderResourceLayoutVk*    m_ShaderResourceLayouts  = nullptr;
     
     // SRB memory allocator must be declared before m_pDefaultShaderResBinding
@@ -115,6 +134,9 @@ private:
     PipelineLayout                   m_PipelineLayout;
     bool m_HasStaticResources    = false;
     bool m_HasNonStaticResources = false;
+
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_PENDING};
+    mutable ThreadingTools::Signal     m_InitCompletedSignal;
 };
 
 }
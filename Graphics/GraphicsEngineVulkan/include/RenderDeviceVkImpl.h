@@ -33,6 +33,7 @@
 #include "DescriptorPoolManager.h"
 #include "VulkanDynamicHeap.h"
 #include "Atomics.h"
+#include "ShaderCache.h"
 #include "CommandQueueVk.h"
 #include "VulkanUtilities/VulkanInstance.h"
 #include "VulkanUtilities/VulkanPhysicalDevice.h"
@@ -41,10 +42,16 @@
 #include "VulkanUtilities/VulkanObjectWrappers.h"
 #include "VulkanUtilities/VulkanMemoryManager.h"
 #include "VulkanUploadHeap.h"
+#include "VulkanUploadPagePool.h"
 #include "FramebufferCache.h"
 #include "RenderPassCache.h"
+#include "DescriptorSetCache.h"
+#include "PipelineCache.h"
 #include "CommandPoolManager.h"
+#include "UploadBatcher.h"
+#include "MemoryDefragmenter.h"
 #include "VulkanDynamicHeap.h"
+#include "ThreadPool.h"
 
 namespace Diligent
 {
@@ -88,6 +95,14 @@ public:
 
     virtual void CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, IBuffer** ppBuffer)override final;
 
+    virtual void GetPipelineCacheData(IDataBlob** ppData)override final;
+
+    virtual bool MergePipelineCacheData(const void* pData, size_t DataSize)override final;
+
+    virtual void CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)override final;
+
+    virtual void FlushPendingUploads()override final;
+
     // Idles the GPU
 	void IdleGPU();
     // pImmediateCtx parameter is only used to make sure the command buffer is submitted from the immediate context
@@ -110,6 +125,7 @@ public:
     const VulkanUtilities::VulkanLogicalDevice&            GetLogicalDevice ()      { return *m_LogicalVkDevice;}
     FramebufferCache&                                      GetFramebufferCache()    { return m_FramebufferCache;}
     RenderPassCache&                                       GetRenderPassCache()     { return m_RenderPassCache;}
+    VkPipelineCache                                        GetVkPipelineCache()const{ return m_PipelineCache.GetVkPipelineCache();}
 
     VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties)
     {
@@ -118,8 +134,19 @@ public:
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
+    UploadBatcher&              GetUploadBatcher()        { return m_UploadBatcher; }
+    VulkanUploadPagePool&       GetUploadPagePool()       { return m_UploadPagePool; }
     void FlushStaleResources(Uint32 CmdQueueIndex);
 
+    // Returns null if the shader cache is not used
+    ShaderCache* GetShaderCache() { return m_pShaderCache.get(); }
+
+    // Returns null if the descriptor set cache is not used
+    DescriptorSetCache* GetDescriptorSetCache() { return m_pDescriptorSetCache.get(); }
+
+    // Returns null if memory defragmentation is disabled
+    MemoryDefragmenter* GetMemoryDefragmenter() { return m_pMemoryDefragmenter.get(); }
+
 private:
     virtual void TestTextureFormat( TEXTURE_FORMAT TexFormat )override final;
 
@@ -136,6 +163,7 @@ private:
 
     EngineVkAttribs m_EngineAttribs;
 
+    PipelineCache          m_PipelineCache;
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_RenderPassCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
@@ -148,7 +176,26 @@ private:
 
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
+    // Upload pages hold allocations from m_MemoryMgr, so the pool must be declared after it
+    VulkanUploadPagePool m_UploadPagePool;
+
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
+
+    // Batches initialization commands of buffers and textures created with initial data.
+    // Uses transient command pools and the global memory manager, so it must be declared after them.
+    UploadBatcher m_UploadBatcher;
+
+    std::unique_ptr<ShaderCache> m_pShaderCache;
+
+    std::unique_ptr<DescriptorSetCache> m_pDescriptorSetCache;
+
+    // Moves buffers out of pages of m_MemoryMgr, so it must be declared after it
+    std::unique_ptr<MemoryDefragmenter> m_pMemoryDefragmenter;
+
+    // Worker threads that initialize pipeline states created by CreatePipelineStateAsync().
+    // The pool is created on first use.
+    std::mutex                                  m_AsyncPSOPoolMtx;
+    std::unique_ptr<ThreadingTools::ThreadPool> m_pAsyncPSOPool;
 };
 
 }
@@ -46,10 +46,13 @@
 //  Ns = m_NumSets
 //
 //
-// Descriptor set for static and mutable resources is assigned during cache initialization
+// Descriptor set for static and mutable resources is assigned during cache initialization, or, 
+// if the descriptor set cache is enabled, when the SRB is committed (see DescriptorSetCache)
 // Descriptor set for dynamic resources is assigned at every draw call
 
+#include <vector>
 #include "DescriptorPoolManager.h"
+#include "DescriptorSetCache.h"
 #include "SPIRVShaderResources.h"
 
 namespace Diligent
@@ -108,7 +111,7 @@ public:
         VkDescriptorImageInfo  GetSamplerDescriptorWriteInfo()                       const;
     };
 
-    // sizeof(DescriptorSet) == 40 (x64, msvc, Release)
+    // sizeof(DescriptorSet) == 72 (x64, msvc, Release)
     class DescriptorSet
     {
     public:
@@ -137,20 +140,49 @@ public:
 
         VkDescriptorSet GetVkDescriptorSet()const
         {
-            return m_DescriptorSetAllocation.GetVkDescriptorSet();
+            return m_UsesSharedSet ? m_SharedSet.GetVkDescriptorSet() : m_DescriptorSetAllocation.GetVkDescriptorSet();
         }
 
         void AssignDescriptorSetAllocation(DescriptorSetAllocation&& Allocation)
         {
             VERIFY(m_NumResources > 0, "Descriptor set is empty");
+            VERIFY(!m_UsesSharedSet, "Descriptor set uses shared vulkan descriptor set");
             m_DescriptorSetAllocation = std::move(Allocation);
         }
 
+        // Indicates that the vulkan descriptor set will be taken from the
+        // descriptor set cache when the resources are committed
+        void EnableSharedSet()
+        {
+            VERIFY(m_NumResources > 0, "Descriptor set is empty");
+            VERIFY(!m_DescriptorSetAllocation, "Descriptor set already has its own vulkan descriptor set");
+            m_UsesSharedSet = true;
+        }
+        bool UsesSharedSet()const{return m_UsesSharedSet;}
+
+        void AssignSharedSet(DescriptorSetCache::SharedDescriptorSet&& SharedSet)
+        {
+            VERIFY(m_UsesSharedSet, "Shared descriptor sets are not enabled");
+            m_SharedSet = std::move(SharedSet);
+        }
+        // Releases the reference to the shared set after the resource has changed. A new set 
+        // will be found or created the next time the resources are committed.
+        void ReleaseSharedSet()
+        {
+            m_SharedSet.Release();
+        }
+
+        // Returns unique IDs of all resources in the set that identify
+        // the set in the descriptor set cache
+        void GetResourceIds(std::vector<UniqueIdentifier>& ResourceIds)const;
+
         const Uint32 m_NumResources = 0;
 
     private:
         Resource* const m_pResources = nullptr;
+        bool m_UsesSharedSet = false;
         DescriptorSetAllocation m_DescriptorSetAllocation;
+        DescriptorSetCache::SharedDescriptorSet m_SharedSet;
     };
 
     inline DescriptorSet& GetDescriptorSet(Uint32 Index)
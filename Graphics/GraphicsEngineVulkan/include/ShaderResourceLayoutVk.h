@@ -95,10 +95,13 @@
 //      ** Bindings, descriptor sets and offsets are assigned during the initialization
 
 #include <array>
+#include <deque>
+#include <vector>
 #include <memory>
 
 #include "ShaderBase.h"
 #include "HashUtils.h"
+#include "ShaderVariableNameIndex.h"
 #include "ShaderResourceCacheVk.h"
 #include "SPIRVShaderResources.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
@@ -233,6 +236,23 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet)const;
 
+    // Descriptor writes of several layouts. The infos are kept in deques, so that
+    // the pointers in the writes stay valid as more writes are appended.
+    struct DescriptorWriteBatch
+    {
+        std::vector<VkWriteDescriptorSet>  WriteDescrSets;
+        std::deque<VkDescriptorImageInfo>  DescrImgInfos;
+        std::deque<VkDescriptorBufferInfo> DescrBuffInfos;
+        std::deque<VkBufferView>           DescrBuffViews;
+    };
+
+    // Appends writes of descriptors of all bound static and mutable resources from ResourceCache 
+    // to vkDescriptorSet to the batch. Layouts of all shader stages append to the same batch to
+    // initialize a shared descriptor set (see DescriptorSetCache) with one vkUpdateDescriptorSets() call.
+    void GetStaticAndMutableDescriptorWrites(const ShaderResourceCacheVk& ResourceCache,
+                                             VkDescriptorSet              vkDescriptorSet,
+                                             DescriptorWriteBatch&        Batch)const;
+
     const Char* GetShaderName()const;
 
     const VkResource& GetResource(SHADER_VARIABLE_TYPE VarType, Uint32 r)const
@@ -242,7 +262,6 @@ public:
         return Resources[GetResourceOffset(VarType,r)];
     }
 
-private:
     Uint32 GetResourceOffset(SHADER_VARIABLE_TYPE VarType, Uint32 r)const
     {
         VERIFY_EXPR( r < m_NumResources[VarType] );
@@ -252,11 +271,25 @@ private:
         r += (VarType > SHADER_VARIABLE_TYPE_MUTABLE) ? m_NumResources[SHADER_VARIABLE_TYPE_MUTABLE] : 0;
         return r;
     }
-    VkResource& GetResource(SHADER_VARIABLE_TYPE VarType, Uint32 r)
+
+    // Returns the index of the resource in the layout, or ShaderVariableNameIndex::InvalidIndex
+    // if the layout has no resource with the given name
+    Uint32 FindResource(const Char* Name)const
     {
-        VERIFY_EXPR( r < m_NumResources[VarType] );
-        auto* Resources = reinterpret_cast<VkResource*>(m_ResourceBuffer.get());
-        return Resources[GetResourceOffset(VarType,r)];
+        return m_NameIndex.Find(Name);
+    }
+
+    Uint32 GetResourceIndex(const VkResource& Res)const
+    {
+        auto Index = static_cast<Uint32>(&Res - reinterpret_cast<const VkResource*>(m_ResourceBuffer.get()));
+        VERIFY(Index < GetTotalResourceCount(), "The resource does not belong to this layout");
+        return Index;
+    }
+
+    // Returns the hash of the resource name that can be used with GetResourceFromMapping()
+    size_t GetResourceNameHash(Uint32 r)const
+    {
+        return m_NameIndex.GetNameHash(r);
     }
 
     const VkResource& GetResource(Uint32 r)const
@@ -266,6 +299,14 @@ private:
         return Resources[r];
     }
 
+private:
+    VkResource& GetResource(SHADER_VARIABLE_TYPE VarType, Uint32 r)
+    {
+        VERIFY_EXPR( r < m_NumResources[VarType] );
+        auto* Resources = reinterpret_cast<VkResource*>(m_ResourceBuffer.get());
+        return Resources[GetResourceOffset(VarType,r)];
+    }
+
     Uint32 GetTotalResourceCount()const
     {
         return m_NumResources[SHADER_VARIABLE_TYPE_NUM_TYPES];
@@ -276,6 +317,8 @@ private:
                         const SHADER_VARIABLE_TYPE*                 AllowedVarTypes,
                         Uint32                                      NumAllowedTypes);
 
+    void InitializeNameIndex();
+
 
     IObject&                                            m_Owner;
     const VulkanUtilities::VulkanLogicalDevice&         m_LogicalDevice;
@@ -286,6 +329,8 @@ private:
     std::shared_ptr<const SPIRVShaderResources>         m_pResources;
 
     std::array<Uint16, SHADER_VARIABLE_TYPE_NUM_TYPES+1>  m_NumResources = {};
+
+    ShaderVariableNameIndex                             m_NameIndex;
 };
 
 }
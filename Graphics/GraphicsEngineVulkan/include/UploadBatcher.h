@@ -0,0 +1,122 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::UploadBatcher class
+
+#include <mutex>
+#include "VulkanUploadHeap.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Records initialization commands of buffers and textures into a shared transient command buffer
+
+/// Every buffer or texture created with initial data used to allocate its own staging buffer, 
+/// command pool and command buffer, and submit it to the queue. The batcher instead suballocates 
+/// staging memory from a shared upload heap and records all copy commands into one transient 
+/// command buffer. The command buffer is submitted when the number of pending uploads or the 
+/// size of pending staging data reaches the threshold, when FlushPendingUploads() is called, 
+/// and always before the render device submits a command buffer of the immediate context, so 
+/// that all initialized resources are ready before they can be used by the GPU.
+class UploadBatcher
+{
+public:
+    UploadBatcher(RenderDeviceVkImpl& DeviceVkImpl,
+                  VkDeviceSize        StagingPageSize,
+                  Uint32              MaxPendingUploads,
+                  VkDeviceSize        MaxPendingStagingSize);
+
+    UploadBatcher             (const UploadBatcher&) = delete;
+    UploadBatcher             (UploadBatcher&&)      = delete;
+    UploadBatcher& operator = (const UploadBatcher&) = delete;
+    UploadBatcher& operator = (UploadBatcher&&)      = delete;
+
+    ~UploadBatcher();
+
+    /// Records upload commands into the shared command buffer
+
+    /// \param [in] StagingSize    - Size of the staging memory required by the upload. If zero, 
+    ///                              no staging memory is allocated (e.g. to clear a texture).
+    /// \param [in] Alignment      - Alignment of the staging memory offset.
+    /// \param [in] RecordCommands - Function that is called as RecordCommands(vkCmdBuff, StagingAllocation).
+    ///                              It must write the data to StagingAllocation.CPUAddress and record 
+    ///                              all commands into vkCmdBuff. The function is called while the batcher 
+    ///                              is locked and must not call any other batcher method.
+    template<typename RecordCommandsType>
+    void Enqueue(VkDeviceSize StagingSize, VkDeviceSize Alignment, RecordCommandsType RecordCommands)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mtx);
+
+        VulkanUploadAllocation StagingAllocation;
+        if (StagingSize != 0)
+            StagingAllocation = m_StagingHeap.Allocate(static_cast<size_t>(StagingSize), static_cast<size_t>(Alignment));
+        RecordCommands(GetCmdBuffer(), static_cast<const VulkanUploadAllocation&>(StagingAllocation));
+
+        ++m_NumPendingUploads;
+        ++m_Stats.NumUploads;
+        m_PendingStagingSize += StagingSize;
+        if (m_NumPendingUploads >= m_MaxPendingUploads || m_PendingStagingSize >= m_MaxPendingStagingSize)
+            FlushLocked();
+    }
+
+    /// Submits all pending upload commands to the queue
+    void Flush();
+
+    struct Statistics
+    {
+        Uint64 NumUploads = 0;
+        Uint64 NumSubmits = 0;
+    };
+    Statistics GetStatistics();
+
+private:
+    // Returns the command buffer that collects the upload commands. The batcher must be locked
+    VkCommandBuffer GetCmdBuffer();
+    // Submits the command buffer and releases staging pages. The batcher must be locked
+    void FlushLocked();
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    const Uint32       m_MaxPendingUploads;
+    const VkDeviceSize m_MaxPendingStagingSize;
+
+    std::mutex m_Mtx;
+
+    VulkanUploadHeap                    m_StagingHeap;
+    VulkanUtilities::CommandPoolWrapper m_CmdPool;
+    VkCommandBuffer                     m_vkCmdBuff = VK_NULL_HANDLE;
+
+    Uint32       m_NumPendingUploads  = 0;
+    VkDeviceSize m_PendingStagingSize = 0;
+
+    Statistics m_Stats;
+};
+
+}
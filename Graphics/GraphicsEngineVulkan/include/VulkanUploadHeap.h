@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include "VulkanUtilities/VulkanMemoryManager.h"
 #include "VulkanUtilities/VulkanObjectWrappers.h"
+#include "VulkanUploadPagePool.h"
 
 namespace Diligent
 {
@@ -33,8 +34,9 @@ namespace Diligent
 // Upload heap is used by a device context to update texture and buffer regions through 
 // UpdateBufferRegion() and UpdateTextureRegion().
 // 
-// The heap allocates pages from the global memory manager.
-// The pages are released and returned to the manager at the end of every frame.
+// The heap takes pages from the device upload page pool (VulkanUploadPagePool).
+// The pages are released at the end of every frame and return to the pool once the GPU is done with them.
+// Chunks larger than half of the page size are allocated directly from the global memory manager.
 // 
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
@@ -45,11 +47,11 @@ namespace Diligent
 //  |__________|____________________________________________________________________________________________________________________|
 //             |                                      A                   |
 //             |                                      |                   |
-//             |Allocate()             CreateNewPage()|                   |ReleaseAllocatedPages()
+//             |Allocate()                   GetPage()|                   |ReleaseAllocatedPages()
 //             |                                ______|___________________V____     
 //             V                               |                              |
-//   VulkanUploadAllocation                    |    Global Memory Manager     |
-//                                             |    (VulkanMemoryManager)     |
+//   VulkanUploadAllocation                    |      Upload page pool        |
+//                                             |    (VulkanUploadPagePool)    |
 //                                             |                              |
 //                                             |______________________________|
 //
@@ -94,14 +96,14 @@ public:
 
     VulkanUploadAllocation Allocate(size_t SizeInBytes, size_t Alignment);
     
-    // Releases all allocated pages that are later returned to the global memory manager by the release queues.
-    // As global memory manager is hosted by the render device, the upload heap can be destroyed before the 
-    // pages are actually returned to the manager.
+    // Releases all allocated pages that are later returned to the upload page pool by the release queues.
+    // As the pool is hosted by the render device, the upload heap can be destroyed before the 
+    // pages are actually returned to the pool.
     void ReleaseAllocatedPages(Uint64 CmdQueueMask);
 
     size_t GetStalePagesCount()const
     {
-        return m_Pages.size();
+        return m_Pages.size() + m_LargeChunks.size();
     }
 
 private:
@@ -109,21 +111,10 @@ private:
     std::string         m_HeapName;
     const VkDeviceSize  m_PageSize;
 
-    struct UploadPageInfo
-    {
-        UploadPageInfo(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation, 
-                       VulkanUtilities::BufferWrapper&&          _Buffer,
-                       Uint8*                                    _CPUAddress) :
-            MemAllocation(std::move(_MemAllocation)),
-            Buffer       (std::move(_Buffer)),
-            CPUAddress   (_CPUAddress)
-        {
-        }
-        VulkanUtilities::VulkanMemoryAllocation MemAllocation;
-        VulkanUtilities::BufferWrapper          Buffer;
-        Uint8* const                            CPUAddress = nullptr;
-    };
-    std::vector<UploadPageInfo> m_Pages;
+    // Pages taken from the upload page pool
+    std::vector<VulkanUploadPage> m_Pages;
+    // Large chunks allocated directly from the global memory manager
+    std::vector<VulkanUploadPage> m_LargeChunks;
 
     struct CurrPageInfo
     {
@@ -131,7 +122,7 @@ private:
         Uint8*   CurrCPUAddress = nullptr;
         size_t   CurrOffset     = 0;
         size_t   AvailableSize  = 0;
-        void Reset(UploadPageInfo& NewPage, size_t PageSize)
+        void Reset(VulkanUploadPage& NewPage, size_t PageSize)
         {
             vkBuffer       = NewPage.Buffer;
             CurrCPUAddress = NewPage.CPUAddress;
@@ -151,7 +142,9 @@ private:
     size_t   m_CurrAllocatedSize   = 0;
     size_t   m_PeakAllocatedSize   = 0;
 
-    UploadPageInfo CreateNewPage(VkDeviceSize SizeInBytes)const;
+    // Number of pages taken from the upload page pool, and how many of them were recycled
+    size_t   m_NumPoolPages        = 0;
+    size_t   m_NumRecycledPages    = 0;
 };
 
 }
@@ -0,0 +1,144 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::VulkanUploadPagePool class
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include "VulkanUtilities/VulkanMemoryManager.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Host-visible staging buffer bound to its own memory allocation
+struct VulkanUploadPage
+{
+    VulkanUploadPage() noexcept {}
+    VulkanUploadPage(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation, 
+                     VulkanUtilities::BufferWrapper&&          _Buffer,
+                     Uint8*                                    _CPUAddress,
+                     VkDeviceSize                              _Size) noexcept :
+        MemAllocation(std::move(_MemAllocation)),
+        Buffer       (std::move(_Buffer)),
+        CPUAddress   (_CPUAddress),
+        Size         (_Size)
+    {
+    }
+    VulkanUploadPage             (const VulkanUploadPage&)  = delete;
+    VulkanUploadPage& operator = (const VulkanUploadPage&)  = delete;
+    VulkanUploadPage             (      VulkanUploadPage&&) = default;
+    VulkanUploadPage& operator = (      VulkanUploadPage&&) = default;
+
+    VulkanUtilities::VulkanMemoryAllocation MemAllocation;
+    VulkanUtilities::BufferWrapper          Buffer;
+    Uint8*                                  CPUAddress = nullptr;
+    VkDeviceSize                            Size       = 0; // Size of the buffer
+};
+
+// Pool of upload pages shared by all upload heaps of the device.
+// 
+// Pages retired by an upload heap are not destroyed, but go into the release queues (DisposePage()) 
+// and return to the pool when the GPU is done with all command buffers that may use them. 
+// GetPage() reuses free pages of the same size, which avoids creating and binding a new 
+// buffer every time a heap needs a page.
+// 
+// Total size of pages that are in use or in flight is tracked every frame, and Trim() destroys
+// free pages that exceed the peak size over the last two trim windows.
+// 
+//     ___________________          GetPage()         ___________________
+//    |                   |------------------------->|                   |
+//    |    Free pages     |                          |  VulkanUploadHeap |
+//    |___________________|                          |___________________|
+//              A                                              |
+//              |  FreePage()        ________________          | DisposePage()
+//              |___________________|                |<________|
+//                                  | Release queues |
+//                                  |________________|
+// 
+class VulkanUploadPagePool
+{
+public:
+    VulkanUploadPagePool(RenderDeviceVkImpl& DeviceVkImpl);
+
+    VulkanUploadPagePool             (const VulkanUploadPagePool&) = delete;
+    VulkanUploadPagePool             (VulkanUploadPagePool&&)      = delete;
+    VulkanUploadPagePool& operator = (const VulkanUploadPagePool&) = delete;
+    VulkanUploadPagePool& operator = (VulkanUploadPagePool&&)      = delete;
+
+    ~VulkanUploadPagePool();
+
+    // Returns a free page of the given size or creates a new one. 
+    // If pIsRecycled is not null, it is set to true when a free page has been reused.
+    VulkanUploadPage GetPage(VkDeviceSize PageSize, bool* pIsRecycled = nullptr);
+
+    // Moves the page obtained from GetPage() into the release queues. The page returns 
+    // to the pool once all command buffers submitted to queues in QueueMask are complete.
+    void DisposePage(VulkanUploadPage&& Page, Uint64 QueueMask);
+
+    // Creates a page that does not belong to the pool
+    VulkanUploadPage CreatePage(VkDeviceSize PageSize)const;
+
+    // Destroys free pages above the high-water mark. Must be called once per frame.
+    void Trim();
+
+    struct Statistics
+    {
+        Uint64       NumPagesCreated   = 0;
+        Uint64       NumPagesRecycled  = 0;
+        Uint64       NumPagesDestroyed = 0;
+        Uint32       NumFreePages      = 0;
+        VkDeviceSize FreePagesSize     = 0;
+        // Total size of pages that are used by heaps or are in flight
+        VkDeviceSize UsedPagesSize     = 0;
+        VkDeviceSize HighWaterMark     = 0;
+    };
+    Statistics GetStatistics();
+
+private:
+    void FreePage(VulkanUploadPage&& Page);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    std::mutex m_Mtx;
+
+    // Free pages, by buffer size
+    std::unordered_map<VkDeviceSize, std::vector<VulkanUploadPage>> m_FreePages;
+
+    // The high-water mark is the peak used size over the current and the previous trim window
+    static constexpr Uint32 TrimWindow = 64;
+    Uint32       m_FramesInWindow     = 0;
+    VkDeviceSize m_CurrWindowPeakSize = 0;
+    VkDeviceSize m_PrevWindowPeakSize = 0;
+
+    Statistics m_Stats;
+};
+
+}
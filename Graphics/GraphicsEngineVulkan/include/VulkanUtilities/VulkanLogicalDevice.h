@@ -80,6 +80,7 @@ namespace VulkanUtilities
         DescriptorPoolWrapper CreateDescriptorPool(const VkDescriptorPoolCreateInfo &DescrPoolCI,   const char* DebugName = "")const;
         DescriptorSetLayoutWrapper CreateDescriptorSetLayout(const VkDescriptorSetLayoutCreateInfo &LayoutCI, const char* DebugName = "")const;
         SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo &SemaphoreCI, const char* DebugName = "")const;
+        PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo &PipelineCacheCI, const char* DebugName = "")const;
         
         VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo &AllocInfo, const char* DebugName = "")const;
         VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo &AllocInfo, const char* DebugName = "")const;
@@ -100,6 +101,7 @@ namespace VulkanUtilities
         void ReleaseVulkanObject(DescriptorPoolWrapper&& DescriptorPool)const;
         void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout)const;
         void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore)const;
+        void ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache)const;
 
         void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const;
 
@@ -126,6 +128,14 @@ namespace VulkanUtilities
         VkResult ResetDescriptorPool(VkDescriptorPool           descriptorPool,
                                      VkDescriptorPoolResetFlags flags = 0)const;
 
+        VkResult GetPipelineCacheData(VkPipelineCache pipelineCache,
+                                      size_t*         pDataSize,
+                                      void*           pData)const;
+
+        VkResult MergePipelineCaches(VkPipelineCache        dstCache,
+                                     uint32_t               srcCacheCount,
+                                     const VkPipelineCache* pSrcCaches)const;
+
     private:
         VulkanLogicalDevice(VkPhysicalDevice vkPhysicalDevice, 
                             const VkDeviceCreateInfo &DeviceCI, 
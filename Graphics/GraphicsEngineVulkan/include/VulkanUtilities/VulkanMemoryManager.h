@@ -25,11 +25,13 @@
 
 #include <mutex>
 #include <array>
-#include <unordered_map>
+#include <vector>
+#include <memory>
 #include <atomic>
 #include <string>
 #include "MemoryAllocator.h"
 #include "VariableSizeAllocationsManager.h"
+#include "PageFreeSpaceIndex.h"
 #include "VulkanUtilities/VulkanPhysicalDevice.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
 #include "VulkanUtilities/VulkanObjectWrappers.h"
@@ -91,11 +93,14 @@ public:
     VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
                      VkDeviceSize         PageSize, 
                      uint32_t             MemoryTypeIndex,
-                     bool                 IsHostVisible)noexcept;
+                     bool                 IsHostVisible,
+                     bool                 IsDedicated = false)noexcept;
     ~VulkanMemoryPage();
 
     VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
         m_ParentMemoryMgr (rhs.m_ParentMemoryMgr),
+        m_MemoryTypeIndex (rhs.m_MemoryTypeIndex),
+        m_IsDedicated     (rhs.m_IsDedicated),
         m_AllocationMgr   (std::move(rhs.m_AllocationMgr)),
         m_VkMemory        (std::move(rhs.m_VkMemory)),
         m_CPUMemory       (rhs.m_CPUMemory)
@@ -111,6 +116,12 @@ public:
     bool IsFull() const{return m_AllocationMgr.IsFull();}
     VkDeviceSize GetPageSize()const{return m_AllocationMgr.GetMaxSize();}
     VkDeviceSize GetUsedSize()const{return m_AllocationMgr.GetUsedSize();}
+    // Unlike GetUsedSize(), locks the page, so it can be called while other threads release allocations
+    VkDeviceSize GetFreeSize();
+
+    uint32_t GetMemoryTypeIndex()const{return m_MemoryTypeIndex;}
+    // Dedicated pages are created for a single large allocation and are never shared
+    bool IsDedicated()const{return m_IsDedicated;}
 
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
@@ -124,12 +135,19 @@ private:
     void Free(VulkanMemoryAllocation&& Allocation);
 
     VulkanMemoryManager&                     m_ParentMemoryMgr;
+    const uint32_t                           m_MemoryTypeIndex;
+    const bool                               m_IsDedicated;
     std::mutex                               m_Mutex;
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
 };
 
+// Pages of every memory type are kept in a separate bucket and are indexed by the amount of free space 
+// (see Diligent::PageFreeSpaceIndex). A new allocation goes to the page with the least free space that 
+// can accommodate it. Allocations that are not smaller than the dedicated allocation threshold get 
+// their own page that is sized to fit the allocation and is destroyed by ShrinkMemory() as soon as 
+// the allocation is released, regardless of the reserve size.
 class VulkanMemoryManager
 {
 public:
@@ -140,7 +158,8 @@ public:
                         VkDeviceSize                 DeviceLocalPageSize,
                         VkDeviceSize                 HostVisiblePageSize,
                         VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) : 
+                        VkDeviceSize                 HostVisibleReserveSize,
+                        VkDeviceSize                 DedicatedAllocationThreshold = 0) : 
         m_MgrName            (std::move(MgrName)),
         m_LogicalDevice      (LogicalDevice),
         m_PhysicalDevice     (PhysicalDevice),
@@ -148,7 +167,8 @@ public:
         m_DeviceLocalPageSize(DeviceLocalPageSize),
         m_HostVisiblePageSize(HostVisiblePageSize),
         m_DeviceLocalReserveSize(DeviceLocalReserveSize),
-        m_HostVisibleReserveSize(HostVisibleReserveSize)
+        m_HostVisibleReserveSize(HostVisibleReserveSize),
+        m_DedicatedAllocationThreshold(DedicatedAllocationThreshold)
     {}
 
     // We have to write this constructor because on msvc default
@@ -159,12 +179,15 @@ public:
         m_LogicalDevice   (rhs.m_LogicalDevice),
         m_PhysicalDevice  (rhs.m_PhysicalDevice),
         m_Allocator       (rhs.m_Allocator),
-        m_Pages           (std::move(rhs.m_Pages)),
+        m_MemoryTypes     (std::move(rhs.m_MemoryTypes)),
+        m_StaleIndexMask  (rhs.m_StaleIndexMask.load()),
+        m_NumReleasedDedicatedPages(rhs.m_NumReleasedDedicatedPages.load()),
     
         m_DeviceLocalPageSize    (rhs.m_DeviceLocalPageSize),
         m_HostVisiblePageSize    (rhs.m_HostVisiblePageSize),
         m_DeviceLocalReserveSize (rhs.m_DeviceLocalReserveSize),
         m_HostVisibleReserveSize (rhs.m_HostVisibleReserveSize),
+        m_DedicatedAllocationThreshold(rhs.m_DedicatedAllocationThreshold),
     
         //m_CurrUsedSize      (rhs.m_CurrUsedSize),
         m_PeakUsedSize      (rhs.m_PeakUsedSize),
@@ -185,6 +208,15 @@ public:
 	VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps);
     void ShrinkMemory();
 
+    // Allocates memory for a resource that is moved out of SrcPage. Only existing shared pages of the 
+    // same memory type that have less free space than SrcPage are considered, and no new page is created.
+    // Returns empty allocation if no such page can accommodate the request.
+    VulkanMemoryAllocation AllocateInDenserPage(VkDeviceSize Size, VkDeviceSize Alignment, VulkanMemoryPage& SrcPage);
+
+    // Returns the size by which the total size of pages exceeds the reserve size, which
+    // is the amount of memory ShrinkMemory() releases if enough pages become empty
+    VkDeviceSize GetSizeOverReserve(bool HostVisible);
+
 protected:
     friend class VulkanMemoryPage;
 
@@ -198,15 +230,35 @@ protected:
 
     Diligent::IMemoryAllocator& m_Allocator;
 
+    struct MemoryTypePages
+    {
+        // All pages of the memory type, including dedicated pages
+        std::vector<std::unique_ptr<VulkanMemoryPage>> Pages;
+        // Shared (not dedicated) pages ordered by free space
+        Diligent::PageFreeSpaceIndex<VulkanMemoryPage, VkDeviceSize> FreeSpaceIndex;
+    };
+
+    VulkanMemoryPage& CreatePage(VkDeviceSize PageSize, uint32_t MemoryTypeIndex, bool HostVisible, bool IsDedicated);
+    // Re-reads free space of all pages of the given type if allocations have been released 
+    // since the last refresh. Returns true if the index was refreshed.
+    bool RefreshFreeSpaceIndex(uint32_t MemoryTypeIndex);
+
     std::mutex m_PagesMtx;
-    std::unordered_multimap<uint32_t, VulkanMemoryPage> m_Pages;
+    std::array<MemoryTypePages, VK_MAX_MEMORY_TYPES> m_MemoryTypes;
+    // Bit i is set when an allocation of memory type i has been released since the free space 
+    // index of that type was refreshed. Allocations are released without locking m_PagesMtx.
+    std::atomic<uint32_t> m_StaleIndexMask{0};
+    // Number of dedicated pages whose allocation has been released
+    std::atomic_int32_t   m_NumReleasedDedicatedPages{0};
     
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
+    // 0 disables dedicated allocations
+    const VkDeviceSize m_DedicatedAllocationThreshold;
     
-    void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
+    void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble, uint32_t MemoryTypeIndex, bool IsDedicated);
 
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic_int64_t, 2> m_CurrUsedSize = {};
@@ -114,4 +114,5 @@ namespace VulkanUtilities
     using DescriptorPoolWrapper = VulkanObjectWrapper<VkDescriptorPool>;
     using DescriptorSetLayoutWrapper = VulkanObjectWrapper<VkDescriptorSetLayout>;
     using SemaphoreWrapper      = VulkanObjectWrapper<VkSemaphore>;
+    using PipelineCacheWrapper  = VulkanObjectWrapper<VkPipelineCache>;
 }
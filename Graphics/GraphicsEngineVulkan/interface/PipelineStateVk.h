@@ -35,6 +35,19 @@ namespace Diligent
 static constexpr INTERFACE_ID IID_PipelineStateVk =
 { 0x2fea0868, 0x932, 0x412a,{ 0x9f, 0xa, 0x7c, 0xea, 0x7e, 0x61, 0xb5, 0xe0 } };
 
+/// Pipeline state initialization status
+enum PIPELINE_STATE_STATUS : Int32
+{
+    /// Pipeline state is being initialized asynchronously
+    PIPELINE_STATE_STATUS_PENDING = 0,
+
+    /// Pipeline state is initialized and can be used
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Pipeline state initialization failed. The object cannot be used.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
 
 /// Interface to the blend state object implemented in Vulkan
 class IPipelineStateVk : public IPipelineState
@@ -46,6 +59,16 @@ public:
 
     /// Returns handle to a vulkan pipeline pass object.
     virtual VkPipeline GetVkPipeline()const = 0;
+
+    /// Returns the initialization status of the pipeline state.
+
+    /// \remarks Pipeline states created by IRenderDeviceVk::CreatePipelineState() are always ready. 
+    ///          Pipeline states created by IRenderDeviceVk::CreatePipelineStateAsync() are pending
+    ///          until the worker thread finishes initialization.
+    virtual PIPELINE_STATE_STATUS GetStatus()const = 0;
+
+    /// Blocks until the pipeline state initialization is complete and returns the final status
+    virtual PIPELINE_STATE_STATUS WaitForCompletion()const = 0;
 };
 
 }
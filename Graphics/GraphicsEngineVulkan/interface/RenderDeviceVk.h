@@ -27,6 +27,7 @@
 /// Definition of the Diligent::IRenderDeviceVk interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Primitives/interface/DataBlob.h"
 
 namespace Diligent
 {
@@ -82,6 +83,50 @@ public:
     ///        destroy it once released. The application must not destroy Vulkan buffer while it is 
     ///        in use by the engine.
     virtual void CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, IBuffer** ppBuffer) = 0;
+
+    /// Serializes the device pipeline cache
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                       data blob containing the cache data will be stored.
+    ///                       The function calls AddRef(), so that the new object will contain 
+    ///                       one reference. If the data cannot be retrieved, *ppData is set to null.
+    /// \remarks The data can be used to initialize the cache of another device (see 
+    ///          EngineVkAttribs::PipelineCacheFilePath) or merged with MergePipelineCacheData().
+    virtual void GetPipelineCacheData(IDataBlob** ppData) = 0;
+
+    /// Merges serialized pipeline cache data into the device pipeline cache
+
+    /// \param [in] pData    - Pointer to the cache data previously obtained by GetPipelineCacheData().
+    /// \param [in] DataSize - Size of the data, in bytes.
+    /// \return true if the data were merged, and false if the data were produced
+    ///         by a different driver or physical device and were ignored.
+    virtual bool MergePipelineCacheData(const void* pData, size_t DataSize) = 0;
+
+    /// Creates a pipeline state whose initialization is performed by engine worker threads
+
+    /// \param [in]  PipelineDesc     - Pipeline state description. The description is validated 
+    ///                                 on the calling thread.
+    /// \param [out] ppPipelineState  - Address of the memory location where the pointer to the
+    ///                                 pipeline state interface will be stored. 
+    ///                                 The function calls AddRef(), so that the new object will contain 
+    ///                                 one reference.
+    /// \remarks The method returns immediately. Shader reflection, pipeline layout creation and
+    ///          Vulkan pipeline compilation are executed asynchronously. Use IPipelineStateVk::GetStatus()
+    ///          to poll the status or IPipelineStateVk::WaitForCompletion() to wait for the initialization.\n
+    ///          Draw and dispatch commands as well as resource commits issued by a device context while 
+    ///          the pipeline state that was bound by IDeviceContext::SetPipelineState() is not ready are skipped.
+    ///          IPipelineState::CreateShaderResourceBinding() and IPipelineState::IsCompatibleWith() 
+    ///          block until the pipeline state is initialized.
+    virtual void CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState) = 0;
+
+    /// Submits pending initial data uploads of buffers and textures to the command queue
+
+    /// \remarks Initialization commands of buffers and textures created with initial data are 
+    ///          batched into a shared command buffer (see EngineVkAttribs::MaxPendingInitialDataUploads).
+    ///          The batch is submitted automatically before every command buffer of the immediate context,
+    ///          so calling this method is not required for correctness. An application may call it
+    ///          after a loading step to let the GPU start copying the data earlier.
+    virtual void FlushPendingUploads() = 0;
 };
 
 }
@@ -156,6 +156,7 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
         VkBuffCI.pQueueFamilyIndices = nullptr; // list of queue families that will access this buffer 
                                                 // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
 
+        m_VkUsageFlags = VkBuffCI.usage;
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
         VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
@@ -178,84 +179,43 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
         bool bInitializeBuffer = (BuffData.pData != nullptr && BuffData.DataSize > 0);
         if( bInitializeBuffer )
         {
-            VkBufferCreateInfo VkStaginBuffCI = VkBuffCI;
-            VkStaginBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-            std::string StagingBufferName = "Staging buffer for '";
-            StagingBufferName += m_Desc.Name;
-            StagingBufferName += '\'';
-            VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
-
-            VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-            VERIFY( IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
-
-            // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges 
-            // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-            // to the host (10.2)
-            auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-            auto StagingBufferMemory = StagingMemoryAllocation.Page->GetVkMemory();
-            auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
-            VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
-
-            auto* StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-            if (StagingData == nullptr)
-                LOG_BUFFER_ERROR_AND_THROW("Failed to allocate staging data");
-            memcpy(StagingData + AlignedStagingMemOffset, BuffData.pData, BuffData.DataSize);
-            
-            err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
-
-            VulkanUtilities::CommandPoolWrapper CmdPool;
-            VkCommandBuffer vkCmdBuff;
-            pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
             m_AccessFlags = VK_ACCESS_TRANSFER_WRITE_BIT;
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, m_AccessFlags);
-
-            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
-            VkBufferCopy BuffCopy = {};
-            BuffCopy.srcOffset = 0;
-            BuffCopy.dstOffset = 0;
-            BuffCopy.size = VkBuffCI.size;
-            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
-
-            Uint32 QueueIndex = 0;
-	        pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
-
-
-            // After command buffer is submitted, safe-release staging resources. This strategy
-            // is little overconservative as the resources will only be released after the 
-            // first command buffer submitted through the immediate context is complete
-
-            // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
-            //              |            |                                                |
-            //      N       |     F      |                                                |
-            //              |            |                                                |
-            //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
-            //              |            |  - SubmittedCmdBuffNumber = N                  |
-            //              |            |  - SubmittedFenceValue = F                     |
-            //     N+1 -  - | -  F+1  -  |                                                |  
-            //              |            |  Release(StagingBuffer)                        |
-            //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
-            //              |            |                                                |
-            //              |            |                                                |
-            //              |            |                                                | ExecuteCommandBuffer()                                      
-            //              |            |                                                | - SubmittedCmdBuffNumber = N+1
-            //              |            |                                                | - SubmittedFenceValue = F+1
-            //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - | 
-            //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)  
-            //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue 
-            //              |            |                                                | 
-
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer),           Uint64{1} << Uint64{QueueIndex});
-            pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+
+            // Staging data are suballocated from the upload heap of the batcher, and the copy command is 
+            // recorded into the shared transient command buffer. The batcher submits the command buffer
+            // before the immediate context submits any command buffer that may use this buffer, and 
+            // safe-releases the staging pages afterwards (see comments in UploadBatcher::FlushLocked())
+            VkBuffer vkDstBuffer = m_VulkanBuffer;
+            // Source buffer offset must be multiple of 4 (18.4)
+            constexpr VkDeviceSize StagingAlignment = 4;
+            pRenderDeviceVk->GetUploadBatcher().Enqueue(BuffData.DataSize, StagingAlignment,
+                [&](VkCommandBuffer vkCmdBuff, const VulkanUploadAllocation& StagingAllocation)
+                {
+                    memcpy(StagingAllocation.CPUAddress, BuffData.pData, BuffData.DataSize);
+
+                    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingAllocation.vkBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
+                    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkDstBuffer, 0, m_AccessFlags);
+
+                    // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                    // as the transient command buffer only contains copy commands
+                    VkBufferCopy BuffCopy = {};
+                    BuffCopy.srcOffset = StagingAllocation.AlignedOffset;
+                    BuffCopy.dstOffset = 0;
+                    BuffCopy.size = BuffData.DataSize;
+                    vkCmdCopyBuffer(vkCmdBuff, StagingAllocation.vkBuffer, vkDstBuffer, 1, &BuffCopy);
+                }
+            );
         }
         else
         {
             m_AccessFlags = 0;
         }
+
+        if (auto* pDefragmenter = pRenderDeviceVk->GetMemoryDefragmenter())
+        {
+            if (IsRelocatable())
+                pDefragmenter->RegisterBuffer(this);
+        }
     }
 }
 
@@ -277,6 +237,12 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
 
 BufferVkImpl :: ~BufferVkImpl()
 {
+    if (auto* pDefragmenter = m_pDevice->GetMemoryDefragmenter())
+    {
+        if (IsRelocatable())
+            pDefragmenter->UnregisterBuffer(this);
+    }
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if(m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.CommandQueueMask);
@@ -514,6 +480,20 @@ VulkanUtilities::BufferViewWrapper BufferVkImpl::CreateView(struct BufferViewDes
     return BuffView;
 }
 
+bool BufferVkImpl::IsRelocatable()const
+{
+    // Vertex, index and indirect argument buffers are bound by the device context at draw time, 
+    // so they can be moved to a new VkBuffer. Buffers that are referenced by descriptor sets 
+    // or buffer views cannot, because these objects would keep the old VkBuffer handle.
+    constexpr Uint32 RelocatableBindFlags = BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER | BIND_INDIRECT_DRAW_ARGS;
+    return m_VulkanBuffer != VK_NULL_HANDLE &&
+           m_MemoryAllocation.Page != nullptr &&
+           !m_MemoryAllocation.Page->IsDedicated() &&
+           m_MemoryAllocation.Page->GetCPUMemory() == nullptr &&
+           (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_STATIC) &&
+           (m_Desc.BindFlags & ~RelocatableBindFlags) == 0;
+}
+
 VkBuffer BufferVkImpl::GetVkBuffer()const
 {
     if (m_VulkanBuffer != VK_NULL_HANDLE)
@@ -0,0 +1,115 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "DescriptorSetCache.h"
+#include "HashUtils.h"
+#include "RenderDeviceVkImpl.h"
+
+namespace Diligent
+{
+
+bool DescriptorSetCache::Key::operator == (const Key& rhs)const
+{
+    return GetHash()   == rhs.GetHash()   &&
+           SetLayout   == rhs.SetLayout   &&
+           ResourceIds == rhs.ResourceIds;
+}
+
+size_t DescriptorSetCache::Key::GetHash()const
+{
+    if (Hash == 0)
+    {
+        Hash = ComputeHash(SetLayout, ResourceIds.size());
+        for (auto Id : ResourceIds)
+            HashCombine(Hash, Id);
+    }
+    return Hash;
+}
+
+void DescriptorSetCache::SharedDescriptorSet::Release()
+{
+    if (m_pCache != nullptr)
+    {
+        VERIFY_EXPR(m_pKey != nullptr);
+        m_pCache->ReleaseSet(*m_pKey);
+        Reset();
+    }
+}
+
+DescriptorSetCache::SharedDescriptorSet DescriptorSetCache::Find(const Key& SetKey)
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    auto it = m_Cache.find(SetKey);
+    if (it == m_Cache.end())
+    {
+        ++m_Stats.NumMisses;
+        return SharedDescriptorSet{};
+    }
+
+    ++m_Stats.NumHits;
+    ++it->second.RefCount;
+    return SharedDescriptorSet{*this, it->first, it->second.Allocation.GetVkDescriptorSet()};
+}
+
+DescriptorSetCache::SharedDescriptorSet DescriptorSetCache::Insert(Key&& SetKey, DescriptorSetAllocation&& Allocation)
+{
+    VERIFY_EXPR(Allocation);
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    auto it = m_Cache.find(SetKey);
+    if (it == m_Cache.end())
+        it = m_Cache.emplace(std::move(SetKey), std::move(Allocation)).first;
+    // Otherwise another thread has added the same set while the caller was writing descriptors.
+    // The caller's allocation will be moved into the release queue when it goes out of scope.
+    ++it->second.RefCount;
+    return SharedDescriptorSet{*this, it->first, it->second.Allocation.GetVkDescriptorSet()};
+}
+
+void DescriptorSetCache::ReleaseSet(const Key& SetKey)
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    auto it = m_Cache.find(SetKey);
+    VERIFY(it != m_Cache.end(), "Shared descriptor set is not found in the cache");
+    VERIFY(it->second.RefCount > 0, "Shared descriptor set is not referenced");
+    if (--it->second.RefCount == 0)
+    {
+        // DescriptorSetAllocation's destructor moves the set into the release queue,
+        // so it will not be reused until the GPU is done with it
+        m_Cache.erase(it);
+    }
+}
+
+DescriptorSetCache::Statistics DescriptorSetCache::GetStatistics()
+{
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    m_Stats.NumEntries = static_cast<Uint32>(m_Cache.size());
+    return m_Stats;
+}
+
+DescriptorSetCache::~DescriptorSetCache()
+{
+    VERIFY(m_Cache.empty(), "All shared descriptor sets must be released");
+}
+
+}
@@ -216,13 +216,31 @@ namespace Diligent
         auto* pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
         const auto& PSODesc = pPipelineStateVk->GetDesc();
 
+        // Pipeline states created asynchronously may still be initialized by the worker thread.
+        // The status is only checked here so that all commands until the next SetPipelineState() 
+        // are consistently either executed or skipped.
+        auto Status = pPipelineStateVk->GetStatus();
+        if (Status != PIPELINE_STATE_STATUS_READY)
+        {
+#ifdef DEVELOPMENT
+            if (Status == PIPELINE_STATE_STATUS_FAILED)
+                LOG_ERROR_MESSAGE("Pipeline state \"", PSODesc.Name, "\" failed to initialize. All draw, dispatch and commit commands will be ignored until another pipeline state is set.");
+#endif
+            TDeviceContextBase::SetPipelineState( pPipelineStateVk, 0 /*Dummy*/ );
+            m_State.PipelineStateNotReady = true;
+            m_DescrSetBindInfo.Reset();
+            return;
+        }
+
         bool CommitStates = false;
         bool CommitScissor = false;
-        if (!m_pPipelineState)
+        if (!m_pPipelineState || m_State.PipelineStateNotReady)
         {
             // If no pipeline state is bound, we are working with the fresh command
             // list. We have to commit the states set in the context that are not
             // committed by the draw command (render targets, viewports, scissor rects, etc.)
+            // The same is true if the previous pipeline state has never been bound to the 
+            // command buffer because it was not ready.
             CommitStates = true;
         }
         else
@@ -238,6 +256,7 @@ namespace Diligent
         }
 
         TDeviceContextBase::SetPipelineState( pPipelineStateVk, 0 /*Dummy*/ );
+        m_State.PipelineStateNotReady = false;
         EnsureVkCmdBuffer();
 
         if (PSODesc.IsComputePipeline)
@@ -272,11 +291,19 @@ namespace Diligent
         VERIFY_EXPR(pPipelineState != nullptr);
 
         auto *pPipelineStateVk = ValidatedCast<PipelineStateVkImpl>(pPipelineState);
+        if (!pPipelineStateVk->IsReady())
+        {
+            LOG_ERROR_MESSAGE("Unable to transition shader resources: pipeline state \"", pPipelineStateVk->GetDesc().Name, "\" is not ready");
+            return;
+        }
         pPipelineStateVk->CommitAndTransitionShaderResources(pShaderResourceBinding, this, false, COMMIT_SHADER_RESOURCES_FLAG_TRANSITION_RESOURCES, nullptr);
     }
 
     void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding *pShaderResourceBinding, Uint32 Flags)
     {
+        if (m_State.PipelineStateNotReady)
+            return;
+
         if (!DeviceContextBase::CommitShaderResources(pShaderResourceBinding, Flags, 0 /*Dummy*/))
             return;
 
@@ -407,6 +434,9 @@ namespace Diligent
             return;
 #endif
 
+        if (m_State.PipelineStateNotReady)
+            return;
+
         EnsureVkCmdBuffer();
 
         if ( drawAttribs.IsIndexed )
@@ -494,6 +524,9 @@ namespace Diligent
             return;
 #endif
 
+        if (m_State.PipelineStateNotReady)
+            return;
+
         EnsureVkCmdBuffer();
 
         // Dispatch commands must be executed outside of render pass
@@ -766,12 +799,25 @@ namespace Diligent
 
         VERIFY_EXPR(m_bIsDeferred || m_SubmittedBuffersCmdQueueMask == (Uint64{1}<<m_CommandQueueId));
 
+        if (!m_bIsDeferred)
+        {
+            // Copy commands of relocated buffers are submitted right away, so that the old 
+            // buffers are released as soon as the GPU is done with this frame
+            auto* pDefragmenter = DeviceVkImpl.GetMemoryDefragmenter();
+            if (pDefragmenter != nullptr && pDefragmenter->Defragment(*this))
+                Flush();
+        }
+
         // Release resources used by the context during this frame.
         
-        // Upload heap returns all allocated pages to the global memory manager.
-        // Note: as global memory manager is hosted by the render device, the upload heap can be destroyed
-        // before the pages are actually returned to the manager.
+        // Upload heap returns all allocated pages to the upload page pool.
+        // Note: as the pool is hosted by the render device, the upload heap can be destroyed
+        // before the pages are actually returned to the pool.
         m_UploadHeap.ReleaseAllocatedPages(m_SubmittedBuffersCmdQueueMask);
+
+        // Upload page pool destroys free pages that exceed the recent peak usage
+        if (!m_bIsDeferred)
+            DeviceVkImpl.GetUploadPagePool().Trim();
         
         // Dynamic heap returns all allocated master blocks to the global dynamic memory manager.
         // Note: as global dynamic memory manager is hosted by the render device, the dynamic heap can
@@ -1127,6 +1173,65 @@ namespace Diligent
         ++m_State.NumCommands;
     }
 
+    bool DeviceContextVkImpl::RelocateBuffer(BufferVkImpl& BuffVk)
+    {
+        VERIFY(!m_bIsDeferred, "Buffers can only be relocated by the immediate context");
+        VERIFY_EXPR(BuffVk.IsRelocatable());
+
+        auto* pDeviceVkImpl = m_pDevice.RawPtr<RenderDeviceVkImpl>();
+        const auto& LogicalDevice = pDeviceVkImpl->GetLogicalDevice();
+        const auto& BuffDesc = BuffVk.GetDesc();
+
+        VkBufferCreateInfo VkBuffCI = {};
+        VkBuffCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        VkBuffCI.size        = BuffDesc.uiSizeInBytes;
+        VkBuffCI.usage       = BuffVk.m_VkUsageFlags;
+        VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        auto NewVkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, BuffDesc.Name);
+
+        auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(NewVkBuffer);
+        auto& SrcPage = *BuffVk.m_MemoryAllocation.Page;
+        VERIFY((MemReqs.memoryTypeBits & (1u << SrcPage.GetMemoryTypeIndex())) != 0, "The buffer is expected to be compatible with the memory type of its current page");
+        auto NewAllocation = pDeviceVkImpl->GetGlobalMemoryManager().AllocateInDenserPage(MemReqs.size, MemReqs.alignment, SrcPage);
+        if (NewAllocation.Page == nullptr)
+        {
+            // The new buffer has never been used by the GPU and is destroyed right away
+            return false;
+        }
+
+        auto AlignedOffset = Align(NewAllocation.UnalignedOffset, MemReqs.alignment);
+        auto err = LogicalDevice.BindBufferMemory(NewVkBuffer, NewAllocation.Page->GetVkMemory(), AlignedOffset);
+        if (err != VK_SUCCESS)
+        {
+            LOG_ERROR_MESSAGE("Failed to bind memory to the relocated buffer '", BuffDesc.Name, '\'');
+            return false;
+        }
+
+        EnsureVkCmdBuffer();
+        if (!BuffVk.CheckAccessFlags(VK_ACCESS_TRANSFER_READ_BIT))
+            BufferMemoryBarrier(BuffVk, VK_ACCESS_TRANSFER_READ_BIT);
+        m_CommandBuffer.BufferMemoryBarrier(NewVkBuffer, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+        VkBufferCopy CopyRegion;
+        CopyRegion.srcOffset = 0;
+        CopyRegion.dstOffset = 0;
+        CopyRegion.size      = BuffDesc.uiSizeInBytes;
+        m_CommandBuffer.CopyBuffer(BuffVk.m_VulkanBuffer, NewVkBuffer, 1, &CopyRegion);
+        ++m_State.NumCommands;
+
+        // Commands that have already been recorded or submitted may still use the old buffer and memory
+        pDeviceVkImpl->SafeReleaseDeviceObject(std::move(BuffVk.m_VulkanBuffer),     BuffDesc.CommandQueueMask);
+        pDeviceVkImpl->SafeReleaseDeviceObject(std::move(BuffVk.m_MemoryAllocation), BuffDesc.CommandQueueMask);
+        BuffVk.m_VulkanBuffer     = std::move(NewVkBuffer);
+        BuffVk.m_MemoryAllocation = std::move(NewAllocation);
+        BuffVk.SetAccessFlags(VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        // The buffer may be bound to the context, in which case the new handle must be committed
+        m_State.CommittedVBsUpToDate = false;
+        m_State.CommittedIBUpToDate  = false;
+
+        return true;
+    }
+
     void DeviceContextVkImpl::CopyTextureRegion(TextureVkImpl *pSrcTexture, TextureVkImpl *pDstTexture, const VkImageCopy &CopyRegion)
     {
         EnsureVkCmdBuffer();
@@ -38,8 +38,50 @@ static const char* g_GenerateMipsCSSource =
     #include "../shaders/GenerateMipsCS_inc.h"
 };
 
+#if GENERATE_MIPS_PRECOMPILED_SPIRV
+// SPIR-V compiled from GenerateMipsCS.csh at build time by GLSL2SPIRVInclude
+#   include "GenerateMipsCS_spv_inc.h"
+#endif
+
 namespace Diligent
 {
+#if GENERATE_MIPS_PRECOMPILED_SPIRV
+    namespace
+    {
+        // Precompiled shaders for one image format, indexed by the NON_POWER_OF_TWO value
+        struct PrecompiledGenerateMipsCS
+        {
+            const char*     GlFmt;
+            bool            IsGamma;
+            const uint32_t* pSPIRV[4];
+            size_t          SPIRVSize[4];
+        };
+
+#       define PRECOMPILED_GENERATE_MIPS_CS(GlFmt, IsGamma, Name)\
+            {GlFmt, IsGamma, {Name##_0, Name##_1, Name##_2, Name##_3}, {sizeof(Name##_0), sizeof(Name##_1), sizeof(Name##_2), sizeof(Name##_3)}}
+
+        // The variants must match the list in GraphicsEngineVulkan/CMakeLists.txt
+        const PrecompiledGenerateMipsCS PrecompiledShaders[] =
+        {
+            PRECOMPILED_GENERATE_MIPS_CS("rgba8",   false, g_GenerateMipsCS_rgba8),
+            PRECOMPILED_GENERATE_MIPS_CS("rgba8",   true,  g_GenerateMipsCS_rgba8_srgb),
+            PRECOMPILED_GENERATE_MIPS_CS("rgba16f", false, g_GenerateMipsCS_rgba16f),
+            PRECOMPILED_GENERATE_MIPS_CS("rgba32f", false, g_GenerateMipsCS_rgba32f)
+        };
+#       undef PRECOMPILED_GENERATE_MIPS_CS
+
+        const PrecompiledGenerateMipsCS* FindPrecompiledShaders(const char* GlFmt, bool IsGamma)
+        {
+            for (const auto& Shaders : PrecompiledShaders)
+            {
+                if (strcmp(Shaders.GlFmt, GlFmt) == 0 && Shaders.IsGamma == IsGamma)
+                    return &Shaders;
+            }
+            return nullptr;
+        }
+    }
+#endif
+
     void GenerateMipsVkHelper::GetGlImageFormat(const TextureFormatAttribs& FmtAttribs, std::array<char, 16>& GlFmt)
     {
         size_t pos = 0;
@@ -124,6 +166,12 @@ namespace Diligent
         std::array<char, 16> GlFmt;
         GetGlImageFormat(FmtAttribs, GlFmt);
 
+#if GENERATE_MIPS_PRECOMPILED_SPIRV
+        // If the shaders for this format were compiled at build time, create them from SPIR-V.
+        // Otherwise, compile GLSL source at run time.
+        const auto* pPrecompiledShaders = FindPrecompiledShaders(GlFmt.data(), IsGamma);
+#endif
+
         for(Uint32 NonPowOfTwo=0; NonPowOfTwo < 4; ++NonPowOfTwo)
         {
             ShaderMacroHelper Macros;
@@ -134,6 +182,15 @@ namespace Diligent
             Macros.Finalize();
             CSCreateAttribs.Macros = Macros;
 
+#if GENERATE_MIPS_PRECOMPILED_SPIRV
+            if (pPrecompiledShaders != nullptr)
+            {
+                CSCreateAttribs.Source       = nullptr;
+                CSCreateAttribs.ByteCode     = pPrecompiledShaders->pSPIRV[NonPowOfTwo];
+                CSCreateAttribs.ByteCodeSize = pPrecompiledShaders->SPIRVSize[NonPowOfTwo];
+            }
+#endif
+
             std::stringstream name_ss;
             name_ss << "Generate mips " << GlFmt.data();
             switch(NonPowOfTwo)
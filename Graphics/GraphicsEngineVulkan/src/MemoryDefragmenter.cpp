@@ -0,0 +1,180 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include <unordered_map>
+#include <algorithm>
+#include "MemoryDefragmenter.h"
+#include "RenderDeviceVkImpl.h"
+#include "DeviceContextVkImpl.h"
+#include "BufferVkImpl.h"
+
+namespace Diligent
+{
+
+MemoryDefragmenter::MemoryDefragmenter(RenderDeviceVkImpl& DeviceVkImpl, VkDeviceSize BudgetPerFrame) :
+    m_DeviceVkImpl  (DeviceVkImpl),
+    m_BudgetPerFrame(BudgetPerFrame)
+{
+    VERIFY_EXPR(m_BudgetPerFrame != 0);
+}
+
+MemoryDefragmenter::~MemoryDefragmenter()
+{
+    DEV_CHECK_ERR(m_Buffers.empty(), "All buffers must have been unregistered from the memory defragmenter");
+    if (m_Stats.NumBuffersMoved != 0)
+    {
+        LOG_INFO_MESSAGE("Memory defragmenter: moved ", m_Stats.NumBuffersMoved, (m_Stats.NumBuffersMoved == 1 ? " buffer (" : " buffers ("),
+                         FormatMemorySize(m_Stats.BytesMoved, 2), "), released ", m_Stats.NumPagesEvacuated, (m_Stats.NumPagesEvacuated == 1 ? " page (" : " pages ("),
+                         FormatMemorySize(m_Stats.EvacuatedPagesSize, 2), ')');
+    }
+}
+
+void MemoryDefragmenter::RegisterBuffer(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    m_Buffers.insert(pBuffer);
+}
+
+void MemoryDefragmenter::UnregisterBuffer(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    m_Buffers.erase(pBuffer);
+    auto it = std::find(m_PageBuffers.begin(), m_PageBuffers.end(), pBuffer);
+    if (it != m_PageBuffers.end())
+        m_PageBuffers.erase(it);
+}
+
+bool MemoryDefragmenter::SelectPage()
+{
+    VERIFY_EXPR(m_PageBuffers.empty());
+
+    // Only device-local buffers are relocatable. Empty pages within the reserve size are
+    // not released, so there is no point in evacuating them.
+    const auto SizeOverReserve = m_DeviceVkImpl.GetGlobalMemoryManager().GetSizeOverReserve(false);
+    if (SizeOverReserve == 0)
+        return false;
+
+    struct PageBuffers
+    {
+        VkDeviceSize               MovableSize = 0;
+        std::vector<BufferVkImpl*> Buffers;
+    };
+    std::unordered_map<VulkanUtilities::VulkanMemoryPage*, PageBuffers> Pages;
+    for (auto* pBuffer : m_Buffers)
+    {
+        const auto& Allocation = pBuffer->GetMemoryAllocation();
+        auto& Page = Pages[Allocation.Page];
+        Page.MovableSize += Allocation.Size;
+        Page.Buffers.push_back(pBuffer);
+    }
+
+    VulkanUtilities::VulkanMemoryPage* pSparsestPage = nullptr;
+    VkDeviceSize                       MinUsedSize   = 0;
+    for (const auto& it : Pages)
+    {
+        auto& Page = *it.first;
+        const auto PageSize = Page.GetPageSize();
+        const auto UsedSize = PageSize - Page.GetFreeSize();
+        // The page can only become empty if all its allocations belong to relocatable buffers.
+        // Allocations of buffers moved earlier that are still in the release queue also prevent 
+        // the page from being selected until they are released.
+        // Pages that are at least half full are not worth evacuating.
+        if (it.second.MovableSize != UsedSize || UsedSize * 2 > PageSize || PageSize > SizeOverReserve)
+            continue;
+
+        if (pSparsestPage == nullptr || UsedSize < MinUsedSize)
+        {
+            pSparsestPage = &Page;
+            MinUsedSize   = UsedSize;
+        }
+    }
+
+    if (pSparsestPage == nullptr)
+        return false;
+
+    m_PageBuffers       = std::move(Pages[pSparsestPage].Buffers);
+    m_EvacuatedPageSize = pSparsestPage->GetPageSize();
+    return true;
+}
+
+bool MemoryDefragmenter::Defragment(DeviceContextVkImpl& ImmediateCtx)
+{
+    // Command lists recorded by deferred contexts may reference the old VkBuffer handles 
+    // and be executed after the handles have been released
+    if (m_DeviceVkImpl.GetNumDeferredContexts() != 0)
+        return false;
+
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    if (m_PageBuffers.empty())
+    {
+        if (m_FramesToNextSelection > 0)
+        {
+            --m_FramesToNextSelection;
+            return false;
+        }
+
+        if (!SelectPage())
+        {
+            m_FramesToNextSelection = SelectionInterval;
+            return false;
+        }
+    }
+
+    VkDeviceSize BytesMoved = 0;
+    while (!m_PageBuffers.empty() && BytesMoved < m_BudgetPerFrame)
+    {
+        auto* pBuffer = m_PageBuffers.back();
+        const auto Size = pBuffer->GetMemoryAllocation().Size;
+        if (!ImmediateCtx.RelocateBuffer(*pBuffer))
+        {
+            // There is no denser page that can accommodate the buffer, so the page cannot be evacuated
+            m_PageBuffers.clear();
+            m_FramesToNextSelection = SelectionInterval;
+            break;
+        }
+
+        m_PageBuffers.pop_back();
+        BytesMoved += Size;
+        ++m_Stats.NumBuffersMoved;
+        m_Stats.BytesMoved += Size;
+        if (m_PageBuffers.empty())
+        {
+            // The page is released by VulkanMemoryManager::ShrinkMemory() once the old
+            // allocations are released by the release queue
+            ++m_Stats.NumPagesEvacuated;
+            m_Stats.EvacuatedPagesSize += m_EvacuatedPageSize;
+        }
+    }
+
+    return BytesMoved != 0;
+}
+
+MemoryDefragmenter::Statistics MemoryDefragmenter::GetStatistics()
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    return m_Stats;
+}
+
+}
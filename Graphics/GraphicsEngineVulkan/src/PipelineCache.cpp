@@ -0,0 +1,205 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include "PipelineCache.h"
+
+namespace Diligent
+{
+
+static bool ReadFile(const String& Path, std::vector<Uint8>& Data)
+{
+    auto* pFile = fopen(Path.c_str(), "rb");
+    if (pFile == nullptr)
+        return false;
+
+    fseek(pFile, 0, SEEK_END);
+    auto FileSize = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    bool Success = false;
+    if (FileSize > 0)
+    {
+        Data.resize(static_cast<size_t>(FileSize));
+        Success = fread(Data.data(), 1, Data.size(), pFile) == Data.size();
+    }
+    fclose(pFile);
+    return Success;
+}
+
+PipelineCache::PipelineCache(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                             const VkPhysicalDeviceProperties&           DeviceProps,
+                             const Char*                                 FilePath) :
+    m_LogicalDevice(LogicalDevice),
+    m_VendorID     (DeviceProps.vendorID),
+    m_DeviceID     (DeviceProps.deviceID),
+    m_FilePath     (FilePath != nullptr ? FilePath : "")
+{
+    memcpy(m_PipelineCacheUUID, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE);
+
+    std::vector<Uint8> InitialData;
+    if (!m_FilePath.empty() && ReadFile(m_FilePath, InitialData))
+    {
+        if (IsCompatible(InitialData.data(), InitialData.size()))
+        {
+            LOG_INFO_MESSAGE("Loaded ", InitialData.size(), " bytes of pipeline cache data from '", m_FilePath, "'");
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Pipeline cache file '", m_FilePath, "' was created by a different driver or device and will be ignored");
+            InitialData.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo PipelineCacheCI = {};
+    PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext           = nullptr;
+    PipelineCacheCI.flags           = 0; // reserved for future use
+    PipelineCacheCI.initialDataSize = InitialData.size();
+    PipelineCacheCI.pInitialData    = InitialData.empty() ? nullptr : InitialData.data();
+    m_VkPipelineCache = m_LogicalDevice.CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+}
+
+PipelineCache::~PipelineCache()
+{
+    if (!m_FilePath.empty())
+        Save();
+}
+
+bool PipelineCache::IsCompatible(const void* pData, size_t DataSize)const
+{
+    // Pipeline cache header version one (9.6):
+    //      Offset   Size          Meaning
+    //      0        4             length in bytes of the entire pipeline cache header
+    //      4        4             VkPipelineCacheHeaderVersion value
+    //      8        4             vendor ID equal to VkPhysicalDeviceProperties::vendorID
+    //      12       4             device ID equal to VkPhysicalDeviceProperties::deviceID
+    //      16       VK_UUID_SIZE  pipeline cache ID equal to VkPhysicalDeviceProperties::pipelineCacheUUID
+    static constexpr size_t MinHeaderSize = 16 + VK_UUID_SIZE;
+    if (pData == nullptr || DataSize < MinHeaderSize)
+        return false;
+
+    const auto* pBytes = reinterpret_cast<const Uint8*>(pData);
+    Uint32 HeaderFields[4];
+    memcpy(HeaderFields, pBytes, sizeof(HeaderFields));
+    const auto HeaderSize    = HeaderFields[0];
+    const auto HeaderVersion = HeaderFields[1];
+    return HeaderSize    >= MinHeaderSize && HeaderSize <= DataSize &&
+           HeaderVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE    &&
+           HeaderFields[2] == m_VendorID &&
+           HeaderFields[3] == m_DeviceID &&
+           memcmp(pBytes + 16, m_PipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+std::vector<Uint8> PipelineCache::GetData()const
+{
+    std::vector<Uint8> Data;
+    // The size of the cache may grow between the two calls when pipelines are created 
+    // by other threads, in which case VK_INCOMPLETE is returned and the call is repeated
+    for (;;)
+    {
+        size_t DataSize = 0;
+        if (m_LogicalDevice.GetPipelineCacheData(m_VkPipelineCache, &DataSize, nullptr) != VK_SUCCESS)
+            return {};
+
+        Data.resize(DataSize);
+        auto err = m_LogicalDevice.GetPipelineCacheData(m_VkPipelineCache, &DataSize, Data.data());
+        if (err == VK_SUCCESS)
+        {
+            Data.resize(DataSize);
+            return Data;
+        }
+        else if (err != VK_INCOMPLETE)
+            return {};
+    }
+}
+
+bool PipelineCache::Merge(const void* pData, size_t DataSize)
+{
+    if (!IsCompatible(pData, DataSize))
+    {
+        LOG_WARNING_MESSAGE("Pipeline cache data were created by a different driver or device and will not be merged");
+        return false;
+    }
+
+    VkPipelineCacheCreateInfo PipelineCacheCI = {};
+    PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext           = nullptr;
+    PipelineCacheCI.flags           = 0; // reserved for future use
+    PipelineCacheCI.initialDataSize = DataSize;
+    PipelineCacheCI.pInitialData    = pData;
+    // The temporary cache is only used by this thread and is destroyed right after it is merged
+    auto SrcCache = m_LogicalDevice.CreatePipelineCache(PipelineCacheCI, "Temporary pipeline cache");
+    VkPipelineCache vkSrcCache = SrcCache;
+
+    std::lock_guard<std::mutex> Lock(m_MergeMtx);
+    return m_LogicalDevice.MergePipelineCaches(m_VkPipelineCache, 1, &vkSrcCache) == VK_SUCCESS;
+}
+
+bool PipelineCache::Save()
+{
+    if (m_FilePath.empty())
+        return false;
+
+    auto Data = GetData();
+    if (Data.empty())
+    {
+        LOG_ERROR_MESSAGE("Failed to retrieve pipeline cache data");
+        return false;
+    }
+
+    // Write the new file next to the existing one, and replace the existing file 
+    // only when all data has been successfully written
+    auto TmpFilePath = m_FilePath + ".tmp";
+    auto* pFile = fopen(TmpFilePath.c_str(), "wb");
+    if (pFile == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create pipeline cache file '", TmpFilePath, "'");
+        return false;
+    }
+    bool Success = fwrite(Data.data(), Data.size(), 1, pFile) == 1;
+    Success = (fclose(pFile) == 0) && Success;
+    if (!Success)
+    {
+        LOG_ERROR_MESSAGE("Failed to write pipeline cache file '", TmpFilePath, "'");
+        remove(TmpFilePath.c_str());
+        return false;
+    }
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    // rename() does not replace existing files on Windows
+    remove(m_FilePath.c_str());
+#endif
+    if (rename(TmpFilePath.c_str(), m_FilePath.c_str()) != 0)
+    {
+        LOG_ERROR_MESSAGE("Failed to replace pipeline cache file '", m_FilePath, "'");
+        remove(TmpFilePath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}
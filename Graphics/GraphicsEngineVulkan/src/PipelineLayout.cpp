@@ -416,8 +416,18 @@ void PipelineLayout::InitResourceCache(RenderDeviceVkImpl* pDeviceVkImpl, Shader
     const auto &StaticAndMutSet = m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_STATIC);
     if (StaticAndMutSet.SetIndex >= 0)
     {
-        DescriptorSetAllocation SetAllocation = pDeviceVkImpl->AllocateDescriptorSet(~Uint64{0}, StaticAndMutSet.VkLayout);
-        ResourceCache.GetDescriptorSet(StaticAndMutSet.SetIndex).AssignDescriptorSetAllocation(std::move(SetAllocation));
+        auto& DescrSet = ResourceCache.GetDescriptorSet(StaticAndMutSet.SetIndex);
+        if (pDeviceVkImpl->GetDescriptorSetCache() != nullptr)
+        {
+            // Vulkan descriptor set will be taken from the descriptor set cache 
+            // by PipelineStateVkImpl::CommitAndTransitionShaderResources()
+            DescrSet.EnableSharedSet();
+        }
+        else
+        {
+            DescriptorSetAllocation SetAllocation = pDeviceVkImpl->AllocateDescriptorSet(~Uint64{0}, StaticAndMutSet.VkLayout);
+            DescrSet.AssignDescriptorSetAllocation(std::move(SetAllocation));
+        }
     }
 }
 
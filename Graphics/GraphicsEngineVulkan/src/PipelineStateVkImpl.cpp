@@ -128,12 +128,49 @@ VkRenderPassCreateInfo PipelineStateVkImpl::GetRenderPassCreateInfo(
 
 PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters,
                                            RenderDeviceVkImpl*      pDeviceVk,
-                                           const PipelineStateDesc& PipelineDesc) : 
+                                           const PipelineStateDesc& PipelineDesc,
+                                           bool                     DeferInitialization) : 
     TPipelineStateBase(pRefCounters, pDeviceVk, PipelineDesc),
     m_SRBMemAllocator(GetRawAllocator()),
     m_pDefaultShaderResBinding(nullptr, STDDeleter<ShaderResourceBindingVkImpl, FixedBlockMemoryAllocator>(pDeviceVk->GetSRBAllocator()) )
 {
-    const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    if (!DeferInitialization)
+    {
+        Initialize();
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
+        m_InitCompletedSignal.Trigger(true);
+    }
+}
+
+void PipelineStateVkImpl::InitializeDeferred()
+{
+    VERIFY(m_Status.load() == PIPELINE_STATE_STATUS_PENDING, "Pipeline state has already been initialized");
+
+    auto Status = PIPELINE_STATE_STATUS_FAILED;
+    try
+    {
+        Initialize();
+        Status = PIPELINE_STATE_STATUS_READY;
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR_MESSAGE("Failed to initialize pipeline state '", m_Desc.Name, "'");
+    }
+    // All writes made by Initialize() become visible to the threads that observe the new status
+    m_Status.store(Status);
+    m_InitCompletedSignal.Trigger(true);
+}
+
+PIPELINE_STATE_STATUS PipelineStateVkImpl::WaitForCompletion()const
+{
+    if (m_Status.load() == PIPELINE_STATE_STATUS_PENDING)
+        m_InitCompletedSignal.Wait();
+    return m_Status.load();
+}
+
+void PipelineStateVkImpl::Initialize()
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
 
     // Initialize shader resource layouts
     auto& ShaderResLayoutAllocator = GetRawAllocator();
@@ -151,7 +188,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
     ShaderResourceLayoutVk::Initialize(m_NumShaders, m_ShaderResourceLayouts, ShaderResources.data(), GetRawAllocator(), ShaderSPIRVs.data(), m_PipelineLayout);
     m_PipelineLayout.Finalize(LogicalDevice);
 
-    if (PipelineDesc.SRBAllocationGranularity > 1)
+    if (m_Desc.SRBAllocationGranularity > 1)
     {
         std::array<size_t, MaxShadersInPipeline> ShaderVariableDataSizes = {};
         for (Uint32 s = 0; s < m_NumShaders; ++s)
@@ -165,7 +202,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         auto DescriptorSetSizes = m_PipelineLayout.GetDescriptorSetSizes(NumSets);
         auto CacheMemorySize = ShaderResourceCacheVk::GetRequiredMemorySize(NumSets, DescriptorSetSizes.data());
 
-        m_SRBMemAllocator.Initialize(PipelineDesc.SRBAllocationGranularity, m_NumShaders, ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
+        m_SRBMemAllocator.Initialize(m_Desc.SRBAllocationGranularity, m_NumShaders, ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
     }
 
     // Create shader modules and initialize shader stages
@@ -224,15 +261,15 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         PipelineCI.stage = ShaderStages[0];
         PipelineCI.layout = m_PipelineLayout.GetVkPipelineLayout();
         
-        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, m_pDevice->GetVkPipelineCache(), m_Desc.Name);
     }
     else
     {
-        const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
+        const auto& PhysicalDevice = m_pDevice->GetPhysicalDevice();
         
         auto& GraphicsPipeline = m_Desc.GraphicsPipeline;
 
-        auto& RPCache = pDeviceVk->GetRenderPassCache();
+        auto& RPCache = m_pDevice->GetRenderPassCache();
         RenderPassCache::RenderPassCacheKey Key(
             GraphicsPipeline.NumRenderTargets,
             GraphicsPipeline.SmplDesc.Count,
@@ -373,7 +410,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
         PipelineCI.basePipelineIndex = 0; // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, m_pDevice->GetVkPipelineCache(), m_Desc.Name);
     }
 
     m_HasStaticResources = false;
@@ -392,7 +429,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
     // If there are only static resources, create default shader resource binding
     if (m_HasStaticResources && !m_HasNonStaticResources)
     {
-        auto& SRBAllocator = pDeviceVk->GetSRBAllocator();
+        auto& SRBAllocator = m_pDevice->GetSRBAllocator();
         // Default shader resource binding must be initialized after resource layouts are parsed!
         m_pDefaultShaderResBinding.reset( NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingVkImpl instance", ShaderResourceBindingVkImpl, this)(this, true) );
     }
@@ -416,13 +453,17 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
     // Default SRB must be destroyed before SRB allocators
     m_pDefaultShaderResBinding.reset();
 
-    auto& RawAllocator = GetRawAllocator();
-
-    for (Uint32 s=0; s < m_NumShaders; ++s)
+    // Resource layouts are not allocated if the deferred initialization failed early
+    if (m_ShaderResourceLayouts != nullptr)
     {
-        m_ShaderResourceLayouts[s].~ShaderResourceLayoutVk();
+        auto& RawAllocator = GetRawAllocator();
+
+        for (Uint32 s=0; s < m_NumShaders; ++s)
+        {
+            m_ShaderResourceLayouts[s].~ShaderResourceLayoutVk();
+        }
+        RawAllocator.Free(m_ShaderResourceLayouts);
     }
-    RawAllocator.Free(m_ShaderResourceLayouts);
 }
 
 IMPLEMENT_QUERY_INTERFACE( PipelineStateVkImpl, IID_PipelineStateVk, TPipelineStateBase )
@@ -430,6 +471,13 @@ IMPLEMENT_QUERY_INTERFACE( PipelineStateVkImpl, IID_PipelineStateVk, TPipelineSt
 
 void PipelineStateVkImpl::CreateShaderResourceBinding(IShaderResourceBinding **ppShaderResourceBinding)
 {
+    if (WaitForCompletion() != PIPELINE_STATE_STATUS_READY)
+    {
+        LOG_ERROR_MESSAGE("Unable to create shader resource binding: pipeline state '", m_Desc.Name, "' failed to initialize");
+        *ppShaderResourceBinding = nullptr;
+        return;
+    }
+
     auto& SRBAllocator = m_pDevice->GetSRBAllocator();
     auto pResBindingVk = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBindingVkImpl instance", ShaderResourceBindingVkImpl)(this, false);
     pResBindingVk->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
@@ -443,6 +491,10 @@ bool PipelineStateVkImpl::IsCompatibleWith(const IPipelineState *pPSO)const
         return true;
 
     const PipelineStateVkImpl *pPSOVk = ValidatedCast<const PipelineStateVkImpl>(pPSO);
+    // Shader resource layout hashes are only known after the initialization is complete
+    if (WaitForCompletion() != PIPELINE_STATE_STATUS_READY || pPSOVk->WaitForCompletion() != PIPELINE_STATE_STATUS_READY)
+        return false;
+
     if (m_ShaderResourceLayoutHash != pPSOVk->m_ShaderResourceLayoutHash)
         return false;
 
@@ -565,6 +617,9 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
                     Layout.CommitDynamicResources(ResourceCache, DynamicDescrSet);
             }
         }
+        if (auto* pDescrSetCache = m_pDevice->GetDescriptorSetCache())
+            AssignSharedDescriptorSet(*pDescrSetCache, ResourceCache);
+
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
         VERIFY_EXPR(pDescrSetBindInfo != nullptr);
         m_PipelineLayout.PrepareDescriptorSets(pCtxVkImpl, m_Desc.IsComputePipeline, ResourceCache, *pDescrSetBindInfo, DynamicDescrSet);
@@ -578,4 +633,38 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
     }
 }
 
+void PipelineStateVkImpl::AssignSharedDescriptorSet(DescriptorSetCache& SetCache, ShaderResourceCacheVk& ResourceCache)const
+{
+    auto SetIndex = m_PipelineLayout.GetStaticAndMutableDescriptorSetIndex();
+    if (SetIndex < 0)
+        return;
+
+    auto& DescrSet = ResourceCache.GetDescriptorSet(SetIndex);
+    VERIFY_EXPR(DescrSet.UsesSharedSet());
+    // The set is released by ShaderResourceLayoutVk::VkResource::BindResource() when any resource changes
+    if (DescrSet.GetVkDescriptorSet() != VK_NULL_HANDLE)
+        return;
+
+    DescriptorSetCache::Key SetKey;
+    SetKey.SetLayout = m_PipelineLayout.GetStaticAndMutableDescriptorSetVkLayout();
+    DescrSet.GetResourceIds(SetKey.ResourceIds);
+
+    auto SharedSet = SetCache.Find(SetKey);
+    if (!SharedSet)
+    {
+        auto SetAllocation = m_pDevice->AllocateDescriptorSet(~Uint64{0}, SetKey.SetLayout);
+        // Descriptors of all shader stages are written with a single vkUpdateDescriptorSets() call
+        ShaderResourceLayoutVk::DescriptorWriteBatch WriteBatch;
+        for (Uint32 s = 0; s < m_NumShaders; ++s)
+            m_ShaderResourceLayouts[s].GetStaticAndMutableDescriptorWrites(ResourceCache, SetAllocation.GetVkDescriptorSet(), WriteBatch);
+        if (!WriteBatch.WriteDescrSets.empty())
+        {
+            const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+            LogicalDevice.UpdateDescriptorSets(static_cast<uint32_t>(WriteBatch.WriteDescrSets.size()), WriteBatch.WriteDescrSets.data(), 0, nullptr);
+        }
+        SharedSet = SetCache.Insert(std::move(SetKey), std::move(SetAllocation));
+    }
+    DescrSet.AssignSharedSet(std::move(SharedSet));
+}
+
 }
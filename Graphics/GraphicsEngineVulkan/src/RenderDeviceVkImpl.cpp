@@ -33,6 +33,7 @@
 #include "DeviceContextVkImpl.h"
 #include "FenceVkImpl.h"
 #include "EngineMemory.h"
+#include "DataBlobImpl.h"
 
 namespace Diligent
 {
@@ -67,6 +68,7 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
     m_PhysicalDevice(std::move(PhysicalDevice)),
     m_LogicalVkDevice(std::move(LogicalDevice)),
     m_EngineAttribs(CreationAttribs),
+    m_PipelineCache(*m_LogicalVkDevice, m_PhysicalDevice->GetProperties(), CreationAttribs.PipelineCacheFilePath),
     m_FramebufferCache(*this),
     m_RenderPassCache(*this),
     m_DescriptorSetAllocator
@@ -110,13 +112,21 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
         false // Pools can only be reset
     },
     m_TransientCmdPoolMgr(*this, "Transient command buffer pool manager", CmdQueues[0]->GetQueueFamilyIndex(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT),
-    m_MemoryMgr("Global resource memory manager", *m_LogicalVkDevice, *m_PhysicalDevice, GetRawAllocator(), CreationAttribs.DeviceLocalMemoryPageSize, CreationAttribs.HostVisibleMemoryPageSize, CreationAttribs.DeviceLocalMemoryReserveSize, CreationAttribs.HostVisibleMemoryReserveSize),
+    m_MemoryMgr("Global resource memory manager", *m_LogicalVkDevice, *m_PhysicalDevice, GetRawAllocator(), CreationAttribs.DeviceLocalMemoryPageSize, CreationAttribs.HostVisibleMemoryPageSize, CreationAttribs.DeviceLocalMemoryReserveSize, CreationAttribs.HostVisibleMemoryReserveSize, CreationAttribs.DedicatedAllocationThreshold),
+    m_UploadPagePool(*this),
     m_DynamicMemoryManager
     {
         GetRawAllocator(),
         *this,
         CreationAttribs.DynamicHeapSize,
         ~Uint64{0}
+    },
+    m_UploadBatcher
+    {
+        *this,
+        CreationAttribs.InitialDataUploadPageSize,
+        CreationAttribs.MaxPendingInitialDataUploads,
+        CreationAttribs.MaxPendingInitialDataSize
     }
 {
     m_DeviceCaps.DevType = DeviceType::Vulkan;
@@ -126,10 +136,25 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
     m_DeviceCaps.bMultithreadedResourceCreationSupported = True;
     for(int fmt = 1; fmt < m_TextureFormatsInfo.size(); ++fmt)
         m_TextureFormatsInfo[fmt].Supported = true; // We will test every format on a specific hardware device
+
+    if (CreationAttribs.ShaderCacheFilePath != nullptr)
+        m_pShaderCache.reset(new ShaderCache(CreationAttribs.ShaderCacheFilePath));
+
+    if (CreationAttribs.EnableDescriptorSetCache)
+        m_pDescriptorSetCache.reset(new DescriptorSetCache(*this));
+
+    if (CreationAttribs.MemoryDefragmentationBudget != 0)
+        m_pMemoryDefragmenter.reset(new MemoryDefragmenter(*this, CreationAttribs.MemoryDefragmentationBudget));
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
 {
+    // Finish all pending pipeline state initialization tasks as they use the device
+    m_pAsyncPSOPool.reset();
+
+    // Submit pending initial data uploads. This releases staging pages of the batcher
+    m_UploadBatcher.Flush();
+
     // Explicitly destroy dynamic heap. This will move resources owned by 
     // the heap into release queues
     m_DynamicMemoryManager.Destroy();
@@ -150,6 +175,18 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // We must destroy command queues explicitly prior to releasing Vulkan device
     DestroyCommandQueues();
 
+    if (m_pShaderCache)
+    {
+        auto Stats = m_pShaderCache->GetStatistics();
+        LOG_INFO_MESSAGE("Shader cache '", m_pShaderCache->GetFilePath(), "': ", Stats.NumHits, " hits, ", Stats.NumMisses, " misses, ", Stats.NumStores, " new entries");
+    }
+
+    if (m_pDescriptorSetCache)
+    {
+        auto Stats = m_pDescriptorSetCache->GetStatistics();
+        LOG_INFO_MESSAGE("Descriptor set cache: ", Stats.NumHits, " hits, ", Stats.NumMisses, " misses");
+    }
+
     //if(m_PhysicalDevice)
     //{
     //    // If m_PhysicalDevice is empty, the device does not own vulkan logical device and must not
@@ -261,6 +298,10 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
     // Stale objects MUST only be discarded when submitting cmd list from the immediate context
     VERIFY(!pImmediateCtx->IsDeferred(), "Command buffers must be submitted from immediate context only");
 
+    // Resources initialized by the pending uploads may be used by the command buffer,
+    // so the uploads must be submitted to the queue first
+    m_UploadBatcher.Flush();
+
     Uint64 SubmittedFenceValue = 0;
     Uint64 SubmittedCmdBuffNumber = 0;
     SubmitCommandBuffer(QueueIndex, SubmitInfo, SubmittedCmdBuffNumber, SubmittedFenceValue, pSignalFences);
@@ -274,6 +315,7 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(Uint32 QueueIndex, const VkSubmi
 
 void RenderDeviceVkImpl::IdleGPU() 
 { 
+    m_UploadBatcher.Flush();
     IdleCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
@@ -399,6 +441,45 @@ void RenderDeviceVkImpl::CreatePipelineState(const PipelineStateDesc &PipelineDe
 }
 
 
+void RenderDeviceVkImpl::CreatePipelineStateAsync(const PipelineStateDesc& PipelineDesc, IPipelineState** ppPipelineState)
+{
+    CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
+        [&]()
+        {
+            // The base class constructor validates the description on this thread
+            PipelineStateVkImpl *pPipelineStateVk( NEW_RC_OBJ(m_PSOAllocator, "PipelineStateVkImpl instance", PipelineStateVkImpl)(this, PipelineDesc, true ) );
+            pPipelineStateVk->QueryInterface( IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState) );
+            OnCreateDeviceObject( pPipelineStateVk );
+
+            {
+                std::lock_guard<std::mutex> Lock(m_AsyncPSOPoolMtx);
+                if (!m_pAsyncPSOPool)
+                {
+                    auto NumThreads = m_EngineAttribs.NumAsyncPipelineThreads;
+                    if (NumThreads == 0)
+                        NumThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+                    m_pAsyncPSOPool.reset(new ThreadingTools::ThreadPool(NumThreads));
+                }
+            }
+
+            // The task keeps the object alive until the initialization is complete
+            RefCntAutoPtr<PipelineStateVkImpl> pPSO(pPipelineStateVk);
+            m_pAsyncPSOPool->EnqueueTask(
+                [pPSO]() mutable
+                {
+                    pPSO->InitializeDeferred();
+                }
+            );
+        } 
+    );
+}
+
+void RenderDeviceVkImpl::FlushPendingUploads()
+{
+    m_UploadBatcher.Flush();
+}
+
+
 void RenderDeviceVkImpl :: CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, IBuffer** ppBuffer)
 {
     CreateDeviceObject("buffer", BuffDesc, ppBuffer, 
@@ -413,6 +494,32 @@ void RenderDeviceVkImpl :: CreateBufferFromVulkanResource(VkBuffer vkBuffer, con
 }
 
 
+void RenderDeviceVkImpl :: GetPipelineCacheData(IDataBlob** ppData)
+{
+    DEV_CHECK_ERR(ppData != nullptr, "Null pointer provided");
+    if (ppData == nullptr)
+        return;
+    *ppData = nullptr;
+
+    auto Data = m_PipelineCache.GetData();
+    if (Data.empty())
+    {
+        LOG_ERROR_MESSAGE("Failed to retrieve pipeline cache data");
+        return;
+    }
+
+    auto* pDataBlob = MakeNewRCObj<DataBlobImpl>()(Data.size());
+    memcpy(pDataBlob->GetDataPtr(), Data.data(), Data.size());
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
+
+bool RenderDeviceVkImpl :: MergePipelineCacheData(const void* pData, size_t DataSize)
+{
+    return m_PipelineCache.Merge(pData, DataSize);
+}
+
+
 void RenderDeviceVkImpl :: CreateBuffer(const BufferDesc& BuffDesc, const BufferData &BuffData, IBuffer **ppBuffer)
 {
     CreateDeviceObject("buffer", BuffDesc, ppBuffer, 
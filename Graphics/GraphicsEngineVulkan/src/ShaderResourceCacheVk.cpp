@@ -389,4 +389,58 @@ Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContextVkImpl *pCtxV
     return OffsetInd;
 }
 
+void ShaderResourceCacheVk::DescriptorSet::GetResourceIds(std::vector<UniqueIdentifier>& ResourceIds)const
+{
+    ResourceIds.clear();
+    ResourceIds.reserve(m_NumResources);
+    for (Uint32 res = 0; res < m_NumResources; ++res)
+    {
+        const auto& Res = m_pResources[res];
+        if (!Res.pObject)
+        {
+            // Unbound resources and immutable samplers
+            ResourceIds.push_back(0);
+            continue;
+        }
+
+        switch (Res.Type)
+        {
+            case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                ResourceIds.push_back(Res.pObject.RawPtr<const BufferVkImpl>()->GetUniqueID());
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::StorageBuffer:
+            case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                ResourceIds.push_back(Res.pObject.RawPtr<const BufferViewVkImpl>()->GetUniqueID());
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+            {
+                // Combined image sampler descriptor also references the sampler assigned to the view
+                const auto* pTexViewVk = Res.pObject.RawPtr<const TextureViewVkImpl>();
+                ResourceIds.push_back(pTexViewVk->GetUniqueID());
+                const auto* pSamplerVk = ValidatedCast<const SamplerVkImpl>(pTexViewVk->GetSampler());
+                ResourceIds.push_back(pSamplerVk != nullptr ? pSamplerVk->GetUniqueID() : 0);
+            }
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+                ResourceIds.push_back(Res.pObject.RawPtr<const TextureViewVkImpl>()->GetUniqueID());
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                ResourceIds.push_back(Res.pObject.RawPtr<const SamplerVkImpl>()->GetUniqueID());
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::AtomicCounter:
+                ResourceIds.push_back(0);
+            break;
+
+            default: UNEXPECTED("Unexpected resource type");
+        }
+    }
+}
+
 }
@@ -40,7 +40,8 @@ namespace Diligent
 ShaderResourceLayoutVk::ShaderResourceLayoutVk(IObject&                                    Owner, 
                                                const VulkanUtilities::VulkanLogicalDevice& LogicalDevice) :
     m_Owner(Owner),
-    m_LogicalDevice(LogicalDevice)
+    m_LogicalDevice(LogicalDevice),
+    m_NameIndex(GetRawAllocator())
 {
 }
 
@@ -92,6 +93,11 @@ void ShaderResourceLayoutVk::AllocateMemory(std::shared_ptr<const SPIRVShaderRes
     m_ResourceBuffer = std::unique_ptr<void, STDDeleterRawMem<void> >(pRawMem, Allocator);
 }
 
+void ShaderResourceLayoutVk::InitializeNameIndex()
+{
+    m_NameIndex.Initialize(GetTotalResourceCount(), [&](Uint32 r){ return GetResource(r).SpirvAttribs.Name; });
+}
+
 void ShaderResourceLayoutVk::InitializeStaticResourceLayout(std::shared_ptr<const SPIRVShaderResources> pSrcResources,
                                                             IMemoryAllocator&                           LayoutDataAllocator,
                                                             ShaderResourceCacheVk&                      StaticResourceCache)
@@ -121,6 +127,8 @@ void ShaderResourceLayoutVk::InitializeStaticResourceLayout(std::shared_ptr<cons
     }
 #endif
 
+    InitializeNameIndex();
+
     StaticResourceCache.InitializeSets(GetRawAllocator(), 1, &StaticResCacheSize);
     InitializeResourceMemoryInCache(StaticResourceCache);
 }
@@ -269,6 +277,9 @@ void ShaderResourceLayoutVk::Initialize(Uint32 NumShaders,
         }
     }
 #endif
+
+    for (Uint32 s = 0; s < NumShaders; ++s)
+        Layouts[s].InitializeNameIndex();
 }
 
 #define LOG_RESOURCE_BINDING_ERROR(ResType, pResource, VarName, ShaderName, ...)\
@@ -512,13 +523,15 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject *pObj, Uint3
     VERIFY_EXPR(ArrayIndex < SpirvAttribs.ArraySize);
 
     auto &DstDescrSet = ResourceCache.GetDescriptorSet(DescriptorSet);
-    auto vkDescrSet = DstDescrSet.GetVkDescriptorSet();
+    // Shared descriptor sets may be used by other SRBs and must never be written. Descriptors of a 
+    // shared set are written once by PipelineStateVkImpl::AssignSharedDescriptorSet() when the set is created.
+    auto vkDescrSet = DstDescrSet.UsesSharedSet() ? VK_NULL_HANDLE : DstDescrSet.GetVkDescriptorSet();
 #ifdef _DEBUG
     if (ResourceCache.DbgGetContentType() == ShaderResourceCacheVk::DbgCacheContentType::SRBResources)
     {
         if(SpirvAttribs.VarType == SHADER_VARIABLE_TYPE_STATIC || SpirvAttribs.VarType == SHADER_VARIABLE_TYPE_MUTABLE)
         {
-            VERIFY(vkDescrSet != VK_NULL_HANDLE, "Static and mutable variables must have valid vulkan descriptor set assigned");
+            VERIFY(vkDescrSet != VK_NULL_HANDLE || DstDescrSet.UsesSharedSet(), "Static and mutable variables must have valid vulkan descriptor set assigned");
             // Dynamic variables do not have vulkan descriptor set only until they are assigned one the first time
         }
     }
@@ -533,6 +546,7 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject *pObj, Uint3
 #endif
     auto &DstRes = DstDescrSet.GetResource(CacheOffset + ArrayIndex);
     VERIFY(DstRes.Type == SpirvAttribs.Type, "Inconsistent types");
+    const IDeviceObject* pPrevObject = DstRes.pObject;
 
     if( pObj )
     {
@@ -582,6 +596,13 @@ void ShaderResourceLayoutVk::VkResource::BindResource(IDeviceObject *pObj, Uint3
 
         DstRes.pObject.Release();
     }
+
+    if (DstDescrSet.UsesSharedSet() && DstRes.pObject.RawPtr() != pPrevObject)
+    {
+        // The content of the set has changed, so the SRB can no longer use the
+        // same shared set. A new one will be assigned when the SRB is committed.
+        DstDescrSet.ReleaseSharedSet();
+    }
 }
 
 bool ShaderResourceLayoutVk::VkResource::IsBound(Uint32 ArrayIndex, const ShaderResourceCacheVk& ResourceCache)const
@@ -670,7 +691,8 @@ void ShaderResourceLayoutVk::dvpVerifyBindings(const ShaderResourceCacheVk& Reso
                 {
                     if (VarType == SHADER_VARIABLE_TYPE_STATIC || VarType == SHADER_VARIABLE_TYPE_MUTABLE)
                     {
-                        VERIFY(vkDescSet != VK_NULL_HANDLE, "Static and mutable variables must have valid vulkan descriptor set assigned");
+                        // Shared descriptor set is only assigned after the bindings are verified
+                        VERIFY(vkDescSet != VK_NULL_HANDLE || CachedDescrSet.UsesSharedSet(), "Static and mutable variables must have valid vulkan descriptor set assigned");
                     }
                     else if (VarType == SHADER_VARIABLE_TYPE_DYNAMIC )
                     {
@@ -895,4 +917,77 @@ void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk&
     }
 }
 
+void ShaderResourceLayoutVk::GetStaticAndMutableDescriptorWrites(const ShaderResourceCacheVk& ResourceCache,
+                                                                 VkDescriptorSet              vkDescriptorSet,
+                                                                 DescriptorWriteBatch&        Batch)const
+{
+    VERIFY_EXPR(vkDescriptorSet != VK_NULL_HANDLE);
+    static_assert(SHADER_VARIABLE_TYPE_STATIC == 0 && SHADER_VARIABLE_TYPE_MUTABLE == 1, "Static and mutable resources are expected to go first in the layout");
+    const Uint32 NumResources = m_NumResources[SHADER_VARIABLE_TYPE_STATIC] + m_NumResources[SHADER_VARIABLE_TYPE_MUTABLE];
+
+    for (Uint32 r = 0; r < NumResources; ++r)
+    {
+        const auto& Res = GetResource(r);
+        VERIFY_EXPR(Res.SpirvAttribs.VarType == SHADER_VARIABLE_TYPE_STATIC || Res.SpirvAttribs.VarType == SHADER_VARIABLE_TYPE_MUTABLE);
+        if (Res.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::AtomicCounter ||
+           (Res.SpirvAttribs.Type == SPIRVShaderResourceAttribs::ResourceType::SeparateSampler && Res.SpirvAttribs.StaticSamplerInd >= 0))
+        {
+            // Immutable samplers are permanently bound into the set layout (13.2.1)
+            continue;
+        }
+
+        const auto& SetResources = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
+        for (Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = SetResources.GetResource(Res.CacheOffset + ArrElem);
+            if (!CachedRes.pObject)
+                continue; // Unbound resources are reported by dvpVerifyBindings()
+
+            VkWriteDescriptorSet WriteDescrSet = {};
+            WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            WriteDescrSet.pNext           = nullptr;
+            WriteDescrSet.dstSet          = vkDescriptorSet;
+            WriteDescrSet.dstBinding      = Res.Binding;
+            WriteDescrSet.dstArrayElement = ArrElem;
+            WriteDescrSet.descriptorCount = 1;
+            WriteDescrSet.descriptorType  = PipelineLayout::GetVkDescriptorType(Res.SpirvAttribs);
+
+            switch (Res.SpirvAttribs.Type)
+            {
+                case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                    Batch.DescrBuffInfos.push_back(CachedRes.GetUniformBufferDescriptorWriteInfo());
+                    WriteDescrSet.pBufferInfo = &Batch.DescrBuffInfos.back();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::StorageBuffer:
+                    Batch.DescrBuffInfos.push_back(CachedRes.GetStorageBufferDescriptorWriteInfo());
+                    WriteDescrSet.pBufferInfo = &Batch.DescrBuffInfos.back();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                    Batch.DescrBuffViews.push_back(CachedRes.GetBufferViewWriteInfo());
+                    WriteDescrSet.pTexelBufferView = &Batch.DescrBuffViews.back();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+                case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+                case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                    Batch.DescrImgInfos.push_back(CachedRes.GetImageDescriptorWriteInfo(Res.SpirvAttribs.StaticSamplerInd >= 0));
+                    WriteDescrSet.pImageInfo = &Batch.DescrImgInfos.back();
+                break;
+
+                case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                    Batch.DescrImgInfos.push_back(CachedRes.GetSamplerDescriptorWriteInfo());
+                    WriteDescrSet.pImageInfo = &Batch.DescrImgInfos.back();
+                break;
+
+                default:
+                    UNEXPECTED("Unexpected resource type");
+            }
+            Batch.WriteDescrSets.push_back(WriteDescrSet);
+        }
+    }
+}
+
 }
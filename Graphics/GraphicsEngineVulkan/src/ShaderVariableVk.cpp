@@ -57,6 +57,7 @@ void ShaderVariableManagerVk::Initialize(const ShaderResourceLayoutVk& SrcLayout
 #endif
 
     const Uint32 AllowedTypeBits = GetAllowedTypeBits(AllowedVarTypes, NumAllowedTypes);
+    m_AllowedTypeBits = AllowedTypeBits;
     VERIFY_EXPR(m_NumVariables == 0);
     auto MemSize = GetRequiredMemorySize(SrcLayout, AllowedVarTypes, NumAllowedTypes, m_NumVariables);
     
@@ -103,18 +104,27 @@ void ShaderVariableManagerVk::Destroy(IMemoryAllocator &Allocator)
 
 ShaderVariableVkImpl* ShaderVariableManagerVk::GetVariable(const Char* Name)
 {
-    ShaderVariableVkImpl* pVar = nullptr;
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
+    if (m_NumVariables == 0)
+        return nullptr;
+
+    const auto& Layout = *m_pResourceLayout;
+    auto ResIndex = Layout.FindResource(Name);
+    if (ResIndex == ShaderVariableNameIndex::InvalidIndex)
+        return nullptr;
+
+    auto VarType = Layout.GetResource(ResIndex).SpirvAttribs.VarType;
+    if (!IsAllowedType(VarType, m_AllowedTypeBits))
+        return nullptr;
+
+    // Variables of every allowed type are created in the same order as 
+    // the resources of this type are stored in the layout
+    Uint32 VarInd = ResIndex - Layout.GetResourceOffset(VarType, 0);
+    for(SHADER_VARIABLE_TYPE t = SHADER_VARIABLE_TYPE_STATIC; t < VarType; t = static_cast<SHADER_VARIABLE_TYPE>(t+1))
     {
-        auto &Var = m_pVariables[v];
-        const auto& Res = Var.m_Resource;
-        if (strcmp(Res.SpirvAttribs.Name, Name) == 0)
-        {
-            pVar = &Var;
-            break;
-        }
+        VarInd += IsAllowedType(t, m_AllowedTypeBits) ? Layout.GetResourceCount(t) : 0;
     }
-    return pVar;
+    VERIFY_EXPR(VarInd < m_NumVariables && &m_pVariables[VarInd].m_Resource == &Layout.GetResource(ResIndex));
+    return m_pVariables + VarInd;
 }
 
 
@@ -162,6 +172,7 @@ void ShaderVariableManagerVk::BindResources( IResourceMapping* pResourceMapping,
     if ( (Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0 )
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    const auto& Layout = *m_pResourceLayout;
     for(Uint32 v=0; v < m_NumVariables; ++v)
     {
         auto &Var = m_pVariables[v];
@@ -174,6 +185,7 @@ void ShaderVariableManagerVk::BindResources( IResourceMapping* pResourceMapping,
         if ( (Flags & (1 << Res.SpirvAttribs.VarType)) == 0 )
             continue;
 
+        const auto NameHash = Layout.GetResourceNameHash(Layout.GetResourceIndex(Res));
         for(Uint32 ArrInd = 0; ArrInd < Res.SpirvAttribs.ArraySize; ++ArrInd)
         {
             if( (Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) && Res.IsBound(ArrInd, *m_pResourceCache) )
@@ -181,7 +193,7 @@ void ShaderVariableManagerVk::BindResources( IResourceMapping* pResourceMapping,
 
             const auto* VarName = Res.SpirvAttribs.Name;
             RefCntAutoPtr<IDeviceObject> pObj;
-            pResourceMapping->GetResource( VarName, &pObj, ArrInd );
+            GetResourceFromMapping( pResourceMapping, VarName, NameHash, ArrInd, &pObj );
             if( pObj )
             {
                 Res.BindResource(pObj, ArrInd, *m_pResourceCache);
@@ -27,7 +27,6 @@
 #include "ShaderVkImpl.h"
 #include "RenderDeviceVkImpl.h"
 #include "DataBlobImpl.h"
-#include "GLSLSourceBuilder.h"
 #include "GLSL2SPIRV.h"
 
 using namespace Diligent;
@@ -42,11 +41,24 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl*
     m_StaticResCache(ShaderResourceCacheVk::DbgCacheContentType::StaticShaderResources),
     m_StaticVarsMgr(*this)
 {
-    auto GLSLSource = BuildGLSLSourceString(CreationAttribs, TargetGLSLCompiler::glslang, "#define TARGET_API_VULKAN 1\n");
-    m_SPIRV = GLSLtoSPIRV(m_Desc.ShaderType, GLSLSource.c_str(), CreationAttribs.ppCompilerOutput);
-    if (m_SPIRV.empty())
+    if (CreationAttribs.ByteCode != nullptr)
     {
-        LOG_ERROR_AND_THROW("Failed to compile shader");
+        // Precompiled SPIR-V
+        constexpr Uint32 SPIRVMagicNumber = 0x07230203;
+        const auto* pWords = reinterpret_cast<const Uint32*>(CreationAttribs.ByteCode);
+        if (CreationAttribs.ByteCodeSize < sizeof(Uint32) || CreationAttribs.ByteCodeSize % sizeof(Uint32) != 0 || pWords[0] != SPIRVMagicNumber)
+        {
+            LOG_ERROR_AND_THROW("Byte code of shader '", (m_Desc.Name ? m_Desc.Name : ""), "' is not valid SPIR-V");
+        }
+        m_SPIRV.assign(pWords, pWords + CreationAttribs.ByteCodeSize / sizeof(Uint32));
+    }
+    else
+    {
+        m_SPIRV = BuildSPIRV(CreationAttribs, pRenderDeviceVk->GetShaderCache());
+        if (m_SPIRV.empty())
+        {
+            LOG_ERROR_AND_THROW("Failed to compile shader");
+        }
     }
 
     // We cannot create shader module here because resource bindings are assigned when
@@ -55,7 +67,39 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl*
     // Load shader resources
     auto &Allocator = GetRawAllocator();
     auto *pRawMem = ALLOCATE(Allocator, "Allocator for ShaderResources", sizeof(SPIRVShaderResources));
-    auto *pResources = new (pRawMem) SPIRVShaderResources(Allocator, pRenderDeviceVk, m_SPIRV, m_Desc);
+    SPIRVShaderResources* pResources = nullptr;
+
+    // Reflection data only depends on the SPIR-V binary, so it is cached to avoid parsing 
+    // SPIR-V with spirv_cross every time the shader is created
+    auto* pCache = pRenderDeviceVk->GetShaderCache();
+    ShaderCache::Key ReflectionKey;
+    if (pCache != nullptr)
+    {
+        ReflectionKey = SPIRVShaderResources::GetReflectionCacheKey(m_SPIRV);
+        std::vector<Uint8> ReflectionData;
+        if (pCache->Find(ReflectionKey, ReflectionData))
+        {
+            try
+            {
+                pResources = new (pRawMem) SPIRVShaderResources(Allocator, pRenderDeviceVk, ReflectionData.data(), ReflectionData.size(), m_Desc);
+            }
+            catch(const std::runtime_error&)
+            {
+                LOG_WARNING_MESSAGE("Failed to load cached resources of shader '", m_Desc.Name, "'. Resources will be reflected from SPIR-V");
+            }
+        }
+    }
+
+    if (pResources == nullptr)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources(Allocator, pRenderDeviceVk, m_SPIRV, m_Desc);
+        if (pCache != nullptr)
+        {
+            std::vector<Uint8> ReflectionData;
+            pResources->SerializeReflection(ReflectionData);
+            pCache->Store(ReflectionKey, ReflectionData.data(), ReflectionData.size());
+        }
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
     m_StaticResLayout.InitializeStaticResourceLayout(m_pShaderResources, GetRawAllocator(), m_StaticResCache);
@@ -162,11 +162,10 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
 
     
     // Vulkan validation layers do not like uninitialized memory, so if no initial data
-    // is provided, we will clear the memory
-
-    VulkanUtilities::CommandPoolWrapper CmdPool;
-    VkCommandBuffer vkCmdBuff;
-    pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
+    // is provided, we will clear the memory.
+    // Initialization commands are recorded into the shared transient command buffer of the upload 
+    // batcher, which submits it before the immediate context submits any command buffer that may 
+    // use this texture.
 
     VkImageAspectFlags aspectMask = 0;
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
@@ -190,8 +189,9 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
     SubresRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
     SubresRange.baseMipLevel = 0;
     SubresRange.levelCount = VK_REMAINING_MIP_LEVELS;
-    VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, m_CurrentLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
+    const auto InitialLayout = m_CurrentLayout;
     m_CurrentLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    VkImage vkImage = m_VulkanImage;
 
     if(bInitializeTexture)
     {
@@ -256,128 +256,108 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
         }
         VERIFY_EXPR(subres == InitData.NumSubresources);
 
-        VkBufferCreateInfo VkStaginBuffCI = {};
-        VkStaginBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        VkStaginBuffCI.pNext = nullptr;
-        VkStaginBuffCI.flags = 0;
-        VkStaginBuffCI.size = uploadBufferSize;
-        VkStaginBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        VkStaginBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        VkStaginBuffCI.queueFamilyIndexCount = 0;
-        VkStaginBuffCI.pQueueFamilyIndices = nullptr;
-
-        std::string StagingBufferName = "Staging buffer for '";
-        StagingBufferName += m_Desc.Name;
-        StagingBufferName += '\'';
-        VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
-
-        VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-        VERIFY( IsPowerOfTwo(StagingBufferMemReqs.alignment), "Alignment is not power of 2!");
-        // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges 
-        // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-        // to the host (10.2)
-        auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        auto StagingBufferMemory = StagingMemoryAllocation.Page->GetVkMemory();
-        auto AlignedStagingMemOffset = Align(StagingMemoryAllocation.UnalignedOffset, StagingBufferMemReqs.alignment);
-        VERIFY_EXPR(StagingMemoryAllocation.Size >= StagingBufferMemReqs.size + (AlignedStagingMemOffset - StagingMemoryAllocation.UnalignedOffset));
-
-        auto *StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-        VERIFY_EXPR(StagingData != nullptr);
-        StagingData += AlignedStagingMemOffset;
-
-        subres = 0;
-        for(Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
-        {
-            for(Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
+        const auto& DeviceLimits = pRenderDeviceVk->GetPhysicalDevice().GetProperties().limits;
+        // Source buffer offset must be multiple of 4 (18.4)
+        auto StagingAlignment = std::max(DeviceLimits.optimalBufferCopyOffsetAlignment, VkDeviceSize{4});
+        pRenderDeviceVk->GetUploadBatcher().Enqueue(uploadBufferSize, StagingAlignment,
+            [&](VkCommandBuffer vkCmdBuff, const VulkanUploadAllocation& StagingAllocation)
             {
-                const auto &SubResData = InitData.pSubResources[subres];
-                const auto &CopyRegion = Regions[subres];
+                auto* StagingData = reinterpret_cast<uint8_t*>(StagingAllocation.CPUAddress);
+                VERIFY_EXPR(StagingData != nullptr);
 
-                auto MipWidth  = CopyRegion.imageExtent.width;
-                auto MipHeight = CopyRegion.imageExtent.height;
-                auto MipDepth  = CopyRegion.imageExtent.depth;
-                Uint32 RowSize = 0;
-                if(FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+                subres = 0;
+                for(Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
                 {
-                    VERIFY_EXPR(FmtAttribs.BlockWidth > 1 && FmtAttribs.BlockHeight > 1);
-                    MipWidth  = (MipWidth  + FmtAttribs.BlockWidth -1) / FmtAttribs.BlockWidth;
-                    MipHeight = (MipHeight + FmtAttribs.BlockHeight-1) / FmtAttribs.BlockHeight;
-                    RowSize   = MipWidth * Uint32{FmtAttribs.ComponentSize}; // ComponentSize is the block size
-                }
-                else
-                {
-                    RowSize = MipWidth * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
-                }
-                VERIFY(SubResData.Stride == 0 || SubResData.Stride >= RowSize, "Stride is too small");
-                VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= RowSize * MipHeight, "Depth stride is too small");
-
-                for(Uint32 z=0; z < MipDepth; ++z)
-                {
-                    for(Uint32 y=0; y < MipHeight; ++y)
+                    for(Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
                     {
-                        memcpy(StagingData + CopyRegion.bufferOffset + (y + z * MipHeight) * RowSize,
-                               reinterpret_cast<const uint8_t*>(SubResData.pData) + y * SubResData.Stride + z * SubResData.DepthStride,
-                               RowSize);
+                        const auto &SubResData = InitData.pSubResources[subres];
+                        const auto &CopyRegion = Regions[subres];
+
+                        auto MipWidth  = CopyRegion.imageExtent.width;
+                        auto MipHeight = CopyRegion.imageExtent.height;
+                        auto MipDepth  = CopyRegion.imageExtent.depth;
+                        Uint32 RowSize = 0;
+                        if(FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+                        {
+                            VERIFY_EXPR(FmtAttribs.BlockWidth > 1 && FmtAttribs.BlockHeight > 1);
+                            MipWidth  = (MipWidth  + FmtAttribs.BlockWidth -1) / FmtAttribs.BlockWidth;
+                            MipHeight = (MipHeight + FmtAttribs.BlockHeight-1) / FmtAttribs.BlockHeight;
+                            RowSize   = MipWidth * Uint32{FmtAttribs.ComponentSize}; // ComponentSize is the block size
+                        }
+                        else
+                        {
+                            RowSize = MipWidth * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+                        }
+                        VERIFY(SubResData.Stride == 0 || SubResData.Stride >= RowSize, "Stride is too small");
+                        VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= RowSize * MipHeight, "Depth stride is too small");
+
+                        for(Uint32 z=0; z < MipDepth; ++z)
+                        {
+                            for(Uint32 y=0; y < MipHeight; ++y)
+                            {
+                                memcpy(StagingData + CopyRegion.bufferOffset + (y + z * MipHeight) * RowSize,
+                                       reinterpret_cast<const uint8_t*>(SubResData.pData) + y * SubResData.Stride + z * SubResData.DepthStride,
+                                       RowSize);
+                            }
+                        }
+               
+                        ++subres;
                     }
                 }
-               
-                ++subres;
-            }
-        }
-        VERIFY_EXPR(subres == InitData.NumSubresources);
+                VERIFY_EXPR(subres == InitData.NumSubresources);
 
-        err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+                // Region offsets are relative to the start of the staging allocation
+                for (auto& CopyRegion : Regions)
+                    CopyRegion.bufferOffset += StagingAllocation.AlignedOffset;
 
-        VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
+                VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, vkImage, InitialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
+                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingAllocation.vkBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
 
-        // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-        // as copy will be the only command in the cmd buffer
-        vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-            m_CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-            static_cast<uint32_t>(Regions.size()), Regions.data());
-
-        Uint32 QueueIndex = 0;
-	    pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
-
-        // After command buffer is submitted, safe-release resources. This strategy
-        // is little overconservative as the resources will be released after the first
-        // command buffer submitted through the immediate context will be completed
-        pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer),           Uint64{1} << Uint64{QueueIndex});
-        pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{QueueIndex});
+                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                // as the transient command buffer only contains copy commands
+                vkCmdCopyBufferToImage(vkCmdBuff, StagingAllocation.vkBuffer, vkImage,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                    static_cast<uint32_t>(Regions.size()), Regions.data());
+            }
+        );
     }
     else
     {
-        VkImageSubresourceRange Subresource;
-        Subresource.aspectMask     = aspectMask;
-        Subresource.baseMipLevel   = 0;
-        Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
-        Subresource.baseArrayLayer = 0;
-        Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-        if(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
-        {
-            if(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+        pRenderDeviceVk->GetUploadBatcher().Enqueue(0, 0,
+            [&](VkCommandBuffer vkCmdBuff, const VulkanUploadAllocation&)
             {
-                VkClearColorValue ClearColor = {};
-                vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
-                                m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                &ClearColor, 1, &Subresource);
+                VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, vkImage, InitialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
+
+                VkImageSubresourceRange Subresource;
+                Subresource.aspectMask     = aspectMask;
+                Subresource.baseMipLevel   = 0;
+                Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
+                Subresource.baseArrayLayer = 0;
+                Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+                if(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+                {
+                    if(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                    {
+                        VkClearColorValue ClearColor = {};
+                        vkCmdClearColorImage(vkCmdBuff, vkImage,
+                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                        &ClearColor, 1, &Subresource);
+                    }
+                }
+                else if(aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT || 
+                        aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+                {
+                    VkClearDepthStencilValue ClearValue = {};
+                    vkCmdClearDepthStencilImage(vkCmdBuff, vkImage,
+                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                    &ClearValue, 1, &Subresource);
+                }
+                else
+                {
+                    UNEXPECTED("Unexpected aspect mask");
+                }
             }
-        }
-        else if(aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT || 
-                aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
-        {
-            VkClearDepthStencilValue ClearValue = {};
-            vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
-                            m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                            &ClearValue, 1, &Subresource);
-        }
-        else
-        {
-            UNEXPECTED("Unexpected aspect mask");
-        }
-        Uint32 QueueIndex = 0;
-        pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(QueueIndex, vkCmdBuff, std::move(CmdPool));
+        );
     }
 
 
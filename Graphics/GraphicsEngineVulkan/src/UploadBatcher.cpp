@@ -0,0 +1,88 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "UploadBatcher.h"
+#include "RenderDeviceVkImpl.h"
+
+namespace Diligent
+{
+
+UploadBatcher::UploadBatcher(RenderDeviceVkImpl& DeviceVkImpl,
+                             VkDeviceSize        StagingPageSize,
+                             Uint32              MaxPendingUploads,
+                             VkDeviceSize        MaxPendingStagingSize) :
+    m_DeviceVkImpl         (DeviceVkImpl),
+    m_MaxPendingUploads    (std::max(MaxPendingUploads, 1u)),
+    m_MaxPendingStagingSize(MaxPendingStagingSize),
+    m_StagingHeap          (DeviceVkImpl, "Initial data upload heap", StagingPageSize)
+{
+}
+
+UploadBatcher::~UploadBatcher()
+{
+    VERIFY(m_vkCmdBuff == VK_NULL_HANDLE && m_NumPendingUploads == 0, "Upload batcher is destroyed with pending uploads. Flush() must be called first");
+    if (m_Stats.NumUploads != 0)
+        LOG_INFO_MESSAGE("Initial data uploads: ", m_Stats.NumUploads, " resources in ", m_Stats.NumSubmits, (m_Stats.NumSubmits == 1 ? " submit" : " submits"));
+}
+
+VkCommandBuffer UploadBatcher::GetCmdBuffer()
+{
+    if (m_vkCmdBuff == VK_NULL_HANDLE)
+        m_DeviceVkImpl.AllocateTransientCmdPool(m_CmdPool, m_vkCmdBuff, "Transient command pool to upload initial resource data");
+    return m_vkCmdBuff;
+}
+
+void UploadBatcher::FlushLocked()
+{
+    if (m_vkCmdBuff == VK_NULL_HANDLE)
+        return;
+
+    Uint32 QueueIndex = 0;
+    m_DeviceVkImpl.ExecuteAndDisposeTransientCmdBuff(QueueIndex, m_vkCmdBuff, std::move(m_CmdPool));
+    m_vkCmdBuff = VK_NULL_HANDLE;
+
+    // After the command buffer is submitted, safe-release staging pages. The pages are
+    // only released after the next command buffer submitted through the immediate context 
+    // is complete (see comments in BufferVkImpl constructor)
+    m_StagingHeap.ReleaseAllocatedPages(Uint64{1} << Uint64{QueueIndex});
+
+    m_NumPendingUploads  = 0;
+    m_PendingStagingSize = 0;
+    ++m_Stats.NumSubmits;
+}
+
+void UploadBatcher::Flush()
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    FlushLocked();
+}
+
+UploadBatcher::Statistics UploadBatcher::GetStatistics()
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    return m_Stats;
+}
+
+}
@@ -39,46 +39,11 @@ VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
 
 VulkanUploadHeap::~VulkanUploadHeap()
 {
-    DEV_CHECK_ERR(m_Pages.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
+    DEV_CHECK_ERR(m_Pages.empty() && m_LargeChunks.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize), " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
-                                 " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)") );
-}
-
-VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes)const
-{
-    VkBufferCreateInfo StagingBufferCI = {};
-    StagingBufferCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    StagingBufferCI.pNext                 = nullptr;
-    StagingBufferCI.flags                 = 0; // VK_BUFFER_CREATE_SPARSE_BINDING_BIT, VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, VK_BUFFER_CREATE_SPARSE_ALIASED_BIT
-    StagingBufferCI.size                  = SizeInBytes;
-    StagingBufferCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    StagingBufferCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-    StagingBufferCI.queueFamilyIndexCount = 0;
-    StagingBufferCI.pQueueFamilyIndices   = nullptr;
-
-    const auto& LogicalDevice  = m_RenderDevice.GetLogicalDevice();
-    const auto& PhysicalDevice = m_RenderDevice.GetPhysicalDevice();
-    auto& GlobalMemoryMgr = m_RenderDevice.GetGlobalMemoryManager();
-
-    auto NewBuffer = LogicalDevice.CreateBuffer(StagingBufferCI, "Upload buffer");
-    auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(NewBuffer);
-    auto MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    DEV_CHECK_ERR(MemoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
-           "Vulkan spec requires that for a VkBuffer not created with the VK_BUFFER_CREATE_SPARSE_BINDING_BIT "
-           "bit set, or for a VkImage that was created with a VK_IMAGE_TILING_LINEAR value in the tiling member "
-           "of the VkImageCreateInfo structure passed to vkCreateImage, the memoryTypeBits member always contains "
-           "at least one bit set corresponding to a VkMemoryType with a propertyFlags that has both the "
-           "VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT bit AND the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit set. (11.6)");
-
-    auto MemAllocation = GlobalMemoryMgr.Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, true);
-
-    auto AlignedOffset = (MemAllocation.UnalignedOffset + (MemReqs.alignment-1)) & ~(MemReqs.alignment-1);
-    auto err = LogicalDevice.BindBufferMemory(NewBuffer, MemAllocation.Page->GetVkMemory(), AlignedOffset);
-    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to bind buffer memory");
-    auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
-
-    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress};
+                                 " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"),
+                                 ". Recycled pages: ", m_NumRecycledPages, " / ", m_NumPoolPages);
 }
 
 VulkanUploadAllocation VulkanUploadHeap::Allocate(size_t SizeInBytes, size_t Alignment)
@@ -89,22 +54,26 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(size_t SizeInBytes, size_t Ali
     if(SizeInBytes >= m_PageSize/2)
     {
         // Allocate large chunk directly from the memory manager
-        auto NewPage = CreateNewPage(SizeInBytes);
+        auto NewPage = m_RenderDevice.GetUploadPagePool().CreatePage(SizeInBytes);
         Allocation.vkBuffer   = NewPage.Buffer;
         Allocation.CPUAddress = NewPage.CPUAddress;
         Allocation.Size       = SizeInBytes;
         VERIFY(Alignment < SizeInBytes, "Alignment must be smaller than the page size");
         Allocation.AlignedOffset = 0;
         m_CurrAllocatedSize      += NewPage.MemAllocation.Size;
-        m_Pages.emplace_back(std::move(NewPage));
+        m_LargeChunks.emplace_back(std::move(NewPage));
     }
     else
     {
         auto AlignmentOffset = Align(m_CurrPage.CurrOffset, Alignment) - m_CurrPage.CurrOffset;
         if(m_CurrPage.AvailableSize < SizeInBytes + AlignmentOffset)
         {
-            // Allocate new page
-            auto NewPage = CreateNewPage(m_PageSize);
+            // Get new page from the pool
+            bool IsRecycled = false;
+            auto NewPage = m_RenderDevice.GetUploadPagePool().GetPage(m_PageSize, &IsRecycled);
+            ++m_NumPoolPages;
+            if (IsRecycled)
+                ++m_NumRecycledPages;
             m_CurrPage.Reset(NewPage, m_PageSize);
             m_CurrAllocatedSize += NewPage.MemAllocation.Size;
             m_Pages.emplace_back(std::move(NewPage));
@@ -132,13 +101,20 @@ void VulkanUploadHeap::ReleaseAllocatedPages(Uint64 CmdQueueMask)
 {
     // The pages will go into the stale resources queue first, however they will move into the release
     // queue rightaway when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame()
+    auto& PagePool = m_RenderDevice.GetUploadPagePool();
     for (auto& Page : m_Pages)
     {
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer),        CmdQueueMask);
+        PagePool.DisposePage(std::move(Page), CmdQueueMask);
+    }
+
+    for (auto& Chunk : m_LargeChunks)
+    {
+        m_RenderDevice.SafeReleaseDeviceObject(std::move(Chunk.MemAllocation), CmdQueueMask);
+        m_RenderDevice.SafeReleaseDeviceObject(std::move(Chunk.Buffer),        CmdQueueMask);
     }
 
     m_Pages.clear();
+    m_LargeChunks.clear();
 
     m_CurrPage = CurrPageInfo{};
     m_CurrFrameSize     = 0;
@@ -0,0 +1,206 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include <algorithm>
+#include "VulkanUploadPagePool.h"
+#include "RenderDeviceVkImpl.h"
+
+namespace Diligent
+{
+
+VulkanUploadPagePool::VulkanUploadPagePool(RenderDeviceVkImpl& DeviceVkImpl) :
+    m_DeviceVkImpl(DeviceVkImpl)
+{
+}
+
+VulkanUploadPagePool::~VulkanUploadPagePool()
+{
+    DEV_CHECK_ERR(m_Stats.UsedPagesSize == 0, "All upload pages must have been returned to the pool");
+    if (m_Stats.NumPagesCreated != 0)
+    {
+        LOG_INFO_MESSAGE("Upload page pool: created ", m_Stats.NumPagesCreated, (m_Stats.NumPagesCreated == 1 ? " page, " : " pages, "),
+                         "recycled ", m_Stats.NumPagesRecycled, ", trimmed ", m_Stats.NumPagesDestroyed, ". High-water mark: ", FormatMemorySize(m_Stats.HighWaterMark, 2));
+    }
+}
+
+VulkanUploadPage VulkanUploadPagePool::CreatePage(VkDeviceSize PageSize)const
+{
+    VkBufferCreateInfo StagingBufferCI = {};
+    StagingBufferCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    StagingBufferCI.pNext                 = nullptr;
+    StagingBufferCI.flags                 = 0; // VK_BUFFER_CREATE_SPARSE_BINDING_BIT, VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, VK_BUFFER_CREATE_SPARSE_ALIASED_BIT
+    StagingBufferCI.size                  = PageSize;
+    StagingBufferCI.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    StagingBufferCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    StagingBufferCI.queueFamilyIndexCount = 0;
+    StagingBufferCI.pQueueFamilyIndices   = nullptr;
+
+    const auto& LogicalDevice  = m_DeviceVkImpl.GetLogicalDevice();
+    const auto& PhysicalDevice = m_DeviceVkImpl.GetPhysicalDevice();
+    auto& GlobalMemoryMgr = m_DeviceVkImpl.GetGlobalMemoryManager();
+
+    auto NewBuffer = LogicalDevice.CreateBuffer(StagingBufferCI, "Upload buffer");
+    auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(NewBuffer);
+    auto MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    DEV_CHECK_ERR(MemoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
+           "Vulkan spec requires that for a VkBuffer not created with the VK_BUFFER_CREATE_SPARSE_BINDING_BIT "
+           "bit set, or for a VkImage that was created with a VK_IMAGE_TILING_LINEAR value in the tiling member "
+           "of the VkImageCreateInfo structure passed to vkCreateImage, the memoryTypeBits member always contains "
+           "at least one bit set corresponding to a VkMemoryType with a propertyFlags that has both the "
+           "VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT bit AND the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit set. (11.6)");
+
+    auto MemAllocation = GlobalMemoryMgr.Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, true);
+
+    auto AlignedOffset = (MemAllocation.UnalignedOffset + (MemReqs.alignment-1)) & ~(MemReqs.alignment-1);
+    auto err = LogicalDevice.BindBufferMemory(NewBuffer, MemAllocation.Page->GetVkMemory(), AlignedOffset);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to bind buffer memory");
+    auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
+
+    return VulkanUploadPage{std::move(MemAllocation), std::move(NewBuffer), CPUAddress, PageSize};
+}
+
+VulkanUploadPage VulkanUploadPagePool::GetPage(VkDeviceSize PageSize, bool* pIsRecycled)
+{
+    {
+        std::lock_guard<std::mutex> Lock(m_Mtx);
+
+        m_Stats.UsedPagesSize += PageSize;
+        m_CurrWindowPeakSize = std::max(m_CurrWindowPeakSize, m_Stats.UsedPagesSize);
+
+        auto it = m_FreePages.find(PageSize);
+        if (it != m_FreePages.end() && !it->second.empty())
+        {
+            auto Page = std::move(it->second.back());
+            it->second.pop_back();
+            --m_Stats.NumFreePages;
+            m_Stats.FreePagesSize -= PageSize;
+            ++m_Stats.NumPagesRecycled;
+            if (pIsRecycled != nullptr)
+                *pIsRecycled = true;
+            return Page;
+        }
+
+        ++m_Stats.NumPagesCreated;
+    }
+
+    // Create the page without holding the lock
+    if (pIsRecycled != nullptr)
+        *pIsRecycled = false;
+    return CreatePage(PageSize);
+}
+
+void VulkanUploadPagePool::DisposePage(VulkanUploadPage&& Page, Uint64 QueueMask)
+{
+    class UploadPageDeleter
+    {
+    public:
+        UploadPageDeleter(VulkanUploadPagePool& _Pool,
+                          VulkanUploadPage&&    _Page) noexcept : 
+            Pool (&_Pool),
+            Page (std::move(_Page))
+        {}
+
+        UploadPageDeleter             (const UploadPageDeleter&) = delete;
+        UploadPageDeleter& operator = (const UploadPageDeleter&) = delete;
+        UploadPageDeleter& operator = (      UploadPageDeleter&&)= delete;
+
+        UploadPageDeleter(UploadPageDeleter&& rhs)noexcept : 
+            Pool (rhs.Pool),
+            Page (std::move(rhs.Page))
+        {
+            rhs.Pool = nullptr;
+        }
+
+        ~UploadPageDeleter()
+        {
+            if (Pool != nullptr)
+            {
+                Pool->FreePage(std::move(Page));
+            }
+        }
+
+    private:
+        VulkanUploadPagePool* Pool;
+        VulkanUploadPage      Page;
+    };
+
+    VERIFY_EXPR(Page.Buffer != VK_NULL_HANDLE);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(UploadPageDeleter{*this, std::move(Page)}, QueueMask);
+}
+
+void VulkanUploadPagePool::FreePage(VulkanUploadPage&& Page)
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    VERIFY(m_Stats.UsedPagesSize >= Page.Size, "Used pages size is less than the size of the returned page");
+    m_Stats.UsedPagesSize -= Page.Size;
+    ++m_Stats.NumFreePages;
+    m_Stats.FreePagesSize += Page.Size;
+    auto PageSize = Page.Size;
+    m_FreePages[PageSize].emplace_back(std::move(Page));
+}
+
+void VulkanUploadPagePool::Trim()
+{
+    // Pages are destroyed after the lock is released
+    std::vector<VulkanUploadPage> StalePages;
+
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+
+    if (++m_FramesInWindow == TrimWindow)
+    {
+        m_PrevWindowPeakSize = m_CurrWindowPeakSize;
+        m_CurrWindowPeakSize = m_Stats.UsedPagesSize;
+        m_FramesInWindow     = 0;
+    }
+    m_Stats.HighWaterMark = std::max(m_PrevWindowPeakSize, m_CurrWindowPeakSize);
+    VERIFY_EXPR(m_Stats.UsedPagesSize <= m_Stats.HighWaterMark);
+
+    // Free pages are only needed to cover the used size up to the high-water mark
+    for (auto it = m_FreePages.begin(); it != m_FreePages.end() && m_Stats.UsedPagesSize + m_Stats.FreePagesSize > m_Stats.HighWaterMark; )
+    {
+        auto& Pages = it->second;
+        while (!Pages.empty() && m_Stats.UsedPagesSize + m_Stats.FreePagesSize > m_Stats.HighWaterMark)
+        {
+            m_Stats.FreePagesSize -= Pages.back().Size;
+            --m_Stats.NumFreePages;
+            ++m_Stats.NumPagesDestroyed;
+            StalePages.emplace_back(std::move(Pages.back()));
+            Pages.pop_back();
+        }
+
+        if (Pages.empty())
+            it = m_FreePages.erase(it);
+        else
+            ++it;
+    }
+}
+
+VulkanUploadPagePool::Statistics VulkanUploadPagePool::GetStatistics()
+{
+    std::lock_guard<std::mutex> Lock(m_Mtx);
+    return m_Stats;
+}
+
+}
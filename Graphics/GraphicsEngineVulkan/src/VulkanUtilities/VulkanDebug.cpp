@@ -291,6 +291,11 @@ namespace VulkanUtilities
         SetObjectName(device, (uint64_t)_event, VK_DEBUG_REPORT_OBJECT_TYPE_EVENT_EXT, name);
     }
 
+    void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char * name)
+    {
+        SetObjectName(device, (uint64_t)pipelineCache, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_CACHE_EXT, name);
+    }
+
 
 
 
@@ -393,6 +398,11 @@ namespace VulkanUtilities
     {
         SetEventName(device, _event, name);
     }
+
+    void SetVulkanObjectName(VkDevice device, VkPipelineCache pipelineCache, const char * name)
+    {
+        SetPipelineCacheName(device, pipelineCache, name);
+    }
     
 
 
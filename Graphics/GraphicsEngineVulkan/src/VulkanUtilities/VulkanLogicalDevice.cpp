@@ -239,6 +239,12 @@ namespace VulkanUtilities
         return CreateVulkanObject<VkSemaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "semaphore");
     }
 
+    PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo &PipelineCacheCI, const char* DebugName)const
+    {
+        VERIFY_EXPR(PipelineCacheCI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+        return CreateVulkanObject<VkPipelineCache>(vkCreatePipelineCache, PipelineCacheCI, DebugName, "pipeline cache");
+    }
+
     VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName)const
     {
         VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -371,6 +377,12 @@ namespace VulkanUtilities
         Semaphore.m_VkObject = VK_NULL_HANDLE;
     }
 
+    void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache)const
+    {
+        vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+        PipelineCache.m_VkObject = VK_NULL_HANDLE;
+    }
+
 
     void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const
     {
@@ -450,4 +462,23 @@ namespace VulkanUtilities
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset descriptor pool");
         return err;
     }
+
+    VkResult VulkanLogicalDevice::GetPipelineCacheData(VkPipelineCache pipelineCache,
+                                                       size_t*         pDataSize,
+                                                       void*           pData)const
+    {
+        // VK_INCOMPLETE is returned if pDataSize is less than the size of the cache data
+        auto err = vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+        DEV_CHECK_ERR(err == VK_SUCCESS || err == VK_INCOMPLETE, "Failed to get pipeline cache data");
+        return err;
+    }
+
+    VkResult VulkanLogicalDevice::MergePipelineCaches(VkPipelineCache        dstCache,
+                                                      uint32_t               srcCacheCount,
+                                                      const VkPipelineCache* pSrcCaches)const
+    {
+        auto err = vkMergePipelineCaches(m_VkDevice, dstCache, srcCacheCount, pSrcCaches);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to merge pipeline caches");
+        return err;
+    }
 }
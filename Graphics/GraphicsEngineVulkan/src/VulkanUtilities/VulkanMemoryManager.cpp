@@ -39,8 +39,11 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
 VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
                                    VkDeviceSize         PageSize, 
                                    uint32_t             MemoryTypeIndex,
-                                   bool                 IsHostVisible)noexcept : 
+                                   bool                 IsHostVisible,
+                                   bool                 IsDedicated)noexcept : 
     m_ParentMemoryMgr(ParentMemoryMgr),
+    m_MemoryTypeIndex(MemoryTypeIndex),
+    m_IsDedicated    (IsDedicated),
     m_AllocationMgr(PageSize, ParentMemoryMgr.m_Allocator)
 {
     VkMemoryAllocateInfo MemAlloc = {};
@@ -49,7 +52,7 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
     MemAlloc.allocationSize = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(IsDedicated ? "Dedicated device memory page. Size: " : "Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -91,12 +94,29 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     }
 }
 
-void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
+VkDeviceSize VulkanMemoryPage::GetFreeSize()
 {
-    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
     std::lock_guard<std::mutex> Lock(m_Mutex);
-    m_AllocationMgr.Free(Allocation.UnalignedOffset, Allocation.Size);
-    Allocation = VulkanMemoryAllocation{};
+    return m_AllocationMgr.GetFreeSize();
+}
+
+void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
+{
+    // The page may be destroyed by ShrinkMemory() as soon as the mutex is released,
+    // so all data required to notify the manager must be read beforehand
+    auto  Size          = Allocation.Size;
+    auto& ParentMemMgr  = m_ParentMemoryMgr;
+    bool  IsHostVisible = m_CPUMemory != nullptr;
+    auto  MemTypeIndex  = m_MemoryTypeIndex;
+    bool  IsDedicated   = m_IsDedicated;
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_AllocationMgr.Free(Allocation.UnalignedOffset, Allocation.Size);
+        Allocation = VulkanMemoryAllocation{};
+    }
+    // Notify the manager after the memory has been released, so that the 
+    // free space index refreshed by the manager includes this allocation
+    ParentMemMgr.OnFreeAllocation(Size, IsHostVisible, MemTypeIndex, IsDedicated);
 }
 
 VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps)
@@ -131,79 +151,175 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible);
 }
 
+VulkanMemoryPage& VulkanMemoryManager::CreatePage(VkDeviceSize PageSize, uint32_t MemoryTypeIndex, bool HostVisible, bool IsDedicated)
+{
+    size_t stat_ind = HostVisible ? 1 : 0;
+    m_CurrAllocatedSize[stat_ind] += PageSize;
+    m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+
+    auto& MemTypePages = m_MemoryTypes[MemoryTypeIndex];
+    MemTypePages.Pages.emplace_back(std::unique_ptr<VulkanMemoryPage>{new VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, IsDedicated}});
+    auto& NewPage = *MemTypePages.Pages.back();
+    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"), (IsDedicated ? " dedicated" : ""),
+                     " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex, 
+                     "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
+    OnNewPageCreated(NewPage);
+    return NewPage;
+}
+
 VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible)
 {
+    VERIFY_EXPR(MemoryTypeIndex < m_MemoryTypes.size());
     VulkanMemoryAllocation Allocation;
 
     std::lock_guard<std::mutex> Lock(m_PagesMtx);
-    auto range = m_Pages.equal_range(MemoryTypeIndex);
-    for(auto page_it = range.first; page_it != range.second; ++page_it)
+    auto& MemTypePages = m_MemoryTypes[MemoryTypeIndex];
+
+    if (m_DedicatedAllocationThreshold != 0 && Size >= m_DedicatedAllocationThreshold)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        // Large resources get their own page, so that they do not fragment shared pages and their 
+        // memory is returned to the system once they are released. The page size is a multiple of 
+        // the alignment, so the allocation always fits at offset 0.
+        auto& DedicatedPage = CreatePage(Diligent::Align(Size, Alignment), MemoryTypeIndex, HostVisible, true);
+        Allocation = DedicatedPage.Allocate(Size, Alignment);
     }
-
-    size_t stat_ind = HostVisible ? 1 : 0;
-    if (Allocation.Page == nullptr)
+    else
     {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
-
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
-
-        auto it = m_Pages.emplace(MemoryTypeIndex, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"), 
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex, 
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
-        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        auto& FreeSpaceIndex = MemTypePages.FreeSpaceIndex;
+        auto TryAllocate = [&](VulkanMemoryPage& Page)
+        {
+            Allocation = Page.Allocate(Size, Alignment);
+            return Allocation.Size;
+        };
+
+        // The index underestimates free space of pages where allocations have been released since 
+        // it was last refreshed. Refreshing requires locking every page, so it is only done when 
+        // the index fails to find a page, before a new one is created, and once per frame in ShrinkMemory().
+        if (FreeSpaceIndex.Allocate(Size, TryAllocate) == nullptr && RefreshFreeSpaceIndex(MemoryTypeIndex))
+            FreeSpaceIndex.Allocate(Size, TryAllocate);
+
+        if (Allocation.Page == nullptr)
+        {
+            auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+            while (PageSize < Size)
+                PageSize *= 2;
+
+            auto& NewPage = CreatePage(PageSize, MemoryTypeIndex, HostVisible, false);
+            Allocation = NewPage.Allocate(Size, Alignment);
+            FreeSpaceIndex.AddPage(&NewPage, PageSize - Allocation.Size);
+        }
     }
+    DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate memory from a new memory page");
 
     if (Allocation.Page != nullptr)
     {
         VERIFY_EXPR(Size + Diligent::Align(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
     }
 
+    size_t stat_ind = HostVisible ? 1 : 0;
     m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
     m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
 
     return Allocation;
 }
 
+bool VulkanMemoryManager::RefreshFreeSpaceIndex(uint32_t MemoryTypeIndex)
+{
+    const uint32_t TypeBit = 1u << MemoryTypeIndex;
+    if ((m_StaleIndexMask.fetch_and(~TypeBit) & TypeBit) == 0)
+        return false;
+
+    m_MemoryTypes[MemoryTypeIndex].FreeSpaceIndex.Refresh([](VulkanMemoryPage& Page){ return Page.GetFreeSize(); });
+    return true;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateInDenserPage(VkDeviceSize Size, VkDeviceSize Alignment, VulkanMemoryPage& SrcPage)
+{
+    VERIFY(!SrcPage.IsDedicated(), "Allocations in dedicated pages are not expected to be moved");
+    VulkanMemoryAllocation Allocation;
+    const auto MemoryTypeIndex = SrcPage.GetMemoryTypeIndex();
+    const bool HostVisible     = SrcPage.GetCPUMemory() != nullptr;
+
+    std::lock_guard<std::mutex> Lock(m_PagesMtx);
+    // Free space must be up to date to compare pages
+    RefreshFreeSpaceIndex(MemoryTypeIndex);
+    const auto SrcFreeSize = SrcPage.GetFreeSize();
+    m_MemoryTypes[MemoryTypeIndex].FreeSpaceIndex.Allocate(Size,
+        [&](VulkanMemoryPage& Page) -> VkDeviceSize
+        {
+            if (&Page == &SrcPage || Page.GetFreeSize() >= SrcFreeSize)
+                return 0;
+            Allocation = Page.Allocate(Size, Alignment);
+            return Allocation.Size;
+        }
+    );
+
+    if (Allocation.Page != nullptr)
+    {
+        size_t stat_ind = HostVisible ? 1 : 0;
+        m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
+        m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    }
+
+    return Allocation;
+}
+
+VkDeviceSize VulkanMemoryManager::GetSizeOverReserve(bool HostVisible)
+{
+    std::lock_guard<std::mutex> Lock(m_PagesMtx);
+    const auto CurrAllocatedSize = m_CurrAllocatedSize[HostVisible ? 1 : 0];
+    const auto ReserveSize       = HostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+    return CurrAllocatedSize > ReserveSize ? CurrAllocatedSize - ReserveSize : 0;
+}
+
 void VulkanMemoryManager::ShrinkMemory()
 {
     std::lock_guard<std::mutex> Lock(m_PagesMtx);
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+    for (uint32_t MemoryTypeIndex = 0; MemoryTypeIndex < m_MemoryTypes.size(); ++MemoryTypeIndex)
+        RefreshFreeSpaceIndex(MemoryTypeIndex);
+
+    bool HasReleasedDedicatedPages = m_NumReleasedDedicatedPages.load() > 0;
+    if (!HasReleasedDedicatedPages && m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
         return;
 
-    auto it = m_Pages.begin();
-    while (it != m_Pages.end())
+    for (auto& MemTypePages : m_MemoryTypes)
     {
-        auto curr_it = it;
-        ++it;
-        auto& Page = curr_it->second;
-        bool IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto ReserveSize = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto& Pages = MemTypePages.Pages;
+        for (size_t i = 0; i < Pages.size(); )
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"), 
-                             " page (", Diligent::FormatMemorySize(PageSize, 2), ")."
-                             " Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+            auto& Page = *Pages[i];
+            bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+            auto ReserveSize = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+            // Dedicated pages are created for a single allocation, so they are not kept in the reserve
+            if (Page.GetFreeSize() == Page.GetPageSize() && (Page.IsDedicated() || m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize))
+            {
+                auto PageSize = Page.GetPageSize();
+                m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
+                LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"), (Page.IsDedicated() ? " dedicated" : ""),
+                                 " page (", Diligent::FormatMemorySize(PageSize, 2), ")."
+                                 " Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+                OnPageDestroy(Page);
+                if (Page.IsDedicated())
+                    m_NumReleasedDedicatedPages.fetch_add(-1);
+                else
+                    MemTypePages.FreeSpaceIndex.RemovePage(&Page);
+                // Page order is not important
+                std::swap(Pages[i], Pages.back());
+                Pages.pop_back();
+            }
+            else
+                ++i;
         }
     }
 }
 
-void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
+void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble, uint32_t MemoryTypeIndex, bool IsDedicated)
 {
     m_CurrUsedSize[IsHostVisble ? 1 : 0].fetch_add( -static_cast<int64_t>(Size) );
+    if (IsDedicated)
+        m_NumReleasedDedicatedPages.fetch_add(1);
+    else
+        m_StaleIndexMask.fetch_or(1u << MemoryTypeIndex);
 }
 
 VulkanMemoryManager::~VulkanMemoryManager()
@@ -221,8 +337,11 @@ VulkanMemoryManager::~VulkanMemoryManager()
                      " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)")
         );
     
-    for(auto it=m_Pages.begin(); it != m_Pages.end(); ++it )
-        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    for (const auto& MemTypePages : m_MemoryTypes)
+    {
+        for (const auto& Page : MemTypePages.Pages)
+            VERIFY(Page->IsEmpty(), "The page contains outstanding allocations");
+    }
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
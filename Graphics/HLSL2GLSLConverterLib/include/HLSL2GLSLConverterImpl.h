@@ -23,7 +23,6 @@
 
 #pragma once
 
-#include <list>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -33,7 +32,7 @@
 #include "HLSLKeywords.h"
 #include "Shader.h"
 #include "HashUtils.h"
-#include "HLSLKeywords.h"
+#include "TokenArena.h"
 
 namespace Diligent
 {
@@ -90,6 +89,11 @@ namespace Diligent
     {
     public:
         static const HLSL2GLSLConverterImpl& GetInstance();
+
+        // Revision of the converter. It must be incremented whenever the converter 
+        // output changes, which invalidates converted shaders stored in shader caches.
+        static constexpr Uint32 Revision = 1;
+
         struct ConversionAttribs
         {
             IShaderSourceInputStreamFactory *pSourceStreamFactory = nullptr;
@@ -110,6 +114,10 @@ namespace Diligent
                           size_t NumSymbols, 
                           IHLSL2GLSLConversionStream **ppStream)const;
 
+        /// Replaces #include directives in the source with the contents of the included files.
+        /// Every file is included only once.
+        static void InsertIncludes(String &Source, IShaderSourceInputStreamFactory* pSourceStreamFactory);
+
     private:
         HLSL2GLSLConverterImpl();
 
@@ -187,8 +195,9 @@ namespace Diligent
         struct TokenInfo
         {
             TokenType Type;
-            String Literal;
-            String Delimiter;
+            // Token strings are allocated in the string pool of the conversion stream
+            TokenString Literal;
+            TokenString Delimiter;
             bool IsBuiltInType()const
             {
                 static_assert( static_cast<int>(TokenType::kw_bool) == 1 && static_cast<int>(TokenType::kw_void) == 191, 
@@ -201,15 +210,15 @@ namespace Diligent
                                 "If you updated control flow keywords, double check that all keywords are defined between break and while");
                 return Type >= TokenType::kw_break && Type <= TokenType::kw_while;
             }
-            TokenInfo( TokenType _Type = TokenType :: Undefined,
-                        const Char* _Literal = "",
-                        const Char* _Delimiter = "" ) : 
+            TokenInfo( TokenType          _Type = TokenType :: Undefined,
+                       const TokenString& _Literal = TokenString(),
+                       const TokenString& _Delimiter = TokenString() ) : 
                 Type( _Type ),
                 Literal( _Literal ),
                 Delimiter(_Delimiter)
             {}
         };
-        typedef std::list<TokenInfo> TokenListType;
+        typedef TokenList<TokenInfo> TokenListType;
 
         
         class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -231,12 +240,11 @@ namespace Diligent
 
             const String& GetInputFileName()const{ return m_InputFileName; }
         private:
-            void InsertIncludes(String &GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
             void Tokenize(const String &Source);
 
             typedef std::unordered_map<String, bool> SamplerHashType;
 
-            const HLSLObjectInfo *FindHLSLObject(const String &Name );
+            const HLSLObjectInfo *FindHLSLObject(const TokenString &Name );
 
             void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
@@ -386,6 +394,19 @@ namespace Diligent
 
             String BuildGLSLSource();
 
+            // Creates a new token and allocates its literal and delimiter in the string pool
+            TokenInfo CreateToken(TokenType Type, const Char* Literal, const Char* Delimiter = "")
+            {
+                return TokenInfo(Type, m_Strings.Add(Literal), m_Strings.Add(Delimiter));
+            }
+            TokenInfo CreateToken(TokenType Type, const Char* Literal, const TokenString& Delimiter)
+            {
+                return TokenInfo(Type, m_Strings.Add(Literal), Delimiter);
+            }
+
+            // Storage for literals and delimiters of all tokens
+            TokenStringPool m_Strings;
+
             // Tokenized source code
             TokenListType m_Tokens;
 
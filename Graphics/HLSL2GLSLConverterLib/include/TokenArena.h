@@ -0,0 +1,455 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TokenString, Diligent::TokenStringPool and Diligent::TokenList classes
+
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <iterator>
+#include <ostream>
+
+#include "BasicTypes.h"
+#include "MemoryAllocator.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+    /// Non-owning view of a null-terminated string stored in a Diligent::TokenStringPool
+
+    /// The view is trivially copyable, so copying a token list never copies the strings.
+    /// Strings cannot be modified in place: every new value must be allocated in the pool.
+    class TokenString
+    {
+    public:
+        TokenString() : 
+            m_Str(""),
+            m_Length(0)
+        {}
+
+        TokenString(const Char* Str, size_t Length) : 
+            m_Str(Str),
+            m_Length(static_cast<Uint32>(Length))
+        {
+            VERIFY_EXPR(Str != nullptr && Str[Length] == 0);
+        }
+
+        const Char* c_str() const { return m_Str; }
+        size_t      length()const { return m_Length; }
+        size_t      size()  const { return m_Length; }
+        bool        empty() const { return m_Length == 0; }
+
+        const Char* begin()const { return m_Str; }
+        const Char* end()  const { return m_Str + m_Length; }
+
+        Char operator[](size_t Pos)const
+        {
+            VERIFY_EXPR(Pos < m_Length);
+            return m_Str[Pos];
+        }
+        Char front()const { return (*this)[0]; }
+        Char back() const { return (*this)[m_Length-1]; }
+
+        String str()const { return String(m_Str, m_Length); }
+
+        bool operator == (const TokenString& Str)const
+        {
+            return m_Length == Str.m_Length && (m_Str == Str.m_Str || memcmp(m_Str, Str.m_Str, m_Length) == 0);
+        }
+        bool operator == (const Char* Str)const
+        {
+            return strcmp(m_Str, Str) == 0;
+        }
+        bool operator == (const String& Str)const
+        {
+            return m_Length == Str.length() && memcmp(m_Str, Str.c_str(), m_Length) == 0;
+        }
+        template<typename T>
+        bool operator != (const T& Str)const
+        {
+            return !(*this == Str);
+        }
+
+    private:
+        const Char* m_Str;
+        Uint32      m_Length;
+    };
+
+    inline std::ostream& operator << (std::ostream& Stream, const TokenString& Str)
+    {
+        return Stream.write(Str.c_str(), Str.length());
+    }
+
+    inline String operator + (const TokenString& Str1, const Char* Str2){ return Str1.str().append(Str2); }
+    inline String operator + (const TokenString& Str1, Char Str2)       { return Str1.str().append(1, Str2); }
+
+
+    /// Paged storage for token strings
+
+    /// Strings are packed into large pages and are released together when the pool is destroyed.
+    /// Empty and single-character strings, which make up the majority of tokens, are not 
+    /// stored in the pool at all.
+    /// 
+    /// The pool can be rolled back to the previously saved state, which releases all strings 
+    /// allocated after the state was obtained, but keeps the pages for reuse.
+    class TokenStringPool
+    {
+    public:
+        TokenStringPool(IMemoryAllocator& Allocator, size_t PageSize = 64 << 10) : 
+            m_Allocator(Allocator),
+            m_PageSize(PageSize)
+        {}
+
+        TokenStringPool             (const TokenStringPool&) = delete;
+        TokenStringPool             (TokenStringPool&&)      = delete;
+        TokenStringPool& operator = (const TokenStringPool&) = delete;
+        TokenStringPool& operator = (TokenStringPool&&)      = delete;
+
+        ~TokenStringPool()
+        {
+            for (auto& Page : m_Pages)
+                m_Allocator.Free(Page.pData);
+        }
+
+        TokenString Add(const Char* Str, size_t Length)
+        {
+            if (Length <= 1)
+            {
+                static const SingleCharStrings Strings;
+                return TokenString(Strings.Get(Length == 1 ? Str[0] : 0), Length);
+            }
+
+            auto* pDst = Allocate(Length + 1);
+            memcpy(pDst, Str, Length);
+            pDst[Length] = 0;
+            return TokenString(pDst, Length);
+        }
+
+        TokenString Add(const Char* Str)   { return Add(Str, strlen(Str)); }
+        TokenString Add(const String& Str) { return Add(Str.c_str(), Str.length()); }
+
+        TokenString Concat(const TokenString& Str1, const TokenString& Str2)
+        {
+            if (Str1.empty())
+                return Str2;
+            if (Str2.empty())
+                return Str1;
+
+            auto Length = Str1.length() + Str2.length();
+            auto* pDst = Allocate(Length + 1);
+            memcpy(pDst, Str1.c_str(), Str1.length());
+            memcpy(pDst + Str1.length(), Str2.c_str(), Str2.length());
+            pDst[Length] = 0;
+            return TokenString(pDst, Length);
+        }
+        TokenString Concat(const TokenString& Str1, const Char* Str2)
+        {
+            return Concat(Str1, Add(Str2));
+        }
+
+        struct State
+        {
+            size_t Page   = 0;
+            size_t Offset = 0;
+        };
+        State GetState()const
+        {
+            State CurrState;
+            CurrState.Page   = m_CurrPage;
+            CurrState.Offset = m_CurrOffset;
+            return CurrState;
+        }
+        
+        /// Releases all strings allocated after the state was obtained
+        void Restore(const State& SavedState)
+        {
+            VERIFY_EXPR(SavedState.Page < m_CurrPage || SavedState.Page == m_CurrPage && SavedState.Offset <= m_CurrOffset);
+            m_CurrPage   = SavedState.Page;
+            m_CurrOffset = SavedState.Offset;
+        }
+
+        size_t GetNumPages()const { return m_Pages.size(); }
+
+    private:
+        Char* Allocate(size_t Size)
+        {
+            // Find the first page starting from the current one that has enough space.
+            // Pages after the current one can only be present if the pool has been rolled back.
+            while (m_CurrPage < m_Pages.size() && m_CurrOffset + Size > m_Pages[m_CurrPage].Size)
+            {
+                ++m_CurrPage;
+                m_CurrOffset = 0;
+            }
+
+            if (m_CurrPage == m_Pages.size())
+            {
+                PageInfo NewPage;
+                NewPage.Size  = std::max(m_PageSize, Size);
+                NewPage.pData = reinterpret_cast<Char*>(m_Allocator.Allocate(NewPage.Size, "Memory page for token strings", __FILE__, __LINE__));
+                m_Pages.push_back(NewPage);
+            }
+
+            auto* Ptr = m_Pages[m_CurrPage].pData + m_CurrOffset;
+            m_CurrOffset += Size;
+            return Ptr;
+        }
+
+        struct SingleCharStrings
+        {
+            SingleCharStrings()
+            {
+                for (int c = 0; c < 256; ++c)
+                {
+                    Strings[c][0] = static_cast<Char>(c);
+                    Strings[c][1] = 0;
+                }
+            }
+            const Char* Get(Char c)const { return Strings[static_cast<unsigned char>(c)]; }
+
+            Char Strings[256][2];
+        };
+
+        struct PageInfo
+        {
+            Char*  pData = nullptr;
+            size_t Size  = 0;
+        };
+        IMemoryAllocator&     m_Allocator;
+        const size_t          m_PageSize;
+        std::vector<PageInfo> m_Pages;
+        size_t                m_CurrPage   = 0;
+        size_t                m_CurrOffset = 0;
+    };
+
+
+    /// Doubly-linked list whose nodes are stored in a contiguous array and are linked by indices
+
+    /// The interface follows std::list, but all nodes are allocated from a single array that grows
+    /// geometrically, and erased nodes are reused by subsequent insertions. Iterators reference 
+    /// nodes by index, so unlike pointers they stay valid when the array is reallocated. 
+    /// If the value type is trivially copyable, copying the list is a single memory copy.
+    template<typename ValueType>
+    class TokenList
+    {
+    private:
+        static constexpr Uint32 EndNode = 0;
+        static constexpr Uint32 InvalidNode = static_cast<Uint32>(-1);
+
+        struct Node
+        {
+            ValueType Value;
+            Uint32    Prev;
+            Uint32    Next;
+        };
+
+    public:
+        using value_type = ValueType;
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type        = ValueType;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = ValueType*;
+            using reference         = ValueType&;
+
+            iterator() {}
+
+            ValueType& operator* ()const { return m_pList->m_Nodes[m_Node].Value; }
+            ValueType* operator->()const { return &m_pList->m_Nodes[m_Node].Value; }
+
+            iterator& operator++()
+            {
+                VERIFY(m_Node != EndNode, "Incrementing end iterator");
+                m_Node = m_pList->m_Nodes[m_Node].Next;
+                return *this;
+            }
+            iterator& operator--()
+            {
+                m_Node = m_pList->m_Nodes[m_Node].Prev;
+                VERIFY(m_Node != EndNode, "Decrementing begin iterator");
+                return *this;
+            }
+            iterator operator++(int) { auto Tmp = *this; ++(*this); return Tmp; }
+            iterator operator--(int) { auto Tmp = *this; --(*this); return Tmp; }
+
+            bool operator == (const iterator& It)const { return m_Node == It.m_Node && m_pList == It.m_pList; }
+            bool operator != (const iterator& It)const { return !(*this == It); }
+
+        private:
+            friend class TokenList;
+            iterator(TokenList* pList, Uint32 Node) : 
+                m_pList(pList),
+                m_Node(Node)
+            {}
+
+            TokenList* m_pList = nullptr;
+            Uint32     m_Node  = InvalidNode;
+        };
+
+        TokenList()
+        {
+            InitEndNode();
+        }
+
+        TokenList(const TokenList& List) : 
+            m_Nodes   (List.m_Nodes),
+            m_FreeList(List.m_FreeList),
+            m_Size    (List.m_Size)
+        {}
+
+        TokenList(TokenList&& List) : 
+            m_Nodes   (std::move(List.m_Nodes)),
+            m_FreeList(List.m_FreeList),
+            m_Size    (List.m_Size)
+        {
+            List.clear();
+        }
+
+        TokenList& operator = (const TokenList& List)
+        {
+            m_Nodes    = List.m_Nodes;
+            m_FreeList = List.m_FreeList;
+            m_Size     = List.m_Size;
+            return *this;
+        }
+
+        TokenList& operator = (TokenList&& List)
+        {
+            m_Nodes    = std::move(List.m_Nodes);
+            m_FreeList = List.m_FreeList;
+            m_Size     = List.m_Size;
+            List.clear();
+            return *this;
+        }
+
+        iterator begin(){ return iterator(this, m_Nodes[EndNode].Next); }
+        iterator end()  { return iterator(this, EndNode); }
+
+        size_t size() const { return m_Size; }
+        bool   empty()const { return m_Size == 0; }
+
+        ValueType& front(){ VERIFY_EXPR(!empty()); return m_Nodes[m_Nodes[EndNode].Next].Value; }
+        ValueType& back() { VERIFY_EXPR(!empty()); return m_Nodes[m_Nodes[EndNode].Prev].Value; }
+
+        void reserve(size_t NumNodes)
+        {
+            m_Nodes.reserve(NumNodes + 1);
+        }
+
+        /// Inserts value before Pos and returns iterator to the new element
+
+        /// The value is taken by copy as it may reference an element of this list,
+        /// which would be invalidated if the node array is reallocated.
+        iterator insert(const iterator& Pos, ValueType Value)
+        {
+            VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+            Uint32 NewNode;
+            if (m_FreeList != InvalidNode)
+            {
+                NewNode = m_FreeList;
+                m_FreeList = m_Nodes[NewNode].Next;
+                m_Nodes[NewNode].Value = Value;
+            }
+            else
+            {
+                NewNode = static_cast<Uint32>(m_Nodes.size());
+                m_Nodes.emplace_back();
+                m_Nodes.back().Value = Value;
+            }
+
+            auto NextNode = Pos.m_Node;
+            auto PrevNode = m_Nodes[NextNode].Prev;
+            m_Nodes[NewNode].Prev  = PrevNode;
+            m_Nodes[NewNode].Next  = NextNode;
+            m_Nodes[PrevNode].Next = NewNode;
+            m_Nodes[NextNode].Prev = NewNode;
+            ++m_Size;
+            return iterator(this, NewNode);
+        }
+
+        void push_back(const ValueType& Value)
+        {
+            insert(end(), Value);
+        }
+
+        /// Removes the element at Pos and returns iterator to the next element
+        iterator erase(const iterator& Pos)
+        {
+            VERIFY(Pos.m_pList == this, "Iterator does not belong to this list");
+            VERIFY(Pos.m_Node != EndNode, "End iterator cannot be erased");
+            auto Node = Pos.m_Node;
+            auto PrevNode = m_Nodes[Node].Prev;
+            auto NextNode = m_Nodes[Node].Next;
+            m_Nodes[PrevNode].Next = NextNode;
+            m_Nodes[NextNode].Prev = PrevNode;
+            m_Nodes[Node].Prev = InvalidNode;
+            m_Nodes[Node].Next = m_FreeList;
+            m_FreeList = Node;
+            --m_Size;
+            return iterator(this, NextNode);
+        }
+
+        /// Removes elements in the range [First, Last) and returns Last
+        iterator erase(iterator First, const iterator& Last)
+        {
+            while (First != Last)
+                First = erase(First);
+            return Last;
+        }
+
+        void clear()
+        {
+            m_Nodes.clear();
+            InitEndNode();
+        }
+
+        void swap(TokenList& List)
+        {
+            std::swap(m_Nodes,    List.m_Nodes);
+            std::swap(m_FreeList, List.m_FreeList);
+            std::swap(m_Size,     List.m_Size);
+        }
+
+    private:
+        void InitEndNode()
+        {
+            // Node 0 is the end node that links the first and the last elements
+            // of the list, so that --end() points to the last element
+            m_Nodes.resize(1);
+            m_Nodes[EndNode].Prev = EndNode;
+            m_Nodes[EndNode].Next = EndNode;
+            m_FreeList = InvalidNode;
+            m_Size     = 0;
+        }
+
+        std::vector<Node> m_Nodes;
+        Uint32            m_FreeList = InvalidNode;
+        size_t            m_Size     = 0;
+    };
+}
@@ -510,7 +510,7 @@ const HLSL2GLSLConverterImpl& HLSL2GLSLConverterImpl::GetInstance()
 HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 {
     // Populate HLSL keywords hash map
-#define DEFINE_KEYWORD(keyword)m_HLSLKeywords.insert( std::make_pair( #keyword, TokenInfo( TokenType::kw_##keyword, #keyword ) ) );
+#define DEFINE_KEYWORD(keyword)m_HLSLKeywords.insert( std::make_pair( #keyword, TokenInfo( TokenType::kw_##keyword, TokenString(#keyword, sizeof(#keyword)-1) ) ) );
     ITERATE_KEYWORDS(DEFINE_KEYWORD)
 #undef DEFINE_KEYWORD
     
@@ -743,7 +743,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 #undef DEFINE_VARIABLE
 }
 
-String CompressNewLines( const String& Str )
+String CompressNewLines( const TokenString& Str )
 {
     String Out;
     auto Char = Str.begin();
@@ -769,7 +769,7 @@ String CompressNewLines( const String& Str )
     return Out;
 }
 
-static Int32 CountNewLines(const String& Str)
+static Int32 CountNewLines(const TokenString& Str)
 {
     Int32 NumNewLines = 0;
     auto Char = Str.begin();
@@ -848,7 +848,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext( IteratorType
     for( ; Token != CurrLineStartToken; ++Token )
     {
         Ctx.append( CompressNewLines(Token->Delimiter) );
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str(), Token->Literal.length());
     }
 
     //\n  if ( x != 0 )
@@ -880,7 +880,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext( IteratorType
             Spaces.append( Token->Literal.length(), ' ' );
 
         Ctx.append( CompressNewLines(Token->Delimiter) );
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str(), Token->Literal.length());
         ++Token;
         
         if( Token == m_Tokens.end() )
@@ -898,7 +898,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext( IteratorType
     while( Token != m_Tokens.end() && NumLinesBelow <= NumAdjacentLines )
     {
         Ctx.append( CompressNewLines(Token->Delimiter) );
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.c_str(), Token->Literal.length());
         ++Token;
 
         if( Token == m_Tokens.end() )
@@ -944,7 +944,7 @@ bool SkipPrefix(const Char* RefStr, IterType &begin, IterType end)
 // all #include directives with the contents of the 
 // file. It maintains a set of already parsed includes
 // to avoid double inclusion
-void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes( String &GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory )
+void HLSL2GLSLConverterImpl::InsertIncludes( String &GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory )
 {
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
@@ -1047,38 +1047,38 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes( String &GLSLSourc
 }
 
 
-void ReadNumericConstant(const String &Source, String::const_iterator &Pos, String &Output)
+void SkipNumericConstant(const String &Source, String::const_iterator &Pos)
 {
-#define COPY_SYMBOL(){ Output.push_back( *(Pos++) ); if( Pos == Source.end() )return; }
+#define SKIP_SYMBOL(){ ++Pos; if( Pos == Source.end() )return; }
 
     while( Pos != Source.end() && *Pos >= '0' && *Pos <= '9' )
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
     if( *Pos == '.' )
     {
-        COPY_SYMBOL()
-        // Copy all numbers
+        SKIP_SYMBOL()
+        // Skip all numbers
         while( Pos != Source.end() && *Pos >= '0' && *Pos <= '9' )
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
     
     // Scientific notation
     // e+1242, E-234
     if( *Pos == 'e' || *Pos == 'E' )
     {
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
         if( *Pos == '+' || *Pos == '-' )
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
 
         // Skip all numbers
         while( Pos != Source.end() && *Pos >= '0' && *Pos <= '9' )
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     if( *Pos == 'f' || *Pos == 'F' )
-        COPY_SYMBOL()
-#undef COPY_SYMBOL
+        SKIP_SYMBOL()
+#undef SKIP_SYMBOL
 }
 
 
@@ -1098,17 +1098,38 @@ do{                                     \
     int OpenBraceCount = 0;
     int OpenStapleCount = 0;
     
+    // Reserve space assuming that a token together with its delimiter
+    // is four symbols long on average
+    m_Tokens.reserve( Source.length() / 4 );
+
     // Push empty node in the beginning of the list to facilitate
     // backwards searching
     m_Tokens.push_back( TokenInfo() );
 
+    // Every literal and delimiter is a contiguous range of the source
+    auto SourceString = [&](String::const_iterator Start, String::const_iterator End)
+    {
+        return m_Strings.Add( Source.c_str() + (Start - Source.begin()), End - Start );
+    };
+    // Appends the next symbol to the literal of the last token. This is only done
+    // when there is no delimiter between the tokens, so the resulting literal
+    // is also a contiguous range of the source
+    auto AppendToLastToken = [&](TokenType Type, String::const_iterator &Pos)
+    {
+        auto &LastToken = m_Tokens.back();
+        LastToken.Type = Type;
+        LastToken.Literal = m_Strings.Concat( LastToken.Literal, SourceString(Pos, Pos+1) );
+        ++Pos;
+    };
+
     // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509638(v=vs.85).aspx
 
     // Notes:
     // * Operators +, - are not detected
     //   * This might be a + b, -a or -10
     // * Operator ?: is not detected
-    auto SrcPos = Source.begin();
+    String Identifier;
+    auto SrcPos = Source.cbegin();
     while( SrcPos != Source.end() )
     {
         TokenInfo NewToken;
@@ -1116,38 +1137,34 @@ do{                                     \
         SkipDelimetersAndComments( Source, SrcPos );
         if( DelimStart != SrcPos )
         {
-            auto DelimSize = SrcPos - DelimStart;
-            NewToken.Delimiter.reserve(DelimSize);
-            NewToken.Delimiter.append(DelimStart, SrcPos);
+            NewToken.Delimiter = SourceString(DelimStart, SrcPos);
         }
         if( SrcPos == Source.end() )
             break;
         
+        auto LiteralStart = SrcPos;
+        auto LiteralEnd = Source.cend();
         switch( *SrcPos )
         {
             case '#':
             {
                 NewToken.Type = TokenType::PreprocessorDirective;
-                auto DirectiveStart = SrcPos;
                 ++SrcPos;
                 SkipDelimetersAndComments( Source, SrcPos );
                 CHECK_END( "Missing preprocessor directive" );
                 SkipIdentifier( Source, SrcPos );
-                auto DirectiveSize = SrcPos - DirectiveStart;
-                NewToken.Literal.reserve(DirectiveSize);
-                NewToken.Literal.append(DirectiveStart, SrcPos);
             }
             break;
 
             case ';':
                 NewToken.Type = TokenType::Semicolon;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case '=':
-                if( m_Tokens.size() > 0 && NewToken.Delimiter == "" )
+                if( m_Tokens.size() > 0 && NewToken.Delimiter.empty() )
                 { 
-                    auto &LastToken = m_Tokens.back();
+                    const auto &LastToken = m_Tokens.back();
                     // +=, -=, *=, /=, %=, <<=, >>=, &=, |=, ^=
                     if( LastToken.Literal == "+" || 
                         LastToken.Literal == "-" || 
@@ -1160,8 +1177,7 @@ do{                                     \
                         LastToken.Literal == "|" ||
                         LastToken.Literal == "^")
                     {
-                        LastToken.Type = TokenType::Assignment;
-                        LastToken.Literal.push_back( *(SrcPos++) );
+                        AppendToLastToken( TokenType::Assignment, SrcPos );
                         continue;
                     }
                     else if( LastToken.Literal == "<" || 
@@ -1169,39 +1185,36 @@ do{                                     \
                              LastToken.Literal == "=" ||
                              LastToken.Literal == "!" )
                     {
-                        LastToken.Type = TokenType::ComparisonOp;
-                        LastToken.Literal.push_back( *(SrcPos++) );
+                        AppendToLastToken( TokenType::ComparisonOp, SrcPos );
                         continue;
                     }
                 }
                 
                 NewToken.Type = TokenType::Assignment;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case '|':
             case '&':
-                if( m_Tokens.size() > 0 && NewToken.Delimiter == "" && 
+                if( m_Tokens.size() > 0 && NewToken.Delimiter.empty() && 
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos )
                 {
-                    m_Tokens.back().Type = TokenType::BooleanOp;
-                    m_Tokens.back().Literal.push_back( *(SrcPos++) );
+                    AppendToLastToken( TokenType::BooleanOp, SrcPos );
                     continue;
                 }
                 else
                 {
                     NewToken.Type = TokenType::BitwiseOp;
-                    NewToken.Literal.push_back( *(SrcPos++) );
+                    ++SrcPos;
                 }
             break;
 
             case '<':
             case '>':
-                if( m_Tokens.size() > 0 && NewToken.Delimiter == "" && 
+                if( m_Tokens.size() > 0 && NewToken.Delimiter.empty() && 
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos )
                 {
-                    m_Tokens.back().Type = TokenType::BitwiseOp;
-                    m_Tokens.back().Literal.push_back( *(SrcPos++) );
+                    AppendToLastToken( TokenType::BitwiseOp, SrcPos );
                     continue;
                 }
                 else
@@ -1210,48 +1223,47 @@ do{                                     \
                     // and template arguments like in Texture2D<float> at this
                     // point. This will be clarified when textures are processed.
                     NewToken.Type = TokenType::ComparisonOp;
-                    NewToken.Literal.push_back( *(SrcPos++) );
+                    ++SrcPos;
                 }
             break;
 
             case '+':
             case '-':
-                if( m_Tokens.size() > 0 && NewToken.Delimiter == "" && 
+                if( m_Tokens.size() > 0 && NewToken.Delimiter.empty() && 
                     m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos )
                 {
-                    m_Tokens.back().Type = TokenType::IncDecOp;
-                    m_Tokens.back().Literal.push_back( *(SrcPos++) );
+                    AppendToLastToken( TokenType::IncDecOp, SrcPos );
                     continue;
                 }
                 else
                 {
                     // We do not currently distinguish between math operator a + b,
                     // unary operator -a and numerical constant -1:
-                    NewToken.Literal.push_back( *(SrcPos++) );
+                    ++SrcPos;
                 }
             break;
             
             case '~':
             case '^':
                 NewToken.Type = TokenType::BitwiseOp;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case '*':
             case '/':
             case '%':
                 NewToken.Type = TokenType::MathOp;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case '!':
                 NewToken.Type = TokenType::BooleanOp;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case ',':
                 NewToken.Type = TokenType::Comma;
-                NewToken.Literal.push_back( *(SrcPos++) );
+                ++SrcPos;
             break;
 
             case '"':
@@ -1259,12 +1271,14 @@ do{                                     \
                 //        ^
                 NewToken.Type = TokenType::SrtingConstant;
                 ++SrcPos;
+                LiteralStart = SrcPos;
                 //[domain("quad")]
                 //         ^
                 while( SrcPos != Source.end() && *SrcPos != '"')
-                    NewToken.Literal.push_back(*(SrcPos++));
+                    ++SrcPos;
                 //[domain("quad")]
                 //             ^
+                LiteralEnd = SrcPos;
                 if(SrcPos != Source.end())
                     ++SrcPos;
                 //[domain("quad")]
@@ -1274,7 +1288,7 @@ do{                                     \
 #define BRACKET_CASE(Symbol, TokenType, Action)\
             case Symbol:                                    \
                 NewToken.Type = TokenType;                  \
-                NewToken.Literal.push_back( *(SrcPos++) );  \
+                ++SrcPos;                                   \
                 Action;                                     \
             break;
             BRACKET_CASE( '(', TokenType::OpenBracket,    ++OpenBracketCount );
@@ -1288,18 +1302,18 @@ do{                                     \
 
             default:
             {
-                auto IdentifierStartPos = SrcPos;
                 SkipIdentifier( Source, SrcPos );
-                if( IdentifierStartPos != SrcPos )
+                if( LiteralStart != SrcPos )
                 {
-                    auto IDSize = SrcPos - IdentifierStartPos;
-                    NewToken.Literal.reserve( IDSize );
-                    NewToken.Literal.append( IdentifierStartPos, SrcPos );
-                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
+                    // Keyword table lookup requires null-terminated string
+                    Identifier.assign( LiteralStart, SrcPos );
+                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(Identifier.c_str());
                     if( KeywordIt != m_Converter.m_HLSLKeywords.end() )
                     {
                         NewToken.Type = KeywordIt->second.Type;
-                        VERIFY( NewToken.Literal == KeywordIt->second.Literal, "Inconsistent literal" );
+                        VERIFY( KeywordIt->second.Literal == Identifier, "Inconsistent literal" );
+                        // Keyword literals are static strings that need not be copied
+                        NewToken.Literal = KeywordIt->second.Literal;
                     }
                     else
                     {
@@ -1317,14 +1331,14 @@ do{                                     \
                     }
                     if( bIsNumericalCostant )
                     {
-                        ReadNumericConstant(Source, SrcPos, NewToken.Literal);
+                        SkipNumericConstant(Source, SrcPos);
                         NewToken.Type = TokenType::NumericConstant;
                     }
                 }
 
                 if( NewToken.Type == TokenType::Undefined )
                 {
-                    NewToken.Literal.push_back( *(SrcPos++) );
+                    ++SrcPos;
                 }
                 // Operators
                 // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509631(v=vs.85).aspx
@@ -1332,6 +1346,8 @@ do{                                     \
                 
         }
         
+        if( NewToken.Literal.empty() )
+            NewToken.Literal = SourceString(LiteralStart, LiteralEnd != Source.end() ? LiteralEnd : SrcPos);
         m_Tokens.push_back( NewToken );
     }
 #undef CHECK_END
@@ -1373,7 +1389,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessConstantBuffer( TokenListT
     VERIFY_EXPR( Token->Type == TokenType::kw_cbuffer );
 
     // Replace "cbuffer" with "uniform"
-    Token->Literal = "uniform";
+    Token->Literal = m_Strings.Add("uniform");
     ++Token;
     // cbuffer CBufferName
     //         ^
@@ -1406,7 +1422,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessConstantBuffer( TokenListT
  
     if( Token == m_Tokens.end() || Token->Type != TokenType::Semicolon )
     {
-        m_Tokens.insert( Token, TokenInfo( TokenType::Semicolon, ";" ) );
+        m_Tokens.insert( Token, CreateToken( TokenType::Semicolon, ";" ) );
         // cbuffer CBufferName
         // {                   
         //    ...
@@ -1421,7 +1437,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     // StructuredBuffer<DataType> g_Data;
     // ^
     VERIFY_EXPR( Token->Type == TokenType::kw_StructuredBuffer || Token->Type == TokenType::kw_RWStructuredBuffer );
-    Token->Literal = "layout(std140) buffer";
+    Token->Literal = m_Strings.Add("layout(std140) buffer");
     // buffer<DataType> g_Data;
     // ^
     
@@ -1430,7 +1446,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     //       ^
     VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF after \"StructuredBuffer\" keyword" );
     VERIFY_PARSER_STATE( Token, Token->Literal == "<", "\'<\' expected after \"StructuredBuffer\" keyword" );
-    Token->Literal = "{";
+    Token->Literal = m_Strings.Add("{");
     Token->Type = TokenType::OpenBrace;
     // buffer{DataType> g_Data;
     //       ^
@@ -1455,9 +1471,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF after" );
     VERIFY_PARSER_STATE( Token, Token->Type == TokenType::Identifier, "Identifier expected in Structured Buffer definition" );
     if(Token->Delimiter.empty())
-        Token->Delimiter=" ";
+        Token->Delimiter=m_Strings.Add(" ");
 
-    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal.c_str(), " "));
+    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal, m_Strings.Add(" ")));
     //          OpenBraceToken
     //              V
     // buffer g_Data{DataType g_Data;
@@ -1470,17 +1486,17 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF after" );
     VERIFY_PARSER_STATE( Token, Token->Type == TokenType::Semicolon, "\';\' expected" );
 
-    m_Tokens.insert(Token, TokenInfo(TokenType::OpenStaple, "["));
-    m_Tokens.insert(Token, TokenInfo(TokenType::ClosingStaple, "]"));
-    m_Tokens.insert(Token, TokenInfo(TokenType::Semicolon, ";"));
-    m_Tokens.insert(Token, TokenInfo(TokenType::ClosingBrace, "}"));
+    m_Tokens.insert(Token, CreateToken(TokenType::OpenStaple, "["));
+    m_Tokens.insert(Token, CreateToken(TokenType::ClosingStaple, "]"));
+    m_Tokens.insert(Token, CreateToken(TokenType::Semicolon, ";"));
+    m_Tokens.insert(Token, CreateToken(TokenType::ClosingBrace, "}"));
     // buffer g_Data{DataType g_Data[]};
     //                                 ^
     ++Token;
     String NameRedefine("#define ");
-    NameRedefine += GlobalVarNameToken->Literal + ' ' + GlobalVarNameToken->Literal + "_data\r\n";
-    m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, NameRedefine.c_str(), "\r\n"));
-    GlobalVarNameToken->Literal.append("_data");
+    NameRedefine += GlobalVarNameToken->Literal + ' ' + GlobalVarNameToken->Literal.c_str() + "_data\r\n";
+    m_Tokens.insert(Token, CreateToken(TokenType::TextBlock, NameRedefine.c_str(), "\r\n"));
+    GlobalVarNameToken->Literal = m_Strings.Concat(GlobalVarNameToken->Literal, "_data");
     // buffer g_Data{DataType g_Data_data[]};
     // #define g_Data g_Data_data
     //                           ^
@@ -1601,7 +1617,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseSamplers( TokenListType::ite
                 const auto &SamplerName = Token->Literal;
 
                 // Add sampler state into the hash map
-                SamplersHash.insert( std::make_pair( SamplerName, bIsComparison ) );
+                SamplersHash.insert( std::make_pair( SamplerName.str(), bIsComparison ) );
 
                 ++Token;
                 // SamplerState LinearClamp ;
@@ -1825,13 +1841,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
         {
             // RWTexture2D<float /* format = r32f */ >
             //                                       ^
-            ParseImageFormat( Token->Delimiter, ImgFormat );
+            ParseImageFormat( Token->Delimiter.str(), ImgFormat );
             if( ImgFormat.length() == 0 )
             {
                 // RWTexture2D</* format = r32f */ float >
                 //                                 ^
                 //                            TexFmtToken
-                ParseImageFormat( TexFmtToken->Delimiter, ImgFormat );
+                ParseImageFormat( TexFmtToken->Delimiter.str(), ImgFormat );
             }
 
             if( ImgFormat.length() != 0 )
@@ -1899,7 +1915,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
         // Texture2D<float>Name;
         // There will be no whitespace
         if( Token->Delimiter == "" )
-            Token->Delimiter = " ";
+            Token->Delimiter = m_Strings.Add(" ");
 
         // Texture2D TexName ;
         //           ^
@@ -1927,23 +1943,24 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
         // |
         // Texture2D TexName ;
         //           ^
-        TexDeclToken->Literal = "";
+        String TexDecl;
         if( IsGlobalScope )
         {
             // Use layout qualifier for global variables only, not for function arguments
-            TexDeclToken->Literal.append( LayoutQualifier );
+            TexDecl.append( LayoutQualifier );
             // Samplers and images in global scope must be declared uniform.
             // Function arguments must not be declared uniform
-            TexDeclToken->Literal.append( "uniform " );
+            TexDecl.append( "uniform " );
             // From GLES 3.1 spec:
             //    Except for image variables qualified with the format qualifiers r32f, r32i, and r32ui,
             //    image variables must specify either memory qualifier readonly or the memory qualifier writeonly.
             // So on GLES we have to assume that an image is a writeonly variable
             if(IsRWTexture && ImgFormat != "r32f" && ImgFormat != "r32i" && ImgFormat != "r32ui")
-                TexDeclToken->Literal.append( "IMAGE_WRITEONLY " ); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
+                TexDecl.append( "IMAGE_WRITEONLY " ); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
         }
-        TexDeclToken->Literal.append( CompleteGLSLSampler );
-        Objects.m.insert( std::make_pair( HashMapStringKey(TextureName), HLSLObjectInfo(CompleteGLSLSampler, NumComponents) ) );
+        TexDecl.append( CompleteGLSLSampler );
+        TexDeclToken->Literal = m_Strings.Add(TexDecl);
+        Objects.m.insert( std::make_pair( HashMapStringKey(TextureName.c_str(), true), HLSLObjectInfo(CompleteGLSLSampler, NumComponents) ) );
 
         // In global sceop, multiple variables can be declared in the same statement
         if( IsGlobalScope )
@@ -1959,7 +1976,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
                 // Texture2D TexName, TexName2 ;
                 //                  ^
                 Token->Type = TokenType::Semicolon;
-                Token->Literal = ";";
+                Token->Literal = m_Strings.Add(";");
                 // Texture2D TexName; TexName2 ;
                 //                  ^
                 
@@ -1968,7 +1985,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
                 //                    ^
 
                 // Insert empty token that will contain next sampler/image declaration
-                TexDeclToken = m_Tokens.insert( Token, TokenInfo(TextureDim, "", "\n") );
+                TexDeclToken = m_Tokens.insert( Token, CreateToken(TextureDim, "", "\n") );
                 // Texture2D TexName;
                 // <Texture Declaration TBD> TexName2 ;
                 // ^                         ^
@@ -1991,7 +2008,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration( TokenL
 
 
 // Finds an HLSL object with the given name in object stack
-const HLSL2GLSLConverterImpl::HLSLObjectInfo *HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject( const String &Name )
+const HLSL2GLSLConverterImpl::HLSLObjectInfo *HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject( const TokenString &Name )
 {
     for( auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt )
     {
@@ -2106,7 +2123,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^                    ^
     // IdentifierToken      ArgsListStartToken 
    
-    *ArgsListStartToken = TokenInfo(TokenType::Comma, ",");
+    *ArgsListStartToken = CreateToken(TokenType::Comma, ",");
     // TestTextArr[2].Sample, TestTextArr_sampler, ... 
     //               ^      ^
     //           DotToken  ArgsListStartToken
@@ -2116,14 +2133,14 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^    
     // IdentifierToken
 
-    m_Tokens.insert( IdentifierToken, TokenInfo( TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter.c_str()) );
-    IdentifierToken->Delimiter = " ";
+    m_Tokens.insert( IdentifierToken, CreateToken( TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter) );
+    IdentifierToken->Delimiter = m_Strings.Add(" ");
     // FunctionStub TestTextArr[2], TestTextArr_sampler, ... 
     //              ^    
     //              IdentifierToken
 
 
-    m_Tokens.insert( IdentifierToken, TokenInfo( TokenType::OpenBracket, "(") );
+    m_Tokens.insert( IdentifierToken, CreateToken( TokenType::OpenBracket, "(") );
     // FunctionStub( TestTextArr[2], TestTextArr_sampler, ... 
     //               ^    
     //               IdentifierToken
@@ -2146,8 +2163,9 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
         //                                                            ^    
         //                                                     ArgsListEndToken
 
-        auto SwizzleToken = m_Tokens.insert( ArgsListEndToken, TokenInfo(TokenType::TextBlock, StubIt->second.Swizzle.c_str(), "") );
-        SwizzleToken->Literal.push_back( static_cast<Char>('0' + pObjectInfo->NumComponents) );
+        auto SwizzleToken = m_Tokens.insert( ArgsListEndToken, CreateToken(TokenType::TextBlock, StubIt->second.Swizzle.c_str(), "") );
+        const Char NumComponents[] = {static_cast<Char>('0' + pObjectInfo->NumComponents), 0};
+        SwizzleToken->Literal = m_Strings.Concat(SwizzleToken->Literal, NumComponents);
         // FunctionStub( TestTextArr[2], TestTextArr_sampler, ...    )_SWIZZLE4;
         //                                                                     ^    
         //                                                            ArgsListEndToken
@@ -2269,54 +2287,54 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextureStore( TokenListT
     // ^                                             ^
     // Token                                    SemicolonToken
 
-    m_Tokens.insert( Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter.c_str()) );
-    m_Tokens.insert( Token, TokenInfo(TokenType::OpenBracket, "(", "" ) );
-    Token->Delimiter = " ";
+    m_Tokens.insert( Token, CreateToken(TokenType::Identifier, "imageStore", Token->Delimiter) );
+    m_Tokens.insert( Token, CreateToken(TokenType::OpenBracket, "(", "" ) );
+    Token->Delimiter = m_Strings.Add(" ");
     // imageStore( RWTex[Location.x] = float4(0.0, 0.0, 0.0, 1.0);
 
-    OpenStaplePos->Delimiter = "";
+    OpenStaplePos->Delimiter = m_Strings.Add("");
     OpenStaplePos->Type = TokenType::Comma;
-    OpenStaplePos->Literal = ",";
+    OpenStaplePos->Literal = m_Strings.Add(",");
     // imageStore( RWTex,Location.x] = float4(0.0, 0.0, 0.0, 1.0);
     //                             ^
     //                         ClosingStaplePos
 
     auto LocationToken = OpenStaplePos;
     ++LocationToken;
-    m_Tokens.insert( LocationToken, TokenInfo( TokenType::Identifier, "_ToIvec", " " ) );
-    m_Tokens.insert( LocationToken, TokenInfo( TokenType::OpenBracket, "(", "" ) );
+    m_Tokens.insert( LocationToken, CreateToken( TokenType::Identifier, "_ToIvec", " " ) );
+    m_Tokens.insert( LocationToken, CreateToken( TokenType::OpenBracket, "(", "" ) );
     // imageStore( RWTex, _ToIvec(Location.x] = float4(0.0, 0.0, 0.0, 1.0);
     //                                      ^
     //                               ClosingStaplePos
 
-    m_Tokens.insert( ClosingStaplePos, TokenInfo( TokenType::ClosingBracket, ")", "" ) );
+    m_Tokens.insert( ClosingStaplePos, CreateToken( TokenType::ClosingBracket, ")", "" ) );
     // imageStore( RWTex, _ToIvec(Location.x)] = float4(0.0, 0.0, 0.0, 1.0);
     //                                       ^
     //                                ClosingStaplePos
 
-    ClosingStaplePos->Delimiter = "";
+    ClosingStaplePos->Delimiter = m_Strings.Add("");
     ClosingStaplePos->Type = TokenType::Comma;
-    ClosingStaplePos->Literal = ",";
+    ClosingStaplePos->Literal = m_Strings.Add(",");
     // imageStore( RWTex, _ToIvec(Location.x), = float4(0.0, 0.0, 0.0, 1.0);
     //                                         ^
     //                                   AssignmentToken
 
-    AssignmentToken->Delimiter = "";
+    AssignmentToken->Delimiter = m_Strings.Add("");
     AssignmentToken->Type = TokenType::OpenBracket;
-    AssignmentToken->Literal = "(";
+    AssignmentToken->Literal = m_Strings.Add("(");
     // imageStore( RWTex, _ToIvec(Location.x),( float4(0.0, 0.0, 0.0, 1.0);
     //                                        ^
 
-    m_Tokens.insert( AssignmentToken, TokenInfo(TokenType::Identifier, "_ExpandVector", " " ) );
+    m_Tokens.insert( AssignmentToken, CreateToken(TokenType::Identifier, "_ExpandVector", " " ) );
     // imageStore( RWTex, _ToIvec(Location.x), _ExpandVector( float4(0.0, 0.0, 0.0, 1.0);
     //                                                      ^
 
     // Insert closing bracket for _ExpandVector
-    m_Tokens.insert( SemicolonToken, TokenInfo(TokenType::ClosingBracket, ")", "" ) );
+    m_Tokens.insert( SemicolonToken, CreateToken(TokenType::ClosingBracket, ")", "" ) );
     // imageStore( RWTex,  _ToIvec(Location.x), _ExpandVector( float4(0.0, 0.0, 0.0, 1.0));
 
     // Insert closing bracket for imageStore
-    m_Tokens.insert( SemicolonToken, TokenInfo(TokenType::ClosingBracket, ")", "" ) );
+    m_Tokens.insert( SemicolonToken, CreateToken(TokenType::ClosingBracket, ")", "" ) );
     // imageStore( RWTex,  _ToIvec(Location.x), _ExpandVector( float4(0.0, 0.0, 0.0, 1.0)));
 
     return false;
@@ -2441,11 +2459,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
 
                 VERIFY_PARSER_STATE( Token, Token != ScopeStart, "Expected \'[\'" );
                 Token->Type = TokenType::Comma;
-                Token->Literal = ",";
+                Token->Literal = m_Strings.Add(",");
                 // InterlockedAdd(Tex2D,GTid.xy, 1, iOldVal);
                 //                     ^
 
-                OperationToken->Literal = StubIt->second.Name;
+                OperationToken->Literal = m_Strings.Add(StubIt->second.Name);
                 // InterlockedAddImage_3(Tex2D,GTid.xy, 1, iOldVal);
             }
             else
@@ -2454,7 +2472,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
                 //                ^
                 auto StubIt = m_Converter.m_GLSLStubs.find( FunctionStubHashKey("shared_var", OperationToken->Literal.c_str(), NumArguments) );
                 VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for funciton ", OperationToken->Literal, " with ", NumArguments, " arguments"  );
-                OperationToken->Literal = StubIt->second.Name;
+                OperationToken->Literal = m_Strings.Add(StubIt->second.Name);
                 // InterlockedAddSharedVar_3(g_i4SharedArray[GTid.x].x, 1, iOldVal);
             }
             Token = ArgsListEndToken;
@@ -2471,14 +2489,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
     VERIFY_PARSER_STATE( Token, Token->IsBuiltInType() || Token->Type == TokenType::Identifier, 
                             "Missing argument type" );
     auto TypeToken = Token;
-    ParamInfo.Type = Token->Literal;
+    ParamInfo.Type = Token->Literal.str();
 
     ++Token;
     //          out float4 Color : SV_Target,
     //                     ^
     VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF while parsing argument list" );
     VERIFY_PARSER_STATE( Token, Token->Type == TokenType::Identifier, "Missing argument name after ", ParamInfo.Type );
-    ParamInfo.Name = Token->Literal;
+    ParamInfo.Name = Token->Literal.str();
 
     ++Token;
     VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF" );
@@ -2490,8 +2508,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
         ProcessScope(Token, m_Tokens.end(), TokenType::OpenStaple, TokenType::ClosingStaple, 
             [&](TokenListType::iterator &tkn, int)
             {
-                ParamInfo.ArraySize.append(tkn->Delimiter);
-                ParamInfo.ArraySize.append(tkn->Literal);
+                ParamInfo.ArraySize.append(tkn->Delimiter.c_str(), tkn->Delimiter.length());
+                ParamInfo.ArraySize.append(tkn->Literal.c_str(), tkn->Literal.length());
                 ++tkn;
             }
         );
@@ -2519,7 +2537,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
             VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected end of file while looking for semantic for argument \"", ParamInfo.Name, '\"' );
             VERIFY_PARSER_STATE( Token, Token->Type == TokenType::Identifier, "Missing semantic for argument \"", ParamInfo.Name, '\"' );
             // Transform to lower case -  semantics are case-insensitive
-            ParamInfo.Semantic = StrToLower(Token->Literal);
+            ParamInfo.Semantic = StrToLower(Token->Literal.str());
             
             ++Token;
             //          out float4 Color : SV_Target,
@@ -2583,8 +2601,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters( TokenL
     if (!bIsVoid)
     {
         ShaderParameterInfo RetParam;
-        RetParam.Type = TypeToken->Literal;
-        RetParam.Name = FuncNameToken->Literal;
+        RetParam.Type = TypeToken->Literal.str();
+        RetParam.Name = FuncNameToken->Literal.str();
         RetParam.storageQualifier = ShaderParameterInfo::StorageQualifier::Ret;
         Params.push_back(RetParam);
     }
@@ -2758,7 +2776,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters( TokenL
                     //                                   ^
                     VERIFY_PARSER_STATE( TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::NumericConstant, "Numeric constant expected" );
                                 
-                    ParamInfo.ArraySize = TmpToken->Literal;
+                    ParamInfo.ArraySize = TmpToken->Literal.str();
                     auto NumCtrlPointsToken = TmpToken;
                     ++TmpToken;
                     VERIFY_PARSER_STATE( TmpToken, TmpToken != m_Tokens.end() && TmpToken->Literal == ">", "Angle bracket expected" );
@@ -2808,7 +2826,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters( TokenL
             VERIFY_PARSER_STATE( SemanticToken, SemanticToken != m_Tokens.end(), "Unexpected EOF" );
             VERIFY_PARSER_STATE( SemanticToken, SemanticToken->Type == TokenType::Identifier, "Exepcted semantic for the return argument ");
             // Transform to lower case -  semantics are case-insensitive
-            RetParam.Semantic = StrToLower(SemanticToken->Literal);
+            RetParam.Semantic = StrToLower(SemanticToken->Literal.str());
             ++SemanticToken;
             // float4 TestPS  ( in VSOutput In ) : SV_Target
             // {
@@ -2824,7 +2842,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters( TokenL
             ParseShaderParameter(TmpTypeToken, RetParam);
         }
         TypeToken->Type = TokenType::Identifier;
-        TypeToken->Literal = "void";
+        TypeToken->Literal = m_Strings.Add("void");
         // void TestPS  ( in VSOutput In )
     }
 
@@ -3400,7 +3418,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
                 Argument.push_back('[');
                 Argument.append(TopLevelParam.ArraySize);
                 Argument.push_back(']');
-                m_Tokens.insert(ArgsListEndToken, TokenInfo(TokenType::TextBlock, Argument.c_str()));
+                m_Tokens.insert(ArgsListEndToken, CreateToken(TokenType::TextBlock, Argument.c_str()));
             }
             else
             {
@@ -3439,8 +3457,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
         }
     }
     ReturnHandlerSS << "return;}\n";
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), TypeToken->Delimiter.c_str()));
-    TypeToken->Delimiter = "\n";
+    m_Tokens.insert(TypeToken, CreateToken(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), TypeToken->Delimiter));
+    TypeToken->Delimiter = m_Strings.Add("\n");
 
     String Prologue = PrologueSS.str();
     Token = ArgsListEndToken;
@@ -3457,7 +3475,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of \"", EntryPoint, "\"." );
     
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, CreateToken(TokenType::TextBlock, Prologue.c_str(), "\n"));
 
     ProcessReturnStatements( Token, bIsVoid, EntryPoint, ReturnMacroName );
 }
@@ -3489,7 +3507,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         VERIFY_PARSER_STATE( TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::Identifier, "Identifier expected");
         // [domain("quad")]
         //  ^
-        auto &Attrib = TmpToken->Literal;
+        auto Attrib = TmpToken->Literal.str();
         StrToLowerInPlace(Attrib);
 
         ++TmpToken;
@@ -3498,8 +3516,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         ProcessScope(TmpToken, m_Tokens.end(), TokenType::OpenBracket, TokenType::ClosingBracket, 
             [&](TokenListType::iterator &tkn, int)
             {
-               AttribValue.append(tkn->Delimiter);
-               AttribValue.append(tkn->Literal);
+               AttribValue.append(tkn->Delimiter.c_str(), tkn->Delimiter.length());
+               AttribValue.append(tkn->Literal.c_str(), tkn->Literal.length());
                ++tkn;
             }
         );
@@ -3799,7 +3817,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessDomainShaderArguments( Tok
     // ^
     
     std::unordered_map<HashMapStringKey, String> Attributes;
-    ParseAttributesInComment(TypeToken->Delimiter, Attributes);
+    ParseAttributesInComment(TypeToken->Delimiter.str(), Attributes);
     ProcessShaderAttributes(Token, Attributes);
 
     stringstream GlobalsSS;
@@ -3954,7 +3972,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements( TokenLis
                 //if( x < 0.5 ) return float4(0.0, 0.0, 0.0, 1.0);
                 //              ^
                 Token->Type = TokenType::Identifier;
-                Token->Literal = MacroName;
+                Token->Literal = m_Strings.Add(MacroName);
                 //if( x < 0.5 ) _RETURN_ float4(0.0, 0.0, 0.0, 1.0);
                 //              ^
 
@@ -3964,7 +3982,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements( TokenLis
 
                 if(Token->Type != TokenType::Semicolon )
                 {
-                    m_Tokens.insert( Token, TokenInfo(TokenType::OpenBracket, "("));
+                    m_Tokens.insert( Token, CreateToken(TokenType::OpenBracket, "("));
                     //if( x < 0.5 ) _RETURN_( float4(0.0, 0.0, 0.0, 1.0);
                     //                        ^
 
@@ -3976,7 +3994,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements( TokenLis
 
                     // Replace semicolon with ')'
                     Token->Type = TokenType::ClosingBracket;
-                    Token->Literal = ")";
+                    Token->Literal = m_Strings.Add(")");
                     //if( x < 0.5 ) _RETURN_( float4(0.0, 0.0, 0.0, 1.0))
                     //                                                  ^
                 }
@@ -4012,8 +4030,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements( TokenLis
     if(IsVoid)
     {
         // Insert return handler before the closing brace
-        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter.c_str()));
-        Token->Delimiter = "\n";
+        m_Tokens.insert(Token, CreateToken(TokenType::TextBlock, MacroName, Token->Delimiter));
+        Token->Delimiter = m_Strings.Add("\n");
         // void main ()
         // {
         //      ...
@@ -4049,15 +4067,15 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessGSOutStreamOperations( Tok
             //          ^
             VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE( Token, Token->Literal == ".", "\'.\' expected");
-            Token->Literal = "_";
-            Token->Delimiter.clear();
+            Token->Literal = m_Strings.Add("_");
+            Token->Delimiter = TokenString();
             // triStream_Append( Out );
             //          ^
             ++Token;
             // triStream_Append( Out );
             //           ^
             VERIFY_PARSER_STATE( Token, Token != m_Tokens.end(), "Unexpected EOF");
-            Token->Delimiter.clear();
+            Token->Delimiter = TokenString();
             ++Token;
         }
         else
@@ -4081,7 +4099,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration( TokenLi
     bool bIsVoid = false;
     ProcessFunctionParameters( ArgsListEndToken, ShaderParams, bIsVoid );
 
-    EntryPointToken->Literal = "main";
+    EntryPointToken->Literal = m_Strings.Add("main");
     //void main ()
 
     std::stringstream ReturnHandlerSS;
@@ -4129,9 +4147,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration( TokenLi
     // TypeToken
 
     // Insert global variables & return handler before the function
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter.c_str()));
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), "\n"));
-    TypeToken->Delimiter = "\n";
+    m_Tokens.insert(TypeToken, CreateToken(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter));
+    m_Tokens.insert(TypeToken, CreateToken(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), "\n"));
+    TypeToken->Delimiter = m_Strings.Add("\n");
     auto BodyStartToken = ArgsListEndToken;
     while( BodyStartToken != m_Tokens.end() && BodyStartToken->Type != TokenType::OpenBrace )
         ++BodyStartToken;
@@ -4148,7 +4166,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration( TokenLi
     VERIFY_PARSER_STATE(FirstStatementToken, FirstStatementToken != m_Tokens.end(), "Unexpected end of file while looking for the body of shader entry point \"", EntryPoint, "\"." );
     
     // Insert prologue before the first token
-    m_Tokens.insert(FirstStatementToken, TokenInfo(TokenType::TextBlock, Prologue.c_str(), "\n"));
+    m_Tokens.insert(FirstStatementToken, CreateToken(TokenType::TextBlock, Prologue.c_str(), "\n"));
 
     auto BodyEndToken = BodyStartToken;
     if (ShaderType == SHADER_TYPE_VERTEX || ShaderType == SHADER_TYPE_HULL || ShaderType == SHADER_TYPE_DOMAIN || ShaderType == SHADER_TYPE_PIXEL)
@@ -4328,7 +4346,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
                 // void CS(uint3 ThreadId  : SV_DispatchThreadID)
                 // ^
                 if( Token != m_Tokens.end() )
-                    Token->Delimiter = OpenStaple->Delimiter + Token->Delimiter;
+                    Token->Delimiter = m_Strings.Concat(OpenStaple->Delimiter, Token->Delimiter);
                 m_Tokens.erase( OpenStaple, Token );
             }
             else
@@ -4342,8 +4360,8 @@ String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
     String Output;
     for( const auto& Token : m_Tokens )
     {
-        Output.append( Token.Delimiter );
-        Output.append( Token.Literal );
+        Output.append(Token.Delimiter.c_str(), Token.Delimiter.length());
+        Output.append(Token.Literal.c_str(), Token.Literal.length());
     }
     return Output;
 }
@@ -4356,6 +4374,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters *p
                                                            size_t NumSymbols,
                                                            bool bPreserveTokens) :
     TBase(pRefCounters),
+    m_Strings(GetRawAllocator()),
     m_bPreserveTokens(bPreserveTokens),
     m_Converter(Converter),
     m_InputFileName(InputFileName != nullptr ? InputFileName : "<Unknown>")
@@ -4434,6 +4453,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint, S
 String HLSL2GLSLConverterImpl::ConversionStream::Convert( const Char* EntryPoint, SHADER_TYPE ShaderType, bool IncludeDefintions, const char* SamplerSuffix )
 {
     TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+    // Strings added during the conversion are released when the tokens are restored
+    auto StringsState = m_Strings.GetState();
 
     std::unordered_map<String, bool> SamplersHash;
     auto Token = m_Tokens.begin();
@@ -4462,7 +4483,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert( const Char* EntryPoint
                 // WARNING: 0:259: Only GLSL version > 110 allows postfix "F" or "f" for float
                 // even when compiling for GL 4.3 AND the code IS UNDER #if 0
                 if( Token->Literal.back() == 'f' || Token->Literal.back() == 'F' )
-                    Token->Literal.pop_back();
+                    Token->Literal = m_Strings.Add(Token->Literal.c_str(), Token->Literal.length()-1);
                 ++Token;
             break;
 
@@ -4649,6 +4670,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert( const Char* EntryPoint
     if(m_bPreserveTokens)
     {
         m_Tokens.swap(TokensCopy);
+        m_Strings.Restore(StringsState);
         m_StructDefinitions.clear();
         m_Objects.clear();
     }
@@ -0,0 +1,204 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Compiles variants of a GLSL shader to SPIR-V and writes them to a C++ include file 
+// as uint32_t arrays, so that the engine can create shader modules without running 
+// the GLSL front end when it starts.
+//
+// Every variant is described by a command line argument
+//
+//     <array name>[:<macro>=<definition>[,<macro>=<definition> ...]]
+//
+// The shaders are compiled by BuildSPIRV(), the same function the Vulkan back-end uses, 
+// so the byte code is identical to the byte code the engine would produce at run time.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GLSL2SPIRV.h"
+
+using namespace Diligent;
+
+static void PrintUsage(const char* ExeName)
+{
+    std::cerr << "Usage: " << ExeName << " <shader type> <source file> <output file> <variant> [<variant> ...]\n"
+                 "  <shader type>  One of vs, ps, gs, hs, ds or cs\n"
+                 "  <variant>      <array name>[:<macro>=<definition>[,<macro>=<definition> ...]]\n";
+}
+
+static SHADER_TYPE ParseShaderType(const char* Type)
+{
+    if (strcmp(Type, "vs") == 0) return SHADER_TYPE_VERTEX;
+    if (strcmp(Type, "ps") == 0) return SHADER_TYPE_PIXEL;
+    if (strcmp(Type, "gs") == 0) return SHADER_TYPE_GEOMETRY;
+    if (strcmp(Type, "hs") == 0) return SHADER_TYPE_HULL;
+    if (strcmp(Type, "ds") == 0) return SHADER_TYPE_DOMAIN;
+    if (strcmp(Type, "cs") == 0) return SHADER_TYPE_COMPUTE;
+    return SHADER_TYPE_UNKNOWN;
+}
+
+struct ShaderVariant
+{
+    std::string ArrayName;
+    // Macro name and definition pairs
+    std::vector<std::string> MacroStrings;
+};
+
+static bool ParseVariant(const char* Arg, ShaderVariant& Variant)
+{
+    std::string Str(Arg);
+    auto ColonPos = Str.find(':');
+    Variant.ArrayName = Str.substr(0, ColonPos);
+    if (Variant.ArrayName.empty())
+        return false;
+
+    if (ColonPos == std::string::npos)
+        return true;
+
+    std::istringstream MacroStream(Str.substr(ColonPos + 1));
+    std::string Macro;
+    while (std::getline(MacroStream, Macro, ','))
+    {
+        auto SeparatorPos = Macro.find('=');
+        if (SeparatorPos == 0 || Macro.empty())
+            return false;
+        Variant.MacroStrings.emplace_back(Macro.substr(0, SeparatorPos));
+        Variant.MacroStrings.emplace_back(SeparatorPos != std::string::npos ? Macro.substr(SeparatorPos + 1) : std::string());
+    }
+    return true;
+}
+
+static void WriteArray(std::ostream& Stream, const std::string& ArrayName, const std::vector<unsigned int>& SPIRV)
+{
+    constexpr size_t WordsPerLine = 8;
+
+    Stream << "static const uint32_t " << ArrayName << "[] =\n{";
+    for (size_t w = 0; w < SPIRV.size(); ++w)
+    {
+        Stream << ((w % WordsPerLine) == 0 ? "\n    " : " ");
+        Stream << "0x" << std::hex << std::setw(8) << std::setfill('0') << SPIRV[w] << std::dec << ',';
+    }
+    Stream << "\n};\n\n";
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    const auto  ShaderType = ParseShaderType(argv[1]);
+    const char* SrcPath    = argv[2];
+    const char* DstPath    = argv[3];
+    if (ShaderType == SHADER_TYPE_UNKNOWN)
+    {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    std::vector<ShaderVariant> Variants(argc - 4);
+    for (int arg = 4; arg < argc; ++arg)
+    {
+        if (!ParseVariant(argv[arg], Variants[arg - 4]))
+        {
+            std::cerr << "Invalid variant description: " << argv[arg] << '\n';
+            return -1;
+        }
+    }
+
+    std::ifstream SrcFile(SrcPath);
+    if (!SrcFile)
+    {
+        std::cerr << "Failed to open source file " << SrcPath << '\n';
+        return -1;
+    }
+    std::stringstream SrcStream;
+    SrcStream << SrcFile.rdbuf();
+    const auto Source = SrcStream.str();
+
+    InitializeGlslang();
+
+    std::stringstream Output;
+    Output << "// This file is generated from " << SrcPath << " by GLSL2SPIRVInclude. Do not edit.\n"
+           << "// Compiler: " << GetGLSLtoSPIRVCompilerVersion() << "\n\n";
+
+    int Result = 0;
+    for (const auto& Variant : Variants)
+    {
+        std::vector<ShaderMacro> Macros;
+        for (size_t m = 0; m < Variant.MacroStrings.size(); m += 2)
+            Macros.emplace_back(Variant.MacroStrings[m].c_str(), Variant.MacroStrings[m+1].c_str());
+        Macros.emplace_back(nullptr, nullptr);
+
+        ShaderCreationAttribs Attribs;
+        Attribs.Desc.Name       = Variant.ArrayName.c_str();
+        Attribs.Desc.ShaderType = ShaderType;
+        Attribs.Source          = Source.c_str();
+        Attribs.EntryPoint      = "main";
+        Attribs.Macros          = Macros.data();
+        Attribs.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+
+        std::vector<unsigned int> SPIRV;
+        try
+        {
+            SPIRV = BuildSPIRV(Attribs, nullptr);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+
+        if (SPIRV.empty())
+        {
+            std::cerr << SrcPath << ": failed to compile variant " << Variant.ArrayName << '\n';
+            Result = -1;
+            continue;
+        }
+
+        WriteArray(Output, Variant.ArrayName, SPIRV);
+    }
+
+    FinalizeGlslang();
+
+    if (Result != 0)
+        return Result;
+
+    // Only write the file if all variants were compiled, so that the build is not
+    // left with a partially generated include
+    std::ofstream DstFile(DstPath);
+    if (!DstFile || !(DstFile << Output.str()))
+    {
+        std::cerr << "Failed to write destination file " << DstPath << '\n';
+        return -1;
+    }
+
+    std::cout << "Compiled " << Variants.size() << " variants of " << SrcPath << '\n';
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+// Populates the persistent shader cache with the shaders listed in a text file, so that 
+// the engine does not have to convert or compile them when the application starts.
+//
+// Every line of the list describes one shader:
+//
+//     <shader type> <entry point> <file> [<macro>=<definition> ...]
+//
+// where shader type is one of vs, ps, gs, hs, ds or cs. Files with .glsl extension are 
+// treated as GLSL, all other files as HLSL. Empty lines and lines starting with # are ignored.
+//
+// For Vulkan, the cache is also populated with reflected shader resources. With 
+// --verify-reflection, the reflection data of every shader is loaded back and compared with 
+// the resources reflected from SPIR-V.
+//
+// The cache must be prewarmed on the same platform and with the same engine version
+// as the application that uses it, otherwise the keys of the entries will not match.
+// For the same reason, --combined-samplers and --sampler-suffix must match the values of
+// ShaderCreationAttribs::UseCombinedTextureSamplers and ShaderCreationAttribs::CombinedSamplerSuffix
+// the application creates the shaders with. Like the engine, the tool uses separate samplers by default.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ShaderCache.h"
+#include "GLSLSourceBuilder.h"
+#include "BasicShaderSourceStreamFactory.h"
+#if VULKAN_SUPPORTED
+#   include "GLSL2SPIRV.h"
+#   include "SPIRVShaderResources.h"
+#   include "DefaultRawMemoryAllocator.h"
+#endif
+
+using namespace Diligent;
+
+static void PrintUsage(const char* ExeName)
+{
+    std::cerr << "Usage: " << ExeName << " --cache <file> [options] <shader list file>\n"
+                 "  --cache <file>          Shader cache file to populate\n"
+#if GL_SUPPORTED && VULKAN_SUPPORTED
+                 "  --api <gl|vk>           Back-end the cache is populated for (default: gl)\n"
+#endif
+                 "  --search-dirs <dirs>    Semicolon-separated list of directories to search\n"
+                 "                          shader files and includes in\n"
+                 "  --combined-samplers     Combine textures with samplers (required to convert\n"
+                 "                          HLSL to GLSL)\n"
+                 "  --separate-samplers     Do not combine textures with samplers (default)\n"
+                 "  --sampler-suffix <str>  Suffix of combined sampler names (default: _sampler)\n"
+#if VULKAN_SUPPORTED
+                 "  --verify-reflection     Verify that reflected resources of Vulkan shaders\n"
+                 "                          are identical after they are loaded from the cache\n"
+#endif
+                 ;
+}
+
+static SHADER_TYPE ParseShaderType(const std::string& Type)
+{
+    if (Type == "vs") return SHADER_TYPE_VERTEX;
+    if (Type == "ps") return SHADER_TYPE_PIXEL;
+    if (Type == "gs") return SHADER_TYPE_GEOMETRY;
+    if (Type == "hs") return SHADER_TYPE_HULL;
+    if (Type == "ds") return SHADER_TYPE_DOMAIN;
+    if (Type == "cs") return SHADER_TYPE_COMPUTE;
+    return SHADER_TYPE_UNKNOWN;
+}
+
+static bool IsGLSLFile(const std::string& FilePath)
+{
+    static const char GLSLExt[] = ".glsl";
+    const auto ExtLen = sizeof(GLSLExt) - 1;
+    return FilePath.length() > ExtLen && FilePath.compare(FilePath.length() - ExtLen, ExtLen, GLSLExt) == 0;
+}
+
+#if VULKAN_SUPPORTED
+// Adds reflected resources of the shader to the cache the same way ShaderVkImpl does. If Verify is true,
+// the resources are loaded back from the reflection data and compared with the original resources.
+static bool CacheShaderResources(const std::vector<unsigned int>& SPIRV, const ShaderDesc& Desc, ShaderCache& Cache, bool Verify)
+{
+    auto Key = SPIRVShaderResources::GetReflectionCacheKey(SPIRV);
+    std::vector<Uint8> CachedData;
+    bool Found = Cache.Find(Key, CachedData);
+    if (Found && !Verify)
+        return true;
+
+    // The shader description has no static samplers, so no device is required
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    SPIRVShaderResources Resources(Allocator, nullptr, SPIRV, Desc);
+    std::vector<Uint8> ReflectionData;
+    Resources.SerializeReflection(ReflectionData);
+    if (!Found)
+        Cache.Store(Key, ReflectionData.data(), ReflectionData.size());
+
+    if (Verify)
+    {
+        if (Found && CachedData != ReflectionData)
+        {
+            LOG_ERROR_MESSAGE("Cached reflection data of shader '", Desc.Name, "' does not match the data reflected from SPIR-V");
+            return false;
+        }
+
+        SPIRVShaderResources LoadedResources(Allocator, nullptr, ReflectionData.data(), ReflectionData.size(), Desc);
+        std::vector<Uint8> ReserializedData;
+        LoadedResources.SerializeReflection(ReserializedData);
+        if (ReserializedData != ReflectionData || 
+            !LoadedResources.IsCompatibleWith(Resources) ||
+            LoadedResources.DumpResources() != Resources.DumpResources())
+        {
+            LOG_ERROR_MESSAGE("Resources of shader '", Desc.Name, "' loaded from the reflection data do not match the resources reflected from SPIR-V");
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    std::string CachePath;
+    std::string SearchDirs;
+    std::string ListPath;
+#if GL_SUPPORTED
+    bool UseVulkan = false;
+#else
+    bool UseVulkan = true;
+#endif
+#if VULKAN_SUPPORTED
+    bool VerifyReflection = false;
+#endif
+    // Shaders are processed with the engine defaults unless the options override them
+    const ShaderCreationAttribs DefaultAttribs;
+    bool UseCombinedTextureSamplers = DefaultAttribs.UseCombinedTextureSamplers;
+    std::string CombinedSamplerSuffix = DefaultAttribs.CombinedSamplerSuffix;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        const bool HasValue = arg + 1 < argc;
+        if (strcmp(argv[arg], "--cache") == 0 && HasValue)
+            CachePath = argv[++arg];
+        else if (strcmp(argv[arg], "--search-dirs") == 0 && HasValue)
+            SearchDirs = argv[++arg];
+        else if (strcmp(argv[arg], "--combined-samplers") == 0)
+            UseCombinedTextureSamplers = true;
+        else if (strcmp(argv[arg], "--separate-samplers") == 0)
+            UseCombinedTextureSamplers = false;
+        else if (strcmp(argv[arg], "--sampler-suffix") == 0 && HasValue)
+            CombinedSamplerSuffix = argv[++arg];
+#if GL_SUPPORTED && VULKAN_SUPPORTED
+        else if (strcmp(argv[arg], "--api") == 0 && HasValue && (strcmp(argv[arg+1], "gl") == 0 || strcmp(argv[arg+1], "vk") == 0))
+            UseVulkan = strcmp(argv[++arg], "vk") == 0;
+#endif
+#if VULKAN_SUPPORTED
+        else if (strcmp(argv[arg], "--verify-reflection") == 0)
+            VerifyReflection = true;
+#endif
+        else if (argv[arg][0] != '-' && ListPath.empty())
+            ListPath = argv[arg];
+        else
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (CachePath.empty() || ListPath.empty())
+    {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    std::ifstream ListFile(ListPath);
+    if (!ListFile)
+    {
+        std::cerr << "Failed to open shader list file " << ListPath << '\n';
+        return -1;
+    }
+
+#if VULKAN_SUPPORTED
+    if (UseVulkan)
+        InitializeGlslang();
+#endif
+
+    auto StartTime = std::chrono::high_resolution_clock::now();
+
+    BasicShaderSourceStreamFactory StreamFactory(SearchDirs.empty() ? nullptr : SearchDirs.c_str());
+    ShaderCache Cache(CachePath.c_str());
+
+    Uint32 NumShaders  = 0;
+    Uint32 NumFailures = 0;
+    std::string Line;
+    for (int LineNumber = 1; std::getline(ListFile, Line); ++LineNumber)
+    {
+        std::istringstream LineStream(Line);
+        std::string Type, EntryPoint, FilePath;
+        if (!(LineStream >> Type) || Type[0] == '#')
+            continue;
+
+        ++NumShaders;
+        if (!(LineStream >> EntryPoint >> FilePath) || ParseShaderType(Type) == SHADER_TYPE_UNKNOWN)
+        {
+            std::cerr << ListPath << '(' << LineNumber << "): invalid shader description\n";
+            ++NumFailures;
+            continue;
+        }
+
+        // Macro name and definition strings must be alive until the shader is processed
+        std::vector<std::string> MacroStrings;
+        std::string Macro;
+        while (LineStream >> Macro)
+        {
+            auto SeparatorPos = Macro.find('=');
+            MacroStrings.emplace_back(Macro.substr(0, SeparatorPos));
+            MacroStrings.emplace_back(SeparatorPos != std::string::npos ? Macro.substr(SeparatorPos + 1) : std::string());
+        }
+        std::vector<ShaderMacro> Macros;
+        for (size_t m = 0; m < MacroStrings.size(); m += 2)
+            Macros.emplace_back(MacroStrings[m].c_str(), MacroStrings[m+1].c_str());
+        Macros.emplace_back(nullptr, nullptr);
+
+        ShaderCreationAttribs Attribs;
+        Attribs.Desc.Name                  = FilePath.c_str();
+        Attribs.Desc.ShaderType            = ParseShaderType(Type);
+        Attribs.FilePath                   = FilePath.c_str();
+        Attribs.pShaderSourceStreamFactory = &StreamFactory;
+        Attribs.EntryPoint                 = EntryPoint.c_str();
+        Attribs.Macros                     = Macros.data();
+        Attribs.SourceLanguage             = IsGLSLFile(FilePath) ? SHADER_SOURCE_LANGUAGE_GLSL : SHADER_SOURCE_LANGUAGE_HLSL;
+        Attribs.UseCombinedTextureSamplers = UseCombinedTextureSamplers;
+        Attribs.CombinedSamplerSuffix      = CombinedSamplerSuffix.c_str();
+
+        try
+        {
+            // Use the same functions as the engine back-ends, so that the cache keys match
+            if (UseVulkan)
+            {
+#if VULKAN_SUPPORTED
+                auto SPIRV = BuildSPIRV(Attribs, &Cache);
+                if (SPIRV.empty())
+                    LOG_ERROR_AND_THROW("Failed to compile shader");
+                if (!CacheShaderResources(SPIRV, Attribs.Desc, Cache, VerifyReflection))
+                    LOG_ERROR_AND_THROW("Failed to verify shader resources");
+#endif
+            }
+            else
+                BuildGLSLSourceString(Attribs, TargetGLSLCompiler::driver, nullptr, &Cache);
+        }
+        catch (const std::runtime_error&)
+        {
+            std::cerr << ListPath << '(' << LineNumber << "): failed to process shader " << FilePath << '\n';
+            ++NumFailures;
+        }
+    }
+
+    auto Stats = Cache.GetStatistics();
+    bool Flushed = Cache.Flush();
+
+#if VULKAN_SUPPORTED
+    if (UseVulkan)
+        FinalizeGlslang();
+#endif
+
+    auto ElapsedMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - StartTime).count();
+    std::cout << "Processed " << NumShaders << " shaders in " << ElapsedMs << " ms, " << NumFailures << " failed: "
+              << Stats.NumHits << " entries already cached, " << Stats.NumStores << " added\n"
+              << "Cache " << CachePath << " contains " << Stats.NumEntries << " entries, " << Stats.DataSize << " bytes\n";
+
+    return (NumFailures == 0 && Flushed) ? 0 : -1;
+}